@@ -0,0 +1,22 @@
+#version 450
+
+// Vertex shader for the FPS renderer's debug lines (heidic_draw_line, heidic_draw_ray, ...)
+// World-space line-list vertices from one per-frame buffer (DebugVertex in stdlib/debug_draw.h);
+// the fragment stage is the cube shader, which writes fragColor as is
+
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec4 inColor;      // R8G8B8A8_UNORM
+
+// Uniform buffer (view and projection; model is unused, positions are already in world space)
+layout(binding = 0) uniform UniformBufferObject {
+    mat4 model;
+    mat4 view;
+    mat4 proj;
+} ubo;
+
+layout(location = 0) out vec3 fragColor;
+
+void main() {
+    gl_Position = ubo.proj * ubo.view * vec4(inPosition, 1.0);
+    fragColor = inColor.rgb;
+}
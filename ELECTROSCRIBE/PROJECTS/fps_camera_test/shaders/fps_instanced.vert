@@ -0,0 +1,30 @@
+#version 450
+
+// Instanced vertex shader for the FPS renderer's colored cubes
+// One shared unit cube mesh; model matrix and color come from the per-instance vertex buffer
+// (MeshInstance in stdlib/instance_batch.h)
+
+// Per-vertex (binding 0)
+layout(location = 0) in vec3 inPosition;
+
+// Per-instance (binding 1)
+layout(location = 1) in vec3 inColor;
+layout(location = 2) in vec4 inModel0;
+layout(location = 3) in vec4 inModel1;
+layout(location = 4) in vec4 inModel2;
+layout(location = 5) in vec4 inModel3;
+
+// Uniform buffer (view and projection shared by all instances; model is unused)
+layout(binding = 0) uniform UniformBufferObject {
+    mat4 model;
+    mat4 view;
+    mat4 proj;
+} ubo;
+
+layout(location = 0) out vec3 fragColor;
+
+void main() {
+    mat4 model = mat4(inModel0, inModel1, inModel2, inModel3);
+    gl_Position = ubo.proj * ubo.view * model * vec4(inPosition, 1.0);
+    fragColor = inColor;
+}
@@ -1999,6 +1999,27 @@ class Editor:
         # Add libraries to link
         build_cmd.extend(["-lvulkan-1", "-lglfw3", "-lgdi32", "-lcomdlg32"])
         
+        # Shaders compile in-process with shaderc (Vulkan SDK); EDEN_SHADER_COMPILER=glslc runs the
+        # glslc executable per shader instead, for SDKs without the shaderc library
+        if os.environ.get("EDEN_SHADER_COMPILER", "").lower() == "glslc":
+            build_cmd.append("-DEDEN_SHADER_COMPILER_GLSLC")
+            self.log_lines.append("Shader compiler: glslc subprocess (EDEN_SHADER_COMPILER=glslc)")
+        else:
+            build_cmd.append("-lshaderc_shared")
+
+            # Copy shaderc_shared.dll to project directory (the exe won't start without it)
+            shaderc_dll_path = os.path.join(vulkan_sdk, "Bin", "shaderc_shared.dll") if vulkan_sdk else None
+            if shaderc_dll_path and os.path.exists(shaderc_dll_path):
+                project_dll_path = os.path.join(project_dir, "shaderc_shared.dll")
+                try:
+                    import shutil
+                    shutil.copy2(shaderc_dll_path, project_dll_path)
+                    self.log_lines.append(f"Copied shaderc_shared.dll to project directory (required for shaders)")
+                except Exception as e:
+                    self.log_lines.append(f"WARNING: Could not copy shaderc_shared.dll: {e}")
+            else:
+                self.log_lines.append(f"WARNING: shaderc_shared.dll not found at {shaderc_dll_path} - set VULKAN_SDK, or build with EDEN_SHADER_COMPILER=glslc")
+
         # Add SDL3/SDL2 library path and linking if UI windows are enabled OR if we have audio resources
         # (has_audio_resources was already checked above for DLL copy)
         if ui_windows_enabled or has_audio_resources:
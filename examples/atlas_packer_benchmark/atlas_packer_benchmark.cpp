@@ -0,0 +1,236 @@
+// EDEN ENGINE - Atlas Packer Benchmark
+// Headless placement and defragmentation check for stdlib/atlas_packer.h
+// Usage: atlas_packer_benchmark [layer_size] [operations]
+//   Churns an atlas of `layer_size` (default 1024) square layers with `operations` (default 20000)
+//   insert/remove calls in the mix a UI loads (icons, buttons, font sheets), repacking every 2000
+//   operations the way TextureAtlas::defragment does. Every rectangle is checked against a shadow
+//   copy of the live ones: inside its layer, no overlap, and exact occupancy.
+
+#include "../../stdlib/atlas_packer.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+#include <vector>
+
+static const uint32_t MAX_LAYERS = 64;
+
+static uint32_t randomInt(uint32_t& seed, uint32_t lo, uint32_t hi) {
+    seed = seed * 1664525u + 1013904223u;
+    return lo + (seed >> 8) % (hi - lo + 1);
+}
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool sameRect(const AtlasRect& a, const AtlasRect& b) {
+    return a.layer == b.layer && a.x == b.x && a.y == b.y && a.width == b.width && a.height == b.height;
+}
+
+static bool overlaps(const AtlasRect& a, const AtlasRect& b) {
+    return a.layer == b.layer && a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+// `rect` has the requested size, lies inside its layer and overlaps none of `live`
+static bool placedOk(const AtlasPacker& packer, const AtlasRect& rect, uint32_t width, uint32_t height,
+                     const std::vector<AtlasRect>& live) {
+    bool ok = rect.width == width && rect.height == height && rect.layer < packer.getLayerCount() &&
+              rect.x + rect.width <= packer.getWidth() && rect.y + rect.height <= packer.getHeight();
+    for (const AtlasRect& other : live) {
+        ok = ok && !overlaps(rect, other);
+    }
+    return ok;
+}
+
+static float shadowOccupancy(const AtlasPacker& packer, const std::vector<AtlasRect>& live) {
+    uint64_t used = 0;
+    for (const AtlasRect& rect : live) {
+        used += static_cast<uint64_t>(rect.width) * rect.height;
+    }
+    return packer.getLayerCount() == 0 ? 0.0f : static_cast<float>(static_cast<double>(used) /
+        (static_cast<double>(packer.getWidth()) * packer.getHeight() * packer.getLayerCount()));
+}
+
+struct ChurnResult {
+    uint64_t inserts = 0;
+    uint64_t removes = 0;
+    uint64_t failures = 0;
+    uint64_t repacks = 0;
+    uint32_t peakLayers = 0;
+    float occupancyBefore = 0.0f;   // Summed over the repacks, averaged in main
+    float occupancyAfter = 0.0f;
+    bool placementOk = true;        // Right size, inside the layer, no overlap; refused only with every layer open
+    bool occupancyOk = true;        // getOccupancy() matches the live area
+    bool repackOk = true;           // Every live rectangle placed again, no more layers than before
+    bool drainOk = true;            // Empty and trimmed to no layers once everything is removed
+    double ms = 0.0;
+};
+
+// Sprite sizes a UI loads: mostly icons, some buttons and panels, now and then a font sheet
+static void spriteSize(uint32_t& seed, uint32_t layerSize, uint32_t& width, uint32_t& height) {
+    uint32_t kind = randomInt(seed, 0, 49);
+    if (kind < 30) {
+        width = height = 16u << randomInt(seed, 0, 2);
+    } else if (kind < 49) {
+        width = randomInt(seed, 24, 200);
+        height = randomInt(seed, 12, 64);
+    } else {
+        width = height = std::min(layerSize, 256u);
+    }
+}
+
+static ChurnResult churn(uint32_t layerSize, uint64_t operations, bool check) {
+    AtlasPacker packer(layerSize, layerSize, MAX_LAYERS);
+    ChurnResult result;
+    std::vector<AtlasRect> live;
+    uint32_t seed = 2024u;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t op = 1; op <= operations; op++) {
+        // Grow for the first quarter, then keep an even mix of loads and unloads
+        bool insert = live.empty() || randomInt(seed, 0, 9) < (op < operations / 4 ? 7u : 5u);
+        if (insert) {
+            uint32_t width, height;
+            spriteSize(seed, layerSize, width, height);
+            AtlasRect rect;
+            if (!packer.insert(width, height, rect)) {
+                result.failures++;
+                result.placementOk = result.placementOk && packer.getLayerCount() == MAX_LAYERS;
+                continue;
+            }
+            if (check) {
+                result.placementOk = result.placementOk && placedOk(packer, rect, width, height, live);
+            }
+            live.push_back(rect);
+            result.inserts++;
+        } else {
+            size_t pick = randomInt(seed, 0, static_cast<uint32_t>(live.size() - 1));
+            packer.remove(live[pick]);
+            live[pick] = live.back();
+            live.pop_back();
+            result.removes++;
+        }
+        result.peakLayers = std::max(result.peakLayers, packer.getLayerCount());
+        if (check && op % 64 == 0) {
+            result.occupancyOk = result.occupancyOk && std::fabs(packer.getOccupancy() - shadowOccupancy(packer, live)) < 1e-6f;
+        }
+
+        // Defragment: repack the live sizes and move every rectangle to its new place
+        if (op % 2000 == 0 && !live.empty()) {
+            std::vector<std::pair<uint32_t, uint32_t>> sizes;
+            for (const AtlasRect& rect : live) {
+                sizes.push_back({rect.width, rect.height});
+            }
+            packer.trimLayers();
+            uint32_t layersBefore = packer.getLayerCount();
+            result.occupancyBefore += packer.getOccupancy();
+            std::vector<AtlasRect> placed;
+            if (!packer.repack(sizes, placed)) {
+                result.repackOk = false;
+                continue;
+            }
+            result.repacks++;
+            result.occupancyAfter += packer.getOccupancy();
+            if (check) {
+                std::vector<AtlasRect> checked;
+                for (size_t i = 0; i < placed.size(); i++) {
+                    result.repackOk = result.repackOk && placedOk(packer, placed[i], sizes[i].first, sizes[i].second, checked);
+                    checked.push_back(placed[i]);
+                }
+                result.repackOk = result.repackOk && packer.getLayerCount() <= layersBefore;
+            }
+            live = placed;
+        }
+    }
+
+    // Drain in random order: every layer resets, and trimming leaves none
+    while (!live.empty()) {
+        size_t pick = randomInt(seed, 0, static_cast<uint32_t>(live.size() - 1));
+        packer.remove(live[pick]);
+        live[pick] = live.back();
+        live.pop_back();
+        result.removes++;
+    }
+    result.ms = elapsedMs(start);
+    result.drainOk = packer.getOccupancy() == 0.0f;
+    packer.trimLayers();
+    result.drainOk = result.drainOk && packer.getLayerCount() == 0;
+    return result;
+}
+
+// Hand-traced sequence on 64x64 layers with known placements
+static bool checkKnownSequence() {
+    AtlasPacker packer(64, 64, 2);
+    AtlasRect a, b, c, d, e, f, g, h;
+    bool ok = packer.insert(32, 16, a) && sameRect(a, {0, 0, 0, 32, 16});
+    ok = ok && packer.insert(32, 32, b) && sameRect(b, {0, 32, 0, 32, 32});     // Lower top edge than on top of a
+    ok = ok && packer.insert(16, 16, c) && sameRect(c, {0, 0, 16, 16, 16});     // On a: top 32 beats 48
+    ok = ok && packer.insert(16, 16, d) && sameRect(d, {0, 16, 16, 16, 16});    // Skyline is now flat at 32
+    ok = ok && packer.insert(64, 32, e) && sameRect(e, {0, 0, 32, 64, 32});     // Fills layer 0 exactly
+    ok = ok && packer.getLayerCount() == 1 && packer.getOccupancy() == 1.0f;
+
+    // Nothing on top of e: its space is reusable at once
+    packer.remove(e);
+    ok = ok && packer.insert(64, 32, e) && sameRect(e, {0, 0, 32, 64, 32});
+
+    ok = ok && packer.insert(1, 1, f) && sameRect(f, {1, 0, 0, 1, 1});          // Layer 0 full: open layer 1
+    ok = ok && packer.insert(1, 1, g) && sameRect(g, {1, 1, 0, 1, 1});
+
+    // a is buried under c and d: its hole stays until a repack, so a new 32x16 goes to layer 1
+    packer.remove(a);
+    ok = ok && packer.insert(32, 16, h) && sameRect(h, {1, 2, 0, 32, 16});
+    ok = ok && std::fabs(packer.getOccupancy() - (1024 + 256 + 256 + 2048 + 1 + 1 + 512) / 8192.0f) < 1e-6f;
+
+    // Over the layer limit, zero-sized or larger than a layer: refused
+    AtlasRect refused;
+    ok = ok && !packer.insert(64, 64, refused) && !packer.insert(65, 1, refused) && !packer.insert(0, 4, refused);
+
+    // Emptying layer 1 resets it; trimming drops it
+    packer.remove(f);
+    packer.remove(g);
+    packer.remove(h);
+    ok = ok && packer.getLayerCount() == 2;
+    packer.trimLayers();
+    ok = ok && packer.getLayerCount() == 1;
+
+    // Repack b, c, d, e: tallest (then widest) first, into one layer with the hole closed
+    std::vector<AtlasRect> placed;
+    ok = ok && packer.repack({{32, 32}, {16, 16}, {16, 16}, {64, 32}}, placed) && placed.size() == 4;
+    ok = ok && sameRect(placed[3], {0, 0, 0, 64, 32}) && sameRect(placed[0], {0, 0, 32, 32, 32}) &&
+         sameRect(placed[1], {0, 32, 32, 16, 16}) && sameRect(placed[2], {0, 48, 32, 16, 16});
+    ok = ok && packer.insert(32, 16, a) && sameRect(a, {0, 32, 48, 32, 16}) && packer.getLayerCount() == 1;
+
+    // A repack that cannot fit leaves the packer unchanged
+    ok = ok && !packer.repack({{64, 64}, {64, 64}, {64, 64}}, placed) && placed.size() == 4 && packer.getLayerCount() == 1;
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    uint32_t layerSize = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 1024;
+    uint64_t operations = argc > 2 ? static_cast<uint64_t>(std::atol(argv[2])) : 20000;
+    layerSize = std::max(layerSize, 256u);
+
+    ChurnResult checked = churn(layerSize, operations, true);
+    ChurnResult timed = churn(layerSize, operations, false);
+    bool knownOk = checkKnownSequence();
+    float repacks = static_cast<float>(std::max<uint64_t>(checked.repacks, 1));
+
+    std::cout << std::fixed << layerSize << "x" << layerSize << " layers, " << operations << " operations" << std::endl;
+    std::cout << "inserts / removes:    " << checked.inserts << " / " << checked.removes << std::endl
+              << "failed inserts:       " << checked.failures << std::endl
+              << "peak layers:          " << checked.peakLayers << std::endl
+              << "repacks:              " << checked.repacks << std::endl
+              << std::setprecision(1)
+              << "occupancy at repack:  " << 100.0f * checked.occupancyBefore / repacks << "% -> "
+              << 100.0f * checked.occupancyAfter / repacks << "%" << std::endl
+              << "us per operation:     " << std::setprecision(2) << timed.ms * 1e3 / std::max<uint64_t>(timed.inserts + timed.removes, 1) << std::endl;
+    std::cout << "placement:            " << (checked.placementOk ? "yes" : "NO") << std::endl
+              << "occupancy:            " << (checked.occupancyOk ? "yes" : "NO") << std::endl
+              << "repack:               " << (checked.repackOk ? "yes" : "NO") << std::endl
+              << "drained:              " << (checked.drainOk ? "yes" : "NO") << std::endl
+              << "known sequence:       " << (knownOk ? "yes" : "NO") << std::endl;
+    return checked.placementOk && checked.occupancyOk && checked.repackOk && checked.drainOk && knownOk ? 0 : 1;
+}
@@ -0,0 +1,229 @@
+// EDEN ENGINE - Audio Cache Benchmark
+// Headless check of the decoded-clip cache in stdlib/audio_cache.h (no audio device)
+// Usage: audio_cache_benchmark [clips] [track.ogg] [work_dir]
+//   Copies the track (default ELECTROSCRIBE/PROJECTS/audio_test/audio/fight_music.ogg) to `clips`
+//   (default 8) sources in work_dir (default audio_cache_bench, deleted afterwards), then loads
+//   them the way AudioResource::loadOGG does: cold (Vorbis decode, .pcm written), again while
+//   they are held (memory hits), and after everything is released (the next launch: .pcm hits).
+//   Edited, resized, touched, deleted and corrupt files follow, and a cache with no directory.
+
+#define STB_VORBIS_IMPLEMENTATION
+#include "../../stdlib/stb_vorbis.h"
+#include "../../stdlib/audio_cache.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <filesystem>
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static std::string readBytes(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// Rewrite a file. The pause first outlasts the file system's timestamp tick, so the new
+// modification time differs even when the edit lands within the same second.
+static void writeBytes(const std::string& path, const std::string& bytes) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << bytes;
+}
+
+static AudioClip decodeOgg(const std::string& path) {
+    AudioClip clip;
+    short* output = nullptr;
+    int frames = stb_vorbis_decode_filename(path.c_str(), &clip.channels, &clip.sampleRate, &output);
+    if (frames > 0 && output) {
+        clip.samples.assign(output, output + static_cast<size_t>(frames) * clip.channels);
+    }
+    free(output);
+    return clip;
+}
+
+// AudioResource::loadOGG for a short clip: the cache, else a decode that is then shared
+static std::shared_ptr<const AudioClip> load(const std::string& path, bool& decoded) {
+    AudioClipCache& cache = AudioClipCache::get_instance();
+    decoded = false;
+    if (std::shared_ptr<const AudioClip> cached = cache.find(path)) {
+        return cached;
+    }
+    decoded = true;
+    return cache.insert(path, decodeOgg(path), true);
+}
+
+static bool sameClip(const AudioClip& a, const AudioClip& b) {
+    return a.channels == b.channels && a.sampleRate == b.sampleRate && a.samples == b.samples;
+}
+
+static size_t countFiles(const std::string& dir, const char* extension) {
+    size_t count = 0;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(dir, error)) {
+        count += entry.path().extension() == extension;
+    }
+    return count;
+}
+
+int main(int argc, char** argv) {
+    size_t clips = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 8;
+    std::string track = argc > 2 ? argv[2] : "ELECTROSCRIBE/PROJECTS/audio_test/audio/fight_music.ogg";
+    std::string work = argc > 3 ? argv[3] : "audio_cache_bench";
+    clips = std::max<size_t>(clips, 5);
+
+    AudioClip reference = decodeOgg(track);
+    if (reference.samples.empty()) {
+        std::cerr << "[EDEN] Failed to decode OGG file: " << track << std::endl;
+        return 1;
+    }
+    std::string trackBytes = readBytes(track);
+    const std::string sounds = work + "/sounds";
+    const std::string cacheDir = work + "/audio_cache";
+    std::filesystem::remove_all(work);
+    std::filesystem::create_directories(sounds);
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < clips; i++) {
+        paths.push_back(sounds + "/clip_" + std::to_string(i) + ".ogg");
+        std::ofstream(paths.back(), std::ios::binary) << trackBytes;
+    }
+
+    AudioClipCache& cache = AudioClipCache::get_instance();
+    cache.setCacheDirectory(cacheDir);
+    bool ok = true;
+    auto statsDelta = [&](const AudioClipCache::Stats& before, uint64_t memory, uint64_t disk, uint64_t misses) {
+        AudioClipCache::Stats after = cache.getStats();
+        return after.memoryHits - before.memoryHits == memory && after.diskHits - before.diskHits == disk &&
+               after.misses - before.misses == misses;
+    };
+
+    // Cold: every clip is decoded and its .pcm written to the cache directory, not beside the source
+    std::vector<std::shared_ptr<const AudioClip>> held(clips);
+    AudioClipCache::Stats before = cache.getStats();
+    auto start = std::chrono::steady_clock::now();
+    bool decoded = false;
+    for (size_t i = 0; i < clips; i++) {
+        held[i] = load(paths[i], decoded);
+        ok = ok && decoded && sameClip(*held[i], reference);
+    }
+    double coldMs = elapsedMs(start);
+    bool coldOk = ok && statsDelta(before, 0, 0, clips) && countFiles(cacheDir, ".pcm") == clips &&
+                  countFiles(sounds, ".pcm") == 0 && cache.pcmCachePath(paths[0]).rfind(cacheDir + "/", 0) == 0;
+
+    // Held: every load shares the clip already in memory, counted once
+    before = cache.getStats();
+    std::vector<std::shared_ptr<const AudioClip>> again(clips);
+    const int memoryRounds = 1000;
+    start = std::chrono::steady_clock::now();
+    for (int round = 0; round < memoryRounds; round++) {
+        for (size_t i = 0; i < clips; i++) {
+            again[i] = load(paths[i], decoded);
+        }
+    }
+    double memoryMs = elapsedMs(start);
+    bool memoryOk = statsDelta(before, clips * memoryRounds, 0, 0) &&
+                    cache.getMemorySize() == clips * reference.samples.size() * sizeof(int16_t);
+    for (size_t i = 0; i < clips; i++) {
+        memoryOk = memoryOk && again[i] == held[i];
+    }
+    memoryOk = memoryOk && load(sounds + "/./../sounds/clip_1.ogg", decoded) == held[1] && !decoded;
+
+    // Next launch: nothing in memory, every clip comes back from its .pcm file unchanged
+    held.assign(clips, nullptr);
+    again.assign(clips, nullptr);
+    cache.purge();
+    before = cache.getStats();
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < clips; i++) {
+        held[i] = load(paths[i], decoded);
+    }
+    double diskMs = elapsedMs(start);
+    bool diskOk = statsDelta(before, 0, clips, 0);
+    for (size_t i = 0; i < clips; i++) {
+        diskOk = diskOk && sameClip(*held[i], reference) && held[i]->samples.data() != reference.samples.data();
+    }
+
+    // Invalidation. An edit of the same size, while the old clip is still held, misses memory and
+    // disk; the fresh decode replaces the .pcm, and the next launch gets the new clip
+    bool invalidOk = true;
+    std::string edited = trackBytes;
+    AudioClip marker;
+    marker.channels = 1;
+    marker.sampleRate = 8000;
+    marker.samples.assign(100, 1234);
+    edited[edited.size() / 2] ^= 0x55;
+    writeBytes(paths[0], edited);
+    before = cache.getStats();
+    invalidOk = invalidOk && !cache.find(paths[0]) && statsDelta(before, 0, 0, 1);
+    std::shared_ptr<const AudioClip> replaced = cache.insert(paths[0], AudioClip(marker), true);
+    invalidOk = invalidOk && cache.find(paths[0]) == replaced && sameClip(*held[0], reference);
+    held[0].reset();
+    replaced.reset();
+    cache.purge();
+    std::shared_ptr<const AudioClip> reloaded = cache.find(paths[0]);
+    invalidOk = invalidOk && reloaded && sameClip(*reloaded, marker);
+
+    // A size change, and a touch that keeps the bytes, are re-decoded too
+    writeBytes(paths[1], trackBytes + "tail");
+    invalidOk = invalidOk && !cache.find(paths[1]);
+    writeBytes(paths[2], trackBytes);
+    invalidOk = invalidOk && !cache.find(paths[2]);
+    held[2] = load(paths[2], decoded);
+    invalidOk = invalidOk && decoded && sameClip(*held[2], reference);
+
+    // A deleted source misses even with its clip held and its .pcm on disk
+    std::filesystem::remove(paths[2]);
+    invalidOk = invalidOk && !cache.find(paths[2]);
+
+    // A truncated .pcm is ignored, then rewritten by the next decode
+    std::string pcm3 = cache.pcmCachePath(paths[3]);
+    uintmax_t pcmBytes = std::filesystem::file_size(pcm3);
+    std::filesystem::resize_file(pcm3, pcmBytes / 2);
+    held[3].reset();
+    cache.purge();
+    invalidOk = invalidOk && !cache.find(paths[3]);
+    held[3] = load(paths[3], decoded);
+    invalidOk = invalidOk && decoded && std::filesystem::file_size(pcm3) == pcmBytes;
+    held[3].reset();
+    cache.purge();
+    before = cache.getStats();
+    invalidOk = invalidOk && cache.find(paths[3]) && statsDelta(before, 0, 1, 0);
+
+    // No directory: clips are still shared in memory, but nothing is written or read from disk
+    cache.setCacheDirectory("");
+    size_t pcmFiles = countFiles(cacheDir, ".pcm");
+    writeBytes(paths[4], trackBytes);
+    held[4] = load(paths[4], decoded);
+    bool noDiskOk = decoded && cache.pcmCachePath(paths[4]).empty() && countFiles(cacheDir, ".pcm") == pcmFiles &&
+                    load(paths[4], decoded) == held[4] && !decoded;
+    held[4].reset();
+    cache.purge();
+    noDiskOk = noDiskOk && !cache.find(paths[4]);
+    cache.setCacheDirectory("audio_cache");
+
+    held.clear();
+    reloaded.reset();
+    cache.purge();
+    std::filesystem::remove_all(work);
+
+    size_t clipBytes = reference.samples.size() * sizeof(int16_t);
+    std::cout << std::fixed << clips << " clips of " << std::setprecision(1)
+              << static_cast<double>(reference.getFrameCount()) / reference.sampleRate << " s, "
+              << trackBytes.size() / 1024 << " KB OGG -> " << clipBytes / 1024 << " KB PCM, "
+              << pcmBytes / 1024 << " KB .pcm each" << std::endl;
+    std::cout << std::setprecision(3)
+              << "decode ms / clip:     " << coldMs / clips << std::endl
+              << ".pcm load ms / clip:  " << diskMs / clips << std::endl
+              << "memory hit us:        " << memoryMs * 1000.0 / (static_cast<double>(clips) * memoryRounds) << std::endl;
+    std::cout << "cold decode:          " << (coldOk ? "yes" : "NO") << std::endl
+              << "memory hits:          " << (memoryOk ? "yes" : "NO") << std::endl
+              << "disk hits:            " << (diskOk ? "yes" : "NO") << std::endl
+              << "invalidation:         " << (invalidOk ? "yes" : "NO") << std::endl
+              << "no cache directory:   " << (noDiskOk ? "yes" : "NO") << std::endl;
+    return coldOk && memoryOk && diskOk && invalidOk && noDiskOk ? 0 : 1;
+}
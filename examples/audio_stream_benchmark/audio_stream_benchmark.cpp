@@ -0,0 +1,131 @@
+// EDEN ENGINE - Audio Stream Benchmark
+// Headless check of OGG streaming in stdlib/audio_stream.h (no audio device)
+// Usage: audio_stream_benchmark [track.ogg] [buffer_seconds]
+//   Decodes the track (default ELECTROSCRIBE/PROJECTS/audio_test/audio/fight_music.ogg) whole with
+//   stb_vorbis_decode_memory, then streams it through OggStream with a ring of `buffer_seconds`
+//   (default 0.5) and compares every sample: once through, looping for two and a half plays, and
+//   with a reader that stalls long enough for the ring to fill. Open time and memory are compared
+//   with the whole-file decode AudioResource used before streaming.
+
+#define STB_VORBIS_IMPLEMENTATION
+#include "../../stdlib/stb_vorbis.h"
+#include "../../stdlib/audio_stream.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <vector>
+
+static uint32_t randomInt(uint32_t& seed, uint32_t lo, uint32_t hi) {
+    seed = seed * 1664525u + 1013904223u;
+    return lo + (seed >> 8) % (hi - lo + 1);
+}
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct StreamPass {
+    std::vector<int16_t> samples;
+    bool finished = false;      // isFinished() once the reader stopped
+};
+
+// Read `frames` frames (or until the stream finishes) in callback-sized chunks of 1-2000 frames.
+// A stalling reader sleeps now and then for longer than the ring lasts, so the decoder has to
+// wait for space rather than overwrite unread audio.
+static StreamPass readStream(OggStream& stream, bool loop, size_t frames, bool stall, uint32_t seed) {
+    StreamPass pass;
+    int channels = stream.getChannels();
+    std::vector<int16_t> chunk(2000 * static_cast<size_t>(channels));
+    stream.start(loop);
+    while (pass.samples.size() / channels < frames && !stream.isFinished()) {
+        size_t wanted = std::min<size_t>(randomInt(seed, 1, 2000), frames - pass.samples.size() / channels);
+        size_t got = stream.read(chunk.data(), wanted);
+        pass.samples.insert(pass.samples.end(), chunk.begin(), chunk.begin() + got * channels);
+        if (got == 0) {
+            std::this_thread::yield();
+        } else if (stall && randomInt(seed, 0, 63) == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(randomInt(seed, 20, 80)));
+        }
+    }
+    pass.finished = stream.isFinished();
+    stream.stop();
+    return pass;
+}
+
+// Samples that differ from the whole-file decode, repeated end to end for a looping stream
+static size_t countMismatches(const std::vector<int16_t>& streamed, const int16_t* decoded, size_t decodedSamples) {
+    size_t mismatches = 0;
+    for (size_t i = 0; i < streamed.size(); i++) {
+        mismatches += streamed[i] != decoded[i % decodedSamples];
+    }
+    return mismatches;
+}
+
+int main(int argc, char** argv) {
+    std::string path = argc > 1 ? argv[1] : "ELECTROSCRIBE/PROJECTS/audio_test/audio/fight_music.ogg";
+    float bufferSeconds = argc > 2 ? static_cast<float>(std::atof(argv[2])) : 0.5f;
+    bufferSeconds = std::max(bufferSeconds, 0.01f);
+
+    std::unique_ptr<OggStream> stream;
+    auto start = std::chrono::steady_clock::now();
+    try {
+        stream = std::make_unique<OggStream>(path, bufferSeconds);
+    } catch (const std::exception& e) {
+        std::cerr << "[EDEN] " << e.what() << std::endl;
+        return 1;
+    }
+    double openMs = elapsedMs(start);
+
+    // Reference: the whole file decoded at once, as AudioResource did before streaming
+    int channels = 0, sampleRate = 0;
+    short* decoded = nullptr;
+    start = std::chrono::steady_clock::now();
+    int decodedFrames = stb_vorbis_decode_memory(stream->getFileData(), static_cast<int>(stream->getFileSize()),
+                                                 &channels, &sampleRate, &decoded);
+    double decodeMs = elapsedMs(start);
+    if (decodedFrames <= 0) {
+        std::cerr << "[EDEN] Failed to decode OGG file: " << path << std::endl;
+        return 1;
+    }
+    size_t frames = static_cast<size_t>(decodedFrames);
+    size_t decodedSamples = frames * channels;
+
+    bool infoOk = stream->getChannels() == channels && stream->getSampleRate() == sampleRate &&
+                  stream->getTotalFrames() == frames;
+
+    // Once through: exactly the decoded samples, then finished
+    start = std::chrono::steady_clock::now();
+    StreamPass once = readStream(*stream, false, frames + 1, false, 1u);
+    double streamMs = elapsedMs(start);
+    bool onceOk = once.samples.size() == decodedSamples && once.finished &&
+                  countMismatches(once.samples, decoded, decodedSamples) == 0;
+
+    // Looping: two and a half plays with no gap, repeat or loss at the loop points
+    size_t loopFrames = frames * 5 / 2;
+    StreamPass looped = readStream(*stream, true, loopFrames, false, 2u);
+    bool loopOk = looped.samples.size() == loopFrames * channels && !looped.finished &&
+                  countMismatches(looped.samples, decoded, decodedSamples) == 0;
+
+    // A reader that stalls: the ring fills and the decoder waits; nothing is lost or repeated
+    StreamPass stalled = readStream(*stream, false, frames + 1, true, 3u);
+    bool stallOk = stalled.samples.size() == decodedSamples && stalled.finished &&
+                   countMismatches(stalled.samples, decoded, decodedSamples) == 0;
+    free(decoded);
+
+    std::cout << std::fixed << path << ": " << frames << " frames, " << channels << " channel(s), "
+              << sampleRate << " Hz, " << std::setprecision(1) << stream->getDurationSeconds() << " s" << std::endl;
+    std::cout << std::setprecision(2)
+              << "open ms (stream):     " << openMs << std::endl
+              << "decode ms (whole):    " << decodeMs << std::endl
+              << "stream ms (whole):    " << streamMs << " (" << std::setprecision(0)
+              << stream->getDurationSeconds() * 1000.0 / streamMs << "x real time)" << std::endl << std::setprecision(2)
+              << "memory KB (ring):     " << stream->getMemorySize() / 1024.0 << std::endl
+              << "memory KB (whole):    " << decodedSamples * sizeof(int16_t) / 1024.0 << std::endl;
+    std::cout << "stream info:          " << (infoOk ? "yes" : "NO") << std::endl
+              << "matches decode:       " << (onceOk ? "yes" : "NO") << std::endl
+              << "gapless loop:         " << (loopOk ? "yes" : "NO") << std::endl
+              << "stalled reader:       " << (stallOk ? "yes" : "NO") << std::endl;
+    return infoOk && onceOk && loopOk && stallOk ? 0 : 1;
+}
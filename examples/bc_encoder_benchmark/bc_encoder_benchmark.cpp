@@ -0,0 +1,182 @@
+// EDEN ENGINE - BC Encoder Benchmark
+// Headless quality (PSNR), throughput and correctness check for stdlib/bc_encoder.h
+// Usage: bc_encoder_benchmark [image.png] [threads]
+//   Without an image, a 1024x1024 synthetic test pattern (gradients, edges, noise) is used.
+//   Fixed BC7 mode 6 blocks, assembled bit by bit from the format spec, are decoded against their
+//   known pixels, and the transcode cache key and cache files are checked in a scratch directory.
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "../../stdlib/bc_encoder.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <fstream>
+
+static std::vector<uint8_t> makeTestPattern(uint32_t width, uint32_t height) {
+    std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+    uint32_t seed = 12345;
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            uint8_t* p = &rgba[(static_cast<size_t>(y) * width + x) * 4];
+            seed = seed * 1664525u + 1013904223u;
+            int noise = static_cast<int>((seed >> 24) & 15) - 8;
+            bool checker = ((x / 64) + (y / 64)) & 1;
+            p[0] = static_cast<uint8_t>(std::min(255, std::max(0, static_cast<int>(128 + 127 * std::sin(x * 0.03)) + noise)));
+            p[1] = static_cast<uint8_t>(y * 255 / height);
+            p[2] = checker ? 220 : static_cast<uint8_t>((x * 3) & 255);
+            p[3] = static_cast<uint8_t>(x < width / 2 ? 255 : (x * 255 / width));
+        }
+    }
+    return rgba;
+}
+
+// BC7 mode 6 blocks with their decoded RGBA. Mode 6 is bit 6 of the first byte, then 7-bit R0 R1
+// G0 G1 B0 B1 A0 A1, the two p-bits (the endpoint's low bit) and 16 indices, 3 bits for pixel 0.
+// Pixel = ((64 - w) * e0 + w * e1 + 32) >> 6 with the 4-bit weights 0, 4, 9, ... 60, 64.
+struct KnownBlock {
+    const char* name;
+    uint8_t block[16];
+    uint8_t rgba[64];
+};
+
+static const KnownBlock KNOWN_BC7_BLOCKS[] = {
+    // Endpoints 0 and 255 in every channel (p-bits 0, 1), indices 0..15: the weight ramp itself
+    {"ramp",
+     {0x40, 0xc0, 0x1f, 0xf0, 0x07, 0xfc, 0x01, 0x7f, 0x11, 0x32, 0x54, 0x76, 0x98, 0xba, 0xdc, 0xfe},
+     {  0,   0,   0,   0,  16,  16,  16,  16,  36,  36,  36,  36,  52,  52,  52,  52,
+       68,  68,  68,  68,  84,  84,  84,  84, 104, 104, 104, 104, 120, 120, 120, 120,
+      135, 135, 135, 135, 151, 151, 151, 151, 171, 171, 171, 171, 187, 187, 187, 187,
+      203, 203, 203, 203, 219, 219, 219, 219, 239, 239, 239, 239, 255, 255, 255, 255}},
+    // Endpoints (21, 255, 129, 255) and (200, 0, 64, 126): p-bits 1, 0, a falling channel and
+    // the largest anchor index (7), scattered indices
+    {"mixed",
+     {0x40, 0x05, 0xf9, 0x0f, 0x00, 0x82, 0xfe, 0xbf, 0x0e, 0x3f, 0xc9, 0x51, 0x2e, 0xb8, 0xd6, 0xa4},
+     {105, 135,  99, 195,  21, 255, 129, 255, 200,   0,  64, 126,  57, 203, 116, 229,
+      127, 104,  90, 178, 164,  52,  77, 152,  32, 239, 125, 247,  80, 171, 108, 213,
+      189,  16,  68, 134,  46, 219, 120, 237, 116, 120,  94, 186, 152,  68,  81, 160,
+       94, 151, 103, 203, 175,  36,  73, 144,  69, 187, 112, 221, 141,  84,  85, 168}},
+    // Every index 0: endpoint 0 (91, 181, 7, 255) alone
+    {"solid",
+     {0xc0, 0x16, 0x40, 0x0b, 0x18, 0x00, 0xfe, 0x80, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+     { 91, 181,   7, 255,  91, 181,   7, 255,  91, 181,   7, 255,  91, 181,   7, 255,
+       91, 181,   7, 255,  91, 181,   7, 255,  91, 181,   7, 255,  91, 181,   7, 255,
+       91, 181,   7, 255,  91, 181,   7, 255,  91, 181,   7, 255,  91, 181,   7, 255,
+       91, 181,   7, 255,  91, 181,   7, 255,  91, 181,   7, 255,  91, 181,   7, 255}},
+};
+
+// Known blocks decode exactly; the encoder writes mode 6 and reproduces what mode 6 can hold exactly
+static bool checkKnownBlocks() {
+    bool ok = true;
+    for (const KnownBlock& known : KNOWN_BC7_BLOCKS) {
+        std::vector<uint8_t> decoded = decode_bc_image(known.block, 4, 4, BCFormat::BC7);
+        bool match = memcmp(decoded.data(), known.rgba, 64) == 0;
+        if (!match) {
+            std::cerr << "[EDEN] BC7 block '" << known.name << "' decoded wrong" << std::endl;
+        }
+        ok = ok && match;
+
+        for (BCQuality quality : {BCQuality::Fast, BCQuality::Quality}) {
+            std::vector<uint8_t> block = encode_bc_image(known.rgba, 4, 4, BCFormat::BC7, quality, 1);
+            std::vector<uint8_t> again = decode_bc_image(block.data(), 4, 4, BCFormat::BC7);
+            ok = ok && block.size() == 16 && (block[0] & 0x7f) == 0x40;
+            if (known.name[0] != 'm') {
+                ok = ok && memcmp(again.data(), known.rgba, 64) == 0;
+            }
+        }
+    }
+    return ok;
+}
+
+// The cache key follows the PNG's bytes (not its timestamp), and cache files round-trip
+static bool checkCache() {
+    const std::string directory = "bc_encoder_benchmark_cache";
+    const std::string source = directory + "_source.png";
+    auto writeSource = [&](const char* bytes) {
+        std::ofstream file(source, std::ios::binary | std::ios::trunc);
+        file << bytes;
+    };
+
+    bool ok = true;
+    uint64_t first = 0, same = 0, edited = 0, otherFormat = 0, otherQuality = 0;
+    writeSource("not really a png, 32 bytes long");
+    ok = ok && bc_cache_key(source, BCFormat::BC7, BCQuality::Fast, first);
+    ok = ok && bc_cache_key(source, BCFormat::BC7, BCQuality::Fast, same) && same == first;
+    ok = ok && bc_cache_key(source, BCFormat::BC5, BCQuality::Fast, otherFormat) && otherFormat != first;
+    ok = ok && bc_cache_key(source, BCFormat::BC7, BCQuality::Quality, otherQuality) && otherQuality != first;
+    writeSource("not really a png, 32 bytes lonG");     // Same size, same second
+    ok = ok && bc_cache_key(source, BCFormat::BC7, BCQuality::Fast, edited) && edited != first;
+    std::remove(source.c_str());
+    ok = ok && !bc_cache_key(source, BCFormat::BC7, BCQuality::Fast, edited);
+
+    // A cache file is found under its own key and format only
+    PNGData png;
+    png.width = 4;
+    png.height = 4;
+    png.pixelData.assign(KNOWN_BC7_BLOCKS[0].rgba, KNOWN_BC7_BLOCKS[0].rgba + 64);
+    DDSData dds = transcode_png_to_bc(png, BCFormat::BC7, BCQuality::Fast);
+    std::string path = bc_cache_path(directory, first, BCFormat::BC7);
+    ok = ok && !bc_cache_is_current(path, BCFormat::BC7);
+    ok = ok && bc_save_cache(directory, path, dds);
+    ok = ok && bc_cache_is_current(path, BCFormat::BC7) && !bc_cache_is_current(path, BCFormat::BC5);
+    ok = ok && !bc_cache_is_current(bc_cache_path(directory, edited, BCFormat::BC7), BCFormat::BC7);
+    DDSData loaded = load_dds(path);
+    ok = ok && loaded.format == dds.format && loaded.compressedData == dds.compressedData;
+    std::remove(path.c_str());
+    std::remove(directory.c_str());
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    uint32_t width = 1024, height = 1024;
+    std::vector<uint8_t> rgba;
+    if (argc > 1) {
+        try {
+            PNGData png = load_png(argv[1]);
+            width = png.width;
+            height = png.height;
+            rgba = std::move(png.pixelData);
+        } catch (const std::exception& e) {
+            std::cerr << "[EDEN] " << e.what() << std::endl;
+            return 1;
+        }
+    } else {
+        rgba = makeTestPattern(width, height);
+    }
+    uint32_t threads = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 0;
+
+    struct Case { BCFormat format; const char* name; int channels; };
+    const Case cases[] = {
+        {BCFormat::BC1, "BC1", 3},
+        {BCFormat::BC3, "BC3", 4},
+        {BCFormat::BC5, "BC5", 2},
+        {BCFormat::BC7, "BC7", 4},
+    };
+
+    std::cout << "Image " << width << "x" << height << ", "
+              << (threads ? threads : std::max(1u, std::thread::hardware_concurrency())) << " thread(s)" << std::endl;
+    std::cout << "format  quality   PSNR (dB)   Mpixel/s   MB/s (RGBA in)" << std::endl;
+    for (const Case& c : cases) {
+        for (BCQuality quality : {BCQuality::Fast, BCQuality::Quality}) {
+            auto start = std::chrono::steady_clock::now();
+            std::vector<uint8_t> blocks = encode_bc_image(rgba.data(), width, height, c.format, quality, threads);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::vector<uint8_t> decoded = decode_bc_image(blocks.data(), width, height, c.format);
+            double psnr = rgba_psnr(rgba.data(), decoded.data(), static_cast<size_t>(width) * height, c.channels);
+            double pixels = static_cast<double>(width) * height;
+            std::cout << std::left << std::setw(8) << c.name
+                      << std::setw(10) << (quality == BCQuality::Fast ? "fast" : "quality")
+                      << std::right << std::fixed << std::setprecision(2)
+                      << std::setw(9) << psnr
+                      << std::setw(11) << pixels / seconds / 1e6
+                      << std::setw(13) << pixels * 4 / seconds / (1024.0 * 1024.0) << std::endl;
+        }
+    }
+
+    bool blocksOk = checkKnownBlocks();
+    bool cacheOk = checkCache();
+    std::cout << "known BC7 blocks:  " << (blocksOk ? "yes" : "NO") << std::endl
+              << "cache key:         " << (cacheOk ? "yes" : "NO") << std::endl;
+    return blocksOk && cacheOk ? 0 : 1;
+}
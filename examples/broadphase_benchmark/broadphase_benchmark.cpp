@@ -0,0 +1,144 @@
+// EDEN ENGINE - Broadphase Benchmark
+// Headless correctness and throughput check for stdlib/broadphase.h
+// Usage: broadphase_benchmark [objects] [frames] [threads]
+//   Objects (default 50000) are boxes over a 500 m square level; one in ten is static ground
+//   clutter, the rest drift and bounce inside the level every frame. Each frame the incremental
+//   sweep-and-prune is updated and queried; every tenth frame it is compared against a broadphase
+//   sorted from scratch and against the brute-force reference on a subset of the boxes.
+
+#include "../../stdlib/broadphase.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+
+static float randomFloat(uint32_t& seed, float lo, float hi) {
+    seed = seed * 1664525u + 1013904223u;
+    return lo + (hi - lo) * static_cast<float>(seed >> 8) / 16777216.0f;
+}
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 50000;
+    int frames = argc > 2 ? std::atoi(argv[2]) : 60;
+    uint32_t threads = argc > 3 ? static_cast<uint32_t>(std::atoi(argv[3])) : 0;
+    const float HALF_EXTENT = 250.0f;
+    const float DT = 1.0f / 60.0f;
+    const size_t REFERENCE_COUNT = std::min<size_t>(count, 8000);
+
+    std::vector<float> posX(count), posY(count), posZ(count), size(count);
+    std::vector<float> velX(count), velY(count), velZ(count);
+    std::vector<uint8_t> isStatic(count);
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < count; i++) {
+        isStatic[i] = (i % 10) == 0 ? 1 : 0;
+        posX[i] = randomFloat(seed, -HALF_EXTENT, HALF_EXTENT);
+        posY[i] = randomFloat(seed, 0.0f, 10.0f);
+        posZ[i] = randomFloat(seed, -HALF_EXTENT, HALF_EXTENT);
+        size[i] = randomFloat(seed, 0.5f, 2.0f);
+        velX[i] = isStatic[i] ? 0.0f : randomFloat(seed, -5.0f, 5.0f);
+        velY[i] = isStatic[i] ? 0.0f : randomFloat(seed, -1.0f, 1.0f);
+        velZ[i] = isStatic[i] ? 0.0f : randomFloat(seed, -5.0f, 5.0f);
+    }
+    std::vector<BroadphaseBounds> bounds(count);
+    auto updateBounds = [&]() {
+        for (size_t i = 0; i < count; i++) {
+            bounds[i] = broadphase_bounds_from_center(posX[i], posY[i], posZ[i], size[i], size[i], size[i]);
+        }
+    };
+    updateBounds();
+
+    // Proxy ids equal box indices because proxies are added in order into an empty broadphase
+    SweepAndPrune broadphase;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < count; i++) {
+        broadphase.addProxy(bounds[i], isStatic[i] != 0, static_cast<uint32_t>(i));
+    }
+    std::vector<BroadphasePair> pairs;
+    broadphase.findPairs(pairs, threads);
+    double firstMs = elapsedMs(start);
+
+    std::cout << count << " objects (" << count / 10 << " static), first frame " << std::fixed << std::setprecision(2)
+              << firstMs << " ms, sweep axis " << "XYZ"[broadphase.getSweepAxis()] << std::endl;
+    std::cout << "frame     pairs   update ms   pairs ms   scratch ms   reference ms   match" << std::endl;
+
+    bool allMatch = true;
+    double totalUpdateMs = 0.0;
+    double totalPairsMs = 0.0;
+    std::vector<BroadphasePair> scratchPairs, subsetPairs, referencePairs;
+    for (int frame = 1; frame <= frames; frame++) {
+        // Drift and bounce off the level bounds
+        for (size_t i = 0; i < count; i++) {
+            posX[i] += velX[i] * DT;
+            posY[i] += velY[i] * DT;
+            posZ[i] += velZ[i] * DT;
+            if (posX[i] < -HALF_EXTENT || posX[i] > HALF_EXTENT) velX[i] = -velX[i];
+            if (posY[i] < 0.0f || posY[i] > 10.0f) velY[i] = -velY[i];
+            if (posZ[i] < -HALF_EXTENT || posZ[i] > HALF_EXTENT) velZ[i] = -velZ[i];
+        }
+        updateBounds();
+
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < count; i++) {
+            if (!isStatic[i]) {
+                broadphase.updateProxy(static_cast<uint32_t>(i), bounds[i]);
+            }
+        }
+        double updateMs = elapsedMs(start);
+        start = std::chrono::steady_clock::now();
+        broadphase.findPairs(pairs, threads);
+        double pairsMs = elapsedMs(start);
+        totalUpdateMs += updateMs;
+        totalPairsMs += pairsMs;
+
+        if (frame % 10 != 0 && frame != frames) {
+            continue;
+        }
+
+        // Same boxes through a broadphase that sorts from scratch
+        start = std::chrono::steady_clock::now();
+        SweepAndPrune scratch;
+        for (size_t i = 0; i < count; i++) {
+            scratch.addProxy(bounds[i], isStatic[i] != 0, static_cast<uint32_t>(i));
+        }
+        scratch.findPairs(scratchPairs, threads);
+        double scratchMs = elapsedMs(start);
+
+        // Brute force over the first REFERENCE_COUNT boxes against the pairs among them
+        start = std::chrono::steady_clock::now();
+        broadphase_pairs_reference(bounds.data(), isStatic.data(), REFERENCE_COUNT, referencePairs);
+        double referenceMs = elapsedMs(start);
+        subsetPairs.clear();
+        for (const BroadphasePair& pair : pairs) {
+            if (pair.b < REFERENCE_COUNT) {
+                subsetPairs.push_back(pair);
+            }
+        }
+
+        std::vector<BroadphasePair> sorted = pairs;
+        broadphase_sort_pairs(sorted);
+        broadphase_sort_pairs(scratchPairs);
+        broadphase_sort_pairs(subsetPairs);
+        bool unique = std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end();
+        bool match = unique && sorted == scratchPairs && subsetPairs == referencePairs;
+        allMatch = allMatch && match;
+        std::cout << std::setw(5) << frame
+                  << std::setw(10) << pairs.size()
+                  << std::setprecision(3) << std::setw(12) << updateMs
+                  << std::setw(11) << pairsMs
+                  << std::setw(13) << scratchMs
+                  << std::setw(15) << referenceMs
+                  << std::setw(8) << (match ? "yes" : "NO") << std::endl;
+    }
+
+    if (frames > 0) {
+        std::cout << "average over " << frames << " frames: update " << std::setprecision(3) << totalUpdateMs / frames
+                  << " ms, pairs " << totalPairsMs / frames << " ms ("
+                  << (threads ? threads : std::max(1u, std::thread::hardware_concurrency())) << " thread(s)), reference on "
+                  << REFERENCE_COUNT << " objects" << std::endl;
+    }
+    return allMatch ? 0 : 1;
+}
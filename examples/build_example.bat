@@ -134,7 +134,7 @@ REM Add library paths
 set COMPILE_CMD=%COMPILE_CMD% -L"%VULKAN_SDK_PATH%\Lib" -L"%GLFW_PATH%\build\src"
 
 REM Add libraries
-set COMPILE_CMD=%COMPILE_CMD% -lvulkan-1 -lglfw3 -lgdi32
+set COMPILE_CMD=%COMPILE_CMD% -lvulkan-1 -lshaderc_shared -lglfw3 -lgdi32
 
 REM Execute compile command
 %COMPILE_CMD%
@@ -0,0 +1,157 @@
+// EDEN ENGINE - BVH Benchmark
+// Headless correctness and throughput check for stdlib/bvh.h
+// Usage: bvh_benchmark [objects] [rays] [threads]
+//   Objects (default 100000) are boxes scattered over a 2 km square level. Rays are downward
+//   gravity probes (coherent, traced in packets of four neighbours) and pick rays from a camera.
+//   Finally 10000 dropped items are ground-snapped with one bvh_intersect_batch call.
+
+#include "../../stdlib/bvh.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+
+static float randomFloat(uint32_t& seed, float lo, float hi) {
+    seed = seed * 1664525u + 1013904223u;
+    return lo + (hi - lo) * static_cast<float>(seed >> 8) / 16777216.0f;
+}
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool sameHit(const BvhHit& a, const BvhHit& b) {
+    return a.index == b.index && (a.index < 0 || (a.distance == b.distance && a.normal[0] == b.normal[0] &&
+                                                  a.normal[1] == b.normal[1] && a.normal[2] == b.normal[2]));
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 100000;
+    size_t rayCount = argc > 2 ? static_cast<size_t>(std::atol(argv[2])) : 100000;
+    uint32_t threads = argc > 3 ? static_cast<uint32_t>(std::atoi(argv[3])) : 0;
+    rayCount = (rayCount + 3) & ~static_cast<size_t>(3);
+    const size_t referenceRays = std::min<size_t>(rayCount, 1000);
+
+    std::vector<BvhBounds> bounds(count);
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < count; i++) {
+        float sx = randomFloat(seed, 0.5f, 4.0f);
+        float sy = randomFloat(seed, 0.5f, 4.0f);
+        float sz = randomFloat(seed, 0.5f, 4.0f);
+        bounds[i] = bvh_bounds_from_center(randomFloat(seed, -1000.0f, 1000.0f), randomFloat(seed, 0.0f, 20.0f),
+                                           randomFloat(seed, -1000.0f, 1000.0f), sx, sy, sz);
+    }
+
+    // Downward probes in groups of four neighbours, and pick rays from a camera above the level
+    std::vector<BvhRay> probes(rayCount), picks(rayCount);
+    for (size_t i = 0; i < rayCount; i += 4) {
+        float x = randomFloat(seed, -1000.0f, 1000.0f);
+        float z = randomFloat(seed, -1000.0f, 1000.0f);
+        for (size_t lane = 0; lane < 4; lane++) {
+            probes[i + lane] = bvh_make_ray(x + lane * 0.25f, 50.0f, z, 0.0f, -1.0f, 0.0f, 100.0f);
+        }
+    }
+    for (size_t i = 0; i < rayCount; i++) {
+        float dx = randomFloat(seed, -1.0f, 1.0f);
+        float dy = randomFloat(seed, -0.6f, -0.05f);
+        float dz = randomFloat(seed, -1.0f, 1.0f);
+        float length = std::sqrt(dx * dx + dy * dy + dz * dz);
+        picks[i] = bvh_make_ray(0.0f, 30.0f, 0.0f, dx / length, dy / length, dz / length, 2000.0f);
+    }
+
+    Bvh bvh;
+    auto start = std::chrono::steady_clock::now();
+    bvh.build(bounds.data(), bounds.size());
+    double buildMs = elapsedMs(start);
+
+    std::vector<BvhBounds> moved = bounds;
+    for (BvhBounds& box : moved) {
+        float dy = randomFloat(seed, -0.5f, 0.5f);
+        box.min[1] += dy;
+        box.max[1] += dy;
+    }
+    start = std::chrono::steady_clock::now();
+    bvh.refit(moved.data(), moved.size());
+    double refitMs = elapsedMs(start);
+
+    std::cout << count << " objects, " << bvh.getNodeCount() << " nodes, build " << std::fixed << std::setprecision(2)
+              << buildMs << " ms, refit " << refitMs << " ms" << std::endl;
+    std::cout << "rays       hits   linear us/ray   bvh us/ray   packet us/ray   match" << std::endl;
+
+    bool allMatch = true;
+    for (int set = 0; set < 2; set++) {
+        const std::vector<BvhRay>& rays = set == 0 ? probes : picks;
+        std::vector<BvhHit> reference(referenceRays), single(rayCount), packet(rayCount);
+
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < referenceRays; i++) {
+            reference[i] = bvh_raycast_reference(moved.data(), moved.size(), rays[i]);
+        }
+        double linearUs = elapsedMs(start) * 1000.0 / referenceRays;
+
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < rayCount; i++) {
+            single[i] = bvh.intersect(rays[i]);
+        }
+        double singleUs = elapsedMs(start) * 1000.0 / rayCount;
+
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < rayCount; i += 4) {
+            bvh.intersect4(&rays[i], &packet[i]);
+        }
+        double packetUs = elapsedMs(start) * 1000.0 / rayCount;
+
+        bool match = true;
+        size_t hits = 0;
+        for (size_t i = 0; i < rayCount; i++) {
+            match = match && sameHit(single[i], packet[i]) && (i >= referenceRays || sameHit(single[i], reference[i]));
+            hits += single[i].index >= 0 ? 1 : 0;
+        }
+        allMatch = allMatch && match;
+        std::cout << std::left << std::setw(8) << (set == 0 ? "probe" : "pick")
+                  << std::right << std::setw(8) << hits
+                  << std::setprecision(3) << std::setw(16) << linearUs
+                  << std::setw(13) << singleUs
+                  << std::setw(16) << packetUs
+                  << std::setw(8) << (match ? "yes" : "NO") << std::endl;
+    }
+
+    // Ground-snap dropped items with one batched call
+    const size_t SNAP_ITEMS = 10000;
+    std::vector<float> itemX(SNAP_ITEMS), itemY(SNAP_ITEMS, 50.0f), itemZ(SNAP_ITEMS);
+    for (size_t i = 0; i < SNAP_ITEMS; i++) {
+        itemX[i] = randomFloat(seed, -1000.0f, 1000.0f);
+        itemZ[i] = randomFloat(seed, -1000.0f, 1000.0f);
+    }
+    std::vector<int32_t> snapIndex(SNAP_ITEMS);
+    std::vector<float> snapDistance(SNAP_ITEMS);
+    BvhRayBatch batch;
+    batch.originX = itemX.data();
+    batch.originY = itemY.data();
+    batch.originZ = itemZ.data();
+    batch.count = SNAP_ITEMS;
+    batch.tMax = 100.0f;
+    BvhHitBatch results;
+    results.index = snapIndex.data();
+    results.distance = snapDistance.data();
+
+    const int iterations = 20;
+    size_t snapped = 0;
+    start = std::chrono::steady_clock::now();
+    for (int it = 0; it < iterations; it++) {
+        snapped = bvh_intersect_batch(bvh, batch, results, threads);
+    }
+    double batchMs = elapsedMs(start) / iterations;
+
+    bool batchMatch = true;
+    for (size_t i = 0; i < SNAP_ITEMS; i++) {
+        BvhHit hit = bvh.intersect(bvh_make_ray(itemX[i], itemY[i], itemZ[i], 0.0f, -1.0f, 0.0f, 100.0f));
+        batchMatch = batchMatch && hit.index == snapIndex[i] && hit.distance == snapDistance[i];
+    }
+    allMatch = allMatch && batchMatch;
+    std::cout << "batch   " << SNAP_ITEMS << " ground snaps, " << snapped << " hits, " << std::setprecision(3) << batchMs
+              << " ms per call (" << (threads ? threads : std::max(1u, std::thread::hardware_concurrency()))
+              << " thread(s)), match " << (batchMatch ? "yes" : "NO") << std::endl;
+    return allMatch ? 0 : 1;
+}
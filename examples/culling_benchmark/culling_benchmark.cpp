@@ -0,0 +1,111 @@
+// EDEN ENGINE - Culling Benchmark
+// Headless correctness and throughput check for stdlib/frustum_culler.h
+// Usage: culling_benchmark [objects] [threads]
+//   Objects (default 100000) are scattered through a 2 km cube around a camera at the origin
+//   looking down -Z with the FPS renderer's projection (70 degree FOV, 0.1 - 2000, Vulkan depth).
+
+#include "../../stdlib/frustum_culler.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+
+#ifdef EDEN_CULL_SSE2
+static const char* const CULL_PATH = "SSE2";
+#else
+static const char* const CULL_PATH = "scalar";
+#endif
+
+// glm::perspectiveRH_ZO with the renderer's Y flip, column-major
+static void makeProjection(float fovY, float aspect, float nearPlane, float farPlane, float out[16]) {
+    float f = 1.0f / std::tan(fovY * 0.5f);
+    memset(out, 0, sizeof(float) * 16);
+    out[0] = f / aspect;
+    out[5] = -f;
+    out[10] = farPlane / (nearPlane - farPlane);
+    out[11] = -1.0f;
+    out[14] = -(farPlane * nearPlane) / (farPlane - nearPlane);
+}
+
+// View matrix for a camera at the origin turned by yaw (radians) about +Y
+static void makeView(float yaw, float out[16]) {
+    float c = std::cos(yaw), s = std::sin(yaw);
+    memset(out, 0, sizeof(float) * 16);
+    out[0] = c;  out[2] = s;
+    out[5] = 1.0f;
+    out[8] = -s; out[10] = c;
+    out[15] = 1.0f;
+}
+
+static float randomFloat(uint32_t& seed, float lo, float hi) {
+    seed = seed * 1664525u + 1013904223u;
+    return lo + (hi - lo) * static_cast<float>(seed >> 8) / 16777216.0f;
+}
+
+template <typename Fn>
+static double averageMilliseconds(int iterations, Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        fn();
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 100000;
+    uint32_t threads = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 0;
+    const int iterations = 50;
+
+    CullBoxes boxes;
+    CullSpheres spheres;
+    boxes.reserve(count);
+    spheres.reserve(count);
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < count; i++) {
+        float x = randomFloat(seed, -1000.0f, 1000.0f);
+        float y = randomFloat(seed, -50.0f, 50.0f);
+        float z = randomFloat(seed, -1000.0f, 1000.0f);
+        float size = randomFloat(seed, 0.25f, 4.0f);
+        boxes.add(x, y, z, size, size * 0.5f, size);
+        spheres.add(x, y, z, size);
+    }
+
+    float view[16], proj[16];
+    makeView(0.3f, view);
+    makeProjection(70.0f * 3.14159265f / 180.0f, 16.0f / 9.0f, 0.1f, 2000.0f, proj);
+
+    std::cout << count << " objects, "
+              << (threads ? threads : std::max(1u, std::thread::hardware_concurrency())) << " thread(s)"
+              << ", " << CULL_PATH << std::endl;
+    std::cout << "test                 visible   reference ms   culler ms   speedup   match" << std::endl;
+
+    bool allMatch = true;
+    for (float maxDistance : {0.0f, 500.0f}) {
+        CullParams params;
+        params.planes = extract_frustum_planes(view, proj);
+        params.maxDistance = maxDistance;
+
+        std::vector<uint32_t> expected, visible;
+        for (int shape = 0; shape < 2; shape++) {
+            double referenceMs, cullerMs;
+            if (shape == 0) {
+                referenceMs = averageMilliseconds(iterations, [&]() { cull_boxes_reference(boxes, params, expected); });
+                cullerMs = averageMilliseconds(iterations, [&]() { cull_boxes(boxes, params, visible, threads); });
+            } else {
+                referenceMs = averageMilliseconds(iterations, [&]() { cull_spheres_reference(spheres, params, expected); });
+                cullerMs = averageMilliseconds(iterations, [&]() { cull_spheres(spheres, params, visible, threads); });
+            }
+            bool match = expected == visible;
+            allMatch = allMatch && match;
+            std::cout << std::left << std::setw(20)
+                      << (std::string(shape == 0 ? "boxes" : "spheres") + (maxDistance > 0.0f ? " + distance" : ""))
+                      << std::right << std::setw(9) << visible.size()
+                      << std::fixed << std::setprecision(3)
+                      << std::setw(15) << referenceMs
+                      << std::setw(12) << cullerMs
+                      << std::setprecision(2) << std::setw(9) << referenceMs / cullerMs << "x"
+                      << std::setw(8) << (match ? "yes" : "NO") << std::endl;
+        }
+    }
+    return allMatch ? 0 : 1;
+}
@@ -0,0 +1,189 @@
+// EDEN ENGINE - Debug Draw Benchmark
+// Headless batching cost and geometry check for stdlib/debug_draw.h
+// Usage: debug_draw_benchmark [primitives] [frames]
+//   Each frame (default 300) submits `primitives` (default 10000) debug primitives, the mix an
+//   editor draws: selection boxes, rays, spot light cones, spheres and plain lines, a quarter of
+//   them as overlay. The batch is then built into a vertex buffer the way the renderer does it.
+
+#include "../../stdlib/debug_draw.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <algorithm>
+
+static float randomFloat(uint32_t& seed, float lo, float hi) {
+    seed = seed * 1664525u + 1013904223u;
+    return lo + (hi - lo) * static_cast<float>(seed >> 8) / 16777216.0f;
+}
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static float distance(const float* a, const float* b) {
+    float dx = a[0] - b[0];
+    float dy = a[1] - b[1];
+    float dz = a[2] - b[2];
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+// Vertices each primitive kind adds (with the default segment counts)
+static const size_t LINE_VERTICES = 2;
+static const size_t BOX_VERTICES = 24;
+static const size_t CONE_VERTICES = (32 + 8) * 2;
+static const size_t SPHERE_VERTICES = 32 * 3 * 2;
+
+// One frame of the editor-like mix; returns the vertices it should produce
+static size_t submitFrame(DebugDrawList& debug, size_t primitives, uint32_t seed) {
+    size_t expected = 0;
+    for (size_t i = 0; i < primitives; i++) {
+        DebugDrawCategory category = (i % 4 == 3) ? DebugDrawCategory::Overlay : DebugDrawCategory::Depth;
+        uint32_t color = debug_pack_color(randomFloat(seed, 0, 1), randomFloat(seed, 0, 1), randomFloat(seed, 0, 1));
+        float p[3] = {randomFloat(seed, -500, 500), randomFloat(seed, 0, 50), randomFloat(seed, -500, 500)};
+        switch (i % 10) {
+            case 0: case 1: case 2: case 3: {
+                float rotation[3] = {randomFloat(seed, 0, 360), randomFloat(seed, 0, 360), randomFloat(seed, 0, 360)};
+                float size[3] = {randomFloat(seed, 0.5f, 4), randomFloat(seed, 0.5f, 4), randomFloat(seed, 0.5f, 4)};
+                debug.box(p, rotation, size, color, category);
+                expected += BOX_VERTICES;
+                break;
+            }
+            case 4: case 5: {
+                float dir[3] = {randomFloat(seed, -1, 1), -1.0f, randomFloat(seed, -1, 1)};
+                debug.ray(p, dir, 100.0f, color, category);
+                expected += LINE_VERTICES;
+                break;
+            }
+            case 6: {
+                float dir[3] = {randomFloat(seed, -1, 1), -1.0f, randomFloat(seed, -1, 1)};
+                debug.cone(p, dir, 20.0f, 0.785f, color, category);
+                expected += CONE_VERTICES;
+                break;
+            }
+            case 7: {
+                debug.sphere(p, randomFloat(seed, 0.5f, 5), color, category);
+                expected += SPHERE_VERTICES;
+                break;
+            }
+            default: {
+                debug.line(p[0], p[1], p[2], p[0] + 1.0f, p[1] + 2.0f, p[2] + 3.0f, color, category);
+                expected += LINE_VERTICES;
+                break;
+            }
+        }
+    }
+    return expected;
+}
+
+// Shapes with known answers: box corners on the half diagonal, cone rim on the slant, exact lines
+static bool checkGeometry() {
+    DebugDrawList debug;
+    bool ok = true;
+
+    float center[3] = {10.0f, 5.0f, -3.0f};
+    float rotation[3] = {30.0f, 45.0f, 60.0f};
+    float size[3] = {2.0f, 4.0f, 6.0f};
+    debug.box(center, rotation, size, debug_pack_color(1, 1, 1));
+    float halfDiagonal = 0.5f * std::sqrt(4.0f + 16.0f + 36.0f);
+    for (const DebugVertex& vertex : debug.getVertices(DebugDrawCategory::Depth)) {
+        ok = ok && std::fabs(distance(vertex.position, center) - halfDiagonal) < 1e-4f;
+    }
+    // Every edge of a rotated box still has one of the three side lengths
+    const std::vector<DebugVertex>& edges = debug.getVertices(DebugDrawCategory::Depth);
+    for (size_t e = 0; e < edges.size(); e += 2) {
+        float length = distance(edges[e].position, edges[e + 1].position);
+        ok = ok && (std::fabs(length - 2.0f) < 1e-4f || std::fabs(length - 4.0f) < 1e-4f || std::fabs(length - 6.0f) < 1e-4f);
+    }
+
+    debug.clear();
+    float apex[3] = {0.0f, 10.0f, 0.0f};
+    float dir[3] = {0.3f, -1.0f, 0.2f};
+    float range = 8.0f;
+    float halfAngle = 0.5f;
+    debug.cone(apex, dir, range, halfAngle, debug_pack_color(1, 1, 0), DebugDrawCategory::Overlay);
+    float slant = range / std::cos(halfAngle);
+    for (const DebugVertex& vertex : debug.getVertices(DebugDrawCategory::Overlay)) {
+        float d = distance(vertex.position, apex);
+        ok = ok && (d < 1e-5f || std::fabs(d - slant) < 1e-3f);
+    }
+    ok = ok && debug.getVertices(DebugDrawCategory::Depth).empty();
+
+    debug.clear();
+    debug.line(1, 2, 3, 4, 5, 6, debug_pack_color(0, 1, 0));
+    const DebugVertex* line = debug.getVertices(DebugDrawCategory::Depth).data();
+    ok = ok && line[0].position[0] == 1.0f && line[1].position[2] == 6.0f && line[0].color == 0xFF00FF00u;
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    size_t primitives = argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 10000;
+    int frames = argc > 2 ? std::atoi(argv[2]) : 300;
+    frames = std::max(frames, 1);
+
+    // Budget with room for the whole mix; the mapped buffer is one region of that size
+    DebugDrawList debug(primitives * SPHERE_VERTICES + 2);
+    std::vector<DebugVertex> mapped(debug.getMaxVertices());
+    DebugDrawRange ranges[DEBUG_DRAW_CATEGORY_COUNT];
+
+    double submitMs = 0.0;
+    double buildMs = 0.0;
+    double worstMs = 0.0;
+    bool countsOk = true;
+    bool rangesOk = true;
+    size_t capacityAfterFirst = 0;
+    size_t vertices = 0;
+    for (int frame = 0; frame < frames; frame++) {
+        auto start = std::chrono::steady_clock::now();
+        debug.clear();
+        size_t expected = submitFrame(debug, primitives, 1234u + static_cast<uint32_t>(frame));
+        double submitted = elapsedMs(start);
+        auto buildStart = std::chrono::steady_clock::now();
+        vertices = debug.build(mapped.data(), mapped.size(), ranges);
+        double built = elapsedMs(buildStart);
+        submitMs += submitted;
+        buildMs += built;
+        worstMs = std::max(worstMs, submitted + built);
+
+        countsOk = countsOk && vertices == expected && debug.getDroppedPrimitives() == 0;
+        rangesOk = rangesOk && ranges[0].firstVertex == 0 && ranges[1].firstVertex == ranges[0].vertexCount &&
+                   ranges[0].vertexCount + ranges[1].vertexCount == vertices &&
+                   ranges[0].vertexCount % 2 == 0 && ranges[1].vertexCount % 2 == 0;
+        size_t capacity = debug.getVertices(DebugDrawCategory::Depth).capacity() +
+                          debug.getVertices(DebugDrawCategory::Overlay).capacity();
+        if (frame == 0) {
+            capacityAfterFirst = capacity;
+        }
+        rangesOk = rangesOk && capacity == capacityAfterFirst;
+    }
+
+    // Over budget: whole primitives are dropped and counted, nothing partial reaches the buffer
+    DebugDrawList small(1000);
+    submitFrame(small, primitives, 99u);
+    bool budgetOk = small.getVertexCount() <= 1000 && small.getVertexCount() % 2 == 0 &&
+                    (primitives < 100 || small.getDroppedPrimitives() > 0);
+    DebugDrawRange smallRanges[DEBUG_DRAW_CATEGORY_COUNT];
+    std::vector<DebugVertex> smallMapped(101);
+    size_t cut = small.build(smallMapped.data(), smallMapped.size(), smallRanges);
+    budgetOk = budgetOk && cut <= 100 && cut % 2 == 0;
+
+    bool geometryOk = checkGeometry();
+    uint32_t draws = (ranges[0].vertexCount > 0 ? 1u : 0u) + (ranges[1].vertexCount > 0 ? 1u : 0u);
+
+    std::cout << std::fixed << primitives << " primitives per frame, " << frames << " frames" << std::endl;
+    std::cout << std::setprecision(3)
+              << "lines per frame:      " << vertices / 2 << " (" << ranges[0].vertexCount / 2 << " depth, "
+              << ranges[1].vertexCount / 2 << " overlay)" << std::endl
+              << "vertex data:          " << std::setprecision(2) << vertices * sizeof(DebugVertex) / (1024.0 * 1024.0) << " MB" << std::endl
+              << std::setprecision(3)
+              << "submit ms / frame:    " << submitMs / frames << std::endl
+              << "build ms / frame:     " << buildMs / frames << std::endl
+              << "worst frame ms:       " << worstMs << std::endl
+              << "draw calls:           " << draws << " (one per primitive: " << primitives << ")" << std::endl;
+    std::cout << "vertex counts match:  " << (countsOk ? "yes" : "NO") << std::endl
+              << "ranges, no regrowth:  " << (rangesOk ? "yes" : "NO") << std::endl
+              << "budget drops whole:   " << (budgetOk ? "yes" : "NO") << std::endl
+              << "geometry:             " << (geometryOk ? "yes" : "NO") << std::endl;
+    return countsOk && rangesOk && budgetOk && geometryOk ? 0 : 1;
+}
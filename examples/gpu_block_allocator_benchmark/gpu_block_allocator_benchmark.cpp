@@ -0,0 +1,228 @@
+// EDEN ENGINE - GPU Block Allocator Benchmark
+// Headless TLSF bookkeeping check for stdlib/gpu_block_allocator.h
+// Usage: gpu_block_allocator_benchmark [block_mb] [operations]
+//   Churns a `block_mb` (default 256) block with `operations` (default 200000) allocate/free calls
+//   in the mix a renderer makes (small buffers, large images, 16 B - 64 KB alignments) and checks
+//   every result against a shadow map of the live allocations: no overlap, alignment, exact
+//   accounting, and that the free ranges are exactly the gaps between allocations (full coalescing).
+
+#include "../../stdlib/gpu_block_allocator.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <map>
+#include <vector>
+#include <algorithm>
+
+static uint32_t randomInt(uint32_t& seed, uint32_t lo, uint32_t hi) {
+    seed = seed * 1664525u + 1013904223u;
+    return lo + (seed >> 8) % (hi - lo + 1);
+}
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Live allocations in address order: offset -> reserved size
+typedef std::map<uint64_t, uint64_t> Shadow;
+
+// Whether some gap between live allocations holds `size` bytes at `alignment`
+static bool shadowFits(const Shadow& live, uint64_t capacity, uint64_t size, uint64_t alignment) {
+    uint64_t cursor = 0;
+    auto fits = [&](uint64_t begin, uint64_t end) {
+        uint64_t aligned = (begin + alignment - 1) & ~(alignment - 1);
+        return aligned + size <= end;
+    };
+    for (const auto& entry : live) {
+        if (entry.first > cursor && fits(cursor, entry.first)) {
+            return true;
+        }
+        cursor = entry.first + entry.second;
+    }
+    return fits(cursor, capacity);
+}
+
+// Gaps between live allocations, which must be exactly the allocator's free ranges
+static void shadowGaps(const Shadow& live, uint64_t capacity, uint32_t& count, uint64_t& largest) {
+    count = 0;
+    largest = 0;
+    uint64_t cursor = 0;
+    for (const auto& entry : live) {
+        if (entry.first > cursor) {
+            count++;
+            largest = std::max(largest, entry.first - cursor);
+        }
+        cursor = entry.first + entry.second;
+    }
+    if (capacity > cursor) {
+        count++;
+        largest = std::max(largest, capacity - cursor);
+    }
+}
+
+struct ChurnResult {
+    uint64_t allocations = 0;
+    uint64_t frees = 0;
+    uint64_t failures = 0;
+    uint64_t peakUsed = 0;
+    uint32_t peakFreeRanges = 0;
+    bool placementOk = true;    // Aligned, in the block, at least the requested size, no overlap
+    bool accountingOk = true;   // Used bytes and allocation count match the shadow map
+    bool coalescedOk = true;    // Free ranges == gaps between allocations; whole block after draining
+    bool failureOk = true;      // A failure means no free range holds the request once aligned
+    double ms = 0.0;
+};
+
+static ChurnResult churn(uint64_t capacity, uint64_t operations, bool check) {
+    GpuBlockAllocator block(capacity);
+    ChurnResult result;
+    Shadow live;
+    std::vector<uint64_t> offsets;
+    uint32_t seed = 777u;
+    static const uint64_t ALIGNMENTS[] = {16, 256, 4096, 65536};
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t op = 0; op < operations; op++) {
+        // Fill to half, then an even mix of allocations and frees (use climbs to ~90%)
+        bool allocate = offsets.empty() || block.getUsedBytes() < capacity / 2 || randomInt(seed, 0, 99) < 50;
+        if (allocate) {
+            uint64_t size = randomInt(seed, 0, 9) == 0 ? randomInt(seed, 64 * 1024, 8 * 1024 * 1024)   // Image
+                                                       : randomInt(seed, 1, 256 * 1024);                // Buffer
+            uint64_t alignment = ALIGNMENTS[randomInt(seed, 0, 3)];
+            uint64_t offset = block.allocate(size, alignment);
+            if (offset == GpuBlockAllocator::INVALID_OFFSET) {
+                result.failures++;
+                if (check) {
+                    result.failureOk = result.failureOk && !shadowFits(live, capacity, size, alignment);
+                }
+                continue;
+            }
+            result.allocations++;
+            offsets.push_back(offset);
+            if (check) {
+                uint64_t reserved = block.getAllocationSize(offset);
+                bool placed = offset % alignment == 0 && reserved >= size && offset + reserved <= capacity;
+                auto next = live.lower_bound(offset);
+                if (next != live.end()) {
+                    placed = placed && offset + reserved <= next->first;
+                }
+                if (next != live.begin()) {
+                    auto prev = std::prev(next);
+                    placed = placed && prev->first + prev->second <= offset;
+                }
+                result.placementOk = result.placementOk && placed;
+                live[offset] = reserved;
+            }
+        } else {
+            size_t pick = randomInt(seed, 0, static_cast<uint32_t>(offsets.size() - 1));
+            block.free(offsets[pick]);
+            if (check) {
+                live.erase(offsets[pick]);
+            }
+            offsets[pick] = offsets.back();
+            offsets.pop_back();
+            result.frees++;
+        }
+        result.peakUsed = std::max(result.peakUsed, block.getUsedBytes());
+        result.peakFreeRanges = std::max(result.peakFreeRanges, block.getFreeRangeCount());
+
+        if (check && op % 64 == 0) {
+            uint64_t used = 0;
+            for (const auto& entry : live) {
+                used += entry.second;
+            }
+            result.accountingOk = result.accountingOk && block.getUsedBytes() == used &&
+                                  block.getFreeBytes() == capacity - used && block.getAllocationCount() == live.size();
+            uint32_t gaps;
+            uint64_t largest;
+            shadowGaps(live, capacity, gaps, largest);
+            result.coalescedOk = result.coalescedOk && block.getFreeRangeCount() == gaps && block.getLargestFree() == largest;
+        }
+    }
+
+    // Drain in random order: the block must be one free range again
+    while (!offsets.empty()) {
+        size_t pick = randomInt(seed, 0, static_cast<uint32_t>(offsets.size() - 1));
+        block.free(offsets[pick]);
+        offsets[pick] = offsets.back();
+        offsets.pop_back();
+        result.frees++;
+    }
+    result.ms = elapsedMs(start);
+    result.coalescedOk = result.coalescedOk && block.isEmpty() && block.getUsedBytes() == 0 &&
+                         block.getFreeRangeCount() == 1 && block.getLargestFree() == capacity;
+    return result;
+}
+
+// Hand-traced sequence with known offsets
+static bool checkKnownSequence() {
+    GpuBlockAllocator block(1024);
+    bool ok = block.allocate(100, 1) == 0;
+    ok = ok && block.allocate(100, 256) == 256;         // [100, 256) stays free as padding
+    ok = ok && block.getFreeRangeCount() == 2 && block.getLargestFree() == 668;
+    ok = ok && block.allocate(50, 4) == 100;            // Best class: the 156-byte padding range
+    ok = ok && block.getUsedBytes() == 250 && block.getAllocationSize(100) == 50;
+
+    block.free(256);                                    // Merges with [150, 256) and [356, 1024)
+    ok = ok && block.getFreeRangeCount() == 1 && block.getLargestFree() == 874;
+    block.free(256);                                    // Double free and unknown offsets are ignored
+    block.free(12345);
+    ok = ok && block.getUsedBytes() == 150 && block.getAllocationCount() == 2;
+    block.free(0);
+    block.free(100);                                    // Merges on both sides
+    ok = ok && block.isEmpty() && block.getFreeRangeCount() == 1 && block.getLargestFree() == 1024;
+
+    // Exactly full, then nothing fits; zero-sized and oversized requests are refused
+    ok = ok && block.allocate(1024, 1024) == 0 && block.getFreeRangeCount() == 0;
+    ok = ok && block.allocate(1, 1) == GpuBlockAllocator::INVALID_OFFSET;
+    block.free(0);
+    ok = ok && block.allocate(0, 1) == GpuBlockAllocator::INVALID_OFFSET &&
+         block.allocate(1025, 1) == GpuBlockAllocator::INVALID_OFFSET;
+
+    // An aligned free range is used even though it has no room for worst-case padding
+    ok = ok && block.allocate(512, 256) == 0 && block.allocate(512, 512) == 512;
+    block.free(0);
+    block.free(512);
+
+    // Fragmentation: every other 64-byte slot freed leaves 8 holes that merge as neighbours go
+    uint64_t slots[16];
+    for (int i = 0; i < 16; i++) {
+        slots[i] = block.allocate(64, 64);
+        ok = ok && slots[i] == static_cast<uint64_t>(i) * 64;
+    }
+    for (int i = 0; i < 16; i += 2) {
+        block.free(slots[i]);
+    }
+    ok = ok && block.getFreeRangeCount() == 8 && block.getLargestFree() == 64;
+    ok = ok && block.allocate(128, 1) == GpuBlockAllocator::INVALID_OFFSET;
+    for (int i = 1; i < 16; i += 2) {
+        block.free(slots[i]);
+    }
+    ok = ok && block.getFreeRangeCount() == 1 && block.getLargestFree() == 1024;
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    uint64_t capacity = (argc > 1 ? static_cast<uint64_t>(std::atol(argv[1])) : 256) * 1024 * 1024;
+    uint64_t operations = argc > 2 ? static_cast<uint64_t>(std::atol(argv[2])) : 200000;
+    capacity = std::max<uint64_t>(capacity, 16 * 1024 * 1024);
+
+    ChurnResult checked = churn(capacity, operations, true);
+    ChurnResult timed = churn(capacity, operations, false);
+    bool knownOk = checkKnownSequence();
+
+    std::cout << std::fixed << capacity / (1024 * 1024) << " MB block, " << operations << " operations" << std::endl;
+    std::cout << "allocations / frees:  " << checked.allocations << " / " << checked.frees << std::endl
+              << "failed allocations:   " << checked.failures << std::endl
+              << "peak use:             " << std::setprecision(1) << 100.0 * checked.peakUsed / capacity << "%" << std::endl
+              << "peak free ranges:     " << checked.peakFreeRanges << std::endl
+              << "ns per operation:     " << timed.ms * 1e6 / std::max<uint64_t>(timed.allocations + timed.frees, 1) << std::endl;
+    std::cout << "no overlap, aligned:  " << (checked.placementOk ? "yes" : "NO") << std::endl
+              << "accounting:           " << (checked.accountingOk ? "yes" : "NO") << std::endl
+              << "full coalescing:      " << (checked.coalescedOk ? "yes" : "NO") << std::endl
+              << "failures justified:   " << (checked.failureOk ? "yes" : "NO") << std::endl
+              << "known sequence:       " << (knownOk ? "yes" : "NO") << std::endl;
+    return checked.placementOk && checked.accountingOk && checked.coalescedOk && checked.failureOk && knownOk ? 0 : 1;
+}
@@ -114,7 +114,7 @@ if defined VULKAN_SDK_PATH (
     if exist "%VULKAN_SDK_PATH%\Lib" (
         set "COMPILE_CMD=!COMPILE_CMD! -L%VULKAN_SDK_PATH%\Lib"
     )
-    set "LINK_LIBS=!LINK_LIBS! -lvulkan-1"
+    set "LINK_LIBS=!LINK_LIBS! -lvulkan-1 -lshaderc_shared"
 )
 
 REM Add Vulkan helper source file to compile
@@ -0,0 +1,110 @@
+// EDEN ENGINE - Image Decode Benchmark
+// Decodes every PNG / JPEG / BMP in a folder, comparing the old one-at-a-time path
+// (stbi_load forcing RGBA, then a copy) with ImageDecoder batches straight into one staging block.
+// Usage: image_decode_benchmark [folder] [threads] [passes]
+//   folder defaults to gateway_editor_v1/textures (the editor's textures), threads to all cores.
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "../../stdlib/image_decoder.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <filesystem>
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void report(const char* name, double seconds, size_t images, uint64_t bytes) {
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << seconds * 1000.0 << " ms"
+              << std::setw(10) << images / seconds << " img/s"
+              << std::setw(10) << bytes / seconds / (1024.0 * 1024.0) << " MB/s" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::string folder = argc > 1 ? argv[1] : "gateway_editor_v1/textures";
+    uint32_t threads = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 0;
+    int passes = argc > 3 ? std::max(1, std::atoi(argv[3])) : 5;
+
+    std::vector<std::string> paths;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(folder, error)) {
+        std::string extension = entry.path().extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+        if (extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".bmp") {
+            paths.push_back(entry.path().string());
+        }
+    }
+    if (paths.empty()) {
+        std::cerr << "[EDEN] No PNG/JPEG/BMP files in " << folder << std::endl;
+        return 1;
+    }
+
+    // Size one staging block for a whole pass (what an upload ring would hand out)
+    size_t stagingSize = 0;
+    for (const std::string& path : paths) {
+        int width, height, channels;
+        if (stbi_info(path.c_str(), &width, &height, &channels)) {
+            stagingSize += static_cast<size_t>(width) * height * 4;
+        }
+    }
+    std::vector<uint8_t> staging(stagingSize);
+    uint64_t passBytes = stagingSize;
+
+    std::cout << paths.size() << " images, " << std::fixed << std::setprecision(1)
+              << passBytes / (1024.0 * 1024.0) << " MB RGBA8 per pass, best of " << passes << std::endl;
+
+    // Old path: decode to a forced-RGBA stb buffer, copy into a vector, one image at a time
+    double best = 1e30;
+    for (int pass = 0; pass < passes; pass++) {
+        auto start = std::chrono::steady_clock::now();
+        for (const std::string& path : paths) {
+            int width, height, channels;
+            stbi_uc* pixels = stbi_load(path.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+            if (!pixels) {
+                continue;
+            }
+            std::vector<uint8_t> copy(static_cast<size_t>(width) * height * 4);
+            memcpy(copy.data(), pixels, copy.size());
+            stbi_image_free(pixels);
+        }
+        best = std::min(best, secondsSince(start));
+    }
+    report("stbi_load + copy (serial)", best, paths.size(), passBytes);
+
+    // ImageDecoder: native-channel decode, SIMD expansion into the staging block
+    uint32_t maxThreads = threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+    for (uint32_t threadCount : {1u, maxThreads}) {
+        ImageDecoder decoder(threadCount);
+        std::atomic<size_t> stagingUsed{0};
+        std::vector<ImageDecodeJob> jobs(paths.size());
+        for (size_t i = 0; i < paths.size(); i++) {
+            jobs[i].path = paths[i];
+            jobs[i].destination = [&](const ImageInfo& info) -> uint8_t* {
+                size_t offset = stagingUsed.fetch_add(info.rgba8Size());
+                return offset + info.rgba8Size() <= staging.size() ? staging.data() + offset : nullptr;
+            };
+        }
+
+        best = 1e30;
+        for (int pass = 0; pass < passes; pass++) {
+            stagingUsed = 0;
+            auto start = std::chrono::steady_clock::now();
+            decoder.decode(jobs);
+            best = std::min(best, secondsSince(start));
+        }
+        for (const ImageDecodeJob& job : jobs) {
+            if (!job.ok) {
+                std::cerr << "[EDEN] " << job.error << std::endl;
+            }
+        }
+
+        std::string name = "ImageDecoder, " + std::to_string(threadCount) + " thread(s)";
+        report(name.c_str(), best, paths.size(), passBytes);
+        if (threadCount == maxThreads) {
+            break;
+        }
+    }
+    return 0;
+}
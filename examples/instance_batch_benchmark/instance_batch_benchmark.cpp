@@ -0,0 +1,219 @@
+// EDEN ENGINE - Instance Batch Benchmark
+// Headless speed and correctness check for stdlib/instance_batch.h (the instanced-draw CPU stage)
+// Usage: instance_batch_benchmark [instances] [frames]
+//   Each frame (default 300) refills an InstanceBatch with `instances` (default 100000) transforms
+//   and builds them into an instance buffer, the way heidic_render_fps does for the colored cubes.
+//   Every record is compared with translate * rotateY * scale built by a generic 4x4 multiply in
+//   double precision, and a few transforms with known matrices and bounds follow.
+
+#include "../../stdlib/instance_batch.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <cstddef>
+#include <algorithm>
+
+// Keeps the timed reference loop from being optimized away
+static volatile double g_sink = 0.0;
+
+static float randomFloat(uint32_t& seed, float lo, float hi) {
+    seed = seed * 1664525u + 1013904223u;
+    return lo + (hi - lo) * static_cast<float>(seed >> 8) / 16777216.0f;
+}
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Column-major 4x4 (m[column * 4 + row]), as glm lays it out
+static void multiply(const double* a, const double* b, double* out) {
+    for (int column = 0; column < 4; column++) {
+        for (int row = 0; row < 4; row++) {
+            double sum = 0.0;
+            for (int k = 0; k < 4; k++) {
+                sum += a[k * 4 + row] * b[column * 4 + k];
+            }
+            out[column * 4 + row] = sum;
+        }
+    }
+}
+
+// The per-object matrix the renderer built before instancing:
+// glm::translate(position) * glm::rotate(yaw, +Y) * glm::scale(scale)
+static void referenceModel(const InstanceTransform& transform, double* model) {
+    const double pi = 3.14159265358979323846;
+    double yaw = transform.yawDegrees * pi / 180.0;
+    double c = std::cos(yaw);
+    double s = std::sin(yaw);
+    double translate[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0,
+                            transform.position[0], transform.position[1], transform.position[2], 1};
+    double rotate[16] = {c, 0, -s, 0, 0, 1, 0, 0, s, 0, c, 0, 0, 0, 0, 1};
+    double scale[16] = {transform.scale[0], 0, 0, 0, 0, transform.scale[1], 0, 0, 0, 0, transform.scale[2], 0, 0, 0, 0, 1};
+    double rotateScale[16];
+    multiply(rotate, scale, rotateScale);
+    multiply(translate, rotateScale, model);
+}
+
+// Largest difference between a record and the reference, relative to the transform's magnitude
+static double recordError(const InstanceTransform& transform, const MeshInstance& record) {
+    double model[16];
+    referenceModel(transform, model);
+    double magnitude = 1.0;
+    for (int i = 0; i < 3; i++) {
+        magnitude = std::max({magnitude, std::fabs(static_cast<double>(transform.position[i])),
+                              std::fabs(static_cast<double>(transform.scale[i]))});
+    }
+    double error = 0.0;
+    for (int i = 0; i < 16; i++) {
+        error = std::max(error, std::fabs(model[i] - record.model[i]) / magnitude);
+    }
+    for (int i = 0; i < 3; i++) {
+        error = std::max(error, std::fabs(static_cast<double>(transform.color[i]) - record.color[i]));
+    }
+    return record.color[3] == 1.0f ? error : 1.0;
+}
+
+// Editor-like scene: boxes across a 1 km square, any yaw, non-uniform scale, random colors
+static void fillBatch(InstanceBatch& batch, size_t instances, uint32_t seed) {
+    batch.clear();
+    for (size_t i = 0; i < instances; i++) {
+        InstanceTransform transform;
+        transform.position[0] = randomFloat(seed, -500, 500);
+        transform.position[1] = randomFloat(seed, 0, 50);
+        transform.position[2] = randomFloat(seed, -500, 500);
+        transform.yawDegrees = i % 4 == 0 ? 0.0f : randomFloat(seed, -360, 360);
+        for (int axis = 0; axis < 3; axis++) {
+            transform.scale[axis] = randomFloat(seed, 0.25f, 8.0f);
+            transform.color[axis] = randomFloat(seed, 0, 1);
+        }
+        batch.add(transform);
+    }
+}
+
+// Transforms with known matrices, the culling bounds, the vertex layout and partial builds
+static bool checkKnownAnswers() {
+    bool ok = true;
+
+    // Default transform: identity matrix, white
+    MeshInstance record;
+    build_mesh_instance(InstanceTransform{}, record);
+    for (int i = 0; i < 16; i++) {
+        ok = ok && record.model[i] == (i % 5 == 0 ? 1.0f : 0.0f);
+    }
+    ok = ok && record.color[0] == 1.0f && record.color[1] == 1.0f && record.color[2] == 1.0f && record.color[3] == 1.0f;
+
+    // Yaw 90: +X turns to -Z and +Z to +X; scale then translation apply
+    InstanceTransform turned;
+    turned.position[0] = 10.0f;
+    turned.position[1] = 20.0f;
+    turned.position[2] = 30.0f;
+    turned.yawDegrees = 90.0f;
+    turned.scale[0] = 2.0f;
+    turned.scale[1] = 3.0f;
+    turned.scale[2] = 4.0f;
+    build_mesh_instance(turned, record);
+    auto transformPoint = [&](float x, float y, float z, int row) {
+        return record.model[row] * x + record.model[4 + row] * y + record.model[8 + row] * z + record.model[12 + row];
+    };
+    ok = ok && std::fabs(transformPoint(1, 0, 0, 0) - 10.0f) < 1e-5f && std::fabs(transformPoint(1, 0, 0, 2) - 28.0f) < 1e-5f;
+    ok = ok && std::fabs(transformPoint(0, 0, 1, 0) - 14.0f) < 1e-5f && std::fabs(transformPoint(0, 0, 1, 2) - 30.0f) < 1e-5f;
+    ok = ok && transformPoint(0, 1, 0, 1) == 23.0f;
+
+    // The unit cube's corners stay inside, and touch, the yaw-rotated bounds the renderer culls with
+    uint32_t seed = 7u;
+    for (int test = 0; test < 1000; test++) {
+        InstanceTransform transform;
+        transform.yawDegrees = randomFloat(seed, -720, 720);
+        for (int axis = 0; axis < 3; axis++) {
+            transform.position[axis] = randomFloat(seed, -100, 100);
+            transform.scale[axis] = randomFloat(seed, 0.1f, 10.0f);
+        }
+        build_mesh_instance(transform, record);
+        float yawRad = transform.yawDegrees * (3.14159265358979f / 180.0f);
+        float c = std::fabs(std::cos(yawRad));
+        float s = std::fabs(std::sin(yawRad));
+        float hx = transform.scale[0] * 0.5f;
+        float hz = transform.scale[2] * 0.5f;
+        float bounds[3] = {c * hx + s * hz, transform.scale[1] * 0.5f, s * hx + c * hz};
+        float reach[3] = {0.0f, 0.0f, 0.0f};
+        for (int corner = 0; corner < 8; corner++) {
+            float x = (corner & 1) ? 0.5f : -0.5f;
+            float y = (corner & 2) ? 0.5f : -0.5f;
+            float z = (corner & 4) ? 0.5f : -0.5f;
+            for (int row = 0; row < 3; row++) {
+                reach[row] = std::max(reach[row], std::fabs(transformPoint(x, y, z, row) - transform.position[row]));
+            }
+        }
+        for (int axis = 0; axis < 3; axis++) {
+            ok = ok && std::fabs(reach[axis] - bounds[axis]) < 1e-4f * (1.0f + bounds[axis]);
+        }
+    }
+
+    // Vertex layout: four model columns at 0/16/32/48, color at 64, 80-byte stride
+    ok = ok && offsetof(MeshInstance, model) == 0 && offsetof(MeshInstance, color) == 64 && sizeof(MeshInstance) == 80;
+
+    // A batch over capacity writes exactly `capacity` records in order and nothing past them
+    InstanceBatch batch;
+    fillBatch(batch, 10, 3u);
+    std::vector<MeshInstance> out(8);
+    out[7].color[0] = -1.0f;
+    ok = ok && batch.build(out.data(), 7) == 7 && out[7].color[0] == -1.0f;
+    for (size_t i = 0; i < 7; i++) {
+        ok = ok && recordError(batch.getTransforms()[i], out[i]) < 1e-6;
+    }
+    batch.clear();
+    ok = ok && batch.empty() && batch.build(out.data(), out.size()) == 0;
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    size_t instances = argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 100000;
+    int frames = argc > 2 ? std::atoi(argv[2]) : 300;
+    instances = std::max<size_t>(instances, 1);
+    frames = std::max(frames, 1);
+
+    InstanceBatch batch;
+    batch.reserve(instances);
+    std::vector<MeshInstance> mapped(instances);
+    double fillMs = 0.0;
+    double buildMs = 0.0;
+    size_t written = 0;
+    for (int frame = 0; frame < frames; frame++) {
+        auto start = std::chrono::steady_clock::now();
+        fillBatch(batch, instances, 1000u + static_cast<uint32_t>(frame));
+        fillMs += elapsedMs(start);
+        start = std::chrono::steady_clock::now();
+        written = batch.build(mapped.data(), mapped.size());
+        buildMs += elapsedMs(start);
+    }
+
+    // Every record of the last frame against the reference
+    double worst = 0.0;
+    for (size_t i = 0; i < written; i++) {
+        worst = std::max(worst, recordError(batch.getTransforms()[i], mapped[i]));
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (const InstanceTransform& transform : batch.getTransforms()) {
+        double model[16];
+        referenceModel(transform, model);
+        g_sink = g_sink + model[12];
+    }
+    double referenceMs = elapsedMs(start);
+
+    bool recordsOk = written == instances && worst < 1e-6;
+    bool knownOk = checkKnownAnswers();
+    std::cout << std::fixed << instances << " instances per frame, " << frames << " frames" << std::endl;
+    std::cout << std::setprecision(3)
+              << "fill ms / frame:      " << fillMs / frames << std::endl
+              << "build ms / frame:     " << buildMs / frames << std::endl
+              << "ns per instance:      " << std::setprecision(2) << buildMs * 1e6 / (static_cast<double>(frames) * instances) << std::endl
+              << "ns per 4x4 reference: " << std::setprecision(2) << referenceMs * 1e6 / instances << std::endl
+              << "instance data:        " << std::setprecision(2) << instances * sizeof(MeshInstance) / (1024.0 * 1024.0) << " MB" << std::endl
+              << "draw calls:           1 (one per object: " << instances << ")" << std::endl
+              << "worst error:          " << std::scientific << std::setprecision(1) << worst << std::endl;
+    std::cout << "records match:        " << (recordsOk ? "yes" : "NO") << std::endl
+              << "known answers:        " << (knownOk ? "yes" : "NO") << std::endl;
+    return recordsOk && knownOk ? 0 : 1;
+}
@@ -0,0 +1,281 @@
+// EDEN ENGINE - KTX2 Benchmark
+// Headless decode speed and correctness check for stdlib/zstd_decoder.h and stdlib/ktx2_loader.h
+// Usage: ktx2_benchmark [iterations]
+//   Decodes frames made by the reference zstd tool (zstd_frames.h) and compares each with the
+//   payload it was made from, then times `iterations` (default 200) decodes of the large frames.
+//   Concatenated and skippable frames, truncated input, and in-memory KTX2 files (none and zstd
+//   supercompression, read back through KTX2Reader) with their error cases follow.
+
+#include "../../stdlib/ktx2_loader.h"
+#include "zstd_frames.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+static uint32_t randomInt(uint32_t& seed) {
+    seed = seed * 1664525u + 1013904223u;
+    return seed >> 8;
+}
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Payloads the reference frames were made from (must stay byte-identical to regenerate them)
+static const char* WORDS[16] = {"texture", "mip", "level", "stream", "the", "of", "a", "block",
+                                "rock", "grass", "sand", "normal", "albedo", "rough", "metal", "sky"};
+
+static std::vector<uint8_t> makeText(size_t size, uint32_t seed) {
+    std::string text;
+    while (text.size() < size) {
+        text += WORDS[randomInt(seed) % 16];
+        text += (randomInt(seed) % 9 == 0) ? ".\n" : " ";
+    }
+    text.resize(size);
+    return std::vector<uint8_t>(text.begin(), text.end());
+}
+
+static std::vector<uint8_t> makeRandom(size_t size, uint32_t seed) {
+    std::vector<uint8_t> bytes(size);
+    for (uint8_t& byte : bytes) {
+        byte = static_cast<uint8_t>(randomInt(seed));
+    }
+    return bytes;
+}
+
+static std::vector<uint8_t> makeRows(size_t size) {
+    std::string text;
+    char line[64];
+    for (int i = 0; text.size() < size; i++) {
+        snprintf(line, sizeof(line), "level %d row %d: rock sample\n", i / 4096, i % 64);
+        text += line;
+    }
+    text.resize(size);
+    return std::vector<uint8_t>(text.begin(), text.end());
+}
+
+// RGBA8 level: coordinate gradients in red/green, a small pattern in blue
+static std::vector<uint8_t> makeLevel(uint32_t size) {
+    std::vector<uint8_t> rgba;
+    for (uint32_t y = 0; y < size; y++) {
+        for (uint32_t x = 0; x < size; x++) {
+            uint8_t n = static_cast<uint8_t>(((x * y) >> 5) & 3);
+            rgba.push_back(static_cast<uint8_t>((x * 4) & 255));
+            rgba.push_back(static_cast<uint8_t>((y * 4) & 255));
+            rgba.push_back(static_cast<uint8_t>(((x / 16 + y / 16) & 1) ? 200 + n : 40 + n));
+            rgba.push_back(255);
+        }
+    }
+    return rgba;
+}
+
+struct Frame {
+    const char* name;
+    const uint8_t* data;
+    size_t size;
+    std::vector<uint8_t> expected;
+};
+
+// Decodes `frame`; false if it throws or the output differs from the payload
+static bool decodesTo(const uint8_t* data, size_t size, const std::vector<uint8_t>& expected) {
+    try {
+        return zstd_decompress(data, size, expected.size()) == expected;
+    } catch (const std::runtime_error&) {
+        return false;
+    }
+}
+
+static bool throws(const uint8_t* data, size_t size) {
+    try {
+        zstd_decompress(data, size);
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+static void putU32(std::vector<uint8_t>& out, size_t offset, uint32_t value) {
+    memcpy(out.data() + offset, &value, 4);
+}
+
+static void putU64(std::vector<uint8_t>& out, size_t offset, uint64_t value) {
+    memcpy(out.data() + offset, &value, 8);
+}
+
+// A 16x16 R8G8B8A8_UNORM KTX2 with 5 levels stored smallest first, as KTX tools write them
+static std::vector<uint8_t> makeKtx2(uint32_t scheme, const std::vector<Frame>& levelFrames) {
+    const uint32_t levelCount = 5;
+    std::vector<uint8_t> file(KTX2_HEADER_SIZE + levelCount * KTX2_LEVEL_INDEX_ENTRY_SIZE, 0);
+    memcpy(file.data(), KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER));
+    putU32(file, 12, 37);               // VK_FORMAT_R8G8B8A8_UNORM
+    putU32(file, 16, 1);                // typeSize
+    putU32(file, 20, 16);
+    putU32(file, 24, 16);
+    putU32(file, 36, 1);                // faceCount
+    putU32(file, 40, levelCount);
+    putU32(file, 44, scheme);
+    for (uint32_t level = levelCount; level-- > 0;) {
+        const Frame& frame = levelFrames[level];
+        size_t entry = KTX2_HEADER_SIZE + level * KTX2_LEVEL_INDEX_ENTRY_SIZE;
+        putU64(file, entry, file.size());
+        if (scheme == KTX2_SUPERCOMPRESSION_ZSTD) {
+            putU64(file, entry + 8, frame.size);
+            file.insert(file.end(), frame.data, frame.data + frame.size);
+        } else {
+            putU64(file, entry + 8, frame.expected.size());
+            file.insert(file.end(), frame.expected.begin(), frame.expected.end());
+        }
+        putU64(file, entry + 16, frame.expected.size());
+    }
+    return file;
+}
+
+static bool parseFails(std::vector<uint8_t> file) {
+    try {
+        KTX2Info info = parse_ktx2_header(file.data(), file.size(), file.size());
+        for (uint32_t level = 0; level < info.levelCount; level++) {
+            const KTX2Level& entry = info.levels[level];
+            decode_ktx2_level(info, level, file.data() + entry.byteOffset, static_cast<size_t>(entry.byteLength));
+        }
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+// Header fields, per-level decode, KTX2Reader from disk, and files that must be refused
+static bool checkKtx2(const std::vector<Frame>& levelFrames) {
+    bool ok = true;
+    std::vector<uint8_t> packed;        // Levels 2..4 packed largest first, as readMipChain returns them
+    for (uint32_t level = 2; level < 5; level++) {
+        packed.insert(packed.end(), levelFrames[level].expected.begin(), levelFrames[level].expected.end());
+    }
+
+    for (uint32_t scheme : {KTX2_SUPERCOMPRESSION_NONE, KTX2_SUPERCOMPRESSION_ZSTD}) {
+        std::vector<uint8_t> file = makeKtx2(scheme, levelFrames);
+        ok = ok && ktx2_header_bytes(file.data(), file.size()) == KTX2_HEADER_SIZE + 5 * KTX2_LEVEL_INDEX_ENTRY_SIZE;
+        KTX2Info info = parse_ktx2_header(file.data(), file.size(), file.size());
+        ok = ok && info.vkFormat == 37 && info.width == 16 && info.height == 16 && info.layerCount == 1 &&
+             info.faceCount == 1 && info.levelCount == 5 && info.supercompressionScheme == scheme;
+        for (uint32_t level = 0; level < 5; level++) {
+            const KTX2Level& entry = info.levels[level];
+            ok = ok && entry.width == (16u >> level) && entry.height == (16u >> level) &&
+                 decode_ktx2_level(info, level, file.data() + entry.byteOffset, static_cast<size_t>(entry.byteLength)) ==
+                     levelFrames[level].expected;
+        }
+
+        std::string path = scheme == KTX2_SUPERCOMPRESSION_ZSTD ? "ktx2_benchmark_zstd.ktx2" : "ktx2_benchmark_none.ktx2";
+        FILE* out = fopen(path.c_str(), "wb");
+        if (!out) {
+            return false;
+        }
+        fwrite(file.data(), 1, file.size(), out);
+        fclose(out);
+        {
+            KTX2Reader reader(path);
+            std::vector<uint64_t> offsets;
+            ok = ok && reader.readLevel(0) == levelFrames[0].expected && reader.readLevel(4) == levelFrames[4].expected;
+            ok = ok && reader.readMipChain(2, &offsets) == packed && offsets == std::vector<uint64_t>{0, 64, 80};
+        }
+        remove(path.c_str());
+    }
+
+    // Refused: bad identifier, Basis Universal, BasisLZ and zlib, data past the end, wrong sizes
+    std::vector<uint8_t> good = makeKtx2(KTX2_SUPERCOMPRESSION_ZSTD, levelFrames);
+    std::vector<uint8_t> bad = good;
+    bad[1] = 'k';
+    ok = ok && parseFails(bad);
+    bad = good;
+    putU32(bad, 12, 0);
+    ok = ok && parseFails(bad);
+    for (uint32_t scheme : {KTX2_SUPERCOMPRESSION_BASISLZ, KTX2_SUPERCOMPRESSION_ZLIB}) {
+        bad = good;
+        putU32(bad, 44, scheme);
+        ok = ok && parseFails(bad);
+    }
+    bad = good;
+    putU64(bad, KTX2_HEADER_SIZE + 8, good.size());                 // Level 0 runs past the end
+    ok = ok && parseFails(bad);
+    bad = good;
+    putU64(bad, KTX2_HEADER_SIZE + 16, 16 * 16 * 4 + 1);            // Decodes to fewer bytes than indexed
+    ok = ok && parseFails(bad);
+    bad = makeKtx2(KTX2_SUPERCOMPRESSION_NONE, levelFrames);
+    putU64(bad, KTX2_HEADER_SIZE + 16, 16);                         // Uncompressed, yet sizes differ
+    ok = ok && parseFails(bad);
+    bad = good;
+    bad.resize(KTX2_HEADER_SIZE + 2 * KTX2_LEVEL_INDEX_ENTRY_SIZE); // Level index cut short
+    ok = ok && parseFails(bad);
+    return ok && !parseFails(good);
+}
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 200;
+    iterations = std::max(iterations, 1);
+
+    std::vector<uint8_t> text = makeText(2000, 1);
+    std::vector<Frame> frames = {
+        {"text -1", ZSTD_FRAME_TEXT_FAST, sizeof(ZSTD_FRAME_TEXT_FAST), text},
+        {"text -19", ZSTD_FRAME_TEXT_BEST, sizeof(ZSTD_FRAME_TEXT_BEST), text},
+        {"random", ZSTD_FRAME_RANDOM, sizeof(ZSTD_FRAME_RANDOM), makeRandom(600, 5)},
+        {"rle", ZSTD_FRAME_RLE, sizeof(ZSTD_FRAME_RLE), std::vector<uint8_t>(300000, 0x5A)},
+        {"rows", ZSTD_FRAME_ROWS, sizeof(ZSTD_FRAME_ROWS), makeRows(300000)},
+    };
+    std::vector<Frame> levelFrames = {
+        {"level 16x16", ZSTD_FRAME_LEVEL16, sizeof(ZSTD_FRAME_LEVEL16), makeLevel(16)},
+        {"level 8x8", ZSTD_FRAME_LEVEL8, sizeof(ZSTD_FRAME_LEVEL8), makeLevel(8)},
+        {"level 4x4", ZSTD_FRAME_LEVEL4, sizeof(ZSTD_FRAME_LEVEL4), makeLevel(4)},
+        {"level 2x2", ZSTD_FRAME_LEVEL2, sizeof(ZSTD_FRAME_LEVEL2), makeLevel(2)},
+        {"level 1x1", ZSTD_FRAME_LEVEL1, sizeof(ZSTD_FRAME_LEVEL1), makeLevel(1)},
+    };
+    frames.insert(frames.end(), levelFrames.begin(), levelFrames.end());
+
+    std::cout << std::fixed << frames.size() << " reference frames, " << iterations << " timed decodes each" << std::endl;
+    std::cout << "frame         stored B  decoded B     MB/s  check" << std::endl;
+    bool framesOk = true;
+    for (const Frame& frame : frames) {
+        bool ok = decodesTo(frame.data, frame.size, frame.expected);
+        framesOk = framesOk && ok;
+        auto start = std::chrono::steady_clock::now();
+        size_t decoded = 0;
+        for (int i = 0; i < iterations; i++) {
+            decoded += zstd_decompress(frame.data, frame.size, frame.expected.size()).size();
+        }
+        double ms = elapsedMs(start);
+        std::cout << std::left << std::setw(12) << frame.name << std::right
+                  << std::setw(10) << frame.size
+                  << std::setw(11) << frame.expected.size()
+                  << std::setprecision(0) << std::setw(9) << decoded / (1024.0 * 1024.0) / std::max(ms / 1000.0, 1e-9)
+                  << (ok ? "  yes" : "  NO") << std::endl;
+    }
+
+    // Concatenated frames with a skippable frame between them decode to the joined payloads
+    std::vector<uint8_t> joined(ZSTD_FRAME_TEXT_BEST, ZSTD_FRAME_TEXT_BEST + sizeof(ZSTD_FRAME_TEXT_BEST));
+    const uint8_t skippable[] = {0x53, 0x2A, 0x4D, 0x18, 0x03, 0x00, 0x00, 0x00, 'e', 'd', 'n'};
+    joined.insert(joined.end(), skippable, skippable + sizeof(skippable));
+    joined.insert(joined.end(), ZSTD_FRAME_RANDOM, ZSTD_FRAME_RANDOM + sizeof(ZSTD_FRAME_RANDOM));
+    std::vector<uint8_t> expected = text;
+    expected.insert(expected.end(), frames[2].expected.begin(), frames[2].expected.end());
+    bool concatOk = decodesTo(joined.data(), joined.size(), expected);
+
+    // Every truncation of every frame, and a bad magic number, throw instead of returning data
+    bool truncatedOk = throws(skippable, 4);
+    for (const Frame& frame : frames) {
+        for (size_t size = 1; size < frame.size; size++) {
+            truncatedOk = truncatedOk && throws(frame.data, size);
+        }
+    }
+    std::vector<uint8_t> badMagic(ZSTD_FRAME_TEXT_FAST, ZSTD_FRAME_TEXT_FAST + sizeof(ZSTD_FRAME_TEXT_FAST));
+    badMagic[0] ^= 1;
+    truncatedOk = truncatedOk && throws(badMagic.data(), badMagic.size());
+
+    bool ktx2Ok = checkKtx2(levelFrames);
+    std::cout << "reference frames:     " << (framesOk ? "yes" : "NO") << std::endl
+              << "concatenated frames:  " << (concatOk ? "yes" : "NO") << std::endl
+              << "truncated input:      " << (truncatedOk ? "yes" : "NO") << std::endl
+              << "KTX2 container:       " << (ktx2Ok ? "yes" : "NO") << std::endl;
+    return framesOk && concatOk && truncatedOk && ktx2Ok ? 0 : 1;
+}
@@ -0,0 +1,229 @@
+// EDEN ENGINE - zstd reference frames for the KTX2 benchmark
+// Produced by the reference zstd command-line tool (v1.5.6) from the payloads that
+// ktx2_benchmark.cpp generates, so the decoder is checked against an independent encoder.
+
+#ifndef EDEN_KTX2_BENCHMARK_FRAMES_H
+#define EDEN_KTX2_BENCHMARK_FRAMES_H
+
+#include <cstdint>
+
+// zstd -1 --no-check: 2000 bytes of text, no content checksum
+static const uint8_t ZSTD_FRAME_TEXT_FAST[] = {
+    0x28, 0xb5, 0x2f, 0xfd, 0x60, 0xd0, 0x06, 0xc5, 0x12, 0x00, 0xd2, 0x8d, 0x24, 0x17, 0x90, 0x25,
+    0x6d, 0x03, 0x08, 0x90, 0x88, 0x80, 0xac, 0x6d, 0x33, 0x2d, 0x6d, 0x69, 0xed, 0xf2, 0xff, 0x07,
+    0x3b, 0x74, 0xe7, 0xa3, 0x0e, 0x2b, 0x54, 0x1f, 0xc3, 0xdf, 0xf0, 0xd7, 0xde, 0x64, 0x78, 0xbf,
+    0xdc, 0x64, 0x86, 0xb6, 0x19, 0x6c, 0xb8, 0x42, 0x99, 0xc1, 0x66, 0xe4, 0x26, 0xed, 0x9f, 0xf6,
+    0xcf, 0x0c, 0x36, 0xd4, 0x36, 0x83, 0x0d, 0x0d, 0x85, 0xe1, 0xda, 0xbf, 0x6b, 0xe7, 0x26, 0xed,
+    0x45, 0x90, 0xa1, 0xe1, 0x0a, 0x65, 0x78, 0x6d, 0x6d, 0xc3, 0x45, 0x90, 0xa1, 0x19, 0xbc, 0x08,
+    0x09, 0x72, 0xd3, 0x99, 0xc1, 0x86, 0xda, 0x86, 0xb9, 0x25, 0x01, 0xb2, 0x9c, 0x30, 0x1c, 0xdd,
+    0x8f, 0x04, 0x7d, 0xf8, 0xf4, 0x70, 0x24, 0xe8, 0x12, 0x38, 0x43, 0x7e, 0x9e, 0x84, 0x5a, 0xc8,
+    0x40, 0xf9, 0x09, 0xc3, 0xd1, 0x6f, 0x11, 0x74, 0xe5, 0x29, 0xd9, 0x90, 0x04, 0x7d, 0x6e, 0x11,
+    0x74, 0x79, 0x54, 0x0a, 0xc8, 0x74, 0x5f, 0xa1, 0xfa, 0x9c, 0x19, 0x7c, 0x08, 0xfd, 0x88, 0x81,
+    0x03, 0xa8, 0xe1, 0xce, 0x91, 0x24, 0x29, 0x34, 0x07, 0x31, 0x04, 0x15, 0x87, 0x02, 0xd9, 0x7a,
+    0x11, 0x14, 0x49, 0xef, 0x68, 0x92, 0x34, 0x07, 0xd6, 0x16, 0xe8, 0x2e, 0x6e, 0x00, 0xe0, 0x91,
+    0xea, 0x6b, 0x2c, 0xe0, 0x60, 0xcb, 0x6b, 0x91, 0x00, 0x64, 0x41, 0xae, 0x10, 0xd5, 0x8e, 0x9d,
+    0x0e, 0x1c, 0xdb, 0x4b, 0xac, 0x6d, 0x72, 0x40, 0x31, 0x6c, 0x6a, 0x1a, 0x68, 0xe5, 0x09, 0xa5,
+    0xb2, 0xf6, 0x55, 0x31, 0x3e, 0xbb, 0x17, 0x8b, 0xc6, 0xd0, 0x20, 0xe2, 0xb0, 0x93, 0x74, 0x0d,
+    0xc1, 0x65, 0xc4, 0xa1, 0x62, 0xc9, 0xf2, 0x60, 0x9f, 0x79, 0x5a, 0x19, 0xa8, 0xd5, 0xce, 0x58,
+    0xc6, 0x16, 0x11, 0x0b, 0xde, 0x2a, 0xc6, 0x66, 0x3c, 0xe9, 0xc3, 0x92, 0xae, 0xf2, 0x06, 0x83,
+    0xb2, 0xcc, 0x7c, 0xe0, 0x83, 0x09, 0xa8, 0xff, 0x7a, 0xce, 0x1a, 0x5d, 0xfe, 0x74, 0x5c, 0x98,
+    0x7a, 0xed, 0x41, 0xa4, 0x01, 0x10, 0x6b, 0x14, 0x59, 0xe3, 0x4b, 0x21, 0x3f, 0x61, 0xed, 0x87,
+    0x6d, 0x35, 0xbd, 0x30, 0x12, 0xb0, 0xcc, 0x7e, 0x7d, 0xf3, 0xb8, 0xe1, 0x88, 0xc2, 0x7d, 0xe8,
+    0xc4, 0x32, 0xc9, 0x9f, 0x39, 0xaa, 0x0d, 0xb7, 0x0c, 0x25, 0x9a, 0x62, 0xed, 0xe3, 0x3e, 0xd0,
+    0xed, 0x00, 0x0a, 0x3d, 0x0e, 0x54, 0x04, 0x03, 0x0c, 0xca, 0x61, 0x3b, 0x90, 0xd0, 0x5c, 0xb0,
+    0x3d, 0x79, 0x20, 0xf0, 0xd0, 0x83, 0x10, 0x15, 0xac, 0xc3, 0x8c, 0x3e, 0x02, 0x0e, 0x22, 0x94,
+    0xbe, 0xfb, 0xf2, 0x6a, 0x81, 0xc7, 0x92, 0x5c, 0x44, 0xd8, 0xd2, 0x0e, 0x01, 0x3d, 0x66, 0x14,
+    0x92, 0x43, 0x8b, 0x9b, 0xa6, 0x64, 0x71, 0x68, 0x3d, 0x3f, 0x24, 0x17, 0xa4, 0xc6, 0x5c, 0xbe,
+    0xcd, 0x5d, 0x37, 0xd4, 0x33, 0x55, 0x09, 0x1e, 0x10, 0xb2, 0x74, 0x43, 0x29, 0x29, 0x32, 0x4a,
+    0xee, 0xf4, 0x45, 0x01, 0x0f, 0x46, 0x71, 0xf1, 0x1c, 0x8d, 0xa9, 0x0c, 0xc0, 0xb1, 0x4e, 0xa4,
+    0x48, 0x5f, 0x5f, 0x20, 0xce, 0x12, 0x98, 0xb2, 0x51, 0xc9, 0x4a, 0xde, 0x3e, 0x0c, 0x3d, 0x7a,
+    0x60, 0xa8, 0x2b, 0x42, 0x8b, 0x02, 0x57, 0xf7, 0x78, 0xc6, 0xec, 0x3b, 0xcf, 0x3f, 0x07, 0xd3,
+    0xc1, 0xb3, 0x95, 0x6b, 0x1e, 0xf2, 0xbc, 0xb4, 0xd8, 0x3d, 0xf5, 0xbe, 0xf3, 0xab, 0x1c, 0x74,
+    0x18, 0x6d, 0xef, 0x82, 0x6a, 0xf4, 0x33, 0x15, 0xab, 0x27, 0x7f, 0x8d, 0x63, 0x08, 0xb0, 0x25,
+    0x78, 0x28, 0x1b, 0x4e, 0x26, 0xb0, 0x29, 0x11, 0x80, 0xe8, 0x5f, 0xe4, 0x50, 0x60, 0x77, 0x76,
+    0x05, 0xd7, 0x00, 0x33, 0x13, 0xb1, 0x10, 0x58, 0x46, 0xc8, 0x6e, 0xa8, 0xa1, 0xb5, 0x08, 0xf2,
+    0xf1, 0x60, 0xf9, 0xda, 0x09, 0x6d, 0x31, 0xa8, 0x50, 0x58, 0xa5, 0x55, 0x20, 0x6a, 0xa2, 0x5a,
+    0xa0, 0xb9, 0x76, 0x4f, 0xdc, 0x84, 0xc0, 0x6f, 0xcc, 0xd3, 0x2d, 0x24, 0xe4, 0x17, 0xc0, 0xc0,
+    0xb6, 0xa9, 0xb8, 0xd9, 0xaa, 0x42, 0x87, 0x03, 0x20, 0xa5, 0x20, 0xff, 0x42, 0x62, 0xe8, 0x3f,
+    0x6f, 0x81, 0x48, 0xa8, 0xea, 0x5b, 0x36, 0x3e, 0x43, 0x34, 0xf0, 0x9c, 0xc1, 0x1f, 0x61, 0x26,
+    0x24, 0xe7, 0x11, 0xcf, 0x60, 0x2f, 0x63, 0x90, 0x1a, 0x4e, 0x8a, 0x11, 0xfe, 0x07, 0xfc, 0x87,
+    0x64, 0xab,
+};
+
+// zstd -19: the same text, with a content checksum
+static const uint8_t ZSTD_FRAME_TEXT_BEST[] = {
+    0x28, 0xb5, 0x2f, 0xfd, 0x64, 0xd0, 0x06, 0x05, 0x10, 0x00, 0x72, 0xc7, 0x14, 0x11, 0xa0, 0xed,
+    0xf0, 0x59, 0x65, 0xb7, 0xca, 0xbe, 0xd5, 0x46, 0xff, 0x0f, 0xfb, 0xf4, 0x83, 0x56, 0x28, 0xca,
+    0xbf, 0xf2, 0xcb, 0xfb, 0x58, 0xca, 0xdf, 0x2b, 0x2b, 0x7f, 0x2c, 0x65, 0xe5, 0x8f, 0x35, 0x96,
+    0xb2, 0xf2, 0x3c, 0xca, 0x63, 0x29, 0x77, 0x59, 0xd4, 0xb1, 0xd1, 0xf7, 0xa9, 0x2d, 0xb5, 0x08,
+    0x28, 0xa7, 0x77, 0x7b, 0x6e, 0x89, 0x06, 0xe8, 0x2b, 0xd4, 0xdd, 0xd1, 0x5f, 0x2b, 0x9f, 0x30,
+    0x8f, 0xdb, 0x6e, 0xf0, 0xc9, 0x7e, 0xfb, 0x42, 0xe0, 0x6a, 0xcb, 0x4c, 0x5a, 0xe7, 0xde, 0x48,
+    0x80, 0xee, 0xa8, 0x80, 0x35, 0x29, 0x94, 0x9a, 0x03, 0x20, 0x02, 0x62, 0x0c, 0x73, 0x67, 0x1e,
+    0x31, 0x08, 0xca, 0xc4, 0x64, 0x24, 0x83, 0x2c, 0x49, 0x86, 0x03, 0x82, 0xe4, 0x01, 0xbd, 0x31,
+    0xb4, 0x29, 0xfc, 0x12, 0x78, 0xb0, 0xd4, 0x10, 0x60, 0x3b, 0x08, 0xd4, 0xa8, 0x70, 0x87, 0x15,
+    0x4f, 0x2b, 0xd7, 0x0f, 0x5f, 0xfe, 0x0a, 0x5b, 0x94, 0xb3, 0xa4, 0x03, 0xe4, 0x6c, 0x0f, 0x62,
+    0x06, 0x3c, 0xe3, 0x96, 0x4d, 0xa1, 0xd8, 0x68, 0x26, 0x1c, 0x6e, 0x34, 0x3e, 0xcc, 0x03, 0x27,
+    0xcd, 0x9e, 0x00, 0x7e, 0x49, 0x72, 0x7b, 0x51, 0x59, 0xb0, 0xde, 0x4b, 0xb3, 0xe1, 0x62, 0x2a,
+    0xe6, 0x5d, 0x00, 0x17, 0xda, 0x1f, 0x91, 0x70, 0x41, 0xc9, 0xab, 0xeb, 0x7c, 0x40, 0xc7, 0xb5,
+    0x1c, 0xaf, 0x00, 0xd3, 0x56, 0xd2, 0x32, 0x7b, 0x48, 0x8a, 0x18, 0x0c, 0xe4, 0xd8, 0x13, 0x4c,
+    0x2b, 0xf1, 0xcd, 0x80, 0x97, 0x9d, 0x59, 0x02, 0x44, 0x4f, 0x74, 0x22, 0x0d, 0x99, 0x68, 0x55,
+    0x82, 0x98, 0x4a, 0x35, 0xc8, 0x06, 0x3c, 0xdb, 0x02, 0x7f, 0x60, 0x1c, 0x81, 0xc8, 0xb2, 0x10,
+    0x8b, 0x9f, 0x40, 0xa0, 0x18, 0x4d, 0x7e, 0x89, 0xc2, 0xe9, 0xf7, 0x2c, 0xdf, 0x09, 0x31, 0x85,
+    0x88, 0x8a, 0x30, 0x53, 0x49, 0x8a, 0xe8, 0x30, 0xbb, 0xcd, 0x35, 0x12, 0x72, 0xde, 0xd3, 0x9c,
+    0x0c, 0x8e, 0x30, 0x7d, 0x0d, 0xd4, 0xf6, 0xc3, 0xa9, 0x3d, 0xab, 0x44, 0xa4, 0xc5, 0x6c, 0x36,
+    0x9a, 0x5f, 0x09, 0xea, 0xbd, 0xa8, 0x54, 0x0d, 0x61, 0x50, 0x90, 0xb6, 0x19, 0xc2, 0x22, 0x12,
+    0xa5, 0x5d, 0x26, 0x45, 0x31, 0x7d, 0x83, 0xf1, 0x98, 0x0f, 0x47, 0x2d, 0xb5, 0x5d, 0x8e, 0x4d,
+    0x19, 0xab, 0x0a, 0x9d, 0x48, 0xc0, 0xdb, 0x19, 0xb8, 0x24, 0xc6, 0x52, 0x09, 0x45, 0xe4, 0xe9,
+    0xa8, 0x84, 0x09, 0x7c, 0x06, 0xc5, 0x63, 0x21, 0x5c, 0xee, 0xe9, 0x3a, 0x58, 0x25, 0xe0, 0xfb,
+    0x01, 0x19, 0x19, 0x99, 0xe2, 0x10, 0xcd, 0x2b, 0xc8, 0xc5, 0xf6, 0xa0, 0x54, 0x34, 0x0a, 0xfe,
+    0x59, 0x86, 0x02, 0xe3, 0xad, 0x13, 0xac, 0x47, 0xc9, 0x35, 0xe9, 0x2e, 0xce, 0x56, 0xd7, 0xf0,
+    0xd3, 0x30, 0x59, 0x9b, 0xf1, 0x41, 0x9f, 0x32, 0x09, 0xa6, 0x12, 0x2d, 0x7c, 0x88, 0xb0, 0x9a,
+    0xb1, 0x24, 0x01, 0x42, 0x92, 0xff, 0x89, 0x6e, 0x8f, 0xae, 0xa9, 0x2d, 0x90, 0xdc, 0x64, 0x4c,
+    0xd5, 0x74, 0x8d, 0x7e, 0xcf, 0x41, 0xdb, 0x12, 0x8b, 0x1e, 0x4a, 0xd9, 0xb0, 0x0e, 0x5b, 0x5d,
+    0xb7, 0x26, 0x60, 0x31, 0x95, 0x48, 0xf9, 0xae, 0x4f, 0x2c, 0xe4, 0x87, 0xd0, 0x77, 0x60, 0xdf,
+    0x44, 0xba, 0x56, 0xa1, 0x8a, 0x8e, 0xe2, 0x13, 0x0a, 0xbe, 0x4e, 0x79, 0xfc, 0x6a, 0xd1, 0x6e,
+    0xbf, 0x01, 0xd0, 0x4b, 0x2b, 0x52, 0x8d, 0x1b, 0x1b, 0x19, 0x21, 0x8e, 0x94, 0x94, 0x36, 0x52,
+    0x1c, 0xd0, 0x29, 0xa2, 0x4b, 0xc5, 0x11, 0xed, 0x09, 0xb6, 0x26, 0xb3, 0xca, 0x54, 0xe2, 0xef,
+    0x6c, 0xf2, 0x40, 0x37, 0xd8, 0xf1, 0xd9, 0x69, 0x4a, 0x0a, 0x58, 0xbc, 0x83, 0xa1,
+};
+
+// zstd -19: 600 random bytes, stored as a raw block
+static const uint8_t ZSTD_FRAME_RANDOM[] = {
+    0x28, 0xb5, 0x2f, 0xfd, 0x64, 0x58, 0x01, 0xc1, 0x12, 0x00, 0xf1, 0xf8, 0x2b, 0xd9, 0x8e, 0xac,
+    0xa3, 0x60, 0x85, 0x68, 0x05, 0x59, 0xc8, 0x90, 0x67, 0xc9, 0x8d, 0xc8, 0x1c, 0xf3, 0x48, 0xf5,
+    0xb8, 0x5b, 0xab, 0x3a, 0x10, 0xc6, 0xac, 0xfb, 0x37, 0x37, 0x7e, 0xdc, 0x81, 0xf2, 0x95, 0xc2,
+    0x82, 0x7b, 0xa5, 0xd0, 0x0f, 0x96, 0xa3, 0x6a, 0x3b, 0x48, 0xc2, 0x34, 0x5a, 0xd4, 0x76, 0x13,
+    0x00, 0xbe, 0x74, 0x2a, 0x02, 0xcb, 0xae, 0xdd, 0x72, 0xfe, 0x5a, 0xd0, 0xa7, 0x9b, 0xec, 0xe8,
+    0x32, 0x26, 0x16, 0x48, 0xe8, 0x64, 0xce, 0x54, 0xde, 0x57, 0x47, 0xb0, 0x67, 0x45, 0xf5, 0x41,
+    0x18, 0xb2, 0x8c, 0x2a, 0xc3, 0x60, 0x01, 0xcf, 0x7e, 0x55, 0x87, 0xd4, 0x9c, 0xd4, 0x92, 0x1e,
+    0xb2, 0x61, 0xd7, 0xd0, 0x92, 0xc1, 0x48, 0x4e, 0x52, 0xf6, 0x1b, 0x3c, 0x45, 0x46, 0xc4, 0x7f,
+    0xff, 0x35, 0xf5, 0x3a, 0x55, 0x85, 0xa4, 0xd1, 0x5a, 0x3c, 0x04, 0xe8, 0x62, 0x9d, 0x89, 0x64,
+    0x01, 0x2c, 0xe7, 0x68, 0x0c, 0xae, 0x13, 0x58, 0x96, 0x26, 0x40, 0xd9, 0xf3, 0xd8, 0xe2, 0xcd,
+    0xb7, 0x48, 0xae, 0x5a, 0xb7, 0x3a, 0x96, 0xe3, 0x05, 0xb3, 0xd0, 0x0d, 0xf7, 0xf6, 0xcf, 0xba,
+    0x21, 0x87, 0x48, 0x10, 0x55, 0x2b, 0x2e, 0x72, 0xa9, 0xe5, 0xb5, 0x85, 0x70, 0xf9, 0x51, 0x2b,
+    0x3f, 0xeb, 0xb6, 0x8a, 0xe8, 0x80, 0xd9, 0x05, 0x81, 0xba, 0xed, 0x41, 0x5d, 0xdf, 0x66, 0x20,
+    0x10, 0x73, 0xf9, 0xc8, 0x6f, 0x38, 0x98, 0x9c, 0x8d, 0x34, 0x79, 0x41, 0xbe, 0xaa, 0x0f, 0x99,
+    0x96, 0x1e, 0x0f, 0xca, 0xea, 0x55, 0x6c, 0x37, 0xcd, 0x51, 0x5a, 0x85, 0x93, 0x58, 0x4d, 0x97,
+    0xd0, 0xee, 0xf9, 0x90, 0x59, 0xd5, 0x53, 0xd7, 0x40, 0x13, 0x8e, 0x0d, 0xdc, 0xeb, 0x1e, 0x18,
+    0xbe, 0xe1, 0xb7, 0x1a, 0xbb, 0xba, 0x4e, 0x7a, 0xe8, 0x79, 0x16, 0xd9, 0x98, 0x62, 0x83, 0x1d,
+    0x60, 0xf9, 0x4a, 0x69, 0x12, 0x02, 0x5d, 0x21, 0xc4, 0x82, 0xf2, 0xe9, 0xc9, 0xbc, 0x7d, 0xa6,
+    0xb5, 0x34, 0xb0, 0x7b, 0x5d, 0xaf, 0x81, 0xcc, 0xd4, 0x30, 0x23, 0x3d, 0x6e, 0xfb, 0x0a, 0xb3,
+    0xbf, 0x94, 0xea, 0x51, 0x9c, 0xbf, 0xb8, 0x7b, 0x18, 0x81, 0xa7, 0xd5, 0x87, 0x1d, 0x2b, 0x44,
+    0x7d, 0x17, 0xf9, 0xeb, 0xcf, 0x34, 0x03, 0x2e, 0x8f, 0x77, 0x7f, 0xb1, 0x14, 0x24, 0xe1, 0x59,
+    0xef, 0xbf, 0xdb, 0x49, 0xf5, 0x0d, 0x63, 0xe5, 0x3b, 0x10, 0xac, 0xd1, 0x14, 0x0e, 0x2a, 0xf2,
+    0x15, 0x8b, 0x91, 0x6b, 0x10, 0x49, 0xd6, 0xa0, 0x1b, 0x4e, 0x2c, 0x35, 0x89, 0xdd, 0x07, 0x0f,
+    0xef, 0x7a, 0x1c, 0x51, 0x1f, 0xea, 0x5d, 0x5f, 0x2f, 0x2f, 0x00, 0xdd, 0x72, 0x8f, 0x79, 0xb0,
+    0x7c, 0x8e, 0x7a, 0xfb, 0x22, 0xee, 0xf9, 0x22, 0x77, 0xb5, 0x29, 0xc9, 0xcf, 0x26, 0x7e, 0xd5,
+    0xbe, 0xc5, 0xac, 0x69, 0x19, 0x57, 0xa8, 0xe9, 0xf3, 0xdf, 0xa5, 0xfa, 0xa0, 0xa1, 0x17, 0x7e,
+    0xb4, 0x21, 0xb3, 0x9b, 0x04, 0x23, 0x6b, 0xb4, 0xa2, 0xac, 0x75, 0x6e, 0xe4, 0xff, 0x44, 0xab,
+    0x5e, 0xa0, 0x8d, 0x91, 0xe2, 0x54, 0x43, 0x83, 0x86, 0x1e, 0x9a, 0x26, 0x9d, 0x42, 0x06, 0x5c,
+    0xbc, 0x44, 0x3b, 0x4b, 0xb5, 0xe9, 0x2e, 0x56, 0x9e, 0x33, 0x12, 0x22, 0xca, 0x68, 0x5b, 0x91,
+    0xcd, 0x0c, 0xbe, 0xc9, 0x7c, 0xe1, 0x2d, 0x2d, 0xea, 0xed, 0xde, 0x62, 0x6b, 0x73, 0x44, 0x4a,
+    0x93, 0xf7, 0x14, 0x0b, 0x37, 0x3e, 0x41, 0x08, 0x6a, 0x4a, 0xff, 0xe6, 0x80, 0x61, 0xc2, 0x88,
+    0x0d, 0x07, 0x3e, 0x11, 0xe6, 0xfe, 0x68, 0xe8, 0x1d, 0x4c, 0x73, 0xae, 0x09, 0x34, 0xd3, 0x49,
+    0x3b, 0x3a, 0x3c, 0xdb, 0x88, 0x23, 0xa3, 0xcb, 0x05, 0xf2, 0x3b, 0xba, 0x05, 0xeb, 0x78, 0x8e,
+    0x1d, 0x92, 0x0f, 0x6a, 0x1f, 0xab, 0xf2, 0xb2, 0x21, 0x3b, 0x57, 0x0a, 0x76, 0x85, 0xb2, 0x57,
+    0xb2, 0x0d, 0xb5, 0xbc, 0xaa, 0x98, 0x56, 0x9d, 0x71, 0x29, 0xc8, 0x9e, 0x5b, 0x04, 0x7f, 0xa4,
+    0xfc, 0xad, 0x2f, 0xd2, 0x29, 0xe8, 0xcd, 0x8c, 0xf5, 0xba, 0x8c, 0x76, 0xb4, 0x66, 0xe0, 0x75,
+    0xfa, 0x70, 0x7e, 0xac, 0x9c, 0x9d, 0x58, 0x7f, 0xac, 0xf0, 0xa4, 0x92, 0x81, 0xad, 0xd6, 0xca,
+    0xac, 0x58, 0xa0, 0x4a, 0x02, 0xb6, 0xf8, 0x76, 0x98, 0xc9, 0x11, 0xf2, 0xc1, 0xd7, 0x5f, 0xa3,
+    0x12, 0x64, 0x8d, 0x5b, 0x53, 0x65,
+};
+
+// zstd -19: 300000 bytes of 0x5A, three RLE blocks
+static const uint8_t ZSTD_FRAME_RLE[] = {
+    0x28, 0xb5, 0x2f, 0xfd, 0xa4, 0xe0, 0x93, 0x04, 0x00, 0x4c, 0x00, 0x00, 0x08, 0x5a, 0x01, 0x00,
+    0xfc, 0xff, 0x39, 0x10, 0x02, 0x02, 0x00, 0x10, 0x5a, 0x03, 0x9f, 0x04, 0x5a, 0x57, 0x82, 0x56,
+    0x41,
+};
+
+// zstd -19: 300000 bytes of repetitive rows, three compressed blocks
+static const uint8_t ZSTD_FRAME_ROWS[] = {
+    0x28, 0xb5, 0x2f, 0xfd, 0xa4, 0xe0, 0x93, 0x04, 0x00, 0xcc, 0x04, 0x00, 0x02, 0xca, 0x15, 0x13,
+    0xa0, 0xbb, 0x1c, 0x70, 0xdd, 0xf4, 0x21, 0x41, 0xd5, 0x78, 0xdb, 0xdd, 0xdd, 0xbd, 0xb9, 0x6b,
+    0xb4, 0x5a, 0x01, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x2a, 0x45, 0x4d, 0x78, 0xae,
+    0xb1, 0xa5, 0x52, 0xc4, 0x84, 0xe7, 0x1a, 0x5b, 0x2a, 0x45, 0x4b, 0x78, 0xae, 0xb1, 0xa5, 0x52,
+    0xa4, 0x84, 0xe7, 0x1a, 0x5b, 0x2a, 0x45, 0x49, 0x78, 0xae, 0xb1, 0xa5, 0x5e, 0x78, 0xae, 0xb1,
+    0xa5, 0x52, 0xc0, 0x40, 0x96, 0x84, 0x68, 0x82, 0xa3, 0x50, 0x98, 0x60, 0x40, 0xc1, 0xa3, 0x30,
+    0x01, 0x0a, 0x10, 0xc3, 0x31, 0x90, 0x80, 0x81, 0xa8, 0x21, 0xf0, 0xee, 0xff, 0x06, 0xe0, 0xa5,
+    0x69, 0x0c, 0x12, 0x78, 0x05, 0x01, 0x04, 0x81, 0x3f, 0x4c, 0xbf, 0xff, 0x5f, 0x6b, 0x9c, 0xdb,
+    0x64, 0x5d, 0xab, 0xd5, 0x27, 0x82, 0x10, 0x05, 0x7b, 0x1b, 0x6d, 0xf3, 0x6d, 0x15, 0x58, 0xe7,
+    0x12, 0x0f, 0xd6, 0xe3, 0x00, 0x01, 0xfe, 0x4e, 0x21, 0x4f, 0x48, 0x89, 0x7c, 0x92, 0x84, 0x9c,
+    0xbf, 0x76, 0xc0, 0xae, 0x02, 0x14, 0x01, 0x00, 0x05, 0x04, 0x32, 0x41, 0xe8, 0xf0, 0xd9, 0xdf,
+    0x12, 0xf8, 0xff, 0xa3, 0xec, 0xfb, 0xff, 0x67, 0x31, 0x1c, 0x3e, 0xc3, 0xbc, 0x63, 0x8e, 0x24,
+    0xbd, 0xd1, 0x92, 0xdf, 0x81, 0xbd, 0x54, 0xaf, 0x4d, 0x40, 0x45, 0x00, 0x00, 0x00, 0x01, 0x00,
+    0xdd, 0x13, 0x1d, 0x00, 0x01, 0x6a, 0x58, 0x67, 0x36,
+};
+
+// zstd -19: 16x16 RGBA8 texture level
+static const uint8_t ZSTD_FRAME_LEVEL16[] = {
+    0x28, 0xb5, 0x2f, 0xfd, 0x64, 0x00, 0x03, 0x6d, 0x10, 0x00, 0x0a, 0x40, 0x20, 0x08, 0x13, 0xd0,
+    0xe7, 0x00, 0x00, 0x00, 0x00, 0x40, 0x29, 0x55, 0x45, 0xb2, 0xe5, 0x57, 0xa5, 0x4a, 0x55, 0xa9,
+    0x46, 0x12, 0x78, 0x00, 0x7d, 0x00, 0x7b, 0x00, 0xe3, 0x78, 0xe3, 0x70, 0xe3, 0x68, 0xe3, 0x60,
+    0xe3, 0x58, 0x77, 0xf4, 0x8e, 0x74, 0x07, 0xba, 0xe3, 0xdc, 0x61, 0xee, 0x28, 0x77, 0x90, 0x3b,
+    0xc6, 0x1d, 0xe2, 0x8e, 0x70, 0x07, 0xb8, 0xe2, 0x5d, 0xe1, 0xae, 0x68, 0x57, 0xb0, 0x2b, 0xd6,
+    0x15, 0xbd, 0x22, 0x5d, 0x81, 0xae, 0x38, 0x57, 0x98, 0x2b, 0xca, 0x15, 0xe4, 0x8a, 0x71, 0x85,
+    0xb8, 0x22, 0x5c, 0x01, 0x6e, 0x78, 0x37, 0xb8, 0x1b, 0xda, 0x0d, 0xec, 0x86, 0x75, 0x43, 0x6f,
+    0x48, 0x37, 0xa0, 0x1b, 0xce, 0x0d, 0xe6, 0x86, 0x72, 0x03, 0xb9, 0x61, 0xdc, 0x20, 0x6e, 0x08,
+    0x37, 0x80, 0x0b, 0xde, 0x05, 0xee, 0x82, 0x76, 0x01, 0xbb, 0x60, 0x5d, 0xd0, 0x0b, 0xd2, 0x05,
+    0xe8, 0x82, 0x73, 0x81, 0xb9, 0xa0, 0x5c, 0x40, 0x2e, 0x18, 0x17, 0x88, 0x0b, 0xc2, 0x05, 0x20,
+    0xab, 0xf3, 0x56, 0xc7, 0x9d, 0xa7, 0x9d, 0x87, 0x9d, 0x67, 0x9d, 0xa7, 0xe3, 0x49, 0xe3, 0x41,
+    0xe3, 0x39, 0xe3, 0x31, 0xe3, 0x29, 0xf7, 0x90, 0x7b, 0xc6, 0x3d, 0xe2, 0x9e, 0x70, 0x0f, 0x38,
+    0xcd, 0x3b, 0x8d, 0x3b, 0x4d, 0x3b, 0x0d, 0x3b, 0xcd, 0x1a, 0x4d, 0x47, 0x93, 0x46, 0x83, 0x46,
+    0x73, 0x46, 0x63, 0xae, 0x29, 0xd7, 0x90, 0x6b, 0xc6, 0x35, 0xe2, 0x9a, 0x70, 0x0d, 0x38, 0xcb,
+    0x3b, 0x8b, 0x3b, 0x4b, 0x1b, 0x0b, 0x1b, 0xcb, 0x1a, 0x4b, 0xc7, 0x92, 0xc6, 0x82, 0xc6, 0x72,
+    0x6e, 0x31, 0xb7, 0x94, 0x5b, 0xc8, 0x2d, 0xe3, 0x16, 0x71, 0x4b, 0xb8, 0x05, 0x8c, 0xe4, 0x8d,
+    0xc4, 0x8d, 0xa4, 0x8d, 0x84, 0x8d, 0x64, 0x8d, 0xa4, 0x23, 0x49, 0x23, 0x41, 0x97, 0x9c, 0x4b,
+    0xcc, 0x25, 0xe5, 0x12, 0x72, 0xc9, 0xb8, 0x44, 0x5c, 0x12, 0x2e, 0x01, 0x01, 0xe3, 0x7a, 0x77,
+    0xb9, 0xbb, 0xda, 0x5d, 0x6c, 0xb5, 0xd6, 0x6a, 0x75, 0xb5, 0xd2, 0xb9, 0xd0, 0xb9, 0xce, 0xb9,
+    0xcc, 0xb8, 0xca, 0xb8, 0xc8, 0xb8, 0xc6, 0x5d, 0xe2, 0xae, 0x70, 0x17, 0xb8, 0x7d, 0xb7, 0xee,
+    0xb6, 0xad, 0xca, 0x56, 0x5d, 0xab, 0xf6, 0x6c, 0x3a, 0x8b, 0xce, 0x9e, 0xb1, 0x66, 0x6c, 0x19,
+    0x4b, 0x6e, 0xc7, 0xad, 0xb8, 0x0d, 0xb7, 0xe0, 0xa6, 0xb7, 0x4a, 0x6e, 0x95, 0xda, 0x2a, 0xb1,
+    0x55, 0x5a, 0x67, 0xea, 0x99, 0xd2, 0x99, 0xd0, 0x98, 0xce, 0x98, 0xcc, 0x98, 0xca, 0x98, 0xc8,
+    0x4d, 0xe3, 0x26, 0x71, 0x53, 0xb8, 0x09, 0xac, 0xd0, 0x5b, 0x21, 0xb7, 0x42, 0x6d, 0x85, 0xd8,
+    0x89, 0xd6, 0x89, 0x7a, 0xa2, 0x74, 0x22, 0x34, 0xa2, 0x33, 0x22, 0x33, 0xa2, 0x32, 0x22, 0x72,
+    0xd1, 0xb8, 0x48, 0x5c, 0x14, 0x2e, 0x02, 0x01, 0xab, 0xf7, 0xce, 0xe7, 0xce, 0xd7, 0xc6, 0xc7,
+    0xc6, 0xb7, 0xee, 0xeb, 0x7d, 0x69, 0xf5, 0xd0, 0xea, 0x9d, 0xf3, 0x99, 0xf3, 0x95, 0xf1, 0x91,
+    0xf1, 0x8d, 0xfb, 0xc4, 0x7d, 0xe1, 0x3e, 0x70, 0xba, 0x77, 0x3a, 0x37, 0xba, 0x36, 0x3a, 0x76,
+    0xdd, 0xba, 0xae, 0x2b, 0x97, 0x56, 0x0e, 0xad, 0xdc, 0x39, 0x9d, 0x39, 0x5d, 0x19, 0x1d, 0x19,
+    0xdd, 0xb8, 0x4e, 0x5c, 0x17, 0xae, 0x03, 0x67, 0x7b, 0x63, 0x73, 0x63, 0x6b, 0xb7, 0xb1, 0xdb,
+    0xd6, 0x6d, 0x5d, 0xb5, 0xb4, 0x6a, 0xe8, 0x6c, 0xe7, 0x6c, 0xe6, 0x6c, 0x65, 0x6c, 0x64, 0x6c,
+    0xe3, 0x36, 0x71, 0x5b, 0xb8, 0x0d, 0x8c, 0xec, 0x8d, 0xcc, 0x5d, 0xd6, 0x2e, 0x63, 0x97, 0xad,
+    0x15, 0xeb, 0x8a, 0xa5, 0x15, 0x43, 0x27, 0x3b, 0x27, 0x33, 0x23, 0x2b, 0x23, 0x23, 0x23, 0x1b,
+    0x97, 0x89, 0xcb, 0xc2, 0x65, 0x20, 0x00, 0xc4, 0xe2, 0x8e, 0x56,
+};
+
+// zstd -19: 8x8 level
+static const uint8_t ZSTD_FRAME_LEVEL8[] = {
+    0x28, 0xb5, 0x2f, 0xfd, 0x64, 0x00, 0x00, 0x05, 0x04, 0x00, 0x06, 0x10, 0x1f, 0x0d, 0xf0, 0x39,
+    0xff, 0xff, 0xbb, 0x68, 0x5b, 0x6b, 0x59, 0x6b, 0xad, 0x4b, 0x01, 0x19, 0x00, 0x1a, 0x00, 0x1a,
+    0x00, 0x17, 0xec, 0x42, 0x5d, 0xa0, 0x0b, 0x73, 0x41, 0x2e, 0xc4, 0x05, 0xb8, 0xc0, 0x4b, 0xbb,
+    0xac, 0x4b, 0xba, 0x9c, 0x4b, 0xb9, 0x8c, 0x4b, 0xb8, 0x64, 0x57, 0xec, 0x4a, 0x5d, 0xa1, 0x2b,
+    0x73, 0x45, 0xae, 0xc4, 0x15, 0xb8, 0xc2, 0x1b, 0x76, 0xa3, 0x6e, 0xd0, 0x8d, 0xb9, 0x21, 0x37,
+    0xe2, 0x06, 0xdc, 0x60, 0x1f, 0xd9, 0xa5, 0xba, 0x44, 0x97, 0xe6, 0x92, 0x5c, 0x8a, 0x4b, 0x70,
+    0x89, 0x77, 0xec, 0x4e, 0xdd, 0xa1, 0x3b, 0x73, 0x47, 0xee, 0xc4, 0x1d, 0xb8, 0xc3, 0x9f, 0xd9,
+    0x67, 0xf5, 0x19, 0x5d, 0x9b, 0x6b, 0x72, 0x2d, 0xae, 0xc1, 0x35, 0x7e, 0x65, 0x5f, 0xd5, 0x2d,
+    0xba, 0x35, 0xb7, 0xe4, 0x56, 0xdc, 0x82, 0x5b, 0x0c, 0x00, 0x85, 0x70, 0xbb, 0xa8,
+};
+
+// zstd -19: 4x4 level
+static const uint8_t ZSTD_FRAME_LEVEL4[] = {
+    0x28, 0xb5, 0x2f, 0xfd, 0x24, 0x40, 0x25, 0x01, 0x00, 0x02, 0x04, 0x08, 0x0a, 0xf0, 0x39, 0xff,
+    0xff, 0xc7, 0x61, 0x6b, 0xed, 0x92, 0x01, 0xbb, 0xed, 0xb4, 0xcb, 0x0e, 0xab, 0xad, 0xb4, 0xca,
+    0x0a, 0x9b, 0x6d, 0xb4, 0xc9, 0x06, 0x8b, 0x2d, 0xb4, 0xc8, 0x02, 0x01, 0x00, 0xaf, 0x78, 0xce,
+    0x13,
+};
+
+// zstd -19: 2x2 level
+static const uint8_t ZSTD_FRAME_LEVEL2[] = {
+    0x28, 0xb5, 0x2f, 0xfd, 0x24, 0x10, 0x81, 0x00, 0x00, 0x00, 0x00, 0x28, 0xff, 0x04, 0x00, 0x28,
+    0xff, 0x00, 0x04, 0x28, 0xff, 0x04, 0x04, 0x28, 0xff, 0x72, 0xfb, 0xf5, 0x91,
+};
+
+// zstd -19: 1x1 level
+static const uint8_t ZSTD_FRAME_LEVEL1[] = {
+    0x28, 0xb5, 0x2f, 0xfd, 0x24, 0x04, 0x21, 0x00, 0x00, 0x00, 0x00, 0x28, 0xff, 0xe4, 0x0e, 0x79,
+    0xac,
+};
+
+#endif // EDEN_KTX2_BENCHMARK_FRAMES_H
@@ -0,0 +1,162 @@
+// EDEN ENGINE - Mip Builder Benchmark
+// Speed and accuracy of stdlib/mip_builder.h: the SSE2 build against the scalar reference
+// Usage: mip_builder_benchmark [size] [threads]
+//   Builds full chains of a `size` x `size` (default 1024) test image with both filters, sRGB and
+//   UNORM, on `threads` (default hardware concurrency) and on one thread, times the reference
+//   build, and compares the chains with compare_mip_chains. An accuracy sweep over small, odd and
+//   non-square sizes and a few images with known answers follow.
+//   Build with -U__SSE2__ to measure the scalar fallback instead of the SSE2 path.
+
+#include "../../stdlib/mip_builder.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdio>
+
+// Largest channel difference allowed between build_mip_chain and the reference. Each builds a
+// level from its own previous level, so 1 LSB rounding differences can compound down the chain.
+static const int MAX_DIFF_LSB = 2;
+
+static uint32_t randomInt(uint32_t& seed) {
+    seed = seed * 1664525u + 1013904223u;
+    return seed >> 8;
+}
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 8x8 blocks of noise, horizontal gradient and hard-edged checkers (exercises ringing and rounding)
+static std::vector<uint8_t> makeImage(uint32_t width, uint32_t height, uint32_t seed) {
+    std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            for (uint32_t c = 0; c < 4; c++) {
+                uint8_t value;
+                switch ((x / 8 + y / 8) % 3) {
+                    case 0:  value = static_cast<uint8_t>(randomInt(seed)); break;
+                    case 1:  value = static_cast<uint8_t>(x * 255 / std::max(width - 1, 1u)); break;
+                    default: value = ((x ^ y) & 4) ? 255 : 0; break;
+                }
+                rgba[(static_cast<size_t>(y) * width + x) * 4 + c] = value;
+            }
+        }
+    }
+    return rgba;
+}
+
+static const char* configName(MipFilter filter, bool srgb) {
+    if (filter == MipFilter::Box) {
+        return srgb ? "box, sRGB" : "box, UNORM";
+    }
+    return srgb ? "kaiser, sRGB" : "kaiser, UNORM";
+}
+
+// Small, odd and non-square sizes down to 1x1, every filter and encoding: largest difference seen
+static int accuracySweep(MipFilter filter, bool srgb) {
+    static const uint32_t SIZES[] = {1, 2, 3, 5, 7, 16, 31, 33, 100, 127, 255, 257};
+    int worst = 0;
+    for (uint32_t width : SIZES) {
+        for (uint32_t height : SIZES) {
+            std::vector<uint8_t> image = makeImage(width, height, width * 131 + height);
+            MipChain fast = build_mip_chain(image.data(), width, height, srgb, filter);
+            MipChain reference = build_mip_chain_reference(image.data(), width, height, srgb, filter);
+            int diff = compare_mip_chains(fast, reference);
+            worst = diff < 0 ? 255 : std::max(worst, diff);
+        }
+    }
+    return worst;
+}
+
+// Images whose chains are known exactly
+static bool checkKnownAnswers() {
+    bool ok = mip_level_count(1, 1) == 1 && mip_level_count(1024, 1) == 11 && mip_level_count(1000, 7) == 10;
+
+    // Layout: each level halves (rounding down, never below 1) and the levels are packed back to back
+    std::vector<uint8_t> image = makeImage(37, 6, 1);
+    MipChain chain = build_mip_chain(image.data(), 37, 6, true);
+    size_t offset = 0;
+    uint32_t width = 37, height = 6;
+    for (const MipLevel& level : chain.levels) {
+        ok = ok && level.width == width && level.height == height && level.offset == offset && level.size == size_t(width) * height * 4;
+        offset += level.size;
+        width = std::max(width / 2, 1u);
+        height = std::max(height / 2, 1u);
+    }
+    ok = ok && chain.levels.size() == 6 && chain.data.size() == offset &&
+         std::equal(image.begin(), image.end(), chain.data.begin());
+
+    // 2x2 black/white: UNORM averages to 128; sRGB averages in linear light to 188 (alpha stays 128)
+    const uint8_t checker[16] = {0, 0, 0, 0, 255, 255, 255, 255, 255, 255, 255, 255, 0, 0, 0, 0};
+    for (int pass = 0; pass < 2; pass++) {
+        MipChain unorm = pass == 0 ? build_mip_chain(checker, 2, 2, false) : build_mip_chain_reference(checker, 2, 2, false);
+        MipChain srgb = pass == 0 ? build_mip_chain(checker, 2, 2, true) : build_mip_chain_reference(checker, 2, 2, true);
+        ok = ok && unorm.data[16] == 128 && unorm.data[19] == 128;
+        ok = ok && srgb.data[16] == 188 && srgb.data[17] == 188 && srgb.data[18] == 188 && srgb.data[19] == 128;
+    }
+
+    // A constant image stays exactly constant at every level, with both filters and encodings
+    for (int value = 0; value < 256; value += 5) {
+        std::vector<uint8_t> flat(37 * 23 * 4, static_cast<uint8_t>(value));
+        for (MipFilter filter : {MipFilter::Box, MipFilter::Kaiser}) {
+            for (bool srgb : {false, true}) {
+                MipChain built = build_mip_chain(flat.data(), 37, 23, srgb, filter);
+                ok = ok && std::all_of(built.data.begin(), built.data.end(), [&](uint8_t v) { return v == value; });
+            }
+        }
+    }
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    uint32_t size = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 1024;
+    uint32_t threads = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 0;
+    size = std::max(size, 1u);
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    std::vector<uint8_t> image = makeImage(size, size, 42);
+#ifdef EDEN_MIP_SSE2
+    const char* path = "SSE2";
+#else
+    const char* path = "scalar fallback";
+#endif
+    std::cout << std::fixed << size << "x" << size << ", " << mip_level_count(size, size) << " levels, "
+              << path << " path, " << threads << " thread(s); tolerance " << MAX_DIFF_LSB << " LSB" << std::endl;
+    std::cout << "config           fast ms  1 thread ms  reference ms  speedup  chain diff  sweep diff  check" << std::endl;
+
+    bool allOk = true;
+    for (MipFilter filter : {MipFilter::Box, MipFilter::Kaiser}) {
+        for (bool srgb : {false, true}) {
+            auto start = std::chrono::steady_clock::now();
+            MipChain fast = build_mip_chain(image.data(), size, size, srgb, filter, threads);
+            double fastMs = elapsedMs(start);
+            start = std::chrono::steady_clock::now();
+            MipChain single = build_mip_chain(image.data(), size, size, srgb, filter, 1);
+            double singleMs = elapsedMs(start);
+            start = std::chrono::steady_clock::now();
+            MipChain reference = build_mip_chain_reference(image.data(), size, size, srgb, filter);
+            double referenceMs = elapsedMs(start);
+
+            int chainDiff = compare_mip_chains(fast, reference);
+            int sweepDiff = accuracySweep(filter, srgb);
+            // Threads only split rows, so the result must not depend on the thread count
+            bool ok = chainDiff >= 0 && chainDiff <= MAX_DIFF_LSB && sweepDiff <= MAX_DIFF_LSB &&
+                      compare_mip_chains(fast, single) == 0;
+            allOk = allOk && ok;
+            std::cout << std::left << std::setw(15) << configName(filter, srgb) << std::right << std::setprecision(2)
+                      << std::setw(9) << fastMs
+                      << std::setw(13) << singleMs
+                      << std::setw(14) << referenceMs
+                      << std::setprecision(1) << std::setw(8) << referenceMs / std::max(fastMs, 1e-3) << "x"
+                      << std::setw(12) << chainDiff
+                      << std::setw(12) << sweepDiff
+                      << (ok ? "    yes" : "    NO") << std::endl;
+        }
+    }
+
+    bool known = checkKnownAnswers();
+    std::cout << "known answers: " << (known ? "yes" : "NO") << std::endl;
+    return allOk && known ? 0 : 1;
+}
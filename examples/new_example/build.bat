@@ -53,6 +53,7 @@ g++ -std=c++17 -O3 ^
     -L"%VULKAN_SDK%\Lib" ^
     -L"%GLFW_PATH%\build\src" ^
     -lvulkan-1 ^
+    -lshaderc_shared ^
     -lglfw3 ^
     -lgdi32
 
@@ -0,0 +1,180 @@
+// EDEN ENGINE - Physics Benchmark
+// Headless stability, determinism and throughput check for stdlib/rigid_body.h
+// Usage: physics_benchmark [bodies] [steps] [threads]
+//   Bodies (default 2000) are used twice: as stacks of 20 boxes standing on the ground, and as a
+//   pile of boxes and spheres dropped from above. Steps (default 300) are 1/60 s each. The pile is
+//   then simulated again single-threaded and must end bit-for-bit in the same place.
+
+#include "../../stdlib/rigid_body.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+
+static float randomFloat(uint32_t& seed, float lo, float hi) {
+    seed = seed * 1664525u + 1013904223u;
+    return lo + (hi - lo) * static_cast<float>(seed >> 8) / 16777216.0f;
+}
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void addGround(PhysicsWorld& world) {
+    RigidBodyDesc ground;
+    ground.halfExtents[0] = 500.0f;
+    ground.halfExtents[1] = 0.5f;
+    ground.halfExtents[2] = 500.0f;
+    ground.position[1] = -0.5f;
+    ground.isStatic = true;
+    world.createBody(ground);
+}
+
+// Boxes and spheres in a loose cloud above a 20 m square, falling onto each other
+static std::vector<uint32_t> addPile(PhysicsWorld& world, size_t count) {
+    std::vector<uint32_t> bodies;
+    uint32_t seed = 777;
+    size_t perLayer = 20 * 20;
+    for (size_t i = 0; i < count; i++) {
+        RigidBodyDesc desc;
+        size_t layer = i / perLayer;
+        size_t cell = i % perLayer;
+        desc.position[0] = static_cast<float>(cell % 20) - 9.5f + randomFloat(seed, -0.2f, 0.2f);
+        desc.position[1] = 1.0f + 1.2f * static_cast<float>(layer);
+        desc.position[2] = static_cast<float>(cell / 20) - 9.5f + randomFloat(seed, -0.2f, 0.2f);
+        if (i % 3 == 2) {
+            desc.shape = PhysicsShape::Sphere;
+            desc.radius = 0.4f;
+        } else {
+            float size = randomFloat(seed, 0.5f, 0.9f);
+            desc.halfExtents[0] = desc.halfExtents[1] = desc.halfExtents[2] = size * 0.5f;
+        }
+        desc.mass = randomFloat(seed, 0.5f, 5.0f);
+        bodies.push_back(world.createBody(desc));
+    }
+    return bodies;
+}
+
+struct RunResult {
+    double averageMs = 0.0;
+    double worstMs = 0.0;
+    uint32_t peakContacts = 0;
+    uint32_t peakIslands = 0;
+    uint32_t peakLargest = 0;
+};
+
+static RunResult runSteps(PhysicsWorld& world, int steps) {
+    RunResult result;
+    double totalMs = 0.0;
+    for (int i = 0; i < steps; i++) {
+        auto start = std::chrono::steady_clock::now();
+        world.step();
+        double ms = elapsedMs(start);
+        totalMs += ms;
+        result.worstMs = std::max(result.worstMs, ms);
+        const PhysicsWorld::Stats& stats = world.getStats();
+        result.peakContacts = std::max(result.peakContacts, stats.contacts);
+        result.peakIslands = std::max(result.peakIslands, stats.islands);
+        result.peakLargest = std::max(result.peakLargest, stats.largestIsland);
+    }
+    result.averageMs = totalMs / std::max(steps, 1);
+    return result;
+}
+
+static void printRow(const char* scene, const PhysicsWorld& world, const RunResult& run, const char* check, bool ok) {
+    std::cout << std::left << std::setw(8) << scene << std::right
+              << std::setw(8) << world.getStats().bodies
+              << std::setw(10) << run.peakContacts
+              << std::setw(9) << run.peakIslands
+              << std::setw(9) << run.peakLargest
+              << std::setw(8) << world.getStats().awakeBodies
+              << std::setprecision(3) << std::setw(10) << run.averageMs
+              << std::setw(10) << run.worstMs
+              << "   " << check << (ok ? " yes" : " NO") << std::endl;
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 2000;
+    int steps = argc > 2 ? std::atoi(argv[2]) : 300;
+    uint32_t threads = argc > 3 ? static_cast<uint32_t>(std::atoi(argv[3])) : 0;
+    const size_t STACK_HEIGHT = 20;
+
+    std::cout << std::fixed << count << " bodies, " << steps << " steps of 1/60 s, "
+              << (threads ? threads : std::max(1u, std::thread::hardware_concurrency())) << " thread(s)" << std::endl;
+    std::cout << "scene     bodies  contacts  islands  largest   awake   avg ms    max ms   check" << std::endl;
+    bool allOk = true;
+
+    // Stacks: 20 boxes per column, columns 3 m apart; each must stay standing where it was built
+    {
+        PhysicsConfig config;
+        config.threadCount = threads;
+        PhysicsWorld world(config);
+        addGround(world);
+        size_t stacks = std::max<size_t>(1, count / STACK_HEIGHT);
+        size_t side = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(stacks))));
+        std::vector<uint32_t> tops;
+        for (size_t s = 0; s < stacks; s++) {
+            float x = 3.0f * static_cast<float>(s % side);
+            float z = 3.0f * static_cast<float>(s / side);
+            for (size_t level = 0; level < STACK_HEIGHT; level++) {
+                RigidBodyDesc desc;
+                desc.position[0] = x;
+                desc.position[1] = 0.5f + static_cast<float>(level);
+                desc.position[2] = z;
+                uint32_t body = world.createBody(desc);
+                if (level + 1 == STACK_HEIGHT) {
+                    tops.push_back(body);
+                }
+            }
+        }
+        RunResult result = runSteps(world, steps);
+
+        float worstSink = 0.0f;
+        float worstDrift = 0.0f;
+        for (size_t s = 0; s < stacks; s++) {
+            float p[3];
+            world.getPosition(tops[s], p);
+            worstSink = std::max(worstSink, (0.5f + STACK_HEIGHT - 1.0f) - p[1]);
+            worstDrift = std::max(worstDrift, std::max(std::fabs(p[0] - 3.0f * static_cast<float>(s % side)),
+                                                       std::fabs(p[2] - 3.0f * static_cast<float>(s / side))));
+        }
+        bool ok = worstSink < 0.2f && worstDrift < 0.01f;
+        allOk = allOk && ok;
+        char check[96];
+        std::snprintf(check, sizeof(check), "top sink %.3f m, drift %.4f m", worstSink, worstDrift);
+        printRow("stacks", world, result, check, ok);
+    }
+
+    // Pile: everything dropped at once into one heap; nothing may end up below the ground
+    std::vector<float> threadedPositions;
+    for (int run = 0; run < 2; run++) {
+        PhysicsConfig config;
+        config.threadCount = run == 0 ? threads : 1;
+        PhysicsWorld world(config);
+        addGround(world);
+        std::vector<uint32_t> bodies = addPile(world, count);
+        RunResult result = runSteps(world, steps);
+
+        std::vector<float> positions(bodies.size() * 3);
+        float lowest = 1e30f;
+        for (size_t i = 0; i < bodies.size(); i++) {
+            world.getPosition(bodies[i], &positions[i * 3]);
+            lowest = std::min(lowest, positions[i * 3 + 1]);
+        }
+        char check[96];
+        bool ok;
+        if (run == 0) {
+            threadedPositions = positions;
+            ok = lowest > 0.0f;
+            std::snprintf(check, sizeof(check), "lowest center %.3f m", lowest);
+        } else {
+            ok = std::memcmp(positions.data(), threadedPositions.data(), positions.size() * sizeof(float)) == 0;
+            std::snprintf(check, sizeof(check), "same as threaded run");
+        }
+        allOk = allOk && ok;
+        printRow(run == 0 ? "pile" : "pile x1", world, result, check, ok);
+    }
+    return allOk ? 0 : 1;
+}
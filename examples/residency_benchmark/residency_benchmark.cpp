@@ -0,0 +1,388 @@
+// EDEN ENGINE - Residency Benchmark
+// Headless budget/eviction check for stdlib/residency_manager.h with mock assets (no GPU)
+// Usage: residency_benchmark [assets] [frames] [budget_mb]
+//   Tracks `assets` (default 2000) mock textures and meshes with fake allocation sizes and walks a
+//   camera across them for `frames` (default 3000) frames, touching what it sees, under a budget
+//   of `budget_mb` (default 512). Every pass of enforceBudget() is checked against the mock assets:
+//   LRU order, top mips dropped before an asset is evicted, nothing evicted while a frame in flight
+//   may use it, and the bytes freed. A hand-traced sequence with known sizes follows.
+
+#include "../../stdlib/residency_manager.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+static const uint32_t MIN_IDLE_FRAMES = 3;   // What the renderer sets with two frames in flight
+
+static uint32_t randomInt(uint32_t& seed, uint32_t lo, uint32_t hi) {
+    seed = seed * 1664525u + 1013904223u;
+    return lo + (seed >> 8) % (hi - lo + 1);
+}
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// What the manager asked a mock asset to do, in call order
+struct Event {
+    enum Kind { DROP, EVICT, RESTORE } kind;
+    int asset;
+    size_t bytes;
+};
+
+// Fake allocation: a mip chain (finest first) or a single-level mesh. Like TextureResource, detail
+// can be dropped one top level at a time until one level is left. Calls made while the asset may
+// still be in use, or an eviction while it could still degrade, are counted as violations.
+struct MockAsset : ResidentAsset {
+    int id = 0;
+    std::vector<size_t> levels;
+    size_t first = 0;                   // Finest resident level
+    bool resident = true;
+    bool pinned = false;
+    uint64_t lastUsedFrame = 0;         // Manager frame of the last touch
+    uint64_t lastUsedOrder = 0;         // Global touch counter at the last touch (LRU order)
+    ResidencyHandle handle = INVALID_RESIDENCY_HANDLE;
+
+    static const ResidencyManager* s_manager;
+    static std::vector<Event>* s_events;
+    static uint64_t s_tooRecent;
+    static uint64_t s_evictedBeforeDegrading;
+
+    size_t getResidentBytes() const override {
+        size_t bytes = 0;
+        for (size_t level = first; resident && level < levels.size(); level++) {
+            bytes += levels[level];
+        }
+        return bytes;
+    }
+
+    void checkIdle() const {
+        if (s_manager->getFrame() - lastUsedFrame < MIN_IDLE_FRAMES) {
+            s_tooRecent++;
+        }
+    }
+
+    size_t evictResidency() override {
+        checkIdle();
+        if (levels.size() - first > 1) {
+            s_evictedBeforeDegrading++;
+        }
+        size_t bytes = getResidentBytes();
+        resident = false;
+        first = 0;
+        s_events->push_back({Event::EVICT, id, bytes});
+        return bytes;
+    }
+
+    bool restoreResidency() override {
+        resident = true;
+        first = 0;
+        s_events->push_back({Event::RESTORE, id, getResidentBytes()});
+        return true;
+    }
+
+    size_t dropDetail() override {
+        if (levels.size() - first <= 1) {
+            return 0;
+        }
+        checkIdle();
+        size_t bytes = levels[first++];
+        s_events->push_back({Event::DROP, id, bytes});
+        return bytes;
+    }
+};
+
+const ResidencyManager* MockAsset::s_manager = nullptr;
+std::vector<Event>* MockAsset::s_events = nullptr;
+uint64_t MockAsset::s_tooRecent = 0;
+uint64_t MockAsset::s_evictedBeforeDegrading = 0;
+
+static uint64_t g_touchOrder = 0;
+
+static bool touchAsset(ResidencyManager& residency, MockAsset& asset) {
+    asset.lastUsedFrame = residency.getFrame();
+    asset.lastUsedOrder = ++g_touchOrder;
+    return residency.touch(asset.handle);
+}
+
+// RGBA8 chain from `size` down to 1x1
+static std::vector<size_t> textureLevels(uint32_t size) {
+    std::vector<size_t> levels;
+    for (uint32_t s = size; s >= 1; s /= 2) {
+        levels.push_back(static_cast<size_t>(s) * s * 4);
+    }
+    return levels;
+}
+
+struct StreamResult {
+    uint64_t passes = 0;
+    uint64_t drops = 0;
+    uint64_t evictions = 0;
+    uint64_t restores = 0;
+    uint64_t framesOverBudget = 0;
+    size_t peakBytes = 0;
+    size_t totalBytes = 0;
+    double touchMs = 0.0;
+    double beginFrameMs = 0.0;
+    uint64_t touches = 0;
+    bool accountingOk = true;
+    bool lruOk = true;
+    bool freedOk = true;
+    bool budgetOk = true;
+    bool pinnedOk = true;
+    bool restoreOk = true;
+};
+
+// A camera walks across a row of assets and touches the 48 around it, plus a few stray ones
+static StreamResult runWorkload(uint32_t assetCount, uint32_t frames, size_t budget) {
+    StreamResult result;
+    ResidencyManager residency;
+    residency.setBudget(budget);
+    residency.setMinIdleFrames(MIN_IDLE_FRAMES);
+    std::vector<Event> events;
+    MockAsset::s_manager = &residency;
+    MockAsset::s_events = &events;
+
+    uint32_t seed = 12345u;
+    std::vector<std::unique_ptr<MockAsset>> assets;
+    for (uint32_t i = 0; i < assetCount; i++) {
+        auto asset = std::make_unique<MockAsset>();
+        asset->id = static_cast<int>(i);
+        if (randomInt(seed, 0, 9) < 7) {
+            asset->levels = textureLevels(64u << randomInt(seed, 0, 5));    // 64 - 2048
+        } else {
+            asset->levels = {static_cast<size_t>(randomInt(seed, 16, 2048)) * 1024};   // Mesh
+        }
+        asset->lastUsedFrame = residency.getFrame();
+        asset->lastUsedOrder = ++g_touchOrder;
+        asset->handle = residency.track(asset.get());
+        asset->pinned = i % 97 == 0;
+        residency.setPinned(asset->handle, asset->pinned);
+        result.totalBytes += asset->getResidentBytes();
+        assets.push_back(std::move(asset));
+    }
+
+    const uint32_t window = 48;
+    for (uint32_t frame = 0; frame < frames; frame++) {
+        std::vector<uint32_t> visible;
+        uint32_t camera = (frame * 3 / 2) % assetCount;
+        for (uint32_t k = 0; k < window; k++) {
+            visible.push_back((camera + k) % assetCount);
+        }
+        for (int k = 0; k < 4; k++) {
+            visible.push_back(randomInt(seed, 0, assetCount - 1));
+        }
+
+        events.clear();
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t index : visible) {
+            MockAsset& asset = *assets[index];
+            bool wasResident = asset.resident;
+            bool restored = touchAsset(residency, asset);
+            result.restoreOk = result.restoreOk && restored == !wasResident && asset.resident &&
+                               residency.isResident(asset.handle);
+        }
+        result.touchMs += elapsedMs(start);
+        result.touches += visible.size();
+        result.restores += events.size();
+
+        // One frame: advance the clock and enforce the budget
+        size_t before = residency.getResidentBytes();
+        events.clear();
+        start = std::chrono::steady_clock::now();
+        residency.beginFrame();
+        result.beginFrameMs += elapsedMs(start);
+        size_t after = residency.getResidentBytes();
+        result.passes += events.empty() ? 0 : 1;
+
+        // Accounting: the manager's bytes and evicted count match the assets
+        size_t actual = 0;
+        uint32_t evicted = 0;
+        for (const auto& asset : assets) {
+            actual += asset->getResidentBytes();
+            evicted += asset->resident ? 0 : 1;
+        }
+        result.accountingOk = result.accountingOk && actual == after && residency.getStats().evictedCount == evicted;
+        if (frame >= MIN_IDLE_FRAMES) {
+            result.peakBytes = std::max(result.peakBytes, after);   // Once the initial load could be shed
+        }
+
+        // Freed bytes: the pass freed exactly what the assets gave back
+        size_t freed = 0;
+        for (const Event& event : events) {
+            freed += event.bytes;
+            result.freedOk = result.freedOk && event.kind != Event::RESTORE;
+            result.pinnedOk = result.pinnedOk && !assets[event.asset]->pinned;
+            result.drops += event.kind == Event::DROP ? 1 : 0;
+            result.evictions += event.kind == Event::EVICT ? 1 : 0;
+        }
+        result.freedOk = result.freedOk && before - after == freed;
+
+        // LRU order: assets are shed least recently used first, each one degraded and then evicted
+        // completely before the next is touched, and the pass stops as soon as the budget is met
+        for (size_t i = 1; i < events.size(); i++) {
+            const MockAsset& previous = *assets[events[i - 1].asset];
+            const MockAsset& current = *assets[events[i].asset];
+            if (previous.id != current.id) {
+                result.lruOk = result.lruOk && !previous.resident && previous.lastUsedOrder < current.lastUsedOrder;
+            }
+        }
+        if (!events.empty()) {
+            uint64_t lastOrder = assets[events.back().asset]->lastUsedOrder;
+            for (const auto& asset : assets) {
+                if (asset->resident && !asset->pinned && asset->id != events.back().asset) {
+                    result.lruOk = result.lruOk && asset->lastUsedOrder > lastOrder;
+                }
+            }
+            result.lruOk = result.lruOk && (after > budget || after + events.back().bytes > budget);
+        }
+
+        // Budget: met, unless everything still over it was used by a frame that may be in flight
+        if (after > budget) {
+            result.framesOverBudget++;
+            for (const auto& asset : assets) {
+                if (asset->resident && !asset->pinned) {
+                    result.budgetOk = result.budgetOk && residency.getFrame() - asset->lastUsedFrame < MIN_IDLE_FRAMES;
+                }
+            }
+        }
+    }
+
+    for (const auto& asset : assets) {
+        residency.untrack(asset->handle);
+    }
+    result.accountingOk = result.accountingOk && residency.getResidentBytes() == 0 &&
+                          residency.getStats().trackedCount == 0 && residency.getStats().evictedCount == 0;
+    return result;
+}
+
+// Hand-traced sequence (minimum idle 3 frames):
+//   A: texture levels 64K/16K/4K, B: 50K mesh, C: texture 16K/4K, D: 100K mesh, pinned
+static bool checkKnownSequence() {
+    const size_t K = 1024;
+    ResidencyManager residency;
+    residency.setMinIdleFrames(MIN_IDLE_FRAMES);
+    std::vector<Event> events;
+    MockAsset::s_manager = &residency;
+    MockAsset::s_events = &events;
+
+    MockAsset a, b, c, d;
+    a.id = 0;
+    a.levels = {64 * K, 16 * K, 4 * K};
+    b.id = 1;
+    b.levels = {50 * K};
+    c.id = 2;
+    c.levels = {16 * K, 4 * K};
+    d.id = 3;
+    d.levels = {100 * K};
+    for (MockAsset* asset : {&a, &b, &c, &d}) {
+        asset->handle = residency.track(asset);
+    }
+    residency.setPinned(d.handle, true);
+    bool ok = residency.getResidentBytes() == 254 * K && residency.getStats().trackedCount == 4;
+
+    // No budget: nothing is shed
+    residency.beginFrame();
+    ok = ok && events.empty() && residency.enforceBudget() == 0;
+
+    // 200K budget: everything was used within the last 3 frames, so it waits until frame 3
+    residency.setBudget(200 * K);
+    ok = ok && residency.enforceBudget() == 0;
+    residency.beginFrame();
+    ok = ok && events.empty() && residency.getFrame() == 2;
+    residency.beginFrame();
+    ok = ok && events.size() == 1 && events[0].kind == Event::DROP && events[0].asset == 0 && events[0].bytes == 64 * K;
+    ok = ok && residency.getResidentBytes() == 190 * K && residency.getStats().totalDetailDrops == 1;
+
+    // Use C then B (LRU: A, D, C, B). 100K budget: A drops its 16K level, is evicted for its last
+    // 4K, D is pinned and C was just used, so the pass stops over budget
+    events.clear();
+    touchAsset(residency, c);
+    touchAsset(residency, b);
+    residency.setBudget(100 * K);
+    ok = ok && residency.enforceBudget() == 20 * K && events.size() == 2;
+    ok = ok && events[0].kind == Event::DROP && events[0].bytes == 16 * K && events[1].kind == Event::EVICT && events[1].bytes == 4 * K;
+    ok = ok && !residency.isResident(a.handle) && residency.getResidentBytes() == 170 * K;
+
+    // Three frames later C degrades and goes, then B, and the pass stops at exactly 100K
+    events.clear();
+    residency.beginFrame();
+    residency.beginFrame();
+    ok = ok && events.empty();
+    residency.beginFrame();
+    ok = ok && events.size() == 3;
+    ok = ok && events[0].kind == Event::DROP && events[0].asset == 2 && events[0].bytes == 16 * K;
+    ok = ok && events[1].kind == Event::EVICT && events[1].asset == 2 && events[1].bytes == 4 * K;
+    ok = ok && events[2].kind == Event::EVICT && events[2].asset == 1 && events[2].bytes == 50 * K;
+    ok = ok && residency.getResidentBytes() == 100 * K && residency.isResident(d.handle);
+    ok = ok && residency.getStats().totalEvictions == 3 && residency.getStats().totalDetailDrops == 3 && residency.getStats().evictedCount == 3;
+
+    // Touching A restores its full chain
+    events.clear();
+    ok = ok && touchAsset(residency, a) && !touchAsset(residency, a);
+    ok = ok && events.size() == 1 && events[0].kind == Event::RESTORE && events[0].bytes == 84 * K;
+    ok = ok && residency.getResidentBytes() == 184 * K && residency.getStats().totalRestores == 1;
+
+    // Three frames on without a budget A is idle too. Unpinned, D is the oldest and goes first, and
+    // the pass stops there: exactly at the budget is within it
+    residency.setBudget(0);
+    residency.beginFrame();
+    residency.beginFrame();
+    residency.beginFrame();
+    residency.setPinned(d.handle, false);
+    residency.setBudget(84 * K);
+    events.clear();
+    ok = ok && residency.enforceBudget() == 100 * K && events.size() == 1 && events[0].asset == 3;
+    ok = ok && residency.getResidentBytes() == 84 * K && residency.isResident(a.handle);
+    ok = ok && residency.enforceBudget() == 0 && residency.getStats().totalDetailDrops == 3;
+
+    // Untracking evicted and resident assets; a stale handle is ignored
+    residency.untrack(b.handle);
+    residency.untrack(a.handle);
+    residency.untrack(a.handle);
+    ok = ok && residency.getStats().trackedCount == 2 && residency.getStats().evictedCount == 2 && residency.getResidentBytes() == 0;
+    ok = ok && !residency.touch(a.handle) && !residency.isResident(a.handle);
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    uint32_t assetCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 2000;
+    uint32_t frames = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 3000;
+    size_t budgetMb = argc > 3 ? static_cast<size_t>(std::atoi(argv[3])) : 512;
+    assetCount = std::max(assetCount, 64u);
+    frames = std::max(frames, 1u);
+    size_t budget = budgetMb * 1024 * 1024;
+
+    StreamResult result = runWorkload(assetCount, frames, budget);
+    bool idleOk = MockAsset::s_tooRecent == 0;
+    bool degradeOk = MockAsset::s_evictedBeforeDegrading == 0;
+    bool knownOk = checkKnownSequence() && MockAsset::s_tooRecent == 0 && MockAsset::s_evictedBeforeDegrading == 0;
+
+    std::cout << std::fixed << assetCount << " assets (" << std::setprecision(0) << result.totalBytes / (1024.0 * 1024.0)
+              << " MB), " << frames << " frames, budget " << budgetMb << " MB" << std::endl;
+    std::cout << "peak resident:        " << std::setprecision(1) << result.peakBytes / (1024.0 * 1024.0) << " MB" << std::endl
+              << "shedding passes:      " << result.passes << std::endl
+              << "detail drops:         " << result.drops << std::endl
+              << "evictions:            " << result.evictions << std::endl
+              << "restores:             " << result.restores << std::endl
+              << "frames over budget:   " << result.framesOverBudget << " (all in use)" << std::endl
+              << "ns per touch:         " << std::setprecision(1) << result.touchMs * 1e6 / std::max<uint64_t>(result.touches, 1) << std::endl
+              << "us per beginFrame:    " << std::setprecision(2) << result.beginFrameMs * 1e3 / frames << std::endl;
+    std::cout << "accounting:           " << (result.accountingOk ? "yes" : "NO") << std::endl
+              << "LRU order:            " << (result.lruOk ? "yes" : "NO") << std::endl
+              << "degrade before evict: " << (degradeOk ? "yes" : "NO") << std::endl
+              << "idle frames kept:     " << (idleOk ? "yes" : "NO") << std::endl
+              << "freed bytes match:    " << (result.freedOk ? "yes" : "NO") << std::endl
+              << "budget enforced:      " << (result.budgetOk ? "yes" : "NO") << std::endl
+              << "pinned kept:          " << (result.pinnedOk ? "yes" : "NO") << std::endl
+              << "restores on touch:    " << (result.restoreOk ? "yes" : "NO") << std::endl
+              << "known sequence:       " << (knownOk ? "yes" : "NO") << std::endl;
+    bool ok = result.accountingOk && result.lruOk && degradeOk && idleOk && result.freedOk && result.budgetOk &&
+              result.pinnedOk && result.restoreOk && knownOk;
+    return ok ? 0 : 1;
+}
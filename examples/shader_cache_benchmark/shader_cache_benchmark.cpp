@@ -0,0 +1,169 @@
+// EDEN ENGINE - Shader Cache Benchmark
+// Cold-start and hot-reload timings for stdlib/shader_compiler.h
+// Usage: shader_cache_benchmark [shaders] [threads] [work_dir]
+//   Writes `shaders` (default 50) vertex/fragment sources sharing one #include into work_dir
+//   (default shader_cache_bench, deleted afterwards), then compiles them cold on one thread and
+//   on `threads` (default hardware concurrency), warm from disk and from memory, and recompiles
+//   after a comment-only edit, a real edit and an edit of the shared include.
+//   Links shaderc_shared from the Vulkan SDK; built with -DEDEN_SHADER_COMPILER_GLSLC it needs glslc
+//   on PATH or in $VULKAN_SDK/bin instead.
+
+#include "../../stdlib/shader_compiler.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <filesystem>
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void writeText(const std::string& path, const std::string& text) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << text;
+}
+
+static std::string sharedInclude(float ambient) {
+    return "// Lighting shared by every benchmark shader\n"
+           "const float AMBIENT = " + std::to_string(ambient) + ";\n"
+           "vec3 shade(vec3 albedo, vec3 normal, vec3 lightDir) {\n"
+           "    float diffuse = max(dot(normalize(normal), normalize(lightDir)), 0.0);\n"
+           "    return albedo * (AMBIENT + diffuse);\n"
+           "}\n";
+}
+
+static std::string shaderSource(size_t index, bool vertex, const std::string& comment, float scale) {
+    // The debug include does not exist: it sits in a branch that is never compiled
+    std::string text = "#version 450\n"
+                       "#include \"common.glsl\"\n"
+                       "#ifdef EDEN_BENCHMARK_DEBUG\n"
+                       "#include \"debug_view.glsl\"\n"
+                       "#endif\n" + comment;
+    if (vertex) {
+        text += "layout(location = 0) in vec3 inPosition;\n"
+                "layout(location = 1) in vec3 inNormal;\n"
+                "layout(location = 0) out vec3 fragColor;\n"
+                "void main() {\n"
+                "    vec3 color = shade(vec3(" + std::to_string(index) + ".0 / " + std::to_string(index + 1) + ".0), inNormal, vec3(1.0, 2.0, 3.0));\n"
+                "    fragColor = color;\n"
+                "    gl_Position = vec4(inPosition * " + std::to_string(scale) + ", 1.0);\n"
+                "}\n";
+    } else {
+        text += "layout(location = 0) in vec3 fragColor;\n"
+                "layout(location = 0) out vec4 outColor;\n"
+                "void main() {\n"
+                "    vec3 color = shade(fragColor, vec3(0.0, 1.0, 0.0), vec3(" + std::to_string(index) + ".0, 1.0, 0.0));\n"
+                "    outColor = vec4(color * " + std::to_string(scale) + ", 1.0);\n"
+                "}\n";
+    }
+    return text;
+}
+
+struct Row {
+    double ms = 0.0;
+    uint32_t ok = 0;
+    uint32_t fromCache = 0;
+};
+
+static Row compileSet(const std::vector<std::string>& paths, uint32_t threads) {
+    Row row;
+    auto start = std::chrono::steady_clock::now();
+    std::vector<ShaderCompileResult> results = ShaderCompiler::get_instance().compileAll(paths, ShaderCompileOptions(), threads);
+    row.ms = elapsedMs(start);
+    for (const ShaderCompileResult& result : results) {
+        row.ok += result.ok ? 1 : 0;
+        row.fromCache += result.fromCache ? 1 : 0;
+        if (!result.ok) {
+            std::cerr << result.log << std::endl;
+        }
+    }
+    return row;
+}
+
+static void printRow(const char* name, const Row& row, uint32_t count, uint32_t compiled, const char* check, bool ok) {
+    std::cout << std::left << std::setw(18) << name << std::right
+              << std::setw(9) << count
+              << std::setw(10) << compiled
+              << std::setw(8) << row.fromCache
+              << std::setprecision(2) << std::setw(11) << row.ms
+              << "   " << check << (ok ? " yes" : " NO") << std::endl;
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 50;
+    uint32_t threads = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 0;
+    std::string workDir = argc > 3 ? argv[3] : "shader_cache_bench";
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    count = std::max<size_t>(count, 1);
+
+    std::filesystem::remove_all(workDir);
+    std::filesystem::create_directories(workDir + "/shaders");
+    std::string includePath = workDir + "/shaders/common.glsl";
+    writeText(includePath, sharedInclude(0.1f));
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < count; i++) {
+        bool vertex = i % 2 == 0;
+        std::string path = workDir + "/shaders/shader_" + std::to_string(i) + (vertex ? ".vert" : ".frag");
+        writeText(path, shaderSource(i, vertex, "", 1.0f));
+        paths.push_back(path);
+    }
+
+    ShaderCompiler& shaders = ShaderCompiler::get_instance();
+    std::cout << std::fixed << count << " shaders, " << threads << " thread(s)" << std::endl;
+    std::cout << "pass                shaders  compiled  cached    time ms   check" << std::endl;
+    bool allOk = true;
+    auto run = [&](const char* name, const std::vector<std::string>& set, uint32_t runThreads, uint32_t expectedCompiles) {
+        uint32_t before = shaders.getStats().compiled;
+        Row row = compileSet(set, runThreads);
+        uint32_t compiled = shaders.getStats().compiled - before;
+        uint32_t expectedCached = static_cast<uint32_t>(set.size()) - expectedCompiles;
+        bool ok = row.ok == set.size() && compiled == expectedCompiles && row.fromCache == expectedCached;
+        char check[64];
+        std::snprintf(check, sizeof(check), "%u compiled, %u cached", expectedCompiles, expectedCached);
+        printRow(name, row, static_cast<uint32_t>(set.size()), compiled, check, ok);
+        allOk = allOk && ok;
+        return row;
+    };
+    uint32_t all = static_cast<uint32_t>(count);
+
+    // Cold start: empty caches, once serial and once in parallel (separate disk caches)
+    shaders.setCacheDirectory(workDir + "/cache_serial");
+    Row serial = run("cold, 1 thread", paths, 1, all);
+    if (serial.ok == 0) {
+        std::cerr << "No shader compiled; see the compiler log above" << std::endl;
+        std::filesystem::remove_all(workDir);
+        return 1;
+    }
+    shaders.clearMemoryCache();
+    shaders.setCacheDirectory(workDir + "/cache");
+    Row parallel = run("cold, parallel", paths, threads, all);
+
+    // Warm start: a new process finds everything on disk; a second pass is served from memory
+    shaders.clearMemoryCache();
+    run("warm, disk", paths, threads, 0);
+    run("warm, memory", paths, threads, 0);
+
+    // Hot reload of one shader: a comment-only edit is a cache hit, a real edit compiles
+    std::vector<std::string> first(1, paths[0]);
+    writeText(paths[0], shaderSource(0, true, "// Tweaked the comment only\n\n", 1.0f));
+    run("edit, comment", first, 1, 0);
+    writeText(paths[0], shaderSource(0, true, "", 2.0f));
+    run("edit, code", first, 1, 1);
+
+    // Edit of the shared include: every shader that includes it recompiles (the #ifdef'd one is not tracked)
+    std::vector<std::string> includes = shaders.getIncludes(paths[0]);
+    bool tracked = includes.size() == 1 && includes[0].find("common.glsl") != std::string::npos;
+    std::cout << "include tracking: " << paths[0] << " -> " << (includes.empty() ? "(none)" : includes[0])
+              << (tracked ? " yes" : " NO") << std::endl;
+    allOk = allOk && tracked;
+    writeText(includePath, sharedInclude(0.2f));
+    run("edit, include", paths, threads, all);
+
+    std::cout << std::setprecision(1) << "parallel cold start speedup: " << serial.ms / std::max(parallel.ms, 1e-3) << "x" << std::endl;
+    std::filesystem::remove_all(workDir);
+    return allOk ? 0 : 1;
+}
@@ -0,0 +1,450 @@
+// EDEN ENGINE - Spatial Audio Benchmark
+// Headless check of stdlib/spatial_audio.h on an offline AudioMixer (no audio device)
+// Usage: spatial_audio_benchmark [emitters] [frames] [budget]
+//   `emitters` (default 500) AudioEmitter components, drifting around a 200 m square with some
+//   fast movers, are updated for `frames` (default 600) frames at 60 Hz around a listener walking
+//   a circle, with `budget` (default 32) voices. Entities are destroyed and created as it runs.
+//   After every update the voiced emitters must be the top `budget` by priority then gain, and
+//   no voice may outlive its emitter. Known attenuation, pan and doppler answers and a hand-traced
+//   voice-stealing sequence follow.
+
+#include "../../stdlib/spatial_audio.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <vector>
+
+static const int OUTPUT_RATE = 48000;
+static const float DT = 1.0f / 60.0f;
+
+static uint32_t randomInt(uint32_t& seed, uint32_t lo, uint32_t hi) {
+    seed = seed * 1664525u + 1013904223u;
+    return lo + (seed >> 8) % (hi - lo + 1);
+}
+
+static float randomFloat(uint32_t& seed, float lo, float hi) {
+    seed = seed * 1664525u + 1013904223u;
+    return lo + (hi - lo) * static_cast<float>(seed >> 8) / 16777216.0f;
+}
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static std::shared_ptr<AudioClip> makeConstant(int rate, size_t frames, int16_t value) {
+    auto clip = std::make_shared<AudioClip>();
+    clip->channels = 1;
+    clip->sampleRate = rate;
+    clip->samples.assign(frames, value);
+    return clip;
+}
+
+static std::shared_ptr<AudioClip> makeNoise(int channels, int rate, size_t frames, uint32_t seed) {
+    auto clip = std::make_shared<AudioClip>();
+    clip->channels = channels;
+    clip->sampleRate = rate;
+    for (size_t i = 0; i < frames * channels; i++) {
+        clip->samples.push_back(static_cast<int16_t>(randomInt(seed, 0, 16383)) - 8192);
+    }
+    return clip;
+}
+
+static std::vector<float> render(AudioMixer& mixer, size_t frames) {
+    std::vector<float> out(frames * 2);
+    mixer.render(out.data(), frames);
+    return out;
+}
+
+// Gain and pan of a constant mono 0.5 clip, read back from the settled bus through the
+// mixer's constant-power pan law (left = g cos a, right = g sin a, a = (pan + 1) pi / 4)
+static bool measureBus(const std::vector<float>& out, float& gain, float& pan) {
+    size_t frames = out.size() / 2;
+    float left = out[(frames - 1) * 2];
+    float right = out[(frames - 1) * 2 + 1];
+    for (size_t k = 16; k < frames; k++) {
+        if (std::fabs(out[k * 2] - left) > 1e-5f || std::fabs(out[k * 2 + 1] - right) > 1e-5f) {
+            return false;
+        }
+    }
+    gain = std::sqrt(left * left + right * right) / 0.5f;
+    pan = gain > 0.0f ? std::atan2(right, left) / 0.785398163f - 1.0f : 0.0f;
+    return true;
+}
+
+// One emitter with a constant clip, updated once and rendered: its gain and pan on the bus
+static bool renderEmitter(AudioEmitter emitter, const float listener[3], const float forward[3],
+                          float& gain, float& pan) {
+    static const float up[3] = {0.0f, 1.0f, 0.0f};
+    AudioMixer mixer(OUTPUT_RATE, 4);
+    SpatialAudio spatial(mixer, 4);
+    spatial.setListener(listener, forward, up);
+    emitter.clip = makeConstant(OUTPUT_RATE, 4096, 16384);
+    spatial.update(&emitter, 1, DT);
+    if (emitter.voice == AudioMixer::INVALID_VOICE) {
+        gain = 0.0f;
+        pan = 0.0f;
+        return spatial.getStats().voiced == 0;
+    }
+    return measureBus(render(mixer, 1024), gain, pan);
+}
+
+// Attenuation and pan with known answers, measured on the mixed output
+static bool checkCurves() {
+    bool ok = true;
+    const float origin[3] = {0.0f, 0.0f, 0.0f};
+    const float ahead[3] = {0.0f, 0.0f, -1.0f};
+    float gain = 0.0f, pan = 0.0f;
+
+    // minDistance 2, maxDistance 40, volume 0.8: 0.8 * 2 / (2 + rolloff * (d - 2)), faded over 36-40 m
+    struct Case {
+        float distance;
+        float rolloff;
+        float gain;
+    };
+    const Case cases[] = {{1.0f, 1.0f, 0.8f},  {2.0f, 1.0f, 0.8f},        {4.0f, 1.0f, 0.4f},
+                          {10.0f, 1.0f, 0.16f}, {20.0f, 1.0f, 0.08f},      {36.0f, 1.0f, 0.0444444f},
+                          {37.0f, 1.0f, 0.0324324f}, {39.5f, 1.0f, 0.0050633f}, {4.0f, 2.0f, 0.2666667f},
+                          {10.0f, 0.5f, 0.2666667f}, {40.0f, 1.0f, 0.0f},   {45.0f, 1.0f, 0.0f}};
+    for (const Case& test : cases) {
+        AudioEmitter emitter;
+        emitter.z = -test.distance;
+        emitter.minDistance = 2.0f;
+        emitter.maxDistance = 40.0f;
+        emitter.rolloff = test.rolloff;
+        emitter.volume = 0.8f;
+        ok = ok && renderEmitter(emitter, origin, ahead, gain, pan);
+        ok = ok && std::fabs(gain - test.gain) < 1e-5f && std::fabs(pan) < 1e-4f;
+    }
+
+    // Pan follows the listener's right axis (forward x up), whatever the distance or height
+    struct PanCase {
+        float listener[3];
+        float forward[3];
+        float emitter[3];
+        float pan;
+    };
+    const float diagonal = 4.0f / std::sqrt(2.0f);
+    const PanCase pans[] = {
+        {{0, 0, 0}, {0, 0, -1}, {4, 0, 0}, 1.0f},                  // Right
+        {{0, 0, 0}, {0, 0, -1}, {-4, 0, 0}, -1.0f},                // Left
+        {{0, 0, 0}, {0, 0, -1}, {diagonal, 0, -diagonal}, 0.7071068f},
+        {{0, 0, 0}, {0, 0, -1}, {-diagonal, 0, diagonal}, -0.7071068f},
+        {{0, 0, 0}, {0, 0, -1}, {0, 0, 4}, 0.0f},                  // Behind
+        {{0, 0, 0}, {0, 0, -1}, {0, 4, 0}, 0.0f},                  // Above
+        {{0, 0, 0}, {1, 0, 0}, {0, 0, 4}, 1.0f},                   // Facing +X, +Z is on the right
+        {{10, 2, -5}, {0, 0, -1}, {10, 2, -9}, 0.0f},              // Listener away from the origin
+        {{10, 2, -5}, {0, 0, -1}, {14, 2, -5}, 1.0f},
+    };
+    for (const PanCase& test : pans) {
+        AudioEmitter emitter;
+        emitter.x = test.emitter[0];
+        emitter.y = test.emitter[1];
+        emitter.z = test.emitter[2];
+        emitter.minDistance = 2.0f;
+        ok = ok && renderEmitter(emitter, test.listener, test.forward, gain, pan);
+        ok = ok && std::fabs(gain - 0.5f) < 1e-5f && std::fabs(pan - test.pan) < 1e-4f;
+    }
+    return ok;
+}
+
+// Doppler, read from how far a virtual (out of range) emitter's cursor moves in one update:
+// sampleRate * pitch * (c + v_listener) / (c + v_emitter) * dt, with c = 343 m/s
+static bool checkDoppler() {
+    bool ok = true;
+    struct Case {
+        float emitterSpeed;         // Along -Z, away from a listener at the origin
+        float listenerSpeed;        // Along -Z, towards the emitter
+        float pitch;
+        float scale;                // Expected cursor speed / sample rate
+    };
+    const Case cases[] = {{0.0f, 0.0f, 1.0f, 1.0f},       {34.3f, 0.0f, 1.0f, 343.0f / 377.3f},
+                          {-34.3f, 0.0f, 1.0f, 343.0f / 308.7f}, {0.0f, 34.3f, 1.0f, 377.3f / 343.0f},
+                          {34.3f, 34.3f, 1.0f, 1.0f},     {-34.3f, 0.0f, 1.5f, 1.5f * 343.0f / 308.7f},
+                          {-600.0f, 0.0f, 1.0f, 2.0f},    // Faster than sound: capped at half of it
+                          {600.0f, 0.0f, 1.0f, 2.0f / 3.0f}, {0.0f, -600.0f, 1.0f, 0.5f}};
+    const float forward[3] = {0.0f, 0.0f, -1.0f};
+    const float up[3] = {0.0f, 1.0f, 0.0f};
+    for (const Case& test : cases) {
+        AudioMixer mixer(OUTPUT_RATE, 4);
+        SpatialAudio spatial(mixer, 4);
+        AudioEmitter emitter;
+        emitter.clip = makeConstant(OUTPUT_RATE, OUTPUT_RATE * 100, 16384);
+        emitter.z = -200.0f;
+        emitter.maxDistance = 50.0f;
+        emitter.pitch = test.pitch;
+        float listener[3] = {0.0f, 0.0f, 0.0f};
+        spatial.setListener(listener, forward, up);
+        spatial.update(&emitter, 1, 0.1f);          // First update: no velocity yet
+        double before = emitter.cursor;
+        emitter.z -= test.emitterSpeed * 0.1f;
+        listener[2] -= test.listenerSpeed * 0.1f;
+        spatial.setListener(listener, forward, up);
+        spatial.update(&emitter, 1, 0.1f);
+        double expected = OUTPUT_RATE * 0.1 * test.scale;
+        ok = ok && emitter.voice == AudioMixer::INVALID_VOICE && emitter.playing;
+        ok = ok && std::fabs(before - OUTPUT_RATE * 0.1 * test.pitch) < 1.0 &&
+             std::fabs((emitter.cursor - before) - expected) < expected * 1e-4;
+    }
+    return ok;
+}
+
+// Hand-traced budget of 2: the loudest win, priority beats gain, stolen voices resume where they
+// were, gone and finished emitters release their voices
+static bool checkStealing() {
+    bool ok = true;
+    AudioMixer mixer(OUTPUT_RATE, 8);
+    SpatialAudio spatial(mixer, 2);
+    const float origin[3] = {0.0f, 0.0f, 0.0f};
+    const float forward[3] = {0.0f, 0.0f, -1.0f};
+    const float up[3] = {0.0f, 1.0f, 0.0f};
+    spatial.setListener(origin, forward, up);
+
+    // Gains 0.8, 0.5, 0.25, 0.125 (minDistance 2, rolloff 1)
+    AudioEmitter emitters[4];
+    const float distances[4] = {2.5f, 4.0f, 8.0f, 16.0f};
+    for (int i = 0; i < 4; i++) {
+        emitters[i].clip = makeConstant(OUTPUT_RATE, OUTPUT_RATE, static_cast<int16_t>(1000 * (i + 1)));
+        emitters[i].z = -distances[i];
+        emitters[i].minDistance = 2.0f;
+    }
+    AudioEmitter& a = emitters[0];
+    AudioEmitter& b = emitters[1];
+    AudioEmitter& c = emitters[2];
+    AudioEmitter& d = emitters[3];
+    auto voiced = [&](bool va, bool vb, bool vc, bool vd) {
+        const bool expected[4] = {va, vb, vc, vd};
+        bool match = true;
+        for (int i = 0; i < 4; i++) {
+            bool has = emitters[i].voice != AudioMixer::INVALID_VOICE;
+            match = match && has == expected[i] && (!has || mixer.isPlaying(emitters[i].voice));
+        }
+        return match;
+    };
+
+    spatial.update(emitters, 4, DT);
+    ok = ok && voiced(true, true, false, false) && spatial.getStats().audible == 4 && spatial.getStats().voiced == 2;
+    render(mixer, 4800);
+    ok = ok && mixer.getActiveVoiceCount() == 2;
+
+    // D moves to 1 m and steals B's voice; B keeps its place in the clip (4800 frames played, less
+    // the filter's history) and, now virtual, advances by this update's time
+    d.z = -1.0f;
+    spatial.update(emitters, 4, DT);
+    ok = ok && voiced(true, false, false, true) &&
+         std::fabs(b.cursor - (4800.0 + OUTPUT_RATE * DT)) <= AudioMixer::FILTER_TAPS;
+    render(mixer, 1024);
+    ok = ok && mixer.getActiveVoiceCount() == 2;
+
+    // While virtual, B's cursor advances in real time
+    double virtualStart = b.cursor;
+    spatial.update(emitters, 4, 0.1f);
+    ok = ok && std::fabs(b.cursor - virtualStart - OUTPUT_RATE * 0.1) < 1.0;
+
+    // Priority beats loudness: C (0.25) takes a voice from A (0.8)
+    c.priority = 1;
+    spatial.update(emitters, 4, DT);
+    ok = ok && voiced(false, false, true, true);
+    render(mixer, 1024);
+    ok = ok && mixer.getActiveVoiceCount() == 2;
+
+    // B wins again and resumes from its cursor (less the filter's history)
+    c.priority = 0;
+    d.z = -16.0f;
+    b.z = -1.0f;
+    double resumeAt = b.cursor;
+    spatial.update(emitters, 4, DT);
+    ok = ok && voiced(true, true, false, false);
+    double position = static_cast<double>(mixer.getSourcePosition(b.voice));
+    ok = ok && position <= resumeAt && position > resumeAt - AudioMixer::FILTER_TAPS;
+
+    // B is destroyed (no longer passed in): its voice fades and is released
+    AudioMixer::VoiceHandle orphan = b.voice;
+    AudioEmitter remaining[3] = {a, c, d};
+    spatial.update(remaining, 3, DT);
+    ok = ok && spatial.getStats().voiced == 2 && remaining[0].voice == a.voice && remaining[1].voice != AudioMixer::INVALID_VOICE;
+    render(mixer, AudioMixer::BLOCK_FRAMES);
+    ok = ok && !mixer.isPlaying(orphan) && mixer.getActiveVoiceCount() == 2;
+
+    // A voiced one-shot that plays out stops; a virtual one stops when its cursor passes the end
+    AudioMixer shots(OUTPUT_RATE, 4);
+    SpatialAudio shotAudio(shots, 1);
+    shotAudio.setListener(origin, forward, up);
+    AudioEmitter oneShots[2];
+    for (AudioEmitter& shot : oneShots) {
+        shot.clip = makeConstant(OUTPUT_RATE, 480, 8192);
+        shot.loop = false;
+        shot.minDistance = 2.0f;
+    }
+    oneShots[0].z = -2.0f;
+    oneShots[1].z = -4.0f;
+    shotAudio.update(oneShots, 2, 0.011f);     // 528 frames: past the virtual one's end
+    ok = ok && oneShots[0].voice != AudioMixer::INVALID_VOICE && oneShots[0].playing;
+    ok = ok && oneShots[1].voice == AudioMixer::INVALID_VOICE && !oneShots[1].playing && oneShots[1].cursor == 0.0;
+    render(shots, 1024);
+    shotAudio.update(oneShots, 2, 0.005f);
+    ok = ok && !oneShots[0].playing && oneShots[0].voice == AudioMixer::INVALID_VOICE;
+    ok = ok && shots.getActiveVoiceCount() == 0 && shotAudio.getStats().voiced == 0;
+    return ok;
+}
+
+// The voice ranking every update must produce, from the emitter and listener positions
+static float referenceGain(const AudioEmitter& emitter, const float listener[3]) {
+    float dx = emitter.x - listener[0];
+    float dy = emitter.y - listener[1];
+    float dz = emitter.z - listener[2];
+    float distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+    if (distance >= emitter.maxDistance) {
+        return 0.0f;
+    }
+    float minDistance = std::max(emitter.minDistance, 1e-3f);
+    float gain = minDistance / (minDistance + emitter.rolloff * (std::max(distance, minDistance) - minDistance));
+    float fadeStart = emitter.maxDistance * 0.9f;
+    if (distance > fadeStart) {
+        gain *= (emitter.maxDistance - distance) / (emitter.maxDistance - fadeStart);
+    }
+    return gain * emitter.volume;
+}
+
+struct Motion {
+    float vx, vy, vz;
+};
+
+static AudioEmitter makeEmitter(uint32_t& seed, uint32_t index, const std::vector<std::shared_ptr<AudioClip>>& clips) {
+    AudioEmitter emitter;
+    emitter.clip = clips[index % clips.size()];
+    emitter.x = randomFloat(seed, -100, 100);
+    emitter.y = randomFloat(seed, 0, 5);
+    emitter.z = randomFloat(seed, -100, 100);
+    emitter.minDistance = randomFloat(seed, 1, 3);
+    emitter.maxDistance = randomFloat(seed, 20, 60);
+    emitter.rolloff = randomFloat(seed, 0.5f, 2.0f);
+    emitter.volume = randomFloat(seed, 0.3f, 1.0f);
+    emitter.pitch = randomFloat(seed, 0.8f, 1.2f);
+    emitter.priority = index % 50 == 0 ? 1 : 0;
+    emitter.loop = index % 5 != 0;
+    return emitter;
+}
+
+int main(int argc, char** argv) {
+    uint32_t emitterCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 500;
+    int frames = argc > 2 ? std::atoi(argv[2]) : 600;
+    uint32_t budget = argc > 3 ? static_cast<uint32_t>(std::atoi(argv[3])) : 32;
+    emitterCount = std::max(emitterCount, 1u);
+    frames = std::max(frames, 1);
+    budget = std::max(budget, 1u);
+
+    // Room for every voice plus as many fading out after losing theirs
+    AudioMixer mixer(OUTPUT_RATE, budget * 2);
+    SpatialAudio spatial(mixer, budget);
+    std::vector<std::shared_ptr<AudioClip>> clips = {
+        makeNoise(1, 22050, 22050, 1), makeNoise(1, 44100, 22050, 2),
+        makeNoise(2, 48000, 14400, 3), makeNoise(1, 32000, 64000, 4)};
+
+    EntityStorage storage;
+    std::vector<EntityId> entities;
+    std::vector<Motion> motion(1);      // Indexed by entity id
+    uint32_t seed = 2024u;
+    uint32_t created = 0;
+    auto spawn = [&]() {
+        EntityId entity = storage.create_entity();
+        storage.add_component<AudioEmitter>(entity, makeEmitter(seed, created++, clips));
+        if (entity >= motion.size()) {
+            motion.resize(entity + 1);
+        }
+        float speed = created % 10 == 0 ? 60.0f : 5.0f;
+        motion[entity] = Motion{randomFloat(seed, -speed, speed), 0.0f, randomFloat(seed, -speed, speed)};
+        entities.push_back(entity);
+    };
+    for (uint32_t i = 0; i < emitterCount; i++) {
+        spawn();
+    }
+
+    const float up[3] = {0.0f, 1.0f, 0.0f};
+    std::vector<float> out(static_cast<size_t>(OUTPUT_RATE * DT) * 2);
+    double updateMs = 0.0;
+    uint64_t audibleSum = 0, voicedSum = 0;
+    bool rankingOk = true, releaseOk = true;
+    for (int frame = 0; frame < frames; frame++) {
+        // Walk a 40 m circle at 5 m/s, facing along it
+        float angle = frame * DT * 5.0f / 40.0f;
+        float listener[3] = {40.0f * std::cos(angle), 1.7f, 40.0f * std::sin(angle)};
+        float forward[3] = {-std::sin(angle), 0.0f, std::cos(angle)};
+        spatial.setListener(listener, forward, up);
+
+        // Emitters drift; finished one-shots fire again now and then; some entities come and go
+        storage.for_each<AudioEmitter>([&](EntityId entity, AudioEmitter& emitter) {
+            emitter.x += motion[entity].vx * DT;
+            emitter.z += motion[entity].vz * DT;
+            if (!emitter.playing && randomInt(seed, 0, 29) == 0) {
+                emitter.playing = true;
+            }
+        });
+        if (frame % 10 == 5) {
+            size_t victim = randomInt(seed, 0, static_cast<uint32_t>(entities.size() - 1));
+            storage.destroy_entity(entities[victim]);
+            entities.erase(entities.begin() + victim);
+            spawn();
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        spatial.update(storage, DT);
+        updateMs += elapsedMs(start);
+
+        // The voiced emitters rank above every audible unvoiced one
+        int bestVirtualPriority = -1;
+        float bestVirtualGain = 0.0f;
+        int worstVoicedPriority = 1 << 30;
+        float worstVoicedGain = 1e30f;
+        uint32_t audible = 0, voiced = 0;
+        storage.for_each<AudioEmitter>([&](EntityId, AudioEmitter& emitter) {
+            if (!emitter.playing) {
+                rankingOk = rankingOk && emitter.voice == AudioMixer::INVALID_VOICE;
+                return;
+            }
+            float gain = referenceGain(emitter, listener);
+            bool isAudible = gain >= 0.001f;
+            bool isVoiced = emitter.voice != AudioMixer::INVALID_VOICE;
+            rankingOk = rankingOk && (isAudible || !isVoiced) && (!isVoiced || mixer.isPlaying(emitter.voice));
+            audible += isAudible;
+            voiced += isVoiced;
+            if (isVoiced && (emitter.priority < worstVoicedPriority ||
+                             (emitter.priority == worstVoicedPriority && gain < worstVoicedGain))) {
+                worstVoicedPriority = emitter.priority;
+                worstVoicedGain = gain;
+            } else if (isAudible && !isVoiced && (emitter.priority > bestVirtualPriority ||
+                                                  (emitter.priority == bestVirtualPriority && gain > bestVirtualGain))) {
+                bestVirtualPriority = emitter.priority;
+                bestVirtualGain = gain;
+            }
+        });
+        // (Stats also count virtual one-shots that played out during this update)
+        rankingOk = rankingOk && voiced == std::min(audible, budget) && spatial.getStats().voiced == voiced &&
+                    spatial.getStats().audible >= audible;
+        rankingOk = rankingOk && (bestVirtualPriority < 0 || worstVoicedPriority > bestVirtualPriority ||
+                                  (worstVoicedPriority == bestVirtualPriority && worstVoicedGain >= bestVirtualGain * (1.0f - 1e-5f)));
+        audibleSum += audible;
+        voicedSum += voiced;
+
+        // Voices lost this update, and those of destroyed entities, are gone after one block
+        mixer.render(out.data(), out.size() / 2);
+        releaseOk = releaseOk && mixer.getActiveVoiceCount() <= voiced;
+    }
+
+    bool curvesOk = checkCurves();
+    bool dopplerOk = checkDoppler();
+    bool stealingOk = checkStealing();
+    std::cout << std::fixed << emitterCount << " emitters, " << frames << " frames, " << budget << " voices" << std::endl;
+    std::cout << std::setprecision(3)
+              << "update ms / frame:    " << updateMs / frames << std::endl
+              << "ns per emitter:       " << std::setprecision(1) << updateMs * 1e6 / (static_cast<double>(frames) * emitterCount) << std::endl
+              << "audible / frame:      " << static_cast<double>(audibleSum) / frames << std::endl
+              << "voiced / frame:       " << static_cast<double>(voicedSum) / frames << std::endl;
+    std::cout << "voice ranking:        " << (rankingOk ? "yes" : "NO") << std::endl
+              << "voices released:      " << (releaseOk ? "yes" : "NO") << std::endl
+              << "attenuation and pan:  " << (curvesOk ? "yes" : "NO") << std::endl
+              << "doppler:              " << (dopplerOk ? "yes" : "NO") << std::endl
+              << "voice stealing:       " << (stealingOk ? "yes" : "NO") << std::endl;
+    return rankingOk && releaseOk && curvesOk && dopplerOk && stealingOk ? 0 : 1;
+}
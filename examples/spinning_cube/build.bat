@@ -70,7 +70,7 @@ g++ -std=c++17 -O3 spinning_cube.cpp "%PROJECT_ROOT%\vulkan\eden_vulkan_helpers.
     -I"%GLFW_PATH%\include" ^
     -L"%VULKAN_SDK_PATH%\Lib" ^
     -L"%GLFW_PATH%\build\src" ^
-    -lvulkan-1 -lglfw3 -lgdi32
+    -lvulkan-1 -lshaderc_shared -lglfw3 -lgdi32
 
 if errorlevel 1 (
     echo Failed to compile C++ code!
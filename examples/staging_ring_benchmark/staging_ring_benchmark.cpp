@@ -0,0 +1,254 @@
+// EDEN ENGINE - Staging Ring Benchmark
+// Headless allocate/retire check for stdlib/staging_ring.h with fake fence values
+// Usage: staging_ring_benchmark [ring_kb] [frames]
+//   Streams uploads through a ring of `ring_kb` (default 4096) for `frames` (default 2000) frames
+//   the way UploadQueue does: one submission per frame, a fake GPU that completes each submission
+//   1-3 frames later, and a stall (submit, then wait for the oldest submission) when the ring is
+//   full. Every region is checked against a shadow copy of what is still in flight.
+
+#include "../../stdlib/staging_ring.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <vector>
+#include <deque>
+#include <algorithm>
+
+static uint32_t randomInt(uint32_t& seed, uint32_t lo, uint32_t hi) {
+    seed = seed * 1664525u + 1013904223u;
+    return lo + (seed >> 8) % (hi - lo + 1);
+}
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct Region {
+    uint64_t offset;
+    uint64_t size;
+    uint64_t submission;    // 0 while the batch is still being recorded
+};
+
+// Fake GPU: submission ids complete in order, each `latency` frames after it was submitted
+struct FakeGpu {
+    std::deque<std::pair<uint64_t, uint64_t>> pending;     // (submission, frame it completes on)
+    uint64_t completed = 0;                                 // Fence value: last completed submission
+
+    void submit(uint64_t submission, uint64_t doneFrame) {
+        if (!pending.empty()) {
+            doneFrame = std::max(doneFrame, pending.back().second);
+        }
+        pending.push_back({submission, doneFrame});
+    }
+    void advance(uint64_t frame) {
+        while (!pending.empty() && pending.front().second <= frame) {
+            completed = pending.front().first;
+            pending.pop_front();
+        }
+    }
+    void waitFor(uint64_t submission) {
+        while (!pending.empty() && pending.front().first <= submission) {
+            completed = pending.front().first;
+            pending.pop_front();
+        }
+    }
+};
+
+struct StreamResult {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+    uint64_t wraps = 0;
+    uint64_t stalls = 0;
+    uint64_t submissions = 0;
+    uint64_t peakUsed = 0;
+    bool placementOk = true;    // Aligned, inside the ring, no overlap with anything in flight
+    bool retireOk = true;       // release() frees exactly the completed batches
+    bool neverStuck = true;     // A full ring always frees up by waiting on the oldest submission
+    double ms = 0.0;
+};
+
+// One run of the streaming workload; `check` keeps the shadow copy (off for the timed run)
+static StreamResult stream(uint64_t capacity, uint64_t frames, bool check) {
+    StagingRing ring(capacity);
+    FakeGpu gpu;
+    StreamResult result;
+    std::vector<Region> live;
+    uint64_t nextSubmission = 1;
+    uint64_t lastOffset = 0;
+    uint32_t seed = 4321u;
+    static const uint64_t ALIGNMENTS[] = {4, 16, 256, 512};
+
+    auto release = [&](uint64_t completed) {
+        ring.release(completed);
+        if (!check) {
+            return;
+        }
+        live.erase(std::remove_if(live.begin(), live.end(), [&](const Region& region) {
+            return region.submission != 0 && region.submission <= completed;
+        }), live.end());
+        uint64_t oldest = 0;
+        size_t batches = 0;
+        uint64_t previous = 0;
+        for (const Region& region : live) {
+            if (region.submission != 0 && region.submission != previous) {
+                oldest = oldest == 0 ? region.submission : std::min(oldest, region.submission);
+                batches++;
+                previous = region.submission;
+            }
+        }
+        result.retireOk = result.retireOk && ring.getOldestSubmission() == oldest && ring.getInFlightCount() == batches;
+    };
+    auto submit = [&](uint64_t frame) {
+        if (ring.getOpenBytes() == 0) {
+            return;
+        }
+        uint64_t submission = nextSubmission++;
+        ring.submit(submission);
+        gpu.submit(submission, frame + randomInt(seed, 1, 3));
+        result.submissions++;
+        for (Region& region : live) {
+            if (region.submission == 0) {
+                region.submission = submission;
+            }
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t frame = 0; frame < frames; frame++) {
+        // Start of frame: retire whatever the GPU has finished (UploadQueue::collect)
+        gpu.advance(frame);
+        release(gpu.completed);
+
+        uint32_t uploads = randomInt(seed, 0, 40);
+        for (uint32_t i = 0; i < uploads; i++) {
+            // Mostly small buffers and mip levels, now and then a big texture
+            uint64_t size = randomInt(seed, 0, 15) == 0 ? randomInt(seed, 256 * 1024, static_cast<uint32_t>(capacity / 2))
+                                                         : randomInt(seed, 64, 64 * 1024);
+            uint64_t alignment = ALIGNMENTS[randomInt(seed, 0, 3)];
+            uint64_t offset = ring.allocate(size, alignment);
+            while (offset == StagingRing::INVALID_OFFSET) {
+                // Ring full: submit what is recorded, wait for the oldest submission, retry
+                result.stalls++;
+                submit(frame);
+                uint64_t oldest = ring.getOldestSubmission();
+                if (oldest == 0) {
+                    result.neverStuck = false;
+                    break;
+                }
+                gpu.waitFor(oldest);
+                release(gpu.completed);
+                offset = ring.allocate(size, alignment);
+            }
+            if (offset == StagingRing::INVALID_OFFSET) {
+                continue;
+            }
+
+            result.allocations++;
+            result.bytes += size;
+            if (offset < lastOffset) {
+                result.wraps++;
+            }
+            lastOffset = offset;
+            result.peakUsed = std::max(result.peakUsed, ring.getUsedBytes());
+            if (check) {
+                bool placed = offset % alignment == 0 && offset + size <= capacity;
+                for (const Region& region : live) {
+                    placed = placed && (offset + size <= region.offset || region.offset + region.size <= offset);
+                }
+                result.placementOk = result.placementOk && placed;
+                live.push_back({offset, size, 0});
+            }
+        }
+
+        // End of frame: one submission carries every upload recorded this frame (UploadQueue::flush)
+        submit(frame);
+    }
+
+    // Drain: everything completes and the ring must be empty again
+    gpu.waitFor(nextSubmission);
+    release(gpu.completed);
+    result.ms = elapsedMs(start);
+    result.retireOk = result.retireOk && ring.getUsedBytes() == 0 && ring.getInFlightCount() == 0 && ring.getOpenBytes() == 0;
+    return result;
+}
+
+// Hand-traced sequences with known offsets, covering wrap-around, a full ring and retirement
+static bool checkKnownSequence() {
+    bool ok = true;
+
+    StagingRing ring(1024);
+    ok = ok && ring.allocate(400, 1) == 0;          // Batch 1: [0, 400)
+    ring.submit(1);
+    ok = ok && ring.allocate(400, 1) == 400;        // Batch 2: [400, 800)
+    ring.submit(2);
+    ok = ok && ring.getUsedBytes() == 800 && ring.getInFlightCount() == 2;
+
+    ring.release(1);                                // Fence 1 signalled: [0, 400) is free again
+    ok = ok && ring.getUsedBytes() == 400 && ring.getOldestSubmission() == 2;
+
+    // 300 bytes do not fit in [800, 1024): skip the tail (224 bytes, charged to this batch) and wrap
+    ok = ok && ring.allocate(300, 1) == 0;
+    ok = ok && ring.getUsedBytes() == 400 + 224 + 300;
+    ok = ok && ring.allocate(200, 1) == StagingRing::INVALID_OFFSET;   // [300, 400) is too small
+    ring.submit(3);
+    ring.release(2);                                // [400, 800) free: 200 bytes fit at 300
+    ok = ok && ring.allocate(200, 1) == 300;
+    ring.release(3);                                // The wrap waste goes back with batch 3
+    ok = ok && ring.getUsedBytes() == 200 && ring.getOpenBytes() == 200;
+    ring.submit(4);
+    ring.release(4);
+    ok = ok && ring.getUsedBytes() == 0 && ring.getInFlightCount() == 0;
+
+    // Alignment padding is charged: 1 byte at 0, then 256-aligned lands on 256
+    ok = ok && ring.allocate(1, 1) == 0 && ring.allocate(8, 256) == 256 && ring.getUsedBytes() == 264;
+    ring.submit(5);
+    ring.release(5);
+
+    // Exactly full: nothing else fits until the fence signals; then the ring starts over at 0
+    ok = ok && ring.allocate(1024, 4) == 0;
+    ring.submit(6);
+    ok = ok && ring.allocate(1, 1) == StagingRing::INVALID_OFFSET;
+    ring.release(5);                                // An older fence value frees nothing
+    ok = ok && ring.getUsedBytes() == 1024;
+    ring.release(6);
+    ok = ok && ring.allocate(16, 16) == 0;
+
+    // Empty and oversized requests are refused; submitting nothing adds no batch
+    ok = ok && ring.allocate(0, 4) == StagingRing::INVALID_OFFSET && ring.allocate(1025, 1) == StagingRing::INVALID_OFFSET;
+    ring.submit(7);
+    ring.submit(8);
+    ok = ok && ring.getInFlightCount() == 1;
+    ring.release(8);
+    ok = ok && ring.getUsedBytes() == 0;
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    uint64_t capacity = (argc > 1 ? static_cast<uint64_t>(std::atol(argv[1])) : 4096) * 1024;
+    uint64_t frames = argc > 2 ? static_cast<uint64_t>(std::atol(argv[2])) : 2000;
+    capacity = std::max<uint64_t>(capacity, 1024 * 1024);
+    frames = std::max<uint64_t>(frames, 1);
+
+    StreamResult checked = stream(capacity, frames, true);
+    StreamResult timed = stream(capacity, frames, false);
+    bool knownOk = checkKnownSequence();
+
+    std::cout << std::fixed << capacity / 1024 << " KB ring, " << frames << " frames" << std::endl;
+    std::cout << "allocations:          " << checked.allocations << " (" << std::setprecision(1)
+              << checked.bytes / (1024.0 * 1024.0) << " MB)" << std::endl
+              << "submissions:          " << checked.submissions << std::endl
+              << "wrap-arounds:         " << checked.wraps << std::endl
+              << "stalls (ring full):   " << checked.stalls << std::endl
+              << "peak use:             " << std::setprecision(1) << 100.0 * checked.peakUsed / capacity << "%" << std::endl
+              << std::setprecision(1)
+              << "ns per allocation:    " << timed.ms * 1e6 / std::max<uint64_t>(timed.allocations, 1) << std::endl;
+    bool wrapped = checked.wraps > 0;
+    std::cout << "placement:            " << (checked.placementOk ? "yes" : "NO") << std::endl
+              << "fence retirement:     " << (checked.retireOk ? "yes" : "NO") << std::endl
+              << "full ring recovers:   " << (checked.neverStuck ? "yes" : "NO") << std::endl
+              << "wrapped around:       " << (wrapped ? "yes" : "NO") << std::endl
+              << "known sequence:       " << (knownOk ? "yes" : "NO") << std::endl;
+    return checked.placementOk && checked.retireOk && checked.neverStuck && wrapped && knownOk ? 0 : 1;
+}
@@ -240,7 +240,7 @@ echo [DEBUG] LIBS=!LIBS!
 REM Link everything - call g++ directly to avoid batch parsing issues with paths
 set "VULKAN_LIB="
 if defined VULKAN_SDK_PATH (
-    set "VULKAN_LIB=-lvulkan-1"
+    set "VULKAN_LIB=-lvulkan-1 -lshaderc_shared"
 )
 
 REM Link - build the link command directly without endlocal
@@ -261,7 +261,7 @@ echo [DEBUG] Base command: !LINK_CMD!
 
 if defined VULKAN_SDK_PATH (
     echo [DEBUG] Adding Vulkan library...
-    set "LINK_CMD=!LINK_CMD! -lvulkan-1"
+    set "LINK_CMD=!LINK_CMD! -lvulkan-1 -lshaderc_shared"
 ) else (
     echo [DEBUG] No Vulkan SDK found
 )
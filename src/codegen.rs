@@ -90,6 +90,10 @@ impl CodeGenerator {
         if !self.hot_components.is_empty() {
             output.push_str("#include \"stdlib/entity_storage.h\"\n");
         }
+        // Include file watcher if anything is hot-reloaded from disk
+        if !self.hot_systems.is_empty() || !self.hot_shaders.is_empty() {
+            output.push_str("#include \"stdlib/file_watcher.h\"\n");
+        }
         output.push_str("\n");
         
         // Defer statement support (RAII helper)
@@ -154,6 +158,9 @@ impl CodeGenerator {
             output.push_str("#include \"stdlib/texture_resource.h\"\n");
             output.push_str("#include \"stdlib/mesh_resource.h\"\n");
             output.push_str("#include \"stdlib/audio_resource.h\"\n");
+            if self.has_resources {
+                output.push_str("#include \"stdlib/file_watcher.h\"\n");
+            }
             output.push_str("\n");
         }
         
@@ -173,6 +180,8 @@ impl CodeGenerator {
         // Generate pipeline declarations and creation functions
         if !self.pipelines.is_empty() {
             output.push_str("\n// Pipeline declarations and creation functions\n");
+            // Pipelines compile through the renderer's on-disk pipeline cache
+            output.push_str("extern \"C\" VkPipelineCache heidic_get_pipeline_cache();\n\n");
             for pipeline in &self.pipelines {
                 output.push_str(&self.generate_pipeline(pipeline));
             }
@@ -367,6 +376,8 @@ impl CodeGenerator {
             output.push_str("// Shader hot-reload function forward declarations\n");
             output.push_str("void check_and_reload_hot_shaders();\n");
             output.push_str("extern \"C\" void heidic_reload_shader(const char* shader_path);\n");
+            output.push_str("extern \"C\" int heidic_shader_includes_changed(const char* shader_path);\n");
+            output.push_str("extern \"C\" int heidic_precompile_shaders(const char** paths, int count);\n");
             output.push_str("\n");
         }
         
@@ -477,12 +488,9 @@ impl CodeGenerator {
             output.push_str("    }\n");
             output.push_str("}\n");
             output.push_str("\n");
-            output.push_str("// File watching and auto-reload\n");
-            output.push_str("#include <sys/stat.h>\n");
-            output.push_str("#include <io.h>\n");
+            output.push_str("// File watching and auto-reload (changes come from FileWatcher, polled once per frame)\n");
             output.push_str("#include <chrono>\n");
             output.push_str("\n");
-            output.push_str("static time_t g_last_dll_time = 0;\n");
             output.push_str("static std::chrono::steady_clock::time_point g_startup_time = std::chrono::steady_clock::now();\n");
             output.push_str("static const int STARTUP_GRACE_PERIOD_SECONDS = 3; // Ignore DLL changes for first 3 seconds after startup\n");
             output.push_str("\n");
@@ -495,19 +503,15 @@ impl CodeGenerator {
             output.push_str("    }\n");
             for system in &self.hot_systems {
                 let dll_name = format!("{}.dll", system.name.to_lowercase());
-                output.push_str(&format!("    // Check {} DLL file modification time\n", system.name));
-                output.push_str(&format!("    struct stat dll_stat;\n"));
-                output.push_str(&format!("    if (stat(\"{}\", &dll_stat) == 0) {{\n", dll_name));
-                output.push_str(&format!("        if (dll_stat.st_mtime > g_last_dll_time) {{\n"));
-                output.push_str(&format!("            g_last_dll_time = dll_stat.st_mtime;\n"));
-                output.push_str(&format!("            std::cout << \"[Hot-Reload] Detected change in {}, reloading...\" << std::endl;\n", dll_name));
-                output.push_str(&format!("            // Unload old DLL first\n"));
-                output.push_str(&format!("            unload_hot_system();\n"));
-                output.push_str(&format!("            // Small delay to ensure DLL is fully unloaded on Windows\n"));
-                output.push_str(&format!("            std::this_thread::sleep_for(std::chrono::milliseconds(100));\n"));
-                output.push_str(&format!("            load_hot_system(\"{}\");\n", dll_name));
-                output.push_str(&format!("            std::cout << \"[Hot-Reload] {} reloaded successfully!\" << std::endl;\n", system.name));
-                output.push_str(&format!("        }}\n"));
+                output.push_str(&format!("    // Check {} DLL for changes\n", system.name));
+                output.push_str(&format!("    if (FileWatcher::get_instance().wasChanged(\"{}\")) {{\n", dll_name));
+                output.push_str(&format!("        std::cout << \"[Hot-Reload] Detected change in {}, reloading...\" << std::endl;\n", dll_name));
+                output.push_str(&format!("        // Unload old DLL first\n"));
+                output.push_str(&format!("        unload_hot_system();\n"));
+                output.push_str(&format!("        // Small delay to ensure DLL is fully unloaded on Windows\n"));
+                output.push_str(&format!("        std::this_thread::sleep_for(std::chrono::milliseconds(100));\n"));
+                output.push_str(&format!("        load_hot_system(\"{}\");\n", dll_name));
+                output.push_str(&format!("        std::cout << \"[Hot-Reload] {} reloaded successfully!\" << std::endl;\n", system.name));
                 output.push_str(&format!("    }}\n"));
             }
             output.push_str("}\n");
@@ -516,64 +520,22 @@ impl CodeGenerator {
         
         // Generate shader hot-reload runtime integration
         if !self.hot_shaders.is_empty() {
-            output.push_str("\n// Shader Hot-Reload Runtime Integration\n");
-            output.push_str("#include <sys/stat.h>\n");
-            output.push_str("#include <io.h>\n");
-            output.push_str("#include <map>\n");
-            output.push_str("#include <string>\n");
-            output.push_str("\n");
-            output.push_str("// Store last modification times for hot shaders\n");
-            output.push_str("static std::map<std::string, time_t> g_shader_mtimes;\n");
-            output.push_str("\n");
+            output.push_str("\n// Shader Hot-Reload Runtime Integration (changes come from FileWatcher, polled once per frame)\n");
             output.push_str("void check_and_reload_hot_shaders() {\n");
-            for (idx, shader) in self.hot_shaders.iter().enumerate() {
-                // Get the shader file path (could be .glsl or .spv)
+            output.push_str("    FileWatcher& watcher = FileWatcher::get_instance();\n");
+            output.push_str("    if (watcher.getChanges().empty()) {\n");
+            output.push_str("        return; // Idle frame - nothing to compare\n");
+            output.push_str("    }\n");
+            for shader in &self.hot_shaders {
                 let shader_path = &shader.path;
-                // Determine the .spv path - keep extension to avoid conflicts (e.g., my_shader.vert.spv)
-                let spv_path = if shader_path.ends_with(".glsl") {
-                    shader_path.replace(".glsl", ".spv")
-                } else if shader_path.ends_with(".vert") || shader_path.ends_with(".frag") || shader_path.ends_with(".comp") {
-                    format!("{}.spv", shader_path)  // my_shader.vert.spv, my_shader.frag.spv
-                } else {
-                    format!("{}.spv", shader_path)
-                };
-                
-                // Use unique variable name for each shader
-                let stat_var_name = format!("shader_stat_{}", idx);
                 
-                output.push_str(&format!("    // Check {} shader file modification time\n", shader_path));
-                output.push_str(&format!("    struct stat {};\n", stat_var_name));
-                output.push_str(&format!("    if (stat(\"{}\", &{}) == 0) {{\n", spv_path, stat_var_name));
-                output.push_str(&format!("        auto it = g_shader_mtimes.find(\"{}\");\n", spv_path));
-                output.push_str(&format!("        time_t last_mtime = (it != g_shader_mtimes.end()) ? it->second : 0;\n"));
-                output.push_str(&format!("        if ({}.st_mtime > last_mtime) {{\n", stat_var_name));
-                output.push_str(&format!("            g_shader_mtimes[\"{}\"] = {}.st_mtime;\n", spv_path, stat_var_name));
-                output.push_str(&format!("            std::cout << \"[Shader Hot-Reload] Detected change in {}, reloading...\" << std::endl;\n", spv_path));
+                // The GLSL source is compiled in-process, so watch it (and its #includes) rather than the .spv
+                output.push_str(&format!("    // Check {} shader for changes\n", shader_path));
+                output.push_str(&format!("    if (watcher.wasChanged(\"{}\") || heidic_shader_includes_changed(\"{}\")) {{\n", shader_path, shader_path));
+                output.push_str(&format!("        std::cout << \"[Shader Hot-Reload] Detected change in {}, reloading...\" << std::endl;\n", shader_path));
                 // Pass the original source path so we can determine shader stage (vertex/fragment)
-                output.push_str(&format!("            heidic_reload_shader(\"{}\");\n", shader_path));
-                output.push_str(&format!("            std::cout << \"[Shader Hot-Reload] {} reloaded successfully!\" << std::endl;\n", spv_path));
-                output.push_str(&format!("        }}\n"));
-                output.push_str(&format!("    }}\n"));
-            }
-            output.push_str("}\n");
-            output.push_str("\n");
-            // Initialize shader modification times at startup
-            output.push_str("static void init_shader_mtimes() {\n");
-            for (idx, shader) in self.hot_shaders.iter().enumerate() {
-                let shader_path = &shader.path;
-                // Use same naming as check_and_reload_hot_shaders: keep extension for .vert/.frag/.comp
-                let spv_path = if shader_path.ends_with(".glsl") {
-                    shader_path.replace(".glsl", ".spv")
-                } else if shader_path.ends_with(".vert") || shader_path.ends_with(".frag") || shader_path.ends_with(".comp") {
-                    format!("{}.spv", shader_path)  // my_shader.vert.spv, my_shader.frag.spv
-                } else {
-                    format!("{}.spv", shader_path)
-                };
-                // Use unique variable name for each shader
-                let stat_var_name = format!("shader_stat_init_{}", idx);
-                output.push_str(&format!("    struct stat {};\n", stat_var_name));
-                output.push_str(&format!("    if (stat(\"{}\", &{}) == 0) {{\n", spv_path, stat_var_name));
-                output.push_str(&format!("        g_shader_mtimes[\"{}\"] = {}.st_mtime;\n", spv_path, stat_var_name));
+                output.push_str(&format!("        heidic_reload_shader(\"{}\");\n", shader_path));
+                output.push_str(&format!("        std::cout << \"[Shader Hot-Reload] {} reloaded successfully!\" << std::endl;\n", shader_path));
                 output.push_str(&format!("    }}\n"));
             }
             output.push_str("}\n");
@@ -584,11 +546,15 @@ impl CodeGenerator {
         if self.has_resources {
             output.push_str("\n// Resource Hot-Reload Runtime Integration (CONTINUUM)\n");
             output.push_str("void check_and_reload_resources() {\n");
+            output.push_str("    FileWatcher& watcher = FileWatcher::get_instance();\n");
+            output.push_str("    if (watcher.getChanges().empty()) {\n");
+            output.push_str("        return; // Idle frame - no per-resource stat() calls\n");
+            output.push_str("    }\n");
             for item in &program.items {
                 if let Item::Resource(res) = item {
                     let global_name = format!("g_resource_{}", res.name.to_lowercase());
-                    output.push_str(&format!("    // Check {} resource file modification time\n", res.name));
-                    output.push_str(&format!("    if ({}.reload()) {{\n", global_name));
+                    output.push_str(&format!("    // Check {} resource for changes\n", res.name));
+                    output.push_str(&format!("    if (watcher.wasChanged(\"{}\") && {}.forceReload()) {{\n", res.path, global_name));
                     output.push_str(&format!("        std::cout << \"[Resource Hot-Reload] {} reloaded successfully!\" << std::endl;\n", res.name));
                     output.push_str(&format!("    }}\n"));
                 }
@@ -597,6 +563,29 @@ impl CodeGenerator {
             output.push_str("\n");
         }
         
+        // Register every hot-reloadable file with the FileWatcher (called once from main)
+        let needs_file_watcher = !self.hot_systems.is_empty() || !self.hot_shaders.is_empty() || self.has_resources;
+        if needs_file_watcher {
+            output.push_str("\n// File watch registration for hot-reload\n");
+            output.push_str("static void init_file_watches() {\n");
+            output.push_str("    FileWatcher& watcher = FileWatcher::get_instance();\n");
+            for system in &self.hot_systems {
+                output.push_str(&format!("    watcher.watch(\"{}.dll\");\n", system.name.to_lowercase()));
+            }
+            for shader in &self.hot_shaders {
+                output.push_str(&format!("    watcher.watch(\"{}\");\n", shader.path));
+            }
+            if self.has_resources {
+                for item in &program.items {
+                    if let Item::Resource(res) = item {
+                        output.push_str(&format!("    watcher.watch(\"{}\");\n", res.path));
+                    }
+                }
+            }
+            output.push_str("}\n");
+            output.push_str("\n");
+        }
+        
         // Generate component hot-reload runtime integration
         if !self.hot_components.is_empty() {
             output.push_str("\n// Component Hot-Reload Runtime Integration\n");
@@ -762,18 +751,18 @@ impl CodeGenerator {
             if !self.hot_systems.is_empty() {
                 for system in &self.hot_systems {
                     let dll_name = format!("{}.dll", system.name.to_lowercase());
-                    let dll_cpp_name = format!("{}_hot.dll.cpp", system.name.to_lowercase());
-                    output.push_str(&format!("    // Initialize file watching\n"));
-                    output.push_str(&format!("    struct stat dll_stat;\n"));
-                    output.push_str(&format!("    if (stat(\"{}\", &dll_stat) == 0) {{\n", dll_cpp_name));
-                    output.push_str(&format!("        g_last_dll_time = dll_stat.st_mtime;\n"));
-                    output.push_str(&format!("    }}\n"));
                     output.push_str(&format!("    load_hot_system(\"{}\");\n", dll_name));
                 }
             }
-            // Initialize shader modification times at startup
+            // Register hot-reloadable files (systems, shaders, resources) with the FileWatcher
+            if needs_file_watcher {
+                output.push_str("    init_file_watches();\n");
+            }
+            // Compile hot shaders on all cores up front so reloads and pipeline creation hit the shader cache
             if !self.hot_shaders.is_empty() {
-                output.push_str("    init_shader_mtimes();\n");
+                let paths: Vec<String> = self.hot_shaders.iter().map(|shader| format!("\"{}\"", shader.path)).collect();
+                output.push_str(&format!("    const char* hot_shader_paths[] = {{ {} }};\n", paths.join(", ")));
+                output.push_str(&format!("    heidic_precompile_shaders(hot_shader_paths, {});\n", paths.len()));
             }
             // Initialize component versions at startup
             if !self.hot_components.is_empty() {
@@ -1474,7 +1463,7 @@ impl CodeGenerator {
         output.push_str(&format!("    pipelineInfo.renderPass = g_renderPass;\n"));
         output.push_str(&format!("    pipelineInfo.subpass = 0;\n"));
         output.push_str(&format!("    pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;\n"));
-        output.push_str(&format!("    if (vkCreateGraphicsPipelines(g_device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &g_pipeline_{}) != VK_SUCCESS) {{\n", pipeline_name_lower));
+        output.push_str(&format!("    if (vkCreateGraphicsPipelines(g_device, heidic_get_pipeline_cache(), 1, &pipelineInfo, nullptr, &g_pipeline_{}) != VK_SUCCESS) {{\n", pipeline_name_lower));
         output.push_str(&format!("        std::cerr << \"[Pipeline {}] ERROR: Failed to create graphics pipeline!\" << std::endl;\n", pipeline_name));
         output.push_str(&format!("        vkDestroyPipelineLayout(g_device, g_pipeline_layout_{}, nullptr);\n", pipeline_name_lower));
         if let Some(_) = &pipeline.layout {
@@ -2124,6 +2113,10 @@ impl CodeGenerator {
                 let mut output = format!("{}    while ({}) {{\n", 
                     self.indent(indent),
                     self.generate_expression(condition));
+                // Collect file changes once per iteration; the hot-reload checks below only query the batch
+                if !self.hot_systems.is_empty() || !self.hot_shaders.is_empty() || self.has_resources {
+                    output.push_str(&format!("{}        FileWatcher::get_instance().poll();\n", self.indent(indent + 1)));
+                }
                 // Add hot-reload check at the start of while loop if we have hot systems or hot shaders
                 if !self.hot_systems.is_empty() {
                     // Add check at the start of each while loop iteration
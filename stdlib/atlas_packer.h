@@ -0,0 +1,287 @@
+// EDEN ENGINE - Atlas Packer
+// Skyline rectangle packing into the layers of a texture array (UI sprites, icons, small textures)
+// Pure CPU bookkeeping with no Vulkan dependency: TextureAtlas owns the image, this decides where
+// things go. Supports incremental insert/remove and a full repack for defragmentation.
+
+#ifndef EDEN_ATLAS_PACKER_H
+#define EDEN_ATLAS_PACKER_H
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <numeric>
+
+// A placed rectangle: texel position within one layer
+struct AtlasRect {
+    uint32_t layer = 0;
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+};
+
+/**
+ * AtlasPacker - Skyline bottom-left packer over a growing number of equally sized layers
+ *
+ * Each layer keeps its skyline: the height of the packed area along x, as a list of segments.
+ * insert() tries every layer and picks the placement with the lowest top edge (then the least
+ * width wasted under it), opening a new layer only when nothing fits. remove() lowers the skyline
+ * when nothing was placed on top of the rectangle, and resets a layer once it is empty; other
+ * holes stay until repack().
+ *
+ * Usage:
+ *   AtlasPacker packer(1024, 1024);
+ *   AtlasRect rect;
+ *   if (packer.insert(64, 32, rect)) { ... copy pixels to rect.layer / rect.x / rect.y ... }
+ *   packer.remove(rect);
+ */
+class AtlasPacker {
+private:
+    struct Segment {
+        uint32_t x;
+        uint32_t y;
+        uint32_t width;
+    };
+
+    struct Layer {
+        std::vector<Segment> skyline;
+        uint64_t usedArea = 0;
+        uint32_t rectCount = 0;
+    };
+
+    uint32_t m_width;
+    uint32_t m_height;
+    uint32_t m_maxLayers;
+    std::vector<Layer> m_layers;
+
+    void resetLayer(Layer& layer) {
+        layer.skyline.assign(1, Segment{0, 0, m_width});
+        layer.usedArea = 0;
+        layer.rectCount = 0;
+    }
+
+    // Top of a width-wide rectangle resting on the skyline from segment `index`; false if it does not fit
+    bool fitAt(const Layer& layer, size_t index, uint32_t width, uint32_t height, uint32_t& y) const {
+        uint32_t x = layer.skyline[index].x;
+        if (x + width > m_width) {
+            return false;
+        }
+        y = 0;
+        uint32_t remaining = width;
+        for (size_t i = index; remaining > 0; i++) {
+            y = std::max(y, layer.skyline[i].y);
+            if (y + height > m_height) {
+                return false;
+            }
+            remaining -= std::min(remaining, layer.skyline[i].width);
+        }
+        return true;
+    }
+
+    // Wasted area trapped under a rectangle placed at segment `index` with bottom `y`
+    uint64_t wasteAt(const Layer& layer, size_t index, uint32_t width, uint32_t y) const {
+        uint64_t waste = 0;
+        uint32_t remaining = width;
+        for (size_t i = index; remaining > 0; i++) {
+            uint32_t span = std::min(remaining, layer.skyline[i].width);
+            waste += static_cast<uint64_t>(span) * (y - layer.skyline[i].y);
+            remaining -= span;
+        }
+        return waste;
+    }
+
+    // Set the skyline over [x, x + width) to `y`
+    void raise(Layer& layer, uint32_t x, uint32_t width, uint32_t y) {
+        std::vector<Segment> result;
+        result.reserve(layer.skyline.size() + 2);
+        bool inserted = false;
+        for (const Segment& segment : layer.skyline) {
+            uint32_t end = segment.x + segment.width;
+            if (end <= x || segment.x >= x + width) {
+                if (!inserted && segment.x >= x + width) {
+                    result.push_back(Segment{x, y, width});
+                    inserted = true;
+                }
+                result.push_back(segment);
+                continue;
+            }
+            if (segment.x < x) {
+                result.push_back(Segment{segment.x, segment.y, x - segment.x});
+            }
+            if (!inserted) {
+                result.push_back(Segment{x, y, width});
+                inserted = true;
+            }
+            if (end > x + width) {
+                result.push_back(Segment{x + width, segment.y, end - (x + width)});
+            }
+        }
+        if (!inserted) {
+            result.push_back(Segment{x, y, width});
+        }
+
+        // Merge neighbours at the same height
+        layer.skyline.clear();
+        for (const Segment& segment : result) {
+            if (!layer.skyline.empty() && layer.skyline.back().y == segment.y) {
+                layer.skyline.back().width += segment.width;
+            } else {
+                layer.skyline.push_back(segment);
+            }
+        }
+    }
+
+    bool insertInto(uint32_t layerIndex, uint32_t width, uint32_t height, AtlasRect& out, uint64_t& bestScore) {
+        Layer& layer = m_layers[layerIndex];
+        bool found = false;
+        for (size_t i = 0; i < layer.skyline.size(); i++) {
+            uint32_t y;
+            if (!fitAt(layer, i, width, height, y)) {
+                continue;
+            }
+            // Lowest top edge first, then least waste (packed into one key)
+            uint64_t score = (static_cast<uint64_t>(y + height) << 32) |
+                             std::min<uint64_t>(wasteAt(layer, i, width, y), 0xFFFFFFFFull);
+            if (score < bestScore) {
+                bestScore = score;
+                out.layer = layerIndex;
+                out.x = layer.skyline[i].x;
+                out.y = y;
+                found = true;
+            }
+        }
+        return found;
+    }
+
+public:
+    /**
+     * @param width/height Layer size in texels
+     * @param maxLayers    Layers insert() may open (texture array layer limit)
+     */
+    AtlasPacker(uint32_t width, uint32_t height, uint32_t maxLayers = 256)
+        : m_width(width), m_height(height), m_maxLayers(maxLayers) {}
+
+    /**
+     * Place a width x height rectangle
+     * @return false if it is larger than a layer or every layer (up to maxLayers) is full
+     */
+    bool insert(uint32_t width, uint32_t height, AtlasRect& out) {
+        if (width == 0 || height == 0 || width > m_width || height > m_height) {
+            return false;
+        }
+        uint64_t bestScore = UINT64_MAX;
+        bool found = false;
+        for (uint32_t layer = 0; layer < m_layers.size(); layer++) {
+            found |= insertInto(layer, width, height, out, bestScore);
+        }
+        if (!found) {
+            if (m_layers.size() >= m_maxLayers) {
+                return false;
+            }
+            m_layers.emplace_back();
+            resetLayer(m_layers.back());
+            found = insertInto(static_cast<uint32_t>(m_layers.size() - 1), width, height, out, bestScore);
+            if (!found) {
+                return false;
+            }
+        }
+
+        out.width = width;
+        out.height = height;
+        Layer& layer = m_layers[out.layer];
+        raise(layer, out.x, width, out.y + height);
+        layer.usedArea += static_cast<uint64_t>(width) * height;
+        layer.rectCount++;
+        return true;
+    }
+
+    /**
+     * Give a rectangle back. Its space is reusable at once if nothing sits on top of it
+     * (or its layer is now empty); otherwise only after repack().
+     */
+    void remove(const AtlasRect& rect) {
+        if (rect.layer >= m_layers.size()) {
+            return;
+        }
+        Layer& layer = m_layers[rect.layer];
+        layer.usedArea -= std::min(layer.usedArea, static_cast<uint64_t>(rect.width) * rect.height);
+        if (layer.rectCount > 0 && --layer.rectCount == 0) {
+            resetLayer(layer);
+            return;
+        }
+
+        // Lower the skyline if it is exactly the rectangle's top edge across its whole width
+        uint32_t top = rect.y + rect.height;
+        for (const Segment& segment : layer.skyline) {
+            bool overlaps = segment.x < rect.x + rect.width && segment.x + segment.width > rect.x;
+            if (overlaps && segment.y != top) {
+                return;
+            }
+        }
+        raise(layer, rect.x, rect.width, rect.y);
+    }
+
+    /**
+     * Drop everything (layers stay allocated but empty)
+     */
+    void clear() {
+        for (Layer& layer : m_layers) {
+            resetLayer(layer);
+        }
+    }
+
+    /**
+     * Pack `sizes` from scratch, tallest first, into as few layers as possible (defragmentation).
+     * On success the packer holds exactly these rectangles and `out[i]` is where sizes[i] went.
+     * @return false if they do not fit in maxLayers (the packer is then unchanged)
+     */
+    bool repack(const std::vector<std::pair<uint32_t, uint32_t>>& sizes, std::vector<AtlasRect>& out) {
+        AtlasPacker packed(m_width, m_height, m_maxLayers);
+        std::vector<AtlasRect> placed(sizes.size());
+
+        std::vector<size_t> order(sizes.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return sizes[a].second != sizes[b].second ? sizes[a].second > sizes[b].second
+                                                      : sizes[a].first > sizes[b].first;
+        });
+        for (size_t index : order) {
+            if (!packed.insert(sizes[index].first, sizes[index].second, placed[index])) {
+                return false;
+            }
+        }
+        m_layers = std::move(packed.m_layers);
+        out = std::move(placed);
+        return true;
+    }
+
+    /**
+     * Remove empty layers at the end (after removals or a repack)
+     */
+    void trimLayers() {
+        while (!m_layers.empty() && m_layers.back().rectCount == 0) {
+            m_layers.pop_back();
+        }
+    }
+
+    uint32_t getLayerCount() const { return static_cast<uint32_t>(m_layers.size()); }
+    uint32_t getWidth() const { return m_width; }
+    uint32_t getHeight() const { return m_height; }
+
+    /**
+     * Fraction of the open layers' area covered by live rectangles
+     */
+    float getOccupancy() const {
+        if (m_layers.empty()) {
+            return 0.0f;
+        }
+        uint64_t used = 0;
+        for (const Layer& layer : m_layers) {
+            used += layer.usedArea;
+        }
+        return static_cast<float>(static_cast<double>(used) /
+                                  (static_cast<double>(m_width) * m_height * m_layers.size()));
+    }
+};
+
+#endif // EDEN_ATLAS_PACKER_H
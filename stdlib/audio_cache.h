@@ -0,0 +1,289 @@
+// EDEN ENGINE - Audio Clip Cache
+// Shares decoded PCM between every AudioResource loading the same file: one immutable,
+// reference-counted AudioClip per (path, mtime, size). Decoded OGG clips are also written to a
+// ".pcm" file in the audio cache directory so later launches skip Vorbis decoding entirely.
+
+#ifndef EDEN_AUDIO_CACHE_H
+#define EDEN_AUDIO_CACHE_H
+
+#include "audio_mixer.h"
+#include "resource_cache.h"
+#include <string>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <direct.h>
+#endif
+
+/**
+ * AudioClipCache - Path-keyed cache of decoded clips
+ *
+ * Entries hold weak references: a clip lives as long as some AudioResource or mixer voice uses
+ * it, and is decoded again (or read from its .pcm file) after that. An entry only matches while
+ * the source file's modification time (to the file system's sub-second resolution) and size are
+ * unchanged, so edited files are re-decoded and their stale .pcm files rewritten.
+ *
+ * .pcm files live in the cache directory (default "audio_cache", like the shader cache), named
+ * by a hash of the normalized source path, so asset folders are never written to.
+ * Layout: PcmHeader followed by frameCount * channels interleaved int16 samples.
+ *
+ * Usage:
+ *   AudioClipCache& cache = AudioClipCache::get_instance();
+ *   std::shared_ptr<const AudioClip> clip = cache.find("audio/step.ogg");
+ *   if (!clip) clip = cache.insert("audio/step.ogg", decodeStep(), true);
+ */
+class AudioClipCache {
+public:
+    struct Stats {
+        uint64_t memoryHits = 0;
+        uint64_t diskHits = 0;
+        uint64_t misses = 0;
+    };
+
+private:
+    struct FileStamp {
+        int64_t mtime = 0;          // Nanoseconds (100 ns units on Windows)
+        int64_t size = -1;
+
+        bool operator==(const FileStamp& other) const { return mtime == other.mtime && size == other.size; }
+    };
+
+    struct PcmHeader {
+        char magic[4];              // "EPCM"
+        uint32_t version;
+        int64_t sourceMtime;
+        int64_t sourceSize;
+        uint32_t channels;
+        uint32_t sampleRate;
+        uint64_t frameCount;
+    };
+
+    struct Entry {
+        FileStamp stamp;
+        std::weak_ptr<const AudioClip> clip;
+    };
+
+    static constexpr uint32_t PCM_VERSION = 2;
+
+    std::unordered_map<std::string, Entry> m_entries;       // normalized path -> entry
+    std::mutex m_mutex;
+    std::string m_cacheDirectory = "audio_cache";
+    Stats m_stats;
+
+    AudioClipCache() = default;
+
+    static FileStamp fileStamp(const std::string& path) {
+        FileStamp stamp;
+#ifdef _WIN32
+        WIN32_FILE_ATTRIBUTE_DATA attributes;
+        if (GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &attributes)) {
+            stamp.mtime = static_cast<int64_t>((static_cast<uint64_t>(attributes.ftLastWriteTime.dwHighDateTime) << 32) |
+                                               attributes.ftLastWriteTime.dwLowDateTime);
+            stamp.size = static_cast<int64_t>((static_cast<uint64_t>(attributes.nFileSizeHigh) << 32) | attributes.nFileSizeLow);
+        }
+#else
+        struct stat fileStat;
+        if (stat(path.c_str(), &fileStat) == 0) {
+#ifdef __APPLE__
+            const struct timespec& modified = fileStat.st_mtimespec;
+#else
+            const struct timespec& modified = fileStat.st_mtim;
+#endif
+            stamp.mtime = static_cast<int64_t>(modified.tv_sec) * 1000000000 + modified.tv_nsec;
+            stamp.size = static_cast<int64_t>(fileStat.st_size);
+        }
+#endif
+        return stamp;
+    }
+
+    static void makeDirectory(const std::string& dir) {
+#ifdef _WIN32
+        _mkdir(dir.c_str());
+#else
+        mkdir(dir.c_str(), 0755);
+#endif
+    }
+
+    // Read a .pcm file; nullptr if missing, corrupt or made from a different version of the source
+    static std::shared_ptr<const AudioClip> readPcm(const std::string& pcmPath, const FileStamp& source) {
+        FILE* file = fopen(pcmPath.c_str(), "rb");
+        if (!file) {
+            return nullptr;
+        }
+        PcmHeader header;
+        std::shared_ptr<AudioClip> clip;
+        if (fread(&header, sizeof(header), 1, file) == 1 && memcmp(header.magic, "EPCM", 4) == 0 &&
+            header.version == PCM_VERSION && header.sourceMtime == source.mtime && header.sourceSize == source.size &&
+            header.channels > 0 && header.channels <= 8 && header.sampleRate > 0 && fseek(file, 0, SEEK_END) == 0 &&
+            static_cast<uint64_t>(ftell(file)) == sizeof(header) + header.frameCount * header.channels * sizeof(int16_t) &&
+            fseek(file, sizeof(header), SEEK_SET) == 0) {
+            clip = std::make_shared<AudioClip>();
+            clip->channels = static_cast<int>(header.channels);
+            clip->sampleRate = static_cast<int>(header.sampleRate);
+            clip->samples.resize(static_cast<size_t>(header.frameCount) * header.channels);
+            if (fread(clip->samples.data(), sizeof(int16_t), clip->samples.size(), file) != clip->samples.size()) {
+                clip.reset();
+            }
+        }
+        fclose(file);
+        return clip;
+    }
+
+    // Write a .pcm file through a temporary name (an unwritable cache only costs the decode next time)
+    static void writePcm(const std::string& directory, const std::string& pcmPath, const AudioClip& clip,
+                         const FileStamp& source) {
+        makeDirectory(directory);
+        std::string tempPath = pcmPath + ".part";
+        FILE* file = fopen(tempPath.c_str(), "wb");
+        if (!file) {
+            return;
+        }
+        PcmHeader header;
+        memcpy(header.magic, "EPCM", 4);
+        header.version = PCM_VERSION;
+        header.sourceMtime = source.mtime;
+        header.sourceSize = source.size;
+        header.channels = static_cast<uint32_t>(clip.channels);
+        header.sampleRate = static_cast<uint32_t>(clip.sampleRate);
+        header.frameCount = clip.getFrameCount();
+        bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                  fwrite(clip.samples.data(), sizeof(int16_t), clip.samples.size(), file) == clip.samples.size();
+        fclose(file);
+        remove(pcmPath.c_str());
+        if (!ok || rename(tempPath.c_str(), pcmPath.c_str()) != 0) {
+            remove(tempPath.c_str());
+        }
+    }
+
+    // Cache file for a normalized source path ("" when the disk cache is off)
+    std::string pcmPathForKey(const std::string& key) const {
+        if (m_cacheDirectory.empty()) {
+            return "";
+        }
+        uint64_t hash = 1469598103934665603ull;
+        for (char c : key) {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 1099511628211ull;
+        }
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.pcm", static_cast<unsigned long long>(hash));
+        return m_cacheDirectory + "/" + name;
+    }
+
+public:
+    AudioClipCache(const AudioClipCache&) = delete;
+    AudioClipCache& operator=(const AudioClipCache&) = delete;
+
+    /**
+     * Get the cache shared by all AudioResources
+     */
+    static AudioClipCache& get_instance() {
+        static AudioClipCache* instance = new AudioClipCache();
+        return *instance;
+    }
+
+    /**
+     * Disk cache file for a source: "audio/step.ogg" -> "audio_cache/<hash of the path>.pcm"
+     * ("" when the disk cache is off)
+     */
+    std::string pcmCachePath(const std::string& sourcePath) {
+        std::string key = ResourceCache<AudioClip>::normalizePath(sourcePath);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return pcmPathForKey(key);
+    }
+
+    /**
+     * Look up the clip for a file's current contents: in memory, else in its .pcm file
+     * @return Shared clip, or nullptr if it has to be decoded (then insert() it)
+     */
+    std::shared_ptr<const AudioClip> find(const std::string& path) {
+        std::string key = ResourceCache<AudioClip>::normalizePath(path);
+        FileStamp stamp = fileStamp(path);
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto it = m_entries.find(key);
+        if (it != m_entries.end() && it->second.stamp == stamp) {
+            if (std::shared_ptr<const AudioClip> clip = it->second.clip.lock()) {
+                m_stats.memoryHits++;
+                return clip;
+            }
+        }
+        if (!m_cacheDirectory.empty() && stamp.size >= 0) {
+            if (std::shared_ptr<const AudioClip> clip = readPcm(pcmPathForKey(key), stamp)) {
+                m_entries[key] = Entry{stamp, clip};
+                m_stats.diskHits++;
+                return clip;
+            }
+        }
+        m_stats.misses++;
+        return nullptr;
+    }
+
+    /**
+     * Register a freshly decoded clip for a file (replaces any stale entry)
+     * @param writeDiskCache Also write the .pcm file (worth it when decoding is expensive, e.g. OGG)
+     * @return The clip, now shared and immutable
+     */
+    std::shared_ptr<const AudioClip> insert(const std::string& path, AudioClip&& decoded, bool writeDiskCache) {
+        std::shared_ptr<const AudioClip> clip = std::make_shared<const AudioClip>(std::move(decoded));
+        std::string key = ResourceCache<AudioClip>::normalizePath(path);
+        FileStamp stamp = fileStamp(path);
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_entries[key] = Entry{stamp, clip};
+        if (writeDiskCache && !m_cacheDirectory.empty() && stamp.size >= 0) {
+            writePcm(m_cacheDirectory, pcmPathForKey(key), *clip, stamp);
+        }
+        return clip;
+    }
+
+    /**
+     * Forget entries whose clips are no longer used by anyone
+     */
+    void purge() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto it = m_entries.begin(); it != m_entries.end();) {
+            it = it->second.clip.expired() ? m_entries.erase(it) : std::next(it);
+        }
+    }
+
+    /**
+     * Bytes of PCM held by live clips (each shared clip counted once)
+     */
+    size_t getMemorySize() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        size_t bytes = 0;
+        for (const auto& pair : m_entries) {
+            if (std::shared_ptr<const AudioClip> clip = pair.second.clip.lock()) {
+                bytes += clip->samples.size() * sizeof(int16_t);
+            }
+        }
+        return bytes;
+    }
+
+    // Directory for .pcm files ("" = memory cache only)
+    void setCacheDirectory(const std::string& dir) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_cacheDirectory = dir;
+    }
+
+    Stats getStats() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+};
+
+#endif // EDEN_AUDIO_CACHE_H
@@ -0,0 +1,668 @@
+// EDEN ENGINE - Audio Mixer
+// Central software mixer: a fixed pool of voices (in-memory clips or OggStreams) with per-voice
+// gain, pan and pitch, polyphase resampling to the output rate, and SSE float mixing.
+// A mixer thread renders ahead into an SpscRing and one SDL device stream drains it; render()
+// also works without any device (offline rendering, tools, tests).
+
+#ifndef EDEN_AUDIO_MIXER_H
+#define EDEN_AUDIO_MIXER_H
+
+#include "spsc_ring.h"
+#include "audio_stream.h"
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <algorithm>
+
+#ifndef SDL3_AUDIO_AVAILABLE
+#ifdef __has_include
+    #if __has_include(<SDL3/SDL.h>)
+        #include <SDL3/SDL.h>
+        #include <SDL3/SDL_audio.h>
+        #define SDL3_AUDIO_AVAILABLE
+    #endif
+#endif
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EDEN_MIXER_SSE2 1
+#include <emmintrin.h>
+#endif
+
+/**
+ * AudioClip - Decoded audio held in memory (interleaved 16-bit, any channel count and rate)
+ * Shared between the AudioResource that loaded it and the voices playing it.
+ */
+struct AudioClip {
+    std::vector<int16_t> samples;
+    int channels = 0;
+    int sampleRate = 0;
+
+    size_t getFrameCount() const { return channels > 0 ? samples.size() / channels : 0; }
+};
+
+// Per-voice playback parameters (changeable while playing)
+struct VoiceParams {
+    float gain = 1.0f;
+    float pan = 0.0f;       // -1 = left, 0 = centre, +1 = right
+    float pitch = 1.0f;     // Playback rate multiplier (1 = original pitch)
+    bool loop = false;      // Clips only; streams loop through OggStream::start()
+};
+
+/**
+ * AudioMixer - Mixes up to maxVoices sources into one stereo float stream
+ *
+ * Each voice is resampled from its source rate (times pitch) to the output rate with an
+ * 8-tap windowed-sinc filter bank of 256 phases, then added to the stereo bus with its gains
+ * ramped across the block (no zipper noise on gain/pan changes). Mono sources are panned at
+ * constant power; stereo sources use pan as balance. When the pool is full the oldest clip voice
+ * is stolen. Voices are addressed by handles that go stale once the voice ends.
+ *
+ * The filter does not narrow its cutoff when pitching up, so large upward pitch shifts alias a
+ * little; that is inaudible for the usual +-1 octave of SFX variation.
+ *
+ * Usage:
+ *   AudioMixer& mixer = AudioMixer::get_instance();
+ *   mixer.start();                                      // Open the device and mixer thread
+ *   auto voice = mixer.play(clip, VoiceParams{0.8f, -0.5f, 1.2f});
+ *   mixer.setPan(voice, 0.5f);
+ *   mixer.stop(voice);
+ *
+ *   AudioMixer offline(48000);
+ *   offline.play(clip);
+ *   offline.render(buffer, frames);                     // No device needed
+ */
+class AudioMixer {
+public:
+    using VoiceHandle = uint32_t;
+    static constexpr VoiceHandle INVALID_VOICE = 0;
+
+    static constexpr int FILTER_TAPS = 8;
+    static constexpr int FILTER_PHASES = 256;
+    static constexpr size_t BLOCK_FRAMES = 256;         // Frames mixed per inner block
+    static constexpr int MAX_STEP = 8;                  // Highest source/output frame ratio (rate x pitch)
+    static constexpr size_t SCRATCH_FRAMES = BLOCK_FRAMES * MAX_STEP + 2 * FILTER_TAPS;
+
+private:
+    struct Voice {
+        bool active = false;
+        uint32_t generation = 0;
+        uint64_t startOrder = 0;
+        std::shared_ptr<const AudioClip> clip;
+        OggStream* stream = nullptr;
+        int channels = 0;
+        int sampleRate = 0;
+        VoiceParams params;
+
+        size_t cursor = 0;                  // Next clip frame to fetch
+        uint32_t frac = 0;                  // Read position within the history (1/2^32 frame)
+        size_t historyCount = 0;            // Source frames fetched but not yet consumed
+        float history[2][FILTER_TAPS];
+        bool sourceEnded = false;
+        bool stopping = false;              // Fading out over one block, then freed
+        int64_t tailFrames = 0;             // Frames still to consume once the source has ended
+        float gains[2] = {0.0f, 0.0f};      // Gains reached at the end of the last block
+    };
+
+    int m_outputRate;
+    std::vector<Voice> m_voices;
+    uint64_t m_startCounter = 0;
+    float m_masterGain = 1.0f;
+    std::mutex m_mutex;                     // Voices: taken by the control API and for each render()
+
+    alignas(16) float m_filter[FILTER_PHASES][FILTER_TAPS];
+    std::vector<float> m_scratch[2];        // Source frames for one block, per channel
+    std::vector<float> m_dry[2];            // Resampled (pre-gain) voice output for one block
+    std::vector<int16_t> m_streamBuffer;
+
+    // Device output (mixer thread -> SpscRing -> SDL callback)
+    std::unique_ptr<SpscRing<float>> m_ring;
+    size_t m_targetSamples = 0;
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+    std::atomic<uint64_t> m_underruns{0};
+#ifdef SDL3_AUDIO_AVAILABLE
+    SDL_AudioStream* m_deviceStream = nullptr;
+#endif
+
+    /**
+     * Windowed-sinc interpolation bank: row p interpolates at 3 + p/PHASES between taps 3 and 4
+     * (Blackman window, cutoff 0.45 of the source rate, each row normalised to unity DC gain)
+     */
+    void buildFilter() {
+        const double pi = 3.14159265358979323846;
+        const double cutoff = 0.45;
+        for (int phase = 0; phase < FILTER_PHASES; phase++) {
+            double frac = static_cast<double>(phase) / FILTER_PHASES;
+            double sum = 0.0;
+            double taps[FILTER_TAPS];
+            for (int j = 0; j < FILTER_TAPS; j++) {
+                double x = j - (FILTER_TAPS / 2 - 1) - frac;
+                double arg = 2.0 * cutoff * x;
+                double sinc = std::abs(arg) < 1e-9 ? 1.0 : std::sin(pi * arg) / (pi * arg);
+                double w = x / (FILTER_TAPS / 2);
+                double window = std::abs(w) >= 1.0 ? 0.0 : 0.42 + 0.5 * std::cos(pi * w) + 0.08 * std::cos(2.0 * pi * w);
+                taps[j] = sinc * window;
+                sum += taps[j];
+            }
+            for (int j = 0; j < FILTER_TAPS; j++) {
+                m_filter[phase][j] = static_cast<float>(taps[j] / sum);
+            }
+        }
+    }
+
+    static void computeGains(const VoiceParams& params, int channels, float gains[2]) {
+        float pan = std::min(1.0f, std::max(-1.0f, params.pan));
+        if (channels == 1) {
+            float angle = (pan + 1.0f) * 0.785398163f;      // Constant power: 0 .. pi/2
+            gains[0] = params.gain * std::cos(angle);
+            gains[1] = params.gain * std::sin(angle);
+        } else {
+            gains[0] = params.gain * std::min(1.0f, 1.0f - pan);
+            gains[1] = params.gain * std::min(1.0f, 1.0f + pan);
+        }
+    }
+
+    Voice* findVoice(VoiceHandle handle) {
+        uint32_t index = handle & 0xFFFF;
+        if (handle == INVALID_VOICE || index >= m_voices.size()) {
+            return nullptr;
+        }
+        Voice& voice = m_voices[index];
+        return voice.active && voice.generation == (handle >> 16) ? &voice : nullptr;
+    }
+
+    // Free voice, or the oldest clip voice (streams are never stolen)
+    Voice* allocateVoice(uint32_t& index) {
+        Voice* oldest = nullptr;
+        for (uint32_t i = 0; i < m_voices.size(); i++) {
+            Voice& voice = m_voices[i];
+            if (!voice.active) {
+                index = i;
+                return &voice;
+            }
+            if (!voice.stream && (!oldest || voice.startOrder < oldest->startOrder)) {
+                oldest = &voice;
+                index = i;
+            }
+        }
+        return oldest;
+    }
+
+    VoiceHandle startVoice(std::shared_ptr<const AudioClip> clip, OggStream* stream, int channels, int sampleRate,
+                           const VoiceParams& params, size_t startFrame) {
+        if (channels <= 0 || sampleRate <= 0) {
+            return INVALID_VOICE;
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        uint32_t index = 0;
+        Voice* voice = allocateVoice(index);
+        if (!voice) {
+            return INVALID_VOICE;
+        }
+        uint32_t generation = ((voice->generation + 1) & 0xFFFF) ? voice->generation + 1 : 1;
+        *voice = Voice{};
+        voice->active = true;
+        voice->generation = generation;
+        voice->startOrder = m_startCounter++;
+        voice->clip = std::move(clip);
+        voice->stream = stream;
+        voice->channels = channels;
+        voice->sampleRate = sampleRate;
+        voice->params = params;
+        voice->historyCount = FILTER_TAPS - 1;              // Zeros: the filter starts from silence
+        if (voice->clip && startFrame > 0) {
+            voice->cursor = startFrame % voice->clip->getFrameCount();
+            // Resuming mid-sound: fade in over the first block instead of clicking
+        } else {
+            computeGains(params, channels, voice->gains);
+        }
+        return (generation << 16) | index;
+    }
+
+    /**
+     * Fetch up to `count` source frames as float (left/right; mono fills left only)
+     * @return Frames delivered; fewer means the source ended or a stream ran dry
+     */
+    size_t fetch(Voice& voice, float* left, float* right, size_t count) {
+        const float scale = 1.0f / 32768.0f;
+        int channels = voice.channels;
+        size_t done = 0;
+
+        if (voice.clip) {
+            const AudioClip& clip = *voice.clip;
+            size_t frames = clip.getFrameCount();
+            while (done < count && frames > 0) {
+                if (voice.cursor >= frames) {
+                    if (!voice.params.loop) {
+                        voice.sourceEnded = true;
+                        break;
+                    }
+                    voice.cursor = 0;
+                }
+                size_t run = std::min(count - done, frames - voice.cursor);
+                const int16_t* src = clip.samples.data() + voice.cursor * channels;
+                for (size_t i = 0; i < run; i++) {
+                    left[done + i] = src[i * channels] * scale;
+                }
+                if (channels > 1) {
+                    for (size_t i = 0; i < run; i++) {
+                        right[done + i] = src[i * channels + 1] * scale;
+                    }
+                }
+                voice.cursor += run;
+                done += run;
+            }
+            return done;
+        }
+
+        size_t chunkFrames = m_streamBuffer.size() / channels;
+        while (done < count) {
+            size_t got = voice.stream->read(m_streamBuffer.data(), std::min(count - done, chunkFrames));
+            for (size_t i = 0; i < got; i++) {
+                left[done + i] = m_streamBuffer[i * channels] * scale;
+            }
+            if (channels > 1) {
+                for (size_t i = 0; i < got; i++) {
+                    right[done + i] = m_streamBuffer[i * channels + 1] * scale;
+                }
+            }
+            done += got;
+            if (got == 0) {
+                if (voice.stream->isFinished()) {
+                    voice.sourceEnded = true;
+                }
+                break;                                      // Underrun: the rest of the block is silent
+            }
+        }
+        return done;
+    }
+
+    // Dot product of 8 source frames with one filter row
+    static float convolve(const float* src, const float* taps) {
+#ifdef EDEN_MIXER_SSE2
+        __m128 sum = _mm_mul_ps(_mm_loadu_ps(src), _mm_load_ps(taps));
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(src + 4), _mm_load_ps(taps + 4)));
+        __m128 shuffled = _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(2, 3, 0, 1));
+        sum = _mm_add_ps(sum, shuffled);
+        shuffled = _mm_movehl_ps(shuffled, sum);
+        return _mm_cvtss_f32(_mm_add_ss(sum, shuffled));
+#else
+        float sum = 0.0f;
+        for (int j = 0; j < FILTER_TAPS; j++) {
+            sum += src[j] * taps[j];
+        }
+        return sum;
+#endif
+    }
+
+    // Add dry[0]/dry[1] to the interleaved bus, ramping gains from `from` to `to` over the block
+    static void accumulate(float* bus, const float* dryLeft, const float* dryRight, size_t frames,
+                           const float from[2], const float to[2]) {
+        float stepLeft = (to[0] - from[0]) / frames;
+        float stepRight = (to[1] - from[1]) / frames;
+        size_t k = 0;
+#ifdef EDEN_MIXER_SSE2
+        __m128 ramp = _mm_set_ps(4.0f, 3.0f, 2.0f, 1.0f);
+        __m128 baseLeft = _mm_set1_ps(from[0]);
+        __m128 baseRight = _mm_set1_ps(from[1]);
+        __m128 deltaLeft = _mm_set1_ps(stepLeft);
+        __m128 deltaRight = _mm_set1_ps(stepRight);
+        for (; k + 4 <= frames; k += 4) {
+            __m128 index = _mm_add_ps(_mm_set1_ps(static_cast<float>(k)), ramp);
+            __m128 left = _mm_mul_ps(_mm_loadu_ps(dryLeft + k), _mm_add_ps(baseLeft, _mm_mul_ps(deltaLeft, index)));
+            __m128 right = _mm_mul_ps(_mm_loadu_ps(dryRight + k), _mm_add_ps(baseRight, _mm_mul_ps(deltaRight, index)));
+            float* out = bus + k * 2;
+            _mm_storeu_ps(out, _mm_add_ps(_mm_loadu_ps(out), _mm_unpacklo_ps(left, right)));
+            _mm_storeu_ps(out + 4, _mm_add_ps(_mm_loadu_ps(out + 4), _mm_unpackhi_ps(left, right)));
+        }
+#endif
+        for (; k < frames; k++) {
+            bus[k * 2] += dryLeft[k] * (from[0] + stepLeft * (k + 1));
+            bus[k * 2 + 1] += dryRight[k] * (from[1] + stepRight * (k + 1));
+        }
+    }
+
+    // Resample one block of a voice and add it to the bus
+    void mixVoice(Voice& voice, float* bus, size_t frames) {
+        double ratio = static_cast<double>(voice.sampleRate) / m_outputRate * std::max(voice.params.pitch, 0.0f);
+        ratio = std::min(std::max(ratio, 1.0 / 1024.0), static_cast<double>(MAX_STEP));
+        uint64_t step = static_cast<uint64_t>(ratio * 4294967296.0);
+        uint64_t position = voice.frac;
+        size_t lastIndex = static_cast<size_t>((position + step * (frames - 1)) >> 32);
+        size_t consumed = static_cast<size_t>((position + step * frames) >> 32);
+        size_t total = std::max(lastIndex + FILTER_TAPS, consumed + FILTER_TAPS - 1);
+        int outChannels = voice.channels > 1 ? 2 : 1;
+
+        // History, then fresh source frames, then silence
+        for (int c = 0; c < outChannels; c++) {
+            std::copy(voice.history[c], voice.history[c] + voice.historyCount, m_scratch[c].data());
+        }
+        size_t need = total - voice.historyCount;
+        size_t got = 0;
+        if (!voice.sourceEnded) {
+            got = fetch(voice, m_scratch[0].data() + voice.historyCount, m_scratch[1].data() + voice.historyCount, need);
+            if (voice.sourceEnded) {
+                voice.tailFrames = static_cast<int64_t>(voice.historyCount + got + FILTER_TAPS);
+            }
+        }
+        for (int c = 0; c < outChannels; c++) {
+            std::fill(m_scratch[c].data() + voice.historyCount + got, m_scratch[c].data() + total, 0.0f);
+        }
+
+        for (int c = 0; c < outChannels; c++) {
+            const float* src = m_scratch[c].data();
+            float* dry = m_dry[c].data();
+            uint64_t p = position;
+            for (size_t k = 0; k < frames; k++, p += step) {
+                dry[k] = convolve(src + (p >> 32), m_filter[(p >> 24) & (FILTER_PHASES - 1)]);
+            }
+        }
+
+        float target[2] = {0.0f, 0.0f};
+        if (!voice.stopping) {
+            computeGains(voice.params, voice.channels, target);
+        }
+        accumulate(bus, m_dry[0].data(), m_dry[outChannels - 1].data(), frames, voice.gains, target);
+        voice.gains[0] = target[0];
+        voice.gains[1] = target[1];
+
+        // Keep what the next block still needs
+        voice.historyCount = total - consumed;
+        for (int c = 0; c < outChannels; c++) {
+            std::copy(m_scratch[c].data() + consumed, m_scratch[c].data() + total, voice.history[c]);
+        }
+        voice.frac = static_cast<uint32_t>(position + step * frames);
+
+        if (voice.sourceEnded) {
+            voice.tailFrames -= static_cast<int64_t>(consumed);
+        }
+        if (voice.stopping || (voice.sourceEnded && voice.tailFrames <= 0)) {
+            voice.active = false;
+            voice.clip.reset();
+            voice.stream = nullptr;
+        }
+    }
+
+    static void applyMasterGain(float* out, size_t count, float gain) {
+        size_t i = 0;
+#ifdef EDEN_MIXER_SSE2
+        __m128 g = _mm_set1_ps(gain);
+        __m128 lo = _mm_set1_ps(-1.0f);
+        __m128 hi = _mm_set1_ps(1.0f);
+        for (; i + 4 <= count; i += 4) {
+            _mm_storeu_ps(out + i, _mm_min_ps(hi, _mm_max_ps(lo, _mm_mul_ps(_mm_loadu_ps(out + i), g))));
+        }
+#endif
+        for (; i < count; i++) {
+            out[i] = std::min(1.0f, std::max(-1.0f, out[i] * gain));
+        }
+    }
+
+    void mixLoop() {
+        std::vector<float> block(BLOCK_FRAMES * 2);
+        while (m_running.load(std::memory_order_relaxed)) {
+            if (m_ring->readAvailable() + block.size() > m_targetSamples) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                continue;
+            }
+            render(block.data(), BLOCK_FRAMES);
+            m_ring->write(block.data(), block.size());
+        }
+    }
+
+#ifdef SDL3_AUDIO_AVAILABLE
+    // SDL device callback: hand over what the mixer thread has rendered (silence on underrun)
+    static void SDLCALL deviceCallback(void* userdata, SDL_AudioStream* stream, int additionalAmount, int totalAmount) {
+        (void)totalAmount;
+        AudioMixer* mixer = static_cast<AudioMixer*>(userdata);
+        float buffer[BLOCK_FRAMES * 2];
+        size_t wanted = (static_cast<size_t>(std::max(additionalAmount, 0)) + sizeof(float) * 2 - 1) / (sizeof(float) * 2) * 2;
+        while (wanted > 0) {
+            size_t got = mixer->m_ring->read(buffer, std::min(wanted, BLOCK_FRAMES * 2));
+            if (got == 0) {
+                mixer->m_underruns.fetch_add(1, std::memory_order_relaxed);
+                break;
+            }
+            SDL_PutAudioStreamData(stream, buffer, static_cast<int>(got * sizeof(float)));
+            wanted -= got;
+        }
+    }
+#endif
+
+public:
+    /**
+     * @param outputRate Mix rate (start() switches to the device's native rate)
+     * @param maxVoices  Voice pool size (at most 65535)
+     */
+    explicit AudioMixer(int outputRate = 48000, uint32_t maxVoices = 64)
+        : m_outputRate(outputRate), m_voices(std::min<uint32_t>(std::max<uint32_t>(maxVoices, 1), 0xFFFF)) {
+        buildFilter();
+        for (int c = 0; c < 2; c++) {
+            m_scratch[c].resize(SCRATCH_FRAMES);
+            m_dry[c].resize(BLOCK_FRAMES);
+        }
+        m_streamBuffer.resize(SCRATCH_FRAMES * 2);
+    }
+
+    ~AudioMixer() {
+        shutdown();
+    }
+
+    AudioMixer(const AudioMixer&) = delete;
+    AudioMixer& operator=(const AudioMixer&) = delete;
+
+    /**
+     * Get the mixer behind the audio device (AudioResource::play goes through it)
+     */
+    static AudioMixer& get_instance() {
+        static AudioMixer* instance = new AudioMixer();
+        return *instance;
+    }
+
+    /**
+     * Open the default playback device and start the mixer thread (no-op if running)
+     * @param latencyFrames Audio the mixer thread keeps rendered ahead of the device
+     * @return false if SDL3 audio is unavailable or the device cannot be opened
+     */
+    bool start(size_t latencyFrames = 1024) {
+        if (m_running) {
+            return true;
+        }
+#ifdef SDL3_AUDIO_AVAILABLE
+        if (SDL_Init(SDL_INIT_AUDIO) == 0) {
+            std::cerr << "[Audio] SDL_Init failed: " << SDL_GetError() << std::endl;
+            return false;
+        }
+
+        // Mix at the device's own rate so SDL does not resample a second time
+        SDL_AudioSpec deviceSpec;
+        int deviceFrames = 0;
+        if (SDL_GetAudioDeviceFormat(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &deviceSpec, &deviceFrames) && deviceSpec.freq > 0) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_outputRate = deviceSpec.freq;
+        }
+        SDL_AudioSpec spec;
+        spec.format = SDL_AUDIO_F32;
+        spec.channels = 2;
+        spec.freq = m_outputRate;
+
+        m_targetSamples = std::max(latencyFrames, BLOCK_FRAMES) * 2;
+        m_ring = std::make_unique<SpscRing<float>>(m_targetSamples + BLOCK_FRAMES * 2);
+        m_underruns = 0;
+        m_deviceStream = SDL_OpenAudioDeviceStream(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &spec, deviceCallback, this);
+        if (!m_deviceStream) {
+            std::cerr << "[Audio] SDL_OpenAudioDeviceStream failed: " << SDL_GetError() << std::endl;
+            return false;
+        }
+        m_running = true;
+        m_thread = std::thread(&AudioMixer::mixLoop, this);
+        SDL_ResumeAudioStreamDevice(m_deviceStream);
+        return true;
+#else
+        (void)latencyFrames;
+        std::cerr << "[Audio] SDL3_AUDIO_AVAILABLE not defined - SDL3 headers not found" << std::endl;
+        return false;
+#endif
+    }
+
+    /**
+     * Close the device and stop the mixer thread (voices are kept)
+     */
+    void shutdown() {
+#ifdef SDL3_AUDIO_AVAILABLE
+        if (m_deviceStream) {
+            SDL_DestroyAudioStream(m_deviceStream);
+            m_deviceStream = nullptr;
+        }
+#endif
+        m_running = false;
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+
+    /**
+     * Mix `frames` stereo frames of all voices into `out` (interleaved L/R float, clamped to
+     * [-1, 1]). Called by the mixer thread when running; call it directly for offline rendering.
+     */
+    void render(float* out, size_t frames) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::fill(out, out + frames * 2, 0.0f);
+        for (size_t offset = 0; offset < frames; offset += BLOCK_FRAMES) {
+            size_t count = std::min(BLOCK_FRAMES, frames - offset);
+            for (Voice& voice : m_voices) {
+                if (voice.active) {
+                    mixVoice(voice, out + offset * 2, count);
+                }
+            }
+        }
+        applyMasterGain(out, frames * 2, m_masterGain);
+    }
+
+    /**
+     * Start a voice playing an in-memory clip
+     * @param startFrame Source frame to start from (wraps; a voice resumed mid-clip fades in)
+     * @return Voice handle, or INVALID_VOICE if the clip is empty or every voice is a stream
+     */
+    VoiceHandle play(std::shared_ptr<const AudioClip> clip, const VoiceParams& params = VoiceParams{},
+                     size_t startFrame = 0) {
+        if (!clip || clip->getFrameCount() == 0) {
+            return INVALID_VOICE;
+        }
+        int channels = clip->channels;
+        int sampleRate = clip->sampleRate;
+        return startVoice(std::move(clip), nullptr, channels, sampleRate, params, startFrame);
+    }
+
+    /**
+     * Start a voice reading a started OggStream (the mixer thread becomes its consumer).
+     * The stream must outlive the voice: stop() the voice before stopping or destroying it.
+     */
+    VoiceHandle playStream(OggStream* stream, const VoiceParams& params = VoiceParams{}) {
+        if (!stream) {
+            return INVALID_VOICE;
+        }
+        return startVoice(nullptr, stream, stream->getChannels(), stream->getSampleRate(), params, 0);
+    }
+
+    /**
+     * Stop a voice. When this returns the mixer no longer touches the voice's source, unless
+     * `fadeOut` is set: then the voice ramps to silence over the next block (no click) and is
+     * freed after it, so its source must stay alive until isPlaying() turns false.
+     */
+    void stop(VoiceHandle handle, bool fadeOut = false) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (Voice* voice = findVoice(handle)) {
+            if (fadeOut) {
+                voice->stopping = true;
+                return;
+            }
+            voice->active = false;
+            voice->clip.reset();
+            voice->stream = nullptr;
+        }
+    }
+
+    void stopAll() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (Voice& voice : m_voices) {
+            voice.active = false;
+            voice.clip.reset();
+            voice.stream = nullptr;
+        }
+    }
+
+    bool isPlaying(VoiceHandle handle) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return findVoice(handle) != nullptr;
+    }
+
+    /**
+     * Source frame a clip voice is currently playing (to resume it later with play(startFrame))
+     */
+    size_t getSourcePosition(VoiceHandle handle) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Voice* voice = findVoice(handle);
+        if (!voice || !voice->clip) {
+            return 0;
+        }
+        size_t frames = voice->clip->getFrameCount();
+        return (voice->cursor + frames - std::min(voice->historyCount, voice->cursor + frames)) % frames;
+    }
+
+    /**
+     * Replace all parameters of a playing voice (gain and pan ramp over the next block)
+     */
+    void setParams(VoiceHandle handle, const VoiceParams& params) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (Voice* voice = findVoice(handle)) {
+            voice->params = params;
+        }
+    }
+
+    void setGain(VoiceHandle handle, float gain) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (Voice* voice = findVoice(handle)) {
+            voice->params.gain = gain;
+        }
+    }
+
+    void setPan(VoiceHandle handle, float pan) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (Voice* voice = findVoice(handle)) {
+            voice->params.pan = pan;
+        }
+    }
+
+    void setPitch(VoiceHandle handle, float pitch) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (Voice* voice = findVoice(handle)) {
+            voice->params.pitch = pitch;
+        }
+    }
+
+    void setMasterGain(float gain) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_masterGain = gain;
+    }
+
+    uint32_t getActiveVoiceCount() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return static_cast<uint32_t>(std::count_if(m_voices.begin(), m_voices.end(),
+                                                   [](const Voice& voice) { return voice.active; }));
+    }
+
+    int getOutputRate() const { return m_outputRate; }
+    uint32_t getMaxVoices() const { return static_cast<uint32_t>(m_voices.size()); }
+    uint64_t getUnderrunCount() const { return m_underruns.load(std::memory_order_relaxed); }
+};
+
+#endif // EDEN_AUDIO_MIXER_H
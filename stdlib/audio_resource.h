@@ -28,6 +28,8 @@
 // stb_vorbis_decode_filename requires both
 // (don't define STB_VORBIS_NO_STDIO or STB_VORBIS_NO_INTEGER_CONVERSION)
 #include "stb_vorbis.h"
+#include "audio_mixer.h"
+#include "audio_cache.h"
 
 // SDL3 audio - check if SDL3 is available
 // Note: We check for SDL3 by trying to include it
@@ -59,7 +61,11 @@ struct SDL_AudioSpec {
  * 
  * Automatically detects format (WAV vs OGG) and loads appropriately.
  * - WAV: Loaded into memory (fast playback, good for short sounds)
- * - OGG: Streamed from disk (memory efficient, good for long music)
+ * - OGG: Streamed from a memory-mapped file through OggStream (memory efficient, good for long
+ *   music); clips shorter than STREAM_MIN_SECONDS are decoded into memory like WAV
+ * 
+ * Playback goes through AudioMixer: every play() of a Sound starts another voice (overlapping
+ * effects share one device stream), while Music restarts its single streamed voice.
  * 
  * Supports hot-reload: audio files can be reloaded at runtime.
  */
@@ -70,21 +76,25 @@ public:
         Music   // Long tracks (background) - streamed
     };
 
+public:
+    // OGG files at least this long are streamed instead of decoded up front
+    static constexpr float STREAM_MIN_SECONDS = 10.0f;
+
 private:
     std::string m_path;
     AudioType m_type;
     bool m_loaded = false;
     
-    // SDL3 audio data
-    SDL_AudioStream* m_audioStream = nullptr;
-    SDL_AudioDeviceID m_audioDevice = 0;
-    
-    // For Sound type (loaded into memory)
-    std::vector<uint8_t> m_audioData;
+    // For Sound type (loaded into memory, 16-bit at the file's own rate; the mixer resamples)
+    // Shared through AudioClipCache with every other resource loading the same file
+    std::shared_ptr<const AudioClip> m_clip;
     SDL_AudioSpec m_spec;
     
-    // For Music type (streamed)
-    // SDL3 handles streaming internally
+    // For Music type (streamed): decoded on a background thread, pulled by the mixer
+    std::unique_ptr<OggStream> m_oggStream;
+    
+    // Mixer voices started by play() that may still be playing
+    std::vector<AudioMixer::VoiceHandle> m_voices;
     
     /**
      * Detect audio type from file extension
@@ -111,6 +121,12 @@ private:
      */
     void loadWAV(const std::string& filepath) {
 #ifdef SDL3_AUDIO_AVAILABLE
+        // Already decoded by another resource (or before a reload of an unchanged file)
+        if (std::shared_ptr<const AudioClip> cached = AudioClipCache::get_instance().find(filepath)) {
+            setClip(std::move(cached));
+            return;
+        }
+        
         SDL_AudioSpec spec;
         uint8_t* audioBuffer = nullptr;
         uint32_t audioLength = 0;
@@ -119,14 +135,28 @@ private:
             throw std::runtime_error("Failed to load WAV file: " + filepath + " - " + SDL_GetError());
         }
         
-        // Store audio data
-        m_audioData.assign(audioBuffer, audioBuffer + audioLength);
-        m_spec = spec;
+        // Convert to 16-bit (keeping channels and rate) for the mixer
+        SDL_AudioSpec clipSpec = spec;
+        clipSpec.format = SDL_AUDIO_S16;
+        uint8_t* converted = nullptr;
+        int convertedLength = 0;
+        bool ok = SDL_ConvertAudioSamples(&spec, audioBuffer, static_cast<int>(audioLength), &clipSpec,
+                                          &converted, &convertedLength);
         
-        // Free SDL's buffer (we've copied the data)
+        // Free SDL's buffer (we've converted the data)
         SDL_free(audioBuffer);
+        if (!ok) {
+            throw std::runtime_error("Failed to convert WAV file: " + filepath + " - " + SDL_GetError());
+        }
         
-        m_loaded = true;
+        // Store audio data (WAV is cheap to load again, so no .pcm file)
+        AudioClip clip;
+        clip.channels = clipSpec.channels;
+        clip.sampleRate = clipSpec.freq;
+        clip.samples.resize(static_cast<size_t>(convertedLength) / sizeof(int16_t));
+        std::memcpy(clip.samples.data(), converted, clip.samples.size() * sizeof(int16_t));
+        SDL_free(converted);
+        setClip(AudioClipCache::get_instance().insert(filepath, std::move(clip), false));
 #else
         // Stub implementation when SDL3 is not available
         // Just mark as loaded with empty data (allows compilation without SDL3)
@@ -140,45 +170,48 @@ private:
      * @param filepath Path to OGG file
      */
     void loadOGG(const std::string& filepath) {
-#ifdef SDL3_AUDIO_AVAILABLE
-        // Use stb_vorbis to decode OGG file
-        // Read file into memory first, then decode (more reliable than decode_filename)
-        std::ifstream file(filepath, std::ios::binary | std::ios::ate);
-        if (!file.is_open()) {
-            throw std::runtime_error("Failed to open OGG file: " + filepath);
+        // Short clips decoded before (this run, or a previous one through the .pcm file)
+        if (std::shared_ptr<const AudioClip> cached = AudioClipCache::get_instance().find(filepath)) {
+            setClip(std::move(cached));
+            return;
         }
         
-        std::streamsize size = file.tellg();
-        file.seekg(0, std::ios::beg);
-        
-        std::vector<unsigned char> buffer(size);
-        if (!file.read(reinterpret_cast<char*>(buffer.data()), size)) {
-            throw std::runtime_error("Failed to read OGG file: " + filepath);
+        // Map the file and parse the Vorbis headers; nothing is decoded yet
+        std::unique_ptr<OggStream> stream = std::make_unique<OggStream>(filepath);
+        if (stream->getDurationSeconds() >= STREAM_MIN_SECONDS) {
+            setSpec(stream->getChannels(), stream->getSampleRate());
+            m_oggStream = std::move(stream);
+            m_loaded = true;
+            return;
         }
-        file.close();
         
-        // Decode OGG from memory
+        // Short clip: decode it all from the mapped file (no intermediate copy of the file)
         int channels = 0;
         int sample_rate = 0;
         short* output = nullptr;
-        
-        int samples = stb_vorbis_decode_memory(buffer.data(), static_cast<int>(size), &channels, &sample_rate, &output);
-        
+        int samples = stb_vorbis_decode_memory(stream->getFileData(), static_cast<int>(stream->getFileSize()),
+                                               &channels, &sample_rate, &output);
         if (samples < 0 || !output) {
             throw std::runtime_error("Failed to decode OGG file: " + filepath);
         }
         
-        // Convert 16-bit shorts to bytes for SDL3
         // stb_vorbis returns interleaved samples: [L, R, L, R, ...] for stereo
-        int total_samples = samples * channels;
-        m_audioData.resize(total_samples * sizeof(int16_t));
-        std::memcpy(m_audioData.data(), output, total_samples * sizeof(int16_t));
+        AudioClip clip;
+        clip.channels = channels;
+        clip.sampleRate = sample_rate;
+        clip.samples.assign(output, output + static_cast<size_t>(samples) * channels);
         
         // Free stb_vorbis's buffer
         free(output);
-        
-        // Set up SDL audio spec
+        setClip(AudioClipCache::get_instance().insert(filepath, std::move(clip), true));
+    }
+    
+    /**
+     * Describe the loaded audio as 16-bit interleaved PCM
+     */
+    void setSpec(int channels, int sample_rate) {
         // SDL3's AudioSpec only has: freq, format, channels (no silence, samples, size)
+        m_spec = SDL_AudioSpec{};
         m_spec.freq = sample_rate;
         m_spec.channels = static_cast<uint8_t>(channels);
         
@@ -193,13 +226,12 @@ private:
             typedef decltype(m_spec.format) AudioFormatType;
             m_spec.format = static_cast<AudioFormatType>(0x8010);
         #endif
-        
-        m_loaded = true;
-#else
-        // Stub implementation when SDL3 is not available
+    }
+    
+    void setClip(std::shared_ptr<const AudioClip> clip) {
+        setSpec(clip->channels, clip->sampleRate);
+        m_clip = std::move(clip);
         m_loaded = true;
-        m_spec = SDL_AudioSpec{};
-#endif
     }
 
 public:
@@ -233,12 +265,10 @@ public:
         : m_path(std::move(other.m_path)),
           m_type(other.m_type),
           m_loaded(other.m_loaded),
-          m_audioStream(other.m_audioStream),
-          m_audioDevice(other.m_audioDevice),
-          m_audioData(std::move(other.m_audioData)),
-          m_spec(other.m_spec) {
-        other.m_audioStream = nullptr;
-        other.m_audioDevice = 0;
+          m_clip(std::move(other.m_clip)),
+          m_spec(other.m_spec),
+          m_oggStream(std::move(other.m_oggStream)),
+          m_voices(std::move(other.m_voices)) {
         other.m_loaded = false;
     }
     
@@ -250,13 +280,11 @@ public:
             m_path = std::move(other.m_path);
             m_type = other.m_type;
             m_loaded = other.m_loaded;
-            m_audioStream = other.m_audioStream;
-            m_audioDevice = other.m_audioDevice;
-            m_audioData = std::move(other.m_audioData);
+            m_clip = std::move(other.m_clip);
             m_spec = other.m_spec;
+            m_oggStream = std::move(other.m_oggStream);
+            m_voices = std::move(other.m_voices);
             
-            other.m_audioStream = nullptr;
-            other.m_audioDevice = 0;
             other.m_loaded = false;
         }
         return *this;
@@ -273,17 +301,10 @@ public:
      * Cleanup audio resources
      */
     void cleanup() {
-#ifdef SDL3_AUDIO_AVAILABLE
-        if (m_audioStream) {
-            SDL_DestroyAudioStream(m_audioStream);
-            m_audioStream = nullptr;
-        }
-        if (m_audioDevice) {
-            SDL_CloseAudioDevice(m_audioDevice);
-            m_audioDevice = 0;
-        }
-#endif
-        m_audioData.clear();
+        // Voices first, so the mixer can no longer touch the decoder
+        stop();
+        m_oggStream.reset();
+        m_clip.reset();
         m_loaded = false;
     }
     
@@ -293,76 +314,58 @@ public:
      * @return true if playback started successfully
      */
     bool play(bool loop = false) {
-#ifdef SDL3_AUDIO_AVAILABLE
-        if (!m_loaded || m_audioData.empty()) {
+        if (!m_loaded || (!m_clip && !m_oggStream)) {
             std::cerr << "[Audio] Not loaded or empty data" << std::endl;
             return false;
         }
         
-        // Stop any existing playback
-        stop();
-        
-        // Ensure SDL3 is initialized (SDL3 requires SDL_Init() before subsystems)
-        // SDL3 returns 0 on failure, non-zero on success (opposite of SDL2!)
-        // Note: SDL_Init can be called multiple times safely
-        if (SDL_Init(SDL_INIT_AUDIO) == 0) {
-            // Failed to initialize - SDL_GetError() will have details
-            std::cerr << "[Audio] SDL_Init failed: " << SDL_GetError() << std::endl;
+        // Opens the device on first use (no-op afterwards)
+        AudioMixer& mixer = AudioMixer::get_instance();
+        if (!mixer.start()) {
             return false;
         }
         
-        // SDL3 audio API: Use SDL_OpenAudioDeviceStream which combines device and stream creation
-        // This is the recommended way in SDL3
-        SDL_AudioStream* stream = SDL_OpenAudioDeviceStream(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &m_spec, nullptr, nullptr);
-        if (!stream) {
-            // Stream creation failed
-            std::cerr << "[Audio] SDL_OpenAudioDeviceStream failed: " << SDL_GetError() << std::endl;
-            return false;
+        VoiceParams params;
+        params.loop = loop;
+        AudioMixer::VoiceHandle voice = AudioMixer::INVALID_VOICE;
+        if (m_oggStream) {
+            // Streamed: one voice; restart from the beginning
+            stop();
+            m_oggStream->start(loop);
+            voice = mixer.playStream(m_oggStream.get(), params);
+            if (voice == AudioMixer::INVALID_VOICE) {
+                m_oggStream->stop();
+            }
+        } else {
+            // In memory: overlap with earlier plays; forget voices that have finished
+            m_voices.erase(std::remove_if(m_voices.begin(), m_voices.end(),
+                                          [&](AudioMixer::VoiceHandle v) { return !mixer.isPlaying(v); }),
+                           m_voices.end());
+            voice = mixer.play(m_clip, params);
         }
-        
-        // Queue the audio data
-        int result = SDL_PutAudioStreamData(stream, m_audioData.data(), static_cast<int>(m_audioData.size()));
-        if (result < 0) {
-            std::cerr << "[Audio] SDL_PutAudioStreamData failed: " << SDL_GetError() << std::endl;
-            SDL_DestroyAudioStream(stream);
+        if (voice == AudioMixer::INVALID_VOICE) {
+            std::cerr << "[Audio] No free mixer voice for " << m_path << std::endl;
             return false;
         }
-        
-        // Start playback - SDL3 uses SDL_ResumeAudioStreamDevice which takes the stream
-        SDL_ResumeAudioStreamDevice(stream);
-        
-        // Store references for cleanup
-        m_audioStream = stream;
-        m_audioDevice = 0;  // Device is managed by the stream
-        
+        m_voices.push_back(voice);
         return true;
-#else
-        // Stub: return false when SDL3 is not available
-        // This means SDL3 headers weren't found at compile time
-        std::cerr << "[Audio] SDL3_AUDIO_AVAILABLE not defined - SDL3 headers not found" << std::endl;
-        return false;
-#endif
     }
     
     /**
-     * Stop playback
+     * Stop playback (every voice started by play())
      */
     void stop() {
-#ifdef SDL3_AUDIO_AVAILABLE
-        if (m_audioStream) {
-            // Pause the stream device
-            SDL_PauseAudioStreamDevice(m_audioStream);
-            // Destroy the stream (this also closes the associated device)
-            SDL_DestroyAudioStream(m_audioStream);
-            m_audioStream = nullptr;
-            m_audioDevice = 0;
+        if (!m_voices.empty()) {
+            AudioMixer& mixer = AudioMixer::get_instance();
+            for (AudioMixer::VoiceHandle voice : m_voices) {
+                mixer.stop(voice);
+            }
+            m_voices.clear();
         }
-        // Also close device if we have it separately
-        if (m_audioDevice) {
-            SDL_CloseAudioDevice(m_audioDevice);
-            m_audioDevice = 0;
+        // The mixer has let go of the stream; now the decoder thread can stop
+        if (m_oggStream) {
+            m_oggStream->stop();
         }
-#endif
     }
     
     /**
@@ -390,11 +393,33 @@ public:
     }
     
     /**
-     * Get audio data (for direct access)
-     * @return Reference to audio data vector
+     * Get the decoded clip (for direct access or playing through AudioMixer with custom params)
+     * @return Clip, or nullptr for streamed audio
+     */
+    std::shared_ptr<const AudioClip> getClip() const {
+        return m_clip;
+    }
+    
+    /**
+     * Get decoded audio size in bytes (for cache accounting)
+     */
+    size_t getMemorySize() const {
+        return (m_clip ? m_clip->samples.size() * sizeof(int16_t) : 0) + (m_oggStream ? m_oggStream->getMemorySize() : 0);
+    }
+    
+    /**
+     * Check if this audio is streamed (long OGG) rather than held in memory
+     */
+    bool isStreaming() const {
+        return m_oggStream != nullptr;
+    }
+    
+    /**
+     * Get the decoder for streamed audio (underrun stats, finished state)
+     * @return OggStream, or nullptr if not streaming
      */
-    const std::vector<uint8_t>& getAudioData() const {
-        return m_audioData;
+    const OggStream* getStream() const {
+        return m_oggStream.get();
     }
     
     /**
@@ -409,6 +434,8 @@ public:
      * Reload audio file (for hot-reload)
      */
     void reload() {
+        // Hold the current clip so an unchanged file is a cache hit instead of a re-decode
+        std::shared_ptr<const AudioClip> previous = m_clip;
         cleanup();
         
         std::string ext = m_path.substr(m_path.find_last_of(".") + 1);
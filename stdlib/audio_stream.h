@@ -0,0 +1,279 @@
+// EDEN ENGINE - Audio Streaming
+// OGG Vorbis music streamed from a memory-mapped file: a background thread decodes with the
+// stb_vorbis pull API into an SpscRing, and the audio callback drains the ring. Memory is the
+// ring (about half a second of PCM) regardless of track length, and opening only parses headers.
+
+#ifndef EDEN_AUDIO_STREAM_H
+#define EDEN_AUDIO_STREAM_H
+
+#include "spsc_ring.h"
+#include <string>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <algorithm>
+#include <stdexcept>
+
+// Declarations only: the stb_vorbis implementation is compiled where audio_resource.h is included
+#ifndef STB_VORBIS_INCLUDE_STB_VORBIS_H
+#define STB_VORBIS_HEADER_ONLY
+#include "stb_vorbis.h"
+#undef STB_VORBIS_HEADER_ONLY
+#endif
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/**
+ * MappedFile - Read-only memory mapping of a whole file (pages are read in by the OS on demand)
+ */
+class MappedFile {
+private:
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @return false if the file cannot be opened, is empty, or cannot be mapped
+     */
+    bool open(const std::string& path) {
+        close();
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        LARGE_INTEGER size;
+        HANDLE mapping = nullptr;
+        if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+            mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        }
+        if (mapping) {
+            m_data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            m_size = m_data ? static_cast<size_t>(size.QuadPart) : 0;
+            CloseHandle(mapping);   // The view keeps the mapping alive
+        }
+        CloseHandle(file);
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat fileStat;
+        if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0) {
+            void* data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED) {
+                madvise(data, static_cast<size_t>(fileStat.st_size), MADV_SEQUENTIAL);
+                m_data = static_cast<const uint8_t*>(data);
+                m_size = static_cast<size_t>(fileStat.st_size);
+            }
+        }
+        ::close(fd);                // The mapping outlives the descriptor
+#endif
+        return m_data != nullptr;
+    }
+
+    void close() {
+        if (m_data) {
+#ifdef _WIN32
+            UnmapViewOfFile(m_data);
+#else
+            munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+        }
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    const uint8_t* data() const { return m_data; }
+    size_t size() const { return m_size; }
+};
+
+/**
+ * OggStream - Incremental OGG Vorbis decode into a lock-free ring
+ *
+ * start() decodes a little up front (so playback does not begin with an underrun) and then
+ * keeps the ring topped up from a background thread. read() is real-time safe: it only copies
+ * out of the ring, never locks, allocates or decodes. Looping seeks back to the first sample on
+ * the decoder thread, so the loop point is gapless.
+ *
+ * Usage:
+ *   OggStream music("audio/theme.ogg");
+ *   music.start(true);                          // Loop
+ *   music.read(out, frames);                    // From the audio callback
+ *   music.stop();
+ */
+class OggStream {
+public:
+    static constexpr size_t DECODE_CHUNK = 4096;       // Samples (not frames) per decode call
+
+private:
+    std::string m_path;
+    MappedFile m_file;
+    stb_vorbis* m_vorbis = nullptr;
+    int m_channels = 0;
+    int m_sampleRate = 0;
+    uint32_t m_totalFrames = 0;
+
+    std::unique_ptr<SpscRing<int16_t>> m_ring;     // Sized once the channel count and rate are known
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+    std::atomic<bool> m_looping{false};
+    std::atomic<bool> m_decodeFinished{false};     // Reached the end without looping
+    std::atomic<uint64_t> m_underruns{0};
+
+    // Decode one chunk into the ring; false at the end of a non-looping stream
+    bool decodeChunk(int16_t* chunk) {
+        int frames = stb_vorbis_get_samples_short_interleaved(m_vorbis, m_channels, chunk, DECODE_CHUNK);
+        if (frames == 0) {
+            if (!m_looping.load(std::memory_order_relaxed) || !stb_vorbis_seek_start(m_vorbis)) {
+                return false;
+            }
+            frames = stb_vorbis_get_samples_short_interleaved(m_vorbis, m_channels, chunk, DECODE_CHUNK);
+            if (frames == 0) {
+                return false;
+            }
+        }
+        m_ring->write(chunk, static_cast<size_t>(frames) * m_channels);
+        return true;
+    }
+
+    void decodeLoop() {
+        int16_t chunk[DECODE_CHUNK];
+        while (m_running.load(std::memory_order_relaxed)) {
+            // Only decode when a whole chunk fits, so the ring always holds whole frames
+            if (m_ring->writeAvailable() < DECODE_CHUNK) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                continue;
+            }
+            if (!decodeChunk(chunk)) {
+                m_decodeFinished = true;
+                return;
+            }
+        }
+    }
+
+public:
+    /**
+     * Map the file and parse the Vorbis headers (no audio is decoded yet)
+     * @param bufferSeconds Decoded audio kept ahead of playback
+     * @throws std::runtime_error if the file cannot be mapped or is not OGG Vorbis
+     */
+    explicit OggStream(const std::string& path, float bufferSeconds = 0.5f)
+        : m_path(path) {
+        if (!m_file.open(path)) {
+            throw std::runtime_error("Failed to open OGG file: " + path);
+        }
+        int error = 0;
+        m_vorbis = stb_vorbis_open_memory(m_file.data(), static_cast<int>(m_file.size()), &error, nullptr);
+        if (!m_vorbis) {
+            throw std::runtime_error("Failed to decode OGG file: " + path + " (stb_vorbis error " +
+                                     std::to_string(error) + ")");
+        }
+        stb_vorbis_info info = stb_vorbis_get_info(m_vorbis);
+        m_channels = info.channels;
+        m_sampleRate = static_cast<int>(info.sample_rate);
+        m_totalFrames = stb_vorbis_stream_length_in_samples(m_vorbis);
+
+        size_t bufferSamples = static_cast<size_t>(bufferSeconds * m_sampleRate) * m_channels;
+        m_ring = std::make_unique<SpscRing<int16_t>>(std::max(bufferSamples, DECODE_CHUNK * 2));
+    }
+
+    ~OggStream() {
+        stop();
+        if (m_vorbis) {
+            stb_vorbis_close(m_vorbis);
+        }
+    }
+
+    OggStream(const OggStream&) = delete;
+    OggStream& operator=(const OggStream&) = delete;
+
+    /**
+     * (Re)start from the beginning. Call while nothing is reading (e.g. before the audio stream
+     * is resumed).
+     */
+    void start(bool loop) {
+        stop();
+        stb_vorbis_seek_start(m_vorbis);
+        m_ring->reset();
+        m_looping = loop;
+        m_decodeFinished = false;
+        m_underruns = 0;
+
+        // Prefill a quarter of the ring so the first callbacks have data
+        int16_t chunk[DECODE_CHUNK];
+        while (m_ring->writeAvailable() > m_ring->getCapacity() * 3 / 4) {
+            if (!decodeChunk(chunk)) {
+                m_decodeFinished = true;
+                return;
+            }
+        }
+        m_running = true;
+        m_thread = std::thread(&OggStream::decodeLoop, this);
+    }
+
+    /**
+     * Stop the decoder thread (the ring keeps what was decoded)
+     */
+    void stop() {
+        m_running = false;
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+
+    /**
+     * Copy up to `frames` interleaved 16-bit frames out of the ring (real-time safe)
+     * @return Frames copied; fewer than asked is an underrun unless the stream has finished
+     */
+    size_t read(int16_t* out, size_t frames) {
+        size_t samples = m_ring->read(out, frames * m_channels);
+        if (samples < frames * m_channels && !m_decodeFinished.load(std::memory_order_relaxed)) {
+            m_underruns.fetch_add(1, std::memory_order_relaxed);
+        }
+        return samples / m_channels;
+    }
+
+    void setLooping(bool loop) { m_looping = loop; }
+
+    // Decoding has ended (non-looping) and everything decoded has been read
+    bool isFinished() const {
+        return m_decodeFinished.load(std::memory_order_acquire) && m_ring->readAvailable() == 0;
+    }
+
+    int getChannels() const { return m_channels; }
+    int getSampleRate() const { return m_sampleRate; }
+    uint32_t getTotalFrames() const { return m_totalFrames; }
+    float getDurationSeconds() const { return m_sampleRate ? static_cast<float>(m_totalFrames) / m_sampleRate : 0.0f; }
+    uint64_t getUnderrunCount() const { return m_underruns.load(std::memory_order_relaxed); }
+    const std::string& getPath() const { return m_path; }
+    const uint8_t* getFileData() const { return m_file.data(); }
+    size_t getFileSize() const { return m_file.size(); }
+
+    // Heap memory held for decoded audio (the mapped file is backed by the page cache)
+    size_t getMemorySize() const { return m_ring->getCapacity() * sizeof(int16_t); }
+};
+
+#endif // EDEN_AUDIO_STREAM_H
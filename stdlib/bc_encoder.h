@@ -0,0 +1,917 @@
+// EDEN ENGINE - BC Block Encoder
+// CPU transcoder from RGBA8 (decoded PNG) to GPU block-compressed formats: BC1, BC3, BC5, BC7
+// Results are cached as .dds files keyed by the PNG's content, so later loads take the DDS fast path
+
+#ifndef EDEN_BC_ENCODER_H
+#define EDEN_BC_ENCODER_H
+
+#include "vulkan.h"
+#include "dds_loader.h"
+#include "png_loader.h"
+#include "mip_builder.h"
+#include <vector>
+#include <string>
+#include <fstream>
+#include <thread>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EDEN_BC_SSE2 1
+#include <emmintrin.h>
+#endif
+
+enum class BCFormat {
+    BC1,        // RGB, 4 bpp (opaque)
+    BC3,        // RGBA, 8 bpp (BC1 color + BC4 alpha)
+    BC5,        // RG, 8 bpp (two BC4 channels) - tangent-space normal maps
+    BC7         // RGBA, 8 bpp, highest quality (mode 6 blocks)
+};
+
+enum class BCQuality {
+    Fast,       // One endpoint fit per block
+    Quality     // Least-squares endpoint refinement, exhaustive p-bit / endpoint search
+};
+
+// ---- Block fetch ------------------------------------------------------------
+
+// 4x4 block as structure-of-arrays floats (0..255), edge pixels replicated past the image
+struct BCBlock {
+    alignas(16) float c[4][16];   // c[channel][pixel]
+};
+
+static void fetchBCBlock(const uint8_t* rgba, uint32_t width, uint32_t height,
+                         uint32_t blockX, uint32_t blockY, BCBlock& block) {
+    for (uint32_t y = 0; y < 4; y++) {
+        uint32_t sy = std::min(blockY * 4 + y, height - 1);
+        for (uint32_t x = 0; x < 4; x++) {
+            uint32_t sx = std::min(blockX * 4 + x, width - 1);
+            const uint8_t* p = rgba + (static_cast<size_t>(sy) * width + sx) * 4;
+            for (int ch = 0; ch < 4; ch++) {
+                block.c[ch][y * 4 + x] = p[ch];
+            }
+        }
+    }
+}
+
+// ---- Shared helpers ---------------------------------------------------------
+
+// Principal axis of the block's colors over `channels` channels (power iteration on the covariance)
+static void bcPrincipalAxis(const BCBlock& block, int channels, float mean[4], float axis[4]) {
+    float cov[4][4] = {};
+    for (int ch = 0; ch < channels; ch++) {
+        float sum = 0.0f;
+        for (int i = 0; i < 16; i++) sum += block.c[ch][i];
+        mean[ch] = sum / 16.0f;
+    }
+    for (int i = 0; i < 16; i++) {
+        float d[4];
+        for (int ch = 0; ch < channels; ch++) d[ch] = block.c[ch][i] - mean[ch];
+        for (int a = 0; a < channels; a++) {
+            for (int b = a; b < channels; b++) cov[a][b] += d[a] * d[b];
+        }
+    }
+    for (int a = 0; a < channels; a++) {
+        for (int b = 0; b < a; b++) cov[a][b] = cov[b][a];
+    }
+
+    // Start from the channel with the widest spread
+    int widest = 0;
+    for (int ch = 1; ch < channels; ch++) {
+        if (cov[ch][ch] > cov[widest][widest]) widest = ch;
+    }
+    float v[4] = {};
+    for (int ch = 0; ch < channels; ch++) v[ch] = cov[widest][ch];
+    for (int iteration = 0; iteration < 8; iteration++) {
+        float next[4] = {};
+        float length = 0.0f;
+        for (int a = 0; a < channels; a++) {
+            for (int b = 0; b < channels; b++) next[a] += cov[a][b] * v[b];
+            length = std::max(length, std::fabs(next[a]));
+        }
+        if (length <= 0.0f) break;
+        for (int ch = 0; ch < channels; ch++) v[ch] = next[ch] / length;
+    }
+    float length = 0.0f;
+    for (int ch = 0; ch < channels; ch++) length += v[ch] * v[ch];
+    length = std::sqrt(length);
+    for (int ch = 0; ch < 4; ch++) {
+        axis[ch] = (ch < channels && length > 0.0f) ? v[ch] / length : 0.0f;
+    }
+}
+
+// Endpoints at the extreme projections of the block onto its principal axis
+static void bcFitEndpoints(const BCBlock& block, int channels, float e0[4], float e1[4]) {
+    float mean[4] = {}, axis[4];
+    bcPrincipalAxis(block, channels, mean, axis);
+    float tMin = 1e30f, tMax = -1e30f;
+    for (int i = 0; i < 16; i++) {
+        float t = 0.0f;
+        for (int ch = 0; ch < channels; ch++) t += (block.c[ch][i] - mean[ch]) * axis[ch];
+        tMin = std::min(tMin, t);
+        tMax = std::max(tMax, t);
+    }
+    for (int ch = 0; ch < 4; ch++) {
+        e0[ch] = ch < channels ? std::min(255.0f, std::max(0.0f, mean[ch] + tMin * axis[ch])) : 255.0f;
+        e1[ch] = ch < channels ? std::min(255.0f, std::max(0.0f, mean[ch] + tMax * axis[ch])) : 255.0f;
+    }
+}
+
+/**
+ * Nearest palette step for every pixel by projecting onto the e0->e1 segment
+ * (4 pixels per SSE2 iteration). Steps are 0..maxStep, evenly spaced along the segment.
+ */
+static void bcProjectSteps(const BCBlock& block, int channels, const float e0[4], const float e1[4],
+                           int maxStep, int steps[16]) {
+    float axis[4] = {}, length2 = 0.0f;
+    for (int ch = 0; ch < channels; ch++) {
+        axis[ch] = e1[ch] - e0[ch];
+        length2 += axis[ch] * axis[ch];
+    }
+    if (length2 <= 0.0f) {
+        for (int i = 0; i < 16; i++) steps[i] = 0;
+        return;
+    }
+    float scale = maxStep / length2;
+#ifdef EDEN_BC_SSE2
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 top = _mm_set1_ps(static_cast<float>(maxStep));
+    const __m128 half = _mm_set1_ps(0.5f);
+    for (int i = 0; i < 16; i += 4) {
+        __m128 t = _mm_setzero_ps();
+        for (int ch = 0; ch < channels; ch++) {
+            __m128 d = _mm_sub_ps(_mm_load_ps(block.c[ch] + i), _mm_set1_ps(e0[ch]));
+            t = _mm_add_ps(t, _mm_mul_ps(d, _mm_set1_ps(axis[ch] * scale)));
+        }
+        t = _mm_min_ps(_mm_max_ps(_mm_add_ps(t, half), zero), _mm_add_ps(top, _mm_set1_ps(0.49f)));
+        alignas(16) int32_t lanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), _mm_cvttps_epi32(t));
+        for (int k = 0; k < 4; k++) steps[i + k] = lanes[k];
+    }
+#else
+    for (int i = 0; i < 16; i++) {
+        float t = 0.0f;
+        for (int ch = 0; ch < channels; ch++) t += (block.c[ch][i] - e0[ch]) * axis[ch] * scale;
+        steps[i] = std::min(maxStep, std::max(0, static_cast<int>(t + 0.5f)));
+    }
+#endif
+}
+
+// Least-squares endpoints for fixed per-pixel interpolation weights (0..1 from e0 to e1)
+static bool bcLeastSquares(const BCBlock& block, int channels, const float weights[16], float e0[4], float e1[4]) {
+    float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+    float ax[4] = {}, bx[4] = {};
+    for (int i = 0; i < 16; i++) {
+        float b = weights[i], a = 1.0f - b;
+        aa += a * a;
+        ab += a * b;
+        bb += b * b;
+        for (int ch = 0; ch < channels; ch++) {
+            ax[ch] += a * block.c[ch][i];
+            bx[ch] += b * block.c[ch][i];
+        }
+    }
+    float det = aa * bb - ab * ab;
+    if (std::fabs(det) < 1e-6f) {
+        return false;
+    }
+    for (int ch = 0; ch < channels; ch++) {
+        e0[ch] = std::min(255.0f, std::max(0.0f, (ax[ch] * bb - bx[ch] * ab) / det));
+        e1[ch] = std::min(255.0f, std::max(0.0f, (bx[ch] * aa - ax[ch] * ab) / det));
+    }
+    return true;
+}
+
+// 128-bit little-endian bit writer/reader for block packing
+struct BCBits {
+    uint64_t word[2] = {0, 0};
+    int position = 0;
+
+    void write(uint32_t value, int bits) {
+        for (int i = 0; i < bits; i++, position++) {
+            if ((value >> i) & 1) word[position >> 6] |= 1ull << (position & 63);
+        }
+    }
+    uint32_t read(int bits) {
+        uint32_t value = 0;
+        for (int i = 0; i < bits; i++, position++) {
+            value |= static_cast<uint32_t>((word[position >> 6] >> (position & 63)) & 1) << i;
+        }
+        return value;
+    }
+};
+
+// ---- BC1 --------------------------------------------------------------------
+
+static uint16_t bcPack565(const float c[4]) {
+    int r = std::min(31, std::max(0, static_cast<int>(c[0] * 31.0f / 255.0f + 0.5f)));
+    int g = std::min(63, std::max(0, static_cast<int>(c[1] * 63.0f / 255.0f + 0.5f)));
+    int b = std::min(31, std::max(0, static_cast<int>(c[2] * 31.0f / 255.0f + 0.5f)));
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+static void bcUnpack565(uint16_t c, int out[3]) {
+    int r = (c >> 11) & 31, g = (c >> 5) & 63, b = c & 31;
+    out[0] = (r << 3) | (r >> 2);
+    out[1] = (g << 2) | (g >> 4);
+    out[2] = (b << 3) | (b >> 2);
+}
+
+// Four-color BC1 palette (c0 > c1 ordering)
+static void bcBC1Palette(uint16_t c0, uint16_t c1, int palette[4][3]) {
+    bcUnpack565(c0, palette[0]);
+    bcUnpack565(c1, palette[1]);
+    for (int ch = 0; ch < 3; ch++) {
+        palette[2][ch] = (2 * palette[0][ch] + palette[1][ch]) / 3;
+        palette[3][ch] = (palette[0][ch] + 2 * palette[1][ch]) / 3;
+    }
+}
+
+// Indices for a quantized endpoint pair; returns the block's squared error
+static float bcBC1Indices(const BCBlock& block, uint16_t c0, uint16_t c1, bool refine, uint32_t& indices) {
+    static const int stepToIndex[4] = {0, 2, 3, 1};
+    int palette[4][3];
+    bcBC1Palette(c0, c1, palette);
+    float p0[4] = {float(palette[0][0]), float(palette[0][1]), float(palette[0][2]), 0.0f};
+    float p1[4] = {float(palette[1][0]), float(palette[1][1]), float(palette[1][2]), 0.0f};
+    int steps[16];
+    bcProjectSteps(block, 3, p0, p1, 3, steps);
+
+    float total = 0.0f;
+    indices = 0;
+    for (int i = 0; i < 16; i++) {
+        int best = steps[i];
+        float bestError = 1e30f;
+        int first = refine ? std::max(0, steps[i] - 1) : steps[i];
+        int last = refine ? std::min(3, steps[i] + 1) : steps[i];
+        for (int s = first; s <= last; s++) {
+            const int* p = palette[stepToIndex[s]];
+            float error = 0.0f;
+            for (int ch = 0; ch < 3; ch++) {
+                float d = block.c[ch][i] - p[ch];
+                error += d * d;
+            }
+            if (error < bestError) {
+                bestError = error;
+                best = s;
+            }
+        }
+        total += bestError;
+        indices |= static_cast<uint32_t>(stepToIndex[best]) << (i * 2);
+    }
+    return total;
+}
+
+static float bcEncodeBC1Color(const BCBlock& block, BCQuality quality, uint8_t out[8]) {
+    float e0[4], e1[4];
+    bcFitEndpoints(block, 3, e0, e1);
+
+    if (quality == BCQuality::Fast) {
+        // Inset the endpoints slightly: the palette ends rarely coincide with outliers
+        for (int ch = 0; ch < 3; ch++) {
+            float inset = (e1[ch] - e0[ch]) / 16.0f;
+            e0[ch] += inset;
+            e1[ch] -= inset;
+        }
+    }
+
+    // Higher endpoint first selects the four-color mode
+    uint16_t c0 = bcPack565(e1), c1 = bcPack565(e0);
+    if (c0 < c1) std::swap(c0, c1);
+    uint32_t indices = 0;
+    float error = 0.0f;
+    if (c0 == c1) {
+        error = bcBC1Indices(block, c0, c1, false, indices);
+        indices = 0;
+    } else {
+        error = bcBC1Indices(block, c0, c1, quality == BCQuality::Quality, indices);
+    }
+
+    if (quality == BCQuality::Quality) {
+        static const float stepWeights[4] = {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};   // By index
+        for (int iteration = 0; iteration < 2 && c0 != c1; iteration++) {
+            float weights[16];
+            for (int i = 0; i < 16; i++) weights[i] = stepWeights[(indices >> (i * 2)) & 3];
+            float a[4], b[4];
+            if (!bcLeastSquares(block, 3, weights, a, b)) break;
+            uint16_t n0 = bcPack565(a), n1 = bcPack565(b);
+            if (n0 < n1) std::swap(n0, n1);
+            if (n0 == n1) break;
+            uint32_t candidate;
+            float candidateError = bcBC1Indices(block, n0, n1, true, candidate);
+            if (candidateError >= error) break;
+            c0 = n0;
+            c1 = n1;
+            indices = candidate;
+            error = candidateError;
+        }
+    }
+
+    out[0] = static_cast<uint8_t>(c0 & 0xFF);
+    out[1] = static_cast<uint8_t>(c0 >> 8);
+    out[2] = static_cast<uint8_t>(c1 & 0xFF);
+    out[3] = static_cast<uint8_t>(c1 >> 8);
+    for (int i = 0; i < 4; i++) out[4 + i] = static_cast<uint8_t>(indices >> (i * 8));
+    return error;
+}
+
+// ---- BC4 (single channel; BC3 alpha, BC5 red/green) --------------------------
+
+static void bcBC4Palette(int a0, int a1, int palette[8]) {
+    palette[0] = a0;
+    palette[1] = a1;
+    if (a0 > a1) {
+        for (int i = 2; i < 8; i++) palette[i] = ((8 - i) * a0 + (i - 1) * a1) / 7;
+    } else {
+        for (int i = 2; i < 6; i++) palette[i] = ((6 - i) * a0 + (i - 1) * a1) / 5;
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+}
+
+static float bcBC4Indices(const float values[16], int a0, int a1, uint64_t& indices) {
+    int palette[8];
+    bcBC4Palette(a0, a1, palette);
+    float total = 0.0f;
+    indices = 0;
+    for (int i = 0; i < 16; i++) {
+        int best = 0;
+        float bestError = 1e30f;
+        for (int k = 0; k < 8; k++) {
+            float d = values[i] - palette[k];
+            if (d * d < bestError) {
+                bestError = d * d;
+                best = k;
+            }
+        }
+        total += bestError;
+        indices |= static_cast<uint64_t>(best) << (i * 3);
+    }
+    return total;
+}
+
+static float bcEncodeBC4(const float values[16], BCQuality quality, uint8_t out[8]) {
+    float lo = 255.0f, hi = 0.0f;
+    for (int i = 0; i < 16; i++) {
+        lo = std::min(lo, values[i]);
+        hi = std::max(hi, values[i]);
+    }
+    int a0 = static_cast<int>(hi + 0.5f), a1 = static_cast<int>(lo + 0.5f);
+    uint64_t indices = 0;
+    float error;
+    if (a0 == a1) {
+        error = bcBC4Indices(values, a0, a1, indices);
+    } else {
+        error = bcBC4Indices(values, a0, a1, indices);
+        if (quality == BCQuality::Quality) {
+            // Pull the endpoints in a little: interpolated steps often land closer to the data
+            int bestA0 = a0, bestA1 = a1;
+            for (int d0 = 0; d0 <= 4; d0++) {
+                for (int d1 = 0; d1 <= 4; d1++) {
+                    int c0 = a0 - d0, c1 = a1 + d1;
+                    if (c0 <= c1 || (d0 == 0 && d1 == 0)) continue;
+                    uint64_t candidate;
+                    float candidateError = bcBC4Indices(values, c0, c1, candidate);
+                    if (candidateError < error) {
+                        error = candidateError;
+                        indices = candidate;
+                        bestA0 = c0;
+                        bestA1 = c1;
+                    }
+                }
+            }
+            a0 = bestA0;
+            a1 = bestA1;
+        }
+    }
+    out[0] = static_cast<uint8_t>(a0);
+    out[1] = static_cast<uint8_t>(a1);
+    for (int i = 0; i < 6; i++) out[2 + i] = static_cast<uint8_t>(indices >> (i * 8));
+    return error;
+}
+
+// ---- BC7 (mode 6: one subset, RGBA 7.7.7.7 + p-bit endpoints, 4-bit indices) ----
+
+static const int BC7_WEIGHTS4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+// Quantize an endpoint to 7 bits per channel with a shared p-bit; returns the decoded 8-bit color
+static void bcQuantizeMode6(const float e[4], int pbit, int q[4], int decoded[4]) {
+    for (int ch = 0; ch < 4; ch++) {
+        q[ch] = std::min(127, std::max(0, static_cast<int>((e[ch] - pbit) / 2.0f + 0.5f)));
+        decoded[ch] = (q[ch] << 1) | pbit;
+    }
+}
+
+static float bcMode6Indices(const BCBlock& block, const int d0[4], const int d1[4], bool refine, int indices[16]) {
+    float p0[4] = {float(d0[0]), float(d0[1]), float(d0[2]), float(d0[3])};
+    float p1[4] = {float(d1[0]), float(d1[1]), float(d1[2]), float(d1[3])};
+    bcProjectSteps(block, 4, p0, p1, 15, indices);
+
+    float total = 0.0f;
+    for (int i = 0; i < 16; i++) {
+        int first = refine ? std::max(0, indices[i] - 1) : indices[i];
+        int last = refine ? std::min(15, indices[i] + 1) : indices[i];
+        float bestError = 1e30f;
+        for (int s = first; s <= last; s++) {
+            float error = 0.0f;
+            for (int ch = 0; ch < 4; ch++) {
+                int value = ((64 - BC7_WEIGHTS4[s]) * d0[ch] + BC7_WEIGHTS4[s] * d1[ch] + 32) >> 6;
+                float d = block.c[ch][i] - value;
+                error += d * d;
+            }
+            if (error < bestError) {
+                bestError = error;
+                indices[i] = s;
+            }
+        }
+        total += bestError;
+    }
+    return total;
+}
+
+struct BCMode6Candidate {
+    int q0[4], q1[4];
+    int p0, p1;
+    int indices[16];
+    float error = 1e30f;
+};
+
+// Best p-bits for a float endpoint pair (Fast: per endpoint by quantization error; Quality: all four pairs)
+static void bcMode6Evaluate(const BCBlock& block, const float e0[4], const float e1[4], BCQuality quality,
+                            BCMode6Candidate& best) {
+    auto quantError = [](const float e[4], int pbit) {
+        int q[4], d[4];
+        bcQuantizeMode6(e, pbit, q, d);
+        float error = 0.0f;
+        for (int ch = 0; ch < 4; ch++) error += (e[ch] - d[ch]) * (e[ch] - d[ch]);
+        return error;
+    };
+
+    for (int p0 = 0; p0 < 2; p0++) {
+        for (int p1 = 0; p1 < 2; p1++) {
+            if (quality == BCQuality::Fast) {
+                int bestP0 = quantError(e0, 0) <= quantError(e0, 1) ? 0 : 1;
+                int bestP1 = quantError(e1, 0) <= quantError(e1, 1) ? 0 : 1;
+                if (p0 != bestP0 || p1 != bestP1) continue;
+            }
+            BCMode6Candidate candidate;
+            int d0[4], d1[4];
+            bcQuantizeMode6(e0, p0, candidate.q0, d0);
+            bcQuantizeMode6(e1, p1, candidate.q1, d1);
+            candidate.p0 = p0;
+            candidate.p1 = p1;
+            candidate.error = bcMode6Indices(block, d0, d1, quality == BCQuality::Quality, candidate.indices);
+            if (candidate.error < best.error) {
+                best = candidate;
+            }
+        }
+    }
+}
+
+static float bcEncodeBC7(const BCBlock& block, BCQuality quality, uint8_t out[16]) {
+    float e0[4], e1[4];
+    bcFitEndpoints(block, 4, e0, e1);
+
+    BCMode6Candidate best;
+    bcMode6Evaluate(block, e0, e1, quality, best);
+
+    if (quality == BCQuality::Quality) {
+        for (int iteration = 0; iteration < 3; iteration++) {
+            float weights[16];
+            for (int i = 0; i < 16; i++) weights[i] = BC7_WEIGHTS4[best.indices[i]] / 64.0f;
+            float a[4], b[4];
+            if (!bcLeastSquares(block, 4, weights, a, b)) break;
+            BCMode6Candidate refined = best;
+            refined.error = 1e30f;
+            bcMode6Evaluate(block, a, b, quality, refined);
+            if (refined.error >= best.error) break;
+            best = refined;
+        }
+    }
+
+    // The anchor (pixel 0) index must have its top bit clear: swap endpoints if not
+    if (best.indices[0] & 8) {
+        std::swap(best.q0, best.q1);
+        std::swap(best.p0, best.p1);
+        for (int i = 0; i < 16; i++) best.indices[i] = 15 - best.indices[i];
+    }
+
+    BCBits bits;
+    bits.write(1u << 6, 7);                     // Mode 6
+    for (int ch = 0; ch < 4; ch++) {
+        bits.write(best.q0[ch], 7);
+        bits.write(best.q1[ch], 7);
+    }
+    bits.write(best.p0, 1);
+    bits.write(best.p1, 1);
+    bits.write(best.indices[0], 3);
+    for (int i = 1; i < 16; i++) bits.write(best.indices[i], 4);
+    memcpy(out, bits.word, 16);
+    return best.error;
+}
+
+// ---- Block dispatch -----------------------------------------------------------
+
+inline uint32_t bc_block_bytes(BCFormat format) {
+    return format == BCFormat::BC1 ? 8 : 16;
+}
+
+inline VkFormat bc_vk_format(BCFormat format, bool srgb) {
+    switch (format) {
+        case BCFormat::BC1: return srgb ? VK_FORMAT_BC1_RGB_SRGB_BLOCK : VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+        case BCFormat::BC3: return srgb ? VK_FORMAT_BC3_SRGB_BLOCK : VK_FORMAT_BC3_UNORM_BLOCK;
+        case BCFormat::BC5: return VK_FORMAT_BC5_UNORM_BLOCK;
+        case BCFormat::BC7: return srgb ? VK_FORMAT_BC7_SRGB_BLOCK : VK_FORMAT_BC7_UNORM_BLOCK;
+    }
+    return VK_FORMAT_UNDEFINED;
+}
+
+static void encodeBCBlock(const BCBlock& block, BCFormat format, BCQuality quality, uint8_t* out) {
+    switch (format) {
+        case BCFormat::BC1:
+            bcEncodeBC1Color(block, quality, out);
+            break;
+        case BCFormat::BC3:
+            bcEncodeBC4(block.c[3], quality, out);
+            bcEncodeBC1Color(block, quality, out + 8);
+            break;
+        case BCFormat::BC5:
+            bcEncodeBC4(block.c[0], quality, out);
+            bcEncodeBC4(block.c[1], quality, out + 8);
+            break;
+        case BCFormat::BC7:
+            bcEncodeBC7(block, quality, out);
+            break;
+    }
+}
+
+static void encodeBCBlockRows(const uint8_t* rgba, uint32_t width, uint32_t height, BCFormat format,
+                              BCQuality quality, uint32_t rowBegin, uint32_t rowEnd, uint8_t* out) {
+    uint32_t blocksWide = (width + 3) / 4;
+    uint32_t blockBytes = bc_block_bytes(format);
+    BCBlock block;
+    for (uint32_t by = rowBegin; by < rowEnd; by++) {
+        for (uint32_t bx = 0; bx < blocksWide; bx++) {
+            fetchBCBlock(rgba, width, height, bx, by, block);
+            encodeBCBlock(block, format, quality, out + (static_cast<size_t>(by) * blocksWide + bx) * blockBytes);
+        }
+    }
+}
+
+/**
+ * Compress one RGBA8 image level to BC blocks (row-major 4x4 blocks, edges replicated)
+ * @param threadCount Worker threads (0 = hardware concurrency); block rows are split between them
+ */
+inline std::vector<uint8_t> encode_bc_image(const uint8_t* rgba, uint32_t width, uint32_t height,
+                                            BCFormat format, BCQuality quality, uint32_t threadCount = 0) {
+    uint32_t blocksWide = (width + 3) / 4;
+    uint32_t blocksHigh = (height + 3) / 4;
+    std::vector<uint8_t> blocks(static_cast<size_t>(blocksWide) * blocksHigh * bc_block_bytes(format));
+
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    const uint32_t MIN_BLOCKS_PER_THREAD = 1024;
+    uint32_t workers = static_cast<uint32_t>(std::min<uint64_t>(
+        {threadCount, static_cast<uint64_t>(blocksWide) * blocksHigh / MIN_BLOCKS_PER_THREAD, blocksHigh}));
+    if (workers <= 1) {
+        encodeBCBlockRows(rgba, width, height, format, quality, 0, blocksHigh, blocks.data());
+        return blocks;
+    }
+
+    std::vector<std::thread> threads;
+    uint32_t rowsPerWorker = (blocksHigh + workers - 1) / workers;
+    for (uint32_t i = 0; i < workers; i++) {
+        uint32_t begin = i * rowsPerWorker;
+        uint32_t end = std::min(blocksHigh, begin + rowsPerWorker);
+        if (begin >= end) break;
+        threads.emplace_back(encodeBCBlockRows, rgba, width, height, format, quality, begin, end, blocks.data());
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    return blocks;
+}
+
+// ---- Decoding (for quality measurement) ----------------------------------------
+
+static void bcDecodeBC1(const uint8_t* in, uint8_t out[64], bool alphaFromColorBlock) {
+    uint16_t c0 = static_cast<uint16_t>(in[0] | (in[1] << 8));
+    uint16_t c1 = static_cast<uint16_t>(in[2] | (in[3] << 8));
+    int palette[4][3];
+    bcBC1Palette(c0, c1, palette);
+    bool threeColor = alphaFromColorBlock && c0 <= c1;
+    if (threeColor) {
+        for (int ch = 0; ch < 3; ch++) {
+            palette[2][ch] = (palette[0][ch] + palette[1][ch]) / 2;
+            palette[3][ch] = 0;
+        }
+    }
+    uint32_t indices = in[4] | (in[5] << 8) | (in[6] << 16) | (static_cast<uint32_t>(in[7]) << 24);
+    for (int i = 0; i < 16; i++) {
+        int index = (indices >> (i * 2)) & 3;
+        for (int ch = 0; ch < 3; ch++) out[i * 4 + ch] = static_cast<uint8_t>(palette[index][ch]);
+        out[i * 4 + 3] = (threeColor && index == 3) ? 0 : 255;
+    }
+}
+
+static void bcDecodeBC4(const uint8_t* in, uint8_t* out, int stride) {
+    int palette[8];
+    bcBC4Palette(in[0], in[1], palette);
+    uint64_t indices = 0;
+    for (int i = 0; i < 6; i++) indices |= static_cast<uint64_t>(in[2 + i]) << (i * 8);
+    for (int i = 0; i < 16; i++) {
+        out[i * stride] = static_cast<uint8_t>(palette[(indices >> (i * 3)) & 7]);
+    }
+}
+
+// Decodes mode 6 (what bcEncodeBC7 emits); other modes decode as zero and return false
+static bool bcDecodeBC7(const uint8_t* in, uint8_t out[64]) {
+    BCBits bits;
+    memcpy(bits.word, in, 16);
+    if (bits.read(7) != (1u << 6)) {
+        memset(out, 0, 64);
+        return false;
+    }
+    int q0[4], q1[4];
+    for (int ch = 0; ch < 4; ch++) {
+        q0[ch] = bits.read(7);
+        q1[ch] = bits.read(7);
+    }
+    int p0 = bits.read(1), p1 = bits.read(1);
+    for (int i = 0; i < 16; i++) {
+        int index = bits.read(i == 0 ? 3 : 4);
+        for (int ch = 0; ch < 4; ch++) {
+            int e0 = (q0[ch] << 1) | p0, e1 = (q1[ch] << 1) | p1;
+            out[i * 4 + ch] = static_cast<uint8_t>(((64 - BC7_WEIGHTS4[index]) * e0 + BC7_WEIGHTS4[index] * e1 + 32) >> 6);
+        }
+    }
+    return true;
+}
+
+/**
+ * Decode BC blocks back to RGBA8 (BC5 decodes to R, G, 0, 255)
+ */
+inline std::vector<uint8_t> decode_bc_image(const uint8_t* blocks, uint32_t width, uint32_t height, BCFormat format) {
+    std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+    uint32_t blocksWide = (width + 3) / 4;
+    uint32_t blocksHigh = (height + 3) / 4;
+    uint32_t blockBytes = bc_block_bytes(format);
+    uint8_t pixels[64];
+    for (uint32_t by = 0; by < blocksHigh; by++) {
+        for (uint32_t bx = 0; bx < blocksWide; bx++) {
+            const uint8_t* in = blocks + (static_cast<size_t>(by) * blocksWide + bx) * blockBytes;
+            switch (format) {
+                case BCFormat::BC1:
+                    bcDecodeBC1(in, pixels, true);
+                    break;
+                case BCFormat::BC3:
+                    bcDecodeBC1(in + 8, pixels, false);
+                    bcDecodeBC4(in, pixels + 3, 4);
+                    break;
+                case BCFormat::BC5:
+                    bcDecodeBC4(in, pixels, 4);
+                    bcDecodeBC4(in + 8, pixels + 1, 4);
+                    for (int i = 0; i < 16; i++) {
+                        pixels[i * 4 + 2] = 0;
+                        pixels[i * 4 + 3] = 255;
+                    }
+                    break;
+                case BCFormat::BC7:
+                    bcDecodeBC7(in, pixels);
+                    break;
+            }
+            for (uint32_t y = 0; y < 4 && by * 4 + y < height; y++) {
+                for (uint32_t x = 0; x < 4 && bx * 4 + x < width; x++) {
+                    memcpy(&rgba[((static_cast<size_t>(by) * 4 + y) * width + bx * 4 + x) * 4], pixels + (y * 4 + x) * 4, 4);
+                }
+            }
+        }
+    }
+    return rgba;
+}
+
+/**
+ * PSNR (dB) between two RGBA8 images over the first `channels` channels
+ */
+inline double rgba_psnr(const uint8_t* a, const uint8_t* b, size_t pixelCount, int channels = 4) {
+    double sum = 0.0;
+    for (size_t i = 0; i < pixelCount; i++) {
+        for (int ch = 0; ch < channels; ch++) {
+            double d = static_cast<double>(a[i * 4 + ch]) - b[i * 4 + ch];
+            sum += d * d;
+        }
+    }
+    double mse = sum / (static_cast<double>(pixelCount) * channels);
+    return mse <= 0.0 ? 99.0 : 10.0 * std::log10(255.0 * 255.0 / mse);
+}
+
+// ---- PNG transcoding and .dds cache ----------------------------------------------
+
+static uint32_t vulkanToDxgiFormat(VkFormat format) {
+    switch (format) {
+        case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGBA_UNORM_BLOCK: return 71;     // DXGI_FORMAT_BC1_UNORM
+        case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+        case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:  return 72;     // DXGI_FORMAT_BC1_UNORM_SRGB
+        case VK_FORMAT_BC3_UNORM_BLOCK:      return 77;     // DXGI_FORMAT_BC3_UNORM
+        case VK_FORMAT_BC3_SRGB_BLOCK:       return 78;     // DXGI_FORMAT_BC3_UNORM_SRGB
+        case VK_FORMAT_BC5_UNORM_BLOCK:      return 83;     // DXGI_FORMAT_BC5_UNORM
+        case VK_FORMAT_BC7_UNORM_BLOCK:      return 98;     // DXGI_FORMAT_BC7_UNORM
+        case VK_FORMAT_BC7_SRGB_BLOCK:       return 99;     // DXGI_FORMAT_BC7_UNORM_SRGB
+        default:                             return 0;
+    }
+}
+
+/**
+ * Write block-compressed data (all mips) as a DX10-header .dds file
+ * @return false if the format has no DXGI equivalent or the file cannot be written
+ */
+inline bool save_dds(const std::string& path, const DDSData& dds) {
+    uint32_t dxgiFormat = vulkanToDxgiFormat(dds.format);
+    if (dxgiFormat == 0) {
+        return false;
+    }
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    DDSHeader header = {};
+    header.size = 124;
+    header.flags = DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_MIPMAPCOUNT | DDSD_LINEARSIZE;
+    header.height = dds.height;
+    header.width = dds.width;
+    header.pitchOrLinearSize = calculateMipmapSize(dds.width, dds.height, dds.format);
+    header.mipMapCount = dds.mipmapCount;
+    header.ddspf.size = 32;
+    header.ddspf.flags = DDPF_FOURCC;
+    header.ddspf.fourCC = FOURCC_DX10;
+    header.caps = 0x1000 | (dds.mipmapCount > 1 ? 0x400008 : 0);   // TEXTURE | MIPMAP | COMPLEX
+
+    DDSHeaderDX10 dx10 = {};
+    dx10.dxgiFormat = dxgiFormat;
+    dx10.resourceDimension = 3;     // D3D10_RESOURCE_DIMENSION_TEXTURE2D
+    dx10.arraySize = 1;
+
+    uint32_t magic = DDS_MAGIC;
+    file.write(reinterpret_cast<const char*>(&magic), sizeof(magic));
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(&dx10), sizeof(dx10));
+    file.write(reinterpret_cast<const char*>(dds.compressedData.data()), dds.compressedData.size());
+    return file.good();
+}
+
+/**
+ * Compress a decoded PNG (and its full mip chain) to BC blocks
+ * BC5 treats the data as linear (normal maps); other formats keep the PNG's sRGB encoding.
+ */
+inline DDSData transcode_png_to_bc(const PNGData& png, BCFormat format, BCQuality quality, uint32_t threadCount = 0) {
+    bool srgb = png.format == VK_FORMAT_R8G8B8A8_SRGB && format != BCFormat::BC5;
+    MipChain chain = build_mip_chain(png.pixelData.data(), png.width, png.height, srgb, MipFilter::Box, threadCount);
+
+    DDSData dds = {};
+    dds.format = bc_vk_format(format, srgb);
+    dds.width = png.width;
+    dds.height = png.height;
+    dds.mipmapCount = static_cast<uint32_t>(chain.levels.size());
+    dds.arraySize = 1;
+    dds.hasAlpha = format == BCFormat::BC3 || format == BCFormat::BC7;
+    for (const MipLevel& level : chain.levels) {
+        std::vector<uint8_t> blocks = encode_bc_image(chain.data.data() + level.offset, level.width, level.height,
+                                                      format, quality, threadCount);
+        dds.compressedData.insert(dds.compressedData.end(), blocks.begin(), blocks.end());
+    }
+    return dds;
+}
+
+// Bump when the encoder's output changes, so older cache files are no longer found
+static constexpr uint32_t BC_CACHE_VERSION = 1;
+
+/**
+ * Cache key of a transcode: FNV-1a over the PNG file's bytes, mixed with its size, the target
+ * format, the quality mode and BC_CACHE_VERSION. An edited PNG gets a new key however quickly it
+ * was saved, and a touched but unchanged one keeps its key.
+ * @return false if the PNG cannot be read
+ */
+inline bool bc_cache_key(const std::string& pngPath, BCFormat format, BCQuality quality, uint64_t& key) {
+    std::ifstream file(pngPath, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    uint64_t hash = 1469598103934665603ull;
+    uint64_t size = 0;
+    char buffer[65536];
+    while (file) {
+        file.read(buffer, sizeof(buffer));
+        std::streamsize count = file.gcount();
+        for (std::streamsize i = 0; i < count; i++) {
+            hash ^= static_cast<uint8_t>(buffer[i]);
+            hash *= 1099511628211ull;
+        }
+        size += static_cast<uint64_t>(count);
+    }
+    uint64_t settings[4] = {size, static_cast<uint64_t>(format), static_cast<uint64_t>(quality), BC_CACHE_VERSION};
+    for (uint64_t value : settings) {
+        hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+    }
+    key = hash;
+    return true;
+}
+
+/**
+ * Cache file for a key: ("texture_cache", 0x1f, BC7) -> "texture_cache/000000000000001f.bc7.dds"
+ */
+inline std::string bc_cache_path(const std::string& cacheDirectory, uint64_t key, BCFormat format) {
+    static const char* suffixes[] = {".bc1.dds", ".bc3.dds", ".bc5.dds", ".bc7.dds"};
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+    return cacheDirectory + "/" + name + suffixes[static_cast<int>(format)];
+}
+
+/**
+ * Whether a cache file exists and holds `format` (the key already covers the PNG's content)
+ */
+inline bool bc_cache_is_current(const std::string& cachePath, BCFormat format) {
+    VkFormat cached = load_dds_header(cachePath).format;
+    return cached == bc_vk_format(format, true) || cached == bc_vk_format(format, false);
+}
+
+/**
+ * Write a transcode to the cache directory (created if missing). The file is written under a
+ * temporary name and renamed, so another process never loads a partial file.
+ * @return false if the cache cannot be written (read-only location)
+ */
+inline bool bc_save_cache(const std::string& cacheDirectory, const std::string& cachePath, const DDSData& dds) {
+#ifdef _WIN32
+    _mkdir(cacheDirectory.c_str());
+#else
+    mkdir(cacheDirectory.c_str(), 0755);
+#endif
+    std::string temp = cachePath + ".part";
+    if (!save_dds(temp, dds)) {
+        std::remove(temp.c_str());
+        return false;
+    }
+    std::remove(cachePath.c_str());
+    if (std::rename(temp.c_str(), cachePath.c_str()) != 0) {
+        std::remove(temp.c_str());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Load the BC-compressed version of a PNG from `cacheDirectory`, transcoding (and writing the
+ * cache) when no cache file matches the PNG's current content.
+ * An empty directory, or one that cannot be written, only costs the transcode time.
+ * @throws std::runtime_error if the PNG cannot be loaded
+ */
+inline DDSData load_or_transcode_png(const std::string& pngPath, BCFormat format, BCQuality quality,
+                                     const std::string& cacheDirectory = "texture_cache") {
+    uint64_t key = 0;
+    std::string cachePath;
+    if (!cacheDirectory.empty() && bc_cache_key(pngPath, format, quality, key)) {
+        cachePath = bc_cache_path(cacheDirectory, key, format);
+        if (bc_cache_is_current(cachePath, format)) {
+            DDSData cached = load_dds(cachePath);
+            if (cached.format != VK_FORMAT_UNDEFINED) {
+                return cached;
+            }
+        }
+    }
+
+    PNGData png = load_png(pngPath);
+    DDSData dds = transcode_png_to_bc(png, format, quality);
+    if (!cachePath.empty()) {
+        bc_save_cache(cacheDirectory, cachePath, dds);
+    }
+    return dds;
+}
+
+/**
+ * Format a PNG should be transcoded to: BC5 for normal maps (*_n, *_nrm, *_normal), BC7 otherwise
+ */
+inline BCFormat bc_format_for_png(const std::string& pngPath) {
+    std::string lower = pngPath;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    size_t dot = lower.find_last_of('.');
+    std::string stem = dot != std::string::npos ? lower.substr(0, dot) : lower;
+    for (const char* suffix : {"_n", "_nrm", "_normal"}) {
+        size_t length = strlen(suffix);
+        if (stem.size() > length && stem.compare(stem.size() - length, length, suffix) == 0) {
+            return BCFormat::BC5;
+        }
+    }
+    return BCFormat::BC7;
+}
+
+#endif // EDEN_BC_ENCODER_H
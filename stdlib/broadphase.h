@@ -0,0 +1,537 @@
+// EDEN ENGINE - Broadphase
+// Collision broadphase for dynamic objects (cubes, items, bodies): incremental sweep-and-prune over
+// axis-aligned boxes. Proxies keep a sort order between frames, so each update is a near-linear
+// insertion sort followed by an SSE2 sweep over sorted SOA intervals that yields candidate overlap
+// pairs. Large sweeps are split across threads. A brute-force reference is kept for verification.
+
+#ifndef EDEN_BROADPHASE_H
+#define EDEN_BROADPHASE_H
+
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <cfloat>
+#include <cstdint>
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EDEN_BROADPHASE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+/**
+ * BroadphaseBounds - Axis-aligned box of one proxy (bounds must be finite)
+ */
+struct BroadphaseBounds {
+    float min[3];
+    float max[3];
+};
+
+/**
+ * Box for an object centered at (x, y, z) with full sizes (sx, sy, sz)
+ */
+inline BroadphaseBounds broadphase_bounds_from_center(float x, float y, float z, float sx, float sy, float sz) {
+    BroadphaseBounds bounds;
+    bounds.min[0] = x - sx * 0.5f;
+    bounds.min[1] = y - sy * 0.5f;
+    bounds.min[2] = z - sz * 0.5f;
+    bounds.max[0] = x + sx * 0.5f;
+    bounds.max[1] = y + sy * 0.5f;
+    bounds.max[2] = z + sz * 0.5f;
+    return bounds;
+}
+
+/**
+ * BroadphasePair - Two proxies whose boxes overlap (a < b; touching boxes count as overlapping)
+ */
+struct BroadphasePair {
+    uint32_t a;
+    uint32_t b;
+};
+
+inline bool operator<(const BroadphasePair& lhs, const BroadphasePair& rhs) {
+    return lhs.a != rhs.a ? lhs.a < rhs.a : lhs.b < rhs.b;
+}
+
+inline bool operator==(const BroadphasePair& lhs, const BroadphasePair& rhs) {
+    return lhs.a == rhs.a && lhs.b == rhs.b;
+}
+
+/**
+ * Sort pairs by (a, b), e.g. to compare results from different broadphases
+ */
+inline void broadphase_sort_pairs(std::vector<BroadphasePair>& pairs) {
+    std::sort(pairs.begin(), pairs.end());
+}
+
+static inline bool broadphaseOverlap(const BroadphaseBounds& a, const BroadphaseBounds& b) {
+    return a.min[0] <= b.max[0] && b.min[0] <= a.max[0] &&
+           a.min[1] <= b.max[1] && b.min[1] <= a.max[1] &&
+           a.min[2] <= b.max[2] && b.min[2] <= a.max[2];
+}
+
+/**
+ * Brute-force reference: every overlapping pair (i, j), i < j, where at least one side is dynamic
+ * @param isStatic  Optional per-box static flags (nullptr = all dynamic)
+ * @return Number of pairs written to out (sorted by (a, b))
+ */
+inline size_t broadphase_pairs_reference(const BroadphaseBounds* bounds, const uint8_t* isStatic, size_t count,
+                                         std::vector<BroadphasePair>& out) {
+    out.clear();
+    for (size_t i = 0; i < count; i++) {
+        for (size_t j = i + 1; j < count; j++) {
+            if (isStatic && isStatic[i] && isStatic[j]) {
+                continue;
+            }
+            if (broadphaseOverlap(bounds[i], bounds[j])) {
+                out.push_back({static_cast<uint32_t>(i), static_cast<uint32_t>(j)});
+            }
+        }
+    }
+    return out.size();
+}
+
+/**
+ * SweepAndPrune - Incremental sweep-and-prune broadphase
+ *
+ * Proxies are identified by the id returned from addProxy (ids of removed proxies are reused).
+ * Boxes are stored SOA by id; findPairs keeps the proxies sorted by their minimum on the sweep
+ * axis (the axis along which the boxes are most spread out), re-sorting incrementally from the
+ * previous frame's order. Static proxies never pair with each other.
+ *
+ * Pairs come out in sweep order, which only depends on the sequence of calls made on the
+ * broadphase (not on the thread count), so results are deterministic.
+ *
+ * Usage:
+ *   SweepAndPrune broadphase;
+ *   uint32_t id = broadphase.addProxy(bounds, false, cubeIndex);
+ *   // each frame:
+ *   broadphase.updateProxy(id, newBounds);
+ *   broadphase.findPairs(pairs);
+ *   for (const BroadphasePair& pair : pairs) narrowphase(broadphase.getUserData(pair.a), ...);
+ */
+class SweepAndPrune {
+public:
+    static constexpr uint32_t INVALID_PROXY = 0xFFFFFFFFu;
+
+private:
+    static constexpr uint8_t FLAG_ALIVE = 1;
+    static constexpr uint8_t FLAG_STATIC = 2;
+    static constexpr uint8_t FLAG_SORTED = 4;   // Id is in m_entries
+    static constexpr uint8_t FLAG_PENDING = 8;  // Id is in m_pending (added since the last findPairs)
+
+    // Sweep lanes read up to 3 entries past the end; these sentinels never overlap anything
+    static constexpr size_t SWEEP_PADDING = 4;
+
+    struct Entry {
+        float key;    // Box minimum on the sweep axis
+        uint32_t id;
+    };
+
+    // Proxy boxes, SOA by id
+    std::vector<float> m_min[3];
+    std::vector<float> m_max[3];
+    std::vector<uint32_t> m_userData;
+    std::vector<uint8_t> m_flags;
+    std::vector<uint32_t> m_freeIds;
+    std::vector<uint32_t> m_pending;
+    uint32_t m_proxyCount = 0;
+
+    // Persistent sort order on the sweep axis
+    std::vector<Entry> m_entries;
+    int m_axis = 0;
+
+    // Sorted SOA copy used by the sweep: sweep-axis max, other two axes' intervals, static mask
+    std::vector<float> m_sortedMax;
+    std::vector<float> m_sortedMin1;
+    std::vector<float> m_sortedMax1;
+    std::vector<float> m_sortedMin2;
+    std::vector<float> m_sortedMax2;
+    std::vector<float> m_sortedKey;
+    std::vector<int32_t> m_sortedStatic;  // -1 (all bits) for static, 0 for dynamic
+    std::vector<uint32_t> m_sortedId;
+
+    std::vector<std::vector<BroadphasePair>> m_workerPairs;
+
+    static bool entryLess(const Entry& a, const Entry& b) {
+        return a.key != b.key ? a.key < b.key : a.id < b.id;
+    }
+
+    /**
+     * Pick the axis with the largest variance of box centers. The current axis is kept unless
+     * another one is clearly better, so scenes near a tie don't re-sort from scratch every frame.
+     */
+    int chooseAxis() const {
+        double sum[3] = {0.0, 0.0, 0.0};
+        double sumSq[3] = {0.0, 0.0, 0.0};
+        size_t n = 0;
+        auto accumulate = [&](uint32_t id) {
+            for (int axis = 0; axis < 3; axis++) {
+                double c = 0.5 * (static_cast<double>(m_min[axis][id]) + m_max[axis][id]);
+                sum[axis] += c;
+                sumSq[axis] += c * c;
+            }
+            n++;
+        };
+        for (const Entry& entry : m_entries) {
+            accumulate(entry.id);
+        }
+        for (uint32_t id : m_pending) {
+            if (m_flags[id] & FLAG_ALIVE) {
+                accumulate(id);
+            }
+        }
+        if (n < 2) {
+            return m_axis;
+        }
+        double variance[3];
+        for (int axis = 0; axis < 3; axis++) {
+            double mean = sum[axis] / n;
+            variance[axis] = sumSq[axis] / n - mean * mean;
+        }
+        int best = m_axis;
+        for (int axis = 0; axis < 3; axis++) {
+            if (variance[axis] > variance[best] * 2.0) {
+                best = axis;
+            }
+        }
+        return best;
+    }
+
+    /**
+     * Bring m_entries up to date: drop removed proxies, refresh keys, append new proxies, and
+     * restore the sort order (insertion sort for the coherent part, merge for new proxies)
+     */
+    void updateSortOrder() {
+        // Drop removed proxies
+        size_t kept = 0;
+        for (size_t i = 0; i < m_entries.size(); i++) {
+            uint32_t id = m_entries[i].id;
+            if (m_flags[id] & FLAG_ALIVE) {
+                m_entries[kept++] = m_entries[i];
+            } else {
+                m_flags[id] &= static_cast<uint8_t>(~FLAG_SORTED);
+            }
+        }
+        m_entries.resize(kept);
+
+        // Switching axis invalidates the previous order entirely
+        int axis = chooseAxis();
+        bool fullSort = axis != m_axis;
+        m_axis = axis;
+
+        const std::vector<float>& keys = m_min[m_axis];
+        for (Entry& entry : m_entries) {
+            entry.key = keys[entry.id];
+        }
+
+        if (fullSort) {
+            std::sort(m_entries.begin(), m_entries.end(), entryLess);
+        } else {
+            // Objects move little between frames, so each entry shifts only a few slots. Give up
+            // on the insertion sort once the work says the order is not coherent (teleports).
+            size_t shiftLimit = 8 * m_entries.size() + 64;
+            size_t shifts = 0;
+            for (size_t i = 1; i < m_entries.size() && shifts <= shiftLimit; i++) {
+                Entry entry = m_entries[i];
+                size_t j = i;
+                while (j > 0 && entryLess(entry, m_entries[j - 1])) {
+                    m_entries[j] = m_entries[j - 1];
+                    j--;
+                }
+                m_entries[j] = entry;
+                shifts += i - j;
+            }
+            if (shifts > shiftLimit) {
+                std::sort(m_entries.begin(), m_entries.end(), entryLess);
+            }
+        }
+
+        // Sort new proxies on their own and merge them in
+        size_t oldCount = m_entries.size();
+        for (uint32_t id : m_pending) {
+            m_flags[id] &= static_cast<uint8_t>(~FLAG_PENDING);
+            if (m_flags[id] & FLAG_ALIVE) {
+                m_flags[id] |= FLAG_SORTED;
+                m_entries.push_back({keys[id], id});
+            }
+        }
+        m_pending.clear();
+        if (m_entries.size() > oldCount) {
+            std::sort(m_entries.begin() + oldCount, m_entries.end(), entryLess);
+            std::inplace_merge(m_entries.begin(), m_entries.begin() + oldCount, m_entries.end(), entryLess);
+        }
+    }
+
+    /**
+     * Gather the sorted proxies into SOA arrays (plus sentinel padding) for the sweep
+     */
+    void gatherSorted() {
+        int axis1 = (m_axis + 1) % 3;
+        int axis2 = (m_axis + 2) % 3;
+        size_t count = m_entries.size();
+        size_t padded = count + SWEEP_PADDING;
+        m_sortedKey.resize(padded);
+        m_sortedMax.resize(padded);
+        m_sortedMin1.resize(padded);
+        m_sortedMax1.resize(padded);
+        m_sortedMin2.resize(padded);
+        m_sortedMax2.resize(padded);
+        m_sortedStatic.resize(padded);
+        m_sortedId.resize(padded);
+        for (size_t i = 0; i < count; i++) {
+            uint32_t id = m_entries[i].id;
+            m_sortedKey[i] = m_entries[i].key;
+            m_sortedMax[i] = m_max[m_axis][id];
+            m_sortedMin1[i] = m_min[axis1][id];
+            m_sortedMax1[i] = m_max[axis1][id];
+            m_sortedMin2[i] = m_min[axis2][id];
+            m_sortedMax2[i] = m_max[axis2][id];
+            m_sortedStatic[i] = (m_flags[id] & FLAG_STATIC) ? -1 : 0;
+            m_sortedId[i] = id;
+        }
+        for (size_t i = count; i < padded; i++) {
+            m_sortedKey[i] = FLT_MAX;
+            m_sortedMax[i] = -FLT_MAX;
+            m_sortedMin1[i] = FLT_MAX;
+            m_sortedMax1[i] = -FLT_MAX;
+            m_sortedMin2[i] = FLT_MAX;
+            m_sortedMax2[i] = -FLT_MAX;
+            m_sortedStatic[i] = -1;
+            m_sortedId[i] = INVALID_PROXY;
+        }
+    }
+
+    static void addPair(std::vector<BroadphasePair>& out, uint32_t idA, uint32_t idB) {
+        if (idA < idB) {
+            out.push_back({idA, idB});
+        } else {
+            out.push_back({idB, idA});
+        }
+    }
+
+    /**
+     * Sweep sorted proxies [begin, end): each one is tested against the proxies that start
+     * before it ends on the sweep axis
+     */
+    void sweepRange(size_t begin, size_t end, std::vector<BroadphasePair>& out) const {
+        size_t count = m_entries.size();
+        const float* key = m_sortedKey.data();
+        const float* min1 = m_sortedMin1.data();
+        const float* max1 = m_sortedMax1.data();
+        const float* min2 = m_sortedMin2.data();
+        const float* max2 = m_sortedMax2.data();
+        const int32_t* isStatic = m_sortedStatic.data();
+        const uint32_t* ids = m_sortedId.data();
+
+        for (size_t i = begin; i < end; i++) {
+            float maxI = m_sortedMax[i];
+            float min1I = min1[i];
+            float max1I = max1[i];
+            float min2I = min2[i];
+            float max2I = max2[i];
+            int32_t staticI = isStatic[i];
+            uint32_t idI = ids[i];
+
+#ifdef EDEN_BROADPHASE_SSE2
+            __m128 vMax = _mm_set1_ps(maxI);
+            __m128 vMin1 = _mm_set1_ps(min1I);
+            __m128 vMax1 = _mm_set1_ps(max1I);
+            __m128 vMin2 = _mm_set1_ps(min2I);
+            __m128 vMax2 = _mm_set1_ps(max2I);
+            __m128i vStatic = _mm_set1_epi32(staticI);
+            for (size_t j = i + 1; j < count; j += 4) {
+                __m128 inRange = _mm_cmple_ps(_mm_loadu_ps(key + j), vMax);
+                int rangeMask = _mm_movemask_ps(inRange);
+                if (rangeMask == 0) {
+                    break;
+                }
+                __m128 overlap = _mm_and_ps(inRange, _mm_cmple_ps(_mm_loadu_ps(min1 + j), vMax1));
+                overlap = _mm_and_ps(overlap, _mm_cmple_ps(vMin1, _mm_loadu_ps(max1 + j)));
+                overlap = _mm_and_ps(overlap, _mm_cmple_ps(_mm_loadu_ps(min2 + j), vMax2));
+                overlap = _mm_and_ps(overlap, _mm_cmple_ps(vMin2, _mm_loadu_ps(max2 + j)));
+                __m128i bothStatic = _mm_and_si128(vStatic, _mm_loadu_si128(reinterpret_cast<const __m128i*>(isStatic + j)));
+                overlap = _mm_andnot_ps(_mm_castsi128_ps(bothStatic), overlap);
+                int mask = _mm_movemask_ps(overlap);
+                if (mask) {
+                    for (int lane = 0; lane < 4; lane++) {
+                        if (mask & (1 << lane)) {
+                            addPair(out, idI, ids[j + lane]);
+                        }
+                    }
+                }
+                if (rangeMask != 0xF) {
+                    break;
+                }
+            }
+#else
+            for (size_t j = i + 1; j < count && key[j] <= maxI; j++) {
+                if ((staticI & isStatic[j]) != 0) {
+                    continue;
+                }
+                if (min1[j] <= max1I && min1I <= max1[j] && min2[j] <= max2I && min2I <= max2[j]) {
+                    addPair(out, idI, ids[j]);
+                }
+            }
+#endif
+        }
+    }
+
+public:
+    /**
+     * Add a proxy
+     * @param isStatic  Static proxies (ground, buildings) only pair with dynamic ones
+     * @param userData  Caller value returned by getUserData (e.g. an object index)
+     * @return Proxy id
+     */
+    uint32_t addProxy(const BroadphaseBounds& bounds, bool isStatic = false, uint32_t userData = 0) {
+        uint32_t id;
+        if (!m_freeIds.empty()) {
+            id = m_freeIds.back();
+            m_freeIds.pop_back();
+        } else {
+            id = static_cast<uint32_t>(m_flags.size());
+            for (int axis = 0; axis < 3; axis++) {
+                m_min[axis].push_back(0.0f);
+                m_max[axis].push_back(0.0f);
+            }
+            m_userData.push_back(0);
+            m_flags.push_back(0);
+        }
+        for (int axis = 0; axis < 3; axis++) {
+            m_min[axis][id] = bounds.min[axis];
+            m_max[axis][id] = bounds.max[axis];
+        }
+        m_userData[id] = userData;
+        uint8_t flags = m_flags[id] & (FLAG_SORTED | FLAG_PENDING);
+        flags |= FLAG_ALIVE;
+        if (isStatic) {
+            flags |= FLAG_STATIC;
+        }
+        // An id removed and reused before the next findPairs is still in the sort order
+        if (!(flags & (FLAG_SORTED | FLAG_PENDING))) {
+            flags |= FLAG_PENDING;
+            m_pending.push_back(id);
+        }
+        m_flags[id] = flags;
+        m_proxyCount++;
+        return id;
+    }
+
+    /**
+     * Move a proxy (takes effect at the next findPairs)
+     */
+    void updateProxy(uint32_t id, const BroadphaseBounds& bounds) {
+        if (!isValid(id)) {
+            return;
+        }
+        for (int axis = 0; axis < 3; axis++) {
+            m_min[axis][id] = bounds.min[axis];
+            m_max[axis][id] = bounds.max[axis];
+        }
+    }
+
+    void setStatic(uint32_t id, bool isStatic) {
+        if (!isValid(id)) {
+            return;
+        }
+        if (isStatic) {
+            m_flags[id] |= FLAG_STATIC;
+        } else {
+            m_flags[id] &= static_cast<uint8_t>(~FLAG_STATIC);
+        }
+    }
+
+    void removeProxy(uint32_t id) {
+        if (!isValid(id)) {
+            return;
+        }
+        m_flags[id] &= static_cast<uint8_t>(~(FLAG_ALIVE | FLAG_STATIC));
+        m_freeIds.push_back(id);
+        m_proxyCount--;
+    }
+
+    /**
+     * Re-sort the proxies and collect every overlapping pair
+     * @param threadCount  Worker threads for large sweeps (0 = hardware concurrency)
+     * @return Number of pairs written to out
+     */
+    size_t findPairs(std::vector<BroadphasePair>& out, uint32_t threadCount = 0) {
+        out.clear();
+        updateSortOrder();
+        gatherSorted();
+
+        if (threadCount == 0) {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+        size_t count = m_entries.size();
+        const size_t MIN_PROXIES_PER_THREAD = 8192;
+        uint32_t workers = static_cast<uint32_t>(std::min<size_t>(threadCount, count / MIN_PROXIES_PER_THREAD));
+        if (workers <= 1) {
+            sweepRange(0, count, out);
+            return out.size();
+        }
+
+        // Each worker sweeps a contiguous slice of the sort order; appending the slices in order
+        // gives the same pair list as a single-threaded sweep
+        m_workerPairs.resize(workers);
+        std::vector<std::thread> threads;
+        size_t proxiesPerWorker = (count + workers - 1) / workers;
+        for (uint32_t w = 0; w < workers; w++) {
+            size_t begin = w * proxiesPerWorker;
+            size_t end = std::min(count, begin + proxiesPerWorker);
+            std::vector<BroadphasePair>& workerOut = m_workerPairs[w];
+            workerOut.clear();
+            if (begin >= end) {
+                continue;
+            }
+            threads.emplace_back([this, begin, end, &workerOut]() {
+                sweepRange(begin, end, workerOut);
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        size_t total = 0;
+        for (uint32_t w = 0; w < workers; w++) {
+            total += m_workerPairs[w].size();
+        }
+        out.reserve(total);
+        for (uint32_t w = 0; w < workers; w++) {
+            out.insert(out.end(), m_workerPairs[w].begin(), m_workerPairs[w].end());
+        }
+        return out.size();
+    }
+
+    void clear() {
+        for (int axis = 0; axis < 3; axis++) {
+            m_min[axis].clear();
+            m_max[axis].clear();
+        }
+        m_userData.clear();
+        m_flags.clear();
+        m_freeIds.clear();
+        m_pending.clear();
+        m_entries.clear();
+        m_proxyCount = 0;
+    }
+
+    bool isValid(uint32_t id) const { return id < m_flags.size() && (m_flags[id] & FLAG_ALIVE); }
+    bool isStatic(uint32_t id) const { return isValid(id) && (m_flags[id] & FLAG_STATIC); }
+    uint32_t getUserData(uint32_t id) const { return id < m_userData.size() ? m_userData[id] : 0; }
+    uint32_t getProxyCount() const { return m_proxyCount; }
+    int getSweepAxis() const { return m_axis; }
+
+    BroadphaseBounds getBounds(uint32_t id) const {
+        BroadphaseBounds bounds = {};
+        if (id < m_flags.size()) {
+            for (int axis = 0; axis < 3; axis++) {
+                bounds.min[axis] = m_min[axis][id];
+                bounds.max[axis] = m_max[axis][id];
+            }
+        }
+        return bounds;
+    }
+};
+
+#endif // EDEN_BROADPHASE_H
@@ -0,0 +1,793 @@
+// EDEN ENGINE - Bounding Volume Hierarchy
+// Ray queries over axis-aligned boxes (level objects, pickable items): a binned-SAH tree built
+// over object bounds, refit in place when objects move, traversed by single rays or by packets
+// of four rays with SSE2. Queries return the nearest hit (object index, distance, surface normal).
+// Large SOA ray batches are traced as packets across threads. A linear reference raycast is kept
+// for verification.
+
+#ifndef EDEN_BVH_H
+#define EDEN_BVH_H
+
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EDEN_BVH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+/**
+ * BvhBounds - Axis-aligned box of one object
+ */
+struct BvhBounds {
+    float min[3];
+    float max[3];
+};
+
+/**
+ * Box for an object centered at (x, y, z) with full sizes (sx, sy, sz)
+ */
+inline BvhBounds bvh_bounds_from_center(float x, float y, float z, float sx, float sy, float sz) {
+    BvhBounds bounds;
+    bounds.min[0] = x - sx * 0.5f;
+    bounds.min[1] = y - sy * 0.5f;
+    bounds.min[2] = z - sz * 0.5f;
+    bounds.max[0] = x + sx * 0.5f;
+    bounds.max[1] = y + sy * 0.5f;
+    bounds.max[2] = z + sz * 0.5f;
+    return bounds;
+}
+
+/**
+ * BvhRay - Ray with its reciprocal direction precomputed once (see bvh_make_ray)
+ *
+ * Distances are in units of the direction's length, so pass a unit direction to get meters.
+ * tMax limits the query (hits farther away are ignored).
+ */
+struct BvhRay {
+    float origin[3];
+    float dir[3];
+    float invDir[3];
+    float tMax;
+};
+
+// Stand-in for 1/0: large enough that a ray parallel to a slab never enters it from outside,
+// small enough that (bound - origin) * invDir stays finite (no NaN from 0 * inf)
+static constexpr float BVH_INV_DIR_LIMIT = 1e30f;
+
+inline BvhRay bvh_make_ray(float ox, float oy, float oz, float dx, float dy, float dz, float tMax = 1e30f) {
+    BvhRay ray;
+    ray.origin[0] = ox;
+    ray.origin[1] = oy;
+    ray.origin[2] = oz;
+    ray.dir[0] = dx;
+    ray.dir[1] = dy;
+    ray.dir[2] = dz;
+    for (int axis = 0; axis < 3; axis++) {
+        float d = ray.dir[axis];
+        ray.invDir[axis] = std::fabs(d) > 1.0f / BVH_INV_DIR_LIMIT ? 1.0f / d : (d < 0.0f ? -BVH_INV_DIR_LIMIT : BVH_INV_DIR_LIMIT);
+    }
+    ray.tMax = tMax;
+    return ray;
+}
+
+/**
+ * BvhHit - Nearest hit of a ray
+ *
+ * index is -1 on a miss. normal is the outward normal of the face the ray entered through.
+ * Rays starting inside a box do not hit that box.
+ */
+struct BvhHit {
+    int32_t index = -1;
+    float distance = 0.0f;
+    float normal[3] = {0.0f, 0.0f, 0.0f};
+};
+
+// Accepts every object (default query filter)
+struct BvhAcceptAll {
+    bool operator()(uint32_t) const { return true; }
+};
+
+// Slab test of one ray against one box: entry/exit distances and the entry axis
+// (ties pick X before Y before Z; the SSE2 paths make the same choice)
+static inline void bvhRayBox(const BvhRay& ray, const float boxMin[3], const float boxMax[3],
+                             float& tEnter, float& tExit, int& axis) {
+    float tNear[3], tFar[3];
+    for (int a = 0; a < 3; a++) {
+        float t0 = (boxMin[a] - ray.origin[a]) * ray.invDir[a];
+        float t1 = (boxMax[a] - ray.origin[a]) * ray.invDir[a];
+        tNear[a] = std::min(t0, t1);
+        tFar[a] = std::max(t0, t1);
+    }
+    tEnter = std::max(std::max(tNear[0], tNear[1]), tNear[2]);
+    tExit = std::min(std::min(tFar[0], tFar[1]), tFar[2]);
+    axis = (tNear[0] >= tNear[1] && tNear[0] >= tNear[2]) ? 0 : (tNear[1] >= tNear[2] ? 1 : 2);
+}
+
+// Candidate hit beats the current one: closer, or as close with a lower index (deterministic ties)
+static inline bool bvhCloser(float t, uint32_t index, const BvhHit& hit) {
+    return t < hit.distance || (t == hit.distance && hit.index >= 0 && index < static_cast<uint32_t>(hit.index));
+}
+
+static inline void bvhSetNormal(BvhHit& hit, int axis, const float dir[3]) {
+    hit.normal[0] = hit.normal[1] = hit.normal[2] = 0.0f;
+    hit.normal[axis] = dir[axis] > 0.0f ? -1.0f : 1.0f;
+}
+
+#ifdef EDEN_BVH_SSE2
+// bvhRayBox for four rays (SOA) against one box; nearX/Y/Z are the per-axis entry distances
+static inline void bvhSlab4(__m128 ox, __m128 oy, __m128 oz, __m128 ix, __m128 iy, __m128 iz,
+                            const float boxMin[3], const float boxMax[3], __m128& tEnter, __m128& tExit,
+                            __m128& nearX, __m128& nearY, __m128& nearZ) {
+    __m128 x0 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(boxMin[0]), ox), ix);
+    __m128 x1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(boxMax[0]), ox), ix);
+    __m128 y0 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(boxMin[1]), oy), iy);
+    __m128 y1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(boxMax[1]), oy), iy);
+    __m128 z0 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(boxMin[2]), oz), iz);
+    __m128 z1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(boxMax[2]), oz), iz);
+    nearX = _mm_min_ps(x0, x1);
+    nearY = _mm_min_ps(y0, y1);
+    nearZ = _mm_min_ps(z0, z1);
+    tEnter = _mm_max_ps(_mm_max_ps(nearX, nearY), nearZ);
+    tExit = _mm_min_ps(_mm_min_ps(_mm_max_ps(x0, x1), _mm_max_ps(y0, y1)), _mm_max_ps(z0, z1));
+}
+#endif
+
+/**
+ * Linear raycast over every box (reference for Bvh::intersect; same hit rules and tie-breaking)
+ */
+template <typename Accept = BvhAcceptAll>
+inline BvhHit bvh_raycast_reference(const BvhBounds* bounds, size_t count, const BvhRay& ray, Accept accept = Accept()) {
+    BvhHit hit;
+    hit.distance = ray.tMax;
+    int hitAxis = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (!accept(static_cast<uint32_t>(i))) {
+            continue;
+        }
+        float tEnter, tExit;
+        int axis;
+        bvhRayBox(ray, bounds[i].min, bounds[i].max, tEnter, tExit, axis);
+        if (tEnter >= 0.0f && tEnter <= tExit && bvhCloser(tEnter, static_cast<uint32_t>(i), hit)) {
+            hit.index = static_cast<int32_t>(i);
+            hit.distance = tEnter;
+            hitAxis = axis;
+        }
+    }
+    if (hit.index >= 0) {
+        bvhSetNormal(hit, hitAxis, ray.dir);
+    }
+    return hit;
+}
+
+/**
+ * Bvh - Binned-SAH bounding volume hierarchy over object boxes
+ *
+ * Leaves reference objects through an index list; object boxes are copied in leaf order so a
+ * leaf's boxes are contiguous. Moving objects only need refit(), which updates boxes bottom-up
+ * without changing the tree; rebuild when objects are added/removed or after large motion
+ * (refit keeps queries correct but the tree's quality degrades as objects drift).
+ *
+ * Usage:
+ *   Bvh bvh;
+ *   bvh.build(bounds.data(), bounds.size());
+ *   BvhHit hit = bvh.intersect(bvh_make_ray(x, y, z, 0.0f, -1.0f, 0.0f, 100.0f));
+ *   if (hit.index >= 0) { ... hit.distance, hit.normal ... }
+ *   // objects moved:
+ *   bvh.refit(bounds.data(), bounds.size());
+ */
+class Bvh {
+public:
+    // 32-byte node: leaves have count > 0 (objects [first, first + count) of the index list),
+    // inner nodes have count == 0, children at first and first + 1, split along axis
+    struct Node {
+        float min[3];
+        uint32_t first;
+        float max[3];
+        uint16_t count;
+        uint16_t axis;
+    };
+
+private:
+    static constexpr uint32_t SAH_BINS = 12;
+    static constexpr uint32_t MAX_LEAF_SIZE = 8;
+    static constexpr uint32_t MAX_DEPTH = 48;       // Deeper nodes are split at the median (bounds the stack)
+    static constexpr uint32_t STACK_SIZE = 128;
+
+    std::vector<Node> m_nodes;
+    std::vector<uint32_t> m_indices;                // Leaf order -> object index
+    std::vector<BvhBounds> m_bounds;                // Object boxes in leaf order
+
+    static float surfaceArea(const float mn[3], const float mx[3]) {
+        float dx = mx[0] - mn[0], dy = mx[1] - mn[1], dz = mx[2] - mn[2];
+        return dx * dy + dy * dz + dz * dx;
+    }
+
+    static void growBounds(float mn[3], float mx[3], const BvhBounds& b) {
+        for (int a = 0; a < 3; a++) {
+            mn[a] = std::min(mn[a], b.min[a]);
+            mx[a] = std::max(mx[a], b.max[a]);
+        }
+    }
+
+    static void resetBounds(float mn[3], float mx[3]) {
+        mn[0] = mn[1] = mn[2] = 1e30f;
+        mx[0] = mx[1] = mx[2] = -1e30f;
+    }
+
+    void updateNodeBounds(Node& node) const {
+        resetBounds(node.min, node.max);
+        if (node.count > 0) {
+            for (uint32_t i = node.first; i < node.first + node.count; i++) {
+                growBounds(node.min, node.max, m_bounds[i]);
+            }
+        } else {
+            for (uint32_t c = node.first; c < node.first + 2; c++) {
+                for (int a = 0; a < 3; a++) {
+                    node.min[a] = std::min(node.min[a], m_nodes[c].min[a]);
+                    node.max[a] = std::max(node.max[a], m_nodes[c].max[a]);
+                }
+            }
+        }
+    }
+
+    // Choose how to split objects [first, first + count) of m_bounds (box nodeMin/nodeMax);
+    // returns false when they should stay a leaf
+    bool findSplit(uint32_t first, uint32_t count, const float nodeMin[3], const float nodeMax[3], uint32_t depth,
+                   int& splitAxis, float& splitPos, bool& median) const {
+        float cMin[3], cMax[3];
+        resetBounds(cMin, cMax);
+        for (uint32_t i = first; i < first + count; i++) {
+            for (int a = 0; a < 3; a++) {
+                float c = (m_bounds[i].min[a] + m_bounds[i].max[a]) * 0.5f;
+                cMin[a] = std::min(cMin[a], c);
+                cMax[a] = std::max(cMax[a], c);
+            }
+        }
+        int widest = 0;
+        for (int a = 1; a < 3; a++) {
+            if (cMax[a] - cMin[a] > cMax[widest] - cMin[widest]) {
+                widest = a;
+            }
+        }
+
+        median = false;
+        if (depth >= MAX_DEPTH || cMax[widest] <= cMin[widest]) {
+            // Too deep, or all centroids coincide: split the list in half if it is too long for a leaf
+            splitAxis = widest;
+            median = true;
+            return count > MAX_LEAF_SIZE || (depth >= MAX_DEPTH && count > 1);
+        }
+
+        // Binned SAH: cost of a split = N_left * A_left + N_right * A_right (in units of the parent area)
+        float bestCost = 1e30f;
+        for (int a = 0; a < 3; a++) {
+            if (cMax[a] <= cMin[a]) {
+                continue;
+            }
+            float binMin[SAH_BINS][3], binMax[SAH_BINS][3];
+            uint32_t binCount[SAH_BINS] = {0};
+            for (uint32_t b = 0; b < SAH_BINS; b++) {
+                resetBounds(binMin[b], binMax[b]);
+            }
+            float scale = SAH_BINS / (cMax[a] - cMin[a]);
+            for (uint32_t i = first; i < first + count; i++) {
+                float c = (m_bounds[i].min[a] + m_bounds[i].max[a]) * 0.5f;
+                uint32_t b = std::min(SAH_BINS - 1, static_cast<uint32_t>((c - cMin[a]) * scale));
+                binCount[b]++;
+                growBounds(binMin[b], binMax[b], m_bounds[i]);
+            }
+
+            // Sweep from the right to get every suffix, then from the left
+            float rightArea[SAH_BINS];
+            uint32_t rightCount[SAH_BINS];
+            float mn[3], mx[3];
+            resetBounds(mn, mx);
+            uint32_t sideCount = 0;
+            for (uint32_t b = SAH_BINS - 1; b > 0; b--) {
+                sideCount += binCount[b];
+                for (int k = 0; k < 3; k++) {
+                    mn[k] = std::min(mn[k], binMin[b][k]);
+                    mx[k] = std::max(mx[k], binMax[b][k]);
+                }
+                rightArea[b] = sideCount ? surfaceArea(mn, mx) : 0.0f;
+                rightCount[b] = sideCount;
+            }
+            resetBounds(mn, mx);
+            sideCount = 0;
+            for (uint32_t b = 0; b < SAH_BINS - 1; b++) {
+                sideCount += binCount[b];
+                for (int k = 0; k < 3; k++) {
+                    mn[k] = std::min(mn[k], binMin[b][k]);
+                    mx[k] = std::max(mx[k], binMax[b][k]);
+                }
+                if (sideCount == 0 || rightCount[b + 1] == 0) {
+                    continue;
+                }
+                float cost = sideCount * surfaceArea(mn, mx) + rightCount[b + 1] * rightArea[b + 1];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    splitAxis = a;
+                    splitPos = cMin[a] + (b + 1) / scale;
+                }
+            }
+        }
+
+        // A node visit costs about one box test, so splitting must save more than that to beat a leaf
+        float nodeArea = surfaceArea(nodeMin, nodeMax);
+        float leafCost = count * nodeArea;
+        if (bestCost >= 1e30f) {
+            splitAxis = widest;
+            median = true;
+            return count > MAX_LEAF_SIZE;
+        }
+        return count > MAX_LEAF_SIZE || bestCost + nodeArea < leafCost;
+    }
+
+    // Reorder objects [0, count) of the given range so the nth smallest centroid along axis is at nth
+    // with smaller ones before it (median split)
+    static void sortRangeByCentroid(BvhBounds* bounds, uint32_t* indices, uint32_t count, int axis, uint32_t nth) {
+        std::vector<std::pair<float, uint32_t>> keys(count);
+        for (uint32_t i = 0; i < count; i++) {
+            keys[i] = {bounds[i].min[axis] + bounds[i].max[axis], i};
+        }
+        std::nth_element(keys.begin(), keys.begin() + nth, keys.end());
+        std::vector<BvhBounds> sortedBounds(count);
+        std::vector<uint32_t> sortedIndices(count);
+        for (uint32_t i = 0; i < count; i++) {
+            sortedBounds[i] = bounds[keys[i].second];
+            sortedIndices[i] = indices[keys[i].second];
+        }
+        std::copy(sortedBounds.begin(), sortedBounds.end(), bounds);
+        std::copy(sortedIndices.begin(), sortedIndices.end(), indices);
+    }
+
+public:
+    /**
+     * Build the tree over count boxes (object i = bounds[i])
+     */
+    void build(const BvhBounds* bounds, size_t count) {
+        m_nodes.clear();
+        m_indices.resize(count);
+        m_bounds.assign(bounds, bounds + count);
+        for (size_t i = 0; i < count; i++) {
+            m_indices[i] = static_cast<uint32_t>(i);
+        }
+        if (count == 0) {
+            return;
+        }
+        m_nodes.reserve(count * 2);
+
+        Node root = {};
+        root.first = 0;
+        root.count = 0;
+        m_nodes.push_back(root);
+
+        // Ranges still to split (a range can be longer than a leaf's 16-bit count)
+        struct Task { uint32_t node, first, count, depth; };
+        std::vector<Task> tasks;
+        tasks.push_back({0, 0, static_cast<uint32_t>(count), 0});
+        while (!tasks.empty()) {
+            Task task = tasks.back();
+            tasks.pop_back();
+
+            Node& node = m_nodes[task.node];
+            node.first = task.first;
+            node.count = 0;
+            resetBounds(node.min, node.max);
+            for (uint32_t i = task.first; i < task.first + task.count; i++) {
+                growBounds(node.min, node.max, m_bounds[i]);
+            }
+
+            int axis = 0;
+            float splitPos = 0.0f;
+            bool median = false;
+            bool split = task.count > 1 &&
+                         findSplit(task.first, task.count, node.min, node.max, task.depth, axis, splitPos, median);
+            if (!split) {
+                node.count = static_cast<uint16_t>(task.count);
+                node.axis = 0;
+                continue;
+            }
+
+            uint32_t mid;
+            if (median) {
+                mid = task.first + task.count / 2;
+                sortRangeByCentroid(m_bounds.data() + task.first, m_indices.data() + task.first,
+                                    task.count, axis, task.count / 2);
+            } else {
+                // Partition by centroid against the split plane
+                uint32_t i = task.first;
+                uint32_t j = task.first + task.count;
+                while (i < j) {
+                    float c = (m_bounds[i].min[axis] + m_bounds[i].max[axis]) * 0.5f;
+                    if (c < splitPos) {
+                        i++;
+                    } else {
+                        j--;
+                        std::swap(m_bounds[i], m_bounds[j]);
+                        std::swap(m_indices[i], m_indices[j]);
+                    }
+                }
+                mid = i;
+                if (mid == task.first || mid == task.first + task.count) {
+                    mid = task.first + task.count / 2;
+                    sortRangeByCentroid(m_bounds.data() + task.first, m_indices.data() + task.first,
+                                        task.count, axis, task.count / 2);
+                }
+            }
+
+            uint32_t left = static_cast<uint32_t>(m_nodes.size());
+            m_nodes[task.node].first = left;
+            m_nodes[task.node].count = 0;
+            m_nodes[task.node].axis = static_cast<uint16_t>(axis);
+            m_nodes.push_back(Node{});
+            m_nodes.push_back(Node{});
+            tasks.push_back({left + 1, mid, task.first + task.count - mid, task.depth + 1});
+            tasks.push_back({left, task.first, mid - task.first, task.depth + 1});
+        }
+    }
+
+    /**
+     * Update boxes after objects moved (same object count); keeps the tree topology
+     * A different count rebuilds the tree.
+     */
+    void refit(const BvhBounds* bounds, size_t count) {
+        if (count != m_indices.size()) {
+            build(bounds, count);
+            return;
+        }
+        for (size_t i = 0; i < count; i++) {
+            m_bounds[i] = bounds[m_indices[i]];
+        }
+        // Children are always stored after their parent, so a reverse sweep is bottom-up
+        for (size_t n = m_nodes.size(); n-- > 0;) {
+            updateNodeBounds(m_nodes[n]);
+        }
+    }
+
+    /**
+     * Nearest hit of one ray
+     * @param accept Filter called with object indices; rejected objects are ignored
+     */
+    template <typename Accept = BvhAcceptAll>
+    BvhHit intersect(const BvhRay& ray, Accept accept = Accept()) const {
+        BvhHit hit;
+        hit.distance = ray.tMax;
+        if (m_nodes.empty()) {
+            return hit;
+        }
+        int hitAxis = 0;
+        uint32_t stack[STACK_SIZE];
+        uint32_t stackSize = 0;
+        stack[stackSize++] = 0;
+        while (stackSize > 0) {
+            const Node& node = m_nodes[stack[--stackSize]];
+            float tEnter, tExit;
+            int axis;
+            bvhRayBox(ray, node.min, node.max, tEnter, tExit, axis);
+            // Equal distances are still visited so ties resolve by index exactly like the reference
+            if (tExit < std::max(tEnter, 0.0f) || tEnter > hit.distance) {
+                continue;
+            }
+            if (node.count > 0) {
+                for (uint32_t i = node.first; i < node.first + node.count; i++) {
+                    uint32_t index = m_indices[i];
+                    if (!accept(index)) {
+                        continue;
+                    }
+                    bvhRayBox(ray, m_bounds[i].min, m_bounds[i].max, tEnter, tExit, axis);
+                    if (tEnter >= 0.0f && tEnter <= tExit && bvhCloser(tEnter, index, hit)) {
+                        hit.index = static_cast<int32_t>(index);
+                        hit.distance = tEnter;
+                        hitAxis = axis;
+                    }
+                }
+            } else {
+                // Visit the child on the ray's side of the split first
+                bool backToFront = ray.dir[node.axis] < 0.0f;
+                stack[stackSize++] = node.first + (backToFront ? 0 : 1);
+                stack[stackSize++] = node.first + (backToFront ? 1 : 0);
+            }
+        }
+        if (hit.index >= 0) {
+            bvhSetNormal(hit, hitAxis, ray.dir);
+        }
+        return hit;
+    }
+
+    /**
+     * Nearest hits of four rays traversed together (SSE2 packet; best for coherent rays such as
+     * neighbouring probes or screen pixels). Same results as four intersect() calls.
+     */
+    template <typename Accept = BvhAcceptAll>
+    void intersect4(const BvhRay rays[4], BvhHit hits[4], Accept accept = Accept()) const {
+#ifdef EDEN_BVH_SSE2
+        if (m_nodes.empty()) {
+            for (int lane = 0; lane < 4; lane++) {
+                hits[lane] = BvhHit();
+                hits[lane].distance = rays[lane].tMax;
+            }
+            return;
+        }
+        const __m128 ox = _mm_setr_ps(rays[0].origin[0], rays[1].origin[0], rays[2].origin[0], rays[3].origin[0]);
+        const __m128 oy = _mm_setr_ps(rays[0].origin[1], rays[1].origin[1], rays[2].origin[1], rays[3].origin[1]);
+        const __m128 oz = _mm_setr_ps(rays[0].origin[2], rays[1].origin[2], rays[2].origin[2], rays[3].origin[2]);
+        const __m128 ix = _mm_setr_ps(rays[0].invDir[0], rays[1].invDir[0], rays[2].invDir[0], rays[3].invDir[0]);
+        const __m128 iy = _mm_setr_ps(rays[0].invDir[1], rays[1].invDir[1], rays[2].invDir[1], rays[3].invDir[1]);
+        const __m128 iz = _mm_setr_ps(rays[0].invDir[2], rays[1].invDir[2], rays[2].invDir[2], rays[3].invDir[2]);
+        const __m128 zero = _mm_setzero_ps();
+        __m128 best = _mm_setr_ps(rays[0].tMax, rays[1].tMax, rays[2].tMax, rays[3].tMax);
+        __m128i bestIndex = _mm_set1_epi32(-1);
+        __m128i bestAxis = _mm_setzero_si128();
+
+        uint32_t stack[STACK_SIZE];
+        uint32_t stackSize = 0;
+        stack[stackSize++] = 0;
+        while (stackSize > 0) {
+            const Node& node = m_nodes[stack[--stackSize]];
+            __m128 tEnter, tExit, nearX, nearY, nearZ;
+            bvhSlab4(ox, oy, oz, ix, iy, iz, node.min, node.max, tEnter, tExit, nearX, nearY, nearZ);
+            __m128 live = _mm_and_ps(_mm_cmpge_ps(tExit, _mm_max_ps(tEnter, zero)), _mm_cmple_ps(tEnter, best));
+            if (_mm_movemask_ps(live) == 0) {
+                continue;
+            }
+            if (node.count > 0) {
+                for (uint32_t i = node.first; i < node.first + node.count; i++) {
+                    uint32_t index = m_indices[i];
+                    if (!accept(index)) {
+                        continue;
+                    }
+                    bvhSlab4(ox, oy, oz, ix, iy, iz, m_bounds[i].min, m_bounds[i].max, tEnter, tExit, nearX, nearY, nearZ);
+                    __m128i indexVec = _mm_set1_epi32(static_cast<int32_t>(index));
+                    // Closer, or equally close with a lower index than a previous hit
+                    __m128 tie = _mm_and_ps(_mm_cmpeq_ps(tEnter, best),
+                                            _mm_castsi128_ps(_mm_and_si128(_mm_cmpgt_epi32(bestIndex, indexVec),
+                                                                           _mm_cmpgt_epi32(bestIndex, _mm_set1_epi32(-1)))));
+                    __m128 take = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(tEnter, zero), _mm_cmple_ps(tEnter, tExit)),
+                                             _mm_or_ps(_mm_cmplt_ps(tEnter, best), tie));
+                    if (_mm_movemask_ps(take) == 0) {
+                        continue;
+                    }
+                    // Entry axis, preferring X then Y then Z on ties
+                    __m128 isX = _mm_and_ps(_mm_cmpge_ps(nearX, nearY), _mm_cmpge_ps(nearX, nearZ));
+                    __m128 isY = _mm_andnot_ps(isX, _mm_cmpge_ps(nearY, nearZ));
+                    __m128i axis = _mm_or_si128(_mm_and_si128(_mm_castps_si128(isY), _mm_set1_epi32(1)),
+                                                _mm_andnot_si128(_mm_castps_si128(_mm_or_ps(isX, isY)), _mm_set1_epi32(2)));
+                    __m128i takeI = _mm_castps_si128(take);
+                    best = _mm_or_ps(_mm_and_ps(take, tEnter), _mm_andnot_ps(take, best));
+                    bestIndex = _mm_or_si128(_mm_and_si128(takeI, indexVec), _mm_andnot_si128(takeI, bestIndex));
+                    bestAxis = _mm_or_si128(_mm_and_si128(takeI, axis), _mm_andnot_si128(takeI, bestAxis));
+                }
+            } else {
+                bool backToFront = rays[0].dir[node.axis] < 0.0f;
+                stack[stackSize++] = node.first + (backToFront ? 0 : 1);
+                stack[stackSize++] = node.first + (backToFront ? 1 : 0);
+            }
+        }
+
+        alignas(16) float distances[4];
+        alignas(16) int32_t indices[4];
+        alignas(16) int32_t axes[4];
+        _mm_store_ps(distances, best);
+        _mm_store_si128(reinterpret_cast<__m128i*>(indices), bestIndex);
+        _mm_store_si128(reinterpret_cast<__m128i*>(axes), bestAxis);
+        for (int lane = 0; lane < 4; lane++) {
+            hits[lane] = BvhHit();
+            hits[lane].index = indices[lane];
+            hits[lane].distance = distances[lane];
+            if (indices[lane] >= 0) {
+                bvhSetNormal(hits[lane], axes[lane], rays[lane].dir);
+            }
+        }
+#else
+        for (int lane = 0; lane < 4; lane++) {
+            hits[lane] = intersect(rays[lane], accept);
+        }
+#endif
+    }
+
+    void clear() {
+        m_nodes.clear();
+        m_indices.clear();
+        m_bounds.clear();
+    }
+
+    bool empty() const { return m_indices.empty(); }
+    size_t getObjectCount() const { return m_indices.size(); }
+    size_t getNodeCount() const { return m_nodes.size(); }
+    const std::vector<Node>& getNodes() const { return m_nodes; }
+};
+
+/**
+ * BvhRayBatch - Many rays as SOA arrays (one entry per ray)
+ *
+ * Directions should be unit length. Leave dirX/dirY/dirZ null when every ray shares `direction`
+ * (e.g. straight-down ground probes). Rays are traced four at a time as packets; large batches are
+ * first ordered along a Morton curve through their origins so each packet's rays start together.
+ */
+struct BvhRayBatch {
+    const float* originX = nullptr;
+    const float* originY = nullptr;
+    const float* originZ = nullptr;
+    const float* dirX = nullptr;
+    const float* dirY = nullptr;
+    const float* dirZ = nullptr;
+    float direction[3] = {0.0f, -1.0f, 0.0f};
+    size_t count = 0;
+    float tMax = 1e30f;
+};
+
+/**
+ * BvhHitBatch - Per-ray results of a batch: object index (-1 = miss) and distance (tMax on a miss)
+ * normalX/Y/Z are optional (null = not written).
+ */
+struct BvhHitBatch {
+    int32_t* index = nullptr;
+    float* distance = nullptr;
+    float* normalX = nullptr;
+    float* normalY = nullptr;
+    float* normalZ = nullptr;
+};
+
+// Spread the low 10 bits of v so there are two zero bits between each (Morton encoding)
+static inline uint32_t bvhMortonSpread(uint32_t v) {
+    v &= 0x3FF;
+    v = (v | (v << 16)) & 0x030000FF;
+    v = (v | (v << 8)) & 0x0300F00F;
+    v = (v | (v << 4)) & 0x030C30C3;
+    v = (v | (v << 2)) & 0x09249249;
+    return v;
+}
+
+// Ray order along a Morton curve through the ray origins, so consecutive rays (packet lanes, and
+// packets traced one after another) start close together and walk the same nodes
+static std::vector<uint32_t> bvhCoherentOrder(const BvhRayBatch& rays) {
+    float lo[3] = {1e30f, 1e30f, 1e30f};
+    float hi[3] = {-1e30f, -1e30f, -1e30f};
+    const float* origins[3] = {rays.originX, rays.originY, rays.originZ};
+    for (int a = 0; a < 3; a++) {
+        for (size_t i = 0; i < rays.count; i++) {
+            lo[a] = std::min(lo[a], origins[a][i]);
+            hi[a] = std::max(hi[a], origins[a][i]);
+        }
+    }
+    float scale[3];
+    for (int a = 0; a < 3; a++) {
+        scale[a] = hi[a] > lo[a] ? 1023.0f / (hi[a] - lo[a]) : 0.0f;
+    }
+
+    // Radix sort of (30-bit code, ray) pairs, 10 bits per pass
+    std::vector<uint64_t> keys(rays.count), sorted(rays.count);
+    for (size_t i = 0; i < rays.count; i++) {
+        uint32_t code = 0;
+        for (int a = 0; a < 3; a++) {
+            code |= bvhMortonSpread(static_cast<uint32_t>((origins[a][i] - lo[a]) * scale[a])) << a;
+        }
+        keys[i] = (static_cast<uint64_t>(code) << 32) | static_cast<uint32_t>(i);
+    }
+    for (int shift = 32; shift < 62; shift += 10) {
+        size_t offsets[1025] = {0};
+        for (uint64_t key : keys) {
+            offsets[((key >> shift) & 0x3FF) + 1]++;
+        }
+        for (int b = 0; b < 1024; b++) {
+            offsets[b + 1] += offsets[b];
+        }
+        for (uint64_t key : keys) {
+            sorted[offsets[(key >> shift) & 0x3FF]++] = key;
+        }
+        keys.swap(sorted);
+    }
+
+    std::vector<uint32_t> order(rays.count);
+    for (size_t i = 0; i < rays.count; i++) {
+        order[i] = static_cast<uint32_t>(keys[i]);
+    }
+    return order;
+}
+
+// Trace rays order[begin, end) of a batch (or rays [begin, end) without an order): packets of
+// four, single rays for the tail
+template <typename Accept>
+static void bvhIntersectBatchRange(const Bvh& bvh, const BvhRayBatch& rays, const BvhHitBatch& hits,
+                                   const uint32_t* order, size_t begin, size_t end, Accept accept) {
+    auto makeRay = [&rays](size_t i) {
+        return bvh_make_ray(rays.originX[i], rays.originY[i], rays.originZ[i],
+                            rays.dirX ? rays.dirX[i] : rays.direction[0],
+                            rays.dirY ? rays.dirY[i] : rays.direction[1],
+                            rays.dirZ ? rays.dirZ[i] : rays.direction[2], rays.tMax);
+    };
+    auto store = [&hits](size_t i, const BvhHit& hit) {
+        hits.index[i] = hit.index;
+        hits.distance[i] = hit.distance;
+        if (hits.normalX) hits.normalX[i] = hit.normal[0];
+        if (hits.normalY) hits.normalY[i] = hit.normal[1];
+        if (hits.normalZ) hits.normalZ[i] = hit.normal[2];
+    };
+
+    size_t i = begin;
+    BvhRay packet[4];
+    BvhHit packetHits[4];
+    size_t rayIndex[4];
+    for (; i + 4 <= end; i += 4) {
+        for (size_t lane = 0; lane < 4; lane++) {
+            rayIndex[lane] = order ? order[i + lane] : i + lane;
+            packet[lane] = makeRay(rayIndex[lane]);
+        }
+        bvh.intersect4(packet, packetHits, accept);
+        for (size_t lane = 0; lane < 4; lane++) {
+            store(rayIndex[lane], packetHits[lane]);
+        }
+    }
+    for (; i < end; i++) {
+        size_t index = order ? order[i] : i;
+        store(index, bvh.intersect(makeRay(index), accept));
+    }
+}
+
+/**
+ * Nearest hits for a whole batch of rays in one call
+ *
+ * Usage (ground-snap dropped items):
+ *   BvhRayBatch rays;
+ *   rays.originX = xs; rays.originY = ys; rays.originZ = zs;   // direction defaults to straight down
+ *   rays.count = itemCount;
+ *   rays.tMax = 100.0f;
+ *   BvhHitBatch hits;
+ *   hits.index = hitIndices; hits.distance = hitDistances;
+ *   bvh_intersect_batch(bvh, rays, hits);
+ *
+ * @param threadCount  Worker threads for large batches (0 = hardware concurrency)
+ * @param accept       Per-object filter, as for Bvh::intersect (called from several threads)
+ * @return Number of rays that hit something
+ */
+template <typename Accept = BvhAcceptAll>
+inline size_t bvh_intersect_batch(const Bvh& bvh, const BvhRayBatch& rays, const BvhHitBatch& hits,
+                                  uint32_t threadCount = 0, Accept accept = Accept()) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Small batches are traced as given; larger ones in Morton order of their origins
+    const size_t MIN_RAYS_TO_REORDER = 256;
+    std::vector<uint32_t> order;
+    if (rays.count >= MIN_RAYS_TO_REORDER) {
+        order = bvhCoherentOrder(rays);
+    }
+    const uint32_t* orderData = order.empty() ? nullptr : order.data();
+
+    const size_t MIN_RAYS_PER_THREAD = 2048;
+    uint32_t workers = static_cast<uint32_t>(std::min<size_t>(threadCount, rays.count / MIN_RAYS_PER_THREAD));
+    if (workers <= 1) {
+        bvhIntersectBatchRange(bvh, rays, hits, orderData, 0, rays.count, accept);
+    } else {
+        std::vector<std::thread> threads;
+        size_t raysPerWorker = ((rays.count + workers - 1) / workers + 3) & ~static_cast<size_t>(3);
+        for (uint32_t w = 0; w < workers; w++) {
+            size_t begin = w * raysPerWorker;
+            size_t end = std::min(rays.count, begin + raysPerWorker);
+            if (begin >= end) {
+                break;
+            }
+            threads.emplace_back([&bvh, &rays, &hits, orderData, begin, end, accept]() {
+                bvhIntersectBatchRange(bvh, rays, hits, orderData, begin, end, accept);
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+
+    size_t hitCount = 0;
+    for (size_t i = 0; i < rays.count; i++) {
+        hitCount += hits.index[i] >= 0 ? 1 : 0;
+    }
+    return hitCount;
+}
+
+#endif // EDEN_BVH_H
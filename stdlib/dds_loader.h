@@ -10,6 +10,8 @@
 #include <string>
 #include <fstream>
 #include <cstring>
+#include <cstdint>
+#include <algorithm>
 
 // DDS constants
 #define DDS_MAGIC 0x20534444  // "DDS " in little-endian
@@ -101,19 +103,20 @@ static VkFormat dxgiFormatToVulkan(uint32_t dxgiFormat) {
     switch (dxgiFormat) {
         // BC compressed formats
         case 71:  return VK_FORMAT_BC1_RGB_UNORM_BLOCK;      // DXGI_FORMAT_BC1_UNORM
-        case 72:  return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;     // DXGI_FORMAT_BC1_UNORM_SRGB
+        case 72:  return VK_FORMAT_BC1_RGB_SRGB_BLOCK;       // DXGI_FORMAT_BC1_UNORM_SRGB
         case 74:  return VK_FORMAT_BC2_UNORM_BLOCK;          // DXGI_FORMAT_BC2_UNORM
-        case 75:  return VK_FORMAT_BC2_UNORM_BLOCK;          // DXGI_FORMAT_BC2_UNORM_SRGB (use same format)
+        case 75:  return VK_FORMAT_BC2_SRGB_BLOCK;           // DXGI_FORMAT_BC2_UNORM_SRGB
         case 77:  return VK_FORMAT_BC3_UNORM_BLOCK;          // DXGI_FORMAT_BC3_UNORM
-        case 78:  return VK_FORMAT_BC3_UNORM_BLOCK;          // DXGI_FORMAT_BC3_UNORM_SRGB (use same format)
+        case 78:  return VK_FORMAT_BC3_SRGB_BLOCK;           // DXGI_FORMAT_BC3_UNORM_SRGB
         case 80:  return VK_FORMAT_BC4_UNORM_BLOCK;          // DXGI_FORMAT_BC4_UNORM
         case 81:  return VK_FORMAT_BC4_SNORM_BLOCK;          // DXGI_FORMAT_BC4_SNORM
         case 83:  return VK_FORMAT_BC5_UNORM_BLOCK;          // DXGI_FORMAT_BC5_UNORM (RG/BC5U)
         case 84:  return VK_FORMAT_BC5_SNORM_BLOCK;          // DXGI_FORMAT_BC5_SNORM
         case 95:  return VK_FORMAT_BC6H_UFLOAT_BLOCK;        // DXGI_FORMAT_BC6H_UF16
         case 96:  return VK_FORMAT_BC6H_SFLOAT_BLOCK;        // DXGI_FORMAT_BC6H_SF16
-        case 97:  return VK_FORMAT_BC7_UNORM_BLOCK;          // DXGI_FORMAT_BC7_UNORM
-        case 98:  return VK_FORMAT_BC7_SRGB_BLOCK;           // DXGI_FORMAT_BC7_UNORM_SRGB
+        case 97:  return VK_FORMAT_BC7_UNORM_BLOCK;          // DXGI_FORMAT_BC7_TYPELESS
+        case 98:  return VK_FORMAT_BC7_UNORM_BLOCK;          // DXGI_FORMAT_BC7_UNORM
+        case 99:  return VK_FORMAT_BC7_SRGB_BLOCK;           // DXGI_FORMAT_BC7_UNORM_SRGB
         
         // Uncompressed formats (less common, but handle them)
         case 28:  return VK_FORMAT_R8G8B8A8_UNORM;           // DXGI_FORMAT_R8G8B8A8_UNORM
@@ -155,12 +158,16 @@ static uint32_t getBlockSize(VkFormat format) {
     switch (format) {
         case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
         case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+        case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
         case VK_FORMAT_BC4_UNORM_BLOCK:
         case VK_FORMAT_BC4_SNORM_BLOCK:
             return 8;  // 64 bits per 4x4 block
         
         case VK_FORMAT_BC2_UNORM_BLOCK:
+        case VK_FORMAT_BC2_SRGB_BLOCK:
         case VK_FORMAT_BC3_UNORM_BLOCK:
+        case VK_FORMAT_BC3_SRGB_BLOCK:
         case VK_FORMAT_BC5_UNORM_BLOCK:
         case VK_FORMAT_BC5_SNORM_BLOCK:
         case VK_FORMAT_BC6H_UFLOAT_BLOCK:
@@ -188,27 +195,13 @@ static uint32_t calculateMipmapSize(uint32_t width, uint32_t height, VkFormat fo
     return blocksWide * blocksHigh * blockSize;
 }
 
-// Load DDS file and extract compressed data
-inline DDSData load_dds(const std::string& path) {
-    DDSData result = {};
-    result.format = VK_FORMAT_UNDEFINED;
-    result.mipmapCount = 1;
-    result.arraySize = 1;
-    result.hasAlpha = false;
-    
-    std::ifstream file(path, std::ios::binary);
-    if (!file.is_open()) {
-        // Return empty result - caller should check format != VK_FORMAT_UNDEFINED
-        // Note: File not found or cannot open - check path/permissions
-        return result;
-    }
-    
+// Read the magic, header (and DX10 header) and fill format/size fields; the stream is left at the pixel data
+static bool readDDSHeader(std::ifstream& file, DDSData& result) {
     // Read magic number
     uint32_t magic = 0;
     file.read(reinterpret_cast<char*>(&magic), sizeof(uint32_t));
     if (magic != DDS_MAGIC) {
-        file.close();
-        return result;  // Invalid DDS file
+        return false;  // Invalid DDS file
     }
     
     // Read header
@@ -217,13 +210,15 @@ inline DDSData load_dds(const std::string& path) {
     
     // Validate header
     if (header.size != 124) {
-        file.close();
-        return result;  // Invalid header size
+        return false;  // Invalid header size
     }
     
     result.width = header.width;
     result.height = header.height;
     result.mipmapCount = (header.flags & DDSD_MIPMAPCOUNT) ? header.mipMapCount : 1;
+    if (result.mipmapCount == 0) {
+        result.mipmapCount = 1;
+    }
     result.hasAlpha = (header.ddspf.flags & DDPF_ALPHAPIXELS) != 0;
     
     // Determine format
@@ -249,23 +244,76 @@ inline DDSData load_dds(const std::string& path) {
                 result.format = result.hasAlpha ? VK_FORMAT_R8G8B8A8_UNORM : VK_FORMAT_B8G8R8A8_UNORM;
             } else {
                 // Unsupported uncompressed format
-                file.close();
-                return result;
+                return false;
             }
         } else {
             // Unsupported format
-            file.close();
-            return result;
+            return false;
         }
     }
     
     // Check if format is supported
-    if (result.format == VK_FORMAT_UNDEFINED) {
-        file.close();
+    return result.format != VK_FORMAT_UNDEFINED && static_cast<bool>(file);
+}
+
+// Read only the DDS header: format, size and mip count (compressedData stays empty)
+inline DDSData load_dds_header(const std::string& path) {
+    DDSData result = {};
+    result.format = VK_FORMAT_UNDEFINED;
+    result.mipmapCount = 1;
+    result.arraySize = 1;
+    result.hasAlpha = false;
+    
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open() || !readDDSHeader(file, result)) {
+        result.format = VK_FORMAT_UNDEFINED;
+    }
+    return result;
+}
+
+/**
+ * Load DDS file and extract compressed data
+ * @param firstLevel/levelCount Read only mips [firstLevel, firstLevel + levelCount) of a non-array
+ *        texture (the file is read from the first requested level only). width/height/mipmapCount
+ *        of the result then describe the returned levels.
+ */
+inline DDSData load_dds(const std::string& path, uint32_t firstLevel = 0, uint32_t levelCount = UINT32_MAX) {
+    DDSData result = {};
+    result.format = VK_FORMAT_UNDEFINED;
+    result.mipmapCount = 1;
+    result.arraySize = 1;
+    result.hasAlpha = false;
+    
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        // Return empty result - caller should check format != VK_FORMAT_UNDEFINED
+        // Note: File not found or cannot open - check path/permissions
+        return result;
+    }
+    
+    if (!readDDSHeader(file, result)) {
+        result.format = VK_FORMAT_UNDEFINED;
         return result;
     }
     
-    // Calculate total data size (all mipmaps)
+    if (firstLevel > 0 || levelCount < result.mipmapCount) {
+        if (result.arraySize != 1 || firstLevel >= result.mipmapCount) {
+            result.format = VK_FORMAT_UNDEFINED;
+            return result;  // Partial reads are only defined for single 2D textures
+        }
+        
+        // Skip the levels before firstLevel
+        uint64_t skipBytes = 0;
+        for (uint32_t i = 0; i < firstLevel; i++) {
+            skipBytes += calculateMipmapSize(result.width, result.height, result.format);
+            result.width = result.width > 1 ? result.width / 2 : 1;
+            result.height = result.height > 1 ? result.height / 2 : 1;
+        }
+        file.seekg(static_cast<std::streamoff>(skipBytes), std::ios::cur);
+        result.mipmapCount = std::min(levelCount, result.mipmapCount - firstLevel);
+    }
+    
+    // Calculate total data size (all requested mipmaps)
     uint32_t totalSize = 0;
     uint32_t currentWidth = result.width;
     uint32_t currentHeight = result.height;
@@ -0,0 +1,387 @@
+// EDEN ENGINE - Debug Draw
+// Immediate-mode debug lines (lines, rays, boxes, circles, spheres, cones) batched per frame.
+// Every primitive becomes line-list vertices in one CPU array per category: depth-tested, or
+// overlay (drawn on top of everything). No Vulkan types: build() copies both categories into
+// plain memory (a persistently mapped vertex buffer), after which each category is one draw.
+
+#ifndef EDEN_DEBUG_DRAW_H
+#define EDEN_DEBUG_DRAW_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/**
+ * DebugVertex - One line-list vertex (16 bytes)
+ *
+ * color is RGBA8 with red in the lowest byte, i.e. VK_FORMAT_R8G8B8A8_UNORM on little-endian hosts.
+ */
+struct DebugVertex {
+    float position[3];
+    uint32_t color;
+};
+
+static_assert(sizeof(DebugVertex) == 16, "DebugVertex must match the debug line vertex layout");
+
+// Depth: hidden behind geometry like any other line. Overlay: always visible.
+enum class DebugDrawCategory : uint32_t {
+    Depth = 0,
+    Overlay = 1
+};
+
+static constexpr uint32_t DEBUG_DRAW_CATEGORY_COUNT = 2;
+
+// Vertices of one category inside the buffer written by DebugDrawList::build (one vkCmdDraw)
+struct DebugDrawRange {
+    uint32_t firstVertex = 0;
+    uint32_t vertexCount = 0;
+};
+
+// Pack a 0..1 color into DebugVertex::color
+inline uint32_t debug_pack_color(float r, float g, float b, float a = 1.0f) {
+    auto channel = [](float value) -> uint32_t {
+        value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+        return static_cast<uint32_t>(value * 255.0f + 0.5f);
+    };
+    return channel(r) | (channel(g) << 8) | (channel(b) << 16) | (channel(a) << 24);
+}
+
+/**
+ * Two unit vectors perpendicular to `axis` (assumed normalized) and to each other
+ */
+inline void debug_orthonormal_basis(const float axis[3], float u[3], float v[3]) {
+    // Cross with the world axis least aligned with `axis`
+    float helper[3] = {0.0f, 0.0f, 0.0f};
+    float ax = std::fabs(axis[0]);
+    float ay = std::fabs(axis[1]);
+    float az = std::fabs(axis[2]);
+    helper[ax <= ay && ax <= az ? 0 : (ay <= az ? 1 : 2)] = 1.0f;
+    u[0] = axis[1] * helper[2] - axis[2] * helper[1];
+    u[1] = axis[2] * helper[0] - axis[0] * helper[2];
+    u[2] = axis[0] * helper[1] - axis[1] * helper[0];
+    float length = std::sqrt(u[0] * u[0] + u[1] * u[1] + u[2] * u[2]);
+    u[0] /= length;
+    u[1] /= length;
+    u[2] /= length;
+    v[0] = axis[1] * u[2] - axis[2] * u[1];
+    v[1] = axis[2] * u[0] - axis[0] * u[2];
+    v[2] = axis[0] * u[1] - axis[1] * u[0];
+}
+
+/**
+ * DebugDrawList - Per-frame debug line batch
+ *
+ * Provides:
+ * - Primitives: line, ray, box (rotated), aabb, circle, sphere, cone, cross
+ * - Two categories (DebugDrawCategory): depth-tested and overlay, kept in separate arrays
+ * - build(): both categories back to back into one destination, with the draw range of each
+ * - A vertex budget shared by both categories. A primitive that does not fit is dropped whole
+ *   and counted (getDroppedPrimitives), so a runaway loop cannot grow memory without bound.
+ *
+ * The arrays keep their capacity across clear(), so a steady frame allocates nothing.
+ *
+ * Usage:
+ *   DebugDrawList debug(65536);
+ *   debug.line(0, 0, 0, 1, 2, 3, debug_pack_color(1, 1, 0));
+ *   debug.box(center, rotation, size, debug_pack_color(1, 1, 1), DebugDrawCategory::Overlay);
+ *   DebugDrawRange ranges[DEBUG_DRAW_CATEGORY_COUNT];
+ *   debug.build(mappedVertices, capacity, ranges);
+ *   for each category: vkCmdBindPipeline(...); vkCmdDraw(cmd, ranges[c].vertexCount, 1, ranges[c].firstVertex, 0);
+ *   debug.clear();
+ */
+class DebugDrawList {
+private:
+    std::vector<DebugVertex> m_vertices[DEBUG_DRAW_CATEGORY_COUNT];
+    size_t m_maxVertices;
+    size_t m_droppedPrimitives = 0;
+
+    // Room for `lineCount` more lines in `category`, or nullptr (primitive dropped) over budget
+    DebugVertex* appendLines(DebugDrawCategory category, size_t lineCount) {
+        size_t add = lineCount * 2;
+        if (getVertexCount() + add > m_maxVertices) {
+            m_droppedPrimitives++;
+            return nullptr;
+        }
+        std::vector<DebugVertex>& vertices = m_vertices[static_cast<uint32_t>(category)];
+        size_t start = vertices.size();
+        vertices.resize(start + add);
+        return vertices.data() + start;
+    }
+
+    static void setVertex(DebugVertex& vertex, float x, float y, float z, uint32_t color) {
+        vertex.position[0] = x;
+        vertex.position[1] = y;
+        vertex.position[2] = z;
+        vertex.color = color;
+    }
+
+    // `segments` points of the circle center + radius * (cos * u + sin * v), written as a closed loop
+    static void writeRing(DebugVertex* out, const float center[3], const float u[3], const float v[3],
+                          float radius, uint32_t segments, uint32_t color) {
+        // Rotate (c, s) by a fixed step instead of calling cos/sin per point
+        float step = 6.28318530717959f / static_cast<float>(segments);
+        float stepC = std::cos(step);
+        float stepS = std::sin(step);
+        float c = 1.0f;
+        float s = 0.0f;
+        float previous[3] = {center[0] + radius * u[0], center[1] + radius * u[1], center[2] + radius * u[2]};
+        for (uint32_t i = 1; i <= segments; i++) {
+            float nextC = c * stepC - s * stepS;
+            s = s * stepC + c * stepS;
+            c = nextC;
+            float point[3];
+            if (i == segments) {
+                point[0] = center[0] + radius * u[0];   // Close the loop exactly
+                point[1] = center[1] + radius * u[1];
+                point[2] = center[2] + radius * u[2];
+            } else {
+                for (int k = 0; k < 3; k++) {
+                    point[k] = center[k] + radius * (c * u[k] + s * v[k]);
+                }
+            }
+            setVertex(out[(i - 1) * 2], previous[0], previous[1], previous[2], color);
+            setVertex(out[(i - 1) * 2 + 1], point[0], point[1], point[2], color);
+            previous[0] = point[0];
+            previous[1] = point[1];
+            previous[2] = point[2];
+        }
+    }
+
+    // The 12 edges of the box with the given 8 corners (bit 0: +x, bit 1: +y, bit 2: +z)
+    static void writeBoxEdges(DebugVertex* out, const float corners[8][3], uint32_t color) {
+        static const uint8_t EDGES[12][2] = {
+            {0, 1}, {2, 3}, {4, 5}, {6, 7},     // Along x
+            {0, 2}, {1, 3}, {4, 6}, {5, 7},     // Along y
+            {0, 4}, {1, 5}, {2, 6}, {3, 7}      // Along z
+        };
+        for (int e = 0; e < 12; e++) {
+            const float* a = corners[EDGES[e][0]];
+            const float* b = corners[EDGES[e][1]];
+            setVertex(out[e * 2], a[0], a[1], a[2], color);
+            setVertex(out[e * 2 + 1], b[0], b[1], b[2], color);
+        }
+    }
+
+public:
+    explicit DebugDrawList(size_t maxVertices = 1 << 20) : m_maxVertices(maxVertices) {}
+
+    // Vertex budget for both categories together (the size of one frame's vertex buffer region)
+    void setMaxVertices(size_t maxVertices) { m_maxVertices = maxVertices; }
+    size_t getMaxVertices() const { return m_maxVertices; }
+
+    // Start a new frame (keeps the allocated capacity)
+    void clear() {
+        for (std::vector<DebugVertex>& vertices : m_vertices) {
+            vertices.clear();
+        }
+        m_droppedPrimitives = 0;
+    }
+
+    void line(float x1, float y1, float z1, float x2, float y2, float z2, uint32_t color,
+              DebugDrawCategory category = DebugDrawCategory::Depth) {
+        DebugVertex* out = appendLines(category, 1);
+        if (out != nullptr) {
+            setVertex(out[0], x1, y1, z1, color);
+            setVertex(out[1], x2, y2, z2, color);
+        }
+    }
+
+    // From `origin` along `direction` (any length; normalized here) for `length` units
+    void ray(const float origin[3], const float direction[3], float length, uint32_t color,
+             DebugDrawCategory category = DebugDrawCategory::Depth) {
+        float norm = std::sqrt(direction[0] * direction[0] + direction[1] * direction[1] + direction[2] * direction[2]);
+        if (norm <= 0.0f) {
+            return;
+        }
+        float scale = length / norm;
+        line(origin[0], origin[1], origin[2],
+             origin[0] + direction[0] * scale, origin[1] + direction[1] * scale, origin[2] + direction[2] * scale,
+             color, category);
+    }
+
+    void aabb(const float minCorner[3], const float maxCorner[3], uint32_t color,
+              DebugDrawCategory category = DebugDrawCategory::Depth) {
+        DebugVertex* out = appendLines(category, 12);
+        if (out == nullptr) {
+            return;
+        }
+        float corners[8][3];
+        for (int i = 0; i < 8; i++) {
+            corners[i][0] = (i & 1) ? maxCorner[0] : minCorner[0];
+            corners[i][1] = (i & 2) ? maxCorner[1] : minCorner[1];
+            corners[i][2] = (i & 4) ? maxCorner[2] : minCorner[2];
+        }
+        writeBoxEdges(out, corners, color);
+    }
+
+    /**
+     * Wireframe box of full size `size` around `center`, rotated by rotationDegrees[0] about X,
+     * then [1] about Y, then [2] about Z
+     */
+    void box(const float center[3], const float rotationDegrees[3], const float size[3], uint32_t color,
+             DebugDrawCategory category = DebugDrawCategory::Depth) {
+        if (rotationDegrees[0] == 0.0f && rotationDegrees[1] == 0.0f && rotationDegrees[2] == 0.0f) {
+            float minCorner[3];
+            float maxCorner[3];
+            for (int k = 0; k < 3; k++) {
+                minCorner[k] = center[k] - size[k] * 0.5f;
+                maxCorner[k] = center[k] + size[k] * 0.5f;
+            }
+            aabb(minCorner, maxCorner, color, category);
+            return;
+        }
+        DebugVertex* out = appendLines(category, 12);
+        if (out == nullptr) {
+            return;
+        }
+        const float toRad = 3.14159265358979f / 180.0f;
+        float cx = std::cos(rotationDegrees[0] * toRad), sx = std::sin(rotationDegrees[0] * toRad);
+        float cy = std::cos(rotationDegrees[1] * toRad), sy = std::sin(rotationDegrees[1] * toRad);
+        float cz = std::cos(rotationDegrees[2] * toRad), sz = std::sin(rotationDegrees[2] * toRad);
+        // Columns of R = Rz * Ry * Rx, each scaled by the half extent on that axis
+        float axes[3][3] = {
+            {cy * cz, cy * sz, -sy},
+            {sx * sy * cz - cx * sz, sx * sy * sz + cx * cz, sx * cy},
+            {cx * sy * cz + sx * sz, cx * sy * sz - sx * cz, cx * cy}
+        };
+        float corners[8][3];
+        for (int i = 0; i < 8; i++) {
+            float hx = (i & 1) ? size[0] * 0.5f : -size[0] * 0.5f;
+            float hy = (i & 2) ? size[1] * 0.5f : -size[1] * 0.5f;
+            float hz = (i & 4) ? size[2] * 0.5f : -size[2] * 0.5f;
+            for (int k = 0; k < 3; k++) {
+                corners[i][k] = center[k] + axes[0][k] * hx + axes[1][k] * hy + axes[2][k] * hz;
+            }
+        }
+        writeBoxEdges(out, corners, color);
+    }
+
+    // Circle of `radius` around `center` in the plane perpendicular to `normal`
+    void circle(const float center[3], const float normal[3], float radius, uint32_t color,
+                DebugDrawCategory category = DebugDrawCategory::Depth, uint32_t segments = 32) {
+        float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        if (length <= 0.0f || segments < 3) {
+            return;
+        }
+        DebugVertex* out = appendLines(category, segments);
+        if (out == nullptr) {
+            return;
+        }
+        float axis[3] = {normal[0] / length, normal[1] / length, normal[2] / length};
+        float u[3];
+        float v[3];
+        debug_orthonormal_basis(axis, u, v);
+        writeRing(out, center, u, v, radius, segments, color);
+    }
+
+    // Three great circles (XY, YZ, XZ planes)
+    void sphere(const float center[3], float radius, uint32_t color,
+                DebugDrawCategory category = DebugDrawCategory::Depth, uint32_t segments = 32) {
+        if (segments < 3) {
+            return;
+        }
+        DebugVertex* out = appendLines(category, segments * 3);
+        if (out == nullptr) {
+            return;
+        }
+        static const float X[3] = {1.0f, 0.0f, 0.0f};
+        static const float Y[3] = {0.0f, 1.0f, 0.0f};
+        static const float Z[3] = {0.0f, 0.0f, 1.0f};
+        writeRing(out, center, X, Y, radius, segments, color);
+        writeRing(out + segments * 2, center, Y, Z, radius, segments, color);
+        writeRing(out + segments * 4, center, X, Z, radius, segments, color);
+    }
+
+    /**
+     * Cone from `apex` along `direction` for `length`, with half-angle `halfAngleRadians` (a spot
+     * light's range and outer cone): the base circle plus `sides` lines from the apex to it
+     */
+    void cone(const float apex[3], const float direction[3], float length, float halfAngleRadians, uint32_t color,
+              DebugDrawCategory category = DebugDrawCategory::Depth, uint32_t segments = 32, uint32_t sides = 8) {
+        float norm = std::sqrt(direction[0] * direction[0] + direction[1] * direction[1] + direction[2] * direction[2]);
+        if (norm <= 0.0f || segments < 3) {
+            return;
+        }
+        sides = sides < segments ? sides : segments;
+        DebugVertex* out = appendLines(category, segments + sides);
+        if (out == nullptr) {
+            return;
+        }
+        // Keep the base finite for a (nearly) flat cone
+        const float maxHalfAngle = 1.55f;
+        float halfAngle = halfAngleRadians < maxHalfAngle ? halfAngleRadians : maxHalfAngle;
+        float radius = length * std::tan(halfAngle < 0.0f ? 0.0f : halfAngle);
+        float axis[3] = {direction[0] / norm, direction[1] / norm, direction[2] / norm};
+        float baseCenter[3] = {apex[0] + axis[0] * length, apex[1] + axis[1] * length, apex[2] + axis[2] * length};
+        float u[3];
+        float v[3];
+        debug_orthonormal_basis(axis, u, v);
+        writeRing(out, baseCenter, u, v, radius, segments, color);
+        // Side lines end on ring points, evenly spaced around the base
+        DebugVertex* sideLines = out + segments * 2;
+        for (uint32_t i = 0; i < sides; i++) {
+            const DebugVertex& onRing = out[(i * segments / sides) * 2];
+            setVertex(sideLines[i * 2], apex[0], apex[1], apex[2], color);
+            sideLines[i * 2 + 1] = onRing;
+        }
+    }
+
+    // Three axis-aligned lines of length `size` through `center` (a point marker)
+    void cross(const float center[3], float size, uint32_t color,
+               DebugDrawCategory category = DebugDrawCategory::Depth) {
+        DebugVertex* out = appendLines(category, 3);
+        if (out == nullptr) {
+            return;
+        }
+        float h = size * 0.5f;
+        for (int axis = 0; axis < 3; axis++) {
+            float a[3] = {center[0], center[1], center[2]};
+            float b[3] = {center[0], center[1], center[2]};
+            a[axis] -= h;
+            b[axis] += h;
+            setVertex(out[axis * 2], a[0], a[1], a[2], color);
+            setVertex(out[axis * 2 + 1], b[0], b[1], b[2], color);
+        }
+    }
+
+    /**
+     * Copy both categories into `out` (Depth first, then Overlay) and report each one's range
+     * @param capacity Vertices `out` can hold; a category that does not fit is cut at a line boundary
+     * @return Vertices written
+     */
+    size_t build(DebugVertex* out, size_t capacity, DebugDrawRange ranges[DEBUG_DRAW_CATEGORY_COUNT]) const {
+        size_t written = 0;
+        for (uint32_t c = 0; c < DEBUG_DRAW_CATEGORY_COUNT; c++) {
+            size_t count = m_vertices[c].size();
+            size_t room = (capacity - written) & ~static_cast<size_t>(1);
+            count = count < room ? count : room;
+            if (count > 0) {
+                std::memcpy(out + written, m_vertices[c].data(), count * sizeof(DebugVertex));
+            }
+            ranges[c].firstVertex = static_cast<uint32_t>(written);
+            ranges[c].vertexCount = static_cast<uint32_t>(count);
+            written += count;
+        }
+        return written;
+    }
+
+    const std::vector<DebugVertex>& getVertices(DebugDrawCategory category) const {
+        return m_vertices[static_cast<uint32_t>(category)];
+    }
+
+    size_t getVertexCount() const {
+        size_t count = 0;
+        for (const std::vector<DebugVertex>& vertices : m_vertices) {
+            count += vertices.size();
+        }
+        return count;
+    }
+
+    size_t getLineCount() const { return getVertexCount() / 2; }
+    size_t getDroppedPrimitives() const { return m_droppedPrimitives; }
+    bool empty() const { return getVertexCount() == 0; }
+};
+
+#endif // EDEN_DEBUG_DRAW_H
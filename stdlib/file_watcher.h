@@ -0,0 +1,374 @@
+// EDEN ENGINE - FileWatcher
+// Central change-notification service for hot-reload (resources, shaders, hot systems)
+// Linux uses inotify so idle frames never touch the filesystem; other platforms fall back
+// to throttled stat() polling. Changes are debounced and delivered as one batch per frame.
+
+#ifndef EDEN_FILE_WATCHER_H
+#define EDEN_FILE_WATCHER_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <chrono>
+#include <ctime>
+#include <cstdint>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <sys/stat.h>
+#include <io.h>
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <cerrno>
+#define EDEN_FILE_WATCHER_INOTIFY
+#endif
+
+/**
+ * FileWatcher - Batched, debounced file change notifications
+ *
+ * Provides:
+ * - One registration per path (watch/unwatch)
+ * - inotify-backed watching on Linux (directory watches, so editors that save via
+ *   rename-over are still detected)
+ * - Polling fallback (stat every pollInterval ms, not every frame) when inotify is
+ *   unavailable or a directory cannot be watched
+ * - Debouncing: a burst of writes to one file is reported once, after it settles
+ *
+ * Usage (once per frame):
+ *   FileWatcher& watcher = FileWatcher::get_instance();
+ *   watcher.watch("textures/brick.dds");
+ *   watcher.poll();
+ *   if (watcher.wasChanged("textures/brick.dds")) { ... }
+ */
+class FileWatcher {
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    struct WatchEntry {
+        std::string eventKey;       // "wd/name" key used to match inotify events (empty if polled)
+        int wd;                     // inotify descriptor of the file's directory (-1 if polled)
+        std::time_t lastModified;   // Only used by the polling fallback
+        bool polled;                // true if this entry is stat()-polled instead of inotify
+    };
+
+    std::unordered_map<std::string, WatchEntry> m_entries;                       // path -> entry
+    std::unordered_map<std::string, std::vector<std::string>> m_eventKeyToPaths; // "wd/name" -> paths
+    std::unordered_map<std::string, Clock::time_point> m_pending;                // path -> last event time
+    std::vector<std::string> m_changes;                                          // Last delivered batch
+
+    uint32_t m_debounceMs = 50;
+    uint32_t m_pollIntervalMs = 250;
+    Clock::time_point m_lastScan = Clock::now();
+    size_t m_polledCount = 0;
+
+#ifdef EDEN_FILE_WATCHER_INOTIFY
+    int m_inotifyFd = -1;
+    std::unordered_map<int, uint32_t> m_wdRefCount;   // watched files per descriptor
+#endif
+
+    FileWatcher() {
+#ifdef EDEN_FILE_WATCHER_INOTIFY
+        m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+    }
+
+    /**
+     * Get file modification time
+     * @return Modification time, or 0 if file doesn't exist
+     */
+    static std::time_t getFileModificationTime(const std::string& filepath) {
+#ifdef _WIN32
+        struct _stat fileStat;
+        if (_stat(filepath.c_str(), &fileStat) == 0) {
+            return fileStat.st_mtime;
+        }
+#else
+        struct stat fileStat;
+        if (stat(filepath.c_str(), &fileStat) == 0) {
+            return fileStat.st_mtime;
+        }
+#endif
+        return 0;
+    }
+
+    // Split "a/b/c.png" into ("a/b", "c.png"); bare file names live in "."
+    static void splitPath(const std::string& path, std::string& dir, std::string& name) {
+        size_t slash = path.find_last_of("/\\");
+        if (slash == std::string::npos) {
+            dir = ".";
+            name = path;
+        } else {
+            dir = slash == 0 ? path.substr(0, 1) : path.substr(0, slash);
+            name = path.substr(slash + 1);
+        }
+    }
+
+    void markPending(const std::string& path, Clock::time_point now) {
+        m_pending[path] = now;
+    }
+
+#ifdef EDEN_FILE_WATCHER_INOTIFY
+    // Drain the inotify queue (non-blocking). Idle frames cost a single read() that returns EAGAIN.
+    void drainInotify(Clock::time_point now) {
+        if (m_inotifyFd < 0) {
+            return;
+        }
+
+        alignas(struct inotify_event) char buffer[4096];
+        for (;;) {
+            ssize_t length = read(m_inotifyFd, buffer, sizeof(buffer));
+            if (length <= 0) {
+                break; // EAGAIN (queue empty) or error
+            }
+
+            for (char* ptr = buffer; ptr < buffer + length; ) {
+                const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(ptr);
+                ptr += sizeof(struct inotify_event) + event->len;
+
+                if (event->mask & IN_Q_OVERFLOW) {
+                    // Kernel dropped events - conservatively treat every watched file as changed
+                    for (const auto& entry : m_entries) {
+                        markPending(entry.first, now);
+                    }
+                    continue;
+                }
+                if (event->len == 0) {
+                    continue;
+                }
+
+                auto pathIt = m_eventKeyToPaths.find(std::to_string(event->wd) + "/" + event->name);
+                if (pathIt != m_eventKeyToPaths.end()) {
+                    for (const std::string& path : pathIt->second) {
+                        markPending(path, now);
+                    }
+                }
+            }
+        }
+    }
+
+    // Watch a directory and return its descriptor (-1 on failure). The kernel hands back the same
+    // descriptor for every spelling of one directory ("textures", "./textures/", a symlink to it),
+    // so descriptors, not path strings, identify directories and carry the reference count.
+    int addInotifyWatch(const std::string& dir) {
+        if (m_inotifyFd < 0) {
+            return -1;
+        }
+
+        int wd = inotify_add_watch(m_inotifyFd, dir.c_str(),
+                                   IN_CLOSE_WRITE | IN_MOVED_TO | IN_MODIFY | IN_CREATE);
+        if (wd < 0) {
+            return -1;
+        }
+
+        m_wdRefCount[wd]++;
+        return wd;
+    }
+
+    void removeInotifyWatch(int wd) {
+        auto it = m_wdRefCount.find(wd);
+        if (it == m_wdRefCount.end()) {
+            return;
+        }
+
+        if (--it->second == 0) {
+            inotify_rm_watch(m_inotifyFd, wd);
+            m_wdRefCount.erase(it);
+        }
+    }
+#endif
+
+    // Polling fallback: stat() every polled entry, but only once per poll interval
+    void scanPolled(Clock::time_point now) {
+        if (m_polledCount == 0) {
+            return;
+        }
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - m_lastScan).count();
+        if (elapsed < static_cast<long long>(m_pollIntervalMs)) {
+            return;
+        }
+        m_lastScan = now;
+
+        for (auto& entry : m_entries) {
+            if (!entry.second.polled) {
+                continue;
+            }
+            std::time_t currentModified = getFileModificationTime(entry.first);
+            if (currentModified > entry.second.lastModified && currentModified > 0) {
+                entry.second.lastModified = currentModified;
+                markPending(entry.first, now);
+            }
+        }
+    }
+
+public:
+    ~FileWatcher() {
+#ifdef EDEN_FILE_WATCHER_INOTIFY
+        if (m_inotifyFd >= 0) {
+            close(m_inotifyFd);
+            m_inotifyFd = -1;
+        }
+#endif
+    }
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    /**
+     * Get the process-wide watcher (shared by resources, shaders and hot systems)
+     */
+    static FileWatcher& get_instance() {
+        static FileWatcher instance;
+        return instance;
+    }
+
+    /**
+     * Start watching a file. Watching the same path twice is a no-op.
+     * The file does not need to exist yet (its directory does for inotify).
+     * Different spellings of one file ("textures/a.png", "./textures/a.png") are separate
+     * registrations that share a directory watch; a change is reported under each of them.
+     * @param path Path to file, as it will later be passed to wasChanged()
+     */
+    void watch(const std::string& path) {
+        if (path.empty() || m_entries.count(path)) {
+            return;
+        }
+
+        std::string dir, name;
+        splitPath(path, dir, name);
+
+        WatchEntry entry;
+        entry.wd = -1;
+        entry.lastModified = getFileModificationTime(path);
+        entry.polled = true;
+
+#ifdef EDEN_FILE_WATCHER_INOTIFY
+        entry.wd = addInotifyWatch(dir);
+        if (entry.wd >= 0) {
+            entry.polled = false;
+            entry.eventKey = std::to_string(entry.wd) + "/" + name;
+            m_eventKeyToPaths[entry.eventKey].push_back(path);
+        }
+#endif
+
+        if (entry.polled) {
+            m_polledCount++;
+        }
+        m_entries[path] = entry;
+    }
+
+    /**
+     * Stop watching a file
+     */
+    void unwatch(const std::string& path) {
+        auto it = m_entries.find(path);
+        if (it == m_entries.end()) {
+            return;
+        }
+
+#ifdef EDEN_FILE_WATCHER_INOTIFY
+        if (!it->second.polled) {
+            auto keyIt = m_eventKeyToPaths.find(it->second.eventKey);
+            if (keyIt != m_eventKeyToPaths.end()) {
+                std::vector<std::string>& paths = keyIt->second;
+                paths.erase(std::remove(paths.begin(), paths.end(), path), paths.end());
+                if (paths.empty()) {
+                    m_eventKeyToPaths.erase(keyIt);
+                }
+            }
+            removeInotifyWatch(it->second.wd);
+        }
+#endif
+
+        if (it->second.polled) {
+            m_polledCount--;
+        }
+        m_pending.erase(path);
+        m_entries.erase(it);
+    }
+
+    /**
+     * Collect file system events and deliver the debounced batch.
+     * Call once per frame, before any wasChanged() queries.
+     * @return Paths whose writes settled since the previous poll (empty on idle frames)
+     */
+    const std::vector<std::string>& poll() {
+        m_changes.clear();
+        Clock::time_point now = Clock::now();
+
+#ifdef EDEN_FILE_WATCHER_INOTIFY
+        drainInotify(now);
+#endif
+        scanPolled(now);
+
+        if (m_pending.empty()) {
+            return m_changes;
+        }
+
+        for (auto it = m_pending.begin(); it != m_pending.end(); ) {
+            auto quietMs = std::chrono::duration_cast<std::chrono::milliseconds>(now - it->second).count();
+            if (quietMs >= static_cast<long long>(m_debounceMs)) {
+                m_changes.push_back(it->first);
+                it = m_pending.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        return m_changes;
+    }
+
+    /**
+     * Get the batch delivered by the last poll()
+     */
+    const std::vector<std::string>& getChanges() const {
+        return m_changes;
+    }
+
+    /**
+     * Check if a path is part of the batch delivered by the last poll()
+     */
+    bool wasChanged(const std::string& path) const {
+        if (m_changes.empty()) {
+            return false;
+        }
+        return std::find(m_changes.begin(), m_changes.end(), path) != m_changes.end();
+    }
+
+    /**
+     * Quiet period a file must settle for before its change is delivered (default 50ms)
+     */
+    void setDebounceMs(uint32_t ms) {
+        m_debounceMs = ms;
+    }
+
+    /**
+     * Interval between stat() sweeps for polled entries (default 250ms)
+     */
+    void setPollIntervalMs(uint32_t ms) {
+        m_pollIntervalMs = ms;
+    }
+
+    /**
+     * Check if events come from the kernel (inotify) rather than polling
+     */
+    bool usingInotify() const {
+#ifdef EDEN_FILE_WATCHER_INOTIFY
+        return m_inotifyFd >= 0;
+#else
+        return false;
+#endif
+    }
+
+    size_t getWatchCount() const {
+        return m_entries.size();
+    }
+};
+
+#endif // EDEN_FILE_WATCHER_H
@@ -0,0 +1,418 @@
+// EDEN ENGINE - Frustum Culler
+// CPU visibility stage for renderer draw lists: view-frustum planes from a view-projection matrix,
+// bounding boxes/spheres packed as SOA and tested four at a time with SSE2 (optionally also
+// against a maximum view distance), large lists split across threads. The result is a compact,
+// ordered list of visible indices. A scalar reference culler is kept for verification.
+
+#ifndef EDEN_FRUSTUM_CULLER_H
+#define EDEN_FRUSTUM_CULLER_H
+
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EDEN_CULL_SSE2 1
+#include <emmintrin.h>
+#endif
+
+/**
+ * FrustumPlanes - The six frustum planes (left, right, bottom, top, near, far), stored SOA
+ *
+ * Normals point into the frustum and are unit length, so nx*x + ny*y + nz*z + d is the signed
+ * distance of a point from a plane (negative = outside).
+ */
+struct FrustumPlanes {
+    float nx[6];
+    float ny[6];
+    float nz[6];
+    float d[6];
+};
+
+/**
+ * Multiply two column-major 4x4 matrices (same layout as glm::mat4 / Mat4::m): out = a * b
+ */
+inline void multiply_mat4(const float a[16], const float b[16], float out[16]) {
+    float result[16];
+    for (int col = 0; col < 4; col++) {
+        for (int row = 0; row < 4; row++) {
+            result[col * 4 + row] = a[0 * 4 + row] * b[col * 4 + 0] + a[1 * 4 + row] * b[col * 4 + 1] +
+                                    a[2 * 4 + row] * b[col * 4 + 2] + a[3 * 4 + row] * b[col * 4 + 3];
+        }
+    }
+    memcpy(out, result, sizeof(result));
+}
+
+/**
+ * Extract frustum planes from a column-major view-projection matrix (Gribb/Hartmann)
+ * @param zeroToOneDepth Clip-space depth is [0, 1] (Vulkan, glm::perspectiveRH_ZO) rather than [-1, 1]
+ *
+ * A flipped Y (proj[1][1] *= -1) only swaps the bottom and top planes, so it needs no special case.
+ */
+inline FrustumPlanes extract_frustum_planes(const float viewProj[16], bool zeroToOneDepth = true) {
+    // Row i of a column-major matrix is (m[i], m[4 + i], m[8 + i], m[12 + i])
+    float rows[4][4];
+    for (int i = 0; i < 4; i++) {
+        rows[i][0] = viewProj[i];
+        rows[i][1] = viewProj[4 + i];
+        rows[i][2] = viewProj[8 + i];
+        rows[i][3] = viewProj[12 + i];
+    }
+
+    float planes[6][4];
+    for (int k = 0; k < 4; k++) {
+        planes[0][k] = rows[3][k] + rows[0][k];     // Left
+        planes[1][k] = rows[3][k] - rows[0][k];     // Right
+        planes[2][k] = rows[3][k] + rows[1][k];     // Bottom
+        planes[3][k] = rows[3][k] - rows[1][k];     // Top
+        planes[4][k] = zeroToOneDepth ? rows[2][k] : rows[3][k] + rows[2][k];  // Near
+        planes[5][k] = rows[3][k] - rows[2][k];     // Far
+    }
+
+    FrustumPlanes result;
+    for (int p = 0; p < 6; p++) {
+        float length = std::sqrt(planes[p][0] * planes[p][0] + planes[p][1] * planes[p][1] + planes[p][2] * planes[p][2]);
+        float invLength = length > 0.0f ? 1.0f / length : 0.0f;
+        result.nx[p] = planes[p][0] * invLength;
+        result.ny[p] = planes[p][1] * invLength;
+        result.nz[p] = planes[p][2] * invLength;
+        result.d[p] = planes[p][3] * invLength;
+    }
+    return result;
+}
+
+/**
+ * Extract frustum planes from separate column-major view and projection matrices
+ */
+inline FrustumPlanes extract_frustum_planes(const float view[16], const float proj[16], bool zeroToOneDepth = true) {
+    float viewProj[16];
+    multiply_mat4(proj, view, viewProj);
+    return extract_frustum_planes(viewProj, zeroToOneDepth);
+}
+
+/**
+ * CullParams - Everything an object is tested against
+ *
+ * maxDistance > 0 also culls objects whose closest point is farther than maxDistance from eye.
+ */
+struct CullParams {
+    FrustumPlanes planes;
+    float eye[3] = {0.0f, 0.0f, 0.0f};
+    float maxDistance = 0.0f;
+};
+
+/**
+ * CullBoxes - World-space axis-aligned bounding boxes (center + half extents), one array per component
+ */
+struct CullBoxes {
+    std::vector<float> centerX, centerY, centerZ;
+    std::vector<float> extentX, extentY, extentZ;
+
+    void clear() {
+        centerX.clear(); centerY.clear(); centerZ.clear();
+        extentX.clear(); extentY.clear(); extentZ.clear();
+    }
+
+    void reserve(size_t count) {
+        centerX.reserve(count); centerY.reserve(count); centerZ.reserve(count);
+        extentX.reserve(count); extentY.reserve(count); extentZ.reserve(count);
+    }
+
+    void add(float cx, float cy, float cz, float ex, float ey, float ez) {
+        centerX.push_back(cx); centerY.push_back(cy); centerZ.push_back(cz);
+        extentX.push_back(ex); extentY.push_back(ey); extentZ.push_back(ez);
+    }
+
+    size_t size() const { return centerX.size(); }
+};
+
+/**
+ * CullSpheres - World-space bounding spheres, one array per component
+ */
+struct CullSpheres {
+    std::vector<float> centerX, centerY, centerZ;
+    std::vector<float> radius;
+
+    void clear() {
+        centerX.clear(); centerY.clear(); centerZ.clear();
+        radius.clear();
+    }
+
+    void reserve(size_t count) {
+        centerX.reserve(count); centerY.reserve(count); centerZ.reserve(count);
+        radius.reserve(count);
+    }
+
+    void add(float cx, float cy, float cz, float r) {
+        centerX.push_back(cx); centerY.push_back(cy); centerZ.push_back(cz);
+        radius.push_back(r);
+    }
+
+    size_t size() const { return centerX.size(); }
+};
+
+// Scalar box test (the SSE2 path evaluates the same expressions in the same order)
+static inline bool cullBoxVisible(const CullParams& params, float cx, float cy, float cz, float ex, float ey, float ez) {
+    const FrustumPlanes& planes = params.planes;
+    for (int p = 0; p < 6; p++) {
+        // Distance of the box's most-inside corner: center distance + projected half extents
+        float dist = planes.nx[p] * cx + planes.ny[p] * cy + planes.nz[p] * cz + planes.d[p];
+        float radius = std::fabs(planes.nx[p]) * ex + std::fabs(planes.ny[p]) * ey + std::fabs(planes.nz[p]) * ez;
+        if (dist + radius < 0.0f) {
+            return false;
+        }
+    }
+    if (params.maxDistance > 0.0f) {
+        float dx = std::max(std::fabs(cx - params.eye[0]) - ex, 0.0f);
+        float dy = std::max(std::fabs(cy - params.eye[1]) - ey, 0.0f);
+        float dz = std::max(std::fabs(cz - params.eye[2]) - ez, 0.0f);
+        if (dx * dx + dy * dy + dz * dz > params.maxDistance * params.maxDistance) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Scalar sphere test
+static inline bool cullSphereVisible(const CullParams& params, float cx, float cy, float cz, float r) {
+    const FrustumPlanes& planes = params.planes;
+    for (int p = 0; p < 6; p++) {
+        float dist = planes.nx[p] * cx + planes.ny[p] * cy + planes.nz[p] * cz + planes.d[p];
+        if (dist + r < 0.0f) {
+            return false;
+        }
+    }
+    if (params.maxDistance > 0.0f) {
+        float dx = cx - params.eye[0];
+        float dy = cy - params.eye[1];
+        float dz = cz - params.eye[2];
+        float reach = params.maxDistance + r;
+        if (dx * dx + dy * dy + dz * dz > reach * reach) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#ifdef EDEN_CULL_SSE2
+// Append the indices of the set lanes of a 4-lane mask. Branchless: every lane is stored, the write
+// pointer only advances past visible ones (the stores stay inside the caller's [begin, end) room)
+static inline uint32_t* cullWriteVisible(uint32_t* out, int mask, uint32_t base) {
+    out[0] = base;
+    out += mask & 1;
+    out[0] = base + 1;
+    out += (mask >> 1) & 1;
+    out[0] = base + 2;
+    out += (mask >> 2) & 1;
+    out[0] = base + 3;
+    out += (mask >> 3) & 1;
+    return out;
+}
+#endif
+
+// Cull boxes [begin, end) and write visible indices to out (room for end - begin); returns the count
+static size_t cullBoxRange(const CullBoxes& boxes, const CullParams& params, size_t begin, size_t end, uint32_t* out) {
+    uint32_t* write = out;
+    size_t i = begin;
+#ifdef EDEN_CULL_SSE2
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 zero = _mm_setzero_ps();
+    const bool distanceTest = params.maxDistance > 0.0f;
+    const __m128 maxDistSq = _mm_set1_ps(params.maxDistance * params.maxDistance);
+    const __m128 eyeX = _mm_set1_ps(params.eye[0]);
+    const __m128 eyeY = _mm_set1_ps(params.eye[1]);
+    const __m128 eyeZ = _mm_set1_ps(params.eye[2]);
+    const FrustumPlanes& planes = params.planes;
+
+    for (; i + 4 <= end; i += 4) {
+        __m128 cx = _mm_loadu_ps(&boxes.centerX[i]);
+        __m128 cy = _mm_loadu_ps(&boxes.centerY[i]);
+        __m128 cz = _mm_loadu_ps(&boxes.centerZ[i]);
+        __m128 ex = _mm_loadu_ps(&boxes.extentX[i]);
+        __m128 ey = _mm_loadu_ps(&boxes.extentY[i]);
+        __m128 ez = _mm_loadu_ps(&boxes.extentZ[i]);
+
+        __m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int p = 0; p < 6; p++) {
+            __m128 dist = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes.nx[p]), cx),
+                                                           _mm_mul_ps(_mm_set1_ps(planes.ny[p]), cy)),
+                                                _mm_mul_ps(_mm_set1_ps(planes.nz[p]), cz)),
+                                     _mm_set1_ps(planes.d[p]));
+            __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(std::fabs(planes.nx[p])), ex),
+                                                  _mm_mul_ps(_mm_set1_ps(std::fabs(planes.ny[p])), ey)),
+                                       _mm_mul_ps(_mm_set1_ps(std::fabs(planes.nz[p])), ez));
+            visible = _mm_and_ps(visible, _mm_cmpge_ps(_mm_add_ps(dist, radius), zero));
+        }
+        if (distanceTest) {
+            __m128 dx = _mm_max_ps(_mm_sub_ps(_mm_andnot_ps(signMask, _mm_sub_ps(cx, eyeX)), ex), zero);
+            __m128 dy = _mm_max_ps(_mm_sub_ps(_mm_andnot_ps(signMask, _mm_sub_ps(cy, eyeY)), ey), zero);
+            __m128 dz = _mm_max_ps(_mm_sub_ps(_mm_andnot_ps(signMask, _mm_sub_ps(cz, eyeZ)), ez), zero);
+            __m128 distSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+            visible = _mm_and_ps(visible, _mm_cmple_ps(distSq, maxDistSq));
+        }
+        write = cullWriteVisible(write, _mm_movemask_ps(visible), static_cast<uint32_t>(i));
+    }
+#endif
+    for (; i < end; i++) {
+        if (cullBoxVisible(params, boxes.centerX[i], boxes.centerY[i], boxes.centerZ[i],
+                           boxes.extentX[i], boxes.extentY[i], boxes.extentZ[i])) {
+            *write++ = static_cast<uint32_t>(i);
+        }
+    }
+    return static_cast<size_t>(write - out);
+}
+
+// Cull spheres [begin, end) and write visible indices to out (room for end - begin); returns the count
+static size_t cullSphereRange(const CullSpheres& spheres, const CullParams& params, size_t begin, size_t end, uint32_t* out) {
+    uint32_t* write = out;
+    size_t i = begin;
+#ifdef EDEN_CULL_SSE2
+    const __m128 zero = _mm_setzero_ps();
+    const bool distanceTest = params.maxDistance > 0.0f;
+    const __m128 maxDist = _mm_set1_ps(params.maxDistance);
+    const __m128 eyeX = _mm_set1_ps(params.eye[0]);
+    const __m128 eyeY = _mm_set1_ps(params.eye[1]);
+    const __m128 eyeZ = _mm_set1_ps(params.eye[2]);
+    const FrustumPlanes& planes = params.planes;
+
+    for (; i + 4 <= end; i += 4) {
+        __m128 cx = _mm_loadu_ps(&spheres.centerX[i]);
+        __m128 cy = _mm_loadu_ps(&spheres.centerY[i]);
+        __m128 cz = _mm_loadu_ps(&spheres.centerZ[i]);
+        __m128 r = _mm_loadu_ps(&spheres.radius[i]);
+
+        __m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int p = 0; p < 6; p++) {
+            __m128 dist = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes.nx[p]), cx),
+                                                           _mm_mul_ps(_mm_set1_ps(planes.ny[p]), cy)),
+                                                _mm_mul_ps(_mm_set1_ps(planes.nz[p]), cz)),
+                                     _mm_set1_ps(planes.d[p]));
+            visible = _mm_and_ps(visible, _mm_cmpge_ps(_mm_add_ps(dist, r), zero));
+        }
+        if (distanceTest) {
+            __m128 dx = _mm_sub_ps(cx, eyeX);
+            __m128 dy = _mm_sub_ps(cy, eyeY);
+            __m128 dz = _mm_sub_ps(cz, eyeZ);
+            __m128 distSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+            __m128 reach = _mm_add_ps(maxDist, r);
+            visible = _mm_and_ps(visible, _mm_cmple_ps(distSq, _mm_mul_ps(reach, reach)));
+        }
+        write = cullWriteVisible(write, _mm_movemask_ps(visible), static_cast<uint32_t>(i));
+    }
+#endif
+    for (; i < end; i++) {
+        if (cullSphereVisible(params, spheres.centerX[i], spheres.centerY[i], spheres.centerZ[i], spheres.radius[i])) {
+            *write++ = static_cast<uint32_t>(i);
+        }
+    }
+    return static_cast<size_t>(write - out);
+}
+
+// Run a range culler over [0, count), split across threads for large lists; visible indices stay in order
+template <typename Objects, typename RangeCuller>
+static size_t cullParallel(const Objects& objects, size_t count, const CullParams& params,
+                           std::vector<uint32_t>& visible, uint32_t threadCount, RangeCuller cullRange) {
+    visible.resize(count);
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    const size_t MIN_OBJECTS_PER_THREAD = 16384;
+    uint32_t workers = static_cast<uint32_t>(std::min<size_t>(threadCount, count / MIN_OBJECTS_PER_THREAD));
+    if (workers <= 1) {
+        visible.resize(cullRange(objects, params, 0, count, visible.data()));
+        return visible.size();
+    }
+
+    // Each worker compacts its chunk in place at the chunk's start; chunks are then packed together
+    size_t perWorker = ((count + workers - 1) / workers + 3) & ~static_cast<size_t>(3);
+    std::vector<size_t> written(workers, 0);
+    std::vector<std::thread> threads;
+    for (uint32_t w = 0; w < workers; w++) {
+        size_t begin = w * perWorker;
+        size_t end = std::min(count, begin + perWorker);
+        if (begin >= end) {
+            break;
+        }
+        threads.emplace_back([&objects, &params, &visible, &written, &cullRange, w, begin, end]() {
+            written[w] = cullRange(objects, params, begin, end, visible.data() + begin);
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    size_t total = 0;
+    for (uint32_t w = 0; w < threads.size(); w++) {
+        size_t begin = w * perWorker;
+        if (total != begin && written[w] > 0) {
+            memmove(visible.data() + total, visible.data() + begin, written[w] * sizeof(uint32_t));
+        }
+        total += written[w];
+    }
+    visible.resize(total);
+    return total;
+}
+
+/**
+ * Cull bounding boxes against the frustum (and maxDistance, if set)
+ *
+ * Usage:
+ *   CullParams params;
+ *   params.planes = extract_frustum_planes(&view[0][0], &proj[0][0]);
+ *   std::vector<uint32_t> visible;
+ *   cull_boxes(boxes, params, visible);
+ *   for (uint32_t index : visible) drawObject(index);
+ *
+ * @param visible      Receives the indices of visible boxes in ascending order
+ * @param threadCount  Worker threads for large lists (0 = hardware concurrency)
+ * @return Number of visible boxes
+ */
+inline size_t cull_boxes(const CullBoxes& boxes, const CullParams& params, std::vector<uint32_t>& visible,
+                         uint32_t threadCount = 0) {
+    return cullParallel(boxes, boxes.size(), params, visible, threadCount, cullBoxRange);
+}
+
+/**
+ * Cull bounding spheres against the frustum (and maxDistance, if set)
+ * @param visible      Receives the indices of visible spheres in ascending order
+ * @param threadCount  Worker threads for large lists (0 = hardware concurrency)
+ * @return Number of visible spheres
+ */
+inline size_t cull_spheres(const CullSpheres& spheres, const CullParams& params, std::vector<uint32_t>& visible,
+                           uint32_t threadCount = 0) {
+    return cullParallel(spheres, spheres.size(), params, visible, threadCount, cullSphereRange);
+}
+
+/**
+ * Straightforward scalar, single-threaded box culling (same results as cull_boxes)
+ */
+inline size_t cull_boxes_reference(const CullBoxes& boxes, const CullParams& params, std::vector<uint32_t>& visible) {
+    visible.clear();
+    for (size_t i = 0; i < boxes.size(); i++) {
+        if (cullBoxVisible(params, boxes.centerX[i], boxes.centerY[i], boxes.centerZ[i],
+                           boxes.extentX[i], boxes.extentY[i], boxes.extentZ[i])) {
+            visible.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    return visible.size();
+}
+
+/**
+ * Straightforward scalar, single-threaded sphere culling (same results as cull_spheres)
+ */
+inline size_t cull_spheres_reference(const CullSpheres& spheres, const CullParams& params, std::vector<uint32_t>& visible) {
+    visible.clear();
+    for (size_t i = 0; i < spheres.size(); i++) {
+        if (cullSphereVisible(params, spheres.centerX[i], spheres.centerY[i], spheres.centerZ[i], spheres.radius[i])) {
+            visible.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    return visible.size();
+}
+
+#endif // EDEN_FRUSTUM_CULLER_H
@@ -0,0 +1,374 @@
+// EDEN ENGINE - GpuAllocator
+// Shared device memory allocator: large blocks per memory type, sub-allocated with TLSF
+// Replaces one vkAllocateMemory per buffer/image (drivers cap the allocation count, and
+// each call is slow). Huge resources still get dedicated allocations.
+
+#ifndef EDEN_GPU_ALLOCATOR_H
+#define EDEN_GPU_ALLOCATOR_H
+
+#include "vulkan.h"
+#include "gpu_block_allocator.h"
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <iostream>
+
+struct GpuMemoryBlock;
+
+/**
+ * GpuAllocation - A sub-range of device memory (or a dedicated allocation)
+ * Bind with vkBind*Memory(device, x, allocation.memory, allocation.offset).
+ */
+struct GpuAllocation {
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkDeviceSize offset = 0;
+    VkDeviceSize size = 0;
+    void* mapped = nullptr;             // Persistently mapped pointer (host-visible memory only)
+    GpuMemoryBlock* block = nullptr;    // Owning block (nullptr for dedicated allocations)
+
+    bool valid() const { return memory != VK_NULL_HANDLE; }
+};
+
+struct GpuMemoryBlock {
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    void* mapped = nullptr;
+    uint32_t poolIndex = 0;
+    GpuBlockAllocator allocator;
+
+    explicit GpuMemoryBlock(VkDeviceSize size) : allocator(size) {}
+};
+
+/**
+ * GpuAllocator - Process-wide device memory allocator
+ *
+ * Provides:
+ * - One pool per (memory type, linear/optimal) pair, so buffers and optimal-tiling images never
+ *   share a block and bufferImageGranularity cannot be violated
+ * - Blocks of 64MB (or 1/8 of small heaps), sub-allocated with GpuBlockAllocator
+ * - Dedicated allocations for anything larger than half a block
+ * - Persistent mapping of host-visible blocks (no per-upload vkMapMemory/vkUnmapMemory)
+ * - Empty blocks are released, except one per pool kept to avoid allocation churn
+ *
+ * Usage:
+ *   GpuAllocator::get_instance().init(physicalDevice, device);   // After vkCreateDevice
+ *   GpuAllocation alloc;
+ *   GpuAllocator::get_instance().createBuffer(size, usage, props, buffer, alloc);
+ *   memcpy(alloc.mapped, data, size);
+ *   vkDestroyBuffer(device, buffer, nullptr);
+ *   GpuAllocator::get_instance().free(alloc);
+ *   GpuAllocator::get_instance().shutdown();                     // Before vkDestroyDevice
+ */
+class GpuAllocator {
+public:
+    struct Stats {
+        uint32_t blockCount = 0;
+        VkDeviceSize blockBytes = 0;            // Device memory reserved by blocks
+        uint32_t dedicatedCount = 0;
+        VkDeviceSize dedicatedBytes = 0;
+        uint32_t allocationCount = 0;           // Live sub-allocations + dedicated allocations
+        VkDeviceSize usedBytes = 0;             // Bytes handed out (sub-allocations + dedicated)
+        uint64_t deviceAllocations = 0;         // Total vkAllocateMemory calls made
+    };
+
+private:
+    static constexpr VkDeviceSize DEFAULT_BLOCK_SIZE = 64ull * 1024 * 1024;
+
+    struct Pool {
+        uint32_t memoryTypeIndex = 0;
+        VkDeviceSize blockSize = DEFAULT_BLOCK_SIZE;
+        std::vector<std::unique_ptr<GpuMemoryBlock>> blocks;
+    };
+
+    VkDevice m_device = VK_NULL_HANDLE;
+    VkPhysicalDeviceMemoryProperties m_memoryProperties = {};
+    Pool m_pools[VK_MAX_MEMORY_TYPES * 2];      // [type * 2 + 0] = linear, [type * 2 + 1] = optimal
+    Stats m_stats;
+    std::mutex m_mutex;
+
+    GpuAllocator() = default;
+
+    uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const {
+        for (uint32_t i = 0; i < m_memoryProperties.memoryTypeCount; i++) {
+            if ((typeFilter & (1u << i)) &&
+                (m_memoryProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+                return i;
+            }
+        }
+        return UINT32_MAX;
+    }
+
+    bool isHostVisible(uint32_t memoryTypeIndex) const {
+        return (m_memoryProperties.memoryTypes[memoryTypeIndex].propertyFlags &
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0;
+    }
+
+    bool allocateDeviceMemory(VkDeviceSize size, uint32_t memoryTypeIndex, VkDeviceMemory& memory, void*& mapped) {
+        VkMemoryAllocateInfo allocInfo = {};
+        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.allocationSize = size;
+        allocInfo.memoryTypeIndex = memoryTypeIndex;
+
+        if (vkAllocateMemory(m_device, &allocInfo, nullptr, &memory) != VK_SUCCESS) {
+            memory = VK_NULL_HANDLE;
+            return false;
+        }
+        m_stats.deviceAllocations++;
+
+        mapped = nullptr;
+        if (isHostVisible(memoryTypeIndex) &&
+            vkMapMemory(m_device, memory, 0, VK_WHOLE_SIZE, 0, &mapped) != VK_SUCCESS) {
+            vkFreeMemory(m_device, memory, nullptr);
+            memory = VK_NULL_HANDLE;
+            return false;
+        }
+        return true;
+    }
+
+    void releaseBlock(Pool& pool, size_t index) {
+        GpuMemoryBlock* block = pool.blocks[index].get();
+        m_stats.blockCount--;
+        m_stats.blockBytes -= block->allocator.getCapacity();
+        vkFreeMemory(m_device, block->memory, nullptr);   // Implicitly unmaps
+        pool.blocks.erase(pool.blocks.begin() + index);
+    }
+
+    bool allocateLocked(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties,
+                        bool optimalTiling, GpuAllocation& out) {
+        out = GpuAllocation();
+        if (m_device == VK_NULL_HANDLE) {
+            std::cerr << "[EDEN] GpuAllocator used before init()" << std::endl;
+            return false;
+        }
+
+        uint32_t memoryTypeIndex = findMemoryType(requirements.memoryTypeBits, properties);
+        if (memoryTypeIndex == UINT32_MAX) {
+            return false;
+        }
+
+        uint32_t poolIndex = memoryTypeIndex * 2 + (optimalTiling ? 1 : 0);
+        Pool& pool = m_pools[poolIndex];
+
+        // Huge resources (render targets, big textures) would waste most of a block
+        if (requirements.size > pool.blockSize / 2) {
+            if (!allocateDeviceMemory(requirements.size, memoryTypeIndex, out.memory, out.mapped)) {
+                return false;
+            }
+            out.size = requirements.size;
+            m_stats.dedicatedCount++;
+            m_stats.dedicatedBytes += requirements.size;
+            m_stats.allocationCount++;
+            m_stats.usedBytes += requirements.size;
+            return true;
+        }
+
+        GpuMemoryBlock* target = nullptr;
+        uint64_t offset = GpuBlockAllocator::INVALID_OFFSET;
+        for (auto& block : pool.blocks) {
+            offset = block->allocator.allocate(requirements.size, requirements.alignment);
+            if (offset != GpuBlockAllocator::INVALID_OFFSET) {
+                target = block.get();
+                break;
+            }
+        }
+
+        if (!target) {
+            auto block = std::make_unique<GpuMemoryBlock>(pool.blockSize);
+            if (!allocateDeviceMemory(pool.blockSize, memoryTypeIndex, block->memory, block->mapped)) {
+                return false;
+            }
+            block->poolIndex = poolIndex;
+            offset = block->allocator.allocate(requirements.size, requirements.alignment);
+            target = block.get();
+            pool.blocks.push_back(std::move(block));
+            m_stats.blockCount++;
+            m_stats.blockBytes += pool.blockSize;
+        }
+
+        out.memory = target->memory;
+        out.offset = offset;
+        out.size = target->allocator.getAllocationSize(offset);
+        out.mapped = target->mapped ? static_cast<char*>(target->mapped) + offset : nullptr;
+        out.block = target;
+        m_stats.allocationCount++;
+        m_stats.usedBytes += out.size;
+        return true;
+    }
+
+public:
+    GpuAllocator(const GpuAllocator&) = delete;
+    GpuAllocator& operator=(const GpuAllocator&) = delete;
+
+    /**
+     * Get the process-wide allocator (shared by the renderer, TextureResource and MeshResource).
+     * Intentionally never destroyed; call shutdown() before destroying the device.
+     */
+    static GpuAllocator& get_instance() {
+        static GpuAllocator* instance = new GpuAllocator();
+        return *instance;
+    }
+
+    /**
+     * Bind the allocator to a device and size its pools from the memory heaps
+     */
+    void init(VkPhysicalDevice physicalDevice, VkDevice device) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_device = device;
+        vkGetPhysicalDeviceMemoryProperties(physicalDevice, &m_memoryProperties);
+
+        for (uint32_t type = 0; type < m_memoryProperties.memoryTypeCount; type++) {
+            VkDeviceSize heapSize = m_memoryProperties.memoryHeaps[m_memoryProperties.memoryTypes[type].heapIndex].size;
+            VkDeviceSize blockSize = heapSize / 8 < DEFAULT_BLOCK_SIZE ? heapSize / 8 : DEFAULT_BLOCK_SIZE;
+            for (uint32_t tiling = 0; tiling < 2; tiling++) {
+                m_pools[type * 2 + tiling].memoryTypeIndex = type;
+                m_pools[type * 2 + tiling].blockSize = blockSize > 0 ? blockSize : DEFAULT_BLOCK_SIZE;
+            }
+        }
+    }
+
+    bool isInitialized() const { return m_device != VK_NULL_HANDLE; }
+
+    /**
+     * Allocate memory for the given requirements
+     * @param optimalTiling true for optimal-tiling images, false for buffers and linear images
+     * @return false if no memory type matches or the device is out of memory
+     */
+    bool allocate(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties,
+                  bool optimalTiling, GpuAllocation& out) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return allocateLocked(requirements, properties, optimalTiling, out);
+    }
+
+    /**
+     * Release an allocation (the buffer/image bound to it must already be destroyed).
+     * Resets the allocation; freeing an invalid allocation is a no-op.
+     */
+    void free(GpuAllocation& allocation) {
+        if (!allocation.valid()) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_device == VK_NULL_HANDLE) {
+            // Already shut down (e.g. a global resource destroyed after the renderer) - blocks are gone
+            allocation = GpuAllocation();
+            return;
+        }
+        m_stats.allocationCount--;
+        m_stats.usedBytes -= allocation.size;
+
+        if (!allocation.block) {
+            vkFreeMemory(m_device, allocation.memory, nullptr);
+            m_stats.dedicatedCount--;
+            m_stats.dedicatedBytes -= allocation.size;
+            allocation = GpuAllocation();
+            return;
+        }
+
+        GpuMemoryBlock* block = allocation.block;
+        block->allocator.free(allocation.offset);
+        allocation = GpuAllocation();
+
+        if (block->allocator.isEmpty()) {
+            // Keep one empty block per pool warm; release any others
+            Pool& pool = m_pools[block->poolIndex];
+            size_t emptyBlocks = 0;
+            for (auto& candidate : pool.blocks) {
+                emptyBlocks += candidate->allocator.isEmpty() ? 1 : 0;
+            }
+            if (emptyBlocks > 1) {
+                for (size_t i = 0; i < pool.blocks.size(); i++) {
+                    if (pool.blocks[i].get() == block) {
+                        releaseBlock(pool, i);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * Create a buffer and bind it to newly allocated memory
+     * @return false on failure (buffer is left VK_NULL_HANDLE)
+     */
+    bool createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties,
+                      VkBuffer& buffer, GpuAllocation& allocation) {
+        VkBufferCreateInfo bufferInfo = {};
+        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.size = size;
+        bufferInfo.usage = usage;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        buffer = VK_NULL_HANDLE;
+        if (vkCreateBuffer(m_device, &bufferInfo, nullptr, &buffer) != VK_SUCCESS) {
+            buffer = VK_NULL_HANDLE;
+            return false;
+        }
+
+        VkMemoryRequirements memRequirements;
+        vkGetBufferMemoryRequirements(m_device, buffer, &memRequirements);
+
+        if (!allocate(memRequirements, properties, false, allocation)) {
+            vkDestroyBuffer(m_device, buffer, nullptr);
+            buffer = VK_NULL_HANDLE;
+            return false;
+        }
+
+        vkBindBufferMemory(m_device, buffer, allocation.memory, allocation.offset);
+        return true;
+    }
+
+    /**
+     * Create an image and bind it to newly allocated memory
+     * @return false on failure (image is left VK_NULL_HANDLE)
+     */
+    bool createImage(const VkImageCreateInfo& imageInfo, VkMemoryPropertyFlags properties,
+                     VkImage& image, GpuAllocation& allocation) {
+        image = VK_NULL_HANDLE;
+        if (vkCreateImage(m_device, &imageInfo, nullptr, &image) != VK_SUCCESS) {
+            image = VK_NULL_HANDLE;
+            return false;
+        }
+
+        VkMemoryRequirements memRequirements;
+        vkGetImageMemoryRequirements(m_device, image, &memRequirements);
+
+        bool optimalTiling = imageInfo.tiling == VK_IMAGE_TILING_OPTIMAL;
+        if (!allocate(memRequirements, properties, optimalTiling, allocation)) {
+            vkDestroyImage(m_device, image, nullptr);
+            image = VK_NULL_HANDLE;
+            return false;
+        }
+
+        vkBindImageMemory(m_device, image, allocation.memory, allocation.offset);
+        return true;
+    }
+
+    /**
+     * Release every block. All buffers/images must already be destroyed; call before vkDestroyDevice.
+     */
+    void shutdown() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_device == VK_NULL_HANDLE) {
+            return;
+        }
+
+        if (m_stats.allocationCount > 0) {
+            std::cerr << "[EDEN] GpuAllocator: " << m_stats.allocationCount
+                      << " allocation(s) still live at shutdown" << std::endl;
+        }
+
+        for (Pool& pool : m_pools) {
+            while (!pool.blocks.empty()) {
+                releaseBlock(pool, pool.blocks.size() - 1);
+            }
+        }
+        m_device = VK_NULL_HANDLE;
+    }
+
+    Stats getStats() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+};
+
+#endif // EDEN_GPU_ALLOCATOR_H
@@ -0,0 +1,337 @@
+// EDEN ENGINE - GpuBlockAllocator
+// TLSF (two-level segregated fit) offset allocator used to sub-allocate one device memory block
+// Pure bookkeeping over [0, capacity): no Vulkan calls, so it can be exercised CPU-side.
+
+#ifndef EDEN_GPU_BLOCK_ALLOCATOR_H
+#define EDEN_GPU_BLOCK_ALLOCATOR_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <unordered_map>
+
+/**
+ * GpuBlockAllocator - O(1) allocate/free of aligned ranges inside a fixed-size block
+ *
+ * Free ranges are kept in segregated lists indexed by (log2 size, 16 linear sub-classes),
+ * with bitmaps so the smallest suitable list is found with two bit scans. When no list is
+ * guaranteed to fit (size plus worst-case alignment padding), the few classes below are checked
+ * range by range, so a request that fits an aligned free range never fails.
+ * Freed ranges are merged with their physical neighbours immediately, so the block returns
+ * to a single free range once everything in it is released.
+ *
+ * Usage:
+ *   GpuBlockAllocator block(64ull * 1024 * 1024);
+ *   uint64_t offset = block.allocate(size, alignment);
+ *   if (offset != GpuBlockAllocator::INVALID_OFFSET) { ... block.free(offset); }
+ */
+class GpuBlockAllocator {
+public:
+    static constexpr uint64_t INVALID_OFFSET = UINT64_MAX;
+
+private:
+    static constexpr uint32_t SL_BITS = 4;                        // 16 sub-classes per power of two
+    static constexpr uint32_t SL_COUNT = 1u << SL_BITS;
+    static constexpr uint32_t SMALL_BITS = 8;                     // Sizes < 256 share linear classes
+    static constexpr uint64_t SMALL_SIZE = 1ull << SMALL_BITS;
+    static constexpr uint32_t FL_COUNT = 64 - SMALL_BITS + 1;
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    struct Range {
+        uint64_t offset = 0;
+        uint64_t size = 0;
+        uint32_t prevPhysical = NONE;   // Neighbouring ranges in address order
+        uint32_t nextPhysical = NONE;
+        uint32_t prevFree = NONE;       // Links within the segregated free list
+        uint32_t nextFree = NONE;
+        bool free = false;
+    };
+
+    std::vector<Range> m_ranges;
+    std::vector<uint32_t> m_unusedRanges;                          // Recycled Range slots
+    std::unordered_map<uint64_t, uint32_t> m_allocated;            // offset -> range
+    uint32_t m_freeHeads[FL_COUNT][SL_COUNT];
+    uint64_t m_flBitmap = 0;
+    uint32_t m_slBitmap[FL_COUNT] = {};
+
+    uint64_t m_capacity = 0;
+    uint64_t m_usedBytes = 0;
+    uint32_t m_freeRangeCount = 0;
+
+    static uint32_t highestBit(uint64_t value) {
+        uint32_t bit = 0;
+        while (value >>= 1) {
+            bit++;
+        }
+        return bit;
+    }
+
+    static uint32_t lowestBit(uint64_t value) {
+        uint32_t bit = 0;
+        while ((value & 1) == 0) {
+            value >>= 1;
+            bit++;
+        }
+        return bit;
+    }
+
+    // Size class a free range of this size is filed under
+    static void mapInsert(uint64_t size, uint32_t& fl, uint32_t& sl) {
+        if (size < SMALL_SIZE) {
+            fl = 0;
+            sl = static_cast<uint32_t>(size / (SMALL_SIZE / SL_COUNT));
+        } else {
+            uint32_t msb = highestBit(size);
+            fl = msb - SMALL_BITS + 1;
+            sl = static_cast<uint32_t>(size >> (msb - SL_BITS)) ^ SL_COUNT;
+        }
+    }
+
+    // First size class whose every range is guaranteed to hold `size` (round up to the next class)
+    static void mapSearch(uint64_t size, uint32_t& fl, uint32_t& sl) {
+        uint64_t round = size < SMALL_SIZE ? (SMALL_SIZE / SL_COUNT) - 1
+                                           : (1ull << (highestBit(size) - SL_BITS)) - 1;
+        if (size + round > size) {
+            size += round;
+        }
+        mapInsert(size, fl, sl);
+    }
+
+    uint32_t newRange() {
+        if (!m_unusedRanges.empty()) {
+            uint32_t index = m_unusedRanges.back();
+            m_unusedRanges.pop_back();
+            m_ranges[index] = Range();
+            return index;
+        }
+        m_ranges.emplace_back();
+        return static_cast<uint32_t>(m_ranges.size() - 1);
+    }
+
+    void insertFree(uint32_t index) {
+        Range& range = m_ranges[index];
+        uint32_t fl, sl;
+        mapInsert(range.size, fl, sl);
+
+        range.free = true;
+        range.prevFree = NONE;
+        range.nextFree = m_freeHeads[fl][sl];
+        if (range.nextFree != NONE) {
+            m_ranges[range.nextFree].prevFree = index;
+        }
+        m_freeHeads[fl][sl] = index;
+        m_flBitmap |= 1ull << fl;
+        m_slBitmap[fl] |= 1u << sl;
+        m_freeRangeCount++;
+    }
+
+    void removeFree(uint32_t index) {
+        Range& range = m_ranges[index];
+        uint32_t fl, sl;
+        mapInsert(range.size, fl, sl);
+
+        if (range.prevFree != NONE) {
+            m_ranges[range.prevFree].nextFree = range.nextFree;
+        } else {
+            m_freeHeads[fl][sl] = range.nextFree;
+        }
+        if (range.nextFree != NONE) {
+            m_ranges[range.nextFree].prevFree = range.prevFree;
+        }
+        if (m_freeHeads[fl][sl] == NONE) {
+            m_slBitmap[fl] &= ~(1u << sl);
+            if (m_slBitmap[fl] == 0) {
+                m_flBitmap &= ~(1ull << fl);
+            }
+        }
+        range.free = false;
+        m_freeRangeCount--;
+    }
+
+    // Smallest non-empty free list at or above (fl, sl)
+    uint32_t findFree(uint32_t fl, uint32_t sl) const {
+        if (fl >= FL_COUNT) {
+            return NONE;
+        }
+        uint32_t slMap = sl < SL_COUNT ? (m_slBitmap[fl] & (~0u << sl)) : 0;
+        if (slMap == 0) {
+            uint64_t flMap = (fl + 1 < 64) ? (m_flBitmap & (~0ull << (fl + 1))) : 0;
+            if (flMap == 0) {
+                return NONE;
+            }
+            fl = lowestBit(flMap);
+            slMap = m_slBitmap[fl];
+        }
+        return m_freeHeads[fl][lowestBit(slMap)];
+    }
+
+    // First free range in the classes from size's own up to (endFl, endSl) that holds `size` once
+    // its start is aligned. Ranges there are not guaranteed to fit, so each is checked; only used
+    // when the padded search found nothing, so a range that is already aligned is not wasted.
+    uint32_t findFreeAligned(uint64_t size, uint64_t alignment, uint32_t endFl, uint32_t endSl) const {
+        uint32_t fl, sl;
+        mapInsert(size, fl, sl);
+        while (fl < FL_COUNT && (fl < endFl || (fl == endFl && sl < endSl))) {
+            if (m_slBitmap[fl] & (1u << sl)) {
+                for (uint32_t index = m_freeHeads[fl][sl]; index != NONE; index = m_ranges[index].nextFree) {
+                    const Range& range = m_ranges[index];
+                    uint64_t aligned = (range.offset + alignment - 1) & ~(alignment - 1);
+                    if (aligned + size <= range.offset + range.size) {
+                        return index;
+                    }
+                }
+            }
+            if (++sl == SL_COUNT) {
+                sl = 0;
+                fl++;
+            }
+        }
+        return NONE;
+    }
+
+    // Split `size` bytes off the front of a range; the remainder becomes a new free range
+    void splitFront(uint32_t index, uint64_t size) {
+        uint32_t rest = newRange();
+        Range& range = m_ranges[index];   // Re-fetch: newRange() may reallocate
+        Range& tail = m_ranges[rest];
+        tail.offset = range.offset + size;
+        tail.size = range.size - size;
+        tail.prevPhysical = index;
+        tail.nextPhysical = range.nextPhysical;
+        if (range.nextPhysical != NONE) {
+            m_ranges[range.nextPhysical].prevPhysical = rest;
+        }
+        range.nextPhysical = rest;
+        range.size = size;
+        insertFree(rest);
+    }
+
+    // Absorb the physical successor of `index` (both must be free / removed from lists)
+    void mergeNext(uint32_t index) {
+        uint32_t next = m_ranges[index].nextPhysical;
+        Range& range = m_ranges[index];
+        range.size += m_ranges[next].size;
+        range.nextPhysical = m_ranges[next].nextPhysical;
+        if (range.nextPhysical != NONE) {
+            m_ranges[range.nextPhysical].prevPhysical = index;
+        }
+        m_unusedRanges.push_back(next);
+    }
+
+public:
+    explicit GpuBlockAllocator(uint64_t capacity) : m_capacity(capacity) {
+        for (uint32_t fl = 0; fl < FL_COUNT; fl++) {
+            for (uint32_t sl = 0; sl < SL_COUNT; sl++) {
+                m_freeHeads[fl][sl] = NONE;
+            }
+        }
+        if (capacity > 0) {
+            uint32_t index = newRange();
+            m_ranges[index].offset = 0;
+            m_ranges[index].size = capacity;
+            insertFree(index);
+        }
+    }
+
+    /**
+     * Allocate an aligned range
+     * @param alignment Must be a power of two (Vulkan guarantees this for memory requirements)
+     * @return Offset of the range, or INVALID_OFFSET if no free range is large enough
+     */
+    uint64_t allocate(uint64_t size, uint64_t alignment) {
+        if (size == 0 || size > m_capacity) {
+            return INVALID_OFFSET;
+        }
+        if (alignment == 0) {
+            alignment = 1;
+        }
+
+        // Any range in the searched class fits size plus worst-case alignment padding
+        uint64_t padded = size + alignment - 1;
+        uint32_t fl, sl;
+        mapSearch(padded, fl, sl);
+        uint32_t index = findFree(fl, sl);
+        if (index == NONE) {
+            index = findFreeAligned(size, alignment, fl, sl);
+        }
+        if (index == NONE) {
+            return INVALID_OFFSET;
+        }
+        removeFree(index);
+
+        uint64_t aligned = (m_ranges[index].offset + alignment - 1) & ~(alignment - 1);
+        uint64_t padding = aligned - m_ranges[index].offset;
+        if (padding > 0) {
+            // Leading padding stays free as its own range
+            splitFront(index, padding);
+            uint32_t padIndex = index;
+            index = m_ranges[padIndex].nextPhysical;
+            removeFree(index);
+            insertFree(padIndex);
+        }
+        if (m_ranges[index].size > size) {
+            splitFront(index, size);
+        }
+
+        m_ranges[index].free = false;
+        m_allocated[m_ranges[index].offset] = index;
+        m_usedBytes += m_ranges[index].size;
+        return m_ranges[index].offset;
+    }
+
+    /**
+     * Release a range returned by allocate(). Unknown offsets are ignored.
+     */
+    void free(uint64_t offset) {
+        auto it = m_allocated.find(offset);
+        if (it == m_allocated.end()) {
+            return;
+        }
+        uint32_t index = it->second;
+        m_allocated.erase(it);
+        m_usedBytes -= m_ranges[index].size;
+
+        uint32_t next = m_ranges[index].nextPhysical;
+        if (next != NONE && m_ranges[next].free) {
+            removeFree(next);
+            mergeNext(index);
+        }
+        uint32_t prev = m_ranges[index].prevPhysical;
+        if (prev != NONE && m_ranges[prev].free) {
+            removeFree(prev);
+            mergeNext(prev);
+            index = prev;
+        }
+        insertFree(index);
+    }
+
+    /**
+     * Size actually reserved for an allocation (0 if the offset is not allocated)
+     */
+    uint64_t getAllocationSize(uint64_t offset) const {
+        auto it = m_allocated.find(offset);
+        return it == m_allocated.end() ? 0 : m_ranges[it->second].size;
+    }
+
+    /**
+     * Largest single free range (what the next allocation can hope for)
+     */
+    uint64_t getLargestFree() const {
+        uint64_t largest = 0;
+        for (const Range& range : m_ranges) {
+            if (range.free && range.size > largest) {
+                largest = range.size;
+            }
+        }
+        return largest;
+    }
+
+    bool isEmpty() const { return m_allocated.empty(); }
+    uint64_t getCapacity() const { return m_capacity; }
+    uint64_t getUsedBytes() const { return m_usedBytes; }
+    uint64_t getFreeBytes() const { return m_capacity - m_usedBytes; }
+    size_t getAllocationCount() const { return m_allocated.size(); }
+    uint32_t getFreeRangeCount() const { return m_freeRangeCount; }
+};
+
+#endif // EDEN_GPU_BLOCK_ALLOCATOR_H
@@ -0,0 +1,646 @@
+// EDEN ENGINE - Image Decoder
+// Decodes PNG / JPEG / BMP straight to RGBA8 in caller-provided memory (e.g. mapped staging)
+// stb_image decodes in the file's native channel count; the RGB -> RGBA expansion (and optional
+// alpha premultiplication) is one SIMD pass into the destination, so no intermediate image is
+// made. ImageDecoder decodes batches on a thread pool whose workers allocate from reusable arenas.
+
+#ifndef EDEN_IMAGE_DECODER_H
+#define EDEN_IMAGE_DECODER_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <functional>
+#include <algorithm>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EDEN_DECODE_SSE2 1
+#include <emmintrin.h>
+#endif
+#if defined(__SSSE3__) || defined(__AVX__)
+#define EDEN_DECODE_SSSE3 1
+#include <tmmintrin.h>
+#endif
+
+/**
+ * DecodeArena - Bump allocator that stb_image allocates from on decoder threads
+ *
+ * Allocations are carved from one block and dropped together by reset(). Growing the most recent
+ * allocation (stb's zlib output buffer) happens in place. Requests that do not fit fall back to
+ * malloc, and the next reset() grows the block to what the image needed, so after the first few
+ * images a worker decodes without touching the heap.
+ */
+class DecodeArena {
+private:
+    static constexpr size_t HEADER_SIZE = 16;   // Holds the allocation size; keeps 16-byte alignment
+    static constexpr size_t NO_BLOCK = SIZE_MAX;
+
+    uint8_t* m_base = nullptr;
+    size_t m_capacity = 0;
+    size_t m_used = 0;
+    size_t m_lastOffset = NO_BLOCK;             // Header offset of the most recent allocation
+    size_t m_demand = 0;                        // Bytes this cycle would have needed
+    uint64_t m_overflows = 0;
+
+    static size_t roundUp(size_t size) { return (size + 15) & ~static_cast<size_t>(15); }
+
+    size_t sizeOf(const void* p) const {
+        size_t size;
+        memcpy(&size, static_cast<const uint8_t*>(p) - HEADER_SIZE, sizeof(size));
+        return size;
+    }
+
+public:
+    explicit DecodeArena(size_t capacity = 0) {
+        if (capacity > 0) {
+            m_base = static_cast<uint8_t*>(std::malloc(capacity));
+            m_capacity = m_base ? capacity : 0;
+        }
+    }
+
+    ~DecodeArena() {
+        std::free(m_base);
+    }
+
+    DecodeArena(const DecodeArena&) = delete;
+    DecodeArena& operator=(const DecodeArena&) = delete;
+
+    bool owns(const void* p) const {
+        return p >= m_base && p < m_base + m_capacity;
+    }
+
+    void* allocate(size_t size) {
+        size_t bytes = HEADER_SIZE + roundUp(size);
+        m_demand += bytes;
+        if (m_used + bytes > m_capacity) {
+            m_overflows++;
+            return std::malloc(size);
+        }
+        uint8_t* header = m_base + m_used;
+        memcpy(header, &size, sizeof(size));
+        m_lastOffset = m_used;
+        m_used += bytes;
+        return header + HEADER_SIZE;
+    }
+
+    void* reallocate(void* p, size_t newSize) {
+        if (!p) {
+            return allocate(newSize);
+        }
+        if (!owns(p)) {
+            m_demand += roundUp(newSize);
+            return std::realloc(p, newSize);
+        }
+
+        size_t oldSize = sizeOf(p);
+        size_t offset = static_cast<size_t>(static_cast<uint8_t*>(p) - m_base) - HEADER_SIZE;
+        if (offset == m_lastOffset && offset + HEADER_SIZE + roundUp(newSize) <= m_capacity) {
+            m_demand += roundUp(newSize) > roundUp(oldSize) ? roundUp(newSize) - roundUp(oldSize) : 0;
+            memcpy(m_base + offset, &newSize, sizeof(newSize));
+            m_used = offset + HEADER_SIZE + roundUp(newSize);
+            return p;
+        }
+
+        void* moved = allocate(newSize);
+        if (moved) {
+            memcpy(moved, p, std::min(oldSize, newSize));
+            release(p);
+        }
+        return moved;
+    }
+
+    void release(void* p) {
+        if (!p) {
+            return;
+        }
+        if (!owns(p)) {
+            std::free(p);
+            return;
+        }
+        // Only the most recent allocation is given back early; the rest waits for reset()
+        size_t offset = static_cast<size_t>(static_cast<uint8_t*>(p) - m_base) - HEADER_SIZE;
+        if (offset == m_lastOffset) {
+            m_used = offset;
+            m_lastOffset = NO_BLOCK;
+        }
+    }
+
+    /**
+     * Drop every allocation (all must have been released) and grow if this cycle overflowed
+     */
+    void reset() {
+        if (m_demand > m_capacity) {
+            size_t capacity = m_demand + m_demand / 4;
+            uint8_t* base = static_cast<uint8_t*>(std::malloc(capacity));
+            if (base) {
+                std::free(m_base);
+                m_base = base;
+                m_capacity = capacity;
+            }
+        }
+        m_used = 0;
+        m_lastOffset = NO_BLOCK;
+        m_demand = 0;
+    }
+
+    size_t getCapacity() const { return m_capacity; }
+    uint64_t getOverflowCount() const { return m_overflows; }
+};
+
+// Arena stb_image allocates from on this thread (null = the heap)
+inline DecodeArena*& decode_arena_for_thread() {
+    thread_local DecodeArena* arena = nullptr;
+    return arena;
+}
+
+inline void* eden_stbi_malloc(size_t size) {
+    DecodeArena* arena = decode_arena_for_thread();
+    return arena ? arena->allocate(size) : std::malloc(size);
+}
+
+inline void* eden_stbi_realloc(void* p, size_t size) {
+    DecodeArena* arena = decode_arena_for_thread();
+    return arena ? arena->reallocate(p, size) : std::realloc(p, size);
+}
+
+inline void eden_stbi_free(void* p) {
+    DecodeArena* arena = decode_arena_for_thread();
+    if (arena) {
+        arena->release(p);
+    } else {
+        std::free(p);
+    }
+}
+
+// stb_image configuration (single-header library)
+// Always include the header for declarations and constants
+// STB_IMAGE_IMPLEMENTATION should be defined in exactly ONE .cpp file before including this header
+// The header itself is safe to include multiple times - only the implementation is defined once
+#ifndef STBI_MALLOC
+#define STBI_MALLOC(size) eden_stbi_malloc(size)
+#define STBI_REALLOC(p, size) eden_stbi_realloc(p, size)
+#define STBI_FREE(p) eden_stbi_free(p)
+#endif
+#define STBI_ONLY_PNG
+#define STBI_ONLY_JPEG
+#define STBI_ONLY_BMP
+#define STBI_NO_LINEAR  // No HDR support needed for 8-bit source textures
+#include "../stdlib/stb_image.h"
+
+// ---- Pixel conversion ----------------------------------------------------------
+
+// c * a / 255, rounded (exact for all 8-bit inputs)
+static inline uint8_t decodeMulDiv255(uint32_t c, uint32_t a) {
+    uint32_t t = c * a + 128;
+    return static_cast<uint8_t>((t + (t >> 8)) >> 8);
+}
+
+#ifdef EDEN_DECODE_SSE2
+// Premultiply 4 RGBA pixels: color * alpha / 255, alpha unchanged
+static inline __m128i decodePremultiply4(__m128i rgba) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bias = _mm_set1_epi16(128);
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+
+    __m128i lo = _mm_unpacklo_epi8(rgba, zero);
+    __m128i hi = _mm_unpackhi_epi8(rgba, zero);
+    __m128i alphaLo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    __m128i alphaHi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    lo = _mm_add_epi16(_mm_mullo_epi16(lo, alphaLo), bias);
+    hi = _mm_add_epi16(_mm_mullo_epi16(hi, alphaHi), bias);
+    lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+    hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+
+    __m128i color = _mm_packus_epi16(lo, hi);
+    return _mm_or_si128(_mm_andnot_si128(alphaMask, color), _mm_and_si128(alphaMask, rgba));
+}
+#endif
+
+/**
+ * Expand `pixelCount` pixels of 1-4 channel 8-bit data (gray, gray+alpha, RGB, RGBA) to RGBA8.
+ * Gray is replicated to RGB and missing alpha becomes 255. With `premultiply`, color is scaled
+ * by alpha (on the stored, possibly sRGB-encoded, values). `src` and `dst` must not overlap.
+ * Assumes a little-endian host (every platform the engine targets).
+ */
+inline void convert_to_rgba8(const uint8_t* src, uint32_t channels, uint8_t* dst, size_t pixelCount,
+                             bool premultiply = false) {
+    size_t i = 0;
+    const uint32_t OPAQUE = 0xFF000000u;
+
+    if (channels == 3) {
+#ifdef EDEN_DECODE_SSSE3
+        // 16 pixels per iteration: 48 source bytes -> 4 vectors, each shuffled into RGBA with alpha set
+        const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+        const __m128i alpha = _mm_set1_epi32(static_cast<int>(OPAQUE));
+        for (; i + 16 <= pixelCount; i += 16) {
+            const uint8_t* s = src + i * 3;
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 16));
+            __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 32));
+            __m128i out[4] = {
+                _mm_or_si128(_mm_shuffle_epi8(a, shuffle), alpha),
+                _mm_or_si128(_mm_shuffle_epi8(_mm_alignr_epi8(b, a, 12), shuffle), alpha),
+                _mm_or_si128(_mm_shuffle_epi8(_mm_alignr_epi8(c, b, 8), shuffle), alpha),
+                _mm_or_si128(_mm_shuffle_epi8(_mm_srli_si128(c, 4), shuffle), alpha),
+            };
+            for (int k = 0; k < 4; k++) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4 + k * 16), out[k]);
+            }
+        }
+#else
+        // 4 pixels per iteration from three 32-bit words (SWAR)
+        for (; i + 4 <= pixelCount; i += 4) {
+            uint32_t w[3];
+            memcpy(w, src + i * 3, 12);
+            uint32_t out[4] = {
+                (w[0] & 0xFFFFFF) | OPAQUE,
+                (((w[0] >> 24) | (w[1] << 8)) & 0xFFFFFF) | OPAQUE,
+                (((w[1] >> 16) | (w[2] << 16)) & 0xFFFFFF) | OPAQUE,
+                (w[2] >> 8) | OPAQUE,
+            };
+            memcpy(dst + i * 4, out, 16);
+        }
+#endif
+        for (; i < pixelCount; i++) {
+            dst[i * 4 + 0] = src[i * 3 + 0];
+            dst[i * 4 + 1] = src[i * 3 + 1];
+            dst[i * 4 + 2] = src[i * 3 + 2];
+            dst[i * 4 + 3] = 255;
+        }
+        return;     // Opaque: premultiplying would not change anything
+    }
+
+    if (channels == 1) {
+#ifdef EDEN_DECODE_SSE2
+        const __m128i alpha = _mm_set1_epi32(static_cast<int>(OPAQUE));
+        for (; i + 16 <= pixelCount; i += 16) {
+            __m128i g = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            __m128i gg0 = _mm_unpacklo_epi8(g, g);
+            __m128i gg1 = _mm_unpackhi_epi8(g, g);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_or_si128(_mm_unpacklo_epi16(gg0, gg0), alpha));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4 + 16), _mm_or_si128(_mm_unpackhi_epi16(gg0, gg0), alpha));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4 + 32), _mm_or_si128(_mm_unpacklo_epi16(gg1, gg1), alpha));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4 + 48), _mm_or_si128(_mm_unpackhi_epi16(gg1, gg1), alpha));
+        }
+#endif
+        for (; i < pixelCount; i++) {
+            uint32_t g = src[i];
+            uint32_t out = g | (g << 8) | (g << 16) | OPAQUE;
+            memcpy(dst + i * 4, &out, 4);
+        }
+        return;
+    }
+
+    if (channels == 2) {
+#ifdef EDEN_DECODE_SSE2
+        // Gray+alpha pairs as 32-bit lanes (g | a << 8) -> g | g << 8 | g << 16 | a << 24
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i grayMask = _mm_set1_epi32(0xFF);
+        for (; i + 8 <= pixelCount; i += 8) {
+            __m128i ga = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+            __m128i halves[2] = {_mm_unpacklo_epi16(ga, zero), _mm_unpackhi_epi16(ga, zero)};
+            for (int k = 0; k < 2; k++) {
+                __m128i g = _mm_and_si128(halves[k], grayMask);
+                __m128i out = _mm_or_si128(_mm_or_si128(g, _mm_slli_epi32(g, 8)), _mm_slli_epi32(halves[k], 16));
+                if (premultiply) {
+                    out = decodePremultiply4(out);
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4 + k * 16), out);
+            }
+        }
+#endif
+        for (; i < pixelCount; i++) {
+            uint32_t g = src[i * 2];
+            uint32_t a = src[i * 2 + 1];
+            if (premultiply) {
+                g = decodeMulDiv255(g, a);
+            }
+            uint32_t out = g | (g << 8) | (g << 16) | (a << 24);
+            memcpy(dst + i * 4, &out, 4);
+        }
+        return;
+    }
+
+    // RGBA: a copy, fused with premultiplication when asked
+    if (!premultiply) {
+        memcpy(dst, src, pixelCount * 4);
+        return;
+    }
+#ifdef EDEN_DECODE_SSE2
+    for (; i + 4 <= pixelCount; i += 4) {
+        __m128i rgba = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), decodePremultiply4(rgba));
+    }
+#endif
+    for (; i < pixelCount; i++) {
+        uint32_t a = src[i * 4 + 3];
+        dst[i * 4 + 0] = decodeMulDiv255(src[i * 4 + 0], a);
+        dst[i * 4 + 1] = decodeMulDiv255(src[i * 4 + 1], a);
+        dst[i * 4 + 2] = decodeMulDiv255(src[i * 4 + 2], a);
+        dst[i * 4 + 3] = static_cast<uint8_t>(a);
+    }
+}
+
+// ---- Decoding -------------------------------------------------------------------
+
+struct ImageInfo {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t channels = 0;      // As stored in the file (1-4); decoded output is always RGBA8
+
+    size_t rgba8Size() const { return static_cast<size_t>(width) * height * 4; }
+};
+
+/**
+ * Read the size and channel count of an encoded image without decoding it
+ * @return false if the data is not a supported PNG / JPEG / BMP
+ */
+inline bool read_image_info(const uint8_t* data, size_t size, ImageInfo& info) {
+    int width, height, channels;
+    if (!stbi_info_from_memory(data, static_cast<int>(size), &width, &height, &channels)) {
+        return false;
+    }
+    info.width = static_cast<uint32_t>(width);
+    info.height = static_cast<uint32_t>(height);
+    info.channels = static_cast<uint32_t>(channels);
+    return true;
+}
+
+/**
+ * Decode an image to RGBA8 (tightly packed rows) at `dst`, which must hold info.rgba8Size() bytes
+ * @param info As returned by read_image_info for the same data
+ * @throws std::runtime_error if decoding fails
+ */
+inline void decode_image_into(const uint8_t* data, size_t size, const ImageInfo& info, uint8_t* dst,
+                              bool premultiply = false) {
+    int width, height, channels;
+    stbi_uc* decoded = stbi_load_from_memory(data, static_cast<int>(size), &width, &height, &channels, 0);
+    if (!decoded) {
+        throw std::runtime_error(std::string("Image decode failed - ") + stbi_failure_reason());
+    }
+    if (static_cast<uint32_t>(width) != info.width || static_cast<uint32_t>(height) != info.height ||
+        static_cast<uint32_t>(channels) != info.channels) {
+        stbi_image_free(decoded);
+        throw std::runtime_error("Image decode produced a different size than its header");
+    }
+    convert_to_rgba8(decoded, info.channels, dst, static_cast<size_t>(width) * height, premultiply);
+    stbi_image_free(decoded);
+}
+
+// Read a whole file into `buffer` (reusing its capacity)
+static bool decodeReadFile(const std::string& path, std::vector<uint8_t>& buffer) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+    setvbuf(file, nullptr, _IONBF, 0);     // Whole-file reads: stdio buffering would only add a copy
+    bool ok = fseek(file, 0, SEEK_END) == 0;
+    long size = ok ? ftell(file) : -1;
+    ok = size >= 0 && fseek(file, 0, SEEK_SET) == 0;
+    if (ok) {
+        buffer.resize(static_cast<size_t>(size));
+        ok = fread(buffer.data(), 1, buffer.size(), file) == buffer.size();
+    }
+    fclose(file);
+    return ok;
+}
+
+/**
+ * Load an image file as RGBA8
+ * @throws std::runtime_error if the file cannot be read or decoded
+ */
+inline std::vector<uint8_t> load_image_rgba8(const std::string& path, ImageInfo& info, bool premultiply = false) {
+    std::vector<uint8_t> file;
+    if (!decodeReadFile(path, file)) {
+        throw std::runtime_error("Failed to read image: " + path);
+    }
+    if (!read_image_info(file.data(), file.size(), info)) {
+        throw std::runtime_error("Failed to load image: " + path + " - " + stbi_failure_reason());
+    }
+    std::vector<uint8_t> pixels(info.rgba8Size());
+    decode_image_into(file.data(), file.size(), info, pixels.data(), premultiply);
+    return pixels;
+}
+
+/**
+ * One image for ImageDecoder::decode
+ */
+struct ImageDecodeJob {
+    // Input: encoded bytes in memory (data/size), or a file path when data is null
+    std::string path;
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    bool premultiply = false;
+
+    // Called on a worker once the image size is known; returns where its info.rgba8Size() bytes
+    // of RGBA8 go (e.g. a slice of mapped staging memory). Must be thread-safe. nullptr skips it.
+    std::function<uint8_t*(const ImageInfo&)> destination;
+
+    // Output
+    ImageInfo info;
+    uint8_t* pixels = nullptr;  // What destination returned
+    bool ok = false;
+    std::string error;
+};
+
+/**
+ * ImageDecoder - Thread pool that decodes batches of images into caller memory
+ *
+ * Each worker owns a DecodeArena for stb_image's working memory and a reusable file buffer, so
+ * steady-state decoding does not allocate. The calling thread works on the batch too.
+ *
+ * Usage:
+ *   std::vector<ImageDecodeJob> jobs(paths.size());
+ *   for (size_t i = 0; i < paths.size(); i++) {
+ *       jobs[i].path = paths[i];
+ *       jobs[i].destination = [&](const ImageInfo& info) { return staging.allocate(info.rgba8Size()); };
+ *   }
+ *   ImageDecoder::get_instance().decode(jobs);   // Blocks; check jobs[i].ok
+ */
+class ImageDecoder {
+public:
+    struct Stats {
+        uint64_t images = 0;
+        uint64_t failures = 0;
+        uint64_t decodedBytes = 0;      // RGBA8 bytes written
+        uint64_t arenaOverflows = 0;    // stb allocations that fell back to the heap (warm-up)
+    };
+
+private:
+    struct Worker {
+        DecodeArena arena;
+        std::vector<uint8_t> fileBuffer;
+        uint64_t images = 0;
+        uint64_t failures = 0;
+        uint64_t decodedBytes = 0;
+    };
+
+    std::vector<std::unique_ptr<Worker>> m_workers;    // [0] = the calling thread
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_batchMutex;                            // One decode() at a time
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    ImageDecodeJob* m_jobs = nullptr;
+    size_t m_jobCount = 0;
+    std::atomic<size_t> m_nextJob{0};
+    uint64_t m_batch = 0;
+    uint32_t m_busyThreads = 0;
+    bool m_stop = false;
+
+    void decodeJob(ImageDecodeJob& job, Worker& worker) {
+        job.ok = false;
+        job.pixels = nullptr;
+        try {
+            const uint8_t* data = job.data;
+            size_t size = job.size;
+            if (!data) {
+                if (!decodeReadFile(job.path, worker.fileBuffer)) {
+                    throw std::runtime_error("Failed to read image: " + job.path);
+                }
+                data = worker.fileBuffer.data();
+                size = worker.fileBuffer.size();
+            }
+            if (!read_image_info(data, size, job.info)) {
+                throw std::runtime_error("Unsupported image: " + job.path + " - " + stbi_failure_reason());
+            }
+            job.pixels = job.destination ? job.destination(job.info) : nullptr;
+            if (!job.pixels) {
+                throw std::runtime_error("No destination for image: " + job.path);
+            }
+            decode_image_into(data, size, job.info, job.pixels, job.premultiply);
+            job.ok = true;
+            worker.images++;
+            worker.decodedBytes += job.info.rgba8Size();
+        } catch (const std::exception& e) {
+            job.error = e.what();
+            worker.failures++;
+        }
+        worker.arena.reset();
+    }
+
+    void runJobs(Worker& worker) {
+        DecodeArena*& arena = decode_arena_for_thread();
+        arena = &worker.arena;
+        for (size_t i = m_nextJob.fetch_add(1); i < m_jobCount; i = m_nextJob.fetch_add(1)) {
+            decodeJob(m_jobs[i], worker);
+        }
+        arena = nullptr;
+    }
+
+    void workerLoop(Worker* worker) {
+        uint64_t seenBatch = 0;
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            m_wake.wait(lock, [&] { return m_stop || m_batch != seenBatch; });
+            if (m_stop) {
+                return;
+            }
+            seenBatch = m_batch;
+            lock.unlock();
+            runJobs(*worker);
+            lock.lock();
+            if (--m_busyThreads == 0) {
+                m_done.notify_one();
+            }
+        }
+    }
+
+public:
+    /**
+     * @param threadCount Threads decoding a batch, including the caller (0 = hardware concurrency)
+     */
+    explicit ImageDecoder(uint32_t threadCount = 0) {
+        if (threadCount == 0) {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+        for (uint32_t i = 0; i < threadCount; i++) {
+            m_workers.push_back(std::unique_ptr<Worker>(new Worker()));
+        }
+        for (uint32_t i = 1; i < threadCount; i++) {
+            m_threads.emplace_back(&ImageDecoder::workerLoop, this, m_workers[i].get());
+        }
+    }
+
+    ~ImageDecoder() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for (std::thread& thread : m_threads) {
+            thread.join();
+        }
+    }
+
+    ImageDecoder(const ImageDecoder&) = delete;
+    ImageDecoder& operator=(const ImageDecoder&) = delete;
+
+    /**
+     * Get the process-wide decoder (hardware concurrency threads).
+     * Intentionally never destroyed; its workers sleep until a batch arrives.
+     */
+    static ImageDecoder& get_instance() {
+        static ImageDecoder* instance = new ImageDecoder();
+        return *instance;
+    }
+
+    /**
+     * Decode every job, spreading them over the pool. Blocks until all are done.
+     * Failures are reported per job (ok / error); this never throws for a bad image.
+     */
+    void decode(ImageDecodeJob* jobs, size_t count) {
+        if (count == 0) {
+            return;
+        }
+        std::lock_guard<std::mutex> batchLock(m_batchMutex);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_jobs = jobs;
+            m_jobCount = count;
+            m_nextJob = 0;
+            m_busyThreads = static_cast<uint32_t>(m_threads.size());
+            m_batch++;
+        }
+        m_wake.notify_all();
+
+        runJobs(*m_workers[0]);
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [&] { return m_busyThreads == 0; });
+        m_jobs = nullptr;
+        m_jobCount = 0;
+    }
+
+    void decode(std::vector<ImageDecodeJob>& jobs) {
+        decode(jobs.data(), jobs.size());
+    }
+
+    uint32_t getThreadCount() const { return static_cast<uint32_t>(m_workers.size()); }
+
+    /**
+     * Totals over every batch (call between batches)
+     */
+    Stats getStats() const {
+        Stats stats;
+        for (const std::unique_ptr<Worker>& worker : m_workers) {
+            stats.images += worker->images;
+            stats.failures += worker->failures;
+            stats.decodedBytes += worker->decodedBytes;
+            stats.arenaOverflows += worker->arena.getOverflowCount();
+        }
+        return stats;
+    }
+};
+
+#endif // EDEN_IMAGE_DECODER_H
@@ -0,0 +1,121 @@
+// EDEN ENGINE - Instance Batch
+// CPU stage that turns per-object transforms into GPU instance records, so every object sharing a
+// mesh is drawn with a single instanced draw. No Vulkan types: the output is plain memory that is
+// copied into a per-instance vertex buffer (VK_VERTEX_INPUT_RATE_INSTANCE).
+
+#ifndef EDEN_INSTANCE_BATCH_H
+#define EDEN_INSTANCE_BATCH_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * InstanceTransform - Compact per-object description (translation, yaw about +Y, per-axis scale,
+ * flat color)
+ */
+struct InstanceTransform {
+    float position[3] = {0.0f, 0.0f, 0.0f};
+    float yawDegrees = 0.0f;
+    float scale[3] = {1.0f, 1.0f, 1.0f};
+    float color[3] = {1.0f, 1.0f, 1.0f};
+};
+
+/**
+ * MeshInstance - One record of the per-instance vertex buffer (80 bytes)
+ *
+ * model is column-major (same layout as glm::mat4), fed to the vertex shader as four vec4
+ * attributes; color.a is unused padding that keeps the stride a multiple of 16.
+ */
+struct MeshInstance {
+    float model[16];
+    float color[4];
+};
+
+static_assert(sizeof(MeshInstance) == 80, "MeshInstance must match the instance vertex layout");
+
+/**
+ * Build the instance record for one transform: model = translate * rotateY(yaw) * scale
+ */
+inline void build_mesh_instance(const InstanceTransform& transform, MeshInstance& out) {
+    float yawRad = transform.yawDegrees * (3.14159265358979f / 180.0f);
+    float c = transform.yawDegrees != 0.0f ? std::cos(yawRad) : 1.0f;
+    float s = transform.yawDegrees != 0.0f ? std::sin(yawRad) : 0.0f;
+    float sx = transform.scale[0];
+    float sy = transform.scale[1];
+    float sz = transform.scale[2];
+
+    // Column 0: rotated X axis * sx
+    out.model[0] = c * sx;
+    out.model[1] = 0.0f;
+    out.model[2] = -s * sx;
+    out.model[3] = 0.0f;
+    // Column 1: Y axis * sy
+    out.model[4] = 0.0f;
+    out.model[5] = sy;
+    out.model[6] = 0.0f;
+    out.model[7] = 0.0f;
+    // Column 2: rotated Z axis * sz
+    out.model[8] = s * sz;
+    out.model[9] = 0.0f;
+    out.model[10] = c * sz;
+    out.model[11] = 0.0f;
+    // Column 3: translation
+    out.model[12] = transform.position[0];
+    out.model[13] = transform.position[1];
+    out.model[14] = transform.position[2];
+    out.model[15] = 1.0f;
+
+    out.color[0] = transform.color[0];
+    out.color[1] = transform.color[1];
+    out.color[2] = transform.color[2];
+    out.color[3] = 1.0f;
+}
+
+/**
+ * Build instance records for a batch of transforms
+ * @param out Destination with room for count records (e.g. a mapped instance buffer)
+ * @return Number of records written
+ */
+inline size_t build_mesh_instances(const InstanceTransform* transforms, size_t count, MeshInstance* out) {
+    for (size_t i = 0; i < count; i++) {
+        build_mesh_instance(transforms[i], out[i]);
+    }
+    return count;
+}
+
+/**
+ * InstanceBatch - Growable list of transforms for one mesh, rebuilt into instance records each frame
+ *
+ * Usage:
+ *   InstanceBatch batch;
+ *   batch.clear();
+ *   for (...) batch.add(transform);
+ *   size_t count = batch.build(mappedInstanceBuffer, capacity);
+ *   vkCmdDrawIndexed(cmd, indexCount, (uint32_t)count, 0, 0, 0);
+ */
+class InstanceBatch {
+private:
+    std::vector<InstanceTransform> m_transforms;
+
+public:
+    void clear() { m_transforms.clear(); }
+    void reserve(size_t count) { m_transforms.reserve(count); }
+    void add(const InstanceTransform& transform) { m_transforms.push_back(transform); }
+
+    /**
+     * Write instance records for the first min(size, capacity) transforms
+     * @return Number of records written (the instanceCount for the draw)
+     */
+    size_t build(MeshInstance* out, size_t capacity) const {
+        size_t count = m_transforms.size() < capacity ? m_transforms.size() : capacity;
+        return build_mesh_instances(m_transforms.data(), count, out);
+    }
+
+    size_t size() const { return m_transforms.size(); }
+    bool empty() const { return m_transforms.empty(); }
+    const std::vector<InstanceTransform>& getTransforms() const { return m_transforms; }
+};
+
+#endif // EDEN_INSTANCE_BATCH_H
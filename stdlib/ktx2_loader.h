@@ -0,0 +1,246 @@
+// EDEN ENGINE - KTX2 Texture Loader
+// GPU-ready texture container (Khronos KTX 2.0) with optional per-level zstd supercompression
+// The level index lets mips be read individually, smallest first, so a texture can become usable
+// before its full-resolution levels have been read. Parsing is Vulkan-independent (vkFormat is kept as a raw value).
+
+#ifndef EDEN_KTX2_LOADER_H
+#define EDEN_KTX2_LOADER_H
+
+#include "zstd_decoder.h"
+#include <vector>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+static const uint8_t KTX2_IDENTIFIER[12] = {0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+static const size_t KTX2_HEADER_SIZE = 80;          // Identifier + header + index, before the level index
+static const size_t KTX2_LEVEL_INDEX_ENTRY_SIZE = 24;
+static const uint32_t KTX2_MAX_LEVELS = 32;
+
+// Supercompression schemes (KTX2 supercompressionScheme)
+#define KTX2_SUPERCOMPRESSION_NONE 0
+#define KTX2_SUPERCOMPRESSION_BASISLZ 1
+#define KTX2_SUPERCOMPRESSION_ZSTD 2
+#define KTX2_SUPERCOMPRESSION_ZLIB 3
+
+// One mip level as stored in the file (level 0 = full resolution)
+struct KTX2Level {
+    uint64_t byteOffset;                // From the start of the file
+    uint64_t byteLength;                // Stored (possibly supercompressed) size
+    uint64_t uncompressedByteLength;    // Size once decompressed: all layers and faces of the level
+    uint32_t width;
+    uint32_t height;
+};
+
+// Parsed KTX2 header and level index
+struct KTX2Info {
+    uint32_t vkFormat;                  // VkFormat value (0 = VK_FORMAT_UNDEFINED, e.g. Basis Universal)
+    uint32_t typeSize;
+    uint32_t width;
+    uint32_t height;
+    uint32_t depth;
+    uint32_t layerCount;                // 0 in the file means "not an array"; stored here as 1
+    uint32_t faceCount;                 // 6 for cubemaps
+    uint32_t levelCount;                // 0 in the file means "generate mips"; stored here as 1
+    uint32_t supercompressionScheme;
+    std::vector<KTX2Level> levels;
+};
+
+static uint32_t ktx2ReadU32(const uint8_t* p) {
+    uint32_t value;
+    memcpy(&value, p, 4);
+    return value;
+}
+
+static uint64_t ktx2ReadU64(const uint8_t* p) {
+    uint64_t value;
+    memcpy(&value, p, 8);
+    return value;
+}
+
+/**
+ * Bytes needed to parse the header and level index (call with at least KTX2_HEADER_SIZE bytes)
+ */
+inline size_t ktx2_header_bytes(const uint8_t* data, size_t size) {
+    if (size < KTX2_HEADER_SIZE || memcmp(data, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) != 0) {
+        return KTX2_HEADER_SIZE;     // Not KTX2: parse_ktx2_header reports it
+    }
+    uint32_t levelCount = std::min(ktx2ReadU32(data + 40), KTX2_MAX_LEVELS);
+    return KTX2_HEADER_SIZE + (levelCount == 0 ? 1 : levelCount) * KTX2_LEVEL_INDEX_ENTRY_SIZE;
+}
+
+/**
+ * Parse the KTX2 header and level index
+ * @param fileSize Total file size, used to validate level ranges (0 = skip the check)
+ * @throws std::runtime_error if the data is not a supported KTX2 file
+ */
+inline KTX2Info parse_ktx2_header(const uint8_t* data, size_t size, uint64_t fileSize = 0) {
+    if (size < KTX2_HEADER_SIZE || memcmp(data, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) != 0) {
+        throw std::runtime_error("Not a KTX2 file (bad identifier)");
+    }
+    if (ktx2ReadU32(data + 40) > KTX2_MAX_LEVELS) {
+        throw std::runtime_error("KTX2 level count out of range");
+    }
+    if (size < ktx2_header_bytes(data, size)) {
+        throw std::runtime_error("KTX2 level index is truncated");
+    }
+
+    KTX2Info info = {};
+    info.vkFormat = ktx2ReadU32(data + 12);
+    info.typeSize = ktx2ReadU32(data + 16);
+    info.width = ktx2ReadU32(data + 20);
+    info.height = ktx2ReadU32(data + 24);
+    info.depth = ktx2ReadU32(data + 28);
+    info.layerCount = std::max(1u, ktx2ReadU32(data + 32));
+    info.faceCount = ktx2ReadU32(data + 36);
+    info.levelCount = std::max(1u, ktx2ReadU32(data + 40));
+    info.supercompressionScheme = ktx2ReadU32(data + 44);
+
+    if (info.vkFormat == 0) {
+        throw std::runtime_error("KTX2 with VK_FORMAT_UNDEFINED (Basis Universal) is not supported");
+    }
+    if (info.supercompressionScheme != KTX2_SUPERCOMPRESSION_NONE &&
+        info.supercompressionScheme != KTX2_SUPERCOMPRESSION_ZSTD) {
+        throw std::runtime_error("Unsupported KTX2 supercompression scheme " +
+                                 std::to_string(info.supercompressionScheme) + " (only none and zstd)");
+    }
+    if (info.width == 0 || info.depth > 1 || (info.faceCount != 1 && info.faceCount != 6)) {
+        throw std::runtime_error("Unsupported KTX2 dimensions (1D/3D textures are not supported)");
+    }
+    if (info.height == 0) {
+        info.height = 1;
+    }
+
+    info.levels.resize(info.levelCount);
+    for (uint32_t level = 0; level < info.levelCount; level++) {
+        const uint8_t* entry = data + KTX2_HEADER_SIZE + level * KTX2_LEVEL_INDEX_ENTRY_SIZE;
+        KTX2Level& out = info.levels[level];
+        out.byteOffset = ktx2ReadU64(entry);
+        out.byteLength = ktx2ReadU64(entry + 8);
+        out.uncompressedByteLength = ktx2ReadU64(entry + 16);
+        out.width = std::max(1u, info.width >> level);
+        out.height = std::max(1u, info.height >> level);
+
+        if (fileSize != 0 && (out.byteOffset > fileSize || out.byteLength > fileSize - out.byteOffset)) {
+            throw std::runtime_error("KTX2 level " + std::to_string(level) + " lies outside the file");
+        }
+        if (info.supercompressionScheme == KTX2_SUPERCOMPRESSION_NONE && out.byteLength != out.uncompressedByteLength) {
+            throw std::runtime_error("KTX2 level " + std::to_string(level) + " has inconsistent sizes");
+        }
+    }
+    return info;
+}
+
+/**
+ * Turn one level's stored bytes into GPU-ready data (zstd-decompressed if supercompressed)
+ * @throws std::runtime_error if decompression fails or the size does not match the level index
+ */
+inline std::vector<uint8_t> decode_ktx2_level(const KTX2Info& info, uint32_t level, const uint8_t* data, size_t size) {
+    const KTX2Level& entry = info.levels.at(level);
+    std::vector<uint8_t> result;
+    if (info.supercompressionScheme == KTX2_SUPERCOMPRESSION_ZSTD) {
+        result = zstd_decompress(data, size, static_cast<size_t>(entry.uncompressedByteLength));
+    } else {
+        result.assign(data, data + size);
+    }
+    if (result.size() != entry.uncompressedByteLength) {
+        throw std::runtime_error("KTX2 level " + std::to_string(level) + " decoded to " +
+                                 std::to_string(result.size()) + " bytes, expected " +
+                                 std::to_string(entry.uncompressedByteLength));
+    }
+    return result;
+}
+
+/**
+ * KTX2Reader - Keeps a KTX2 file open and reads individual mip levels on demand
+ *
+ * Only the header and level index are read on open. Levels are fetched with readLevel(), so a
+ * caller can take the small tail first and come back for the large levels later.
+ *
+ * Usage:
+ *   KTX2Reader reader("textures/rock.ktx2");
+ *   std::vector<uint64_t> offsets;
+ *   std::vector<uint8_t> tail = reader.readMipChain(4, &offsets);   // Levels 4..N-1, usable at once
+ *   std::vector<uint8_t> full = reader.readLevel(0);                // Full resolution, later
+ */
+class KTX2Reader {
+private:
+    std::string m_path;
+    std::ifstream m_file;
+    uint64_t m_fileSize = 0;
+    KTX2Info m_info;
+
+public:
+    /**
+     * Open a file and parse its header and level index
+     * @throws std::runtime_error if the file cannot be opened or is not a supported KTX2
+     */
+    explicit KTX2Reader(const std::string& path) : m_path(path) {
+        m_file.open(path, std::ios::binary | std::ios::ate);
+        if (!m_file.is_open()) {
+            throw std::runtime_error("Failed to open KTX2 file: " + path);
+        }
+        m_fileSize = static_cast<uint64_t>(m_file.tellg());
+        m_file.seekg(0, std::ios::beg);
+
+        std::vector<uint8_t> header(KTX2_HEADER_SIZE);
+        if (!m_file.read(reinterpret_cast<char*>(header.data()), header.size())) {
+            throw std::runtime_error("KTX2 file too small: " + path);
+        }
+        size_t needed = ktx2_header_bytes(header.data(), header.size());
+        header.resize(needed);
+        if (!m_file.read(reinterpret_cast<char*>(header.data() + KTX2_HEADER_SIZE), needed - KTX2_HEADER_SIZE)) {
+            throw std::runtime_error("KTX2 level index is truncated: " + path);
+        }
+        m_info = parse_ktx2_header(header.data(), header.size(), m_fileSize);
+    }
+
+    const KTX2Info& getInfo() const { return m_info; }
+    const std::string& getPath() const { return m_path; }
+
+    /**
+     * Read and decompress one mip level (all layers/faces of it)
+     */
+    std::vector<uint8_t> readLevel(uint32_t level) {
+        const KTX2Level& entry = m_info.levels.at(level);
+        std::vector<uint8_t> stored(static_cast<size_t>(entry.byteLength));
+        m_file.clear();
+        m_file.seekg(static_cast<std::streamoff>(entry.byteOffset), std::ios::beg);
+        if (!m_file.read(reinterpret_cast<char*>(stored.data()), stored.size())) {
+            throw std::runtime_error("Failed to read KTX2 level " + std::to_string(level) + " from " + m_path);
+        }
+        return decode_ktx2_level(m_info, level, stored.data(), stored.size());
+    }
+
+    /**
+     * Read levels [firstLevel, levelCount) smallest first and return them packed largest first
+     * (the DDS layout: firstLevel at offset 0)
+     * @param levelOffsets Optional: receives each level's offset in the result, index 0 = firstLevel
+     */
+    std::vector<uint8_t> readMipChain(uint32_t firstLevel, std::vector<uint64_t>* levelOffsets = nullptr) {
+        if (firstLevel >= m_info.levelCount) {
+            throw std::runtime_error("KTX2 first level out of range: " + m_path);
+        }
+        std::vector<uint64_t> offsets(m_info.levelCount - firstLevel);
+        uint64_t total = 0;
+        for (uint32_t level = firstLevel; level < m_info.levelCount; level++) {
+            offsets[level - firstLevel] = total;
+            total += m_info.levels[level].uncompressedByteLength;
+        }
+
+        std::vector<uint8_t> chain(static_cast<size_t>(total));
+        for (uint32_t level = m_info.levelCount; level-- > firstLevel;) {
+            std::vector<uint8_t> data = readLevel(level);
+            memcpy(chain.data() + offsets[level - firstLevel], data.data(), data.size());
+        }
+        if (levelOffsets) {
+            *levelOffsets = std::move(offsets);
+        }
+        return chain;
+    }
+};
+
+#endif // EDEN_KTX2_LOADER_H
@@ -7,6 +7,9 @@
 
 #include "vulkan.h"
 #include "obj_loader.h"
+#include "residency_manager.h"
+#include "gpu_allocator.h"
+#include "upload_queue.h"
 #include <vector>
 #include <string>
 #include <cstring>
@@ -31,67 +34,31 @@ struct MeshVertex {
  * - Basic geometry (vertices, normals)
  * - Textured OBJs (UV coordinates)
  * - Automatic GPU buffer creation
+ * - Residency management: CPU copies of vertices/indices are kept, so the ResidencyManager
+ *   can evict the GPU buffers and ensureResident() re-uploads them on demand
  */
-class MeshResource {
+class MeshResource : public ResidentAsset {
 private:
     VkBuffer m_vertexBuffer = VK_NULL_HANDLE;
     VkBuffer m_indexBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory m_vertexBufferMemory = VK_NULL_HANDLE;
-    VkDeviceMemory m_indexBufferMemory = VK_NULL_HANDLE;
+    GpuAllocation m_vertexBufferMemory;
+    GpuAllocation m_indexBufferMemory;
     
     uint32_t m_indexCount = 0;
+    VkDeviceSize m_memorySize = 0;  // Vertex + index buffer bytes (for cache/budget accounting)
     bool m_loaded = false;
+    ResidencyHandle m_residency = INVALID_RESIDENCY_HANDLE;
+    uint64_t m_uploadId = 0;        // UploadQueue submission that fills the buffers
     bool m_hasNormals = false;
     bool m_hasTexcoords = false;
     
-    // Helper function to find memory type (same as TextureResource)
-    uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
-        VkPhysicalDeviceMemoryProperties memProperties;
-        vkGetPhysicalDeviceMemoryProperties(g_physicalDevice, &memProperties);
-        
-        for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
-            if ((typeFilter & (1 << i)) && 
-                (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
-                return i;
-            }
-        }
-        
-        return UINT32_MAX;
-    }
-    
-    // Create buffer helper
+    // Create buffer helper (memory is sub-allocated from the shared GpuAllocator)
     void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, 
                      VkMemoryPropertyFlags properties, VkBuffer& buffer, 
-                     VkDeviceMemory& bufferMemory) {
-        VkBufferCreateInfo bufferInfo = {};
-        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-        bufferInfo.size = size;
-        bufferInfo.usage = usage;
-        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-        
-        if (vkCreateBuffer(g_device, &bufferInfo, nullptr, &buffer) != VK_SUCCESS) {
+                     GpuAllocation& bufferMemory) {
+        if (!GpuAllocator::get_instance().createBuffer(size, usage, properties, buffer, bufferMemory)) {
             throw std::runtime_error("Failed to create buffer");
         }
-        
-        VkMemoryRequirements memRequirements;
-        vkGetBufferMemoryRequirements(g_device, buffer, &memRequirements);
-        
-        VkMemoryAllocateInfo allocInfo = {};
-        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        allocInfo.allocationSize = memRequirements.size;
-        allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, properties);
-        
-        if (allocInfo.memoryTypeIndex == UINT32_MAX) {
-            vkDestroyBuffer(g_device, buffer, nullptr);
-            throw std::runtime_error("Failed to find suitable memory type for buffer");
-        }
-        
-        if (vkAllocateMemory(g_device, &allocInfo, nullptr, &bufferMemory) != VK_SUCCESS) {
-            vkDestroyBuffer(g_device, buffer, nullptr);
-            throw std::runtime_error("Failed to allocate buffer memory");
-        }
-        
-        vkBindBufferMemory(g_device, buffer, bufferMemory, 0);
     }
     
     // Load OBJ and create Vulkan buffers
@@ -141,59 +108,22 @@ private:
         // Store indices
         m_indices = meshData.indices;
         
+        uploadBuffers();
+    }
+    
+    // Upload m_vertices/m_indices into device-local vertex/index buffers
+    // (recorded on the shared UploadQueue; submitted with the next frame's flush)
+    void uploadBuffers() {
+        UploadQueue& uploads = UploadQueue::get_instance();
+        
         // Create vertex buffer
         VkDeviceSize vertexBufferSize = sizeof(MeshVertex) * m_vertices.size();
         createBuffer(vertexBufferSize, 
                     VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
                     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
                     m_vertexBuffer, m_vertexBufferMemory);
-        
-        // Create staging buffer for vertex data
-        VkBuffer stagingVertexBuffer;
-        VkDeviceMemory stagingVertexBufferMemory;
-        createBuffer(vertexBufferSize,
-                    VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                    stagingVertexBuffer, stagingVertexBufferMemory);
-        
-        // Copy vertex data to staging buffer
-        void* data;
-        vkMapMemory(g_device, stagingVertexBufferMemory, 0, vertexBufferSize, 0, &data);
-        memcpy(data, m_vertices.data(), (size_t)vertexBufferSize);
-        vkUnmapMemory(g_device, stagingVertexBufferMemory);
-        
-        // Copy staging buffer to vertex buffer (using command buffer)
-        VkCommandBufferAllocateInfo allocInfo = {};
-        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-        allocInfo.commandPool = g_commandPool;
-        allocInfo.commandBufferCount = 1;
-        
-        VkCommandBuffer commandBuffer;
-        vkAllocateCommandBuffers(g_device, &allocInfo, &commandBuffer);
-        
-        VkCommandBufferBeginInfo beginInfo = {};
-        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-        vkBeginCommandBuffer(commandBuffer, &beginInfo);
-        
-        VkBufferCopy copyRegion = {};
-        copyRegion.size = vertexBufferSize;
-        vkCmdCopyBuffer(commandBuffer, stagingVertexBuffer, m_vertexBuffer, 1, &copyRegion);
-        
-        vkEndCommandBuffer(commandBuffer);
-        
-        VkSubmitInfo submitInfo = {};
-        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        submitInfo.commandBufferCount = 1;
-        submitInfo.pCommandBuffers = &commandBuffer;
-        
-        vkQueueSubmit(g_graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
-        vkQueueWaitIdle(g_graphicsQueue);
-        
-        vkFreeCommandBuffers(g_device, g_commandPool, 1, &commandBuffer);
-        vkDestroyBuffer(g_device, stagingVertexBuffer, nullptr);
-        vkFreeMemory(g_device, stagingVertexBufferMemory, nullptr);
+        uploads.uploadBuffer(m_vertexBuffer, 0, m_vertices.data(), vertexBufferSize,
+                             VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT);
         
         // Create index buffer
         VkDeviceSize indexBufferSize = sizeof(uint32_t) * m_indices.size();
@@ -201,38 +131,11 @@ private:
                     VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
                     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
                     m_indexBuffer, m_indexBufferMemory);
+        uploads.uploadBuffer(m_indexBuffer, 0, m_indices.data(), indexBufferSize,
+                             VK_ACCESS_INDEX_READ_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT);
         
-        // Create staging buffer for index data
-        VkBuffer stagingIndexBuffer;
-        VkDeviceMemory stagingIndexBufferMemory;
-        createBuffer(indexBufferSize,
-                    VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                    stagingIndexBuffer, stagingIndexBufferMemory);
-        
-        // Copy index data to staging buffer
-        vkMapMemory(g_device, stagingIndexBufferMemory, 0, indexBufferSize, 0, &data);
-        memcpy(data, m_indices.data(), (size_t)indexBufferSize);
-        vkUnmapMemory(g_device, stagingIndexBufferMemory);
-        
-        // Copy staging buffer to index buffer
-        vkAllocateCommandBuffers(g_device, &allocInfo, &commandBuffer);
-        vkBeginCommandBuffer(commandBuffer, &beginInfo);
-        
-        copyRegion.size = indexBufferSize;
-        vkCmdCopyBuffer(commandBuffer, stagingIndexBuffer, m_indexBuffer, 1, &copyRegion);
-        
-        vkEndCommandBuffer(commandBuffer);
-        
-        submitInfo.commandBufferCount = 1;
-        submitInfo.pCommandBuffers = &commandBuffer;
-        
-        vkQueueSubmit(g_graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
-        vkQueueWaitIdle(g_graphicsQueue);
-        
-        vkFreeCommandBuffers(g_device, g_commandPool, 1, &commandBuffer);
-        vkDestroyBuffer(g_device, stagingIndexBuffer, nullptr);
-        vkFreeMemory(g_device, stagingIndexBufferMemory, nullptr);
+        m_uploadId = uploads.getRecordingId();
+        m_memorySize = m_vertexBufferMemory.size + m_indexBufferMemory.size;
     }
 
 public:
@@ -259,6 +162,7 @@ public:
             cleanup();
             throw;
         }
+        m_residency = ResidencyManager::get_instance().track(this);
     }
     
     /**
@@ -280,103 +184,15 @@ public:
         m_hasNormals = true;
         m_hasTexcoords = true;
         
-        // Create vertex buffer
-        VkDeviceSize vertexBufferSize = sizeof(MeshVertex) * m_vertices.size();
-        if (vertexBufferSize == 0) return false;
+        if (m_vertices.empty()) return false;
         
         try {
-            createBuffer(vertexBufferSize, 
-                        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-                        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-                        m_vertexBuffer, m_vertexBufferMemory);
-            
-            // Create staging buffer for vertex data
-            VkBuffer stagingVertexBuffer;
-            VkDeviceMemory stagingVertexBufferMemory;
-            createBuffer(vertexBufferSize,
-                        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                        stagingVertexBuffer, stagingVertexBufferMemory);
-            
-            // Copy vertex data to staging buffer
-            void* data;
-            vkMapMemory(g_device, stagingVertexBufferMemory, 0, vertexBufferSize, 0, &data);
-            memcpy(data, m_vertices.data(), (size_t)vertexBufferSize);
-            vkUnmapMemory(g_device, stagingVertexBufferMemory);
-            
-            // Copy staging buffer to vertex buffer
-            VkCommandBufferAllocateInfo allocInfo = {};
-            allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-            allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-            allocInfo.commandPool = g_commandPool;
-            allocInfo.commandBufferCount = 1;
-            
-            VkCommandBuffer commandBuffer;
-            vkAllocateCommandBuffers(g_device, &allocInfo, &commandBuffer);
-            
-            VkCommandBufferBeginInfo beginInfo = {};
-            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-            vkBeginCommandBuffer(commandBuffer, &beginInfo);
-            
-            VkBufferCopy copyRegion = {};
-            copyRegion.size = vertexBufferSize;
-            vkCmdCopyBuffer(commandBuffer, stagingVertexBuffer, m_vertexBuffer, 1, &copyRegion);
-            
-            vkEndCommandBuffer(commandBuffer);
-            
-            VkSubmitInfo submitInfo = {};
-            submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-            submitInfo.commandBufferCount = 1;
-            submitInfo.pCommandBuffers = &commandBuffer;
-            
-            vkQueueSubmit(g_graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
-            vkQueueWaitIdle(g_graphicsQueue);
-            
-            vkFreeCommandBuffers(g_device, g_commandPool, 1, &commandBuffer);
-            vkDestroyBuffer(g_device, stagingVertexBuffer, nullptr);
-            vkFreeMemory(g_device, stagingVertexBufferMemory, nullptr);
-            
-            // Create index buffer
-            VkDeviceSize indexBufferSize = sizeof(uint32_t) * m_indices.size();
-            createBuffer(indexBufferSize,
-                        VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-                        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-                        m_indexBuffer, m_indexBufferMemory);
-            
-            // Create staging buffer for index data
-            VkBuffer stagingIndexBuffer;
-            VkDeviceMemory stagingIndexBufferMemory;
-            createBuffer(indexBufferSize,
-                        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                        stagingIndexBuffer, stagingIndexBufferMemory);
-            
-            // Copy index data to staging buffer
-            vkMapMemory(g_device, stagingIndexBufferMemory, 0, indexBufferSize, 0, &data);
-            memcpy(data, m_indices.data(), (size_t)indexBufferSize);
-            vkUnmapMemory(g_device, stagingIndexBufferMemory);
-            
-            // Copy staging buffer to index buffer
-            vkAllocateCommandBuffers(g_device, &allocInfo, &commandBuffer);
-            vkBeginCommandBuffer(commandBuffer, &beginInfo);
-            
-            copyRegion.size = indexBufferSize;
-            vkCmdCopyBuffer(commandBuffer, stagingIndexBuffer, m_indexBuffer, 1, &copyRegion);
-            
-            vkEndCommandBuffer(commandBuffer);
-            
-            submitInfo.commandBufferCount = 1;
-            submitInfo.pCommandBuffers = &commandBuffer;
-            
-            vkQueueSubmit(g_graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
-            vkQueueWaitIdle(g_graphicsQueue);
-            
-            vkFreeCommandBuffers(g_device, g_commandPool, 1, &commandBuffer);
-            vkDestroyBuffer(g_device, stagingIndexBuffer, nullptr);
-            vkFreeMemory(g_device, stagingIndexBufferMemory, nullptr);
+            uploadBuffers();
             
             m_loaded = true;
+            if (m_residency == INVALID_RESIDENCY_HANDLE) {
+                m_residency = ResidencyManager::get_instance().track(this);
+            }
             return true;
         } catch (const std::exception& e) {
             cleanup();
@@ -388,13 +204,19 @@ public:
     MeshResource(MeshResource&& other) noexcept 
         : m_vertexBuffer(other.m_vertexBuffer), m_indexBuffer(other.m_indexBuffer),
           m_vertexBufferMemory(other.m_vertexBufferMemory), m_indexBufferMemory(other.m_indexBufferMemory),
-          m_indexCount(other.m_indexCount), m_loaded(other.m_loaded),
-          m_hasNormals(other.m_hasNormals), m_hasTexcoords(other.m_hasTexcoords) {
+          m_indexCount(other.m_indexCount), m_memorySize(other.m_memorySize), m_loaded(other.m_loaded),
+          m_residency(other.m_residency), m_uploadId(other.m_uploadId),
+          m_hasNormals(other.m_hasNormals), m_hasTexcoords(other.m_hasTexcoords),
+          m_vertices(std::move(other.m_vertices)), m_indices(std::move(other.m_indices)) {
         other.m_vertexBuffer = VK_NULL_HANDLE;
         other.m_indexBuffer = VK_NULL_HANDLE;
-        other.m_vertexBufferMemory = VK_NULL_HANDLE;
-        other.m_indexBufferMemory = VK_NULL_HANDLE;
+        other.m_vertexBufferMemory = GpuAllocation();
+        other.m_indexBufferMemory = GpuAllocation();
+        other.m_memorySize = 0;
         other.m_loaded = false;
+        other.m_residency = INVALID_RESIDENCY_HANDLE;
+        other.m_uploadId = 0;
+        ResidencyManager::get_instance().retarget(m_residency, this);
     }
     
     // Delete copy constructor and assignment (meshes are unique resources)
@@ -408,22 +230,59 @@ public:
     
     // Cleanup helper
     void cleanup() {
+        if (m_residency != INVALID_RESIDENCY_HANDLE) {
+            ResidencyManager::get_instance().untrack(m_residency);
+            m_residency = INVALID_RESIDENCY_HANDLE;
+        }
+        releaseGpuBuffers();
+    }
+    
+    /**
+     * Mark the mesh as used this frame, re-uploading it if the ResidencyManager evicted it.
+     * @return true if the vertex/index buffer handles changed
+     */
+    bool ensureResident() {
+        return ResidencyManager::get_instance().touch(m_residency);
+    }
+    
+    // ResidentAsset interface (called by the ResidencyManager)
+    size_t getResidentBytes() const override {
+        return static_cast<size_t>(m_memorySize);
+    }
+    
+    size_t evictResidency() override {
+        size_t freed = static_cast<size_t>(m_memorySize);
+        releaseGpuBuffers();
+        return freed;
+    }
+    
+    bool restoreResidency() override {
+        try {
+            uploadBuffers();
+            m_loaded = true;
+        } catch (const std::exception& e) {
+            releaseGpuBuffers();
+            return false;
+        }
+        return true;
+    }
+    
+    // Destroy Vulkan buffers but keep CPU-side geometry and residency registration
+    void releaseGpuBuffers() {
+        // A pending upload must not write into buffers that are about to be destroyed
+        UploadQueue::get_instance().waitFor(m_uploadId);
+        m_uploadId = 0;
         if (m_indexBuffer != VK_NULL_HANDLE) {
             vkDestroyBuffer(g_device, m_indexBuffer, nullptr);
             m_indexBuffer = VK_NULL_HANDLE;
         }
-        if (m_indexBufferMemory != VK_NULL_HANDLE) {
-            vkFreeMemory(g_device, m_indexBufferMemory, nullptr);
-            m_indexBufferMemory = VK_NULL_HANDLE;
-        }
+        GpuAllocator::get_instance().free(m_indexBufferMemory);
         if (m_vertexBuffer != VK_NULL_HANDLE) {
             vkDestroyBuffer(g_device, m_vertexBuffer, nullptr);
             m_vertexBuffer = VK_NULL_HANDLE;
         }
-        if (m_vertexBufferMemory != VK_NULL_HANDLE) {
-            vkFreeMemory(g_device, m_vertexBufferMemory, nullptr);
-            m_vertexBufferMemory = VK_NULL_HANDLE;
-        }
+        GpuAllocator::get_instance().free(m_vertexBufferMemory);
+        m_memorySize = 0;
         m_loaded = false;
     }
     
@@ -431,6 +290,7 @@ public:
     VkBuffer getVertexBuffer() const { return m_vertexBuffer; }
     VkBuffer getIndexBuffer() const { return m_indexBuffer; }
     uint32_t getIndexCount() const { return m_indexCount; }
+    VkDeviceSize getMemorySize() const { return m_memorySize; }
     bool hasNormals() const { return m_hasNormals; }
     bool hasTexcoords() const { return m_hasTexcoords; }
     bool isLoaded() const { return m_loaded; }
@@ -0,0 +1,672 @@
+// EDEN ENGINE - PipelineCache
+// Disk-persistent VkPipelineCache shared by every graphics pipeline the renderer creates, and a
+// small worker pool that rebuilds pipelines off the render thread (shader hot-reload).
+// A cache file is only handed to the driver when its header matches this exact device, driver
+// and cache UUID and its checksum is intact; anything else is ignored and replaced on save.
+
+#ifndef EDEN_PIPELINE_CACHE_H
+#define EDEN_PIPELINE_CACHE_H
+
+#include "vulkan.h"
+#include <vector>
+#include <deque>
+#include <memory>
+#include <string>
+#include <functional>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <iostream>
+
+static constexpr uint32_t PIPELINE_CACHE_FILE_MAGIC = 0x43504445;   // "EDPC"
+static constexpr uint32_t PIPELINE_CACHE_FILE_VERSION = 1;
+static constexpr uint32_t PIPELINE_CACHE_UUID_SIZE = 16;
+
+// Identity of the device a cache blob was produced on (VkPhysicalDeviceProperties)
+struct PipelineCacheDeviceInfo {
+    uint32_t vendorID = 0;
+    uint32_t deviceID = 0;
+    uint32_t driverVersion = 0;
+    uint8_t pipelineCacheUUID[PIPELINE_CACHE_UUID_SIZE] = {};
+};
+
+// File layout: this header, then `dataSize` bytes from vkGetPipelineCacheData
+struct PipelineCacheFileHeader {
+    uint32_t magic = PIPELINE_CACHE_FILE_MAGIC;
+    uint32_t version = PIPELINE_CACHE_FILE_VERSION;
+    uint32_t headerSize = sizeof(PipelineCacheFileHeader);
+    uint32_t vendorID = 0;
+    uint32_t deviceID = 0;
+    uint32_t driverVersion = 0;
+    uint8_t pipelineCacheUUID[PIPELINE_CACHE_UUID_SIZE] = {};
+    uint64_t dataSize = 0;
+    uint64_t checksum = 0;          // FNV-1a over the cache data
+};
+static_assert(sizeof(PipelineCacheFileHeader) == 56, "PipelineCacheFileHeader must stay tightly packed");
+
+enum class PipelineCacheStatus {
+    Valid,
+    TooSmall,               // Shorter than the headers it claims to have
+    BadMagic,               // Not a pipeline cache file
+    BadVersion,             // Written by a different file format version
+    DeviceMismatch,         // Other GPU or other cache UUID
+    DriverMismatch,         // Same GPU, different driver version
+    BadChecksum,            // Truncated or corrupted data
+    BadVulkanHeader         // The driver's own header does not describe this device
+};
+
+inline const char* pipeline_cache_status_name(PipelineCacheStatus status) {
+    switch (status) {
+        case PipelineCacheStatus::Valid: return "valid";
+        case PipelineCacheStatus::TooSmall: return "too small";
+        case PipelineCacheStatus::BadMagic: return "not a pipeline cache";
+        case PipelineCacheStatus::BadVersion: return "old file version";
+        case PipelineCacheStatus::DeviceMismatch: return "different device";
+        case PipelineCacheStatus::DriverMismatch: return "different driver version";
+        case PipelineCacheStatus::BadChecksum: return "checksum mismatch";
+        case PipelineCacheStatus::BadVulkanHeader: return "bad Vulkan cache header";
+    }
+    return "unknown";
+}
+
+inline uint64_t pipeline_cache_checksum(const uint8_t* data, size_t size) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ data[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+/**
+ * Build the on-disk image of a cache blob (file header + data)
+ */
+inline std::vector<uint8_t> pipeline_cache_serialize(const PipelineCacheDeviceInfo& device,
+                                                     const uint8_t* data, size_t size) {
+    PipelineCacheFileHeader header;
+    header.vendorID = device.vendorID;
+    header.deviceID = device.deviceID;
+    header.driverVersion = device.driverVersion;
+    std::memcpy(header.pipelineCacheUUID, device.pipelineCacheUUID, PIPELINE_CACHE_UUID_SIZE);
+    header.dataSize = size;
+    header.checksum = pipeline_cache_checksum(data, size);
+
+    std::vector<uint8_t> file(sizeof(header) + size);
+    std::memcpy(file.data(), &header, sizeof(header));
+    if (size > 0) {
+        std::memcpy(file.data() + sizeof(header), data, size);
+    }
+    return file;
+}
+
+/**
+ * Check a cache file image against the current device. On success `data`/`dataSize` point at
+ * the blob inside `file` that can be passed to vkCreatePipelineCache.
+ *
+ * Besides our own header, the VkPipelineCacheHeaderVersionOne at the start of the blob is
+ * checked too (header size, version 1, vendor, device and cache UUID), so a file copied between
+ * machines or edited by hand never reaches the driver.
+ */
+inline PipelineCacheStatus pipeline_cache_validate(const uint8_t* file, size_t size,
+                                                   const PipelineCacheDeviceInfo& device,
+                                                   const uint8_t** data, size_t* dataSize) {
+    PipelineCacheFileHeader header;
+    if (size < sizeof(header)) {
+        return PipelineCacheStatus::TooSmall;
+    }
+    std::memcpy(&header, file, sizeof(header));
+    if (header.magic != PIPELINE_CACHE_FILE_MAGIC) {
+        return PipelineCacheStatus::BadMagic;
+    }
+    if (header.version != PIPELINE_CACHE_FILE_VERSION || header.headerSize != sizeof(header)) {
+        return PipelineCacheStatus::BadVersion;
+    }
+    if (header.vendorID != device.vendorID || header.deviceID != device.deviceID ||
+        std::memcmp(header.pipelineCacheUUID, device.pipelineCacheUUID, PIPELINE_CACHE_UUID_SIZE) != 0) {
+        return PipelineCacheStatus::DeviceMismatch;
+    }
+    if (header.driverVersion != device.driverVersion) {
+        return PipelineCacheStatus::DriverMismatch;
+    }
+    if (header.dataSize != size - sizeof(header)) {
+        return PipelineCacheStatus::TooSmall;
+    }
+    const uint8_t* blob = file + sizeof(header);
+    if (pipeline_cache_checksum(blob, static_cast<size_t>(header.dataSize)) != header.checksum) {
+        return PipelineCacheStatus::BadChecksum;
+    }
+
+    // VkPipelineCacheHeaderVersionOne: headerSize, headerVersion, vendorID, deviceID, UUID
+    const size_t VULKAN_HEADER_SIZE = 16 + PIPELINE_CACHE_UUID_SIZE;
+    if (header.dataSize < VULKAN_HEADER_SIZE) {
+        return PipelineCacheStatus::BadVulkanHeader;
+    }
+    uint32_t fields[4];
+    std::memcpy(fields, blob, sizeof(fields));
+    if (fields[0] < VULKAN_HEADER_SIZE || fields[0] > header.dataSize || fields[1] != 1 ||
+        fields[2] != device.vendorID || fields[3] != device.deviceID ||
+        std::memcmp(blob + 16, device.pipelineCacheUUID, PIPELINE_CACHE_UUID_SIZE) != 0) {
+        return PipelineCacheStatus::BadVulkanHeader;
+    }
+
+    *data = blob;
+    *dataSize = static_cast<size_t>(header.dataSize);
+    return PipelineCacheStatus::Valid;
+}
+
+/**
+ * GraphicsPipelineDesc - Self-contained description of a simple graphics pipeline
+ *
+ * Owns everything the create-info structs point at, so it can be copied into a job and built
+ * on another thread. Covers the renderer's forward pipelines: two shader stages, one optional
+ * vertex layout, a static or dynamic viewport, optional depth test and alpha blending.
+ */
+struct GraphicsPipelineDesc {
+    VkShaderModule vertexShader = VK_NULL_HANDLE;
+    VkShaderModule fragmentShader = VK_NULL_HANDLE;
+    std::vector<VkVertexInputBindingDescription> bindings;
+    std::vector<VkVertexInputAttributeDescription> attributes;
+    VkPrimitiveTopology topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    VkExtent2D extent = {};                     // Static viewport/scissor (ignored if dynamicViewport)
+    bool dynamicViewport = false;
+    VkCullModeFlags cullMode = VK_CULL_MODE_NONE;
+    VkFrontFace frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+    bool depthTest = false;
+    bool depthWrite = false;
+    VkCompareOp depthCompareOp = VK_COMPARE_OP_LESS;
+    bool alphaBlend = false;
+    VkPipelineLayout layout = VK_NULL_HANDLE;
+    VkRenderPass renderPass = VK_NULL_HANDLE;
+    uint32_t subpass = 0;
+};
+
+/**
+ * Create a pipeline from `desc` through `cache` (VK_NULL_HANDLE for no cache).
+ * Safe to call from any thread: every create-info struct lives on this call's stack.
+ */
+inline VkResult create_graphics_pipeline(VkDevice device, VkPipelineCache cache,
+                                         const GraphicsPipelineDesc& desc, VkPipeline* pipeline) {
+    VkPipelineShaderStageCreateInfo stages[2] = {};
+    stages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+    stages[0].module = desc.vertexShader;
+    stages[0].pName = "main";
+    stages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+    stages[1].module = desc.fragmentShader;
+    stages[1].pName = "main";
+
+    VkPipelineVertexInputStateCreateInfo vertexInputInfo = {};
+    vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    vertexInputInfo.vertexBindingDescriptionCount = static_cast<uint32_t>(desc.bindings.size());
+    vertexInputInfo.pVertexBindingDescriptions = desc.bindings.data();
+    vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(desc.attributes.size());
+    vertexInputInfo.pVertexAttributeDescriptions = desc.attributes.data();
+
+    VkPipelineInputAssemblyStateCreateInfo inputAssembly = {};
+    inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    inputAssembly.topology = desc.topology;
+    inputAssembly.primitiveRestartEnable = VK_FALSE;
+
+    VkViewport viewport = {};
+    viewport.width = static_cast<float>(desc.extent.width);
+    viewport.height = static_cast<float>(desc.extent.height);
+    viewport.maxDepth = 1.0f;
+    VkRect2D scissor = {};
+    scissor.extent = desc.extent;
+
+    VkPipelineViewportStateCreateInfo viewportState = {};
+    viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewportState.viewportCount = 1;
+    viewportState.pViewports = desc.dynamicViewport ? nullptr : &viewport;
+    viewportState.scissorCount = 1;
+    viewportState.pScissors = desc.dynamicViewport ? nullptr : &scissor;
+
+    VkPipelineRasterizationStateCreateInfo rasterizer = {};
+    rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+    rasterizer.lineWidth = 1.0f;
+    rasterizer.cullMode = desc.cullMode;
+    rasterizer.frontFace = desc.frontFace;
+
+    VkPipelineMultisampleStateCreateInfo multisampling = {};
+    multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    VkPipelineDepthStencilStateCreateInfo depthStencil = {};
+    depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+    depthStencil.depthTestEnable = desc.depthTest ? VK_TRUE : VK_FALSE;
+    depthStencil.depthWriteEnable = desc.depthWrite ? VK_TRUE : VK_FALSE;
+    depthStencil.depthCompareOp = desc.depthTest ? desc.depthCompareOp : VK_COMPARE_OP_ALWAYS;
+
+    VkPipelineColorBlendAttachmentState colorBlendAttachment = {};
+    colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
+                                          VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+    if (desc.alphaBlend) {
+        colorBlendAttachment.blendEnable = VK_TRUE;
+        colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+        colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+        colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
+        colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+        colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+        colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
+    }
+
+    VkPipelineColorBlendStateCreateInfo colorBlending = {};
+    colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    colorBlending.attachmentCount = 1;
+    colorBlending.pAttachments = &colorBlendAttachment;
+
+    VkDynamicState dynamicStates[] = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+    VkPipelineDynamicStateCreateInfo dynamicState = {};
+    dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamicState.dynamicStateCount = 2;
+    dynamicState.pDynamicStates = dynamicStates;
+
+    VkGraphicsPipelineCreateInfo pipelineInfo = {};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    pipelineInfo.stageCount = 2;
+    pipelineInfo.pStages = stages;
+    pipelineInfo.pVertexInputState = &vertexInputInfo;
+    pipelineInfo.pInputAssemblyState = &inputAssembly;
+    pipelineInfo.pViewportState = &viewportState;
+    pipelineInfo.pRasterizationState = &rasterizer;
+    pipelineInfo.pMultisampleState = &multisampling;
+    pipelineInfo.pDepthStencilState = &depthStencil;
+    pipelineInfo.pColorBlendState = &colorBlending;
+    pipelineInfo.pDynamicState = desc.dynamicViewport ? &dynamicState : nullptr;
+    pipelineInfo.layout = desc.layout;
+    pipelineInfo.renderPass = desc.renderPass;
+    pipelineInfo.subpass = desc.subpass;
+    pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
+
+    return vkCreateGraphicsPipelines(device, cache, 1, &pipelineInfo, nullptr, pipeline);
+}
+
+/**
+ * PipelineCache - Process-wide pipeline cache and asynchronous pipeline rebuilds
+ *
+ * Provides:
+ * - One VkPipelineCache for every vkCreateGraphicsPipelines call (renderer paths, ImGui and
+ *   generated create_<pipeline>_pipeline functions), loaded from disk at init and written back
+ *   (temporary file + rename, so a crash never leaves a half-written cache) at save/shutdown
+ * - rebuildAsync(): compiles a GraphicsPipelineDesc on a worker thread against the shared
+ *   cache. The pipeline it replaces keeps rendering until update() swaps the new one in on the
+ *   render thread; the old one is destroyed once the frames that used it have finished.
+ *   If the same pipeline is rebuilt again before an older build lands, the older result is dropped.
+ * - retire(): deferred destruction of objects (e.g. replaced shader modules) until running
+ *   builds and in-flight frames can no longer use them
+ *
+ * The cache itself is internally synchronized by the driver; everything else here is called
+ * from the render thread.
+ *
+ * Usage:
+ *   PipelineCache& pipelines = PipelineCache::get_instance();
+ *   pipelines.init(device, physicalDevice, "pipeline_cache.bin");
+ *   vkCreateGraphicsPipelines(device, pipelines.get(), 1, &info, nullptr, &pipeline);
+ *   pipelines.rebuildAsync(&pipeline, desc);   // After a shader changed
+ *   pipelines.update();                        // Once per frame, before recording
+ *   pipelines.shutdown();                      // Device idle; saves the cache
+ */
+class PipelineCache {
+public:
+    struct Stats {
+        PipelineCacheStatus loadStatus = PipelineCacheStatus::TooSmall;
+        bool loadedFromDisk = false;
+        size_t loadedBytes = 0;
+        size_t savedBytes = 0;
+        uint32_t buildsStarted = 0;
+        uint32_t buildsSwapped = 0;
+        uint32_t buildsDropped = 0;     // Superseded by a newer build, or shut down before landing
+        uint32_t buildsFailed = 0;
+    };
+
+private:
+    struct Build {
+        uint64_t id = 0;
+        VkPipeline* target = nullptr;
+        GraphicsPipelineDesc desc;
+        std::function<void(bool)> onDone;
+        VkPipeline result = VK_NULL_HANDLE;
+        VkResult status = VK_NOT_READY;
+        bool finished = false;
+    };
+
+    struct Retired {
+        uint64_t frame;
+        uint64_t lastBuild;         // Destroy only after every build up to this id has finished
+        std::function<void()> destroy;
+    };
+
+    VkDevice m_device = VK_NULL_HANDLE;
+    VkPipelineCache m_cache = VK_NULL_HANDLE;
+    PipelineCacheDeviceInfo m_deviceInfo;
+    std::string m_path;
+    uint64_t m_savedChecksum = 0;
+
+    std::deque<std::unique_ptr<Build>> m_builds;    // Submission order, until update() lands them
+    std::deque<Build*> m_queue;                     // Not yet picked up by a worker
+    std::unordered_map<VkPipeline*, uint64_t> m_latestBuild;
+    std::deque<Retired> m_retired;
+    uint64_t m_nextBuild = 1;
+    uint64_t m_frame = 0;
+    uint32_t m_retireFrames = 3;                    // Frames a replaced pipeline may still be in use
+
+    std::vector<std::thread> m_workers;
+    uint32_t m_threadCount = 0;                     // 0 = half the hardware threads, at most 4
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_stop = false;
+
+    Stats m_stats;
+
+    void workerLoop() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            m_wake.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+            if (m_queue.empty()) {
+                return;
+            }
+            Build* build = m_queue.front();
+            m_queue.pop_front();
+            lock.unlock();
+
+            VkPipeline pipeline = VK_NULL_HANDLE;
+            VkResult status = create_graphics_pipeline(m_device, m_cache, build->desc, &pipeline);
+
+            lock.lock();
+            build->result = pipeline;
+            build->status = status;
+            build->finished = true;
+        }
+    }
+
+    void startWorkers() {
+        uint32_t count = m_threadCount;
+        if (count == 0) {
+            count = std::min(4u, std::max(1u, std::thread::hardware_concurrency() / 2));
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            m_workers.emplace_back(&PipelineCache::workerLoop, this);
+        }
+    }
+
+    void stopWorkers() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for (std::thread& worker : m_workers) {
+            worker.join();
+        }
+        m_workers.clear();
+        m_stop = false;
+    }
+
+    // Land finished builds in submission order; `discard` destroys results instead of swapping
+    void landBuilds(bool discard) {
+        std::vector<std::unique_ptr<Build>> landed;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            while (!m_builds.empty() && m_builds.front()->finished) {
+                landed.push_back(std::move(m_builds.front()));
+                m_builds.pop_front();
+            }
+        }
+        for (std::unique_ptr<Build>& build : landed) {
+            bool ok = build->status == VK_SUCCESS && build->result != VK_NULL_HANDLE;
+            bool current = m_latestBuild[build->target] == build->id;
+            if (discard || !current) {
+                if (build->result != VK_NULL_HANDLE) {
+                    vkDestroyPipeline(m_device, build->result, nullptr);
+                }
+                m_stats.buildsDropped++;
+                ok = false;
+            } else if (!ok) {
+                m_stats.buildsFailed++;
+                std::cerr << "[PipelineCache] ERROR: Pipeline rebuild failed (VkResult " << build->status
+                          << "), keeping the current pipeline" << std::endl;
+            } else {
+                VkPipeline old = *build->target;
+                *build->target = build->result;
+                if (old != VK_NULL_HANDLE) {
+                    VkDevice device = m_device;
+                    retire([device, old]() { vkDestroyPipeline(device, old, nullptr); });
+                }
+                m_stats.buildsSwapped++;
+            }
+            if (current) {
+                m_latestBuild.erase(build->target);
+            }
+            if (build->onDone) {
+                build->onDone(ok);
+            }
+        }
+    }
+
+    // Smallest build id not landed yet (every build below it has finished)
+    uint64_t firstPendingBuild() const {
+        return m_builds.empty() ? m_nextBuild : m_builds.front()->id;
+    }
+
+public:
+    PipelineCache() = default;
+    PipelineCache(const PipelineCache&) = delete;
+    PipelineCache& operator=(const PipelineCache&) = delete;
+
+    ~PipelineCache() {
+        stopWorkers();
+    }
+
+    static PipelineCache& get_instance() {
+        static PipelineCache instance;
+        return instance;
+    }
+
+    /**
+     * Create the pipeline cache, seeded from `path` if that file was written for this device
+     * and driver (an empty path keeps the cache in memory only). Returns false only if no cache could be created at all (pipelines then
+     * compile uncached, which is still correct).
+     */
+    bool init(VkDevice device, VkPhysicalDevice physicalDevice, const std::string& path = "pipeline_cache.bin") {
+        if (m_cache != VK_NULL_HANDLE) {
+            return true;
+        }
+        m_device = device;
+        m_path = path;
+        m_stats = Stats();
+
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+        m_deviceInfo.vendorID = properties.vendorID;
+        m_deviceInfo.deviceID = properties.deviceID;
+        m_deviceInfo.driverVersion = properties.driverVersion;
+        std::memcpy(m_deviceInfo.pipelineCacheUUID, properties.pipelineCacheUUID, PIPELINE_CACHE_UUID_SIZE);
+
+        std::vector<uint8_t> file;
+        std::ifstream in;
+        if (!m_path.empty()) {
+            in.open(m_path, std::ios::binary | std::ios::ate);
+        }
+        if (in.is_open()) {
+            file.resize(static_cast<size_t>(in.tellg()));
+            in.seekg(0);
+            in.read(reinterpret_cast<char*>(file.data()), static_cast<std::streamsize>(file.size()));
+            if (!in) {
+                file.clear();
+            }
+        }
+
+        const uint8_t* data = nullptr;
+        size_t dataSize = 0;
+        if (!file.empty()) {
+            m_stats.loadStatus = pipeline_cache_validate(file.data(), file.size(), m_deviceInfo, &data, &dataSize);
+            if (m_stats.loadStatus != PipelineCacheStatus::Valid) {
+                std::cout << "[PipelineCache] Ignoring " << m_path << " ("
+                          << pipeline_cache_status_name(m_stats.loadStatus) << ")" << std::endl;
+                data = nullptr;
+                dataSize = 0;
+            }
+        }
+
+        VkPipelineCacheCreateInfo createInfo = {};
+        createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        createInfo.initialDataSize = dataSize;
+        createInfo.pInitialData = data;
+        VkResult result = vkCreatePipelineCache(m_device, &createInfo, nullptr, &m_cache);
+        if (result != VK_SUCCESS && data != nullptr) {
+            // The driver rejected data that passed our checks; start empty
+            createInfo.initialDataSize = 0;
+            createInfo.pInitialData = nullptr;
+            dataSize = 0;
+            result = vkCreatePipelineCache(m_device, &createInfo, nullptr, &m_cache);
+        }
+        if (result != VK_SUCCESS) {
+            std::cerr << "[PipelineCache] ERROR: Failed to create pipeline cache!" << std::endl;
+            m_cache = VK_NULL_HANDLE;
+            return false;
+        }
+
+        m_stats.loadedFromDisk = dataSize > 0;
+        m_stats.loadedBytes = dataSize;
+        m_savedChecksum = dataSize > 0 ? pipeline_cache_checksum(data, dataSize) : 0;
+        if (dataSize > 0) {
+            std::cout << "[PipelineCache] Loaded " << dataSize << " bytes from " << m_path << std::endl;
+        }
+        return true;
+    }
+
+    // The shared cache (VK_NULL_HANDLE before init, which Vulkan treats as "no cache")
+    VkPipelineCache get() const { return m_cache; }
+
+    /**
+     * Write the cache to disk if it changed since it was loaded or last saved
+     */
+    bool save() {
+        if (m_cache == VK_NULL_HANDLE || m_path.empty()) {
+            return false;
+        }
+        size_t size = 0;
+        if (vkGetPipelineCacheData(m_device, m_cache, &size, nullptr) != VK_SUCCESS || size == 0) {
+            return false;
+        }
+        std::vector<uint8_t> data(size);
+        if (vkGetPipelineCacheData(m_device, m_cache, &size, data.data()) != VK_SUCCESS) {
+            return false;
+        }
+        data.resize(size);
+        uint64_t checksum = pipeline_cache_checksum(data.data(), data.size());
+        if (checksum == m_savedChecksum) {
+            return true;
+        }
+
+        std::vector<uint8_t> file = pipeline_cache_serialize(m_deviceInfo, data.data(), data.size());
+        std::string tempPath = m_path + ".tmp";
+        {
+            std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(file.data()), static_cast<std::streamsize>(file.size()));
+            if (!out) {
+                std::cerr << "[PipelineCache] ERROR: Failed to write " << tempPath << std::endl;
+                return false;
+            }
+        }
+        std::remove(m_path.c_str());    // rename() does not replace an existing file on Windows
+        if (std::rename(tempPath.c_str(), m_path.c_str()) != 0) {
+            std::cerr << "[PipelineCache] ERROR: Failed to replace " << m_path << std::endl;
+            return false;
+        }
+        m_savedChecksum = checksum;
+        m_stats.savedBytes = data.size();
+        return true;
+    }
+
+    /**
+     * Rebuild the pipeline stored in `*target` from `desc` on a worker thread. `*target` is
+     * replaced by update() once the build lands; `onDone(ok)` then runs on the render thread.
+     * Shader modules in `desc` must stay alive until then (retire() them instead of destroying).
+     */
+    void rebuildAsync(VkPipeline* target, const GraphicsPipelineDesc& desc, std::function<void(bool)> onDone = nullptr) {
+        if (m_workers.empty()) {
+            startWorkers();
+        }
+        std::unique_ptr<Build> build(new Build());
+        build->id = m_nextBuild++;
+        build->target = target;
+        build->desc = desc;
+        build->onDone = std::move(onDone);
+        m_latestBuild[target] = build->id;
+        m_stats.buildsStarted++;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_queue.push_back(build.get());
+            m_builds.push_back(std::move(build));
+        }
+        m_wake.notify_one();
+    }
+
+    // Whether any rebuild has not landed yet
+    bool isBuilding() const { return !m_builds.empty(); }
+
+    /**
+     * Destroy `destroy`'s objects once the builds started so far have finished and the frames
+     * that may still reference them are done
+     */
+    void retire(std::function<void()> destroy) {
+        m_retired.push_back({m_frame, m_nextBuild - 1, std::move(destroy)});
+    }
+
+    /**
+     * Advance one frame: swap in pipelines whose builds finished and destroy old retired objects
+     */
+    void update() {
+        m_frame++;
+        landBuilds(false);
+        uint64_t firstPending = firstPendingBuild();
+        while (!m_retired.empty() && m_frame - m_retired.front().frame > m_retireFrames &&
+               m_retired.front().lastBuild < firstPending) {
+            m_retired.front().destroy();
+            m_retired.pop_front();
+        }
+    }
+
+    /**
+     * Wait for running builds, drop their results, destroy retired objects, save the cache to
+     * disk and destroy it. The device must be idle.
+     */
+    void shutdown() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (Build* build : m_queue) {
+                build->finished = true;     // Never started, nothing to destroy
+            }
+            m_queue.clear();
+        }
+        stopWorkers();
+        landBuilds(true);
+        m_builds.clear();
+        m_latestBuild.clear();
+        while (!m_retired.empty()) {
+            m_retired.front().destroy();
+            m_retired.pop_front();
+        }
+        if (m_cache != VK_NULL_HANDLE) {
+            save();
+            vkDestroyPipelineCache(m_device, m_cache, nullptr);
+            m_cache = VK_NULL_HANDLE;
+        }
+        m_device = VK_NULL_HANDLE;
+    }
+
+    void setRetireFrames(uint32_t frames) { m_retireFrames = frames; }
+    void setThreadCount(uint32_t threads) { m_threadCount = threads; }
+    const std::string& getPath() const { return m_path; }
+    const Stats& getStats() const { return m_stats; }
+};
+
+#endif // EDEN_PIPELINE_CACHE_H
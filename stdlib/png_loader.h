@@ -6,24 +6,22 @@
 #define EDEN_PNG_LOADER_H
 
 #include "vulkan.h"
+#include "mip_builder.h"
 #include <vector>
 #include <string>
 #include <fstream>
 #include <cstring>
 
-// Use stb_image for PNG loading (single-header library)
-// Always include the header for declarations and constants
+// Decoding goes through image_decoder.h (stb_image configuration, SIMD RGBA expansion)
 // STB_IMAGE_IMPLEMENTATION should be defined in exactly ONE .cpp file before including this header
-// The header itself is safe to include multiple times - only the implementation is defined once
-#define STBI_ONLY_PNG
-#define STBI_NO_LINEAR  // We don't need HDR support for PNG
-#include "../stdlib/stb_image.h"
+#include "image_decoder.h"
 
 // PNG data structure (similar to DDS but uncompressed)
 struct PNGData {
     VkFormat format;              // Always VK_FORMAT_R8G8B8A8_SRGB for PNG
     uint32_t width, height;
-    std::vector<uint8_t> pixelData;  // RGBA8 uncompressed data
+    std::vector<uint8_t> pixelData;  // RGBA8 uncompressed data (all mip levels after generate_png_mipmaps)
+    std::vector<MipLevel> mipLevels; // Empty until generate_png_mipmaps (level 0 only)
 };
 
 /**
@@ -35,26 +33,18 @@ struct PNGData {
 inline PNGData load_png(const std::string& filepath) {
     PNGData result;
     
-    // stb_image loads PNG and converts to RGBA8
-    int width, height, channels;
-    unsigned char* pixels = stbi_load(filepath.c_str(), &width, &height, &channels, STBI_rgb_alpha);
-    
-    if (!pixels) {
-        throw std::runtime_error("Failed to load PNG: " + filepath + " - " + stbi_failure_reason());
+    // Decoded straight into pixelData (RGB sources are expanded to RGBA8 on the way)
+    ImageInfo info;
+    try {
+        result.pixelData = load_image_rgba8(filepath, info);
+    } catch (const std::exception& e) {
+        throw std::runtime_error(std::string("Failed to load PNG - ") + e.what());
     }
     
     // PNG is always loaded as RGBA8
     result.format = VK_FORMAT_R8G8B8A8_SRGB;
-    result.width = static_cast<uint32_t>(width);
-    result.height = static_cast<uint32_t>(height);
-    
-    // Copy pixel data (STBI_rgb_alpha always gives 4 channels)
-    size_t dataSize = width * height * 4;
-    result.pixelData.resize(dataSize);
-    memcpy(result.pixelData.data(), pixels, dataSize);
-    
-    // Free stb_image's buffer
-    stbi_image_free(pixels);
+    result.width = info.width;
+    result.height = info.height;
     
     return result;
 }
@@ -66,26 +56,30 @@ inline PNGData load_png(const std::string& filepath) {
 inline PNGData load_png_from_memory(const uint8_t* data, size_t size) {
     PNGData result;
     
-    int width, height, channels;
-    unsigned char* pixels = stbi_load_from_memory(data, static_cast<int>(size), 
-                                                   &width, &height, &channels, STBI_rgb_alpha);
-    
-    if (!pixels) {
+    ImageInfo info;
+    if (!read_image_info(data, size, info)) {
         throw std::runtime_error("Failed to load PNG from memory - " + std::string(stbi_failure_reason()));
     }
     
     result.format = VK_FORMAT_R8G8B8A8_SRGB;
-    result.width = static_cast<uint32_t>(width);
-    result.height = static_cast<uint32_t>(height);
-    
-    size_t dataSize = width * height * 4;
-    result.pixelData.resize(dataSize);
-    memcpy(result.pixelData.data(), pixels, dataSize);
-    
-    stbi_image_free(pixels);
+    result.width = info.width;
+    result.height = info.height;
+    result.pixelData.resize(info.rgba8Size());
+    decode_image_into(data, size, info, result.pixelData.data());
     
     return result;
 }
 
+/**
+ * Replace pixelData with the full mip chain (level 0 first, tightly packed) and fill mipLevels
+ * Filtering happens in linear light for sRGB formats.
+ */
+inline void generate_png_mipmaps(PNGData& png, MipFilter filter = MipFilter::Box) {
+    MipChain chain = build_mip_chain(png.pixelData.data(), png.width, png.height,
+                                     png.format == VK_FORMAT_R8G8B8A8_SRGB, filter);
+    png.pixelData = std::move(chain.data);
+    png.mipLevels = std::move(chain.levels);
+}
+
 #endif // EDEN_PNG_LOADER_H
 
@@ -0,0 +1,287 @@
+// EDEN ENGINE - ResidencyManager
+// Tracks GPU bytes per TextureResource/MeshResource and enforces a device memory budget
+// Over budget, least-recently-used assets drop their top mips or are evicted entirely;
+// evicted assets reload on demand the next time they are used.
+//
+// The manager only does accounting and policy. It talks to assets through ResidentAsset,
+// so it can be exercised CPU-side with a mock asset/allocator (no Vulkan required).
+
+#ifndef EDEN_RESIDENCY_MANAGER_H
+#define EDEN_RESIDENCY_MANAGER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <list>
+
+/**
+ * ResidentAsset - Interface implemented by anything the ResidencyManager can evict
+ */
+class ResidentAsset {
+public:
+    virtual ~ResidentAsset() = default;
+
+    // Bytes of device memory currently held
+    virtual size_t getResidentBytes() const = 0;
+
+    // Release all device memory (CPU-side metadata/path is kept). Returns bytes freed.
+    virtual size_t evictResidency() = 0;
+
+    // Recreate device memory after an eviction. Returns false if the reload failed.
+    virtual bool restoreResidency() = 0;
+
+    // Optionally shed detail instead of evicting (e.g. drop the top mip level).
+    // Returns bytes freed, or 0 if the asset cannot degrade further.
+    virtual size_t dropDetail() { return 0; }
+};
+
+using ResidencyHandle = uint32_t;
+static constexpr ResidencyHandle INVALID_RESIDENCY_HANDLE = UINT32_MAX;
+
+/**
+ * ResidencyManager - LRU residency under a configurable byte budget
+ *
+ * Usage:
+ *   ResidencyManager& residency = ResidencyManager::get_instance();
+ *   residency.setBudget(512ull * 1024 * 1024);
+ *   ResidencyHandle h = residency.track(&texture);
+ *   residency.touch(h);          // Whenever the asset is used (reloads it if evicted)
+ *   residency.beginFrame();      // Once per frame: advances the clock and enforces the budget
+ */
+class ResidencyManager {
+public:
+    struct Stats {
+        size_t residentBytes = 0;
+        size_t budgetBytes = 0;
+        uint32_t trackedCount = 0;
+        uint32_t evictedCount = 0;      // Assets currently evicted
+        uint64_t totalEvictions = 0;
+        uint64_t totalDetailDrops = 0;
+        uint64_t totalRestores = 0;
+    };
+
+private:
+    struct Record {
+        ResidentAsset* asset = nullptr;
+        size_t bytes = 0;
+        uint64_t lastUsedFrame = 0;
+        bool resident = true;
+        bool pinned = false;
+        bool active = false;
+        std::list<ResidencyHandle>::iterator lruIt;   // Position in m_lru (resident records only)
+    };
+
+    std::vector<Record> m_records;
+    std::vector<ResidencyHandle> m_freeHandles;
+    std::list<ResidencyHandle> m_lru;       // Resident records, least recently used first
+    uint64_t m_frame = 0;
+    uint32_t m_minIdleFrames = 3;            // Never evict something used by a frame still in flight
+    Stats m_stats;
+
+    void moveToMostRecent(Record& record) {
+        m_lru.splice(m_lru.end(), m_lru, record.lruIt);
+    }
+
+    void refreshBytes(Record& record) {
+        size_t bytes = record.asset->getResidentBytes();
+        m_stats.residentBytes = m_stats.residentBytes - record.bytes + bytes;
+        record.bytes = bytes;
+    }
+
+public:
+    ResidencyManager() = default;
+    ResidencyManager(const ResidencyManager&) = delete;
+    ResidencyManager& operator=(const ResidencyManager&) = delete;
+
+    /**
+     * Get the process-wide manager used by TextureResource and MeshResource.
+     * Intentionally never destroyed (assets untrack themselves during static destruction).
+     */
+    static ResidencyManager& get_instance() {
+        static ResidencyManager* instance = new ResidencyManager();
+        return *instance;
+    }
+
+    /**
+     * Start tracking a resident asset. It counts as used this frame.
+     */
+    ResidencyHandle track(ResidentAsset* asset) {
+        ResidencyHandle handle;
+        if (!m_freeHandles.empty()) {
+            handle = m_freeHandles.back();
+            m_freeHandles.pop_back();
+        } else {
+            handle = static_cast<ResidencyHandle>(m_records.size());
+            m_records.emplace_back();
+        }
+
+        Record& record = m_records[handle];
+        record = Record();
+        record.asset = asset;
+        record.bytes = asset->getResidentBytes();
+        record.lastUsedFrame = m_frame;
+        record.active = true;
+        record.lruIt = m_lru.insert(m_lru.end(), handle);
+
+        m_stats.residentBytes += record.bytes;
+        m_stats.trackedCount++;
+        return handle;
+    }
+
+    /**
+     * Stop tracking (asset destroyed)
+     */
+    void untrack(ResidencyHandle handle) {
+        if (handle >= m_records.size() || !m_records[handle].active) {
+            return;
+        }
+
+        Record& record = m_records[handle];
+        if (record.resident) {
+            m_lru.erase(record.lruIt);
+            m_stats.residentBytes -= record.bytes;
+        } else {
+            m_stats.evictedCount--;
+        }
+        m_stats.trackedCount--;
+        record.active = false;
+        record.asset = nullptr;
+        m_freeHandles.push_back(handle);
+    }
+
+    /**
+     * Point a handle at a moved-to asset (move constructors)
+     */
+    void retarget(ResidencyHandle handle, ResidentAsset* asset) {
+        if (handle < m_records.size() && m_records[handle].active) {
+            m_records[handle].asset = asset;
+        }
+    }
+
+    /**
+     * Mark an asset as used this frame, restoring it first if it was evicted
+     * @return true if the asset had to be restored (its GPU handles changed)
+     */
+    bool touch(ResidencyHandle handle) {
+        if (handle >= m_records.size() || !m_records[handle].active) {
+            return false;
+        }
+
+        Record& record = m_records[handle];
+        record.lastUsedFrame = m_frame;
+
+        if (record.resident) {
+            moveToMostRecent(record);
+            return false;
+        }
+
+        if (!record.asset->restoreResidency()) {
+            return false;
+        }
+
+        record.resident = true;
+        record.bytes = record.asset->getResidentBytes();
+        record.lruIt = m_lru.insert(m_lru.end(), handle);
+        m_stats.residentBytes += record.bytes;
+        m_stats.evictedCount--;
+        m_stats.totalRestores++;
+        return true;
+    }
+
+    /**
+     * Re-read an asset's size after it changed outside the manager (hot-reload, streaming)
+     */
+    void updateBytes(ResidencyHandle handle) {
+        if (handle < m_records.size() && m_records[handle].active && m_records[handle].resident) {
+            refreshBytes(m_records[handle]);
+        }
+    }
+
+    /**
+     * Pinned assets are never evicted (e.g. ones an owner cannot touch every frame)
+     */
+    void setPinned(ResidencyHandle handle, bool pinned) {
+        if (handle < m_records.size() && m_records[handle].active) {
+            m_records[handle].pinned = pinned;
+        }
+    }
+
+    /**
+     * Advance the frame clock and enforce the budget. Call once per frame.
+     */
+    void beginFrame() {
+        m_frame++;
+        enforceBudget();
+    }
+
+    /**
+     * Shed memory until resident bytes fit the budget.
+     * Walks the LRU list oldest-first; each candidate first drops detail (top mips) if it can,
+     * and is evicted entirely only when it cannot degrade any further.
+     * @return Bytes freed
+     */
+    size_t enforceBudget() {
+        if (m_stats.budgetBytes == 0 || m_stats.residentBytes <= m_stats.budgetBytes) {
+            return 0;
+        }
+
+        size_t freed = 0;
+        auto it = m_lru.begin();
+        while (it != m_lru.end() && m_stats.residentBytes > m_stats.budgetBytes) {
+            ResidencyHandle handle = *it;
+            Record& record = m_records[handle];
+
+            // LRU order: once we reach something used recently, everything after it is newer
+            if (m_frame - record.lastUsedFrame < m_minIdleFrames) {
+                break;
+            }
+            if (record.pinned) {
+                ++it;
+                continue;
+            }
+
+            size_t dropped = record.asset->dropDetail();
+            if (dropped > 0) {
+                freed += dropped;
+                refreshBytes(record);
+                m_stats.totalDetailDrops++;
+                continue; // Re-check the same asset; it may still be over budget
+            }
+
+            freed += record.asset->evictResidency();
+            m_stats.residentBytes -= record.bytes;
+            record.bytes = 0;
+            record.resident = false;
+            it = m_lru.erase(it);
+            m_stats.evictedCount++;
+            m_stats.totalEvictions++;
+        }
+
+        return freed;
+    }
+
+    /**
+     * Budget in bytes (0 = unlimited, the default)
+     */
+    void setBudget(size_t bytes) {
+        m_stats.budgetBytes = bytes;
+    }
+
+    /**
+     * Frames an asset must go unused before it may be evicted (default 3; the renderer uses frames in flight + 1)
+     */
+    void setMinIdleFrames(uint32_t frames) {
+        m_minIdleFrames = frames;
+    }
+
+    bool isResident(ResidencyHandle handle) const {
+        return handle < m_records.size() && m_records[handle].active && m_records[handle].resident;
+    }
+
+    size_t getResidentBytes() const { return m_stats.residentBytes; }
+    size_t getBudget() const { return m_stats.budgetBytes; }
+    uint64_t getFrame() const { return m_frame; }
+    const Stats& getStats() const { return m_stats; }
+};
+
+#endif // EDEN_RESIDENCY_MANAGER_H
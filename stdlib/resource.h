@@ -1,6 +1,7 @@
 // EDEN ENGINE - Resource<T> Template Wrapper
 // Generic resource wrapper with hot-reload, file watching, and RAII lifecycle management
 // Works with any resource type (TextureResource, MeshResource, etc.)
+// Loaded data lives in ResourceCache<T>, so resources naming the same file share one copy
 
 #ifndef EDEN_RESOURCE_H
 #define EDEN_RESOURCE_H
@@ -9,6 +10,7 @@
 #include <string>
 #include <ctime>
 #include <stdexcept>
+#include "resource_cache.h"
 
 #ifdef _WIN32
 #include <sys/stat.h>
@@ -22,7 +24,7 @@
  * Resource<T> - Generic resource wrapper with hot-reload support
  * 
  * Provides:
- * - RAII lifecycle management
+ * - RAII lifecycle management (shared, reference-counted data via ResourceCache<T>)
  * - File modification time tracking
  * - Hot-reload capability (check and reload on file change)
  * - Convenient accessors (get(), operator*, operator->)
@@ -35,7 +37,7 @@
 template<typename T>
 class Resource {
 private:
-    std::unique_ptr<T> m_data;
+    std::shared_ptr<typename ResourceCache<T>::Slot> m_slot;
     std::string m_path;
     std::time_t m_lastModified;
     bool m_loaded;
@@ -65,7 +67,7 @@ private:
      */
     void loadResource() {
         try {
-            m_data = std::make_unique<T>(m_path);
+            m_slot = ResourceCache<T>::get_instance().acquire(m_path);
             m_lastModified = getFileModificationTime(m_path);
             m_loaded = true;
         } catch (const std::exception& e) {
@@ -74,6 +76,28 @@ private:
         }
     }
 
+    /**
+     * Reload this resource's slot in place (all Resource<T> sharing the path see the result)
+     * @throws std::runtime_error if loading fails (the previous data is kept)
+     */
+    void reloadResource() {
+        if (!m_slot) {
+            loadResource();
+            return;
+        }
+        try {
+            ResourceCache<T>::get_instance().reload(*m_slot);
+            m_lastModified = getFileModificationTime(m_path);
+            m_loaded = true;
+        } catch (const std::exception& e) {
+            throw std::runtime_error("Failed to reload resource '" + m_path + "': " + e.what());
+        }
+    }
+
+    T* data() const {
+        return m_slot ? m_slot->get() : nullptr;
+    }
+
 public:
     /**
      * Constructor - Stores path but does NOT load resource yet (lazy loading)
@@ -93,7 +117,7 @@ public:
     
     // Move constructor
     Resource(Resource&& other) noexcept
-        : m_data(std::move(other.m_data)),
+        : m_slot(std::move(other.m_slot)),
           m_path(std::move(other.m_path)),
           m_lastModified(other.m_lastModified),
           m_loaded(other.m_loaded) {
@@ -104,7 +128,7 @@ public:
     // Move assignment
     Resource& operator=(Resource&& other) noexcept {
         if (this != &other) {
-            m_data = std::move(other.m_data);
+            m_slot = std::move(other.m_slot);
             m_path = std::move(other.m_path);
             m_lastModified = other.m_lastModified;
             m_loaded = other.m_loaded;
@@ -114,7 +138,7 @@ public:
         return *this;
     }
     
-    // Destructor - RAII cleanup (unique_ptr handles destruction)
+    // Destructor - RAII cleanup (releasing the slot returns the data to the cache)
     ~Resource() = default;
     
     /**
@@ -130,7 +154,7 @@ public:
                 return nullptr;
             }
         }
-        return m_data.get();
+        return data();
     }
     
     /**
@@ -138,7 +162,7 @@ public:
      * @return Const pointer to resource, or nullptr if not loaded
      */
     const T* get() const {
-        return m_data.get();
+        return data();
     }
     
     /**
@@ -150,20 +174,20 @@ public:
         if (!m_loaded && !m_path.empty()) {
             loadResource();
         }
-        if (!m_loaded || !m_data) {
+        if (!m_loaded || !data()) {
             throw std::runtime_error("Resource '" + m_path + "' is not loaded");
         }
-        return *m_data;
+        return *data();
     }
     
     /**
      * Const dereference operator
      */
     const T& operator*() const {
-        if (!m_loaded || !m_data) {
+        if (!m_loaded || !data()) {
             throw std::runtime_error("Resource '" + m_path + "' is not loaded");
         }
-        return *m_data;
+        return *data();
     }
     
     /**
@@ -175,20 +199,20 @@ public:
         if (!m_loaded && !m_path.empty()) {
             loadResource();
         }
-        if (!m_loaded || !m_data) {
+        if (!m_loaded || !data()) {
             throw std::runtime_error("Resource '" + m_path + "' is not loaded");
         }
-        return m_data.get();
+        return data();
     }
     
     /**
      * Const member access operator
      */
     const T* operator->() const {
-        if (!m_loaded || !m_data) {
+        if (!m_loaded || !data()) {
             throw std::runtime_error("Resource '" + m_path + "' is not loaded");
         }
-        return m_data.get();
+        return data();
     }
     
     /**
@@ -196,7 +220,7 @@ public:
      * @return true if loaded, false otherwise
      */
     bool isLoaded() const {
-        return m_loaded && m_data != nullptr;
+        return m_loaded && data() != nullptr;
     }
     
     /**
@@ -230,18 +254,14 @@ public:
         // Check if file has been modified
         if (currentModified > m_lastModified && currentModified > 0) {
             try {
-                // Destroy old resource
-                m_data.reset();
-                m_loaded = false;
-                
-                // Load new resource
-                loadResource();
+                // Swap in new data (old data is released once nothing else shares it)
+                reloadResource();
                 
                 return true; // Reloaded successfully
             } catch (const std::exception& e) {
                 // Reload failed - log error but don't throw
                 // (allows game to continue running even if reload fails)
-                m_loaded = false;
+                m_lastModified = currentModified;
                 return false;
             }
         }
@@ -259,16 +279,10 @@ public:
         }
         
         try {
-            // Destroy old resource
-            m_data.reset();
-            m_loaded = false;
-            
-            // Load new resource
-            loadResource();
+            reloadResource();
             
             return true;
         } catch (const std::exception& e) {
-            m_loaded = false;
             return false;
         }
     }
@@ -277,7 +291,7 @@ public:
      * Reset resource (unload)
      */
     void reset() {
-        m_data.reset();
+        m_slot.reset();
         m_loaded = false;
         m_lastModified = 0;
     }
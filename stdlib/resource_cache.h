@@ -0,0 +1,323 @@
+// EDEN ENGINE - ResourceCache<T>
+// Content-addressed, reference-counted cache shared by every Resource<T> of the same type
+// Identical files (same normalized path, or same bytes under different paths) are loaded once
+
+#ifndef EDEN_RESOURCE_CACHE_H
+#define EDEN_RESOURCE_CACHE_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <fstream>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Memory footprint of a cached resource. Types that know their GPU/CPU cost expose
+// getMemorySize(); anything else is counted as sizeof(T).
+template<typename T, typename = void>
+struct ResourceMemorySize {
+    static size_t get(const T&) { return sizeof(T); }
+};
+
+template<typename T>
+struct ResourceMemorySize<T, decltype(void(std::declval<const T&>().getMemorySize()))> {
+    static size_t get(const T& resource) { return static_cast<size_t>(resource.getMemorySize()); }
+};
+
+/**
+ * ResourceCache<T> - Shared, deduplicated storage for loaded resources
+ *
+ * Provides:
+ * - Path slots: every Resource<T> naming the same (normalized) path shares one slot,
+ *   so a hot-reload through any of them is seen by all of them
+ * - Content entries: slots whose files hash to the same bytes share one loaded T
+ * - Reference counting per entry; unreferenced entries stay warm in an LRU list and
+ *   are only destroyed when their total size exceeds the configured budget
+ *
+ * Not thread-safe: acquire/reload/release are expected on the main (render) thread,
+ * which is also where T's Vulkan objects are created.
+ *
+ * Usage:
+ *   auto slot = ResourceCache<TextureResource>::get_instance().acquire("textures/brick.dds");
+ *   TextureResource* tex = slot->get();
+ */
+template<typename T>
+class ResourceCache {
+public:
+    struct Entry {
+        std::unique_ptr<T> data;
+        uint64_t contentKey = 0;                // Hash of file bytes (mixed with size)
+        size_t memoryBytes = 0;
+        uint32_t refCount = 0;                  // Number of slots bound to this entry
+        bool cached = false;                    // false if the file couldn't be hashed (never shared)
+        bool inLru = false;
+        typename std::list<Entry*>::iterator lruIt;
+    };
+
+    /**
+     * Slot - per-path handle shared by all Resource<T> instances naming that path
+     * Destroying the last shared_ptr to a slot releases its entry back to the cache.
+     */
+    class Slot {
+        friend class ResourceCache<T>;
+        std::string m_path;
+        std::shared_ptr<Entry> m_entry;
+
+    public:
+        explicit Slot(const std::string& path) : m_path(path) {}
+        ~Slot() {
+            ResourceCache<T>::get_instance().unbind(*this);
+        }
+
+        Slot(const Slot&) = delete;
+        Slot& operator=(const Slot&) = delete;
+
+        T* get() const { return m_entry ? m_entry->data.get() : nullptr; }
+        const std::string& getPath() const { return m_path; }
+        uint64_t getContentKey() const { return m_entry ? m_entry->contentKey : 0; }
+    };
+
+private:
+    std::unordered_map<std::string, std::weak_ptr<Slot>> m_slots;            // normalized path -> slot
+    std::unordered_map<uint64_t, std::shared_ptr<Entry>> m_entries;          // content key -> entry
+    std::list<Entry*> m_lru;                                                 // unreferenced, most recent first
+    size_t m_unreferencedBytes = 0;
+    size_t m_totalBytes = 0;
+    size_t m_budgetBytes = 64ull * 1024 * 1024;
+
+    ResourceCache() = default;
+
+    // FNV-1a over the file bytes, mixed with the size so truncated copies never collide
+    static uint64_t hashFile(const std::string& path, bool& ok) {
+        std::ifstream file(path, std::ios::binary);
+        ok = file.is_open();
+        uint64_t hash = 1469598103934665603ull;
+        uint64_t size = 0;
+        if (!ok) {
+            return 0;
+        }
+
+        char buffer[64 * 1024];
+        while (file) {
+            file.read(buffer, sizeof(buffer));
+            std::streamsize count = file.gcount();
+            for (std::streamsize i = 0; i < count; i++) {
+                hash ^= static_cast<uint8_t>(buffer[i]);
+                hash *= 1099511628211ull;
+            }
+            size += static_cast<uint64_t>(count);
+        }
+
+        hash ^= size + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+
+    // Called when an entry's last slot lets go of it
+    void releaseEntry(const std::shared_ptr<Entry>& entry) {
+        if (!entry->cached) {
+            m_totalBytes -= entry->memoryBytes; // Nothing can find it again - destroyed with the last shared_ptr
+            return;
+        }
+        touchUnreferenced(entry.get());
+        trim();
+    }
+
+    void touchUnreferenced(Entry* entry) {
+        m_lru.push_front(entry);
+        entry->lruIt = m_lru.begin();
+        entry->inLru = true;
+        m_unreferencedBytes += entry->memoryBytes;
+    }
+
+    void removeFromLru(Entry* entry) {
+        if (!entry->inLru) {
+            return;
+        }
+        m_lru.erase(entry->lruIt);
+        entry->inLru = false;
+        m_unreferencedBytes -= entry->memoryBytes;
+    }
+
+    void bind(Slot& slot, const std::shared_ptr<Entry>& entry) {
+        removeFromLru(entry.get());
+        entry->refCount++;
+        slot.m_entry = entry;
+    }
+
+    void unbind(Slot& slot) {
+        if (!slot.m_entry) {
+            return;
+        }
+
+        std::shared_ptr<Entry> entry = std::move(slot.m_entry);
+        slot.m_entry.reset();
+
+        auto slotIt = m_slots.find(slot.m_path);
+        if (slotIt != m_slots.end() && slotIt->second.expired()) {
+            m_slots.erase(slotIt);
+        }
+
+        if (--entry->refCount == 0) {
+            releaseEntry(entry);
+        }
+    }
+
+    // Find the entry for a path's current contents, loading it if no identical file is cached
+    std::shared_ptr<Entry> findOrLoad(const std::string& path) {
+        bool ok = false;
+        uint64_t contentKey = hashFile(path, ok);
+
+        if (ok) {
+            auto it = m_entries.find(contentKey);
+            if (it != m_entries.end()) {
+                return it->second;
+            }
+        }
+
+        // Not cached (or unreadable - let T's constructor report the real error)
+        auto entry = std::make_shared<Entry>();
+        entry->data = std::make_unique<T>(path);
+        entry->contentKey = contentKey;
+        entry->memoryBytes = ResourceMemorySize<T>::get(*entry->data);
+        m_totalBytes += entry->memoryBytes;
+
+        if (ok) {
+            entry->cached = true;
+            m_entries[contentKey] = entry;
+        }
+        return entry;
+    }
+
+public:
+    ResourceCache(const ResourceCache&) = delete;
+    ResourceCache& operator=(const ResourceCache&) = delete;
+
+    /**
+     * Get the cache for this resource type.
+     * Intentionally never destroyed: global Resource<T> objects release their slots during
+     * static destruction, after function-local statics would already be gone.
+     */
+    static ResourceCache& get_instance() {
+        static ResourceCache* instance = new ResourceCache();
+        return *instance;
+    }
+
+    /**
+     * Normalize a path so "./a//b\\c.png" and "a/b/c.png" share a slot
+     */
+    static std::string normalizePath(const std::string& path) {
+        std::vector<std::string> parts;
+        std::string part;
+        bool absolute = !path.empty() && (path[0] == '/' || path[0] == '\\');
+
+        for (size_t i = 0; i <= path.size(); i++) {
+            char c = i < path.size() ? path[i] : '/';
+            if (c == '/' || c == '\\') {
+                if (part == "..") {
+                    if (!parts.empty() && parts.back() != "..") {
+                        parts.pop_back();
+                    } else if (!absolute) {
+                        parts.push_back(part);
+                    }
+                } else if (!part.empty() && part != ".") {
+                    parts.push_back(part);
+                }
+                part.clear();
+            } else {
+                part += c;
+            }
+        }
+
+        std::string result = absolute ? "/" : "";
+        for (size_t i = 0; i < parts.size(); i++) {
+            if (i > 0) {
+                result += '/';
+            }
+            result += parts[i];
+        }
+        return result;
+    }
+
+    /**
+     * Acquire a shared slot for a path, loading the resource if it isn't cached
+     * @throws std::runtime_error (from T's constructor) if loading fails
+     */
+    std::shared_ptr<Slot> acquire(const std::string& path) {
+        std::string key = normalizePath(path);
+
+        auto slotIt = m_slots.find(key);
+        if (slotIt != m_slots.end()) {
+            if (std::shared_ptr<Slot> existing = slotIt->second.lock()) {
+                return existing;
+            }
+        }
+
+        std::shared_ptr<Entry> entry = findOrLoad(path);
+        auto slot = std::make_shared<Slot>(key);
+        bind(*slot, entry);
+        m_slots[key] = slot;
+        return slot;
+    }
+
+    /**
+     * Reload a slot from disk. Every Resource<T> sharing the slot sees the new data;
+     * other paths that shared the old contents keep the old entry.
+     * @throws std::runtime_error (from T's constructor) if loading fails; the slot keeps its old data
+     */
+    void reload(Slot& slot) {
+        bool ok = false;
+        uint64_t contentKey = hashFile(slot.m_path, ok);
+        if (ok && slot.m_entry && slot.m_entry->contentKey == contentKey) {
+            return; // Touched but unchanged - nothing to do
+        }
+
+        std::shared_ptr<Entry> entry = findOrLoad(slot.m_path);
+        std::shared_ptr<Entry> old = slot.m_entry;
+        bind(slot, entry);
+
+        if (old && --old->refCount == 0) {
+            releaseEntry(old);
+        }
+    }
+
+    /**
+     * Destroy least-recently-used unreferenced entries until they fit in the budget
+     */
+    void trim() {
+        while (m_unreferencedBytes > m_budgetBytes && !m_lru.empty()) {
+            Entry* victim = m_lru.back();
+            removeFromLru(victim);
+            m_totalBytes -= victim->memoryBytes;
+            m_entries.erase(victim->contentKey); // Releases the last reference -> destroys T
+        }
+    }
+
+    /**
+     * Destroy every unreferenced entry (call before tearing down the Vulkan device)
+     */
+    void purgeUnreferenced() {
+        size_t budget = m_budgetBytes;
+        m_budgetBytes = 0;
+        trim();
+        m_budgetBytes = budget;
+    }
+
+    /**
+     * Bytes of unreferenced entries kept warm before LRU eviction starts (default 64MB)
+     */
+    void setBudget(size_t bytes) {
+        m_budgetBytes = bytes;
+        trim();
+    }
+
+    size_t getBudget() const { return m_budgetBytes; }
+    size_t getTotalBytes() const { return m_totalBytes; }
+    size_t getUnreferencedBytes() const { return m_unreferencedBytes; }
+    size_t getEntryCount() const { return m_entries.size(); }
+};
+
+#endif // EDEN_RESOURCE_CACHE_H
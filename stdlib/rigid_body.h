@@ -0,0 +1,922 @@
+// EDEN ENGINE - Rigid Body Physics
+// Fixed-timestep rigid bodies for items and level objects (boxes, spheres, HDM collision shapes).
+// A step runs the sweep-and-prune broadphase, generates box/sphere contacts, groups touching bodies
+// into islands and solves each island with sequential impulses (friction, restitution, warm
+// starting). Islands that come to rest go to sleep. Awake islands are solved in parallel on a
+// worker pool; each island is solved on its own, so results do not depend on the thread count.
+//
+// Bodies translate but do not rotate: boxes stay axis-aligned (the engine's cubes only carry a
+// cosmetic yaw), which keeps single-point contacts exact and tall stacks stable.
+
+#ifndef EDEN_RIGID_BODY_H
+#define EDEN_RIGID_BODY_H
+
+#include "broadphase.h"
+#include "entity_storage.h"
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * PhysicsShape - Collision shape of a body
+ */
+enum class PhysicsShape : uint8_t {
+    Box,       // Axis-aligned box (halfExtents)
+    Sphere     // Sphere (radius)
+};
+
+// HDM physics collision_type values
+static constexpr int HDM_COLLISION_NONE = 0;
+static constexpr int HDM_COLLISION_BOX = 1;
+static constexpr int HDM_COLLISION_MESH = 2;
+
+/**
+ * RigidBodyDesc - Everything needed to create a body
+ */
+struct RigidBodyDesc {
+    PhysicsShape shape = PhysicsShape::Box;
+    float halfExtents[3] = {0.5f, 0.5f, 0.5f};
+    float radius = 0.5f;
+    float position[3] = {0.0f, 0.0f, 0.0f};
+    float velocity[3] = {0.0f, 0.0f, 0.0f};
+    float mass = 1.0f;              // Ignored for static bodies
+    bool isStatic = false;
+    float friction = 0.5f;
+    float restitution = 0.0f;
+    uint32_t userData = 0;          // Caller value (e.g. an entity id or cube index)
+};
+
+/**
+ * Fill a body description from HDM physics properties
+ *
+ * Box collision uses collision_bounds as the box size. HDM stores no hull for mesh collision,
+ * only its bounds, so a mesh collides as the box of those bounds.
+ *
+ * @return false for collision type none (the object gets no body)
+ */
+inline bool rigid_body_desc_from_hdm(int collisionType, const float bounds[3], bool isStatic, float mass,
+                                     RigidBodyDesc& desc) {
+    if (collisionType != HDM_COLLISION_BOX && collisionType != HDM_COLLISION_MESH) {
+        return false;
+    }
+    desc.shape = PhysicsShape::Box;
+    for (int axis = 0; axis < 3; axis++) {
+        desc.halfExtents[axis] = std::max(bounds[axis], 0.001f) * 0.5f;
+    }
+    desc.isStatic = isStatic;
+    desc.mass = mass > 0.0f ? mass : 1.0f;
+    return true;
+}
+
+/**
+ * PhysicsConfig - World settings (units: meters, seconds, kilograms)
+ */
+struct PhysicsConfig {
+    float gravity[3] = {0.0f, -9.81f, 0.0f};
+    float fixedTimestep = 1.0f / 60.0f;
+    uint32_t maxSubsteps = 4;            // Per update(); extra time is dropped (no spiral of death)
+    uint32_t velocityIterations = 10;
+    uint32_t positionIterations = 4;
+    float contactMargin = 0.02f;         // Contacts are created this far before bodies touch
+    float penetrationSlop = 0.005f;      // Penetration left alone (keeps resting contacts quiet)
+    float baumgarte = 0.2f;              // Fraction of penetration pushed out per step (adds no velocity)
+    float restitutionThreshold = 1.0f;   // Closing speed below which contacts don't bounce
+    float sleepVelocity = 0.05f;         // Speed below which a body counts as resting
+    float timeToSleep = 0.5f;            // Seconds an island must rest before it sleeps
+    uint32_t threadCount = 0;            // Island solver threads incl. the caller (0 = hardware concurrency)
+};
+
+/**
+ * PhysicsContact - One contact between two bodies (a < b; normal points from a to b)
+ */
+struct PhysicsContact {
+    uint32_t a;
+    uint32_t b;
+    float normal[3];
+    float penetration;           // Negative while the bodies are still apart (speculative contact)
+    float tangent1[3];
+    float tangent2[3];
+    float friction;
+    float restitution;
+    float normalMass;
+    float targetVelocity;        // Normal velocity the solver drives towards
+    float positionBias;          // Separation speed that pushes penetration out this step
+    float normalImpulse;         // Accumulated impulses (kept across steps for warm starting)
+    float tangentImpulse[2];
+    float positionImpulse;       // Accumulated penetration push (this step only)
+};
+
+static inline bool physicsPairLess(uint32_t a0, uint32_t b0, uint32_t a1, uint32_t b1) {
+    return a0 != a1 ? a0 < a1 : b0 < b1;
+}
+
+static inline float physicsDot(const float a[3], const float b[3]) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+/**
+ * Contact between two axis-aligned boxes: pushed apart along the axis of least overlap
+ */
+static inline void physicsBoxBox(const float posA[3], const float halfA[3], const float posB[3], const float halfB[3],
+                                 PhysicsContact& contact) {
+    int bestAxis = 0;
+    float bestOverlap = 0.0f;
+    for (int axis = 0; axis < 3; axis++) {
+        float overlap = halfA[axis] + halfB[axis] - std::fabs(posB[axis] - posA[axis]);
+        if (axis == 0 || overlap < bestOverlap) {
+            bestOverlap = overlap;
+            bestAxis = axis;
+        }
+    }
+    contact.normal[0] = contact.normal[1] = contact.normal[2] = 0.0f;
+    contact.normal[bestAxis] = posB[bestAxis] >= posA[bestAxis] ? 1.0f : -1.0f;
+    contact.penetration = bestOverlap;
+}
+
+static inline void physicsSphereSphere(const float posA[3], float radiusA, const float posB[3], float radiusB,
+                                       PhysicsContact& contact) {
+    float d[3] = {posB[0] - posA[0], posB[1] - posA[1], posB[2] - posA[2]};
+    float distance = std::sqrt(physicsDot(d, d));
+    if (distance > 1e-6f) {
+        for (int axis = 0; axis < 3; axis++) {
+            contact.normal[axis] = d[axis] / distance;
+        }
+    } else {
+        contact.normal[0] = 0.0f;
+        contact.normal[1] = 1.0f;
+        contact.normal[2] = 0.0f;
+    }
+    contact.penetration = radiusA + radiusB - distance;
+}
+
+/**
+ * Contact between a sphere and an axis-aligned box; the normal points from the sphere to the box
+ */
+static inline void physicsSphereBox(const float sphere[3], float radius, const float box[3], const float half[3],
+                                    PhysicsContact& contact) {
+    float local[3];
+    float closest[3];
+    bool inside = true;
+    for (int axis = 0; axis < 3; axis++) {
+        local[axis] = sphere[axis] - box[axis];
+        closest[axis] = std::min(std::max(local[axis], -half[axis]), half[axis]);
+        inside = inside && closest[axis] == local[axis];
+    }
+    if (!inside) {
+        float d[3] = {local[0] - closest[0], local[1] - closest[1], local[2] - closest[2]};
+        float distance = std::sqrt(physicsDot(d, d));
+        for (int axis = 0; axis < 3; axis++) {
+            contact.normal[axis] = -d[axis] / distance;
+        }
+        contact.penetration = radius - distance;
+        return;
+    }
+    // Center inside the box: out through the nearest face
+    int bestAxis = 0;
+    float bestDepth = 0.0f;
+    for (int axis = 0; axis < 3; axis++) {
+        float depth = half[axis] - std::fabs(local[axis]);
+        if (axis == 0 || depth < bestDepth) {
+            bestDepth = depth;
+            bestAxis = axis;
+        }
+    }
+    contact.normal[0] = contact.normal[1] = contact.normal[2] = 0.0f;
+    contact.normal[bestAxis] = local[bestAxis] >= 0.0f ? -1.0f : 1.0f;
+    contact.penetration = radius + bestDepth;
+}
+
+/**
+ * Two unit tangents perpendicular to a unit normal
+ */
+static inline void physicsTangents(const float n[3], float t1[3], float t2[3]) {
+    if (std::fabs(n[0]) < 0.57735f) {
+        // cross(n, X)
+        float length = std::sqrt(n[2] * n[2] + n[1] * n[1]);
+        t1[0] = 0.0f;
+        t1[1] = n[2] / length;
+        t1[2] = -n[1] / length;
+    } else {
+        // cross(n, Y)
+        float length = std::sqrt(n[2] * n[2] + n[0] * n[0]);
+        t1[0] = -n[2] / length;
+        t1[1] = 0.0f;
+        t1[2] = n[0] / length;
+    }
+    t2[0] = n[1] * t1[2] - n[2] * t1[1];
+    t2[1] = n[2] * t1[0] - n[0] * t1[2];
+    t2[2] = n[0] * t1[1] - n[1] * t1[0];
+}
+
+/**
+ * PhysicsWorld - Bodies, contacts and the fixed-timestep solver
+ *
+ * Bodies are identified by the id returned from createBody (ids of destroyed bodies are reused).
+ * Moving a body by hand (setPosition / setVelocity / applyImpulse) wakes it and its island.
+ *
+ * Usage:
+ *   PhysicsWorld world;
+ *   RigidBodyDesc desc;
+ *   rigid_body_desc_from_hdm(physics.collision_type, bounds, physics.is_static, physics.mass, desc);
+ *   uint32_t body = world.createBody(desc);
+ *   // each frame:
+ *   world.update(deltaTime);
+ *   world.getPosition(body, position);
+ */
+class PhysicsWorld {
+public:
+    static constexpr uint32_t INVALID_BODY = 0xFFFFFFFFu;
+
+    struct Stats {
+        uint32_t bodies = 0;
+        uint32_t awakeBodies = 0;
+        uint32_t contacts = 0;
+        uint32_t islands = 0;          // Awake islands solved in the last step
+        uint32_t largestIsland = 0;    // Bodies in the largest awake island
+    };
+
+private:
+    struct Body {
+        float position[3];
+        float velocity[3];
+        float correction[3];     // Penetration push for this step; moves the body without becoming velocity
+        float halfExtents[3];
+        float radius;
+        float invMass;
+        float friction;
+        float restitution;
+        float sleepTime;
+        uint32_t userData;
+        uint32_t proxy;
+        PhysicsShape shape;
+        bool isStatic;
+        bool awake;
+        bool alive;
+    };
+
+    struct Island {
+        uint32_t bodyStart;
+        uint32_t bodyCount;
+        uint32_t contactStart;
+        uint32_t contactCount;
+    };
+
+    PhysicsConfig m_config;
+    std::vector<Body> m_bodies;
+    std::vector<uint32_t> m_freeIds;
+    uint32_t m_bodyCount = 0;
+    float m_accumulator = 0.0f;
+
+    SweepAndPrune m_broadphase;
+    std::vector<BroadphasePair> m_pairs;
+    std::vector<PhysicsContact> m_contacts;
+    std::vector<PhysicsContact> m_previousContacts;
+
+    // Island build scratch: bodies and contacts grouped by island
+    std::vector<uint32_t> m_parent;
+    std::vector<uint32_t> m_islandOfRoot;
+    std::vector<uint32_t> m_islandBodies;
+    std::vector<uint32_t> m_islandContacts;
+    std::vector<Island> m_islands;
+    std::vector<uint32_t> m_jobOrder;
+    Stats m_stats;
+
+    // Worker pool: solveIslands hands out m_jobOrder entries through m_nextJob
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    std::atomic<size_t> m_nextJob{0};
+    uint64_t m_batch = 0;
+    uint32_t m_busyThreads = 0;
+    bool m_stop = false;
+
+    BroadphaseBounds bodyBounds(const Body& body) const {
+        float margin = body.isStatic ? 0.0f : m_config.contactMargin;
+        if (body.shape == PhysicsShape::Sphere) {
+            float size = 2.0f * (body.radius + margin);
+            return broadphase_bounds_from_center(body.position[0], body.position[1], body.position[2], size, size, size);
+        }
+        return broadphase_bounds_from_center(body.position[0], body.position[1], body.position[2],
+                                             2.0f * (body.halfExtents[0] + margin),
+                                             2.0f * (body.halfExtents[1] + margin),
+                                             2.0f * (body.halfExtents[2] + margin));
+    }
+
+    bool isDynamic(uint32_t id) const { return !m_bodies[id].isStatic; }
+
+    void computeContact(const Body& bodyA, const Body& bodyB, PhysicsContact& contact) const {
+        if (bodyA.shape == PhysicsShape::Box && bodyB.shape == PhysicsShape::Box) {
+            physicsBoxBox(bodyA.position, bodyA.halfExtents, bodyB.position, bodyB.halfExtents, contact);
+        } else if (bodyA.shape == PhysicsShape::Sphere && bodyB.shape == PhysicsShape::Sphere) {
+            physicsSphereSphere(bodyA.position, bodyA.radius, bodyB.position, bodyB.radius, contact);
+        } else if (bodyA.shape == PhysicsShape::Sphere) {
+            physicsSphereBox(bodyA.position, bodyA.radius, bodyB.position, bodyB.halfExtents, contact);
+        } else {
+            physicsSphereBox(bodyB.position, bodyB.radius, bodyA.position, bodyA.halfExtents, contact);
+            for (int axis = 0; axis < 3; axis++) {
+                contact.normal[axis] = -contact.normal[axis];
+            }
+        }
+    }
+
+    /**
+     * Broadphase + narrowphase: one contact per overlapping pair that involves a dynamic body,
+     * carrying over last step's impulses (warm starting) when the normal is about the same
+     */
+    void updateContacts() {
+        for (Body& body : m_bodies) {
+            if (body.alive && !body.isStatic && body.awake) {
+                m_broadphase.updateProxy(body.proxy, bodyBounds(body));
+            }
+        }
+        m_broadphase.findPairs(m_pairs, m_config.threadCount);
+        for (BroadphasePair& pair : m_pairs) {
+            uint32_t a = m_broadphase.getUserData(pair.a);
+            uint32_t b = m_broadphase.getUserData(pair.b);
+            pair.a = std::min(a, b);
+            pair.b = std::max(a, b);
+        }
+        broadphase_sort_pairs(m_pairs);
+
+        m_previousContacts.swap(m_contacts);
+        m_contacts.clear();
+        size_t previous = 0;
+        for (const BroadphasePair& pair : m_pairs) {
+            const Body& bodyA = m_bodies[pair.a];
+            const Body& bodyB = m_bodies[pair.b];
+            PhysicsContact contact;
+            contact.a = pair.a;
+            contact.b = pair.b;
+            computeContact(bodyA, bodyB, contact);
+            if (contact.penetration < -m_config.contactMargin) {
+                continue;
+            }
+            physicsTangents(contact.normal, contact.tangent1, contact.tangent2);
+            contact.friction = std::sqrt(bodyA.friction * bodyB.friction);
+            contact.restitution = std::max(bodyA.restitution, bodyB.restitution);
+            contact.normalMass = 1.0f / (bodyA.invMass + bodyB.invMass);
+            contact.targetVelocity = 0.0f;
+            contact.positionBias = 0.0f;
+            contact.positionImpulse = 0.0f;
+            contact.normalImpulse = 0.0f;
+            contact.tangentImpulse[0] = 0.0f;
+            contact.tangentImpulse[1] = 0.0f;
+
+            // Both lists are sorted by (a, b)
+            while (previous < m_previousContacts.size() &&
+                   physicsPairLess(m_previousContacts[previous].a, m_previousContacts[previous].b, pair.a, pair.b)) {
+                previous++;
+            }
+            if (previous < m_previousContacts.size() && m_previousContacts[previous].a == pair.a &&
+                m_previousContacts[previous].b == pair.b) {
+                const PhysicsContact& old = m_previousContacts[previous];
+                if (physicsDot(old.normal, contact.normal) > 0.95f) {
+                    contact.normalImpulse = old.normalImpulse;
+                    contact.tangentImpulse[0] = old.tangentImpulse[0];
+                    contact.tangentImpulse[1] = old.tangentImpulse[1];
+                }
+            }
+            m_contacts.push_back(contact);
+        }
+    }
+
+    uint32_t findRoot(uint32_t id) {
+        while (m_parent[id] != id) {
+            m_parent[id] = m_parent[m_parent[id]];
+            id = m_parent[id];
+        }
+        return id;
+    }
+
+    /**
+     * Group dynamic bodies connected by contacts into islands (static bodies don't connect).
+     * Islands are numbered in order of their lowest body id, so the grouping is deterministic.
+     */
+    void buildIslands() {
+        uint32_t bodyCapacity = static_cast<uint32_t>(m_bodies.size());
+        m_parent.resize(bodyCapacity);
+        for (uint32_t id = 0; id < bodyCapacity; id++) {
+            m_parent[id] = id;
+        }
+        for (const PhysicsContact& contact : m_contacts) {
+            if (isDynamic(contact.a) && isDynamic(contact.b)) {
+                uint32_t rootA = findRoot(contact.a);
+                uint32_t rootB = findRoot(contact.b);
+                if (rootA != rootB) {
+                    // Lower id becomes the root
+                    m_parent[std::max(rootA, rootB)] = std::min(rootA, rootB);
+                }
+            }
+        }
+
+        m_islandOfRoot.assign(bodyCapacity, INVALID_BODY);
+        m_islands.clear();
+        for (uint32_t id = 0; id < bodyCapacity; id++) {
+            const Body& body = m_bodies[id];
+            if (!body.alive || body.isStatic) {
+                continue;
+            }
+            uint32_t root = findRoot(id);
+            if (m_islandOfRoot[root] == INVALID_BODY) {
+                m_islandOfRoot[root] = static_cast<uint32_t>(m_islands.size());
+                m_islands.push_back({0, 0, 0, 0});
+            }
+            m_islands[m_islandOfRoot[root]].bodyCount++;
+        }
+        for (const PhysicsContact& contact : m_contacts) {
+            uint32_t dynamicBody = isDynamic(contact.a) ? contact.a : contact.b;
+            m_islands[m_islandOfRoot[findRoot(dynamicBody)]].contactCount++;
+        }
+
+        // Counting sort bodies and contacts into their islands
+        uint32_t bodyOffset = 0;
+        uint32_t contactOffset = 0;
+        for (Island& island : m_islands) {
+            island.bodyStart = bodyOffset;
+            island.contactStart = contactOffset;
+            bodyOffset += island.bodyCount;
+            contactOffset += island.contactCount;
+            island.bodyCount = 0;
+            island.contactCount = 0;
+        }
+        m_islandBodies.resize(bodyOffset);
+        m_islandContacts.resize(contactOffset);
+        for (uint32_t id = 0; id < bodyCapacity; id++) {
+            const Body& body = m_bodies[id];
+            if (body.alive && !body.isStatic) {
+                Island& island = m_islands[m_islandOfRoot[findRoot(id)]];
+                m_islandBodies[island.bodyStart + island.bodyCount++] = id;
+            }
+        }
+        for (uint32_t c = 0; c < m_contacts.size(); c++) {
+            uint32_t dynamicBody = isDynamic(m_contacts[c].a) ? m_contacts[c].a : m_contacts[c].b;
+            Island& island = m_islands[m_islandOfRoot[findRoot(dynamicBody)]];
+            m_islandContacts[island.contactStart + island.contactCount++] = c;
+        }
+    }
+
+    /**
+     * Advance one island by dt: gravity, contact solve, position update, sleep check.
+     * Only touches the island's own bodies and contacts (static bodies are read-only).
+     */
+    void solveIsland(const Island& island, float dt) {
+        const uint32_t* bodies = m_islandBodies.data() + island.bodyStart;
+        const uint32_t* contacts = m_islandContacts.data() + island.contactStart;
+        const float* gravity = m_config.gravity;
+
+        for (uint32_t i = 0; i < island.bodyCount; i++) {
+            Body& body = m_bodies[bodies[i]];
+            if (!body.awake) {
+                body.awake = true;
+                body.sleepTime = 0.0f;
+            }
+            for (int axis = 0; axis < 3; axis++) {
+                body.velocity[axis] += gravity[axis] * dt;
+                body.correction[axis] = 0.0f;
+            }
+        }
+
+        // Static bodies are shared between islands (and threads), so only dynamic ones are written
+        auto applyVelocity = [](Body& body, const float direction[3], float impulse) {
+            if (body.invMass > 0.0f) {
+                for (int axis = 0; axis < 3; axis++) {
+                    body.velocity[axis] += direction[axis] * impulse * body.invMass;
+                }
+            }
+        };
+        auto applyCorrection = [](Body& body, const float direction[3], float impulse) {
+            if (body.invMass > 0.0f) {
+                for (int axis = 0; axis < 3; axis++) {
+                    body.correction[axis] += direction[axis] * impulse * body.invMass;
+                }
+            }
+        };
+
+        // Targets: close speculative gaps exactly, bounce fast impacts. Penetration is pushed out
+        // separately (split impulse), so resolving it never adds kinetic energy.
+        float inverseDt = 1.0f / dt;
+        for (uint32_t i = 0; i < island.contactCount; i++) {
+            PhysicsContact& contact = m_contacts[contacts[i]];
+            Body& bodyA = m_bodies[contact.a];
+            Body& bodyB = m_bodies[contact.b];
+            float relative[3] = {bodyB.velocity[0] - bodyA.velocity[0], bodyB.velocity[1] - bodyA.velocity[1],
+                                 bodyB.velocity[2] - bodyA.velocity[2]};
+            float normalVelocity = physicsDot(relative, contact.normal);
+            contact.targetVelocity = std::min(contact.penetration, 0.0f) * inverseDt;
+            contact.positionBias = m_config.baumgarte * inverseDt *
+                                   std::max(contact.penetration - m_config.penetrationSlop, 0.0f);
+            contact.positionImpulse = 0.0f;
+            if (normalVelocity < -m_config.restitutionThreshold) {
+                contact.targetVelocity = std::max(contact.targetVelocity, -contact.restitution * normalVelocity);
+            }
+        }
+        // Warm start only once every target is known: bounces use the velocities before any impulse
+        for (uint32_t i = 0; i < island.contactCount; i++) {
+            PhysicsContact& contact = m_contacts[contacts[i]];
+            Body& bodyA = m_bodies[contact.a];
+            Body& bodyB = m_bodies[contact.b];
+            float impulse[3];
+            for (int axis = 0; axis < 3; axis++) {
+                impulse[axis] = contact.normal[axis] * contact.normalImpulse +
+                                contact.tangent1[axis] * contact.tangentImpulse[0] +
+                                contact.tangent2[axis] * contact.tangentImpulse[1];
+            }
+            applyVelocity(bodyA, impulse, -1.0f);
+            applyVelocity(bodyB, impulse, 1.0f);
+        }
+
+        for (uint32_t iteration = 0; iteration < m_config.velocityIterations; iteration++) {
+            for (uint32_t i = 0; i < island.contactCount; i++) {
+                PhysicsContact& contact = m_contacts[contacts[i]];
+                Body& bodyA = m_bodies[contact.a];
+                Body& bodyB = m_bodies[contact.b];
+
+                // Friction, bounded by the current normal impulse
+                float maxFriction = contact.friction * contact.normalImpulse;
+                const float* tangents[2] = {contact.tangent1, contact.tangent2};
+                for (int t = 0; t < 2; t++) {
+                    const float* tangent = tangents[t];
+                    float relative[3] = {bodyB.velocity[0] - bodyA.velocity[0], bodyB.velocity[1] - bodyA.velocity[1],
+                                         bodyB.velocity[2] - bodyA.velocity[2]};
+                    float lambda = -physicsDot(relative, tangent) * contact.normalMass;
+                    float accumulated = std::min(std::max(contact.tangentImpulse[t] + lambda, -maxFriction), maxFriction);
+                    lambda = accumulated - contact.tangentImpulse[t];
+                    contact.tangentImpulse[t] = accumulated;
+                    applyVelocity(bodyA, tangent, -lambda);
+                    applyVelocity(bodyB, tangent, lambda);
+                }
+
+                // Normal: push apart until the target separation velocity is reached, never pull
+                float relative[3] = {bodyB.velocity[0] - bodyA.velocity[0], bodyB.velocity[1] - bodyA.velocity[1],
+                                     bodyB.velocity[2] - bodyA.velocity[2]};
+                float lambda = (contact.targetVelocity - physicsDot(relative, contact.normal)) * contact.normalMass;
+                float accumulated = std::max(contact.normalImpulse + lambda, 0.0f);
+                lambda = accumulated - contact.normalImpulse;
+                contact.normalImpulse = accumulated;
+                applyVelocity(bodyA, contact.normal, -lambda);
+                applyVelocity(bodyB, contact.normal, lambda);
+            }
+        }
+
+        // Push penetrating bodies apart through the correction terms
+        for (uint32_t iteration = 0; iteration < m_config.positionIterations; iteration++) {
+            for (uint32_t i = 0; i < island.contactCount; i++) {
+                PhysicsContact& contact = m_contacts[contacts[i]];
+                if (contact.positionBias <= 0.0f) {
+                    continue;
+                }
+                Body& bodyA = m_bodies[contact.a];
+                Body& bodyB = m_bodies[contact.b];
+                float relative[3] = {bodyB.correction[0] - bodyA.correction[0], bodyB.correction[1] - bodyA.correction[1],
+                                     bodyB.correction[2] - bodyA.correction[2]};
+                float lambda = (contact.positionBias - physicsDot(relative, contact.normal)) * contact.normalMass;
+                float accumulated = std::max(contact.positionImpulse + lambda, 0.0f);
+                lambda = accumulated - contact.positionImpulse;
+                contact.positionImpulse = accumulated;
+                applyCorrection(bodyA, contact.normal, -lambda);
+                applyCorrection(bodyB, contact.normal, lambda);
+            }
+        }
+
+        // Integrate positions and decide whether the whole island can sleep
+        float sleepVelocitySq = m_config.sleepVelocity * m_config.sleepVelocity;
+        float minSleepTime = m_config.timeToSleep;
+        for (uint32_t i = 0; i < island.bodyCount; i++) {
+            Body& body = m_bodies[bodies[i]];
+            for (int axis = 0; axis < 3; axis++) {
+                body.position[axis] += (body.velocity[axis] + body.correction[axis]) * dt;
+            }
+            if (physicsDot(body.velocity, body.velocity) > sleepVelocitySq) {
+                body.sleepTime = 0.0f;
+            } else {
+                body.sleepTime += dt;
+            }
+            minSleepTime = std::min(minSleepTime, body.sleepTime);
+        }
+        if (minSleepTime >= m_config.timeToSleep) {
+            for (uint32_t i = 0; i < island.bodyCount; i++) {
+                Body& body = m_bodies[bodies[i]];
+                body.awake = false;
+                body.velocity[0] = body.velocity[1] = body.velocity[2] = 0.0f;
+            }
+        }
+    }
+
+    bool islandAwake(const Island& island) const {
+        for (uint32_t i = 0; i < island.bodyCount; i++) {
+            if (m_bodies[m_islandBodies[island.bodyStart + i]].awake) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void runIslandJobs() {
+        float dt = m_config.fixedTimestep;
+        for (size_t i = m_nextJob.fetch_add(1); i < m_jobOrder.size(); i = m_nextJob.fetch_add(1)) {
+            solveIsland(m_islands[m_jobOrder[i]], dt);
+        }
+    }
+
+    void workerLoop() {
+        uint64_t seenBatch = 0;
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            m_wake.wait(lock, [&] { return m_stop || m_batch != seenBatch; });
+            if (m_stop) {
+                return;
+            }
+            seenBatch = m_batch;
+            lock.unlock();
+            runIslandJobs();
+            lock.lock();
+            if (--m_busyThreads == 0) {
+                m_done.notify_one();
+            }
+        }
+    }
+
+    /**
+     * Solve every awake island, largest first, on the worker pool (small steps stay on the caller)
+     */
+    void solveIslands() {
+        m_jobOrder.clear();
+        m_stats.largestIsland = 0;
+        uint32_t awakeBodies = 0;
+        for (uint32_t i = 0; i < m_islands.size(); i++) {
+            if (islandAwake(m_islands[i])) {
+                m_jobOrder.push_back(i);
+                awakeBodies += m_islands[i].bodyCount;
+                m_stats.largestIsland = std::max(m_stats.largestIsland, m_islands[i].bodyCount);
+            }
+        }
+        std::sort(m_jobOrder.begin(), m_jobOrder.end(), [this](uint32_t a, uint32_t b) {
+            return m_islands[a].contactCount != m_islands[b].contactCount
+                       ? m_islands[a].contactCount > m_islands[b].contactCount
+                       : a < b;
+        });
+        m_stats.islands = static_cast<uint32_t>(m_jobOrder.size());
+        m_nextJob = 0;
+
+        const uint32_t MIN_BODIES_FOR_THREADS = 256;
+        uint32_t threadCount = m_config.threadCount;
+        if (threadCount == 0) {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+        if (threadCount <= 1 || m_jobOrder.size() < 2 || awakeBodies < MIN_BODIES_FOR_THREADS) {
+            runIslandJobs();
+            return;
+        }
+
+        while (m_threads.size() + 1 < threadCount) {
+            m_threads.emplace_back(&PhysicsWorld::workerLoop, this);
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_busyThreads = static_cast<uint32_t>(m_threads.size());
+            m_batch++;
+        }
+        m_wake.notify_all();
+        runIslandJobs();
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [&] { return m_busyThreads == 0; });
+    }
+
+public:
+    explicit PhysicsWorld(const PhysicsConfig& config = PhysicsConfig()) : m_config(config) {}
+
+    ~PhysicsWorld() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for (std::thread& thread : m_threads) {
+            thread.join();
+        }
+    }
+
+    PhysicsWorld(const PhysicsWorld&) = delete;
+    PhysicsWorld& operator=(const PhysicsWorld&) = delete;
+
+    /**
+     * Create a body
+     * @return Body id
+     */
+    uint32_t createBody(const RigidBodyDesc& desc) {
+        uint32_t id;
+        if (!m_freeIds.empty()) {
+            id = m_freeIds.back();
+            m_freeIds.pop_back();
+        } else {
+            id = static_cast<uint32_t>(m_bodies.size());
+            m_bodies.push_back(Body());
+        }
+        Body& body = m_bodies[id];
+        for (int axis = 0; axis < 3; axis++) {
+            body.position[axis] = desc.position[axis];
+            body.velocity[axis] = desc.isStatic ? 0.0f : desc.velocity[axis];
+            body.correction[axis] = 0.0f;
+            body.halfExtents[axis] = desc.halfExtents[axis];
+        }
+        body.radius = desc.radius;
+        body.invMass = desc.isStatic || desc.mass <= 0.0f ? 0.0f : 1.0f / desc.mass;
+        body.friction = desc.friction;
+        body.restitution = desc.restitution;
+        body.sleepTime = 0.0f;
+        body.userData = desc.userData;
+        body.shape = desc.shape;
+        body.isStatic = desc.isStatic;
+        body.awake = !desc.isStatic;
+        body.alive = true;
+        body.proxy = m_broadphase.addProxy(bodyBounds(body), desc.isStatic, id);
+        m_bodyCount++;
+        return id;
+    }
+
+    void destroyBody(uint32_t id) {
+        if (!isValid(id)) {
+            return;
+        }
+        wakeTouching(id);
+        m_broadphase.removeProxy(m_bodies[id].proxy);
+        m_bodies[id].alive = false;
+        m_bodies[id].awake = false;
+        m_freeIds.push_back(id);
+        m_bodyCount--;
+    }
+
+    /**
+     * Wake a body (its island wakes with it at the next step)
+     */
+    void wake(uint32_t id) {
+        if (isValid(id) && !m_bodies[id].isStatic) {
+            m_bodies[id].awake = true;
+            m_bodies[id].sleepTime = 0.0f;
+        }
+    }
+
+    /**
+     * Teleport a body (static bodies included); wakes it and whatever rested on it
+     */
+    void setPosition(uint32_t id, float x, float y, float z) {
+        if (!isValid(id)) {
+            return;
+        }
+        Body& body = m_bodies[id];
+        body.position[0] = x;
+        body.position[1] = y;
+        body.position[2] = z;
+        m_broadphase.updateProxy(body.proxy, bodyBounds(body));
+        wake(id);
+        wakeTouching(id);
+    }
+
+    void setVelocity(uint32_t id, float x, float y, float z) {
+        if (!isValid(id) || m_bodies[id].isStatic) {
+            return;
+        }
+        Body& body = m_bodies[id];
+        body.velocity[0] = x;
+        body.velocity[1] = y;
+        body.velocity[2] = z;
+        wake(id);
+    }
+
+    void applyImpulse(uint32_t id, float x, float y, float z) {
+        if (!isValid(id) || m_bodies[id].isStatic) {
+            return;
+        }
+        Body& body = m_bodies[id];
+        body.velocity[0] += x * body.invMass;
+        body.velocity[1] += y * body.invMass;
+        body.velocity[2] += z * body.invMass;
+        wake(id);
+    }
+
+    /**
+     * Wake every body in contact with a body (it moved or went away)
+     */
+    void wakeTouching(uint32_t id) {
+        for (const PhysicsContact& contact : m_contacts) {
+            if (contact.a == id) {
+                wake(contact.b);
+            } else if (contact.b == id) {
+                wake(contact.a);
+            }
+        }
+    }
+
+    /**
+     * Advance the simulation by one fixed timestep
+     */
+    void step() {
+        updateContacts();
+        buildIslands();
+        solveIslands();
+
+        m_stats.bodies = m_bodyCount;
+        m_stats.contacts = static_cast<uint32_t>(m_contacts.size());
+        m_stats.awakeBodies = 0;
+        for (const Body& body : m_bodies) {
+            m_stats.awakeBodies += body.alive && body.awake ? 1 : 0;
+        }
+    }
+
+    /**
+     * Advance by a frame's elapsed time in fixed steps (at most maxSubsteps)
+     * @return Number of steps taken
+     */
+    uint32_t update(float frameTime) {
+        m_accumulator += frameTime;
+        uint32_t steps = 0;
+        while (m_accumulator >= m_config.fixedTimestep && steps < m_config.maxSubsteps) {
+            step();
+            m_accumulator -= m_config.fixedTimestep;
+            steps++;
+        }
+        if (steps == m_config.maxSubsteps && m_accumulator >= m_config.fixedTimestep) {
+            m_accumulator = 0.0f;
+        }
+        return steps;
+    }
+
+    /**
+     * Fraction of a step left in the accumulator (for interpolating rendered positions)
+     */
+    float getInterpolationAlpha() const { return m_accumulator / m_config.fixedTimestep; }
+
+    bool isValid(uint32_t id) const { return id < m_bodies.size() && m_bodies[id].alive; }
+    bool isAwake(uint32_t id) const { return isValid(id) && m_bodies[id].awake; }
+    bool isStatic(uint32_t id) const { return isValid(id) && m_bodies[id].isStatic; }
+    uint32_t getUserData(uint32_t id) const { return id < m_bodies.size() ? m_bodies[id].userData : 0; }
+
+    void getPosition(uint32_t id, float out[3]) const {
+        for (int axis = 0; axis < 3; axis++) {
+            out[axis] = isValid(id) ? m_bodies[id].position[axis] : 0.0f;
+        }
+    }
+
+    void getVelocity(uint32_t id, float out[3]) const {
+        for (int axis = 0; axis < 3; axis++) {
+            out[axis] = isValid(id) ? m_bodies[id].velocity[axis] : 0.0f;
+        }
+    }
+
+    uint32_t getBodyCount() const { return m_bodyCount; }
+    const std::vector<PhysicsContact>& getContacts() const { return m_contacts; }
+    const PhysicsConfig& getConfig() const { return m_config; }
+    const Stats& getStats() const { return m_stats; }
+};
+
+// ============================================================================
+// ECS integration
+// ============================================================================
+
+/**
+ * RigidBodyComponent - Links an entity to its body in a PhysicsWorld
+ */
+struct RigidBodyComponent {
+    uint32_t body = PhysicsWorld::INVALID_BODY;
+};
+
+/**
+ * Create a body for an entity and attach a RigidBodyComponent (desc.userData is set to the entity)
+ */
+inline uint32_t physics_add_body(PhysicsWorld& world, EntityStorage& storage, EntityId entity, RigidBodyDesc desc) {
+    desc.userData = entity;
+    RigidBodyComponent component;
+    component.body = world.createBody(desc);
+    storage.add_component(entity, component);
+    return component.body;
+}
+
+/**
+ * Copy body positions into each entity's Position component (any type with float x, y, z)
+ * Static bodies only move through setPosition, so they are skipped.
+ */
+template <typename Position>
+inline void physics_write_positions(const PhysicsWorld& world, EntityStorage& storage) {
+    storage.for_each<RigidBodyComponent>([&](EntityId entity, RigidBodyComponent& component) {
+        if (!world.isValid(component.body) || world.isStatic(component.body)) {
+            return;
+        }
+        Position* position = storage.get_component<Position>(entity);
+        if (position) {
+            float p[3];
+            world.getPosition(component.body, p);
+            position->x = p[0];
+            position->y = p[1];
+            position->z = p[2];
+        }
+    });
+}
+
+#endif // EDEN_RIGID_BODY_H
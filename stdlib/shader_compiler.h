@@ -0,0 +1,1094 @@
+// EDEN ENGINE - ShaderCompiler
+// GLSL -> SPIR-V compile service with a content-addressed SPIR-V cache
+// A shader's cache key covers its stage, its source and every file it #includes (comments and
+// whitespace stripped, so cosmetic edits never recompile), the defines and the compiler backend.
+// Hits are served from memory, then from the on-disk cache; only misses reach the compiler.
+//
+// Backends: shaderc in-process by default (link shaderc_shared from the Vulkan SDK). Building with
+// EDEN_SHADER_COMPILER_GLSLC drops that dependency and runs one glslc process per cache miss
+// instead ($VULKAN_SDK/bin or PATH); a missing glslc is reported once on stderr.
+
+#ifndef EDEN_SHADER_COMPILER_H
+#define EDEN_SHADER_COMPILER_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <cctype>
+#include <iostream>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#endif
+
+#ifndef EDEN_SHADER_COMPILER_GLSLC
+#include <shaderc/shaderc.h>
+#else
+#include <filesystem>
+#endif
+
+static constexpr uint32_t SPIRV_MAGIC = 0x07230203;
+static constexpr uint32_t SHADER_CACHE_VERSION = 1;     // Bump when the key or file layout changes
+
+enum class ShaderStageKind {
+    Unknown,
+    Vertex,
+    Fragment,
+    Compute,
+    Geometry,
+    TessControl,
+    TessEvaluation
+};
+
+// glslc -fshader-stage / file extension name of a stage
+inline const char* shader_stage_name(ShaderStageKind stage) {
+    switch (stage) {
+        case ShaderStageKind::Vertex: return "vert";
+        case ShaderStageKind::Fragment: return "frag";
+        case ShaderStageKind::Compute: return "comp";
+        case ShaderStageKind::Geometry: return "geom";
+        case ShaderStageKind::TessControl: return "tesc";
+        case ShaderStageKind::TessEvaluation: return "tese";
+        case ShaderStageKind::Unknown: break;
+    }
+    return "";
+}
+
+/**
+ * Stage of a GLSL source from its name: the .vert/.frag/.comp/.geom/.tesc/.tese extension, or
+ * for .glsl files the stage named in the file name (vert_3d.glsl, my_frag.glsl)
+ */
+inline ShaderStageKind shader_stage_from_path(const std::string& path) {
+    static const ShaderStageKind STAGES[] = {
+        ShaderStageKind::Vertex, ShaderStageKind::Fragment, ShaderStageKind::Compute,
+        ShaderStageKind::Geometry, ShaderStageKind::TessControl, ShaderStageKind::TessEvaluation
+    };
+    std::string name = path.substr(path.find_last_of("/\\") == std::string::npos ? 0 : path.find_last_of("/\\") + 1);
+    std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    size_t dot = name.find_last_of('.');
+    if (dot == std::string::npos) {
+        return ShaderStageKind::Unknown;
+    }
+    std::string extension = name.substr(dot + 1);
+    for (ShaderStageKind stage : STAGES) {
+        if (extension == shader_stage_name(stage)) {
+            return stage;
+        }
+    }
+    if (extension == "glsl") {
+        for (ShaderStageKind stage : STAGES) {
+            if (name.find(shader_stage_name(stage)) != std::string::npos) {
+                return stage;
+            }
+        }
+    }
+    return ShaderStageKind::Unknown;
+}
+
+struct ShaderDefine {
+    std::string name;
+    std::string value;
+};
+
+struct ShaderCompileOptions {
+    std::vector<ShaderDefine> defines;
+    std::vector<std::string> includeDirs;   // Searched for <file> includes, and for "file" after the includer's directory
+    bool optimize = true;
+};
+
+struct ShaderCompileResult {
+    bool ok = false;
+    bool fromCache = false;                 // Served from the memory or disk cache (no compile)
+    uint64_t key = 0;
+    std::vector<uint32_t> spirv;
+    std::vector<std::string> includes;      // Every file pulled in by #include (resolved paths)
+    std::string log;                        // Compiler errors/warnings
+};
+
+inline uint64_t shader_hash(const void* data, size_t size, uint64_t hash = 14695981039346656037ull) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+inline uint64_t shader_hash_string(const std::string& text, uint64_t hash) {
+    // The length separates consecutive strings ("ab"+"c" never hashes like "a"+"bc")
+    uint64_t length = text.size();
+    hash = shader_hash(&length, sizeof(length), hash);
+    return shader_hash(text.data(), text.size(), hash);
+}
+
+/**
+ * Source reduced to what the compiler sees: comments removed, runs of spaces/tabs collapsed,
+ * blank lines and leading/trailing whitespace dropped. Line structure is kept, so directives
+ * still end where they did.
+ */
+inline std::string shader_normalize_source(const std::string& source) {
+    std::string out;
+    out.reserve(source.size());
+    bool lineHasText = false;
+    bool pendingSpace = false;
+    size_t i = 0;
+    while (i < source.size()) {
+        char c = source[i];
+        if (c == '/' && i + 1 < source.size() && source[i + 1] == '/') {
+            while (i < source.size() && source[i] != '\n') {
+                i++;
+            }
+            continue;
+        }
+        if (c == '/' && i + 1 < source.size() && source[i + 1] == '*') {
+            size_t end = source.find("*/", i + 2);
+            size_t stop = end == std::string::npos ? source.size() : end + 2;
+            // A block comment separates tokens and may span lines; keep its line breaks
+            for (size_t j = i; j < stop; j++) {
+                if (source[j] == '\n' && lineHasText) {
+                    out += '\n';
+                    lineHasText = false;
+                }
+            }
+            pendingSpace = lineHasText;
+            i = stop;
+            continue;
+        }
+        if (c == '\n' || c == '\r') {
+            if (lineHasText) {
+                out += '\n';
+            }
+            lineHasText = false;
+            pendingSpace = false;
+            i++;
+            continue;
+        }
+        if (c == ' ' || c == '\t' || c == '\f' || c == '\v') {
+            pendingSpace = lineHasText;
+            i++;
+            continue;
+        }
+        if (pendingSpace) {
+            out += ' ';
+            pendingSpace = false;
+        }
+        out += c;
+        lineHasText = true;
+        i++;
+    }
+    if (lineHasText) {
+        out += '\n';
+    }
+    return out;
+}
+
+inline bool shader_read_text(const std::string& path, std::string& text) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    text = contents.str();
+    return true;
+}
+
+inline std::string shader_directory_of(const std::string& path) {
+    size_t slash = path.find_last_of("/\\");
+    return slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+}
+
+/**
+ * Resolve an #include: "name" is looked up next to the including file first, then in the include
+ * directories; <name> only in the include directories. Returns an empty string if not found.
+ */
+inline std::string shader_resolve_include(const std::string& name, bool relative, const std::string& includer,
+                                          const std::vector<std::string>& includeDirs) {
+    std::vector<std::string> candidates;
+    if (relative) {
+        candidates.push_back(shader_directory_of(includer) + name);
+    }
+    for (const std::string& dir : includeDirs) {
+        bool separated = !dir.empty() && (dir.back() == '/' || dir.back() == '\\');
+        candidates.push_back(dir.empty() ? name : dir + (separated ? "" : "/") + name);
+    }
+    for (const std::string& candidate : candidates) {
+        std::ifstream file(candidate);
+        if (file.is_open()) {
+            return candidate;
+        }
+    }
+    return std::string();
+}
+
+// Three-valued logic for preprocessor conditions the include scan cannot always decide
+enum class ShaderTruth {
+    False,
+    True,
+    Unknown
+};
+
+inline ShaderTruth shader_truth_not(ShaderTruth a) {
+    return a == ShaderTruth::Unknown ? a : a == ShaderTruth::True ? ShaderTruth::False : ShaderTruth::True;
+}
+
+inline ShaderTruth shader_truth_and(ShaderTruth a, ShaderTruth b) {
+    if (a == ShaderTruth::False || b == ShaderTruth::False) {
+        return ShaderTruth::False;
+    }
+    return a == ShaderTruth::True && b == ShaderTruth::True ? ShaderTruth::True : ShaderTruth::Unknown;
+}
+
+inline ShaderTruth shader_truth_or(ShaderTruth a, ShaderTruth b) {
+    return shader_truth_not(shader_truth_and(shader_truth_not(a), shader_truth_not(b)));
+}
+
+/**
+ * Macros known while scanning for includes: the compile's defines, the GLSL macros every Vulkan
+ * compile predefines, and each #define/#undef in code that is compiled. A macro defined or
+ * undefined in code that may or may not be compiled is uncertain.
+ */
+struct ShaderMacroTable {
+    std::unordered_map<std::string, std::string> values;    // Name -> replacement text
+    std::unordered_set<std::string> functionLike;
+    std::unordered_set<std::string> uncertain;
+
+    explicit ShaderMacroTable(const std::vector<ShaderDefine>& defines) {
+        values["VULKAN"] = "100";
+        values["GL_SPIRV"] = "100";
+        values["GL_core_profile"] = "1";
+        for (const ShaderDefine& define : defines) {
+            values[define.name] = define.value;
+        }
+    }
+
+    // Whether `name` is defined; macros the compiler may predefine (GL_*, __*) are Unknown
+    ShaderTruth isDefined(const std::string& name) const {
+        if (uncertain.count(name)) {
+            return ShaderTruth::Unknown;
+        }
+        if (values.count(name)) {
+            return ShaderTruth::True;
+        }
+        bool predefined = name.compare(0, 3, "GL_") == 0 || name.compare(0, 2, "__") == 0;
+        return predefined ? ShaderTruth::Unknown : ShaderTruth::False;
+    }
+};
+
+/**
+ * Evaluates an #if/#elif expression: integer arithmetic, comparisons, logic, ?:, defined and
+ * object-like macros. Anything it cannot decide (function-like or uncertain macros, macros the
+ * compiler predefines, malformed expressions) makes the result Unknown.
+ */
+class ShaderConditionParser {
+    struct Value {
+        long long value = 0;
+        bool known = false;
+    };
+
+    static constexpr const char* UNKNOWN_TOKEN = "#unknown";
+
+    const ShaderMacroTable& m_macros;
+    std::vector<std::string> m_tokens;
+    size_t m_pos = 0;
+    bool m_valid = true;
+
+    static Value known(long long value) {
+        Value result;
+        result.value = value;
+        result.known = true;
+        return result;
+    }
+
+    static bool isIdentifier(const std::string& token) {
+        return !token.empty() && (std::isalpha(static_cast<unsigned char>(token[0])) || token[0] == '_');
+    }
+
+    static std::vector<std::string> tokenize(const std::string& text) {
+        static const char* pairs[] = {"<<", ">>", "<=", ">=", "==", "!=", "&&", "||"};
+        std::vector<std::string> tokens;
+        size_t i = 0;
+        while (i < text.size()) {
+            unsigned char c = static_cast<unsigned char>(text[i]);
+            if (std::isspace(c)) {
+                i++;
+                continue;
+            }
+            size_t start = i;
+            if (std::isalnum(c) || c == '_') {
+                while (i < text.size() && (std::isalnum(static_cast<unsigned char>(text[i])) || text[i] == '_')) {
+                    i++;
+                }
+            } else {
+                i++;
+                for (const char* pair : pairs) {
+                    if (text.compare(start, 2, pair) == 0) {
+                        i = start + 2;
+                        break;
+                    }
+                }
+            }
+            tokens.push_back(text.substr(start, i - start));
+        }
+        return tokens;
+    }
+
+    // Macro replacement; the operand of `defined` is left alone
+    void expand(const std::string& text, int depth) {
+        std::vector<std::string> tokens = tokenize(text);
+        for (size_t i = 0; i < tokens.size(); i++) {
+            const std::string& token = tokens[i];
+            if (token == "defined") {
+                size_t last = std::min(tokens.size() - 1, i + 1 < tokens.size() && tokens[i + 1] == "(" ? i + 3 : i + 1);
+                m_tokens.insert(m_tokens.end(), tokens.begin() + i, tokens.begin() + last + 1);
+                i = last;
+            } else if (!isIdentifier(token)) {
+                m_tokens.push_back(token);
+            } else if (m_macros.uncertain.count(token) || m_macros.functionLike.count(token)) {
+                m_tokens.push_back(UNKNOWN_TOKEN);
+            } else if (m_macros.values.count(token)) {
+                if (depth < 16) {
+                    expand(m_macros.values.at(token), depth + 1);
+                } else {
+                    m_tokens.push_back(UNKNOWN_TOKEN);   // Self-referencing macro
+                }
+            } else {
+                m_tokens.push_back(token);
+            }
+        }
+    }
+
+    bool accept(const char* token) {
+        if (m_pos < m_tokens.size() && m_tokens[m_pos] == token) {
+            m_pos++;
+            return true;
+        }
+        return false;
+    }
+
+    static int precedence(const std::string& op) {
+        static const char* levels[][4] = {
+            {"||"}, {"&&"}, {"|"}, {"^"}, {"&"}, {"==", "!="}, {"<", ">", "<=", ">="}, {"<<", ">>"}, {"+", "-"}, {"*", "/", "%"},
+        };
+        for (int level = 0; level < 10; level++) {
+            for (const char* candidate : levels[level]) {
+                if (candidate && op == candidate) {
+                    return level + 1;
+                }
+            }
+        }
+        return 0;
+    }
+
+    static Value apply(const std::string& op, Value a, Value b) {
+        // && and || are decided by one known side, as the compiler would short-circuit
+        if (op == "&&" || op == "||") {
+            bool decisive = op == "||";
+            if ((a.known && (a.value != 0) == decisive) || (b.known && (b.value != 0) == decisive)) {
+                return known(decisive);
+            }
+            return a.known && b.known ? known(!decisive) : Value();
+        }
+        if (!a.known || !b.known) {
+            return Value();
+        }
+        if ((op == "/" || op == "%") && b.value == 0) {
+            return Value();
+        }
+        if ((op == "<<" || op == ">>") && (b.value < 0 || b.value > 62)) {
+            return Value();
+        }
+        if (op == "|") return known(a.value | b.value);
+        if (op == "^") return known(a.value ^ b.value);
+        if (op == "&") return known(a.value & b.value);
+        if (op == "==") return known(a.value == b.value);
+        if (op == "!=") return known(a.value != b.value);
+        if (op == "<") return known(a.value < b.value);
+        if (op == ">") return known(a.value > b.value);
+        if (op == "<=") return known(a.value <= b.value);
+        if (op == ">=") return known(a.value >= b.value);
+        if (op == "<<") return known(a.value << b.value);
+        if (op == ">>") return known(a.value >> b.value);
+        if (op == "+") return known(a.value + b.value);
+        if (op == "-") return known(a.value - b.value);
+        if (op == "*") return known(a.value * b.value);
+        if (op == "/") return known(a.value / b.value);
+        return known(a.value % b.value);
+    }
+
+    Value parsePrimary() {
+        if (m_pos >= m_tokens.size()) {
+            m_valid = false;
+            return Value();
+        }
+        std::string token = m_tokens[m_pos++];
+        if (token == "(") {
+            Value inner = parseConditional();
+            m_valid = m_valid && accept(")");
+            return inner;
+        }
+        if (token == "defined") {
+            bool parenthesized = accept("(");
+            if (m_pos >= m_tokens.size() || !isIdentifier(m_tokens[m_pos])) {
+                m_valid = false;
+                return Value();
+            }
+            ShaderTruth defined = m_macros.isDefined(m_tokens[m_pos++]);
+            m_valid = m_valid && (!parenthesized || accept(")"));
+            return defined == ShaderTruth::Unknown ? Value() : known(defined == ShaderTruth::True);
+        }
+        if (token == UNKNOWN_TOKEN) {
+            return Value();
+        }
+        if (std::isdigit(static_cast<unsigned char>(token[0]))) {
+            std::string digits = token;
+            while (!digits.empty() && std::strchr("uUlL", digits.back())) {
+                digits.pop_back();
+            }
+            char* end = nullptr;
+            long long value = std::strtoll(digits.c_str(), &end, 0);
+            m_valid = m_valid && !digits.empty() && *end == '\0';
+            return known(value);
+        }
+        if (isIdentifier(token)) {
+            // Undefined names are 0, except those the compiler may predefine
+            return m_macros.isDefined(token) == ShaderTruth::Unknown ? Value() : known(0);
+        }
+        m_valid = false;
+        return Value();
+    }
+
+    Value parseUnary() {
+        for (const char* op : {"!", "~", "-", "+"}) {
+            if (accept(op)) {
+                Value operand = parseUnary();
+                if (!operand.known) {
+                    return operand;
+                }
+                switch (op[0]) {
+                    case '!': return known(!operand.value);
+                    case '~': return known(~operand.value);
+                    case '-': return known(-operand.value);
+                    default: return operand;
+                }
+            }
+        }
+        return parsePrimary();
+    }
+
+    Value parseBinary(int minPrecedence) {
+        Value left = parseUnary();
+        while (m_valid && m_pos < m_tokens.size()) {
+            std::string op = m_tokens[m_pos];
+            int level = precedence(op);
+            if (level == 0 || level < minPrecedence) {
+                break;
+            }
+            m_pos++;
+            Value right = parseBinary(level + 1);
+            left = apply(op, left, right);
+        }
+        return left;
+    }
+
+    Value parseConditional() {
+        Value condition = parseBinary(1);
+        if (!accept("?")) {
+            return condition;
+        }
+        Value ifTrue = parseConditional();
+        m_valid = m_valid && accept(":");
+        Value ifFalse = parseConditional();
+        if (condition.known) {
+            return condition.value ? ifTrue : ifFalse;
+        }
+        return ifTrue.known && ifFalse.known && ifTrue.value == ifFalse.value ? ifTrue : Value();
+    }
+
+public:
+    ShaderConditionParser(const std::string& expression, const ShaderMacroTable& macros) : m_macros(macros) {
+        expand(expression, 0);
+    }
+
+    ShaderTruth evaluate() {
+        Value result = parseConditional();
+        if (!m_valid || m_pos != m_tokens.size() || !result.known) {
+            return ShaderTruth::Unknown;
+        }
+        return result.value ? ShaderTruth::True : ShaderTruth::False;
+    }
+};
+
+/**
+ * Include scan of one file. `compiled` says whether the file's code is compiled at all (Unknown
+ * for a file included from a branch that may not be taken).
+ */
+inline bool shader_scan_includes(const std::string& path, const std::string& source, ShaderTruth compiled,
+                                 const std::vector<std::string>& includeDirs, ShaderMacroTable& macros,
+                                 std::vector<std::string>& includes, std::vector<std::string>& contents,
+                                 std::string& error) {
+    struct Branch {
+        ShaderTruth enclosing;      // Whether the code around the #if is compiled
+        ShaderTruth taken;          // Whether an earlier #if/#elif of the group was taken
+        ShaderTruth active;         // Whether the current branch is compiled
+    };
+    std::vector<Branch> branches;
+
+    std::istringstream lines(shader_normalize_source(source));
+    std::string line;
+    while (std::getline(lines, line)) {
+        if (line.empty() || line[0] != '#') {
+            continue;
+        }
+        size_t pos = line.find_first_not_of(' ', 1);
+        if (pos == std::string::npos) {
+            continue;
+        }
+        size_t nameEnd = pos;
+        while (nameEnd < line.size() && std::isalpha(static_cast<unsigned char>(line[nameEnd]))) {
+            nameEnd++;
+        }
+        std::string directive = line.substr(pos, nameEnd - pos);
+        std::string rest = nameEnd < line.size() ? line.substr(nameEnd + (line[nameEnd] == ' ' ? 1 : 0)) : std::string();
+        std::string word = rest.substr(0, rest.find_first_of(" ("));
+        ShaderTruth current = branches.empty() ? compiled : branches.back().active;
+
+        if (directive == "if" || directive == "ifdef" || directive == "ifndef") {
+            ShaderTruth condition = ShaderTruth::False;
+            if (current != ShaderTruth::False) {
+                condition = directive == "if" ? ShaderConditionParser(rest, macros).evaluate()
+                          : directive == "ifdef" ? macros.isDefined(word) : shader_truth_not(macros.isDefined(word));
+            }
+            branches.push_back({current, condition, shader_truth_and(current, condition)});
+            continue;
+        }
+        if (directive == "elif" || directive == "else") {
+            if (branches.empty()) {
+                continue;   // The compiler reports the unmatched directive
+            }
+            Branch& branch = branches.back();
+            ShaderTruth reachable = shader_truth_and(branch.enclosing, shader_truth_not(branch.taken));
+            ShaderTruth condition = ShaderTruth::True;
+            if (directive == "elif") {
+                condition = reachable == ShaderTruth::False ? ShaderTruth::False : ShaderConditionParser(rest, macros).evaluate();
+            }
+            branch.active = shader_truth_and(reachable, condition);
+            branch.taken = shader_truth_or(branch.taken, condition);
+            continue;
+        }
+        if (directive == "endif") {
+            if (!branches.empty()) {
+                branches.pop_back();
+            }
+            continue;
+        }
+        if (current == ShaderTruth::False) {
+            continue;
+        }
+
+        if (directive == "define" || directive == "undef") {
+            if (word.empty()) {
+                continue;
+            }
+            if (current == ShaderTruth::Unknown) {
+                macros.uncertain.insert(word);
+                continue;
+            }
+            macros.uncertain.erase(word);
+            macros.functionLike.erase(word);
+            macros.values.erase(word);
+            if (directive == "define") {
+                bool function = rest.size() > word.size() && rest[word.size()] == '(';
+                if (function) {
+                    macros.functionLike.insert(word);
+                }
+                macros.values[word] = function || rest.size() <= word.size() ? std::string() : rest.substr(word.size() + 1);
+            }
+            continue;
+        }
+        if (directive == "version" && current == ShaderTruth::True) {
+            macros.values["__VERSION__"] = word;
+            continue;
+        }
+        if (directive != "include") {
+            continue;
+        }
+
+        size_t open = rest.find_first_of("\"<");
+        if (open == std::string::npos) {
+            continue;
+        }
+        char closeChar = rest[open] == '"' ? '"' : '>';
+        size_t close = rest.find(closeChar, open + 1);
+        if (close == std::string::npos) {
+            continue;
+        }
+        std::string name = rest.substr(open + 1, close - open - 1);
+        std::string resolved = shader_resolve_include(name, closeChar == '"', path, includeDirs);
+        if (resolved.empty()) {
+            if (current == ShaderTruth::Unknown) {
+                continue;   // Only an error if the branch is compiled; the compiler will say so
+            }
+            error = path + ": cannot find include \"" + name + "\"";
+            return false;
+        }
+        if (std::find(includes.begin(), includes.end(), resolved) != includes.end()) {
+            continue;
+        }
+        std::string text;
+        if (!shader_read_text(resolved, text)) {
+            error = path + ": cannot read include \"" + resolved + "\"";
+            return false;
+        }
+        includes.push_back(resolved);
+        contents.push_back(text);
+        if (!shader_scan_includes(resolved, text, current, includeDirs, macros, includes, contents, error)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Append every file `source` (read from `path`) includes, transitively and in first-seen order,
+ * to `includes`. Each file is visited once, which also stops include cycles. Includes in
+ * #if/#ifdef branches that `defines` rule out are skipped. A branch whose condition cannot be
+ * decided here (e.g. #ifdef GL_EXT_...) is followed, but a missing include there is not an error.
+ * Returns false and sets `error` if a compiled include cannot be found.
+ */
+inline bool shader_collect_includes(const std::string& path, const std::string& source,
+                                    const std::vector<std::string>& includeDirs, const std::vector<ShaderDefine>& defines,
+                                    std::vector<std::string>& includes, std::vector<std::string>& contents,
+                                    std::string& error) {
+    ShaderMacroTable macros(defines);
+    return shader_scan_includes(path, source, ShaderTruth::True, includeDirs, macros, includes, contents, error);
+}
+
+/**
+ * Cache key of a compile: stage, backend, optimization, defines (order-independent), and the
+ * normalized text of the source and of every include in order
+ */
+inline uint64_t shader_cache_key(ShaderStageKind stage, const std::string& backend, const ShaderCompileOptions& options,
+                                 const std::string& source, const std::vector<std::string>& includeContents) {
+    uint64_t hash = shader_hash(&SHADER_CACHE_VERSION, sizeof(SHADER_CACHE_VERSION));
+    uint32_t stageValue = static_cast<uint32_t>(stage);
+    hash = shader_hash(&stageValue, sizeof(stageValue), hash);
+    hash = shader_hash_string(backend, hash);
+    hash = shader_hash_string(options.optimize ? "O" : "O0", hash);
+
+    std::vector<ShaderDefine> defines = options.defines;
+    std::sort(defines.begin(), defines.end(), [](const ShaderDefine& a, const ShaderDefine& b) {
+        return a.name != b.name ? a.name < b.name : a.value < b.value;
+    });
+    for (const ShaderDefine& define : defines) {
+        hash = shader_hash_string(define.name, hash);
+        hash = shader_hash_string(define.value, hash);
+    }
+    hash = shader_hash_string(shader_normalize_source(source), hash);
+    for (const std::string& text : includeContents) {
+        hash = shader_hash_string(shader_normalize_source(text), hash);
+    }
+    return hash;
+}
+
+/**
+ * ShaderCompiler - Process-wide GLSL compile service with a SPIR-V cache
+ *
+ * Provides:
+ * - compile(): one shader, served from memory, then disk, then the compiler backend
+ * - compileAll(): many shaders on worker threads (startup); each result is the same as compile()
+ * - Include tracking: getIncludes(path) lists the files a source pulled in at its last compile,
+ *   so a hot-reload can also react to edits of a shared include
+ * - Global defines (addDefine) applied to every compile in addition to per-call ones
+ *
+ * compile() and compileAll() may be called from any thread.
+ *
+ * Usage:
+ *   ShaderCompiler& shaders = ShaderCompiler::get_instance();
+ *   shaders.setCacheDirectory("shader_cache");
+ *   std::vector<ShaderCompileResult> warm = shaders.compileAll({"shaders/mesh.vert", "shaders/mesh.frag"});
+ *   ShaderCompileResult result = shaders.compile("shaders/mesh.frag");
+ *   if (result.ok) { createModule(result.spirv); } else { std::cerr << result.log; }
+ */
+class ShaderCompiler {
+public:
+    struct Stats {
+        uint32_t compiled = 0;          // Cache misses compiled by the backend
+        uint32_t memoryHits = 0;
+        uint32_t diskHits = 0;
+        uint32_t failures = 0;
+    };
+
+private:
+    std::string m_cacheDirectory = "shader_cache";
+    std::vector<ShaderDefine> m_defines;
+    std::vector<std::string> m_includeDirs;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> m_memoryCache;
+    std::unordered_map<std::string, std::vector<std::string>> m_includes;   // Source path -> includes at last compile
+    uint32_t m_tempCounter = 0;
+    Stats m_stats;
+    mutable std::mutex m_mutex;
+
+#ifndef EDEN_SHADER_COMPILER_GLSLC
+    shaderc_compiler_t m_shaderc = nullptr;
+
+    struct IncludeContext {
+        std::vector<std::string> includeDirs;
+    };
+
+    static shaderc_include_result* resolveInclude(void* userData, const char* requested, int type,
+                                                  const char* requester, size_t) {
+        IncludeContext* context = static_cast<IncludeContext*>(userData);
+        std::string* names = new std::string[2];
+        names[0] = shader_resolve_include(requested, type == shaderc_include_type_relative, requester, context->includeDirs);
+        shaderc_include_result* result = new shaderc_include_result();
+        if (names[0].empty() || !shader_read_text(names[0], names[1])) {
+            names[0].clear();
+            names[1] = std::string("cannot find include ") + requested;
+        }
+        result->source_name = names[0].c_str();
+        result->source_name_length = names[0].size();
+        result->content = names[1].c_str();
+        result->content_length = names[1].size();
+        result->user_data = names;
+        return result;
+    }
+
+    static void releaseInclude(void*, shaderc_include_result* result) {
+        delete[] static_cast<std::string*>(result->user_data);
+        delete result;
+    }
+#endif
+
+    static std::string backendName() {
+#ifndef EDEN_SHADER_COMPILER_GLSLC
+        return "shaderc";
+#else
+        return "glslc";
+#endif
+    }
+
+    std::string cachePath(uint64_t key) const {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.spv", static_cast<unsigned long long>(key));
+        return m_cacheDirectory + "/" + name;
+    }
+
+    static bool readSpirv(const std::string& path, std::vector<uint32_t>& spirv) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            return false;
+        }
+        size_t size = static_cast<size_t>(file.tellg());
+        if (size < 20 || size % 4 != 0) {
+            return false;
+        }
+        spirv.resize(size / 4);
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(spirv.data()), static_cast<std::streamsize>(size));
+        return file && spirv[0] == SPIRV_MAGIC;
+    }
+
+    static bool writeFile(const std::string& path, const void* data, size_t size) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        return static_cast<bool>(file);
+    }
+
+    static void makeDirectory(const std::string& dir) {
+#ifdef _WIN32
+        _mkdir(dir.c_str());
+#else
+        mkdir(dir.c_str(), 0755);
+#endif
+    }
+
+    // Unique temporary path in `dir` (several compiles may run at once)
+    std::string tempPath(const std::string& dir, const char* suffix) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        char name[64];
+        std::snprintf(name, sizeof(name), "/eden_tmp%u_%u%s", static_cast<unsigned>(std::hash<std::thread::id>()(std::this_thread::get_id()) & 0xffff),
+                      m_tempCounter++, suffix);
+        return (dir.empty() ? std::string(".") : dir) + name;
+    }
+
+#ifdef EDEN_SHADER_COMPILER_GLSLC
+    // glslc from $VULKAN_SDK/bin, else the first one on PATH; empty (reported once) if there is none
+    static const std::string& glslcPath() {
+        static const std::string found = [] {
+#ifdef _WIN32
+            const char* exe = "glslc.exe";
+            const char separator = ';';
+#else
+            const char* exe = "glslc";
+            const char separator = ':';
+#endif
+            std::vector<std::string> dirs;
+            if (const char* sdk = std::getenv("VULKAN_SDK")) {
+                dirs.push_back(std::string(sdk) + "/bin");
+                dirs.push_back(std::string(sdk) + "/Bin");
+            }
+            if (const char* path = std::getenv("PATH")) {
+                std::stringstream entries(path);
+                std::string dir;
+                while (std::getline(entries, dir, separator)) {
+                    if (!dir.empty()) {
+                        dirs.push_back(dir);
+                    }
+                }
+            }
+            std::error_code error;
+            for (const std::string& dir : dirs) {
+                std::filesystem::path candidate = std::filesystem::path(dir) / exe;
+                if (std::filesystem::is_regular_file(candidate, error)) {
+                    return candidate.string();
+                }
+            }
+            std::cerr << "[ShaderCompiler] ERROR: glslc not found in $VULKAN_SDK/bin or on PATH; "
+                      << "shaders cannot be compiled (install the Vulkan SDK, or build without EDEN_SHADER_COMPILER_GLSLC)" << std::endl;
+            return std::string();
+        }();
+        return found;
+    }
+#endif
+
+    bool runBackend(const std::string& path, const std::string& source, ShaderStageKind stage,
+                    const ShaderCompileOptions& options, const std::string& tempDir,
+                    std::vector<uint32_t>& spirv, std::string& log) {
+#ifndef EDEN_SHADER_COMPILER_GLSLC
+        static const shaderc_shader_kind KINDS[] = {
+            shaderc_glsl_infer_from_source, shaderc_vertex_shader, shaderc_fragment_shader, shaderc_compute_shader,
+            shaderc_geometry_shader, shaderc_tess_control_shader, shaderc_tess_evaluation_shader
+        };
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_shaderc == nullptr) {
+                m_shaderc = shaderc_compiler_initialize();
+            }
+        }
+        (void)tempDir;
+        IncludeContext context{options.includeDirs};
+        shaderc_compile_options_t compileOptions = shaderc_compile_options_initialize();
+        for (const ShaderDefine& define : options.defines) {
+            shaderc_compile_options_add_macro_definition(compileOptions, define.name.c_str(), define.name.size(),
+                                                         define.value.c_str(), define.value.size());
+        }
+        shaderc_compile_options_set_optimization_level(compileOptions, options.optimize
+            ? shaderc_optimization_level_performance : shaderc_optimization_level_zero);
+        shaderc_compile_options_set_include_callbacks(compileOptions, resolveInclude, releaseInclude, &context);
+        shaderc_compilation_result_t result = shaderc_compile_into_spv(m_shaderc, source.c_str(), source.size(),
+            KINDS[static_cast<int>(stage)], path.c_str(), "main", compileOptions);
+        bool ok = shaderc_result_get_compilation_status(result) == shaderc_compilation_status_success;
+        log = shaderc_result_get_error_message(result);
+        if (ok) {
+            const uint32_t* words = reinterpret_cast<const uint32_t*>(shaderc_result_get_bytes(result));
+            spirv.assign(words, words + shaderc_result_get_length(result) / 4);
+        }
+        shaderc_result_release(result);
+        shaderc_compile_options_release(compileOptions);
+        return ok;
+#else
+        (void)source;
+        const std::string& glslc = glslcPath();
+        if (glslc.empty()) {
+            log = "glslc not found in $VULKAN_SDK/bin or on PATH; install the Vulkan SDK or build without EDEN_SHADER_COMPILER_GLSLC";
+            return false;
+        }
+        std::string output = tempPath(tempDir, ".spv");
+        std::string errors = tempPath(tempDir, ".log");
+        std::string command = "\"" + glslc + "\" -fshader-stage=" + shader_stage_name(stage) + (options.optimize ? " -O" : " -O0");
+        for (const ShaderDefine& define : options.defines) {
+            command += " \"-D" + define.name + (define.value.empty() ? "" : "=" + define.value) + "\"";
+        }
+        for (const std::string& dir : options.includeDirs) {
+            command += " \"-I" + dir + "\"";
+        }
+        command += " \"" + path + "\" -o \"" + output + "\" 2> \"" + errors + "\"";
+#ifdef _WIN32
+        command = "\"" + command + "\"";    // cmd.exe strips one outer pair of quotes
+#endif
+        int status = std::system(command.c_str());
+        shader_read_text(errors, log);
+        bool ok = status == 0 && readSpirv(output, spirv);
+        std::remove(output.c_str());
+        std::remove(errors.c_str());
+        if (!ok && log.empty()) {
+            log = "glslc failed (exit status " + std::to_string(status) + "); is the Vulkan SDK installed?";
+        }
+        return ok;
+#endif
+    }
+
+public:
+    ShaderCompiler() = default;
+    ShaderCompiler(const ShaderCompiler&) = delete;
+    ShaderCompiler& operator=(const ShaderCompiler&) = delete;
+
+#ifndef EDEN_SHADER_COMPILER_GLSLC
+    ~ShaderCompiler() {
+        if (m_shaderc != nullptr) {
+            shaderc_compiler_release(m_shaderc);
+        }
+    }
+#endif
+
+    static ShaderCompiler& get_instance() {
+        static ShaderCompiler instance;
+        return instance;
+    }
+
+    // Directory for cached SPIR-V ("" = memory cache only)
+    void setCacheDirectory(const std::string& dir) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_cacheDirectory = dir;
+    }
+
+    // Define applied to every compile (part of the cache key like any per-call define)
+    void addDefine(const std::string& name, const std::string& value = "") {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_defines.push_back({name, value});
+    }
+
+    void addIncludeDirectory(const std::string& dir) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_includeDirs.push_back(dir);
+    }
+
+    /**
+     * SPIR-V for the GLSL source at `path`. The stage comes from the file name.
+     */
+    ShaderCompileResult compile(const std::string& path, const ShaderCompileOptions& callOptions = ShaderCompileOptions()) {
+        ShaderCompileResult result;
+        ShaderStageKind stage = shader_stage_from_path(path);
+        if (stage == ShaderStageKind::Unknown) {
+            result.log = path + ": cannot tell the shader stage from the file name";
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stats.failures++;
+            return result;
+        }
+
+        ShaderCompileOptions options = callOptions;
+        std::string cacheDirectory;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            options.defines.insert(options.defines.begin(), m_defines.begin(), m_defines.end());
+            options.includeDirs.insert(options.includeDirs.end(), m_includeDirs.begin(), m_includeDirs.end());
+            cacheDirectory = m_cacheDirectory;
+        }
+
+        std::string source;
+        std::vector<std::string> includeContents;
+        if (!shader_read_text(path, source)) {
+            result.log = path + ": cannot read shader source";
+        } else if (shader_collect_includes(path, source, options.includeDirs, options.defines, result.includes,
+                                           includeContents, result.log)) {
+            result.key = shader_cache_key(stage, backendName(), options, source, includeContents);
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (result.key == 0) {
+                m_stats.failures++;
+                return result;
+            }
+            m_includes[path] = result.includes;
+            auto cached = m_memoryCache.find(result.key);
+            if (cached != m_memoryCache.end()) {
+                result.spirv = cached->second;
+                result.ok = result.fromCache = true;
+                m_stats.memoryHits++;
+                return result;
+            }
+        }
+
+        bool fromDisk = !cacheDirectory.empty() && readSpirv(cachePath(result.key), result.spirv);
+        if (!fromDisk && !cacheDirectory.empty()) {
+            makeDirectory(cacheDirectory);
+        }
+        if (!fromDisk && !runBackend(path, source, stage, options, cacheDirectory, result.spirv, result.log)) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stats.failures++;
+            result.spirv.clear();
+            return result;
+        }
+        if (!fromDisk && !cacheDirectory.empty()) {
+            // Temporary file + rename, so a concurrent reader never sees a partial blob
+            std::string temp = tempPath(cacheDirectory, ".part");
+            if (writeFile(temp, result.spirv.data(), result.spirv.size() * sizeof(uint32_t))) {
+                std::remove(cachePath(result.key).c_str());
+                std::rename(temp.c_str(), cachePath(result.key).c_str());
+            }
+            std::remove(temp.c_str());
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_memoryCache[result.key] = result.spirv;
+        result.ok = true;
+        result.fromCache = fromDisk;
+        if (fromDisk) {
+            m_stats.diskHits++;
+        } else {
+            m_stats.compiled++;
+        }
+        return result;
+    }
+
+    /**
+     * Compile `paths` on up to `threadCount` threads (0 = hardware concurrency). Results are in
+     * the order of `paths`.
+     */
+    std::vector<ShaderCompileResult> compileAll(const std::vector<std::string>& paths,
+                                                const ShaderCompileOptions& options = ShaderCompileOptions(),
+                                                uint32_t threadCount = 0) {
+        std::vector<ShaderCompileResult> results(paths.size());
+        if (threadCount == 0) {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+        threadCount = static_cast<uint32_t>(std::min<size_t>(threadCount, paths.size()));
+        std::atomic<size_t> next(0);
+        auto worker = [&]() {
+            for (size_t i = next++; i < paths.size(); i = next++) {
+                results[i] = compile(paths[i], options);
+            }
+        };
+        std::vector<std::thread> threads;
+        for (uint32_t t = 1; t < threadCount; t++) {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        return results;
+    }
+
+    // Files `path` included at its last compile (empty if it was never compiled)
+    std::vector<std::string> getIncludes(const std::string& path) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_includes.find(path);
+        return it != m_includes.end() ? it->second : std::vector<std::string>();
+    }
+
+    // Drop the in-memory cache (the disk cache stays)
+    void clearMemoryCache() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_memoryCache.clear();
+    }
+
+    Stats getStats() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+};
+
+#endif // EDEN_SHADER_COMPILER_H
@@ -0,0 +1,341 @@
+// EDEN ENGINE - Spatial Audio
+// 3D positional sound on top of AudioMixer: an AudioEmitter ECS component, a listener fed from
+// the camera, and a per-frame update that attenuates, pans and doppler-shifts each emitter.
+// Only the loudest emitters within the voice budget get mixer voices; the rest are virtual
+// (their playback position keeps advancing for free) and resume seamlessly when they win a voice.
+
+#ifndef EDEN_SPATIAL_AUDIO_H
+#define EDEN_SPATIAL_AUDIO_H
+
+#include "audio_mixer.h"
+#include "entity_storage.h"
+#include <vector>
+#include <memory>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+
+/**
+ * AudioEmitter - ECS component for a sound at a world position
+ *
+ * Set the clip and parameters, move x/y/z every frame (velocity for doppler is derived from the
+ * movement). The runtime state fields belong to SpatialAudio.
+ */
+struct AudioEmitter {
+    std::shared_ptr<const AudioClip> clip;      // Mono clips pan best; stereo clips are balanced
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+    float volume = 1.0f;
+    float pitch = 1.0f;
+    float minDistance = 1.0f;       // Full volume inside this radius
+    float maxDistance = 50.0f;      // Inaudible (never voiced) beyond this radius
+    float rolloff = 1.0f;           // Inverse-distance rolloff factor
+    int priority = 0;               // Higher priorities win voices before louder lower ones
+    bool loop = true;
+    bool playing = true;            // Clear to stop; cleared by SpatialAudio when a one-shot ends
+
+    // Runtime state
+    AudioMixer::VoiceHandle voice = AudioMixer::INVALID_VOICE;
+    double cursor = 0.0;            // Playback position in source frames while virtual
+    float lastX = 0.0f, lastY = 0.0f, lastZ = 0.0f;
+    bool hasLastPosition = false;
+};
+
+/**
+ * SpatialAudio - Drives AudioEmitters through the AudioMixer
+ *
+ * Per emitter and frame:
+ *   gain    = volume * minDistance / (minDistance + rolloff * (distance - minDistance)),
+ *             faded to zero over the last 10% before maxDistance
+ *   pan     = direction to the emitter projected on the listener's right axis
+ *   doppler = (c + v_listener) / (c + v_emitter), velocities along the listener-to-emitter
+ *             direction (c = 343 m/s)
+ * Audible emitters are ranked by (priority, gain); the top voiceBudget are voiced, the rest
+ * virtualized with a short fade. Voices of emitters that disappear (entity destroyed,
+ * component removed) are stopped on the next update.
+ *
+ * Usage:
+ *   AudioEmitter engine;
+ *   engine.clip = engineSound.getClip();
+ *   g_storage.add_component<AudioEmitter>(entity, engine);
+ *
+ *   // Each frame (the FPS renderer sets the listener from its camera)
+ *   SpatialAudio::get_instance().update(g_storage, deltaTime);
+ */
+class SpatialAudio {
+public:
+    struct Stats {
+        uint32_t emitters = 0;      // Playing emitters seen in the last update
+        uint32_t audible = 0;       // Within range and above the gain threshold
+        uint32_t voiced = 0;        // Holding a mixer voice
+    };
+
+private:
+    static constexpr float SPEED_OF_SOUND = 343.0f;
+    static constexpr float MIN_AUDIBLE_GAIN = 0.001f;
+
+    struct Candidate {
+        AudioEmitter* emitter;
+        float gain;
+        float pan;
+        float pitch;
+    };
+
+    AudioMixer& m_mixer;
+    uint32_t m_voiceBudget;
+    bool m_startDevice;                 // Open the mixer's device the first time a voice is needed
+    float m_dopplerFactor = 1.0f;
+
+    float m_listenerPosition[3] = {0.0f, 0.0f, 0.0f};
+    float m_listenerForward[3] = {0.0f, 0.0f, -1.0f};
+    float m_listenerUp[3] = {0.0f, 1.0f, 0.0f};
+    float m_lastListenerPosition[3] = {0.0f, 0.0f, 0.0f};
+    bool m_hasLastListener = false;
+
+    std::vector<AudioEmitter*> m_emitters;
+    std::vector<Candidate> m_candidates;
+    std::vector<AudioMixer::VoiceHandle> m_ownedVoices;     // Voices started for emitters, sorted
+    std::vector<AudioMixer::VoiceHandle> m_claimedVoices;
+    Stats m_stats;
+
+    static float dot(const float a[3], const float b[3]) {
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    }
+
+    static void normalize(float v[3]) {
+        float length = std::sqrt(dot(v, v));
+        if (length > 1e-6f) {
+            v[0] /= length;
+            v[1] /= length;
+            v[2] /= length;
+        }
+    }
+
+    static float distanceGain(const AudioEmitter& emitter, float distance) {
+        float minDistance = std::max(emitter.minDistance, 1e-3f);
+        float clamped = std::max(distance, minDistance);
+        float gain = minDistance / (minDistance + emitter.rolloff * (clamped - minDistance));
+        float fadeStart = emitter.maxDistance * 0.9f;
+        if (distance > fadeStart) {
+            gain *= std::max(0.0f, (emitter.maxDistance - distance) / (emitter.maxDistance - fadeStart));
+        }
+        return gain * emitter.volume;
+    }
+
+    // Advance a virtual emitter; false once a one-shot has played out
+    static bool advanceVirtual(AudioEmitter& emitter, float pitch, float dt) {
+        double frames = static_cast<double>(emitter.clip->getFrameCount());
+        emitter.cursor += static_cast<double>(emitter.clip->sampleRate) * pitch * dt;      // pitch includes doppler
+        if (emitter.cursor < frames) {
+            return true;
+        }
+        if (!emitter.loop) {
+            return false;
+        }
+        emitter.cursor = std::fmod(emitter.cursor, frames);
+        return true;
+    }
+
+    void devoice(AudioEmitter& emitter) {
+        if (emitter.voice != AudioMixer::INVALID_VOICE) {
+            emitter.cursor = static_cast<double>(m_mixer.getSourcePosition(emitter.voice));
+            m_mixer.stop(emitter.voice, true);
+            emitter.voice = AudioMixer::INVALID_VOICE;
+        }
+    }
+
+    void updateEmitters(float dt) {
+        float right[3] = {
+            m_listenerForward[1] * m_listenerUp[2] - m_listenerForward[2] * m_listenerUp[1],
+            m_listenerForward[2] * m_listenerUp[0] - m_listenerForward[0] * m_listenerUp[2],
+            m_listenerForward[0] * m_listenerUp[1] - m_listenerForward[1] * m_listenerUp[0]};
+        normalize(right);
+        float listenerVelocity[3] = {0.0f, 0.0f, 0.0f};
+        if (m_hasLastListener && dt > 0.0f) {
+            for (int i = 0; i < 3; i++) {
+                listenerVelocity[i] = (m_listenerPosition[i] - m_lastListenerPosition[i]) / dt;
+            }
+        }
+        std::copy(m_listenerPosition, m_listenerPosition + 3, m_lastListenerPosition);
+        m_hasLastListener = true;
+
+        m_candidates.clear();
+        m_claimedVoices.clear();
+        m_stats = Stats{};
+        for (AudioEmitter* emitter : m_emitters) {
+            if (!emitter->playing || !emitter->clip || emitter->clip->getFrameCount() == 0) {
+                if (emitter->voice != AudioMixer::INVALID_VOICE) {
+                    m_mixer.stop(emitter->voice, true);
+                    emitter->voice = AudioMixer::INVALID_VOICE;
+                }
+                emitter->hasLastPosition = false;
+                continue;
+            }
+            m_stats.emitters++;
+
+            // A voiced one-shot that reached its end is done
+            if (emitter->voice != AudioMixer::INVALID_VOICE && !m_mixer.isPlaying(emitter->voice)) {
+                emitter->voice = AudioMixer::INVALID_VOICE;
+                if (!emitter->loop) {
+                    emitter->playing = false;
+                    emitter->cursor = 0.0;
+                    continue;
+                }
+            }
+
+            float position[3] = {emitter->x, emitter->y, emitter->z};
+            float emitterVelocity[3] = {0.0f, 0.0f, 0.0f};
+            if (emitter->hasLastPosition && dt > 0.0f) {
+                emitterVelocity[0] = (emitter->x - emitter->lastX) / dt;
+                emitterVelocity[1] = (emitter->y - emitter->lastY) / dt;
+                emitterVelocity[2] = (emitter->z - emitter->lastZ) / dt;
+            }
+            emitter->lastX = emitter->x;
+            emitter->lastY = emitter->y;
+            emitter->lastZ = emitter->z;
+            emitter->hasLastPosition = true;
+
+            float toEmitter[3] = {position[0] - m_listenerPosition[0], position[1] - m_listenerPosition[1],
+                                  position[2] - m_listenerPosition[2]};
+            float distance = std::sqrt(dot(toEmitter, toEmitter));
+            float gain = distance < emitter->maxDistance ? distanceGain(*emitter, distance) : 0.0f;
+            float pan = 0.0f;
+            float doppler = 1.0f;
+            if (distance > 1e-4f) {
+                for (int i = 0; i < 3; i++) {
+                    toEmitter[i] /= distance;
+                }
+                pan = dot(toEmitter, right);
+                // Clamped both ways: faster than sound would flip the shift's sign or divide by ~0
+                float limit = SPEED_OF_SOUND * 0.5f;
+                float listenerSpeed = std::max(-limit, std::min(dot(listenerVelocity, toEmitter) * m_dopplerFactor, limit));
+                float emitterSpeed = std::max(-limit, std::min(dot(emitterVelocity, toEmitter) * m_dopplerFactor, limit));
+                doppler = (SPEED_OF_SOUND + listenerSpeed) / (SPEED_OF_SOUND + emitterSpeed);
+            }
+            float pitch = emitter->pitch * std::min(2.0f, std::max(0.5f, doppler));
+
+            if (gain < MIN_AUDIBLE_GAIN) {
+                devoice(*emitter);
+                if (!advanceVirtual(*emitter, pitch, dt)) {
+                    emitter->playing = false;
+                    emitter->cursor = 0.0;
+                }
+                continue;
+            }
+            m_candidates.push_back(Candidate{emitter, gain, pan, pitch});
+        }
+        m_stats.audible = static_cast<uint32_t>(m_candidates.size());
+
+        // Loudest (by priority, then gain) first; only the top voiceBudget are voiced
+        size_t voiced = std::min<size_t>(m_candidates.size(), m_voiceBudget);
+        std::partial_sort(m_candidates.begin(), m_candidates.begin() + voiced, m_candidates.end(),
+                          [](const Candidate& a, const Candidate& b) {
+                              if (a.emitter->priority != b.emitter->priority) {
+                                  return a.emitter->priority > b.emitter->priority;
+                              }
+                              return a.gain > b.gain;
+                          });
+
+        for (size_t i = voiced; i < m_candidates.size(); i++) {
+            AudioEmitter& emitter = *m_candidates[i].emitter;
+            devoice(emitter);
+            if (!advanceVirtual(emitter, m_candidates[i].pitch, dt)) {
+                emitter.playing = false;
+                emitter.cursor = 0.0;
+            }
+        }
+        if (voiced > 0 && m_startDevice) {
+            m_startDevice = false;
+            m_mixer.start();
+        }
+        for (size_t i = 0; i < voiced; i++) {
+            const Candidate& candidate = m_candidates[i];
+            AudioEmitter& emitter = *candidate.emitter;
+            VoiceParams params;
+            params.gain = candidate.gain;
+            params.pan = candidate.pan;
+            params.pitch = candidate.pitch;
+            params.loop = emitter.loop;
+            if (emitter.voice != AudioMixer::INVALID_VOICE) {
+                m_mixer.setParams(emitter.voice, params);
+            } else {
+                emitter.voice = m_mixer.play(emitter.clip, params, static_cast<size_t>(emitter.cursor));
+            }
+            if (emitter.voice != AudioMixer::INVALID_VOICE) {
+                m_claimedVoices.push_back(emitter.voice);
+                m_stats.voiced++;
+            }
+        }
+
+        // Voices whose emitters were destroyed or removed since the last update
+        std::sort(m_claimedVoices.begin(), m_claimedVoices.end());
+        for (AudioMixer::VoiceHandle voice : m_ownedVoices) {
+            if (!std::binary_search(m_claimedVoices.begin(), m_claimedVoices.end(), voice)) {
+                m_mixer.stop(voice, true);
+            }
+        }
+        m_ownedVoices.swap(m_claimedVoices);
+    }
+
+public:
+    /**
+     * @param voiceBudget Voices emitters may hold at once (leave room for 2D sounds and music)
+     * @param startDevice Call mixer.start() when the first emitter becomes audible (false for
+     *                    offline mixers driven by render())
+     */
+    explicit SpatialAudio(AudioMixer& mixer, uint32_t voiceBudget = 32, bool startDevice = false)
+        : m_mixer(mixer), m_voiceBudget(std::min(voiceBudget, mixer.getMaxVoices())), m_startDevice(startDevice) {}
+
+    SpatialAudio(const SpatialAudio&) = delete;
+    SpatialAudio& operator=(const SpatialAudio&) = delete;
+
+    /**
+     * Get the spatial audio system on the device mixer
+     */
+    static SpatialAudio& get_instance() {
+        static SpatialAudio* instance = new SpatialAudio(AudioMixer::get_instance(), 32, true);
+        return *instance;
+    }
+
+    /**
+     * Set the listener pose (normally the camera). Velocity for doppler comes from the
+     * position change between updates.
+     */
+    void setListener(const float position[3], const float forward[3], const float up[3]) {
+        std::copy(position, position + 3, m_listenerPosition);
+        std::copy(forward, forward + 3, m_listenerForward);
+        std::copy(up, up + 3, m_listenerUp);
+        normalize(m_listenerForward);
+        normalize(m_listenerUp);
+    }
+
+    /**
+     * Update every AudioEmitter component in the storage
+     * @param dt Seconds since the last update
+     */
+    void update(EntityStorage& storage, float dt) {
+        m_emitters.clear();
+        storage.for_each<AudioEmitter>([this](EntityId, AudioEmitter& emitter) { m_emitters.push_back(&emitter); });
+        updateEmitters(dt);
+    }
+
+    /**
+     * Update emitters kept outside the ECS
+     */
+    void update(AudioEmitter* emitters, size_t count, float dt) {
+        m_emitters.clear();
+        for (size_t i = 0; i < count; i++) {
+            m_emitters.push_back(&emitters[i]);
+        }
+        updateEmitters(dt);
+    }
+
+    void setVoiceBudget(uint32_t budget) { m_voiceBudget = std::min(budget, m_mixer.getMaxVoices()); }
+    void setDopplerFactor(float factor) { m_dopplerFactor = factor; }
+
+    uint32_t getVoiceBudget() const { return m_voiceBudget; }
+    const Stats& getStats() const { return m_stats; }
+};
+
+#endif // EDEN_SPATIAL_AUDIO_H
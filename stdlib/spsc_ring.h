@@ -0,0 +1,107 @@
+// EDEN ENGINE - SpscRing
+// Lock-free single-producer / single-consumer ring buffer
+// Used between a decoder thread and the audio callback: neither side ever blocks or allocates.
+
+#ifndef EDEN_SPSC_RING_H
+#define EDEN_SPSC_RING_H
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+
+/**
+ * SpscRing - Fixed-capacity FIFO of trivially copyable elements for exactly one writer thread
+ * and one reader thread
+ *
+ * Head and tail are free-running counters (capacity is a power of two), each written by only
+ * one side, with release/acquire ordering so the reader never sees a slot before its data.
+ *
+ * Usage:
+ *   SpscRing<int16_t> ring(48000);
+ *   ring.write(samples, count);            // Producer thread
+ *   size_t got = ring.read(out, wanted);   // Consumer thread (e.g. audio callback)
+ */
+template <typename T>
+class SpscRing {
+    static_assert(std::is_trivially_copyable<T>::value, "SpscRing elements are copied with memcpy");
+
+private:
+    std::unique_ptr<T[]> m_buffer;
+    size_t m_capacity = 0;
+    size_t m_mask = 0;
+    alignas(64) std::atomic<size_t> m_head{0};     // Next element the producer writes
+    alignas(64) std::atomic<size_t> m_tail{0};     // Next element the consumer reads
+
+public:
+    /**
+     * @param capacity Minimum element count (rounded up to a power of two)
+     */
+    explicit SpscRing(size_t capacity) {
+        m_capacity = 1;
+        while (m_capacity < capacity) {
+            m_capacity <<= 1;
+        }
+        m_mask = m_capacity - 1;
+        m_buffer.reset(new T[m_capacity]);
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    /**
+     * Producer: append up to `count` elements
+     * @return Elements written (less than count when the ring is full)
+     */
+    size_t write(const T* data, size_t count) {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        size_t tail = m_tail.load(std::memory_order_acquire);
+        count = std::min(count, m_capacity - (head - tail));
+        size_t start = head & m_mask;
+        size_t first = std::min(count, m_capacity - start);
+        memcpy(m_buffer.get() + start, data, first * sizeof(T));
+        memcpy(m_buffer.get(), data + first, (count - first) * sizeof(T));
+        m_head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    /**
+     * Consumer: take up to `count` elements
+     * @return Elements read (less than count when the ring runs dry)
+     */
+    size_t read(T* out, size_t count) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        size_t head = m_head.load(std::memory_order_acquire);
+        count = std::min(count, head - tail);
+        size_t start = tail & m_mask;
+        size_t first = std::min(count, m_capacity - start);
+        memcpy(out, m_buffer.get() + start, first * sizeof(T));
+        memcpy(out + first, m_buffer.get(), (count - first) * sizeof(T));
+        m_tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    // Elements the consumer can read now
+    size_t readAvailable() const {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_relaxed);
+    }
+
+    // Elements the producer can write now
+    size_t writeAvailable() const {
+        return m_capacity - (m_head.load(std::memory_order_relaxed) - m_tail.load(std::memory_order_acquire));
+    }
+
+    /**
+     * Empty the ring. Only while neither the producer nor the consumer is running.
+     */
+    void reset() {
+        m_head.store(0, std::memory_order_relaxed);
+        m_tail.store(0, std::memory_order_relaxed);
+    }
+
+    size_t getCapacity() const { return m_capacity; }
+};
+
+#endif // EDEN_SPSC_RING_H
@@ -0,0 +1,132 @@
+// EDEN ENGINE - StagingRing
+// Ring allocator over a persistently mapped staging buffer
+// Regions are tagged with the submission that reads them and recycled once that submission's
+// fence has signalled. Pure bookkeeping (no Vulkan calls), so it can be exercised CPU-side.
+
+#ifndef EDEN_STAGING_RING_H
+#define EDEN_STAGING_RING_H
+
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+
+/**
+ * StagingRing - FIFO sub-allocation of [0, capacity)
+ *
+ * Allocations are handed out front-to-back and wrap to offset 0 when the end is reached
+ * (the skipped tail is charged to the current batch so it is reclaimed with it).
+ * submit() closes the current batch under a submission id; release() frees every batch whose
+ * submission has completed. Submission ids must increase monotonically.
+ *
+ * Usage:
+ *   StagingRing ring(32ull * 1024 * 1024);
+ *   uint64_t offset = ring.allocate(size, 16);
+ *   if (offset == StagingRing::INVALID_OFFSET) { ...wait for the oldest submission, release(), retry }
+ *   ring.submit(submissionId);
+ *   ring.release(completedSubmissionId);
+ */
+class StagingRing {
+public:
+    static constexpr uint64_t INVALID_OFFSET = UINT64_MAX;
+
+private:
+    struct Batch {
+        uint64_t submission;
+        uint64_t end;       // Head position when the batch was submitted
+        uint64_t bytes;     // Bytes charged to the batch (data, alignment padding, wrap waste)
+    };
+
+    uint64_t m_capacity = 0;
+    uint64_t m_head = 0;            // Next free byte
+    uint64_t m_tail = 0;            // Oldest byte still in use
+    uint64_t m_used = 0;            // Bytes in use (open batch + in-flight batches)
+    uint64_t m_openBytes = 0;       // Bytes charged to the batch being recorded
+    std::deque<Batch> m_inFlight;
+
+public:
+    explicit StagingRing(uint64_t capacity = 0) : m_capacity(capacity) {}
+
+    /**
+     * Allocate a contiguous region
+     * @param alignment Power of two (buffer-image copies need 4, or the texel block size)
+     * @return Offset, or INVALID_OFFSET if the ring is currently too full (or size > capacity)
+     */
+    uint64_t allocate(uint64_t size, uint64_t alignment) {
+        if (size == 0 || size > m_capacity) {
+            return INVALID_OFFSET;
+        }
+        if (alignment == 0) {
+            alignment = 1;
+        }
+        if (m_used == 0) {
+            m_head = 0;
+            m_tail = 0;
+        }
+
+        uint64_t aligned = (m_head + alignment - 1) & ~(alignment - 1);
+        uint64_t charged;
+
+        if (m_used == 0 || m_head > m_tail) {
+            // Free space is [head, capacity) followed by [0, tail)
+            if (aligned + size <= m_capacity) {
+                charged = aligned + size - m_head;
+            } else if (size <= m_tail) {
+                charged = (m_capacity - m_head) + size;     // Skip the tail end and wrap
+                aligned = 0;
+            } else {
+                return INVALID_OFFSET;
+            }
+        } else {
+            // head <= tail with data in flight: free space is [head, tail)
+            if (aligned + size <= m_tail) {
+                charged = aligned + size - m_head;
+            } else {
+                return INVALID_OFFSET;
+            }
+        }
+
+        m_head = aligned + size;
+        if (m_head == m_capacity) {
+            m_head = 0;
+        }
+        m_used += charged;
+        m_openBytes += charged;
+        return aligned;
+    }
+
+    /**
+     * Close the current batch; its regions stay reserved until release(submission)
+     */
+    void submit(uint64_t submission) {
+        if (m_openBytes == 0) {
+            return;
+        }
+        m_inFlight.push_back({submission, m_head, m_openBytes});
+        m_openBytes = 0;
+    }
+
+    /**
+     * Recycle every batch whose submission id is <= completed
+     */
+    void release(uint64_t completed) {
+        while (!m_inFlight.empty() && m_inFlight.front().submission <= completed) {
+            m_tail = m_inFlight.front().end;
+            m_used -= m_inFlight.front().bytes;
+            m_inFlight.pop_front();
+        }
+    }
+
+    /**
+     * Oldest submission still holding ring space (0 if none)
+     */
+    uint64_t getOldestSubmission() const {
+        return m_inFlight.empty() ? 0 : m_inFlight.front().submission;
+    }
+
+    uint64_t getCapacity() const { return m_capacity; }
+    uint64_t getUsedBytes() const { return m_used; }
+    uint64_t getOpenBytes() const { return m_openBytes; }
+    size_t getInFlightCount() const { return m_inFlight.size(); }
+};
+
+#endif // EDEN_STAGING_RING_H
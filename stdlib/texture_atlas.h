@@ -0,0 +1,453 @@
+// EDEN ENGINE - TextureAtlas
+// Packs many small RGBA8 images (UI sprites, icons, font sheets) into the layers of one 2D array
+// texture: one image, one view, one sampler and one descriptor instead of one set per texture.
+// Placement is done by AtlasPacker; this owns the Vulkan objects and a CPU copy of every layer.
+
+#ifndef EDEN_TEXTURE_ATLAS_H
+#define EDEN_TEXTURE_ATLAS_H
+
+#include "vulkan.h"
+#include "atlas_packer.h"
+#include "image_decoder.h"
+#include "gpu_allocator.h"
+#include "upload_queue.h"
+#include <vector>
+#include <string>
+#include <deque>
+#include <unordered_map>
+#include <cstring>
+#include <stdexcept>
+
+extern VkDevice g_device;
+
+using AtlasHandle = uint32_t;
+static constexpr AtlasHandle INVALID_ATLAS_HANDLE = UINT32_MAX;
+
+// Where an entry lives: array layer plus normalized UV rectangle (sample with vec3(uv, layer))
+struct AtlasRegion {
+    uint32_t layer = 0;
+    float u0 = 0.0f;
+    float v0 = 0.0f;
+    float u1 = 0.0f;
+    float v1 = 0.0f;
+};
+
+/**
+ * TextureAtlas - Texture array of packed small images behind stable handles
+ *
+ * add() places an image and copies it (with its edge texels extruded into the padding, so linear
+ * filtering does not bleed) into the CPU copy of its layer. update(), once per frame before the
+ * uploads are flushed, builds a new array image from the layers when anything changed and retires
+ * the old one after a few frames, so frames in flight never see a half-written layer.
+ * Handles stay valid across defragment(); their regions move, so re-read them when update()
+ * returns true (it also means the view changed: rewrite the descriptor).
+ *
+ * Usage:
+ *   TextureAtlas atlas(1024);
+ *   AtlasHandle icon = atlas.addFromFile("ui/icons/save.png");
+ *   if (atlas.update()) { ... write atlas.getDescriptorImageInfo() to the UI descriptor set ... }
+ *   AtlasRegion region;
+ *   atlas.getRegion(icon, region);   // uv0/uv1 and layer for the quad
+ */
+class TextureAtlas {
+public:
+    struct Stats {
+        uint32_t entryCount = 0;
+        uint32_t layerCount = 0;
+        float occupancy = 0.0f;
+        uint64_t rebuilds = 0;          // Times the GPU image was rebuilt by update()
+        uint64_t defragmentations = 0;
+    };
+
+private:
+    struct Entry {
+        AtlasRect rect;                 // Padded rectangle in the packer
+        std::string path;               // Source file (addFromFile), for de-duplication
+        uint32_t refCount = 0;          // 0 = free slot
+    };
+
+    struct Retired {
+        uint64_t frame;
+        VkImage image;
+        VkImageView view;
+        GpuAllocation memory;
+    };
+
+    static constexpr uint32_t RETIRE_FRAMES = 3;    // Frames a replaced image may still be in use
+
+    AtlasPacker m_packer;
+    uint32_t m_layerSize;
+    uint32_t m_padding;
+    VkFormat m_format;
+
+    std::vector<std::vector<uint8_t>> m_layers;    // RGBA8 CPU copy of every layer
+    std::vector<Entry> m_entries;
+    std::vector<AtlasHandle> m_freeHandles;
+    std::unordered_map<std::string, AtlasHandle> m_byPath;
+    bool m_dirty = false;
+
+    VkImage m_image = VK_NULL_HANDLE;
+    VkImageView m_imageView = VK_NULL_HANDLE;
+    VkSampler m_sampler = VK_NULL_HANDLE;
+    GpuAllocation m_imageMemory;
+    uint32_t m_imageLayers = 0;
+    std::deque<Retired> m_retired;
+    uint64_t m_frame = 0;
+    uint32_t m_generation = 0;
+    Stats m_stats;
+
+    size_t layerBytes() const { return static_cast<size_t>(m_layerSize) * m_layerSize * 4; }
+
+    void ensureLayers() {
+        while (m_layers.size() < m_packer.getLayerCount()) {
+            m_layers.emplace_back(layerBytes(), 0);
+        }
+    }
+
+    // Copy an image into its padded rectangle, extruding the border texels into the padding
+    void blit(const AtlasRect& rect, const uint8_t* rgba, uint32_t width, uint32_t height) {
+        uint8_t* layer = m_layers[rect.layer].data();
+        for (uint32_t y = 0; y < rect.height; y++) {
+            uint32_t srcY = std::min(height - 1, y > m_padding ? y - m_padding : 0);
+            const uint8_t* srcRow = rgba + static_cast<size_t>(srcY) * width * 4;
+            uint8_t* dstRow = layer + (static_cast<size_t>(rect.y + y) * m_layerSize + rect.x) * 4;
+            for (uint32_t x = 0; x < m_padding; x++) {
+                memcpy(dstRow + x * 4, srcRow, 4);
+                memcpy(dstRow + (m_padding + width + x) * 4, srcRow + (width - 1) * 4, 4);
+            }
+            memcpy(dstRow + m_padding * 4, srcRow, static_cast<size_t>(width) * 4);
+        }
+    }
+
+    // Move a padded rectangle's texels between layer copies (defragmentation)
+    static void copyRect(const std::vector<std::vector<uint8_t>>& src, const AtlasRect& from,
+                         std::vector<std::vector<uint8_t>>& dst, const AtlasRect& to, uint32_t layerSize) {
+        for (uint32_t y = 0; y < from.height; y++) {
+            memcpy(dst[to.layer].data() + (static_cast<size_t>(to.y + y) * layerSize + to.x) * 4,
+                   src[from.layer].data() + (static_cast<size_t>(from.y + y) * layerSize + from.x) * 4,
+                   static_cast<size_t>(from.width) * 4);
+        }
+    }
+
+    void destroyRetired(bool all) {
+        while (!m_retired.empty() && (all || m_frame - m_retired.front().frame > RETIRE_FRAMES)) {
+            Retired& retired = m_retired.front();
+            vkDestroyImageView(g_device, retired.view, nullptr);
+            vkDestroyImage(g_device, retired.image, nullptr);
+            GpuAllocator::get_instance().free(retired.memory);
+            m_retired.pop_front();
+        }
+    }
+
+    void createSampler() {
+        VkSamplerCreateInfo samplerInfo = {};
+        samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter = VK_FILTER_LINEAR;
+        samplerInfo.minFilter = VK_FILTER_LINEAR;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.anisotropyEnable = VK_FALSE;
+        samplerInfo.maxAnisotropy = 1.0f;
+        samplerInfo.borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
+        samplerInfo.unnormalizedCoordinates = VK_FALSE;
+        samplerInfo.compareEnable = VK_FALSE;
+        samplerInfo.compareOp = VK_COMPARE_OP_ALWAYS;
+        samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.minLod = 0.0f;
+        samplerInfo.maxLod = 0.0f;     // Single level: sprites are drawn near 1:1
+        if (vkCreateSampler(g_device, &samplerInfo, nullptr, &m_sampler) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create atlas sampler");
+        }
+    }
+
+    // Build a new array image holding every layer and queue its upload
+    void rebuildImage() {
+        ensureLayers();
+        if (m_layers.empty()) {
+            m_layers.emplace_back(layerBytes(), 0);     // Keep a valid (blank) view while empty
+        }
+        uint32_t layerCount = static_cast<uint32_t>(m_layers.size());
+
+        VkImageCreateInfo imageInfo = {};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.extent.width = m_layerSize;
+        imageInfo.extent.height = m_layerSize;
+        imageInfo.extent.depth = 1;
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = layerCount;
+        imageInfo.format = m_format;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        VkImage image;
+        GpuAllocation memory;
+        if (!GpuAllocator::get_instance().createImage(imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, image, memory)) {
+            throw std::runtime_error("Failed to create atlas image");
+        }
+
+        VkImageViewCreateInfo viewInfo = {};
+        viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image = image;
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+        viewInfo.format = m_format;
+        viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        viewInfo.subresourceRange.baseMipLevel = 0;
+        viewInfo.subresourceRange.levelCount = 1;
+        viewInfo.subresourceRange.baseArrayLayer = 0;
+        viewInfo.subresourceRange.layerCount = layerCount;
+        VkImageView view;
+        if (vkCreateImageView(g_device, &viewInfo, nullptr, &view) != VK_SUCCESS) {
+            vkDestroyImage(g_device, image, nullptr);
+            GpuAllocator::get_instance().free(memory);
+            throw std::runtime_error("Failed to create atlas image view");
+        }
+
+        // One staging copy of all layers, one region per layer
+        std::vector<uint8_t> pixels(layerBytes() * layerCount);
+        std::vector<VkBufferImageCopy> regions(layerCount);
+        for (uint32_t layer = 0; layer < layerCount; layer++) {
+            memcpy(pixels.data() + layerBytes() * layer, m_layers[layer].data(), layerBytes());
+            VkBufferImageCopy& region = regions[layer];
+            region = {};
+            region.bufferOffset = layerBytes() * layer;
+            region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            region.imageSubresource.mipLevel = 0;
+            region.imageSubresource.baseArrayLayer = layer;
+            region.imageSubresource.layerCount = 1;
+            region.imageOffset = {0, 0, 0};
+            region.imageExtent = {m_layerSize, m_layerSize, 1};
+        }
+        UploadQueue::get_instance().uploadImage(image, pixels.data(), pixels.size(), regions, 1, layerCount);
+
+        if (m_image != VK_NULL_HANDLE) {
+            m_retired.push_back(Retired{m_frame, m_image, m_imageView, m_imageMemory});
+        }
+        m_image = image;
+        m_imageView = view;
+        m_imageMemory = memory;
+        m_imageLayers = layerCount;
+        m_generation++;
+        m_stats.rebuilds++;
+    }
+
+public:
+    /**
+     * @param layerSize Width and height of each array layer in texels
+     * @param padding   Texels of extruded border around each entry (1 is enough for linear filtering)
+     * @param format    VK_FORMAT_R8G8B8A8_SRGB for color art, _UNORM for data (must be 4 bytes/texel)
+     * @param maxLayers Array layers the atlas may grow to
+     */
+    explicit TextureAtlas(uint32_t layerSize = 1024, uint32_t padding = 1,
+                          VkFormat format = VK_FORMAT_R8G8B8A8_SRGB, uint32_t maxLayers = 64)
+        : m_packer(layerSize, layerSize, maxLayers), m_layerSize(layerSize), m_padding(padding), m_format(format) {}
+
+    ~TextureAtlas() {
+        cleanup();
+    }
+
+    TextureAtlas(const TextureAtlas&) = delete;
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+    /**
+     * Destroy the Vulkan objects (before the device; entries and CPU layers are kept)
+     */
+    void cleanup() {
+        if (g_device == VK_NULL_HANDLE) {
+            return;
+        }
+        UploadQueue::get_instance().waitIdle();
+        destroyRetired(true);
+        if (m_imageView != VK_NULL_HANDLE) {
+            vkDestroyImageView(g_device, m_imageView, nullptr);
+            m_imageView = VK_NULL_HANDLE;
+        }
+        if (m_image != VK_NULL_HANDLE) {
+            vkDestroyImage(g_device, m_image, nullptr);
+            m_image = VK_NULL_HANDLE;
+        }
+        GpuAllocator::get_instance().free(m_imageMemory);
+        if (m_sampler != VK_NULL_HANDLE) {
+            vkDestroySampler(g_device, m_sampler, nullptr);
+            m_sampler = VK_NULL_HANDLE;
+        }
+        m_imageLayers = 0;
+        m_dirty = !m_entries.empty();
+    }
+
+    /**
+     * Pack an RGBA8 image (tightly packed rows)
+     * @return Handle, or INVALID_ATLAS_HANDLE if it is larger than a layer or the atlas is full
+     *         (even after defragmenting)
+     */
+    AtlasHandle add(const uint8_t* rgba, uint32_t width, uint32_t height) {
+        if (!rgba || width == 0 || height == 0) {
+            return INVALID_ATLAS_HANDLE;
+        }
+        AtlasRect rect;
+        uint32_t paddedWidth = width + 2 * m_padding;
+        uint32_t paddedHeight = height + 2 * m_padding;
+        if (!m_packer.insert(paddedWidth, paddedHeight, rect)) {
+            // Holes left by removals may add up to enough space
+            if (!defragment() || !m_packer.insert(paddedWidth, paddedHeight, rect)) {
+                return INVALID_ATLAS_HANDLE;
+            }
+        }
+        ensureLayers();
+        blit(rect, rgba, width, height);
+
+        AtlasHandle handle;
+        if (!m_freeHandles.empty()) {
+            handle = m_freeHandles.back();
+            m_freeHandles.pop_back();
+        } else {
+            handle = static_cast<AtlasHandle>(m_entries.size());
+            m_entries.emplace_back();
+        }
+        m_entries[handle] = Entry();
+        m_entries[handle].rect = rect;
+        m_entries[handle].refCount = 1;
+        m_stats.entryCount++;
+        m_dirty = true;
+        return handle;
+    }
+
+    /**
+     * Pack an image file (PNG / JPEG / BMP). Adding the same path again returns the same handle
+     * (reference counted; remove() it as many times).
+     */
+    AtlasHandle addFromFile(const std::string& path) {
+        auto it = m_byPath.find(path);
+        if (it != m_byPath.end()) {
+            m_entries[it->second].refCount++;
+            return it->second;
+        }
+        ImageInfo info;
+        std::vector<uint8_t> pixels;
+        try {
+            pixels = load_image_rgba8(path, info);
+        } catch (const std::exception& e) {
+            return INVALID_ATLAS_HANDLE;
+        }
+        AtlasHandle handle = add(pixels.data(), info.width, info.height);
+        if (handle != INVALID_ATLAS_HANDLE) {
+            m_entries[handle].path = path;
+            m_byPath[path] = handle;
+        }
+        return handle;
+    }
+
+    void remove(AtlasHandle handle) {
+        if (handle >= m_entries.size() || m_entries[handle].refCount == 0) {
+            return;
+        }
+        Entry& entry = m_entries[handle];
+        if (--entry.refCount > 0) {
+            return;
+        }
+        m_packer.remove(entry.rect);
+        if (!entry.path.empty()) {
+            m_byPath.erase(entry.path);
+        }
+        entry = Entry();
+        m_freeHandles.push_back(handle);
+        m_stats.entryCount--;
+        // Texels stay in the layer copy until overwritten; nothing samples them
+    }
+
+    /**
+     * Repack every live entry from scratch (tallest first) into as few layers as possible.
+     * Regions change; the GPU image is rebuilt by the next update().
+     * @return false if the entries do not fit (they are then left where they were)
+     */
+    bool defragment() {
+        std::vector<AtlasHandle> live;
+        std::vector<std::pair<uint32_t, uint32_t>> sizes;
+        for (AtlasHandle handle = 0; handle < m_entries.size(); handle++) {
+            if (m_entries[handle].refCount > 0) {
+                live.push_back(handle);
+                sizes.push_back({m_entries[handle].rect.width, m_entries[handle].rect.height});
+            }
+        }
+
+        std::vector<AtlasRect> placed;
+        if (!m_packer.repack(sizes, placed)) {
+            return false;
+        }
+
+        std::vector<std::vector<uint8_t>> layers(m_packer.getLayerCount(), std::vector<uint8_t>(layerBytes(), 0));
+        for (size_t i = 0; i < live.size(); i++) {
+            copyRect(m_layers, m_entries[live[i]].rect, layers, placed[i], m_layerSize);
+            m_entries[live[i]].rect = placed[i];
+        }
+        m_layers = std::move(layers);
+        m_stats.defragmentations++;
+        m_dirty = true;
+        return true;
+    }
+
+    /**
+     * Once per frame, before the frame's uploads are flushed: rebuild the GPU image if entries
+     * were added or moved, and destroy images retired a few frames ago.
+     * @return true if the image view changed (rewrite descriptors, re-read regions)
+     */
+    bool update() {
+        m_frame++;
+        destroyRetired(false);
+        if (!m_dirty || g_device == VK_NULL_HANDLE) {
+            return false;
+        }
+        if (m_sampler == VK_NULL_HANDLE) {
+            createSampler();
+        }
+        m_packer.trimLayers();
+        m_layers.resize(std::min<size_t>(m_layers.size(), std::max(1u, m_packer.getLayerCount())));
+        rebuildImage();
+        m_dirty = false;
+        return true;
+    }
+
+    /**
+     * Layer and UV rectangle of an entry (inside its padding)
+     */
+    bool getRegion(AtlasHandle handle, AtlasRegion& region) const {
+        if (handle >= m_entries.size() || m_entries[handle].refCount == 0) {
+            return false;
+        }
+        const AtlasRect& rect = m_entries[handle].rect;
+        float scale = 1.0f / static_cast<float>(m_layerSize);
+        region.layer = rect.layer;
+        region.u0 = (rect.x + m_padding) * scale;
+        region.v0 = (rect.y + m_padding) * scale;
+        region.u1 = (rect.x + rect.width - m_padding) * scale;
+        region.v1 = (rect.y + rect.height - m_padding) * scale;
+        return true;
+    }
+
+    VkImageView getImageView() const { return m_imageView; }
+    VkSampler getSampler() const { return m_sampler; }
+    uint32_t getLayerCount() const { return m_imageLayers; }
+    uint32_t getLayerSize() const { return m_layerSize; }
+    uint32_t getGeneration() const { return m_generation; }
+
+    VkDescriptorImageInfo getDescriptorImageInfo() const {
+        VkDescriptorImageInfo imageInfo = {};
+        imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        imageInfo.imageView = m_imageView;
+        imageInfo.sampler = m_sampler;
+        return imageInfo;
+    }
+
+    Stats getStats() const {
+        Stats stats = m_stats;
+        stats.layerCount = m_packer.getLayerCount();
+        stats.occupancy = m_packer.getOccupancy();
+        return stats;
+    }
+};
+
+#endif // EDEN_TEXTURE_ATLAS_H
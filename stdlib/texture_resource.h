@@ -1,5 +1,5 @@
 // EDEN ENGINE - TextureResource Class
-// Unified texture loading: automatically handles DDS (compressed) and PNG (uncompressed)
+// Unified texture loading: automatically handles DDS / KTX2 (GPU-ready) and PNG (source)
 // Creates Vulkan resources (image, view, sampler) ready for use in shaders
 
 #ifndef EDEN_TEXTURE_RESOURCE_H
@@ -7,7 +7,13 @@
 
 #include "vulkan.h"
 #include "dds_loader.h"
+#include "ktx2_loader.h"
 #include "png_loader.h"
+#include "bc_encoder.h"
+#include "residency_manager.h"
+#include "gpu_allocator.h"
+#include "upload_queue.h"
+#include "texture_streamer.h"
 #include <vector>
 #include <string>
 #include <algorithm>
@@ -24,105 +30,60 @@ extern VkQueue g_graphicsQueue;
 /**
  * TextureResource - Unified texture loading and Vulkan resource management
  * 
- * Automatically detects format (DDS vs PNG) and creates appropriate Vulkan resources.
- * Handles both compressed (DDS) and uncompressed (PNG) textures seamlessly.
+ * Automatically detects format (DDS, KTX2 or PNG) and creates appropriate Vulkan resources.
+ * Handles both GPU-ready (DDS, KTX2 with optional zstd) and source (PNG) textures seamlessly.
+ * Registered with the ResidencyManager: under memory pressure it may drop top mips or be
+ * evicted, and is reloaded from its path by ensureResident().
+ * GPU-ready textures (DDS, KTX2, cached PNG transcodes) are also streamed by the TextureStreamer:
+ * they load with only the mip tail resident and gain finer levels, smallest first, up to the
+ * level requested with requestLevel() / requestScreenSize() (full resolution by default).
  */
-class TextureResource {
+class TextureResource : public ResidentAsset, public StreamedAsset {
 private:
+    std::string m_path;
+    
     VkImage m_image = VK_NULL_HANDLE;
     VkImageView m_imageView = VK_NULL_HANDLE;
     VkSampler m_sampler = VK_NULL_HANDLE;
-    VkDeviceMemory m_imageMemory = VK_NULL_HANDLE;
+    GpuAllocation m_imageMemory;
     
     VkFormat m_format = VK_FORMAT_UNDEFINED;
     uint32_t m_width = 0;
     uint32_t m_height = 0;
     uint32_t m_mipmapCount = 1;
+    VkDeviceSize m_memorySize = 0;  // Device memory backing the image (for cache/budget accounting)
+    uint32_t m_skipMips = 0;        // Top mip levels dropped by the ResidencyManager (block-compressed only)
+    uint32_t m_generation = 0;      // Bumped whenever the Vulkan handles are recreated
+    uint32_t m_observedGeneration = 0;
     
     bool m_loaded = false;
+    ResidencyHandle m_residency = INVALID_RESIDENCY_HANDLE;
+    uint64_t m_uploadId = 0;        // UploadQueue submission that fills the image
     
-    // Helper function to find memory type (same as in vulkan helpers)
-    uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
-        VkPhysicalDeviceMemoryProperties memProperties;
-        vkGetPhysicalDeviceMemoryProperties(g_physicalDevice, &memProperties);
-        
-        for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
-            if ((typeFilter & (1 << i)) && 
-                (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
-                return i;
-            }
-        }
-        
-        return UINT32_MAX;
-    }
+    // Streaming state (GPU-ready sources only)
+    std::string m_sourcePath;       // DDS/KTX2 the levels are read from (empty = not streamable)
+    uint32_t m_sourceWidth = 0;     // Level 0 size and level count of the source
+    uint32_t m_sourceHeight = 0;
+    uint32_t m_sourceLevels = 1;
+    uint32_t m_residentLevel = UINT32_MAX;  // Finest source level the view exposes (UINT32_MAX = load from the tail)
+    StreamHandle m_stream = INVALID_STREAM_HANDLE;
     
-    // Helper to begin single-time command buffer
-    VkCommandBuffer beginSingleTimeCommands() {
-        VkCommandBufferAllocateInfo allocInfo = {};
-        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-        allocInfo.commandPool = g_commandPool;
-        allocInfo.commandBufferCount = 1;
-        
-        VkCommandBuffer commandBuffer;
-        vkAllocateCommandBuffers(g_device, &allocInfo, &commandBuffer);
-        
-        VkCommandBufferBeginInfo beginInfo = {};
-        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-        
-        vkBeginCommandBuffer(commandBuffer, &beginInfo);
-        return commandBuffer;
-    }
+    // A level upload in flight; it becomes visible once the upload has completed
+    struct PendingLevel {
+        uint32_t level = UINT32_MAX;    // UINT32_MAX = nothing pending
+        uint64_t uploadId = 0;
+        uint32_t top = 0;               // Top source level of `image`
+        VkImage image = VK_NULL_HANDLE; // Larger replacement image (null = uploaded into m_image)
+        GpuAllocation memory;
+    };
+    PendingLevel m_pending;
     
-    // Helper to end single-time command buffer
-    void endSingleTimeCommands(VkCommandBuffer commandBuffer) {
-        vkEndCommandBuffer(commandBuffer);
-        
-        VkSubmitInfo submitInfo = {};
-        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        submitInfo.commandBufferCount = 1;
-        submitInfo.pCommandBuffers = &commandBuffer;
-        
-        vkQueueSubmit(g_graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
-        vkQueueWaitIdle(g_graphicsQueue);
-        
-        vkFreeCommandBuffers(g_device, g_commandPool, 1, &commandBuffer);
-    }
-    
-    // Create buffer helper (for staging)
-    void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, 
-                     VkMemoryPropertyFlags properties, VkBuffer& buffer, 
-                     VkDeviceMemory& bufferMemory) {
-        VkBufferCreateInfo bufferInfo = {};
-        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-        bufferInfo.size = size;
-        bufferInfo.usage = usage;
-        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-        
-        if (vkCreateBuffer(g_device, &bufferInfo, nullptr, &buffer) != VK_SUCCESS) {
-            throw std::runtime_error("Failed to create buffer");
-        }
-        
-        VkMemoryRequirements memRequirements;
-        vkGetBufferMemoryRequirements(g_device, buffer, &memRequirements);
-        
-        VkMemoryAllocateInfo allocInfo = {};
-        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        allocInfo.allocationSize = memRequirements.size;
-        allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, properties);
-        
-        if (allocInfo.memoryTypeIndex == UINT32_MAX) {
-            vkDestroyBuffer(g_device, buffer, nullptr);
-            throw std::runtime_error("Failed to find suitable memory type for buffer");
-        }
-        
-        if (vkAllocateMemory(g_device, &allocInfo, nullptr, &bufferMemory) != VK_SUCCESS) {
-            vkDestroyBuffer(g_device, buffer, nullptr);
-            throw std::runtime_error("Failed to allocate buffer memory");
-        }
-        
-        vkBindBufferMemory(g_device, buffer, bufferMemory, 0);
+    static const uint32_t STREAM_TAIL_SIZE = 128;   // Levels up to this size load up front
+    
+    bool isKTX2(const std::string& filepath) {
+        std::string lowerPath = filepath;
+        std::transform(lowerPath.begin(), lowerPath.end(), lowerPath.begin(), ::tolower);
+        return lowerPath.length() >= 5 && lowerPath.substr(lowerPath.length() - 5) == ".ktx2";
     }
     
     // Detect file format from extension or magic number
@@ -140,36 +101,85 @@ private:
         return false;
     }
     
-    // Load DDS texture and create Vulkan resources
-    void loadDDS(const std::string& filepath) {
-        // Check if file exists first for better error message
-        std::ifstream testFile(filepath, std::ios::binary);
-        if (!testFile.is_open()) {
-            throw std::runtime_error("DDS file not found or cannot open: " + filepath + 
-                                    " (check path is relative to executable or use absolute path)");
+    // Open a GPU-ready source (DDS or KTX2): read format, size and level count, no pixel data
+    void openSource(const std::string& filepath) {
+        if (isKTX2(filepath)) {
+            KTX2Reader reader(filepath);
+            const KTX2Info& info = reader.getInfo();
+            if (info.layerCount != 1 || info.faceCount != 1) {
+                throw std::runtime_error("KTX2 arrays and cubemaps are not supported by TextureResource: " + filepath);
+            }
+            m_format = static_cast<VkFormat>(info.vkFormat);
+            for (const KTX2Level& level : info.levels) {
+                // Mip regions are laid out with calculateMipmapSize (BC blocks or 4-byte texels)
+                if (level.uncompressedByteLength != calculateMipmapSize(level.width, level.height, m_format)) {
+                    throw std::runtime_error("Unsupported KTX2 format " + std::to_string(info.vkFormat) + ": " + filepath);
+                }
+            }
+            m_sourceWidth = info.width;
+            m_sourceHeight = info.height;
+            m_sourceLevels = info.levelCount;
+        } else {
+            // Check if file exists first for better error message
+            std::ifstream testFile(filepath, std::ios::binary);
+            if (!testFile.is_open()) {
+                throw std::runtime_error("DDS file not found or cannot open: " + filepath + 
+                                        " (check path is relative to executable or use absolute path)");
+            }
+            testFile.close();
+            
+            DDSData header = load_dds_header(filepath);
+            if (header.format == VK_FORMAT_UNDEFINED || header.arraySize != 1) {
+                throw std::runtime_error("Failed to load DDS file: " + filepath + 
+                                        " (file exists but is invalid or unsupported format)");
+            }
+            m_format = header.format;
+            m_sourceWidth = header.width;
+            m_sourceHeight = header.height;
+            m_sourceLevels = header.mipmapCount;
         }
-        testFile.close();
-        
-        DDSData ddsData = load_dds(filepath);
-        
-        if (ddsData.format == VK_FORMAT_UNDEFINED) {
-            throw std::runtime_error("Failed to load DDS file: " + filepath + 
-                                    " (file exists but is invalid or unsupported format)");
+        m_sourcePath = filepath;
+    }
+    
+    // Read source levels [first, first + count), packed largest first; KTX2 levels are read smallest first
+    DDSData readSourceLevels(uint32_t first, uint32_t count) {
+        if (isKTX2(m_sourcePath)) {
+            KTX2Reader reader(m_sourcePath);
+            DDSData levels = {};
+            levels.format = m_format;
+            levels.width = reader.getInfo().levels[first].width;
+            levels.height = reader.getInfo().levels[first].height;
+            levels.mipmapCount = count;
+            levels.arraySize = 1;
+            std::vector<std::vector<uint8_t>> data(count);
+            for (uint32_t i = count; i-- > 0;) {
+                data[i] = reader.readLevel(first + i);
+            }
+            for (const std::vector<uint8_t>& level : data) {
+                levels.compressedData.insert(levels.compressedData.end(), level.begin(), level.end());
+            }
+            return levels;
         }
         
-        m_format = ddsData.format;
-        m_width = ddsData.width;
-        m_height = ddsData.height;
-        m_mipmapCount = ddsData.mipmapCount;
-        
-        // Create Vulkan image
+        DDSData levels = load_dds(m_sourcePath, first, count);
+        if (levels.format == VK_FORMAT_UNDEFINED) {
+            throw std::runtime_error("Failed to read mip levels from " + m_sourcePath);
+        }
+        return levels;
+    }
+    
+    uint32_t levelWidth(uint32_t level) const { return std::max(1u, m_sourceWidth >> level); }
+    uint32_t levelHeight(uint32_t level) const { return std::max(1u, m_sourceHeight >> level); }
+    
+    // Create a sampled image holding source levels [top, m_sourceLevels)
+    void createLevelImage(uint32_t top, VkImage& image, GpuAllocation& memory) {
         VkImageCreateInfo imageInfo = {};
         imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
         imageInfo.imageType = VK_IMAGE_TYPE_2D;
-        imageInfo.extent.width = m_width;
-        imageInfo.extent.height = m_height;
+        imageInfo.extent.width = levelWidth(top);
+        imageInfo.extent.height = levelHeight(top);
         imageInfo.extent.depth = 1;
-        imageInfo.mipLevels = m_mipmapCount;
+        imageInfo.mipLevels = m_sourceLevels - top;
         imageInfo.arrayLayers = 1;
         imageInfo.format = m_format;
         imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
@@ -178,107 +188,152 @@ private:
         imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
         imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
         
-        if (vkCreateImage(g_device, &imageInfo, nullptr, &m_image) != VK_SUCCESS) {
-            throw std::runtime_error("Failed to create DDS image");
+        // Image memory is sub-allocated from the shared GpuAllocator (dedicated if very large)
+        if (!GpuAllocator::get_instance().createImage(imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                                      image, memory)) {
+            throw std::runtime_error("Failed to create texture image");
         }
-        
-        // Allocate image memory
-        VkMemoryRequirements memRequirements;
-        vkGetImageMemoryRequirements(g_device, m_image, &memRequirements);
-        
-        VkMemoryAllocateInfo allocInfo = {};
-        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        allocInfo.allocationSize = memRequirements.size;
-        allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, 
-                                                   VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-        
-        if (allocInfo.memoryTypeIndex == UINT32_MAX) {
-            vkDestroyImage(g_device, m_image, nullptr);
-            throw std::runtime_error("Failed to find suitable memory type for DDS image");
+    }
+    
+    // Queue the upload of packed levels [first, first + count) into an image whose top level is `top`
+    uint64_t uploadLevels(VkImage image, uint32_t top, const uint8_t* data, VkDeviceSize size,
+                          uint32_t first, uint32_t count) {
+        // Copy buffer to image (compressed blocks, one region per mip level)
+        std::vector<VkBufferImageCopy> regions(count);
+        VkDeviceSize mipOffset = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t level = first + i;
+            VkBufferImageCopy& region = regions[i];
+            region = {};
+            region.bufferOffset = mipOffset;
+            region.bufferRowLength = 0;
+            region.bufferImageHeight = 0;
+            region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            region.imageSubresource.mipLevel = level - top;
+            region.imageSubresource.baseArrayLayer = 0;
+            region.imageSubresource.layerCount = 1;
+            region.imageOffset = {0, 0, 0};
+            region.imageExtent = {levelWidth(level), levelHeight(level), 1};
+            
+            mipOffset += calculateMipmapSize(levelWidth(level), levelHeight(level), m_format);
         }
-        
-        if (vkAllocateMemory(g_device, &allocInfo, nullptr, &m_imageMemory) != VK_SUCCESS) {
-            vkDestroyImage(g_device, m_image, nullptr);
-            throw std::runtime_error("Failed to allocate DDS image memory");
+        if (mipOffset > size) {
+            throw std::runtime_error("Mip data is truncated: " + m_path);
         }
         
-        vkBindImageMemory(g_device, m_image, m_imageMemory, 0);
-        
-        // Create staging buffer for compressed data
-        VkBuffer stagingBuffer;
-        VkDeviceMemory stagingBufferMemory;
-        createBuffer(ddsData.compressedData.size(), 
-                    VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                    stagingBuffer, stagingBufferMemory);
-        
-        // Copy compressed data to staging buffer
-        void* data;
-        vkMapMemory(g_device, stagingBufferMemory, 0, ddsData.compressedData.size(), 0, &data);
-        memcpy(data, ddsData.compressedData.data(), ddsData.compressedData.size());
-        vkUnmapMemory(g_device, stagingBufferMemory);
-        
-        // Upload to GPU
-        VkCommandBuffer commandBuffer = beginSingleTimeCommands();
-        
-        // Transition to transfer destination
-        VkImageMemoryBarrier barrier = {};
-        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-        barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        barrier.image = m_image;
-        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        barrier.subresourceRange.baseMipLevel = 0;
-        barrier.subresourceRange.levelCount = m_mipmapCount;
-        barrier.subresourceRange.baseArrayLayer = 0;
-        barrier.subresourceRange.layerCount = 1;
-        barrier.srcAccessMask = 0;
-        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-        
-        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 
-                            VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
-        
-        // Copy buffer to image (compressed blocks)
-        VkBufferImageCopy region = {};
-        region.bufferOffset = 0;
-        region.bufferRowLength = 0;
-        region.bufferImageHeight = 0;
-        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        region.imageSubresource.mipLevel = 0;
-        region.imageSubresource.baseArrayLayer = 0;
-        region.imageSubresource.layerCount = 1;
-        region.imageOffset = {0, 0, 0};
-        region.imageExtent = {m_width, m_height, 1};
-        
-        vkCmdCopyBufferToImage(commandBuffer, stagingBuffer, m_image, 
-                              VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-        
-        // Transition to shader-readable
-        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-        barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-        
-        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, 
-                            VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+        // Upload through the shared staging ring; the levels end up in SHADER_READ_ONLY_OPTIMAL
+        // once the batch is flushed. Only these levels are transitioned, so resident ones stay valid.
+        UploadQueue& uploads = UploadQueue::get_instance();
+        uploads.uploadImage(image, data, mipOffset, regions, count, 1, first - top);
+        return uploads.getRecordingId();
+    }
+    
+    // Make m_image hold levels [top, m_sourceLevels) with `data` (levels [first, ...)) uploaded
+    void createAndUpload(uint32_t top, const DDSData& data, uint32_t first) {
+        createLevelImage(top, m_image, m_imageMemory);
+        m_memorySize = m_imageMemory.size;
+        m_skipMips = top;
+        m_width = levelWidth(top);
+        m_height = levelHeight(top);
+        m_mipmapCount = m_sourceLevels - top;
+        m_residentLevel = first;
+        m_uploadId = uploadLevels(m_image, top, data.compressedData.data(), data.compressedData.size(),
+                                  first, m_sourceLevels - first);
+    }
+    
+    /**
+     * Load a GPU-ready source. The image covers the requested detail (m_skipMips, and the streamer's
+     * requested level); with streaming enabled only the mip tail is read and uploaded now, the
+     * finer levels follow through streamLevel().
+     */
+    void loadGpuReady(const std::string& filepath) {
+        openSource(filepath);
+        
+        TextureStreamer& streamer = TextureStreamer::get_instance();
+        uint32_t top = std::min(m_skipMips, m_sourceLevels - 1);
+        uint32_t first = top;
+        if (streamer.isEnabled()) {
+            top = std::max(top, std::min(streamer.getRequestedLevel(m_stream), m_sourceLevels - 1));
+            uint32_t tail = top;
+            while (tail + 1 < m_sourceLevels && std::max(levelWidth(tail), levelHeight(tail)) > STREAM_TAIL_SIZE) {
+                tail++;
+            }
+            // Keep detail that was already visible (dropDetail reloads), otherwise start from the tail
+            first = std::max(top, std::min(tail, m_residentLevel));
+        }
         
-        endSingleTimeCommands(commandBuffer);
+        DDSData data = readSourceLevels(first, m_sourceLevels - first);
+        createAndUpload(top, data, first);
+    }
+    
+    // Upload a complete in-memory chain (transcoded PNG whose cache could not be written); not streamed
+    void uploadDDS(const DDSData& ddsData, uint32_t skipMips) {
+        m_sourcePath.clear();
+        m_format = ddsData.format;
+        m_sourceWidth = ddsData.width;
+        m_sourceHeight = ddsData.height;
+        m_sourceLevels = ddsData.mipmapCount;
+        
+        // Skip dropped top mips: find where the first resident level starts in the data
+        uint32_t top = std::min(skipMips, m_sourceLevels - 1);
+        VkDeviceSize skipOffset = 0;
+        for (uint32_t level = 0; level < top; level++) {
+            skipOffset += calculateMipmapSize(levelWidth(level), levelHeight(level), m_format);
+        }
         
-        // Cleanup staging buffer
-        vkDestroyBuffer(g_device, stagingBuffer, nullptr);
-        vkFreeMemory(g_device, stagingBufferMemory, nullptr);
+        DDSData levels = {};
+        levels.compressedData.assign(ddsData.compressedData.begin() + skipOffset, ddsData.compressedData.end());
+        createAndUpload(top, levels, top);
+    }
+    
+    // PNG transcoding settings (shared by every TextureResource)
+    struct PngCompression {
+        bool enabled = true;
+        BCQuality quality = BCQuality::Fast;
+        std::string cacheDirectory = "texture_cache";   // "" = transcode on every load, write nothing
+    };
+    static PngCompression& pngCompression() {
+        static PngCompression settings;
+        return settings;
     }
     
     // Load PNG texture and create Vulkan resources
     void loadPNG(const std::string& filepath) {
+        // Transcode to BC7 (BC5 for normal maps); the cached .dds, keyed by the PNG's content,
+        // is then loaded (and streamed) like any other DDS
+        if (pngCompression().enabled) {
+            const PngCompression& settings = pngCompression();
+            BCFormat format = bc_format_for_png(filepath);
+            uint64_t key = 0;
+            if (settings.cacheDirectory.empty() || !bc_cache_key(filepath, format, settings.quality, key)) {
+                uploadDDS(transcode_png_to_bc(load_png(filepath), format, settings.quality), m_skipMips);
+                return;
+            }
+            std::string cachePath = bc_cache_path(settings.cacheDirectory, key, format);
+            if (!bc_cache_is_current(cachePath, format)) {
+                DDSData ddsData = transcode_png_to_bc(load_png(filepath), format, settings.quality);
+                if (!bc_save_cache(settings.cacheDirectory, cachePath, ddsData)) {
+                    uploadDDS(ddsData, m_skipMips);     // Cache directory not writable
+                    return;
+                }
+            }
+            loadGpuReady(cachePath);
+            return;
+        }
+        
         PNGData pngData = load_png(filepath);
+        generate_png_mipmaps(pngData);  // PNG carries no mips; build the chain on the CPU
         
         m_format = pngData.format;
         m_width = pngData.width;
         m_height = pngData.height;
-        m_mipmapCount = 1;  // PNG has no mipmaps
+        m_mipmapCount = static_cast<uint32_t>(pngData.mipLevels.size());
+        m_sourcePath.clear();           // Not streamed: every level is uploaded now
+        m_sourceWidth = m_width;
+        m_sourceHeight = m_height;
+        m_sourceLevels = m_mipmapCount;
+        m_skipMips = 0;
+        m_residentLevel = 0;
         
         // Create Vulkan image
         VkImageCreateInfo imageInfo = {};
@@ -287,7 +342,7 @@ private:
         imageInfo.extent.width = m_width;
         imageInfo.extent.height = m_height;
         imageInfo.extent.depth = 1;
-        imageInfo.mipLevels = 1;
+        imageInfo.mipLevels = m_mipmapCount;
         imageInfo.arrayLayers = 1;
         imageInfo.format = m_format;
         imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
@@ -296,116 +351,61 @@ private:
         imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
         imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
         
-        if (vkCreateImage(g_device, &imageInfo, nullptr, &m_image) != VK_SUCCESS) {
+        // Image memory is sub-allocated from the shared GpuAllocator (dedicated if very large)
+        if (!GpuAllocator::get_instance().createImage(imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                                      m_image, m_imageMemory)) {
             throw std::runtime_error("Failed to create PNG image");
         }
-        
-        // Allocate image memory
-        VkMemoryRequirements memRequirements;
-        vkGetImageMemoryRequirements(g_device, m_image, &memRequirements);
-        
-        VkMemoryAllocateInfo allocInfo = {};
-        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        allocInfo.allocationSize = memRequirements.size;
-        allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, 
-                                                   VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-        
-        if (allocInfo.memoryTypeIndex == UINT32_MAX) {
-            vkDestroyImage(g_device, m_image, nullptr);
-            throw std::runtime_error("Failed to find suitable memory type for PNG image");
-        }
-        
-        if (vkAllocateMemory(g_device, &allocInfo, nullptr, &m_imageMemory) != VK_SUCCESS) {
-            vkDestroyImage(g_device, m_image, nullptr);
-            throw std::runtime_error("Failed to allocate PNG image memory");
+        m_memorySize = m_imageMemory.size;
+        
+        // Copy buffer to image (uncompressed RGBA8, one region per mip level)
+        std::vector<VkBufferImageCopy> regions(m_mipmapCount);
+        for (uint32_t level = 0; level < m_mipmapCount; level++) {
+            const MipLevel& mip = pngData.mipLevels[level];
+            VkBufferImageCopy& region = regions[level];
+            region = {};
+            region.bufferOffset = mip.offset;
+            region.bufferRowLength = 0;
+            region.bufferImageHeight = 0;
+            region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            region.imageSubresource.mipLevel = level;
+            region.imageSubresource.baseArrayLayer = 0;
+            region.imageSubresource.layerCount = 1;
+            region.imageOffset = {0, 0, 0};
+            region.imageExtent = {mip.width, mip.height, 1};
         }
         
-        vkBindImageMemory(g_device, m_image, m_imageMemory, 0);
-        
-        // Create staging buffer for uncompressed RGBA8 data
-        VkBuffer stagingBuffer;
-        VkDeviceMemory stagingBufferMemory;
-        createBuffer(pngData.pixelData.size(), 
-                    VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                    stagingBuffer, stagingBufferMemory);
-        
-        // Copy pixel data to staging buffer
-        void* data;
-        vkMapMemory(g_device, stagingBufferMemory, 0, pngData.pixelData.size(), 0, &data);
-        memcpy(data, pngData.pixelData.data(), pngData.pixelData.size());
-        vkUnmapMemory(g_device, stagingBufferMemory);
-        
-        // Upload to GPU
-        VkCommandBuffer commandBuffer = beginSingleTimeCommands();
-        
-        // Transition to transfer destination
-        VkImageMemoryBarrier barrier = {};
-        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-        barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        barrier.image = m_image;
-        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        barrier.subresourceRange.baseMipLevel = 0;
-        barrier.subresourceRange.levelCount = 1;
-        barrier.subresourceRange.baseArrayLayer = 0;
-        barrier.subresourceRange.layerCount = 1;
-        barrier.srcAccessMask = 0;
-        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-        
-        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 
-                            VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
-        
-        // Copy buffer to image (uncompressed RGBA8)
-        VkBufferImageCopy region = {};
-        region.bufferOffset = 0;
-        region.bufferRowLength = 0;
-        region.bufferImageHeight = 0;
-        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        region.imageSubresource.mipLevel = 0;
-        region.imageSubresource.baseArrayLayer = 0;
-        region.imageSubresource.layerCount = 1;
-        region.imageOffset = {0, 0, 0};
-        region.imageExtent = {m_width, m_height, 1};
-        
-        vkCmdCopyBufferToImage(commandBuffer, stagingBuffer, m_image, 
-                              VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-        
-        // Transition to shader-readable
-        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-        barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-        
-        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, 
-                            VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
-        
-        endSingleTimeCommands(commandBuffer);
-        
-        // Cleanup staging buffer
-        vkDestroyBuffer(g_device, stagingBuffer, nullptr);
-        vkFreeMemory(g_device, stagingBufferMemory, nullptr);
+        UploadQueue& uploads = UploadQueue::get_instance();
+        uploads.uploadImage(m_image, pngData.pixelData.data(), pngData.pixelData.size(),
+                            regions, m_mipmapCount);
+        m_uploadId = uploads.getRecordingId();
     }
     
-    // Create image view and sampler
-    void createViewAndSampler() {
-        // Create image view
+    // Create a view of `image` (top source level `top`) exposing levels [m_residentLevel, m_sourceLevels).
+    // Levels still being streamed stay outside the view, so shaders never sample them.
+    VkImageView createLevelView(VkImage image, uint32_t top) {
         VkImageViewCreateInfo viewInfo = {};
         viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-        viewInfo.image = m_image;
+        viewInfo.image = image;
         viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
         viewInfo.format = m_format;
         viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        viewInfo.subresourceRange.baseMipLevel = 0;
-        viewInfo.subresourceRange.levelCount = m_mipmapCount;
+        viewInfo.subresourceRange.baseMipLevel = m_residentLevel - top;
+        viewInfo.subresourceRange.levelCount = m_sourceLevels - m_residentLevel;
         viewInfo.subresourceRange.baseArrayLayer = 0;
         viewInfo.subresourceRange.layerCount = 1;
         
-        if (vkCreateImageView(g_device, &viewInfo, nullptr, &m_imageView) != VK_SUCCESS) {
+        VkImageView view = VK_NULL_HANDLE;
+        if (vkCreateImageView(g_device, &viewInfo, nullptr, &view) != VK_SUCCESS) {
             throw std::runtime_error("Failed to create image view");
         }
+        return view;
+    }
+    
+    // Create image view and sampler
+    void createViewAndSampler() {
+        // Create image view
+        m_imageView = createLevelView(m_image, m_skipMips);
         
         // Create sampler
         VkSamplerCreateInfo samplerInfo = {};
@@ -435,41 +435,46 @@ private:
 public:
     /**
      * Constructor - Loads texture from file and creates Vulkan resources
-     * @param filepath Path to texture file (DDS or PNG)
+     * @param filepath Path to texture file (DDS, KTX2 or PNG)
      * @throws std::runtime_error if loading or resource creation fails
      */
-    TextureResource(const std::string& filepath) {
+    TextureResource(const std::string& filepath) : m_path(filepath) {
+        m_stream = TextureStreamer::get_instance().track(this);
         try {
-            // Auto-detect format and load
-            if (isDDS(filepath)) {
-                loadDDS(filepath);
-            } else {
-                // Assume PNG (could add more format detection later)
-                loadPNG(filepath);
-            }
-            
-            // Create image view and sampler
-            createViewAndSampler();
-            
+            loadFromFile();
+            m_observedGeneration = m_generation;
             m_loaded = true;
         } catch (const std::exception& e) {
             cleanup();
             throw;
         }
+        m_residency = ResidencyManager::get_instance().track(this);
     }
     
     // Move constructor
     TextureResource(TextureResource&& other) noexcept 
-        : m_image(other.m_image), m_imageView(other.m_imageView), 
+        : m_path(std::move(other.m_path)), m_image(other.m_image), m_imageView(other.m_imageView), 
           m_sampler(other.m_sampler), m_imageMemory(other.m_imageMemory),
           m_format(other.m_format), m_width(other.m_width), 
           m_height(other.m_height), m_mipmapCount(other.m_mipmapCount),
-          m_loaded(other.m_loaded) {
+          m_memorySize(other.m_memorySize), m_skipMips(other.m_skipMips),
+          m_generation(other.m_generation), m_observedGeneration(other.m_observedGeneration),
+          m_loaded(other.m_loaded), m_residency(other.m_residency), m_uploadId(other.m_uploadId),
+          m_sourcePath(std::move(other.m_sourcePath)), m_sourceWidth(other.m_sourceWidth),
+          m_sourceHeight(other.m_sourceHeight), m_sourceLevels(other.m_sourceLevels),
+          m_residentLevel(other.m_residentLevel), m_stream(other.m_stream), m_pending(other.m_pending) {
         other.m_image = VK_NULL_HANDLE;
         other.m_imageView = VK_NULL_HANDLE;
         other.m_sampler = VK_NULL_HANDLE;
-        other.m_imageMemory = VK_NULL_HANDLE;
+        other.m_imageMemory = GpuAllocation();
+        other.m_memorySize = 0;
         other.m_loaded = false;
+        other.m_residency = INVALID_RESIDENCY_HANDLE;
+        other.m_uploadId = 0;
+        other.m_stream = INVALID_STREAM_HANDLE;
+        other.m_pending = PendingLevel();
+        ResidencyManager::get_instance().retarget(m_residency, this);
+        TextureStreamer::get_instance().retarget(m_stream, this);
     }
     
     // Delete copy constructor and assignment (textures are unique resources)
@@ -483,6 +488,232 @@ public:
     
     // Cleanup helper
     void cleanup() {
+        if (m_residency != INVALID_RESIDENCY_HANDLE) {
+            ResidencyManager::get_instance().untrack(m_residency);
+            m_residency = INVALID_RESIDENCY_HANDLE;
+        }
+        if (m_stream != INVALID_STREAM_HANDLE) {
+            TextureStreamer::get_instance().untrack(m_stream);
+            m_stream = INVALID_STREAM_HANDLE;
+        }
+        releaseGpuObjects();
+    }
+    
+    /**
+     * Mark the texture as used this frame, reloading it if the ResidencyManager evicted it.
+     * @return true if the image/view/sampler handles changed (rewrite descriptors that use them)
+     */
+    bool ensureResident() {
+        bool restored = ResidencyManager::get_instance().touch(m_residency);
+        bool changed = restored || m_observedGeneration != m_generation;
+        m_observedGeneration = m_generation;
+        return changed;
+    }
+    
+    /**
+     * Finest mip level to stream in (0 = full resolution, the default). Coarser requests do not
+     * free memory by themselves; the ResidencyManager drops detail when over budget.
+     */
+    void requestLevel(uint32_t level) {
+        TextureStreamer::get_instance().request(m_stream, level);
+    }
+    
+    /**
+     * Request the level matching an on-screen footprint (pixels along the longer axis)
+     */
+    void requestScreenSize(float screenPixels) {
+        requestLevel(TextureStreamer::level_for_screen_size(m_sourceWidth, m_sourceHeight, screenPixels));
+    }
+    
+    /**
+     * Never evict this texture or drop its detail. Streaming still swaps in a new view as finer
+     * levels land, so a descriptor set that samples it must be rewritten whenever
+     * ensureResident() returns true.
+     */
+    void pinResidency() {
+        ResidencyManager::get_instance().setPinned(m_residency, true);
+    }
+    
+    // ResidentAsset interface (called by the ResidencyManager)
+    size_t getResidentBytes() const override {
+        return static_cast<size_t>(m_memorySize);
+    }
+    
+    size_t evictResidency() override {
+        size_t freed = static_cast<size_t>(m_memorySize);
+        releaseGpuObjects();
+        m_residentLevel = UINT32_MAX;   // Stream back in from the tail when restored
+        return freed;
+    }
+    
+    bool restoreResidency() override {
+        m_skipMips = 0; // Evicted textures come back at full resolution
+        return reloadAtCurrentDetail();
+    }
+    
+    size_t dropDetail() override {
+        // Only GPU-ready sources (DDS, KTX2 or a cached PNG transcode) can be re-uploaded from a lower level
+        if (!m_loaded || m_mipmapCount <= 1 || m_sourcePath.empty()) {
+            return 0;
+        }
+        size_t before = static_cast<size_t>(m_memorySize);
+        releaseGpuObjects();
+        m_skipMips++;
+        if (!reloadAtCurrentDetail()) {
+            return before;
+        }
+        return before > m_memorySize ? before - static_cast<size_t>(m_memorySize) : 0;
+    }
+    
+    // StreamedAsset interface (called by the TextureStreamer)
+    uint32_t getStreamedLevel() const override {
+        return (m_loaded && !m_sourcePath.empty()) ? m_residentLevel : 0;
+    }
+    
+    bool updateStreaming() override {
+        if (m_pending.level == UINT32_MAX) {
+            return false;
+        }
+        if (!UploadQueue::get_instance().isComplete(m_pending.uploadId)) {
+            return true;
+        }
+        finishPendingLevel();
+        return false;
+    }
+    
+    uint64_t getLevelBytes(uint32_t level) const override {
+        // Streaming above the image's top level re-uploads every level below it into a larger image
+        uint32_t last = level < m_skipMips ? m_sourceLevels : level + 1;
+        uint64_t bytes = 0;
+        for (uint32_t i = level; i < last; i++) {
+            bytes += calculateMipmapSize(levelWidth(i), levelHeight(i), m_format);
+        }
+        return bytes;
+    }
+    
+    bool streamLevel(uint32_t level, uint32_t targetLevel) override {
+        if (!m_loaded || m_sourcePath.empty() || m_pending.level != UINT32_MAX || level + 1 != m_residentLevel) {
+            return false;
+        }
+        
+        PendingLevel pending;
+        pending.level = level;
+        pending.top = m_skipMips;
+        try {
+            if (level >= m_skipMips) {
+                // The image already has room for the level: upload it in place, outside the current view
+                DDSData data = readSourceLevels(level, 1);
+                pending.uploadId = uploadLevels(m_image, m_skipMips, data.compressedData.data(),
+                                                data.compressedData.size(), level, 1);
+            } else {
+                // The ResidencyManager dropped these levels; only grow back while it fits the budget
+                pending.top = std::min(targetLevel, level);
+                ResidencyManager& residency = ResidencyManager::get_instance();
+                uint64_t grownBytes = 0;
+                for (uint32_t i = pending.top; i < m_sourceLevels; i++) {
+                    grownBytes += calculateMipmapSize(levelWidth(i), levelHeight(i), m_format);
+                }
+                if (residency.getBudget() != 0 &&
+                    residency.getResidentBytes() - m_memorySize + grownBytes > residency.getBudget()) {
+                    return false;
+                }
+                
+                DDSData data = readSourceLevels(level, m_sourceLevels - level);
+                createLevelImage(pending.top, pending.image, pending.memory);
+                pending.uploadId = uploadLevels(pending.image, pending.top, data.compressedData.data(),
+                                                data.compressedData.size(), level, m_sourceLevels - level);
+            }
+        } catch (const std::exception& e) {
+            if (pending.image != VK_NULL_HANDLE) {
+                vkDestroyImage(g_device, pending.image, nullptr);
+                GpuAllocator::get_instance().free(pending.memory);
+            }
+            return false;
+        }
+        m_pending = pending;
+        return true;
+    }
+    
+private:
+    // Make a landed level visible: swap in a view (and image) that includes it, retiring the old
+    // objects until frames that still reference them have finished
+    void finishPendingLevel() {
+        VkImage image = m_pending.image != VK_NULL_HANDLE ? m_pending.image : m_image;
+        uint32_t previousLevel = m_residentLevel;
+        m_residentLevel = m_pending.level;
+        VkImageView view;
+        try {
+            view = createLevelView(image, m_pending.top);
+        } catch (const std::exception& e) {
+            m_residentLevel = previousLevel;
+            throw;
+        }
+        
+        VkDevice device = g_device;
+        VkImageView oldView = m_imageView;
+        if (m_pending.image != VK_NULL_HANDLE) {
+            VkImage oldImage = m_image;
+            GpuAllocation oldMemory = m_imageMemory;
+            TextureStreamer::get_instance().retire([device, oldView, oldImage, oldMemory]() mutable {
+                vkDestroyImageView(device, oldView, nullptr);
+                vkDestroyImage(device, oldImage, nullptr);
+                GpuAllocator::get_instance().free(oldMemory);
+            });
+            m_image = m_pending.image;
+            m_imageMemory = m_pending.memory;
+            m_memorySize = m_imageMemory.size;
+            m_skipMips = m_pending.top;
+            m_width = levelWidth(m_skipMips);
+            m_height = levelHeight(m_skipMips);
+            m_mipmapCount = m_sourceLevels - m_skipMips;
+            ResidencyManager::get_instance().updateBytes(m_residency);
+        } else {
+            TextureStreamer::get_instance().retire([device, oldView]() {
+                vkDestroyImageView(device, oldView, nullptr);
+            });
+        }
+        m_imageView = view;
+        m_uploadId = std::max(m_uploadId, m_pending.uploadId);
+        m_pending = PendingLevel();
+        m_generation++;
+    }
+    
+    bool reloadAtCurrentDetail() {
+        try {
+            loadFromFile();
+            m_loaded = true;
+        } catch (const std::exception& e) {
+            releaseGpuObjects();
+            return false;
+        }
+        return true;
+    }
+    
+    // Load (or reload) from m_path, honoring m_skipMips
+    void loadFromFile() {
+        // Auto-detect format and load
+        if (isDDS(m_path) || isKTX2(m_path)) {
+            loadGpuReady(m_path);
+        } else {
+            // Assume PNG (could add more format detection later)
+            loadPNG(m_path);
+        }
+        
+        // Create image view and sampler
+        createViewAndSampler();
+        m_generation++;
+    }
+    
+    // Destroy Vulkan objects but keep path/residency registration
+    void releaseGpuObjects() {
+        // A pending upload must not write into an image that is about to be destroyed
+        UploadQueue::get_instance().waitFor(std::max(m_uploadId, m_pending.uploadId));
+        m_uploadId = 0;
+        if (m_pending.image != VK_NULL_HANDLE) {
+            vkDestroyImage(g_device, m_pending.image, nullptr);
+            GpuAllocator::get_instance().free(m_pending.memory);
+        }
+        m_pending = PendingLevel();
         if (m_sampler != VK_NULL_HANDLE) {
             vkDestroySampler(g_device, m_sampler, nullptr);
             m_sampler = VK_NULL_HANDLE;
@@ -495,13 +726,12 @@ public:
             vkDestroyImage(g_device, m_image, nullptr);
             m_image = VK_NULL_HANDLE;
         }
-        if (m_imageMemory != VK_NULL_HANDLE) {
-            vkFreeMemory(g_device, m_imageMemory, nullptr);
-            m_imageMemory = VK_NULL_HANDLE;
-        }
+        GpuAllocator::get_instance().free(m_imageMemory);
+        m_memorySize = 0;
         m_loaded = false;
     }
     
+public:
     // Getters for Vulkan resources (ready to use in descriptors, etc.)
     VkImage getImage() const { return m_image; }
     VkImageView getImageView() const { return m_imageView; }
@@ -510,6 +740,8 @@ public:
     uint32_t getWidth() const { return m_width; }
     uint32_t getHeight() const { return m_height; }
     uint32_t getMipmapCount() const { return m_mipmapCount; }
+    const std::string& getPath() const { return m_path; }
+    VkDeviceSize getMemorySize() const { return m_memorySize; }
     bool isLoaded() const { return m_loaded; }
     
     // Get descriptor image info (ready for descriptor set updates)
@@ -520,6 +752,25 @@ public:
         imageInfo.sampler = m_sampler;
         return imageInfo;
     }
+
+    /**
+     * Control PNG transcoding for textures loaded after the call.
+     * Enabled (the default), PNGs are compressed to BC7 (BC5 for *_n / *_nrm / *_normal) and
+     * cached in the PNG cache directory; disabled, they upload as RGBA8.
+     */
+    static void setPngCompression(bool enabled, BCQuality quality = BCQuality::Fast) {
+        pngCompression().enabled = enabled;
+        pngCompression().quality = quality;
+    }
+
+    /**
+     * Directory for transcoded PNGs (default "texture_cache", created on first write).
+     * Files are named by a hash of the PNG's bytes, so asset folders are never written to.
+     * An empty string disables the cache: PNGs are transcoded on every load and not streamed.
+     */
+    static void setPngCacheDirectory(const std::string& directory) {
+        pngCompression().cacheDirectory = directory;
+    }
 };
 
 #endif // EDEN_TEXTURE_RESOURCE_H
@@ -0,0 +1,280 @@
+// EDEN ENGINE - TextureStreamer
+// Progressive mip streaming: textures become usable with only their mip tail uploaded, and finer
+// levels are streamed in (smallest first) as on-screen size or distance asks for them, under a
+// per-frame upload bandwidth budget.
+//
+// Like the ResidencyManager, the streamer only does policy and accounting. It talks to textures
+// through StreamedAsset, so it can be exercised CPU-side with a mock asset (no Vulkan required).
+
+#ifndef EDEN_TEXTURE_STREAMER_H
+#define EDEN_TEXTURE_STREAMER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <functional>
+
+/**
+ * StreamedAsset - Interface implemented by anything whose mip levels the TextureStreamer can stream
+ */
+class StreamedAsset {
+public:
+    virtual ~StreamedAsset() = default;
+
+    // Finest mip level (0 = full resolution) that shaders can currently sample
+    virtual uint32_t getStreamedLevel() const = 0;
+
+    // Whether a level upload is still in flight. Implementations finish (make visible) uploads
+    // that have landed when this is called.
+    virtual bool updateStreaming() = 0;
+
+    // Bytes it costs to upload `level`
+    virtual uint64_t getLevelBytes(uint32_t level) const = 0;
+
+    // Start uploading `level` (always getStreamedLevel() - 1). `targetLevel` is the finest level
+    // currently requested, for sizing storage. Returns false if it cannot stream now (e.g. no memory).
+    virtual bool streamLevel(uint32_t level, uint32_t targetLevel) = 0;
+};
+
+using StreamHandle = uint32_t;
+static constexpr StreamHandle INVALID_STREAM_HANDLE = UINT32_MAX;
+
+/**
+ * TextureStreamer - Requested-level bookkeeping and bandwidth-limited mip streaming
+ *
+ * Every tracked texture has a requested level (0 until feedback says otherwise, so textures
+ * nobody reports on still reach full resolution). Each update() starts at most one level upload
+ * per texture, largest deficit first, until the frame's byte budget is spent.
+ *
+ * Usage:
+ *   TextureStreamer& streamer = TextureStreamer::get_instance();
+ *   StreamHandle h = streamer.track(&texture);
+ *   streamer.request(h, TextureStreamer::level_for_screen_size(1024, 1024, 180.0f));
+ *   streamer.update();   // Once per frame, before uploads are flushed
+ */
+class TextureStreamer {
+public:
+    struct Stats {
+        uint32_t trackedCount = 0;
+        uint32_t pendingCount = 0;      // Textures with a level upload in flight
+        uint32_t waitingCount = 0;      // Textures below their requested level, not yet started
+        uint64_t bytesThisFrame = 0;
+        uint64_t totalLevelsStreamed = 0;
+        uint64_t totalBytesStreamed = 0;
+    };
+
+private:
+    struct Record {
+        StreamedAsset* asset = nullptr;
+        uint32_t requestedLevel = 0;
+        bool active = false;
+    };
+
+    struct Candidate {
+        StreamHandle handle;
+        uint32_t level;
+        uint32_t deficit;
+        uint64_t bytes;
+    };
+
+    std::vector<Record> m_records;
+    std::vector<StreamHandle> m_freeHandles;
+    std::deque<std::pair<uint64_t, std::function<void()>>> m_retired;
+    uint64_t m_frame = 0;
+    uint64_t m_bandwidthBudget = 16ull * 1024 * 1024;  // Upload bytes started per frame
+    uint32_t m_retireFrames = 3;                       // Frames a replaced object may still be in use
+    bool m_enabled = true;
+    Stats m_stats;
+
+public:
+    TextureStreamer() = default;
+    TextureStreamer(const TextureStreamer&) = delete;
+    TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+    /**
+     * Get the process-wide streamer used by TextureResource.
+     * Intentionally never destroyed (assets untrack themselves during static destruction).
+     */
+    static TextureStreamer& get_instance() {
+        static TextureStreamer* instance = new TextureStreamer();
+        return *instance;
+    }
+
+    /**
+     * Mip level whose size best matches an on-screen footprint (in pixels along the longer axis)
+     */
+    static uint32_t level_for_screen_size(uint32_t textureWidth, uint32_t textureHeight, float screenPixels) {
+        float size = static_cast<float>(std::max(textureWidth, textureHeight));
+        if (screenPixels <= 1.0f) {
+            return static_cast<uint32_t>(std::log2(std::max(size, 1.0f)));
+        }
+        float level = std::floor(std::log2(std::max(size / screenPixels, 1.0f)));
+        return static_cast<uint32_t>(level);
+    }
+
+    /**
+     * Mip level for a surface of `worldSize` meters (covered once by the texture) seen from `distance`
+     * with a vertical field of view `fovY` (radians) on a viewport `viewportHeight` pixels tall
+     */
+    static uint32_t level_for_distance(uint32_t textureWidth, uint32_t textureHeight, float worldSize,
+                                       float distance, float fovY, float viewportHeight) {
+        float projected = viewportHeight * worldSize / (2.0f * std::max(distance, 1e-3f) * std::tan(fovY * 0.5f));
+        return level_for_screen_size(textureWidth, textureHeight, projected);
+    }
+
+    StreamHandle track(StreamedAsset* asset) {
+        StreamHandle handle;
+        if (!m_freeHandles.empty()) {
+            handle = m_freeHandles.back();
+            m_freeHandles.pop_back();
+        } else {
+            handle = static_cast<StreamHandle>(m_records.size());
+            m_records.emplace_back();
+        }
+        m_records[handle] = Record();
+        m_records[handle].asset = asset;
+        m_records[handle].active = true;
+        m_stats.trackedCount++;
+        return handle;
+    }
+
+    void untrack(StreamHandle handle) {
+        if (handle >= m_records.size() || !m_records[handle].active) {
+            return;
+        }
+        m_records[handle] = Record();
+        m_freeHandles.push_back(handle);
+        m_stats.trackedCount--;
+    }
+
+    /**
+     * Point a handle at a moved-to asset (move constructors)
+     */
+    void retarget(StreamHandle handle, StreamedAsset* asset) {
+        if (handle < m_records.size() && m_records[handle].active) {
+            m_records[handle].asset = asset;
+        }
+    }
+
+    /**
+     * Finest level the texture should stream to (sticky until the next request)
+     */
+    void request(StreamHandle handle, uint32_t level) {
+        if (handle < m_records.size() && m_records[handle].active) {
+            m_records[handle].requestedLevel = level;
+        }
+    }
+
+    uint32_t getRequestedLevel(StreamHandle handle) const {
+        return (handle < m_records.size() && m_records[handle].active) ? m_records[handle].requestedLevel : 0;
+    }
+
+    /**
+     * Destroy `destroy`'s objects once frames that may still reference them have finished
+     * (used for images/views replaced by a finer version)
+     */
+    void retire(std::function<void()> destroy) {
+        m_retired.emplace_back(m_frame, std::move(destroy));
+    }
+
+    /**
+     * Destroy every retired object now (device idle, shutdown)
+     */
+    void flushRetired() {
+        while (!m_retired.empty()) {
+            m_retired.front().second();
+            m_retired.pop_front();
+        }
+    }
+
+    /**
+     * Advance one frame: finish landed uploads, destroy old retired objects, and start level
+     * uploads (largest deficit first) until the bandwidth budget is spent. A frame always starts
+     * at least one upload, so levels larger than the budget still make progress.
+     */
+    void update() {
+        m_frame++;
+        while (!m_retired.empty() && m_frame - m_retired.front().first > m_retireFrames) {
+            m_retired.front().second();
+            m_retired.pop_front();
+        }
+
+        m_stats.pendingCount = 0;
+        m_stats.waitingCount = 0;
+        m_stats.bytesThisFrame = 0;
+
+        std::vector<Candidate> candidates;
+        for (StreamHandle handle = 0; handle < m_records.size(); handle++) {
+            Record& record = m_records[handle];
+            if (!record.active) {
+                continue;
+            }
+            if (record.asset->updateStreaming()) {
+                m_stats.pendingCount++;
+                continue;
+            }
+            uint32_t streamed = record.asset->getStreamedLevel();
+            if (streamed > record.requestedLevel) {
+                candidates.push_back({handle, streamed - 1, streamed - record.requestedLevel,
+                                      record.asset->getLevelBytes(streamed - 1)});
+            }
+        }
+        if (!m_enabled) {
+            m_stats.waitingCount = static_cast<uint32_t>(candidates.size());
+            return;
+        }
+
+        std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+            return a.deficit != b.deficit ? a.deficit > b.deficit : a.bytes < b.bytes;
+        });
+
+        uint64_t spent = 0;
+        for (const Candidate& candidate : candidates) {
+            if (spent > 0 && spent + candidate.bytes > m_bandwidthBudget) {
+                m_stats.waitingCount++;
+                continue;   // A smaller level further down may still fit
+            }
+            Record& record = m_records[candidate.handle];
+            if (!record.asset->streamLevel(candidate.level, record.requestedLevel)) {
+                m_stats.waitingCount++;
+                continue;
+            }
+            spent += candidate.bytes;
+            m_stats.pendingCount++;
+            m_stats.totalLevelsStreamed++;
+            m_stats.totalBytesStreamed += candidate.bytes;
+        }
+        m_stats.bytesThisFrame = spent;
+    }
+
+    /**
+     * Upload bytes started per frame (default 16MB)
+     */
+    void setBandwidthBudget(uint64_t bytesPerFrame) {
+        m_bandwidthBudget = bytesPerFrame;
+    }
+
+    /**
+     * Frames a replaced image/view is kept alive for (default 3; at least the frames in flight)
+     */
+    void setRetireFrames(uint32_t frames) {
+        m_retireFrames = frames;
+    }
+
+    /**
+     * Disabled, update() still finishes landed uploads but starts no new ones
+     */
+    void setEnabled(bool enabled) {
+        m_enabled = enabled;
+    }
+
+    bool isEnabled() const { return m_enabled; }
+    uint64_t getBandwidthBudget() const { return m_bandwidthBudget; }
+    uint64_t getFrame() const { return m_frame; }
+    const Stats& getStats() const { return m_stats; }
+};
+
+#endif // EDEN_TEXTURE_STREAMER_H
@@ -0,0 +1,556 @@
+// EDEN ENGINE - UploadQueue
+// Batched buffer/image uploads through a persistent, fence-tracked staging ring
+// Uploads from any number of resources are recorded into one command buffer and submitted
+// together (once per frame, or when the ring fills) instead of one queue round-trip each.
+// Uses a dedicated transfer queue when the device has one.
+
+#ifndef EDEN_UPLOAD_QUEUE_H
+#define EDEN_UPLOAD_QUEUE_H
+
+#include "vulkan.h"
+#include "gpu_allocator.h"
+#include "staging_ring.h"
+#include <vector>
+#include <utility>
+#include <cstring>
+#include <iostream>
+
+/**
+ * UploadQueue - Process-wide uploader used by TextureResource and MeshResource
+ *
+ * Provides:
+ * - A persistently mapped staging ring (32MB by default); regions are recycled when the
+ *   submission that read them signals its fence, never by waiting for the queue to idle
+ * - One transfer submission per flush() for every upload recorded since the last one
+ * - Queue family ownership transfer (release on the transfer queue, acquire on the graphics
+ *   queue) when a dedicated transfer queue is used
+ * - One-off staging buffers for uploads larger than the ring, freed on completion
+ *
+ * Not thread-safe: record uploads and flush on the render thread.
+ *
+ * Destination contents are valid for graphics submissions made after the flush() that
+ * carries the upload; the renderer flushes right before submitting each frame.
+ *
+ * Usage:
+ *   UploadQueue& uploads = UploadQueue::get_instance();
+ *   uploads.uploadBuffer(vertexBuffer, 0, vertices, size,
+ *                        VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT);
+ *   uploads.uploadImage(image, pixels, size, regions, mipLevels);
+ *   uploads.flush();      // Before the frame's vkQueueSubmit
+ */
+class UploadQueue {
+public:
+    struct Stats {
+        uint64_t submissions = 0;
+        uint64_t uploads = 0;
+        uint64_t uploadedBytes = 0;
+        uint64_t ringStalls = 0;        // Times an upload had to wait for ring space
+        uint64_t oversizedUploads = 0;  // Uploads that bypassed the ring
+    };
+
+private:
+    static constexpr uint32_t SUBMISSION_COUNT = 4;
+    static constexpr VkDeviceSize DEFAULT_RING_SIZE = 32ull * 1024 * 1024;
+
+    struct Submission {
+        uint64_t id = 0;
+        bool inFlight = false;
+        VkFence fence = VK_NULL_HANDLE;
+        VkSemaphore ownershipSemaphore = VK_NULL_HANDLE;    // Transfer -> graphics (dedicated queue only)
+        VkCommandBuffer transferCommands = VK_NULL_HANDLE;
+        VkCommandBuffer acquireCommands = VK_NULL_HANDLE;   // Graphics-queue acquire barriers
+        std::vector<std::pair<VkBuffer, GpuAllocation>> oversized;
+    };
+
+    VkDevice m_device = VK_NULL_HANDLE;
+    VkQueue m_graphicsQueue = VK_NULL_HANDLE;
+    VkQueue m_transferQueue = VK_NULL_HANDLE;
+    uint32_t m_graphicsFamily = 0;
+    uint32_t m_transferFamily = 0;
+    bool m_dedicatedTransfer = false;
+
+    VkCommandPool m_transferPool = VK_NULL_HANDLE;
+    VkCommandPool m_graphicsPool = VK_NULL_HANDLE;
+
+    VkBuffer m_ringBuffer = VK_NULL_HANDLE;
+    GpuAllocation m_ringMemory;
+    StagingRing m_ring;
+
+    Submission m_submissions[SUBMISSION_COUNT];
+    uint32_t m_current = 0;             // Submission slot being recorded
+    bool m_recording = false;
+    uint64_t m_nextId = 1;
+
+    std::vector<VkBufferMemoryBarrier> m_bufferAcquires;
+    std::vector<VkImageMemoryBarrier> m_imageAcquires;
+    VkPipelineStageFlags m_acquireStages = 0;
+
+    Stats m_stats;
+
+    UploadQueue() = default;
+
+    // Free what a completed submission held and give its ring space back
+    void retire(Submission& submission) {
+        for (auto& staging : submission.oversized) {
+            vkDestroyBuffer(m_device, staging.first, nullptr);
+            GpuAllocator::get_instance().free(staging.second);
+        }
+        submission.oversized.clear();
+        submission.inFlight = false;
+
+        // Release ring space up to the oldest submission that is still executing
+        uint64_t completed = m_nextId - 1;
+        for (const Submission& other : m_submissions) {
+            if (other.inFlight && other.id <= completed) {
+                completed = other.id - 1;
+            }
+        }
+        m_ring.release(completed);
+    }
+
+    void waitAndRetire(Submission& submission) {
+        if (!submission.inFlight) {
+            return;
+        }
+        vkWaitForFences(m_device, 1, &submission.fence, VK_TRUE, UINT64_MAX);
+        retire(submission);
+    }
+
+    Submission* findSubmission(uint64_t id) {
+        for (Submission& submission : m_submissions) {
+            if (submission.inFlight && submission.id == id) {
+                return &submission;
+            }
+        }
+        return nullptr;
+    }
+
+    void beginRecording() {
+        if (m_recording) {
+            return;
+        }
+
+        Submission& submission = m_submissions[m_current];
+        waitAndRetire(submission);
+        vkResetFences(m_device, 1, &submission.fence);
+        vkResetCommandBuffer(submission.transferCommands, 0);
+
+        VkCommandBufferBeginInfo beginInfo = {};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        vkBeginCommandBuffer(submission.transferCommands, &beginInfo);
+        m_recording = true;
+    }
+
+    // Copy data into staging memory; returns the buffer/offset the GPU copy should read from
+    void stage(const void* data, VkDeviceSize size, VkDeviceSize alignment,
+               VkBuffer& source, VkDeviceSize& sourceOffset) {
+        if (size > m_ring.getCapacity()) {
+            GpuAllocation allocation;
+            if (!GpuAllocator::get_instance().createBuffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                    source, allocation)) {
+                throw std::runtime_error("Failed to create staging buffer for upload");
+            }
+            memcpy(allocation.mapped, data, static_cast<size_t>(size));
+            m_submissions[m_current].oversized.push_back({source, allocation});
+            sourceOffset = 0;
+            m_stats.oversizedUploads++;
+            return;
+        }
+
+        uint64_t offset = m_ring.allocate(size, alignment);
+        while (offset == StagingRing::INVALID_OFFSET) {
+            // Ring full: submit what is recorded so far, then wait for the oldest batch to finish
+            m_stats.ringStalls++;
+            if (m_ring.getOpenBytes() > 0) {
+                flush();
+                beginRecording();
+            }
+            Submission* oldest = findSubmission(m_ring.getOldestSubmission());
+            if (!oldest) {
+                throw std::runtime_error("Staging ring exhausted with nothing in flight");
+            }
+            waitAndRetire(*oldest);
+            offset = m_ring.allocate(size, alignment);
+        }
+
+        memcpy(static_cast<char*>(m_ringMemory.mapped) + offset, data, static_cast<size_t>(size));
+        source = m_ringBuffer;
+        sourceOffset = offset;
+    }
+
+public:
+    UploadQueue(const UploadQueue&) = delete;
+    UploadQueue& operator=(const UploadQueue&) = delete;
+
+    /**
+     * Get the process-wide upload queue.
+     * Intentionally never destroyed; call shutdown() before destroying the device.
+     */
+    static UploadQueue& get_instance() {
+        static UploadQueue* instance = new UploadQueue();
+        return *instance;
+    }
+
+    /**
+     * Create the staging ring and per-submission command buffers/fences.
+     * Pass the graphics queue as the transfer queue when there is no dedicated one.
+     * @return false if any Vulkan object could not be created
+     */
+    bool init(VkDevice device, uint32_t graphicsFamily, VkQueue graphicsQueue,
+              uint32_t transferFamily, VkQueue transferQueue,
+              VkDeviceSize ringSize = DEFAULT_RING_SIZE) {
+        m_device = device;
+        m_graphicsFamily = graphicsFamily;
+        m_graphicsQueue = graphicsQueue;
+        m_transferFamily = transferFamily;
+        m_transferQueue = transferQueue;
+        m_dedicatedTransfer = transferFamily != graphicsFamily;
+
+        VkCommandPoolCreateInfo poolInfo = {};
+        poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        poolInfo.queueFamilyIndex = transferFamily;
+        if (vkCreateCommandPool(device, &poolInfo, nullptr, &m_transferPool) != VK_SUCCESS) {
+            return false;
+        }
+        if (m_dedicatedTransfer) {
+            poolInfo.queueFamilyIndex = graphicsFamily;
+            if (vkCreateCommandPool(device, &poolInfo, nullptr, &m_graphicsPool) != VK_SUCCESS) {
+                return false;
+            }
+        }
+
+        for (Submission& submission : m_submissions) {
+            VkCommandBufferAllocateInfo allocInfo = {};
+            allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocInfo.commandPool = m_transferPool;
+            allocInfo.commandBufferCount = 1;
+            if (vkAllocateCommandBuffers(device, &allocInfo, &submission.transferCommands) != VK_SUCCESS) {
+                return false;
+            }
+
+            VkFenceCreateInfo fenceInfo = {};
+            fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+            if (vkCreateFence(device, &fenceInfo, nullptr, &submission.fence) != VK_SUCCESS) {
+                return false;
+            }
+
+            if (m_dedicatedTransfer) {
+                allocInfo.commandPool = m_graphicsPool;
+                if (vkAllocateCommandBuffers(device, &allocInfo, &submission.acquireCommands) != VK_SUCCESS) {
+                    return false;
+                }
+                VkSemaphoreCreateInfo semaphoreInfo = {};
+                semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+                if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &submission.ownershipSemaphore) != VK_SUCCESS) {
+                    return false;
+                }
+            }
+        }
+
+        if (!GpuAllocator::get_instance().createBuffer(ringSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                m_ringBuffer, m_ringMemory)) {
+            return false;
+        }
+        m_ring = StagingRing(ringSize);
+        return true;
+    }
+
+    bool isInitialized() const { return m_ringBuffer != VK_NULL_HANDLE; }
+    bool usesDedicatedTransferQueue() const { return m_dedicatedTransfer; }
+
+    /**
+     * Record a copy of `data` into a buffer (dst needs VK_BUFFER_USAGE_TRANSFER_DST_BIT)
+     * @param dstAccess/dstStage How the buffer is consumed (e.g. vertex attribute read at vertex input)
+     */
+    void uploadBuffer(VkBuffer dst, VkDeviceSize dstOffset, const void* data, VkDeviceSize size,
+                      VkAccessFlags dstAccess, VkPipelineStageFlags dstStage) {
+        if (size == 0) {
+            return;
+        }
+        beginRecording();
+
+        VkBuffer source;
+        VkDeviceSize sourceOffset;
+        stage(data, size, 4, source, sourceOffset);
+
+        VkCommandBuffer commands = m_submissions[m_current].transferCommands;
+        VkBufferCopy copyRegion = {};
+        copyRegion.srcOffset = sourceOffset;
+        copyRegion.dstOffset = dstOffset;
+        copyRegion.size = size;
+        vkCmdCopyBuffer(commands, source, dst, 1, &copyRegion);
+
+        VkBufferMemoryBarrier barrier = {};
+        barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = dstAccess;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.buffer = dst;
+        barrier.offset = dstOffset;
+        barrier.size = size;
+
+        if (m_dedicatedTransfer) {
+            // Release on the transfer queue; the matching acquire is recorded at flush()
+            barrier.srcQueueFamilyIndex = m_transferFamily;
+            barrier.dstQueueFamilyIndex = m_graphicsFamily;
+            barrier.dstAccessMask = 0;
+            vkCmdPipelineBarrier(commands, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                                 0, 0, nullptr, 1, &barrier, 0, nullptr);
+            barrier.srcAccessMask = 0;
+            barrier.dstAccessMask = dstAccess;
+            m_bufferAcquires.push_back(barrier);
+            m_acquireStages |= dstStage;
+        } else {
+            vkCmdPipelineBarrier(commands, VK_PIPELINE_STAGE_TRANSFER_BIT, dstStage,
+                                 0, 0, nullptr, 1, &barrier, 0, nullptr);
+        }
+
+        m_stats.uploads++;
+        m_stats.uploadedBytes += size;
+    }
+
+    /**
+     * Record a copy of `data` into an image and leave it in SHADER_READ_ONLY_OPTIMAL
+     * @param regions Copy regions with bufferOffset relative to the start of `data`
+     * @param mipLevels/arrayLayers Subresources transitioned, starting at baseMipLevel. Their previous
+     *        contents are discarded; levels outside the range are untouched (mip streaming).
+     */
+    void uploadImage(VkImage image, const void* data, VkDeviceSize size,
+                     const std::vector<VkBufferImageCopy>& regions,
+                     uint32_t mipLevels, uint32_t arrayLayers = 1, uint32_t baseMipLevel = 0) {
+        if (size == 0 || regions.empty()) {
+            return;
+        }
+        beginRecording();
+
+        VkBuffer source;
+        VkDeviceSize sourceOffset;
+        stage(data, size, 16, source, sourceOffset);   // 16 covers BC block and texel alignment
+
+        VkCommandBuffer commands = m_submissions[m_current].transferCommands;
+
+        VkImageMemoryBarrier barrier = {};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = image;
+        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        barrier.subresourceRange.baseMipLevel = baseMipLevel;
+        barrier.subresourceRange.levelCount = mipLevels;
+        barrier.subresourceRange.baseArrayLayer = 0;
+        barrier.subresourceRange.layerCount = arrayLayers;
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        vkCmdPipelineBarrier(commands, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+        std::vector<VkBufferImageCopy> shifted(regions);
+        for (VkBufferImageCopy& region : shifted) {
+            region.bufferOffset += sourceOffset;
+        }
+        vkCmdCopyBufferToImage(commands, source, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                               static_cast<uint32_t>(shifted.size()), shifted.data());
+
+        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+        if (m_dedicatedTransfer) {
+            // Release (with the layout transition) here; the identical acquire runs on the graphics queue
+            barrier.srcQueueFamilyIndex = m_transferFamily;
+            barrier.dstQueueFamilyIndex = m_graphicsFamily;
+            barrier.dstAccessMask = 0;
+            vkCmdPipelineBarrier(commands, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                                 0, 0, nullptr, 0, nullptr, 1, &barrier);
+            barrier.srcAccessMask = 0;
+            barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            m_imageAcquires.push_back(barrier);
+            m_acquireStages |= VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        } else {
+            vkCmdPipelineBarrier(commands, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                                 0, 0, nullptr, 0, nullptr, 1, &barrier);
+        }
+
+        m_stats.uploads++;
+        m_stats.uploadedBytes += size;
+    }
+
+    /**
+     * Submit everything recorded since the last flush (no-op if nothing was recorded).
+     * Also recycles ring space from submissions that have completed.
+     * @return Id of the submission carrying the uploads (0 if nothing was submitted)
+     */
+    uint64_t flush() {
+        collect();
+        if (!m_recording) {
+            return 0;
+        }
+
+        Submission& submission = m_submissions[m_current];
+        submission.id = m_nextId++;
+        vkEndCommandBuffer(submission.transferCommands);
+
+        VkSubmitInfo submitInfo = {};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &submission.transferCommands;
+
+        if (m_dedicatedTransfer) {
+            submitInfo.signalSemaphoreCount = 1;
+            submitInfo.pSignalSemaphores = &submission.ownershipSemaphore;
+            vkQueueSubmit(m_transferQueue, 1, &submitInfo, VK_NULL_HANDLE);
+
+            // Acquire ownership on the graphics queue; the fence covers both submissions
+            vkResetCommandBuffer(submission.acquireCommands, 0);
+            VkCommandBufferBeginInfo beginInfo = {};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            vkBeginCommandBuffer(submission.acquireCommands, &beginInfo);
+            if (!m_bufferAcquires.empty() || !m_imageAcquires.empty()) {
+                vkCmdPipelineBarrier(submission.acquireCommands, VK_PIPELINE_STAGE_TRANSFER_BIT, m_acquireStages,
+                                     0, 0, nullptr,
+                                     static_cast<uint32_t>(m_bufferAcquires.size()), m_bufferAcquires.data(),
+                                     static_cast<uint32_t>(m_imageAcquires.size()), m_imageAcquires.data());
+            }
+            vkEndCommandBuffer(submission.acquireCommands);
+
+            VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+            VkSubmitInfo acquireInfo = {};
+            acquireInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            acquireInfo.waitSemaphoreCount = 1;
+            acquireInfo.pWaitSemaphores = &submission.ownershipSemaphore;
+            acquireInfo.pWaitDstStageMask = &waitStage;
+            acquireInfo.commandBufferCount = 1;
+            acquireInfo.pCommandBuffers = &submission.acquireCommands;
+            vkQueueSubmit(m_graphicsQueue, 1, &acquireInfo, submission.fence);
+
+            m_bufferAcquires.clear();
+            m_imageAcquires.clear();
+            m_acquireStages = 0;
+        } else {
+            vkQueueSubmit(m_transferQueue, 1, &submitInfo, submission.fence);
+        }
+
+        m_ring.submit(submission.id);
+        submission.inFlight = true;
+        m_recording = false;
+        m_current = (m_current + 1) % SUBMISSION_COUNT;
+        m_stats.submissions++;
+        return submission.id;
+    }
+
+    /**
+     * Retire submissions whose fences have signalled (non-blocking)
+     */
+    void collect() {
+        for (Submission& submission : m_submissions) {
+            if (submission.inFlight && vkGetFenceStatus(m_device, submission.fence) == VK_SUCCESS) {
+                retire(submission);
+            }
+        }
+    }
+
+    /**
+     * Id the next flush() will give to uploads being recorded now.
+     * Keep it with the destination so it can be waited on before destroying that resource.
+     */
+    uint64_t getRecordingId() const { return m_nextId; }
+
+    /**
+     * Whether the submission with this id (and every earlier one) has completed, as of the
+     * last flush()/collect(). Non-blocking; false while uploads under the id are still being recorded.
+     */
+    bool isComplete(uint64_t id) const {
+        if (id == 0 || m_device == VK_NULL_HANDLE) {
+            return true;
+        }
+        if (id >= m_nextId) {
+            return !m_recording;    // Recorded but not flushed yet (or nothing was recorded under it)
+        }
+        for (const Submission& submission : m_submissions) {
+            if (submission.inFlight && submission.id <= id) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Block until the submission with this id (and every earlier one) has completed,
+     * flushing first if it is still being recorded. Cheap when it already has.
+     */
+    void waitFor(uint64_t id) {
+        if (id == 0 || m_device == VK_NULL_HANDLE) {
+            return;
+        }
+        if (m_recording && id >= m_nextId) {
+            flush();
+        }
+        for (Submission& submission : m_submissions) {
+            if (submission.inFlight && submission.id <= id) {
+                waitAndRetire(submission);
+            }
+        }
+    }
+
+    /**
+     * Flush and block until every upload has completed (loading screens, shutdown)
+     */
+    void waitIdle() {
+        flush();
+        for (Submission& submission : m_submissions) {
+            waitAndRetire(submission);
+        }
+    }
+
+    /**
+     * Destroy the ring and Vulkan objects. Call before GpuAllocator::shutdown().
+     */
+    void shutdown() {
+        if (m_device == VK_NULL_HANDLE) {
+            return;
+        }
+        if (isInitialized()) {
+            waitIdle();
+        }
+
+        for (Submission& submission : m_submissions) {
+            if (submission.fence != VK_NULL_HANDLE) {
+                vkDestroyFence(m_device, submission.fence, nullptr);
+            }
+            if (submission.ownershipSemaphore != VK_NULL_HANDLE) {
+                vkDestroySemaphore(m_device, submission.ownershipSemaphore, nullptr);
+            }
+            submission = Submission();
+        }
+        if (m_transferPool != VK_NULL_HANDLE) {
+            vkDestroyCommandPool(m_device, m_transferPool, nullptr);   // Frees its command buffers
+            m_transferPool = VK_NULL_HANDLE;
+        }
+        if (m_graphicsPool != VK_NULL_HANDLE) {
+            vkDestroyCommandPool(m_device, m_graphicsPool, nullptr);
+            m_graphicsPool = VK_NULL_HANDLE;
+        }
+        if (m_ringBuffer != VK_NULL_HANDLE) {
+            vkDestroyBuffer(m_device, m_ringBuffer, nullptr);
+            m_ringBuffer = VK_NULL_HANDLE;
+        }
+        GpuAllocator::get_instance().free(m_ringMemory);
+        m_ring = StagingRing();
+        m_recording = false;
+        m_device = VK_NULL_HANDLE;
+    }
+
+    const Stats& getStats() const { return m_stats; }
+};
+
+#endif // EDEN_UPLOAD_QUEUE_H
@@ -0,0 +1,672 @@
+// EDEN ENGINE - Zstandard Decoder
+// Self-contained decompressor for zstd frames (RFC 8878), used for KTX2 supercompressed mip levels
+// Decode-only: no dictionaries, the optional content checksum is skipped rather than verified
+
+#ifndef EDEN_ZSTD_DECODER_H
+#define EDEN_ZSTD_DECODER_H
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <stdexcept>
+
+static const uint32_t ZSTD_MAGIC = 0xFD2FB528;
+static const uint32_t ZSTD_SKIPPABLE_MAGIC_MASK = 0xFFFFFFF0;
+static const uint32_t ZSTD_SKIPPABLE_MAGIC = 0x184D2A50;
+static const size_t ZSTD_MAX_BLOCK_SIZE = 128 * 1024;
+
+static inline int zstdHighBit(uint32_t value) {
+    int bit = 0;
+    while (value >>= 1) bit++;
+    return bit;
+}
+
+static inline void zstdCheck(bool condition, const char* message) {
+    if (!condition) {
+        throw std::runtime_error(std::string("zstd: ") + message);
+    }
+}
+
+// ---- Bit readers --------------------------------------------------------------
+
+// Forward little-endian bit reader (FSE table descriptions)
+struct ZstdForwardBits {
+    const uint8_t* data;
+    size_t size;
+    size_t bitPos = 0;
+
+    ZstdForwardBits(const uint8_t* d, size_t s) : data(d), size(s) {}
+
+    uint32_t peek(int bits) const {
+        uint64_t value = 0;
+        size_t byte = bitPos >> 3;
+        for (int i = 0; i < 8 && byte + i < size; i++) {
+            value |= static_cast<uint64_t>(data[byte + i]) << (i * 8);
+        }
+        return static_cast<uint32_t>((value >> (bitPos & 7)) & ((1ull << bits) - 1));
+    }
+    void consume(int bits) { bitPos += bits; }
+    size_t bytesConsumed() const { return (bitPos + 7) >> 3; }
+};
+
+/**
+ * Backward bit reader (FSE/Huffman payloads): the stream is read from its last byte towards
+ * its first, starting just below the highest set bit of the last byte (the end marker).
+ * Reading past the start yields zeros and makes overflowed() true.
+ */
+struct ZstdBackwardBits {
+    const uint8_t* data;
+    size_t size;
+    int64_t bitPos;     // Bits not yet consumed are [0, bitPos)
+
+    ZstdBackwardBits(const uint8_t* d, size_t s) : data(d), size(s) {
+        zstdCheck(s > 0 && d[s - 1] != 0, "corrupt bitstream end marker");
+        bitPos = static_cast<int64_t>(s - 1) * 8 + zstdHighBit(d[s - 1]);
+    }
+
+    uint64_t bitsAt(int64_t position, int bits) const {
+        if (bits <= 0) return 0;
+        if (position < 0) {
+            return bitsAt(0, bits + static_cast<int>(position)) << (-position);
+        }
+        size_t byte = static_cast<size_t>(position >> 3);
+        uint64_t value = 0;
+        if (byte + 8 <= size) {
+            memcpy(&value, data + byte, 8);
+        } else {
+            for (size_t i = 0; byte + i < size; i++) {
+                value |= static_cast<uint64_t>(data[byte + i]) << (i * 8);
+            }
+        }
+        return (value >> (position & 7)) & ((1ull << bits) - 1);
+    }
+
+    uint64_t read(int bits) {
+        if (bits == 0) return 0;
+        bitPos -= bits;
+        return bitsAt(bitPos, bits);
+    }
+    uint64_t peek(int bits) const { return bitsAt(bitPos - bits, bits); }
+    void consume(int bits) { bitPos -= bits; }
+    bool overflowed() const { return bitPos < 0; }
+    bool finished() const { return bitPos == 0; }
+};
+
+// ---- FSE ----------------------------------------------------------------------------
+
+struct ZstdFseEntry {
+    uint16_t baseline;      // Next state = baseline + read(bits)
+    uint8_t symbol;
+    uint8_t bits;
+};
+
+struct ZstdFseTable {
+    std::vector<ZstdFseEntry> entries;
+    int accuracyLog = 0;
+
+    // Build the decoding table from normalized counts (-1 = "less than one" probability)
+    void build(const int16_t* counts, int symbolCount, int log) {
+        accuracyLog = log;
+        uint32_t size = 1u << log;
+        entries.assign(size, ZstdFseEntry{0, 0, 0});
+        std::vector<uint16_t> next(symbolCount);
+
+        uint32_t highThreshold = size - 1;
+        for (int s = 0; s < symbolCount; s++) {
+            if (counts[s] == -1) {
+                entries[highThreshold--].symbol = static_cast<uint8_t>(s);
+                next[s] = 1;
+            } else {
+                next[s] = static_cast<uint16_t>(counts[s]);
+            }
+        }
+
+        uint32_t step = (size >> 1) + (size >> 3) + 3;
+        uint32_t mask = size - 1;
+        uint32_t position = 0;
+        for (int s = 0; s < symbolCount; s++) {
+            for (int i = 0; i < counts[s]; i++) {
+                entries[position].symbol = static_cast<uint8_t>(s);
+                do {
+                    position = (position + step) & mask;
+                } while (position > highThreshold);
+            }
+        }
+        zstdCheck(position == 0, "corrupt FSE distribution");
+
+        for (uint32_t u = 0; u < size; u++) {
+            uint32_t state = next[entries[u].symbol]++;
+            int bits = log - zstdHighBit(state);
+            entries[u].bits = static_cast<uint8_t>(bits);
+            entries[u].baseline = static_cast<uint16_t>((state << bits) - size);
+        }
+    }
+
+    // Single-symbol table (RLE mode): every state decodes `symbol` and reads no bits
+    void buildRle(uint8_t symbol) {
+        accuracyLog = 0;
+        entries.assign(1, ZstdFseEntry{0, symbol, 0});
+    }
+
+    /**
+     * Read a table description from a forward bitstream
+     * @return Bytes consumed
+     */
+    size_t read(const uint8_t* src, size_t size, int maxSymbol, int maxLog) {
+        ZstdForwardBits bits(src, size);
+        int log = static_cast<int>(bits.peek(4)) + 5;
+        bits.consume(4);
+        zstdCheck(log <= maxLog, "FSE accuracy log too large");
+
+        int16_t counts[256] = {};
+        int remaining = (1 << log) + 1;
+        int threshold = 1 << log;
+        int nbBits = log + 1;
+        int symbol = 0;
+        bool previousZero = false;
+        while (remaining > 1 && symbol <= maxSymbol) {
+            if (previousZero) {
+                int repeat;
+                do {
+                    repeat = static_cast<int>(bits.peek(2));
+                    bits.consume(2);
+                    symbol += repeat;
+                } while (repeat == 3);
+                zstdCheck(symbol <= maxSymbol, "FSE symbol out of range");
+                previousZero = false;
+                if (remaining <= 1) break;
+            }
+            int max = (2 * threshold - 1) - remaining;
+            int count;
+            uint32_t raw = bits.peek(nbBits);
+            if (static_cast<int>(raw & (threshold - 1)) < max) {
+                count = static_cast<int>(raw & (threshold - 1));
+                bits.consume(nbBits - 1);
+            } else {
+                count = static_cast<int>(raw & (2 * threshold - 1));
+                if (count >= threshold) count -= max;
+                bits.consume(nbBits);
+            }
+            count--;
+            remaining -= count < 0 ? -count : count;
+            zstdCheck(symbol <= maxSymbol, "FSE symbol out of range");
+            counts[symbol++] = static_cast<int16_t>(count);
+            previousZero = count == 0;
+            while (remaining < threshold) {
+                nbBits--;
+                threshold >>= 1;
+            }
+        }
+        zstdCheck(remaining == 1, "corrupt FSE table description");
+        zstdCheck(bits.bytesConsumed() <= size, "truncated FSE table description");
+        build(counts, symbol, log);
+        return bits.bytesConsumed();
+    }
+};
+
+struct ZstdFseState {
+    const ZstdFseTable* table = nullptr;
+    uint32_t state = 0;
+
+    void init(const ZstdFseTable& t, ZstdBackwardBits& bits) {
+        table = &t;
+        state = static_cast<uint32_t>(bits.read(t.accuracyLog));
+    }
+    uint8_t symbol() const { return table->entries[state].symbol; }
+    void update(ZstdBackwardBits& bits) {
+        const ZstdFseEntry& entry = table->entries[state];
+        state = entry.baseline + static_cast<uint32_t>(bits.read(entry.bits));
+    }
+};
+
+// ---- Huffman (literals) ----------------------------------------------------------------
+
+struct ZstdHuffmanTable {
+    std::vector<uint8_t> symbols;   // Indexed by the next maxBits bits
+    std::vector<uint8_t> lengths;
+    int maxBits = 0;
+
+    bool empty() const { return maxBits == 0; }
+
+    /**
+     * Read a Huffman tree description (direct 4-bit weights or FSE-compressed weights)
+     * @return Bytes consumed
+     */
+    size_t read(const uint8_t* src, size_t size) {
+        zstdCheck(size > 0, "missing Huffman tree description");
+        uint8_t header = src[0];
+        uint8_t weights[256] = {};
+        int weightCount = 0;
+        size_t consumed;
+
+        if (header >= 128) {
+            weightCount = header - 127;
+            size_t bytes = (weightCount + 1) / 2;
+            zstdCheck(1 + bytes <= size, "truncated Huffman weights");
+            for (int i = 0; i < weightCount; i++) {
+                uint8_t byte = src[1 + i / 2];
+                weights[i] = (i & 1) ? (byte & 15) : (byte >> 4);
+            }
+            consumed = 1 + bytes;
+        } else {
+            zstdCheck(1 + static_cast<size_t>(header) <= size, "truncated Huffman weights");
+            const uint8_t* payload = src + 1;
+            ZstdFseTable table;
+            size_t tableBytes = table.read(payload, header, 15, 6);
+            ZstdBackwardBits bits(payload + tableBytes, header - tableBytes);
+            ZstdFseState first, second;
+            first.init(table, bits);
+            second.init(table, bits);
+            while (true) {
+                zstdCheck(weightCount < 255, "too many Huffman weights");
+                weights[weightCount++] = first.symbol();
+                first.update(bits);
+                if (bits.overflowed()) {
+                    weights[weightCount++] = second.symbol();
+                    break;
+                }
+                zstdCheck(weightCount < 255, "too many Huffman weights");
+                weights[weightCount++] = second.symbol();
+                second.update(bits);
+                if (bits.overflowed()) {
+                    weights[weightCount++] = first.symbol();
+                    break;
+                }
+            }
+            consumed = 1 + header;
+        }
+
+        // The last symbol's weight is implied: it completes the total to a power of two
+        uint32_t total = 0;
+        for (int i = 0; i < weightCount; i++) {
+            zstdCheck(weights[i] <= 11, "Huffman weight too large");
+            if (weights[i] > 0) total += 1u << (weights[i] - 1);
+        }
+        zstdCheck(total > 0, "empty Huffman tree");
+        maxBits = zstdHighBit(total) + 1;
+        uint32_t remainder = (1u << maxBits) - total;
+        zstdCheck((remainder & (remainder - 1)) == 0 && maxBits <= 11, "corrupt Huffman tree");
+        weights[weightCount++] = static_cast<uint8_t>(zstdHighBit(remainder) + 1);
+
+        // Codes are assigned from the lowest weight (longest code) up, symbols ascending within a weight
+        symbols.assign(1u << maxBits, 0);
+        lengths.assign(1u << maxBits, 0);
+        uint32_t position = 0;
+        for (int weight = 1; weight <= maxBits; weight++) {
+            for (int s = 0; s < weightCount; s++) {
+                if (weights[s] != weight) continue;
+                uint32_t span = 1u << (weight - 1);
+                for (uint32_t i = 0; i < span; i++) {
+                    symbols[position + i] = static_cast<uint8_t>(s);
+                    lengths[position + i] = static_cast<uint8_t>(maxBits + 1 - weight);
+                }
+                position += span;
+            }
+        }
+        return consumed;
+    }
+
+    void decodeStream(const uint8_t* src, size_t size, uint8_t* out, size_t count) const {
+        ZstdBackwardBits bits(src, size);
+        for (size_t i = 0; i < count; i++) {
+            uint32_t index = static_cast<uint32_t>(bits.peek(maxBits));
+            out[i] = symbols[index];
+            bits.consume(lengths[index]);
+        }
+        zstdCheck(bits.finished(), "corrupt Huffman stream");
+    }
+};
+
+// ---- Sequences ------------------------------------------------------------------------------
+
+static const uint32_t ZSTD_LL_BASE[36] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    16, 18, 20, 22, 24, 28, 32, 40, 48, 64, 128, 256, 512, 1024, 2048, 4096,
+    8192, 16384, 32768, 65536};
+static const uint8_t ZSTD_LL_BITS[36] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 1, 1, 1, 2, 2, 3, 3, 4, 6, 7, 8, 9, 10, 11, 12,
+    13, 14, 15, 16};
+static const uint32_t ZSTD_ML_BASE[53] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18,
+    19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34,
+    35, 37, 39, 41, 43, 47, 51, 59, 67, 83, 99, 131, 259, 515, 1027, 2051,
+    4099, 8195, 16387, 32771, 65539};
+static const uint8_t ZSTD_ML_BITS[53] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 1, 1, 1, 2, 2, 3, 3, 4, 4, 5, 7, 8, 9, 10, 11,
+    12, 13, 14, 15, 16};
+
+static const int16_t ZSTD_LL_DEFAULT[36] = {
+    4, 3, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 3, 2, 1, 1, 1, 1, 1,
+    -1, -1, -1, -1};
+static const int16_t ZSTD_ML_DEFAULT[53] = {
+    1, 4, 3, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, -1, -1,
+    -1, -1, -1, -1, -1};
+static const int16_t ZSTD_OF_DEFAULT[29] = {
+    1, 1, 1, 1, 1, 1, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, -1, -1, -1, -1, -1};
+
+// State carried between the blocks of one frame (repeat tables, repeat offsets)
+struct ZstdFrameState {
+    ZstdHuffmanTable huffman;
+    ZstdFseTable literalLengths, offsets, matchLengths;
+    bool haveLL = false, haveOF = false, haveML = false;
+    uint32_t repeat[3] = {1, 4, 8};
+};
+
+/**
+ * Read one sequence-table description (predefined / RLE / FSE / repeat)
+ * @return Bytes consumed
+ */
+static size_t zstdReadSequenceTable(int mode, const uint8_t* src, size_t size, ZstdFseTable& table, bool& have,
+                                    const int16_t* defaults, int defaultCount, int defaultLog,
+                                    int maxSymbol, int maxLog) {
+    switch (mode) {
+        case 0:
+            table.build(defaults, defaultCount, defaultLog);
+            have = true;
+            return 0;
+        case 1:
+            zstdCheck(size >= 1, "truncated RLE sequence table");
+            zstdCheck(src[0] <= maxSymbol, "RLE symbol out of range");
+            table.buildRle(src[0]);
+            have = true;
+            return 1;
+        case 2: {
+            size_t consumed = table.read(src, size, maxSymbol, maxLog);
+            have = true;
+            return consumed;
+        }
+        default:
+            zstdCheck(have, "repeat mode without a previous table");
+            return 0;
+    }
+}
+
+// ---- Blocks --------------------------------------------------------------------------------
+
+/**
+ * Decode the literals section of a compressed block
+ * @return Bytes consumed
+ */
+static size_t zstdDecodeLiterals(const uint8_t* src, size_t size, ZstdFrameState& state, std::vector<uint8_t>& literals) {
+    zstdCheck(size >= 1, "truncated literals section");
+    int type = src[0] & 3;
+    int sizeFormat = (src[0] >> 2) & 3;
+
+    if (type == 0 || type == 1) {
+        size_t regenerated, headerSize;
+        switch (sizeFormat) {
+            case 0:
+            case 2:
+                regenerated = src[0] >> 3;
+                headerSize = 1;
+                break;
+            case 1:
+                zstdCheck(size >= 2, "truncated literals header");
+                regenerated = (src[0] >> 4) + (static_cast<size_t>(src[1]) << 4);
+                headerSize = 2;
+                break;
+            default:
+                zstdCheck(size >= 3, "truncated literals header");
+                regenerated = (src[0] >> 4) + (static_cast<size_t>(src[1]) << 4) + (static_cast<size_t>(src[2]) << 12);
+                headerSize = 3;
+                break;
+        }
+        zstdCheck(regenerated <= ZSTD_MAX_BLOCK_SIZE, "literals too large");
+        if (type == 0) {
+            zstdCheck(headerSize + regenerated <= size, "truncated raw literals");
+            literals.assign(src + headerSize, src + headerSize + regenerated);
+            return headerSize + regenerated;
+        }
+        zstdCheck(headerSize + 1 <= size, "truncated RLE literals");
+        literals.assign(regenerated, src[headerSize]);
+        return headerSize + 1;
+    }
+
+    // Huffman-compressed (type 2) or treeless (type 3, reuses the previous tree)
+    size_t headerSize = sizeFormat < 2 ? 3 : sizeFormat == 2 ? 4 : 5;
+    int sizeBits = sizeFormat < 2 ? 10 : sizeFormat == 2 ? 14 : 18;
+    zstdCheck(size >= headerSize, "truncated literals header");
+    uint64_t header = 0;
+    for (size_t i = 0; i < headerSize; i++) header |= static_cast<uint64_t>(src[i]) << (i * 8);
+    size_t regenerated = static_cast<size_t>((header >> 4) & ((1u << sizeBits) - 1));
+    size_t compressed = static_cast<size_t>((header >> (4 + sizeBits)) & ((1u << sizeBits) - 1));
+    bool fourStreams = sizeFormat != 0;
+    zstdCheck(regenerated <= ZSTD_MAX_BLOCK_SIZE, "literals too large");
+    zstdCheck(headerSize + compressed <= size, "truncated compressed literals");
+
+    const uint8_t* payload = src + headerSize;
+    size_t payloadSize = compressed;
+    if (type == 2) {
+        size_t treeSize = state.huffman.read(payload, payloadSize);
+        payload += treeSize;
+        payloadSize -= treeSize;
+    } else {
+        zstdCheck(!state.huffman.empty(), "treeless literals without a previous tree");
+    }
+
+    literals.resize(regenerated);
+    if (!fourStreams) {
+        state.huffman.decodeStream(payload, payloadSize, literals.data(), regenerated);
+    } else {
+        zstdCheck(payloadSize >= 6, "truncated literals jump table");
+        size_t streamSizes[4];
+        streamSizes[0] = payload[0] | (payload[1] << 8);
+        streamSizes[1] = payload[2] | (payload[3] << 8);
+        streamSizes[2] = payload[4] | (payload[5] << 8);
+        size_t used = 6 + streamSizes[0] + streamSizes[1] + streamSizes[2];
+        zstdCheck(used <= payloadSize, "corrupt literals jump table");
+        streamSizes[3] = payloadSize - used;
+        size_t segment = (regenerated + 3) / 4;
+        const uint8_t* stream = payload + 6;
+        size_t outOffset = 0;
+        for (int i = 0; i < 4; i++) {
+            size_t count = i < 3 ? segment : regenerated - 3 * segment;
+            zstdCheck(outOffset + count <= regenerated, "corrupt literals sizes");
+            state.huffman.decodeStream(stream, streamSizes[i], literals.data() + outOffset, count);
+            stream += streamSizes[i];
+            outOffset += count;
+        }
+    }
+    return headerSize + compressed;
+}
+
+static void zstdDecodeCompressedBlock(const uint8_t* src, size_t size, ZstdFrameState& state, std::vector<uint8_t>& out) {
+    std::vector<uint8_t> literals;
+    size_t position = zstdDecodeLiterals(src, size, state, literals);
+
+    // Sequences section header
+    zstdCheck(position < size || position == size, "truncated block");
+    uint32_t sequenceCount = 0;
+    if (position < size) {
+        uint8_t byte0 = src[position++];
+        if (byte0 < 128) {
+            sequenceCount = byte0;
+        } else if (byte0 < 255) {
+            zstdCheck(position < size, "truncated sequence count");
+            sequenceCount = ((byte0 - 128u) << 8) + src[position++];
+        } else {
+            zstdCheck(position + 2 <= size, "truncated sequence count");
+            sequenceCount = src[position] + (static_cast<uint32_t>(src[position + 1]) << 8) + 0x7F00;
+            position += 2;
+        }
+    }
+
+    if (sequenceCount == 0) {
+        out.insert(out.end(), literals.begin(), literals.end());
+        return;
+    }
+
+    zstdCheck(position < size, "missing sequence compression modes");
+    uint8_t modes = src[position++];
+    zstdCheck((modes & 3) == 0, "reserved sequence mode bits set");
+    position += zstdReadSequenceTable((modes >> 6) & 3, src + position, size - position, state.literalLengths,
+                                      state.haveLL, ZSTD_LL_DEFAULT, 36, 6, 35, 9);
+    position += zstdReadSequenceTable((modes >> 4) & 3, src + position, size - position, state.offsets,
+                                      state.haveOF, ZSTD_OF_DEFAULT, 29, 5, 31, 8);
+    position += zstdReadSequenceTable((modes >> 2) & 3, src + position, size - position, state.matchLengths,
+                                      state.haveML, ZSTD_ML_DEFAULT, 53, 6, 52, 9);
+    zstdCheck(position < size, "missing sequence bitstream");
+
+    ZstdBackwardBits bits(src + position, size - position);
+    ZstdFseState llState, ofState, mlState;
+    llState.init(state.literalLengths, bits);
+    ofState.init(state.offsets, bits);
+    mlState.init(state.matchLengths, bits);
+
+    size_t literalPos = 0;
+    for (uint32_t i = 0; i < sequenceCount; i++) {
+        uint8_t ofCode = ofState.symbol();
+        uint8_t mlCode = mlState.symbol();
+        uint8_t llCode = llState.symbol();
+        zstdCheck(ofCode <= 31 && mlCode <= 52 && llCode <= 35, "sequence code out of range");
+
+        uint32_t offsetValue = (1u << ofCode) + static_cast<uint32_t>(bits.read(ofCode));
+        uint32_t matchLength = ZSTD_ML_BASE[mlCode] + static_cast<uint32_t>(bits.read(ZSTD_ML_BITS[mlCode]));
+        uint32_t literalLength = ZSTD_LL_BASE[llCode] + static_cast<uint32_t>(bits.read(ZSTD_LL_BITS[llCode]));
+
+        // Offsets 1-3 refer to recent offsets (shifted by one when there are no literals)
+        uint32_t offset;
+        if (offsetValue > 3) {
+            offset = offsetValue - 3;
+            state.repeat[2] = state.repeat[1];
+            state.repeat[1] = state.repeat[0];
+            state.repeat[0] = offset;
+        } else {
+            uint32_t index = offsetValue - 1 + (literalLength == 0 ? 1 : 0);
+            if (index == 0) {
+                offset = state.repeat[0];
+            } else {
+                offset = index == 3 ? state.repeat[0] - 1 : state.repeat[index];
+                if (index != 1) state.repeat[2] = state.repeat[1];
+                state.repeat[1] = state.repeat[0];
+                state.repeat[0] = offset;
+            }
+        }
+
+        if (i + 1 < sequenceCount) {
+            llState.update(bits);
+            mlState.update(bits);
+            ofState.update(bits);
+        }
+
+        zstdCheck(literalPos + literalLength <= literals.size(), "sequence overruns literals");
+        out.insert(out.end(), literals.begin() + literalPos, literals.begin() + literalPos + literalLength);
+        literalPos += literalLength;
+
+        zstdCheck(offset > 0 && offset <= out.size(), "match offset out of range");
+        size_t from = out.size() - offset;
+        out.resize(out.size() + matchLength);
+        uint8_t* dst = out.data() + out.size() - matchLength;
+        const uint8_t* match = out.data() + from;
+        if (offset >= matchLength) {
+            memcpy(dst, match, matchLength);
+        } else {
+            for (uint32_t k = 0; k < matchLength; k++) dst[k] = match[k];     // Overlapping copy
+        }
+    }
+    zstdCheck(bits.finished(), "corrupt sequence bitstream");
+    out.insert(out.end(), literals.begin() + literalPos, literals.end());
+}
+
+// ---- Frames -----------------------------------------------------------------------------------
+
+/**
+ * Decompress every frame in `src` (skippable frames are ignored)
+ * @param expectedSize Decompressed size if known (reserves the output; 0 = unknown)
+ * @throws std::runtime_error on malformed input or dictionary-compressed frames
+ */
+inline std::vector<uint8_t> zstd_decompress(const uint8_t* src, size_t size, size_t expectedSize = 0) {
+    std::vector<uint8_t> out;
+    out.reserve(expectedSize);
+    size_t position = 0;
+
+    while (position < size) {
+        zstdCheck(position + 4 <= size, "truncated frame magic");
+        uint32_t magic;
+        memcpy(&magic, src + position, 4);
+        position += 4;
+
+        if ((magic & ZSTD_SKIPPABLE_MAGIC_MASK) == ZSTD_SKIPPABLE_MAGIC) {
+            zstdCheck(position + 4 <= size, "truncated skippable frame");
+            uint32_t skip;
+            memcpy(&skip, src + position, 4);
+            zstdCheck(position + 4 + skip <= size, "truncated skippable frame");
+            position += 4 + skip;
+            continue;
+        }
+        zstdCheck(magic == ZSTD_MAGIC, "bad frame magic");
+
+        zstdCheck(position < size, "truncated frame header");
+        uint8_t descriptor = src[position++];
+        int contentSizeFlag = descriptor >> 6;
+        bool singleSegment = (descriptor >> 5) & 1;
+        bool hasChecksum = (descriptor >> 2) & 1;
+        int dictionaryFlag = descriptor & 3;
+        zstdCheck((descriptor & 0x08) == 0, "reserved frame header bit set");
+
+        size_t headerBytes = (singleSegment ? 0 : 1) + (dictionaryFlag == 3 ? 4 : dictionaryFlag) +
+                             (contentSizeFlag == 0 ? (singleSegment ? 1 : 0) : (1u << contentSizeFlag));
+        zstdCheck(position + headerBytes <= size, "truncated frame header");
+        if (!singleSegment) position++;                 // Window descriptor (the output is one buffer)
+        uint32_t dictionaryId = 0;
+        for (int i = 0; i < (dictionaryFlag == 3 ? 4 : dictionaryFlag); i++) {
+            dictionaryId |= static_cast<uint32_t>(src[position++]) << (i * 8);
+        }
+        zstdCheck(dictionaryId == 0, "dictionaries are not supported");
+        size_t contentSizeBytes = contentSizeFlag == 0 ? (singleSegment ? 1 : 0) : (1u << contentSizeFlag);
+        uint64_t contentSize = 0;
+        for (size_t i = 0; i < contentSizeBytes; i++) {
+            contentSize |= static_cast<uint64_t>(src[position++]) << (i * 8);
+        }
+        if (contentSizeFlag == 1) contentSize += 256;
+        if (contentSizeBytes > 0 && out.capacity() < out.size() + contentSize) {
+            out.reserve(out.size() + static_cast<size_t>(contentSize));
+        }
+
+        ZstdFrameState state;
+        bool last = false;
+        while (!last) {
+            zstdCheck(position + 3 <= size, "truncated block header");
+            uint32_t header = src[position] | (src[position + 1] << 8) | (src[position + 2] << 16);
+            position += 3;
+            last = header & 1;
+            int type = (header >> 1) & 3;
+            size_t blockSize = header >> 3;
+
+            switch (type) {
+                case 0:     // Raw
+                    zstdCheck(position + blockSize <= size, "truncated raw block");
+                    out.insert(out.end(), src + position, src + position + blockSize);
+                    position += blockSize;
+                    break;
+                case 1:     // RLE: one byte repeated blockSize times
+                    zstdCheck(position + 1 <= size, "truncated RLE block");
+                    out.insert(out.end(), blockSize, src[position]);
+                    position += 1;
+                    break;
+                case 2:
+                    zstdCheck(position + blockSize <= size && blockSize <= ZSTD_MAX_BLOCK_SIZE, "truncated compressed block");
+                    zstdDecodeCompressedBlock(src + position, blockSize, state, out);
+                    position += blockSize;
+                    break;
+                default:
+                    zstdCheck(false, "reserved block type");
+            }
+        }
+        if (hasChecksum) {
+            zstdCheck(position + 4 <= size, "truncated content checksum");
+            position += 4;
+        }
+    }
+    return out;
+}
+
+#endif // EDEN_ZSTD_DECODER_H
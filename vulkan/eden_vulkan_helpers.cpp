@@ -33,7 +33,19 @@
 #include "../stdlib/png_loader.h"
 #include "../stdlib/texture_resource.h"
 #include "../stdlib/mesh_resource.h"
+#include "../stdlib/gpu_allocator.h"
+#include "../stdlib/upload_queue.h"
+#include "../stdlib/pipeline_cache.h"
+#include "../stdlib/shader_compiler.h"
+#include "../stdlib/file_watcher.h"
 #include "../stdlib/resource.h"
+#include "../stdlib/spatial_audio.h"
+#include "../stdlib/instance_batch.h"
+#include "../stdlib/debug_draw.h"
+#include "../stdlib/frustum_culler.h"
+#include "../stdlib/bvh.h"
+#include "../stdlib/broadphase.h"
+#include "../stdlib/rigid_body.h"
 
 // ImGui includes (if available)
 #ifdef USE_IMGUI
@@ -68,28 +80,42 @@ VkPipeline g_cubePipeline = VK_NULL_HANDLE;
 VkPipelineLayout g_pipelineLayout = VK_NULL_HANDLE;
 // Vertex buffers for custom shaders (when they need vertex input)
 VkBuffer g_triangleVertexBuffer = VK_NULL_HANDLE;
-VkDeviceMemory g_triangleVertexBufferMemory = VK_NULL_HANDLE;
+GpuAllocation g_triangleVertexBufferMemory;
 bool g_usingCustomShaders = false; // Track if we're using custom shaders that need vertex buffers
 std::vector<VkFramebuffer> g_framebuffers;
 VkCommandPool g_commandPool = VK_NULL_HANDLE;
 std::vector<VkCommandBuffer> g_commandBuffers;  // Already non-static, accessible to NEUROSHELL
 VkQueue g_graphicsQueue = VK_NULL_HANDLE;
 static uint32_t g_graphicsQueueFamilyIndex = 0;
-static uint32_t g_currentFrame = 0;
+static VkQueue g_transferQueue = VK_NULL_HANDLE;            // Dedicated DMA queue if the device has one
+static uint32_t g_transferQueueFamilyIndex = 0;             // == graphics family when there is none
 VkExtent2D g_swapchainExtent = {};  // Made non-static for NEUROSHELL access
 
 // Additional state
 static std::vector<VkImage> g_swapchainImages;
 static std::vector<VkImageView> g_swapchainImageViews;
-VkSemaphore g_imageAvailableSemaphore = VK_NULL_HANDLE;  // Made non-static for NEUROSHELL access
-VkSemaphore g_renderFinishedSemaphore = VK_NULL_HANDLE;  // Made non-static for NEUROSHELL access
-VkFence g_inFlightFence = VK_NULL_HANDLE;  // Made non-static for NEUROSHELL access
+
+// Frames in flight: the CPU records frame N+1 while the GPU still renders frame N
+// Each frame slot owns an acquire semaphore and a fence; command buffers, uniform buffers and
+// descriptor sets stay per swapchain image and are reused only once the fence of the frame that
+// last rendered that image has signaled (g_imagesInFlight)
+struct FrameSync {
+    VkSemaphore imageAvailable = VK_NULL_HANDLE;
+    VkFence inFlight = VK_NULL_HANDLE;
+};
+static const uint32_t MAX_FRAMES_IN_FLIGHT = 3;
+static uint32_t g_framesInFlight = 2;                      // Set with heidic_set_frames_in_flight before init
+static std::vector<FrameSync> g_frameSync;
+static uint32_t g_currentFrame = 0;                        // Frame slot being recorded
+static std::vector<VkFence> g_imagesInFlight;              // Per swapchain image: fence of its last frame
+static std::vector<VkSemaphore> g_renderFinishedSemaphores;  // Per swapchain image (waited on by present)
 static uint32_t g_swapchainImageCount = 0;
+static std::string g_pipelineCachePath = "pipeline_cache.bin";   // Set with heidic_set_pipeline_cache_path
 static VkFormat g_swapchainImageFormat = VK_FORMAT_UNDEFINED;
 
 // Depth buffer
 static VkImage g_depthImage = VK_NULL_HANDLE;
-static VkDeviceMemory g_depthImageMemory = VK_NULL_HANDLE;
+static GpuAllocation g_depthImageMemory;
 static VkImageView g_depthImageView = VK_NULL_HANDLE;
 static VkFormat g_depthFormat = VK_FORMAT_D32_SFLOAT;
 
@@ -98,7 +124,7 @@ static VkDescriptorSetLayout g_descriptorSetLayout = VK_NULL_HANDLE;
 static VkDescriptorPool g_descriptorPool = VK_NULL_HANDLE;
 static std::vector<VkDescriptorSet> g_descriptorSets;
 static std::vector<VkBuffer> g_uniformBuffers;
-static std::vector<VkDeviceMemory> g_uniformBuffersMemory;
+static std::vector<GpuAllocation> g_uniformBuffersMemory;
 
 // ImGui state
 #ifdef USE_IMGUI
@@ -125,7 +151,9 @@ extern "C" void heidic_set_rotation_speed(float speed) {
 }
 
 // Helper to read binary file (for shaders)
-static std::vector<char> readFile(const std::string& filename) {
+// Locate a file in the project directory, its parents, or the example/shader folders
+// Returns an empty string if it is in none of them
+static std::string findFile(const std::string& filename) {
     std::vector<std::string> paths = {
         filename,  // Current directory (project directory)
         "../" + filename,
@@ -148,18 +176,58 @@ static std::vector<char> readFile(const std::string& filename) {
     };
     
     for (const auto& path : paths) {
-        std::ifstream file(path, std::ios::ate | std::ios::binary);
+        std::ifstream file(path, std::ios::binary);
         if (file.is_open()) {
-            size_t fileSize = (size_t) file.tellg();
-            std::vector<char> buffer(fileSize);
-            file.seekg(0);
-            file.read(buffer.data(), fileSize);
-            file.close();
-            return buffer;
+            return path;
         }
     }
-    
-    throw std::runtime_error("failed to open file: " + filename);
+    return std::string();
+}
+
+static std::vector<char> readFile(const std::string& filename) {
+    std::string path = findFile(filename);
+    std::ifstream file(path, std::ios::ate | std::ios::binary);
+    if (path.empty() || !file.is_open()) {
+        throw std::runtime_error("failed to open file: " + filename);
+    }
+    size_t fileSize = (size_t) file.tellg();
+    std::vector<char> buffer(fileSize);
+    file.seekg(0);
+    file.read(buffer.data(), fileSize);
+    return buffer;
+}
+
+// Compile a GLSL source through the shader compile service (cached by content, includes and
+// defines). Include files are registered with the FileWatcher so editing one reloads its users.
+static bool compileShaderSource(const std::string& sourcePath, std::vector<char>& code) {
+    ShaderCompileResult result = ShaderCompiler::get_instance().compile(sourcePath);
+    if (!result.ok) {
+        std::cerr << "[Shader] ERROR: Failed to compile " << sourcePath << ":\n" << result.log << std::endl;
+        return false;
+    }
+    for (const std::string& include : result.includes) {
+        FileWatcher::get_instance().watch(include);
+    }
+    const char* bytes = reinterpret_cast<const char*>(result.spirv.data());
+    code.assign(bytes, bytes + result.spirv.size() * sizeof(uint32_t));
+    return true;
+}
+
+// Load a shader by its .spv name. If the GLSL source is found (x.vert.spv <- x.vert,
+// x.spv <- x.glsl) it is compiled through the shader cache; the .spv is the fallback when there
+// is no source or no compiler. Throws like readFile if neither can be loaded.
+static std::vector<char> loadShaderCode(const std::string& spvName) {
+    std::string base = spvName.size() > 4 && spvName.compare(spvName.size() - 4, 4, ".spv") == 0
+        ? spvName.substr(0, spvName.size() - 4) : std::string();
+    if (!base.empty()) {
+        std::string source = shader_stage_from_path(base) != ShaderStageKind::Unknown ? base : base + ".glsl";
+        std::string sourcePath = shader_stage_from_path(source) != ShaderStageKind::Unknown ? findFile(source) : std::string();
+        std::vector<char> code;
+        if (!sourcePath.empty() && compileShaderSource(sourcePath, code)) {
+            return code;
+        }
+    }
+    return readFile(spvName);
 }
 
 // Helper to find graphics queue family
@@ -181,46 +249,27 @@ static uint32_t findGraphicsQueueFamily(VkPhysicalDevice device, VkSurfaceKHR su
     return UINT32_MAX;
 }
 
-// Helper to find memory type
-static uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
-    VkPhysicalDeviceMemoryProperties memProperties;
-    vkGetPhysicalDeviceMemoryProperties(g_physicalDevice, &memProperties);
-
-    for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
-        if ((typeFilter & (1 << i)) && (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+// Helper to find a transfer-only queue family (copy engine); UINT32_MAX if the device has none
+static uint32_t findTransferQueueFamily(VkPhysicalDevice device) {
+    uint32_t queueFamilyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, queueFamilies.data());
+    
+    for (uint32_t i = 0; i < queueFamilyCount; i++) {
+        VkQueueFlags flags = queueFamilies[i].queueFlags;
+        if ((flags & VK_QUEUE_TRANSFER_BIT) && !(flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT))) {
             return i;
         }
     }
-    return 0; 
+    return UINT32_MAX;
 }
 
-// Helper to create buffer
-static void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& bufferMemory) {
-    VkBufferCreateInfo bufferInfo = {};
-    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    bufferInfo.size = size;
-    bufferInfo.usage = usage;
-    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-
-    if (vkCreateBuffer(g_device, &bufferInfo, nullptr, &buffer) != VK_SUCCESS) {
+// Helper to create buffer (memory is sub-allocated from the shared GpuAllocator)
+static void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, GpuAllocation& bufferMemory) {
+    if (!GpuAllocator::get_instance().createBuffer(size, usage, properties, buffer, bufferMemory)) {
         std::cerr << "[EDEN] Failed to create buffer!" << std::endl;
-        return;
-    }
-
-    VkMemoryRequirements memRequirements;
-    vkGetBufferMemoryRequirements(g_device, buffer, &memRequirements);
-
-    VkMemoryAllocateInfo allocInfo = {};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, properties);
-
-    if (vkAllocateMemory(g_device, &allocInfo, nullptr, &bufferMemory) != VK_SUCCESS) {
-        std::cerr << "[EDEN] Failed to allocate buffer memory!" << std::endl;
-        return;
     }
-
-    vkBindBufferMemory(g_device, buffer, bufferMemory, 0);
 }
 
 // Helper to find supported format
@@ -238,7 +287,7 @@ static VkFormat findSupportedFormat(const std::vector<VkFormat>& candidates, VkI
 }
 
 // Helper to create image
-static void createImage(uint32_t width, uint32_t height, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImage& image, VkDeviceMemory& imageMemory) {
+static void createImage(uint32_t width, uint32_t height, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImage& image, GpuAllocation& imageMemory) {
     VkImageCreateInfo imageInfo = {};
     imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
     imageInfo.imageType = VK_IMAGE_TYPE_2D;
@@ -254,25 +303,9 @@ static void createImage(uint32_t width, uint32_t height, VkFormat format, VkImag
     imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
     imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
-    if (vkCreateImage(g_device, &imageInfo, nullptr, &image) != VK_SUCCESS) {
+    if (!GpuAllocator::get_instance().createImage(imageInfo, properties, image, imageMemory)) {
         std::cerr << "[EDEN] Failed to create image!" << std::endl;
-        return;
-    }
-
-    VkMemoryRequirements memRequirements;
-    vkGetImageMemoryRequirements(g_device, image, &memRequirements);
-
-    VkMemoryAllocateInfo allocInfo = {};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, properties);
-
-    if (vkAllocateMemory(g_device, &allocInfo, nullptr, &imageMemory) != VK_SUCCESS) {
-        std::cerr << "[EDEN] Failed to allocate image memory!" << std::endl;
-        return;
     }
-
-    vkBindImageMemory(g_device, image, imageMemory, 0);
 }
 
 // Create depth buffer
@@ -303,6 +336,201 @@ static void createDepthResources() {
     }
 }
 
+// Create per-frame fences/semaphores (g_framesInFlight slots) and per-image present semaphores
+static bool createFrameSyncObjects() {
+    VkSemaphoreCreateInfo semaphoreInfo = {};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    
+    VkFenceCreateInfo fenceInfo = {};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+    
+    g_frameSync.resize(g_framesInFlight);
+    for (FrameSync& frame : g_frameSync) {
+        if (vkCreateSemaphore(g_device, &semaphoreInfo, nullptr, &frame.imageAvailable) != VK_SUCCESS ||
+            vkCreateFence(g_device, &fenceInfo, nullptr, &frame.inFlight) != VK_SUCCESS) {
+            return false;
+        }
+    }
+    g_renderFinishedSemaphores.resize(g_swapchainImageCount, VK_NULL_HANDLE);
+    for (VkSemaphore& semaphore : g_renderFinishedSemaphores) {
+        if (vkCreateSemaphore(g_device, &semaphoreInfo, nullptr, &semaphore) != VK_SUCCESS) {
+            return false;
+        }
+    }
+    g_imagesInFlight.assign(g_swapchainImageCount, VK_NULL_HANDLE);
+    g_currentFrame = 0;
+    return true;
+}
+
+static void destroyFrameSyncObjects() {
+    for (FrameSync& frame : g_frameSync) {
+        if (frame.imageAvailable != VK_NULL_HANDLE) {
+            vkDestroySemaphore(g_device, frame.imageAvailable, nullptr);
+        }
+        if (frame.inFlight != VK_NULL_HANDLE) {
+            vkDestroyFence(g_device, frame.inFlight, nullptr);
+        }
+    }
+    for (VkSemaphore semaphore : g_renderFinishedSemaphores) {
+        if (semaphore != VK_NULL_HANDLE) {
+            vkDestroySemaphore(g_device, semaphore, nullptr);
+        }
+    }
+    g_frameSync.clear();
+    g_renderFinishedSemaphores.clear();
+    g_imagesInFlight.clear();
+    g_currentFrame = 0;
+}
+
+// Start a frame: wait until this frame slot's previous submission is done, acquire a swapchain
+// image and wait for whichever older frame still renders to that image. After this the image's
+// command buffer, uniform buffer and descriptor set, and this slot's ring buffer regions, are free.
+// Returns false if no image was acquired (nothing must be submitted then).
+static bool beginFrame(uint32_t& imageIndex) {
+    if (g_frameSync.empty()) {
+        return false;
+    }
+    FrameSync& frame = g_frameSync[g_currentFrame];
+    vkWaitForFences(g_device, 1, &frame.inFlight, VK_TRUE, UINT64_MAX);
+    
+    VkResult result = vkAcquireNextImageKHR(g_device, g_swapchain, UINT64_MAX, frame.imageAvailable, VK_NULL_HANDLE, &imageIndex);
+    if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
+        return false;
+    }
+    
+    if (g_imagesInFlight[imageIndex] != VK_NULL_HANDLE && g_imagesInFlight[imageIndex] != frame.inFlight) {
+        vkWaitForFences(g_device, 1, &g_imagesInFlight[imageIndex], VK_TRUE, UINT64_MAX);
+    }
+    g_imagesInFlight[imageIndex] = frame.inFlight;
+    
+    // Swap in hot-reloaded pipelines that finished compiling, before this frame records
+    PipelineCache::get_instance().update();
+    return true;
+}
+
+// Replace this frame slot's semaphore and fence after a failed submit. The fence was already reset
+// and the acquire semaphore is still pending, so waiting on or reusing either would hang. The new
+// fence starts signaled, and images that last rendered on the old one no longer wait on it.
+static void recreateFrameSlot() {
+    FrameSync& frame = g_frameSync[g_currentFrame];
+    vkDeviceWaitIdle(g_device);
+    for (VkFence& fence : g_imagesInFlight) {
+        if (fence == frame.inFlight) {
+            fence = VK_NULL_HANDLE;
+        }
+    }
+    vkDestroySemaphore(g_device, frame.imageAvailable, nullptr);
+    vkDestroyFence(g_device, frame.inFlight, nullptr);
+    frame.imageAvailable = VK_NULL_HANDLE;
+    frame.inFlight = VK_NULL_HANDLE;
+    
+    VkSemaphoreCreateInfo semaphoreInfo = {};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    VkFenceCreateInfo fenceInfo = {};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+    if (vkCreateSemaphore(g_device, &semaphoreInfo, nullptr, &frame.imageAvailable) != VK_SUCCESS ||
+        vkCreateFence(g_device, &fenceInfo, nullptr, &frame.inFlight) != VK_SUCCESS) {
+        std::cerr << "[EDEN] ERROR: Failed to recreate frame sync objects!" << std::endl;
+    }
+}
+
+// Finish a frame: submit the image's command buffer on this slot's fence, present, and advance to
+// the next frame slot without waiting for the GPU. Returns false if the submit failed; the slot's
+// sync objects are recreated then, so the next beginFrame does not wait on a fence nothing signals.
+static bool submitFrame(uint32_t imageIndex) {
+    FrameSync& frame = g_frameSync[g_currentFrame];
+    
+    VkSubmitInfo submitInfo = {};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    
+    VkSemaphore waitSemaphores[] = {frame.imageAvailable};
+    VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
+    submitInfo.waitSemaphoreCount = 1;
+    submitInfo.pWaitSemaphores = waitSemaphores;
+    submitInfo.pWaitDstStageMask = waitStages;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &g_commandBuffers[imageIndex];
+    
+    VkSemaphore signalSemaphores[] = {g_renderFinishedSemaphores[imageIndex]};
+    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.pSignalSemaphores = signalSemaphores;
+    
+    // Submit batched texture/mesh uploads ahead of this frame's work
+    UploadQueue::get_instance().flush();
+    vkResetFences(g_device, 1, &frame.inFlight);
+    if (vkQueueSubmit(g_graphicsQueue, 1, &submitInfo, frame.inFlight) != VK_SUCCESS) {
+        recreateFrameSlot();
+        return false;
+    }
+    
+    // Present
+    VkPresentInfoKHR presentInfo = {};
+    presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+    presentInfo.waitSemaphoreCount = 1;
+    presentInfo.pWaitSemaphores = signalSemaphores;
+    
+    VkSwapchainKHR swapChains[] = {g_swapchain};
+    presentInfo.swapchainCount = 1;
+    presentInfo.pSwapchains = swapChains;
+    presentInfo.pImageIndices = &imageIndex;
+    presentInfo.pResults = nullptr;
+    
+    vkQueuePresentKHR(g_graphicsQueue, &presentInfo);
+    g_currentFrame = (g_currentFrame + 1) % g_framesInFlight;
+    return true;
+}
+
+// Give back a frame that beginFrame started but that will not be drawn (recording failed or a
+// resource is missing). Returning early is not enough: the image stays acquired, the slot's
+// acquire semaphore stays pending and the slot never advances. Instead the image's command buffer
+// is re-recorded with only a transition to the present layout and submitted as usual, so the image
+// is presented (its contents are undefined for that one frame).
+static void abandonFrame(uint32_t imageIndex) {
+    VkCommandBuffer commandBuffer = g_commandBuffers[imageIndex];
+    vkResetCommandBuffer(commandBuffer, 0);
+    
+    VkCommandBufferBeginInfo beginInfo = {};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    if (vkBeginCommandBuffer(commandBuffer, &beginInfo) == VK_SUCCESS) {
+        VkImageMemoryBarrier barrier = {};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        barrier.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = g_swapchainImages[imageIndex];
+        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        barrier.subresourceRange.levelCount = 1;
+        barrier.subresourceRange.layerCount = 1;
+        // Same stage the acquire semaphore is waited at, so the transition runs after the acquire
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &barrier);
+        if (vkEndCommandBuffer(commandBuffer) == VK_SUCCESS) {
+            submitFrame(imageIndex);
+            return;
+        }
+    }
+    
+    // Not even that could be recorded: consume the acquire semaphore with an empty batch on the
+    // slot's fence and move on. The image stays unpresented until the swapchain is recreated.
+    FrameSync& frame = g_frameSync[g_currentFrame];
+    VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    VkSubmitInfo submitInfo = {};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.waitSemaphoreCount = 1;
+    submitInfo.pWaitSemaphores = &frame.imageAvailable;
+    submitInfo.pWaitDstStageMask = &waitStage;
+    vkResetFences(g_device, 1, &frame.inFlight);
+    if (vkQueueSubmit(g_graphicsQueue, 1, &submitInfo, frame.inFlight) != VK_SUCCESS) {
+        recreateFrameSlot();
+        return;
+    }
+    g_currentFrame = (g_currentFrame + 1) % g_framesInFlight;
+}
+
 // Configure GLFW for Vulkan
 extern "C" void heidic_glfw_vulkan_hints() {
     glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
@@ -474,20 +702,26 @@ extern "C" int heidic_init_renderer(GLFWwindow* window) {
         return 0;
     }
     
+    // Uploads go through a dedicated transfer queue when the device exposes one
+    uint32_t transferFamily = findTransferQueueFamily(g_physicalDevice);
+    g_transferQueueFamilyIndex = transferFamily != UINT32_MAX ? transferFamily : g_graphicsQueueFamilyIndex;
+    
     // 5. Create logical device
     float queuePriority = 1.0f;
-    VkDeviceQueueCreateInfo queueCreateInfo = {};
-    queueCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-    queueCreateInfo.queueFamilyIndex = g_graphicsQueueFamilyIndex;
-    queueCreateInfo.queueCount = 1;
-    queueCreateInfo.pQueuePriorities = &queuePriority;
+    VkDeviceQueueCreateInfo queueCreateInfos[2] = {};
+    queueCreateInfos[0].sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+    queueCreateInfos[0].queueFamilyIndex = g_graphicsQueueFamilyIndex;
+    queueCreateInfos[0].queueCount = 1;
+    queueCreateInfos[0].pQueuePriorities = &queuePriority;
+    queueCreateInfos[1] = queueCreateInfos[0];
+    queueCreateInfos[1].queueFamilyIndex = g_transferQueueFamilyIndex;
     
     VkPhysicalDeviceFeatures deviceFeatures = {};
     
     VkDeviceCreateInfo deviceCreateInfo = {};
     deviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
-    deviceCreateInfo.pQueueCreateInfos = &queueCreateInfo;
-    deviceCreateInfo.queueCreateInfoCount = 1;
+    deviceCreateInfo.pQueueCreateInfos = queueCreateInfos;
+    deviceCreateInfo.queueCreateInfoCount = g_transferQueueFamilyIndex != g_graphicsQueueFamilyIndex ? 2 : 1;
     deviceCreateInfo.pEnabledFeatures = &deviceFeatures;
     
     const char* deviceExtensions[] = { VK_KHR_SWAPCHAIN_EXTENSION_NAME };
@@ -502,6 +736,20 @@ extern "C" int heidic_init_renderer(GLFWwindow* window) {
     }
     
     vkGetDeviceQueue(g_device, g_graphicsQueueFamilyIndex, 0, &g_graphicsQueue);
+    vkGetDeviceQueue(g_device, g_transferQueueFamilyIndex, 0, &g_transferQueue);
+    
+    // All buffers/images sub-allocate from large per-memory-type blocks
+    GpuAllocator::get_instance().init(g_physicalDevice, g_device);
+    
+    // Every pipeline below (and hot-reloaded ones) compiles through the on-disk pipeline cache
+    PipelineCache::get_instance().init(g_device, g_physicalDevice, g_pipelineCachePath);
+    PipelineCache::get_instance().setRetireFrames(g_framesInFlight);
+    
+    // Eviction and streamed-level retirement run after the frame slot's fence wait, so an asset
+    // used by any frame still in flight is kept (one extra frame covers uses recorded before the
+    // clock advances)
+    ResidencyManager::get_instance().setMinIdleFrames(g_framesInFlight + 1);
+    TextureStreamer::get_instance().setRetireFrames(g_framesInFlight);
     
     // 6. Create swapchain
     VkSurfaceCapabilitiesKHR capabilities;
@@ -556,6 +804,8 @@ extern "C" int heidic_init_renderer(GLFWwindow* window) {
     
     if (vkCreateSwapchainKHR(g_device, &swapchainCreateInfo, nullptr, &g_swapchain) != VK_SUCCESS) {
         std::cerr << "[EDEN] ERROR: Failed to create swapchain!" << std::endl;
+        PipelineCache::get_instance().shutdown();
+        GpuAllocator::get_instance().shutdown();
         vkDestroyDevice(g_device, nullptr);
         vkDestroySurfaceKHR(g_instance, g_surface, nullptr);
         vkDestroyInstance(g_instance, nullptr);
@@ -682,7 +932,7 @@ extern "C" int heidic_init_renderer(GLFWwindow* window) {
     // Try to load custom vertex shader
     for (const auto& path : vertPaths) {
         try {
-            vertShaderCode = readFile(path);
+            vertShaderCode = loadShaderCode(path);
             loadedCustomShaders = true;
             g_usingCustomShaders = true;  // Mark that we're using custom shaders
             std::cout << "[EDEN] Loaded custom vertex shader: " << path << std::endl;
@@ -695,7 +945,7 @@ extern "C" int heidic_init_renderer(GLFWwindow* window) {
     // Try to load custom fragment shader
     for (const auto& path : fragPaths) {
         try {
-            fragShaderCode = readFile(path);
+            fragShaderCode = loadShaderCode(path);
             if (loadedCustomShaders) {
                 std::cout << "[EDEN] Loaded custom fragment shader: " << path << std::endl;
                 break;
@@ -708,8 +958,8 @@ extern "C" int heidic_init_renderer(GLFWwindow* window) {
     // Fall back to default shaders if custom ones weren't found
     if (!loadedCustomShaders || fragShaderCode.empty()) {
         try {
-            vertShaderCode = readFile("vert_3d.spv");
-            fragShaderCode = readFile("frag_3d.spv");
+            vertShaderCode = loadShaderCode("vert_3d.spv");
+            fragShaderCode = loadShaderCode("frag_3d.spv");
             g_usingCustomShaders = false;  // Using default shaders
             std::cout << "[EDEN] Using default shaders (vert_3d.spv, frag_3d.spv)" << std::endl;
         } catch (const std::exception& e) {
@@ -795,10 +1045,8 @@ extern "C" int heidic_init_renderer(GLFWwindow* window) {
                    g_triangleVertexBuffer, g_triangleVertexBufferMemory);
         
         // Copy vertex data to buffer
-        void* data;
-        vkMapMemory(g_device, g_triangleVertexBufferMemory, 0, bufferSize, 0, &data);
+        void* data = g_triangleVertexBufferMemory.mapped;
         memcpy(data, triangleVertices.data(), (size_t)bufferSize);
-        vkUnmapMemory(g_device, g_triangleVertexBufferMemory);
         
         std::cout << "[EDEN] Created vertex buffer for custom shaders" << std::endl;
     } else {
@@ -900,7 +1148,7 @@ extern "C" int heidic_init_renderer(GLFWwindow* window) {
     pipelineInfo.subpass = 0;
     pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
     
-    if (vkCreateGraphicsPipelines(g_device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &g_pipeline) != VK_SUCCESS) {
+    if (vkCreateGraphicsPipelines(g_device, PipelineCache::get_instance().get(), 1, &pipelineInfo, nullptr, &g_pipeline) != VK_SUCCESS) {
         std::cerr << "[EDEN] ERROR: Failed to create graphics pipeline!" << std::endl;
         vkDestroyPipelineLayout(g_device, g_pipelineLayout, nullptr);
         vkDestroyShaderModule(g_device, g_fragShaderModule, nullptr);
@@ -948,6 +1196,13 @@ extern "C" int heidic_init_renderer(GLFWwindow* window) {
         return 0;
     }
     
+    // Texture/mesh uploads are batched through a persistent staging ring and flushed per frame
+    if (!UploadQueue::get_instance().init(g_device, g_graphicsQueueFamilyIndex, g_graphicsQueue,
+                                          g_transferQueueFamilyIndex, g_transferQueue)) {
+        std::cerr << "[EDEN] ERROR: Failed to create upload queue!" << std::endl;
+        return 0;
+    }
+    
     // 13. Create command buffers
     g_commandBuffers.resize(g_swapchainImageCount);
     VkCommandBufferAllocateInfo allocInfo = {};
@@ -1021,17 +1276,8 @@ extern "C" int heidic_init_renderer(GLFWwindow* window) {
         vkUpdateDescriptorSets(g_device, 1, &descriptorWrite, 0, nullptr);
     }
     
-    // 17. Create synchronization objects
-    VkSemaphoreCreateInfo semaphoreInfo = {};
-    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
-    
-    VkFenceCreateInfo fenceInfo = {};
-    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-    fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
-    
-    if (vkCreateSemaphore(g_device, &semaphoreInfo, nullptr, &g_imageAvailableSemaphore) != VK_SUCCESS ||
-        vkCreateSemaphore(g_device, &semaphoreInfo, nullptr, &g_renderFinishedSemaphore) != VK_SUCCESS ||
-        vkCreateFence(g_device, &fenceInfo, nullptr, &g_inFlightFence) != VK_SUCCESS) {
+    // 17. Create synchronization objects (per frame in flight and per swapchain image)
+    if (!createFrameSyncObjects()) {
         std::cerr << "[EDEN] ERROR: Failed to create synchronization objects!" << std::endl;
         return 0;
     }
@@ -1060,13 +1306,11 @@ extern "C" void heidic_render_frame(GLFWwindow* window) {
         g_rotationAngle -= 2.0f * 3.14159f;
     }
     
-    // Wait for previous frame to finish
-    vkWaitForFences(g_device, 1, &g_inFlightFence, VK_TRUE, UINT64_MAX);
-    vkResetFences(g_device, 1, &g_inFlightFence);
-    
-    // Acquire next image
+    // Wait for this frame slot and acquire the next swapchain image
     uint32_t imageIndex;
-    vkAcquireNextImageKHR(g_device, g_swapchain, UINT64_MAX, g_imageAvailableSemaphore, VK_NULL_HANDLE, &imageIndex);
+    if (!beginFrame(imageIndex)) {
+        return;
+    }
     
     // Update uniform buffer with rotation using GLM
     UniformBufferObject ubo = {};
@@ -1093,16 +1337,15 @@ extern "C" void heidic_render_frame(GLFWwindow* window) {
     ubo.proj[1][1] *= -1;
     
     // Update uniform buffer
-    void* data;
-    vkMapMemory(g_device, g_uniformBuffersMemory[imageIndex], 0, sizeof(UniformBufferObject), 0, &data);
+    void* data = g_uniformBuffersMemory[imageIndex].mapped;
     memcpy(data, &ubo, sizeof(UniformBufferObject));
-    vkUnmapMemory(g_device, g_uniformBuffersMemory[imageIndex]);
     
     // Record command buffer
     VkCommandBufferBeginInfo beginInfo = {};
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
     
     if (vkBeginCommandBuffer(g_commandBuffers[imageIndex], &beginInfo) != VK_SUCCESS) {
+        abandonFrame(imageIndex);
         return;
     }
     
@@ -1151,44 +1394,12 @@ extern "C" void heidic_render_frame(GLFWwindow* window) {
     vkCmdEndRenderPass(g_commandBuffers[imageIndex]);
     
     if (vkEndCommandBuffer(g_commandBuffers[imageIndex]) != VK_SUCCESS) {
+        abandonFrame(imageIndex);
         return;
     }
     
-    // Submit command buffer
-    VkSubmitInfo submitInfo = {};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    
-    VkSemaphore waitSemaphores[] = {g_imageAvailableSemaphore};
-    VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-    submitInfo.waitSemaphoreCount = 1;
-    submitInfo.pWaitSemaphores = waitSemaphores;
-    submitInfo.pWaitDstStageMask = waitStages;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &g_commandBuffers[imageIndex];
-    
-    VkSemaphore signalSemaphores[] = {g_renderFinishedSemaphore};
-    submitInfo.signalSemaphoreCount = 1;
-    submitInfo.pSignalSemaphores = signalSemaphores;
-    
-    if (vkQueueSubmit(g_graphicsQueue, 1, &submitInfo, g_inFlightFence) != VK_SUCCESS) {
-        return;
-    }
-    
-    // Present
-    VkPresentInfoKHR presentInfo = {};
-    presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-    presentInfo.waitSemaphoreCount = 1;
-    presentInfo.pWaitSemaphores = signalSemaphores;
-    
-    VkSwapchainKHR swapChains[] = {g_swapchain};
-    presentInfo.swapchainCount = 1;
-    presentInfo.pSwapchains = swapChains;
-    presentInfo.pImageIndices = &imageIndex;
-    presentInfo.pResults = nullptr;
-    
-    vkQueuePresentKHR(g_graphicsQueue, &presentInfo);
-    
-    g_currentFrame = (g_currentFrame + 1) % g_swapchainImageCount;
+    // Submit on this frame slot's fence and present
+    submitFrame(imageIndex);
 }
 
 // Cleanup renderer
@@ -1199,10 +1410,13 @@ extern "C" void heidic_cleanup_renderer() {
     
     vkDeviceWaitIdle(g_device);
     
+    // Finish pipeline builds still using our shader modules, then write the pipeline cache to disk
+    PipelineCache::get_instance().shutdown();
+    
     // Cleanup uniform buffers
     for (size_t i = 0; i < g_uniformBuffers.size(); i++) {
         vkDestroyBuffer(g_device, g_uniformBuffers[i], nullptr);
-        vkFreeMemory(g_device, g_uniformBuffersMemory[i], nullptr);
+        GpuAllocator::get_instance().free(g_uniformBuffersMemory[i]);
     }
     
     // Cleanup descriptor pool
@@ -1216,25 +1430,14 @@ extern "C" void heidic_cleanup_renderer() {
     }
     
     // Cleanup synchronization objects
-    if (g_imageAvailableSemaphore != VK_NULL_HANDLE) {
-        vkDestroySemaphore(g_device, g_imageAvailableSemaphore, nullptr);
-    }
-    if (g_renderFinishedSemaphore != VK_NULL_HANDLE) {
-        vkDestroySemaphore(g_device, g_renderFinishedSemaphore, nullptr);
-    }
-    if (g_inFlightFence != VK_NULL_HANDLE) {
-        vkDestroyFence(g_device, g_inFlightFence, nullptr);
-    }
+    destroyFrameSyncObjects();
     
     // Cleanup triangle vertex buffer (for custom shaders)
     if (g_triangleVertexBuffer != VK_NULL_HANDLE) {
         vkDestroyBuffer(g_device, g_triangleVertexBuffer, nullptr);
         g_triangleVertexBuffer = VK_NULL_HANDLE;
     }
-    if (g_triangleVertexBufferMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(g_device, g_triangleVertexBufferMemory, nullptr);
-        g_triangleVertexBufferMemory = VK_NULL_HANDLE;
-    }
+    GpuAllocator::get_instance().free(g_triangleVertexBufferMemory);
     
     // Cleanup command pool
     if (g_commandPool != VK_NULL_HANDLE) {
@@ -1282,9 +1485,7 @@ extern "C" void heidic_cleanup_renderer() {
     if (g_depthImage != VK_NULL_HANDLE) {
         vkDestroyImage(g_device, g_depthImage, nullptr);
     }
-    if (g_depthImageMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(g_device, g_depthImageMemory, nullptr);
-    }
+    GpuAllocator::get_instance().free(g_depthImageMemory);
     
     // Cleanup swapchain image views
     for (auto imageView : g_swapchainImageViews) {
@@ -1296,6 +1497,19 @@ extern "C" void heidic_cleanup_renderer() {
         vkDestroySwapchainKHR(g_device, g_swapchain, nullptr);
     }
     
+    // Destroy cached textures/meshes that nothing references any more (they own Vulkan objects)
+    ResourceCache<TextureResource>::get_instance().purgeUnreferenced();
+    ResourceCache<MeshResource>::get_instance().purgeUnreferenced();
+    
+    // Drain pending uploads and release the staging ring
+    UploadQueue::get_instance().shutdown();
+    
+    // Destroy texture images/views replaced by streamed-in levels (the device is idle)
+    TextureStreamer::get_instance().flushRetired();
+    
+    // Release device memory blocks (every buffer/image above is already destroyed)
+    GpuAllocator::get_instance().shutdown();
+    
     // Cleanup device
     if (g_device != VK_NULL_HANDLE) {
         vkDestroyDevice(g_device, nullptr);
@@ -1319,16 +1533,152 @@ extern "C" void heidic_sleep_ms(uint32_t milliseconds) {
     std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
 }
 
+// GPU residency budget for TextureResource/MeshResource (0 = unlimited)
+extern "C" void heidic_set_gpu_memory_budget_mb(float megabytes) {
+    size_t bytes = megabytes > 0.0f ? static_cast<size_t>(megabytes * 1024.0f * 1024.0f) : 0;
+    ResidencyManager::get_instance().setBudget(bytes);
+    ResidencyManager::get_instance().enforceBudget();
+}
+
+extern "C" float heidic_get_gpu_resident_memory_mb() {
+    return static_cast<float>(ResidencyManager::get_instance().getResidentBytes()) / (1024.0f * 1024.0f);
+}
+
+extern "C" void heidic_print_gpu_memory_stats() {
+    GpuAllocator::Stats stats = GpuAllocator::get_instance().getStats();
+    std::cout << "[EDEN] GPU memory: " << stats.allocationCount << " allocations, "
+              << (stats.usedBytes / (1024 * 1024)) << " MB used, "
+              << stats.blockCount << " blocks (" << (stats.blockBytes / (1024 * 1024)) << " MB), "
+              << stats.dedicatedCount << " dedicated (" << (stats.dedicatedBytes / (1024 * 1024)) << " MB), "
+              << stats.deviceAllocations << " vkAllocateMemory calls total" << std::endl;
+}
+
+// Submit pending texture/mesh uploads now (frames do this automatically before their submit).
+// Pass a nonzero wait to block until they have landed, e.g. at the end of a loading screen.
+extern "C" void heidic_flush_uploads(int wait) {
+    if (!UploadQueue::get_instance().isInitialized()) {
+        return;
+    }
+    if (wait) {
+        UploadQueue::get_instance().waitIdle();
+    } else {
+        UploadQueue::get_instance().flush();
+    }
+}
+
+// Frames the CPU may record ahead of the GPU (1-3, default 2). Takes effect at heidic_init_renderer.
+extern "C" void heidic_set_frames_in_flight(int frames) {
+    if (!g_frameSync.empty()) {
+        std::cerr << "[EDEN] WARNING: Frames in flight must be set before heidic_init_renderer" << std::endl;
+        return;
+    }
+    g_framesInFlight = static_cast<uint32_t>(std::max(1, std::min(frames, static_cast<int>(MAX_FRAMES_IN_FLIGHT))));
+}
+
+// View-distance culling for the cube/ball/mesh draw lists (0 = frustum culling only)
+static float g_cullMaxDistance = 0.0f;
+
+extern "C" void heidic_set_cull_distance(float distance) {
+    g_cullMaxDistance = std::max(0.0f, distance);
+}
+
+// PNG textures are transcoded to BC7/BC5 and cached as .dds in the PNG cache directory (on by default).
+// quality: 0 = fast, 1 = slower encode with better endpoints. Affects textures loaded afterwards.
+extern "C" void heidic_set_png_texture_compression(int enabled, int quality) {
+    TextureResource::setPngCompression(enabled != 0, quality ? BCQuality::Quality : BCQuality::Fast);
+}
+
+// Directory for transcoded PNGs keyed by PNG content ("" = transcode on every load, write nothing)
+extern "C" void heidic_set_png_texture_cache_dir(const char* dir) {
+    TextureResource::setPngCacheDirectory(dir ? dir : "");
+}
+
+// Texture mip streaming: GPU-ready textures load with their mip tail and stream finer levels
+// in at up to this many MB of uploads per frame (0 = stop streaming new levels)
+extern "C" void heidic_set_texture_streaming_budget_mb(float megabytes) {
+    TextureStreamer& streamer = TextureStreamer::get_instance();
+    streamer.setEnabled(megabytes > 0.0f);
+    if (megabytes > 0.0f) {
+        streamer.setBandwidthBudget(static_cast<uint64_t>(megabytes * 1024.0f * 1024.0f));
+    }
+}
+
+// Pipeline cache file, validated against the device and driver on load ("" = memory only); call before init
+extern "C" void heidic_set_pipeline_cache_path(const char* path) {
+    g_pipelineCachePath = path ? path : "";
+}
+
+// Write the pipeline cache to disk now (cleanup also saves it)
+extern "C" void heidic_save_pipeline_cache() {
+    PipelineCache::get_instance().save();
+}
+
+// Directory for compiled SPIR-V keyed by shader content ("" = keep compiled shaders in memory only)
+extern "C" void heidic_set_shader_cache_dir(const char* dir) {
+    ShaderCompiler::get_instance().setCacheDirectory(dir ? dir : "");
+}
+
+// Preprocessor define passed to every shader compiled afterwards (value may be empty)
+extern "C" void heidic_add_shader_define(const char* name, const char* value) {
+    ShaderCompiler::get_instance().addDefine(name, value ? value : "");
+}
+
+// Compile GLSL sources on all cores so the renderer's loads are cache hits (call at startup)
+// Returns how many compiled; failures are logged and left to the .spv fallback
+extern "C" int heidic_precompile_shaders(const char** paths, int count) {
+    std::vector<std::string> sources;
+    for (int i = 0; i < count; i++) {
+        std::string path = findFile(paths[i]);
+        sources.push_back(path.empty() ? std::string(paths[i]) : path);
+    }
+    auto start = std::chrono::steady_clock::now();
+    std::vector<ShaderCompileResult> results = ShaderCompiler::get_instance().compileAll(sources);
+    int compiled = 0;
+    int fromCache = 0;
+    for (size_t i = 0; i < results.size(); i++) {
+        if (!results[i].ok) {
+            std::cerr << "[Shader] ERROR: Failed to compile " << sources[i] << ":\n" << results[i].log << std::endl;
+            continue;
+        }
+        compiled++;
+        fromCache += results[i].fromCache ? 1 : 0;
+        for (const std::string& include : results[i].includes) {
+            FileWatcher::get_instance().watch(include);
+        }
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "[Shader] Prepared " << compiled << "/" << count << " shaders (" << fromCache
+              << " from cache) in " << ms << " ms" << std::endl;
+    return compiled;
+}
+
+// Whether a file included by this shader (at its last compile) changed in this FileWatcher batch
+extern "C" int heidic_shader_includes_changed(const char* shader_path) {
+    std::string path = findFile(shader_path);
+    FileWatcher& watcher = FileWatcher::get_instance();
+    for (const std::string& include : ShaderCompiler::get_instance().getIncludes(path.empty() ? shader_path : path)) {
+        if (watcher.wasChanged(include)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Shared cache for pipelines created outside this file (generated create_<pipeline>_pipeline)
+extern "C" VkPipelineCache heidic_get_pipeline_cache() {
+    return PipelineCache::get_instance().get();
+}
+
 // Hot-reload shader function
+// The new shader module is created right away and the pipeline using it is rebuilt on a
+// PipelineCache worker; the current pipeline keeps rendering until the rebuild lands
+// (beginFrame swaps it in). Replaced modules and pipelines are destroyed once nothing uses them.
 extern "C" void heidic_reload_shader(const char* shader_path) {
     if (g_device == VK_NULL_HANDLE) {
         std::cerr << "[Shader Hot-Reload] ERROR: Device not initialized!" << std::endl;
         return;
     }
     
-    // Wait for device to be idle before reloading
-    vkDeviceWaitIdle(g_device);
-    
     std::string shaderPathStr(shader_path);
     
     // Determine the .spv path from the source path (shader_path is now the original source)
@@ -1415,52 +1765,30 @@ extern "C" void heidic_reload_shader(const char* shader_path) {
         return;
     }
     
-    // Read new shader code from the .spv file
+    // Compile the GLSL source in-process (a cache hit if only comments or whitespace changed);
+    // a path without a GLSL source reloads its .spv file instead
     std::vector<char> shaderCode;
-    try {
-        shaderCode = readFile(spv_path);
-    } catch (const std::exception& e) {
-        std::cerr << "[Shader Hot-Reload] ERROR: Failed to read shader file " << spv_path << ": " << e.what() << std::endl;
-        return;
-    }
-    
-    // Destroy old shader module
-    if (*targetModule != VK_NULL_HANDLE) {
-        vkDestroyShaderModule(g_device, *targetModule, nullptr);
-        *targetModule = VK_NULL_HANDLE;
-    }
-    
-    // Create new shader module
-    VkShaderModuleCreateInfo createInfo = {};
-    createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-    createInfo.codeSize = shaderCode.size();
-    createInfo.pCode = reinterpret_cast<const uint32_t*>(shaderCode.data());
-    
-    if (vkCreateShaderModule(g_device, &createInfo, nullptr, targetModule) != VK_SUCCESS) {
-        std::cerr << "[Shader Hot-Reload] ERROR: Failed to create new shader module!" << std::endl;
-        return;
-    }
-    
-    // Destroy old pipeline
-    if (*targetPipeline != VK_NULL_HANDLE) {
-        vkDestroyPipeline(g_device, *targetPipeline, nullptr);
-        *targetPipeline = VK_NULL_HANDLE;
+    std::string sourcePath = shader_stage_from_path(shaderPathStr) != ShaderStageKind::Unknown ? findFile(shaderPathStr) : std::string();
+    if (!sourcePath.empty()) {
+        if (!compileShaderSource(sourcePath, shaderCode)) {
+            std::cerr << "[Shader Hot-Reload] Keeping the current pipeline until " << shader_path << " compiles" << std::endl;
+            return;
+        }
+    } else {
+        try {
+            shaderCode = readFile(spv_path);
+        } catch (const std::exception& e) {
+            std::cerr << "[Shader Hot-Reload] ERROR: Failed to read shader file " << spv_path << ": " << e.what() << std::endl;
+            return;
+        }
     }
     
     // Get the other shader module (vertex or fragment)
     VkShaderModule otherModule = VK_NULL_HANDLE;
     if (isTriangleShader) {
-        if (isVertex) {
-            otherModule = g_fragShaderModule;
-        } else {
-            otherModule = g_vertShaderModule;
-        }
+        otherModule = isVertex ? g_fragShaderModule : g_vertShaderModule;
     } else if (isCubeShader) {
-        if (isVertex) {
-            otherModule = g_cubeFragShaderModule;
-        } else {
-            otherModule = g_cubeVertShaderModule;
-        }
+        otherModule = isVertex ? g_cubeFragShaderModule : g_cubeVertShaderModule;
     }
     
     if (otherModule == VK_NULL_HANDLE) {
@@ -1468,280 +1796,70 @@ extern "C" void heidic_reload_shader(const char* shader_path) {
         return;
     }
     
-    // Create shader stage info for both shaders
-    VkPipelineShaderStageCreateInfo vertStageInfo = {};
-    vertStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-    vertStageInfo.stage = VK_SHADER_STAGE_VERTEX_BIT;
-    vertStageInfo.module = isVertex ? *targetModule : otherModule;
-    vertStageInfo.pName = "main";
-    
-    VkPipelineShaderStageCreateInfo fragStageInfo = {};
-    fragStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-    fragStageInfo.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
-    fragStageInfo.module = isFragment ? *targetModule : otherModule;
-    fragStageInfo.pName = "main";
+    // Create the new shader module next to the old one (a rebuild started earlier may still be
+    // compiling against the old one, so it is retired instead of destroyed)
+    VkShaderModuleCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    createInfo.codeSize = shaderCode.size();
+    createInfo.pCode = reinterpret_cast<const uint32_t*>(shaderCode.data());
     
-    VkPipelineShaderStageCreateInfo shaderStages[] = {vertStageInfo, fragStageInfo};
+    VkShaderModule newModule = VK_NULL_HANDLE;
+    if (vkCreateShaderModule(g_device, &createInfo, nullptr, &newModule) != VK_SUCCESS) {
+        std::cerr << "[Shader Hot-Reload] ERROR: Failed to create new shader module!" << std::endl;
+        return;
+    }
     
-    // Recreate pipeline (triangle or cube)
-    if (isTriangleShader) {
-        // Triangle pipeline setup
-        // Custom shaders (my_shader) need vertex input, default shaders don't
-        VkPipelineVertexInputStateCreateInfo vertexInputInfo = {};
-        vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-        
-        VkVertexInputBindingDescription bindingDescription = {};
-        VkVertexInputAttributeDescription attributeDescriptions[2] = {};
-        
-        if (g_usingCustomShaders) {
-            // Set up vertex input for custom shaders
-            bindingDescription.binding = 0;
-            bindingDescription.stride = sizeof(Vertex);
-            bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
-            
-            attributeDescriptions[0].binding = 0;
-            attributeDescriptions[0].location = 0;
-            attributeDescriptions[0].format = VK_FORMAT_R32G32B32_SFLOAT;
-            attributeDescriptions[0].offset = offsetof(Vertex, pos);
-            
-            attributeDescriptions[1].binding = 0;
-            attributeDescriptions[1].location = 1;
-            attributeDescriptions[1].format = VK_FORMAT_R32G32B32_SFLOAT;
-            attributeDescriptions[1].offset = offsetof(Vertex, color);
-            
-            vertexInputInfo.vertexBindingDescriptionCount = 1;
-            vertexInputInfo.pVertexBindingDescriptions = &bindingDescription;
-            vertexInputInfo.vertexAttributeDescriptionCount = 2;
-            vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions;
-            
-            // Create vertex buffer for triangle if it doesn't exist
-            if (g_triangleVertexBuffer == VK_NULL_HANDLE) {
-                std::vector<Vertex> triangleVertices = {
-                    {{ 0.0f, -0.5f, 0.0f}, {1.0f, 0.0f, 0.0f}},  // Bottom (red)
-                    {{ 0.5f,  0.5f, 0.0f}, {0.0f, 1.0f, 0.0f}},  // Top-right (green)
-                    {{-0.5f,  0.5f, 0.0f}, {0.0f, 0.0f, 1.0f}}   // Top-left (blue)
-                };
-                
-                VkDeviceSize bufferSize = sizeof(Vertex) * triangleVertices.size();
-                createBuffer(bufferSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-                           VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                           g_triangleVertexBuffer, g_triangleVertexBufferMemory);
-                
-                // Copy vertex data to buffer
-                void* data;
-                vkMapMemory(g_device, g_triangleVertexBufferMemory, 0, bufferSize, 0, &data);
-                memcpy(data, triangleVertices.data(), (size_t)bufferSize);
-                vkUnmapMemory(g_device, g_triangleVertexBufferMemory);
-                
-                std::cout << "[Shader Hot-Reload] Created vertex buffer for custom shaders" << std::endl;
-            }
-        } else {
-            // Default shaders use hardcoded vertices (no vertex input)
-            vertexInputInfo.vertexBindingDescriptionCount = 0;
-            vertexInputInfo.vertexAttributeDescriptionCount = 0;
-        }
-        
-        VkPipelineInputAssemblyStateCreateInfo inputAssembly = {};
-        inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
-        inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
-        inputAssembly.primitiveRestartEnable = VK_FALSE;
-        
-        VkViewport viewport = {};
-        viewport.x = 0.0f;
-        viewport.y = 0.0f;
-        viewport.width = (float)g_swapchainExtent.width;
-        viewport.height = (float)g_swapchainExtent.height;
-        viewport.minDepth = 0.0f;
-        viewport.maxDepth = 1.0f;
-        
-        VkRect2D scissor = {};
-        scissor.offset = {0, 0};
-        scissor.extent = g_swapchainExtent;
-        
-        VkPipelineViewportStateCreateInfo viewportState = {};
-        viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
-        viewportState.viewportCount = 1;
-        viewportState.pViewports = &viewport;
-        viewportState.scissorCount = 1;
-        viewportState.pScissors = &scissor;
-        
-        VkPipelineRasterizationStateCreateInfo rasterizer = {};
-        rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
-        rasterizer.depthClampEnable = VK_FALSE;
-        rasterizer.rasterizerDiscardEnable = VK_FALSE;
-        rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
-        rasterizer.lineWidth = 1.0f;
-        rasterizer.cullMode = VK_CULL_MODE_NONE;
-        rasterizer.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
-        rasterizer.depthBiasEnable = VK_FALSE;
-        
-        VkPipelineMultisampleStateCreateInfo multisampling = {};
-        multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
-        multisampling.sampleShadingEnable = VK_FALSE;
-        multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
-        
-        VkPipelineDepthStencilStateCreateInfo depthStencil = {};
-        depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
-        depthStencil.depthTestEnable = VK_FALSE;
-        depthStencil.depthWriteEnable = VK_FALSE;
-        depthStencil.depthCompareOp = VK_COMPARE_OP_ALWAYS;
-        depthStencil.depthBoundsTestEnable = VK_FALSE;
-        depthStencil.stencilTestEnable = VK_FALSE;
-        
-        VkPipelineColorBlendAttachmentState colorBlendAttachment = {};
-        colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
-        colorBlendAttachment.blendEnable = VK_FALSE;
-        
-        VkPipelineColorBlendStateCreateInfo colorBlending = {};
-        colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
-        colorBlending.logicOpEnable = VK_FALSE;
-        colorBlending.attachmentCount = 1;
-        colorBlending.pAttachments = &colorBlendAttachment;
-        
-        VkGraphicsPipelineCreateInfo pipelineInfo = {};
-        pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-        pipelineInfo.stageCount = 2;
-        pipelineInfo.pStages = shaderStages;
-        pipelineInfo.pVertexInputState = &vertexInputInfo;
-        pipelineInfo.pInputAssemblyState = &inputAssembly;
-        pipelineInfo.pViewportState = &viewportState;
-        pipelineInfo.pRasterizationState = &rasterizer;
-        pipelineInfo.pMultisampleState = &multisampling;
-        pipelineInfo.pDepthStencilState = &depthStencil;
-        pipelineInfo.pColorBlendState = &colorBlending;
-        pipelineInfo.layout = g_pipelineLayout;
-        pipelineInfo.renderPass = g_renderPass;
-        pipelineInfo.subpass = 0;
-        pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
-        
-        if (vkCreateGraphicsPipelines(g_device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &g_pipeline) != VK_SUCCESS) {
-            std::cerr << "[Shader Hot-Reload] ERROR: Failed to recreate triangle pipeline!" << std::endl;
-            return;
-        }
-    } else if (isCubeShader) {
-        // Cube pipeline setup (with vertex input)
-        VkVertexInputBindingDescription bindingDescription = {};
-        bindingDescription.binding = 0;
-        bindingDescription.stride = sizeof(Vertex);
-        bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
-        
-        VkVertexInputAttributeDescription attributeDescriptions[2] = {};
-        attributeDescriptions[0].binding = 0;
-        attributeDescriptions[0].location = 0;
-        attributeDescriptions[0].format = VK_FORMAT_R32G32B32_SFLOAT;
-        attributeDescriptions[0].offset = offsetof(Vertex, pos);
-        
-        attributeDescriptions[1].binding = 0;
-        attributeDescriptions[1].location = 1;
-        attributeDescriptions[1].format = VK_FORMAT_R32G32B32_SFLOAT;
-        attributeDescriptions[1].offset = offsetof(Vertex, color);
-        
-        VkPipelineVertexInputStateCreateInfo vertexInputInfo = {};
-        vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-        vertexInputInfo.vertexBindingDescriptionCount = 1;
-        vertexInputInfo.pVertexBindingDescriptions = &bindingDescription;
-        vertexInputInfo.vertexAttributeDescriptionCount = 2;
-        vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions;
-        
-        VkPipelineInputAssemblyStateCreateInfo inputAssembly = {};
-        inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
-        inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
-        inputAssembly.primitiveRestartEnable = VK_FALSE;
-        
-        VkViewport viewport = {};
-        viewport.x = 0.0f;
-        viewport.y = 0.0f;
-        viewport.width = (float)g_swapchainExtent.width;
-        viewport.height = (float)g_swapchainExtent.height;
-        viewport.minDepth = 0.0f;
-        viewport.maxDepth = 1.0f;
-        
-        VkRect2D scissor = {};
-        scissor.offset = {0, 0};
-        scissor.extent = g_swapchainExtent;
-        
-        VkPipelineViewportStateCreateInfo viewportState = {};
-        viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
-        viewportState.viewportCount = 1;
-        viewportState.pViewports = &viewport;
-        viewportState.scissorCount = 1;
-        viewportState.pScissors = &scissor;
-        
-        VkPipelineRasterizationStateCreateInfo rasterizer = {};
-        rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
-        rasterizer.depthClampEnable = VK_FALSE;
-        rasterizer.rasterizerDiscardEnable = VK_FALSE;
-        rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
-        rasterizer.lineWidth = 1.0f;
-        rasterizer.cullMode = VK_CULL_MODE_BACK_BIT;
-        rasterizer.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
-        rasterizer.depthBiasEnable = VK_FALSE;
-        
-        VkPipelineMultisampleStateCreateInfo multisampling = {};
-        multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
-        multisampling.sampleShadingEnable = VK_FALSE;
-        multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
-        
-        VkPipelineDepthStencilStateCreateInfo depthStencil = {};
-        depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
-        depthStencil.depthTestEnable = VK_TRUE;
-        depthStencil.depthWriteEnable = VK_TRUE;
-        depthStencil.depthCompareOp = VK_COMPARE_OP_LESS;
-        depthStencil.depthBoundsTestEnable = VK_FALSE;
-        depthStencil.stencilTestEnable = VK_FALSE;
-        
-        VkPipelineColorBlendAttachmentState colorBlendAttachment = {};
-        colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
-        colorBlendAttachment.blendEnable = VK_FALSE;
-        
-        VkPipelineColorBlendStateCreateInfo colorBlending = {};
-        colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
-        colorBlending.logicOpEnable = VK_FALSE;
-        colorBlending.attachmentCount = 1;
-        colorBlending.pAttachments = &colorBlendAttachment;
+    PipelineCache& pipelines = PipelineCache::get_instance();
+    if (*targetModule != VK_NULL_HANDLE) {
+        VkShaderModule oldModule = *targetModule;
+        pipelines.retire([oldModule]() { vkDestroyShaderModule(g_device, oldModule, nullptr); });
+    }
+    *targetModule = newModule;
+    
+    GraphicsPipelineDesc desc;
+    desc.vertexShader = isVertex ? newModule : otherModule;
+    desc.fragmentShader = isFragment ? newModule : otherModule;
+    desc.extent = g_swapchainExtent;
+    desc.layout = g_pipelineLayout;
+    desc.renderPass = g_renderPass;
+    
+    bool needsVertexInput = isCubeShader || g_usingCustomShaders;
+    if (needsVertexInput) {
+        desc.bindings.push_back({0, sizeof(Vertex), VK_VERTEX_INPUT_RATE_VERTEX});
+        desc.attributes.push_back({0, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(Vertex, pos)});
+        desc.attributes.push_back({1, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(Vertex, color)});
+    }
+    if (isCubeShader) {
+        // Cube pipeline: back-face culling and depth test
+        desc.cullMode = VK_CULL_MODE_BACK_BIT;
+        desc.depthTest = true;
+        desc.depthWrite = true;
+    } else if (g_usingCustomShaders && g_triangleVertexBuffer == VK_NULL_HANDLE) {
+        // Custom shaders (my_shader) read the triangle from a vertex buffer; default shaders
+        // use hardcoded vertices
+        std::vector<Vertex> triangleVertices = {
+            {{ 0.0f, -0.5f, 0.0f}, {1.0f, 0.0f, 0.0f}},  // Bottom (red)
+            {{ 0.5f,  0.5f, 0.0f}, {0.0f, 1.0f, 0.0f}},  // Top-right (green)
+            {{-0.5f,  0.5f, 0.0f}, {0.0f, 0.0f, 1.0f}}   // Top-left (blue)
+        };
         
-        VkGraphicsPipelineCreateInfo pipelineInfo = {};
-        pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-        pipelineInfo.stageCount = 2;
-        pipelineInfo.pStages = shaderStages;
-        pipelineInfo.pVertexInputState = &vertexInputInfo;
-        pipelineInfo.pInputAssemblyState = &inputAssembly;
-        pipelineInfo.pViewportState = &viewportState;
-        pipelineInfo.pRasterizationState = &rasterizer;
-        pipelineInfo.pMultisampleState = &multisampling;
-        pipelineInfo.pDepthStencilState = &depthStencil;
-        pipelineInfo.pColorBlendState = &colorBlending;
-        pipelineInfo.layout = g_pipelineLayout;
-        pipelineInfo.renderPass = g_renderPass;
-        pipelineInfo.subpass = 0;
-        pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
+        VkDeviceSize bufferSize = sizeof(Vertex) * triangleVertices.size();
+        createBuffer(bufferSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                   VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                   g_triangleVertexBuffer, g_triangleVertexBufferMemory);
+        memcpy(g_triangleVertexBufferMemory.mapped, triangleVertices.data(), (size_t)bufferSize);
         
-        if (vkCreateGraphicsPipelines(g_device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &g_cubePipeline) != VK_SUCCESS) {
-            std::cerr << "[Shader Hot-Reload] ERROR: Failed to recreate cube pipeline!" << std::endl;
-            return;
-        }
-    }
-    
-    // Recreate command buffers (they reference the pipeline)
-    // Free old command buffers
-    if (g_commandPool != VK_NULL_HANDLE) {
-        vkFreeCommandBuffers(g_device, g_commandPool, static_cast<uint32_t>(g_commandBuffers.size()), g_commandBuffers.data());
+        std::cout << "[Shader Hot-Reload] Created vertex buffer for custom shaders" << std::endl;
     }
     
-    // Reallocate command buffers
-    g_commandBuffers.resize(g_swapchainImageCount);
-    VkCommandBufferAllocateInfo allocInfo = {};
-    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    allocInfo.commandPool = g_commandPool;
-    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocInfo.commandBufferCount = static_cast<uint32_t>(g_commandBuffers.size());
-    
-    if (vkAllocateCommandBuffers(g_device, &allocInfo, g_commandBuffers.data()) != VK_SUCCESS) {
-        std::cerr << "[Shader Hot-Reload] ERROR: Failed to reallocate command buffers!" << std::endl;
-        return;
-    }
-    
-    std::cout << "[Shader Hot-Reload] Successfully reloaded shader: " << shader_path << std::endl;
+    // Command buffers are re-recorded every frame, so the swapped pipeline is picked up by the
+    // next frame without touching them
+    std::string reloadedPath = shaderPathStr;
+    pipelines.rebuildAsync(targetPipeline, desc, [reloadedPath](bool ok) {
+        if (ok) {
+            std::cout << "[Shader Hot-Reload] Successfully reloaded shader: " << reloadedPath << std::endl;
+        }
+    });
 }
 
 // ============================================================================
@@ -1750,9 +1868,9 @@ extern "C" void heidic_reload_shader(const char* shader_path) {
 
 // Cube-specific state
 static VkBuffer g_cubeVertexBuffer = VK_NULL_HANDLE;
-static VkDeviceMemory g_cubeVertexBufferMemory = VK_NULL_HANDLE;
+static GpuAllocation g_cubeVertexBufferMemory;
 static VkBuffer g_cubeIndexBuffer = VK_NULL_HANDLE;
-static VkDeviceMemory g_cubeIndexBufferMemory = VK_NULL_HANDLE;
+static GpuAllocation g_cubeIndexBufferMemory;
 // g_cubePipeline is already declared at the top of the file (line 43)
 static uint32_t g_cubeIndexCount = 0;
 static float g_cubeRotationAngle = 0.0f;
@@ -1806,10 +1924,8 @@ extern "C" int heidic_init_renderer_cube(GLFWwindow* window) {
                  g_cubeVertexBuffer, g_cubeVertexBufferMemory);
     
     // Copy vertex data to buffer
-    void* data;
-    vkMapMemory(g_device, g_cubeVertexBufferMemory, 0, vertexBufferSize, 0, &data);
+    void* data = g_cubeVertexBufferMemory.mapped;
     memcpy(data, cubeVertices.data(), (size_t)vertexBufferSize);
-    vkUnmapMemory(g_device, g_cubeVertexBufferMemory);
     
     // Create index buffer
     VkDeviceSize indexBufferSize = sizeof(cubeIndices[0]) * cubeIndices.size();
@@ -1819,16 +1935,15 @@ extern "C" int heidic_init_renderer_cube(GLFWwindow* window) {
                  g_cubeIndexBuffer, g_cubeIndexBufferMemory);
     
     // Copy index data to buffer
-    vkMapMemory(g_device, g_cubeIndexBufferMemory, 0, indexBufferSize, 0, &data);
+    data = g_cubeIndexBufferMemory.mapped;
     memcpy(data, cubeIndices.data(), (size_t)indexBufferSize);
-    vkUnmapMemory(g_device, g_cubeIndexBufferMemory);
     
     // Create a new pipeline for cube (with vertex input)
     // Load shaders - readFile already checks multiple paths including examples/spinning_cube/
     std::vector<char> vertShaderCode, fragShaderCode;
     try {
-        vertShaderCode = readFile("vert_cube.spv");
-        fragShaderCode = readFile("frag_cube.spv");
+        vertShaderCode = loadShaderCode("vert_cube.spv");
+        fragShaderCode = loadShaderCode("frag_cube.spv");
         std::cout << "[EDEN] Loaded cube shaders successfully" << std::endl;
     } catch (const std::exception& e) {
         std::cerr << "[EDEN] ERROR: Could not find cube shader files (vert_cube.spv, frag_cube.spv)!" << std::endl;
@@ -1976,7 +2091,7 @@ extern "C" int heidic_init_renderer_cube(GLFWwindow* window) {
     pipelineInfo.subpass = 0;
     pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
     
-    if (vkCreateGraphicsPipelines(g_device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &g_cubePipeline) != VK_SUCCESS) {
+    if (vkCreateGraphicsPipelines(g_device, PipelineCache::get_instance().get(), 1, &pipelineInfo, nullptr, &g_cubePipeline) != VK_SUCCESS) {
         std::cerr << "[EDEN] ERROR: Failed to create cube graphics pipeline!" << std::endl;
         vkDestroyShaderModule(g_device, g_cubeFragShaderModule, nullptr);
         vkDestroyShaderModule(g_device, g_cubeVertShaderModule, nullptr);
@@ -2007,13 +2122,11 @@ extern "C" void heidic_render_frame_cube(GLFWwindow* window) {
         g_cubeRotationAngle -= 2.0f * 3.14159f;
     }
     
-    // Wait for previous frame
-    vkWaitForFences(g_device, 1, &g_inFlightFence, VK_TRUE, UINT64_MAX);
-    vkResetFences(g_device, 1, &g_inFlightFence);
-    
-    // Acquire next image
+    // Wait for this frame slot and acquire the next swapchain image
     uint32_t imageIndex;
-    vkAcquireNextImageKHR(g_device, g_swapchain, UINT64_MAX, g_imageAvailableSemaphore, VK_NULL_HANDLE, &imageIndex);
+    if (!beginFrame(imageIndex)) {
+        return;
+    }
     
     // Reset command buffer
     vkResetCommandBuffer(g_commandBuffers[imageIndex], 0);
@@ -2066,10 +2179,8 @@ extern "C" void heidic_render_frame_cube(GLFWwindow* window) {
     ubo.proj[1][1] *= -1.0f;
     
     // Update uniform buffer
-    void* data;
-    vkMapMemory(g_device, g_uniformBuffersMemory[imageIndex], 0, sizeof(ubo), 0, &data);
+    void* data = g_uniformBuffersMemory[imageIndex].mapped;
     memcpy(data, &ubo, sizeof(ubo));
-    vkUnmapMemory(g_device, g_uniformBuffersMemory[imageIndex]);
     
     // Bind descriptor set
     vkCmdBindDescriptorSets(g_commandBuffers[imageIndex], VK_PIPELINE_BIND_POINT_GRAPHICS, g_pipelineLayout, 0, 1, &g_descriptorSets[imageIndex], 0, nullptr);
@@ -2105,43 +2216,14 @@ extern "C" void heidic_render_frame_cube(GLFWwindow* window) {
     
     if (vkEndCommandBuffer(g_commandBuffers[imageIndex]) != VK_SUCCESS) {
         std::cerr << "[EDEN] ERROR: Failed to record command buffer!" << std::endl;
+        abandonFrame(imageIndex);
         return;
     }
     
-    // Submit command buffer
-    VkSubmitInfo submitInfo = {};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    
-    VkSemaphore waitSemaphores[] = {g_imageAvailableSemaphore};
-    VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-    submitInfo.waitSemaphoreCount = 1;
-    submitInfo.pWaitSemaphores = waitSemaphores;
-    submitInfo.pWaitDstStageMask = waitStages;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &g_commandBuffers[imageIndex];
-    
-    VkSemaphore signalSemaphores[] = {g_renderFinishedSemaphore};
-    submitInfo.signalSemaphoreCount = 1;
-    submitInfo.pSignalSemaphores = signalSemaphores;
-    
-    if (vkQueueSubmit(g_graphicsQueue, 1, &submitInfo, g_inFlightFence) != VK_SUCCESS) {
+    // Submit on this frame slot's fence and present
+    if (!submitFrame(imageIndex)) {
         std::cerr << "[EDEN] ERROR: Failed to submit draw command buffer!" << std::endl;
-        return;
     }
-    
-    // Present
-    VkPresentInfoKHR presentInfo = {};
-    presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-    presentInfo.waitSemaphoreCount = 1;
-    presentInfo.pWaitSemaphores = signalSemaphores;
-    
-    VkSwapchainKHR swapChains[] = {g_swapchain};
-    presentInfo.swapchainCount = 1;
-    presentInfo.pSwapchains = swapChains;
-    presentInfo.pImageIndices = &imageIndex;
-    presentInfo.pResults = nullptr;
-    
-    vkQueuePresentKHR(g_graphicsQueue, &presentInfo);
 }
 
 // ============================================================================
@@ -2154,27 +2236,85 @@ static VkShaderModule g_fpsVertShaderModule = VK_NULL_HANDLE;
 static VkShaderModule g_fpsFragShaderModule = VK_NULL_HANDLE;
 static bool g_fpsInitialized = false;
 static VkBuffer g_fpsCubeVertexBuffer = VK_NULL_HANDLE;
-static VkDeviceMemory g_fpsCubeVertexBufferMemory = VK_NULL_HANDLE;
+static GpuAllocation g_fpsCubeVertexBufferMemory;
 static VkBuffer g_fpsCubeIndexBuffer = VK_NULL_HANDLE;
-static VkDeviceMemory g_fpsCubeIndexBufferMemory = VK_NULL_HANDLE;
+static GpuAllocation g_fpsCubeIndexBufferMemory;
 static uint32_t g_fpsCubeIndexCount = 0;
 
 // Colored reference cubes (1x1x1 cubes for spatial reference)
-static VkBuffer g_coloredCubeVertexBuffers[19] = {VK_NULL_HANDLE};  // 9 big + 5 small + 1 rectangle + 1 pink block + 1 ground + 1 building
-static VkDeviceMemory g_coloredCubeVertexBufferMemory[19] = {VK_NULL_HANDLE};
+// All cubes share one unit cube mesh and are drawn with a single instanced draw: per-cube model
+// matrix and color live in a per-instance vertex buffer rebuilt each frame (see instance_batch.h)
+static const int MAX_COLORED_CUBES = 19;  // 9 big + 5 small + 1 rectangle + 1 pink block + 1 ground + 1 building
+static VkBuffer g_unitCubeVertexBuffer = VK_NULL_HANDLE;
+static GpuAllocation g_unitCubeVertexBufferMemory;
+static VkBuffer g_coloredCubeInstanceBuffer = VK_NULL_HANDLE;
+static GpuAllocation g_coloredCubeInstanceBufferMemory;
+static VkPipeline g_fpsInstancedPipeline = VK_NULL_HANDLE;
+static VkShaderModule g_fpsInstancedVertShaderModule = VK_NULL_HANDLE;
+static bool g_fpsCubeInstancing = false;  // false: instanced vertex shader missing, one draw per cube with push constants
+static InstanceBatch g_coloredCubeBatch;
 static int g_numColoredCubes = 0;
 // Store cube sizes (1.0 for big cubes, 0.5 for small cubes, or per-axis for rectangles)
-static float g_coloredCubeSizes[19] = {0.0f};
+static float g_coloredCubeSizes[MAX_COLORED_CUBES] = {0.0f};
 // Store per-axis sizes for non-uniform shapes (x, y, z)
-static float g_coloredCubeSizeX[19] = {0.0f};
-static float g_coloredCubeSizeY[19] = {0.0f};
-static float g_coloredCubeSizeZ[19] = {0.0f};
+static float g_coloredCubeSizeX[MAX_COLORED_CUBES] = {0.0f};
+static float g_coloredCubeSizeY[MAX_COLORED_CUBES] = {0.0f};
+static float g_coloredCubeSizeZ[MAX_COLORED_CUBES] = {0.0f};
+
+// Debug lines (heidic_draw_line, heidic_draw_ray, heidic_draw_cube_wireframe, ...): accumulated on
+// the CPU until the next heidic_render_fps, which copies them into its region of a persistently
+// mapped ring and draws each category (depth-tested, overlay) with one vkCmdDraw
+static const uint32_t MAX_DEBUG_DRAW_VERTICES = 131072;   // Per frame in flight (2 MB), both categories
+static DebugDrawList g_debugDraw(MAX_DEBUG_DRAW_VERTICES);
+static DebugDrawCategory g_debugDrawCategory = DebugDrawCategory::Depth;
+static VkBuffer g_debugDrawBuffer = VK_NULL_HANDLE;
+static GpuAllocation g_debugDrawBufferMemory;
+static VkShaderModule g_debugLineVertShaderModule = VK_NULL_HANDLE;
+static VkPipeline g_debugLinePipelines[DEBUG_DRAW_CATEGORY_COUNT] = {VK_NULL_HANDLE, VK_NULL_HANDLE};
 
 // FPS Camera matrices for raycasting (updated each frame in heidic_render_fps)
 static glm::mat4 g_fpsCurrentView = glm::mat4(1.0f);
 static glm::mat4 g_fpsCurrentProj = glm::mat4(1.0f);
 static glm::vec3 g_fpsCurrentCamPos = glm::vec3(0.0f);
 
+// Per-frame culling scratch (bounds are rebuilt each frame; visible indices index into them)
+static CullBoxes g_coloredCubeBounds;
+static CullSpheres g_ballBounds;
+static std::vector<uint32_t> g_visibleIndices;
+
+// Ray query acceleration over the colored cubes: rebuilt when the cube set changes, refit when
+// cubes move (heidic_set_cube_position, attached cubes) before the next raycast
+static Bvh g_coloredCubeBvh;
+static std::vector<BvhBounds> g_coloredCubeBvhBounds;
+static bool g_coloredCubeBvhDirty = true;
+static BvhHit g_lastRaycastHit;                 // Result of the last heidic_raycast_cubes/pick call
+static glm::vec3 g_lastRaycastPoint = glm::vec3(0.0f);
+// Cubes the game leaves out of ray queries (heidic_raycast_set_ignored_cube); cleared by renderer init
+static bool g_cubeIgnoredByPicks[MAX_COLORED_CUBES] = {false};     // heidic_raycast_cubes/pick_center/cubes_batch
+static bool g_cubeIgnoredByGround[MAX_COLORED_CUBES] = {false};    // heidic_raycast_downward_big_cube/downward_batch
+
+// Collision broadphase over the colored cubes. Each cube collides as a box of its render size
+// unless heidic_apply_hdm_physics_to_cube gave it the loaded HDM physics properties; the proxy set
+// is rebuilt when those settings change and moved on every heidic_update_cube_broadphase call.
+struct CubeCollision {
+    int collisionType = 1;                     // 0=none, 1=box, 2=mesh (broadphase uses the box)
+    float bounds[3] = {0.0f, 0.0f, 0.0f};      // Collision box size (0 = use the cube's size)
+    bool isStatic = false;
+    float mass = 1.0f;
+};
+static CubeCollision g_cubeCollision[MAX_COLORED_CUBES];
+static SweepAndPrune g_cubeBroadphase;
+static std::vector<uint32_t> g_cubeBroadphaseProxies;    // Proxy id per cube (INVALID_PROXY = no collision)
+static std::vector<BroadphasePair> g_cubeOverlapPairs;   // Cube index pairs from the last update
+static bool g_cubeBroadphaseDirty = true;
+
+// Rigid-body physics for cubes enabled with heidic_physics_enable_cube (the starting floor is a
+// static body); heidic_physics_step copies simulated positions back into the cube positions
+static PhysicsWorld g_cubePhysics;
+static uint32_t g_cubeBodies[MAX_COLORED_CUBES];
+static uint32_t g_cubePhysicsFloor = PhysicsWorld::INVALID_BODY;
+static bool g_cubeBodiesInitialized = false;
+
 // Mutable cube positions (for pickup system)
 struct ColoredCubePos {
     float x, y, z;
@@ -2186,6 +2326,8 @@ struct ColoredCubeColor {
     float r, g, b;
 };
 static std::vector<ColoredCubeColor> g_coloredCubeOriginalColors;
+// Current cube colors (original or selection highlight), copied into the instance buffer each frame
+static std::vector<ColoredCubeColor> g_coloredCubeColors;
 
 // Store cube rotations (yaw in degrees, for visual rotation around Y axis)
 static std::vector<float> g_coloredCubeRotations;
@@ -2286,10 +2428,8 @@ extern "C" int heidic_init_renderer_fps(GLFWwindow* window) {
                      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                      g_fpsCubeVertexBuffer, g_fpsCubeVertexBufferMemory);
         
-        void* data;
-        vkMapMemory(g_device, g_fpsCubeVertexBufferMemory, 0, vertexBufferSize, 0, &data);
+        void* data = g_fpsCubeVertexBufferMemory.mapped;
         memcpy(data, floorCubeVertices.data(), (size_t)vertexBufferSize);
-        vkUnmapMemory(g_device, g_fpsCubeVertexBufferMemory);
         
         // Create index buffer
         VkDeviceSize indexBufferSize = sizeof(floorCubeIndices[0]) * floorCubeIndices.size();
@@ -2298,9 +2438,8 @@ extern "C" int heidic_init_renderer_fps(GLFWwindow* window) {
                      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                      g_fpsCubeIndexBuffer, g_fpsCubeIndexBufferMemory);
         
-        vkMapMemory(g_device, g_fpsCubeIndexBufferMemory, 0, indexBufferSize, 0, &data);
+        data = g_fpsCubeIndexBufferMemory.mapped;
         memcpy(data, floorCubeIndices.data(), (size_t)indexBufferSize);
-        vkUnmapMemory(g_device, g_fpsCubeIndexBufferMemory);
         
         std::cout << "[FPS] Created floor cube buffers: " << floorCubeVertices.size() << " vertices, " 
                   << floorCubeIndices.size() << " indices" << std::endl;
@@ -2339,7 +2478,17 @@ extern "C" int heidic_init_renderer_fps(GLFWwindow* window) {
         {500.0f, 25.0f, 0.0f, 1.0f, 1.0f, 0.0f},  // Yellow building at +500X, 25 units up (half of 50 height)
     };
     
-    g_numColoredCubes = static_cast<int>(referenceCubes.size());
+    g_numColoredCubes = std::min(static_cast<int>(referenceCubes.size()), MAX_COLORED_CUBES);
+    g_coloredCubeBvhDirty = true;
+    g_cubeBroadphaseDirty = true;
+    for (int i = 0; i < MAX_COLORED_CUBES; i++) {
+        g_cubeCollision[i] = CubeCollision();
+        g_cubeIgnoredByPicks[i] = false;
+        g_cubeIgnoredByGround[i] = false;
+    }
+    // Ground platform and building never move
+    g_cubeCollision[16].isStatic = true;
+    g_cubeCollision[17].isStatic = true;
     
     // Initialize global cube positions array, store original colors, initialize rotations, attachment data, and item properties
     g_coloredCubePositions.clear();
@@ -2406,31 +2555,33 @@ extern "C" int heidic_init_renderer_fps(GLFWwindow* window) {
         }
     }
     
-    // Create vertex buffers for each colored cube
-    // Note: All vertices are created at size 1.0 (from -0.5 to 0.5), scaling is done in model matrix
-    for (int i = 0; i < g_numColoredCubes && i < 19; i++) {
-        // Create cube vertices with the specified color (always size 1.0, scaled in model matrix)
-        std::vector<Vertex> coloredCubeVertices = {
-            {{-0.5f, -0.5f,  0.5f}, {referenceCubes[i].r, referenceCubes[i].g, referenceCubes[i].b}},
-            {{ 0.5f, -0.5f,  0.5f}, {referenceCubes[i].r, referenceCubes[i].g, referenceCubes[i].b}},
-            {{ 0.5f,  0.5f,  0.5f}, {referenceCubes[i].r, referenceCubes[i].g, referenceCubes[i].b}},
-            {{-0.5f,  0.5f,  0.5f}, {referenceCubes[i].r, referenceCubes[i].g, referenceCubes[i].b}},
-            {{-0.5f, -0.5f, -0.5f}, {referenceCubes[i].r, referenceCubes[i].g, referenceCubes[i].b}},
-            {{ 0.5f, -0.5f, -0.5f}, {referenceCubes[i].r, referenceCubes[i].g, referenceCubes[i].b}},
-            {{ 0.5f,  0.5f, -0.5f}, {referenceCubes[i].r, referenceCubes[i].g, referenceCubes[i].b}},
-            {{-0.5f,  0.5f, -0.5f}, {referenceCubes[i].r, referenceCubes[i].g, referenceCubes[i].b}},
+    // Create the shared unit cube (-0.5 to 0.5); size, rotation, position and color are per instance
+    {
+        std::vector<Vertex> unitCubeVertices = {
+            {{-0.5f, -0.5f,  0.5f}, {1.0f, 1.0f, 1.0f}},
+            {{ 0.5f, -0.5f,  0.5f}, {1.0f, 1.0f, 1.0f}},
+            {{ 0.5f,  0.5f,  0.5f}, {1.0f, 1.0f, 1.0f}},
+            {{-0.5f,  0.5f,  0.5f}, {1.0f, 1.0f, 1.0f}},
+            {{-0.5f, -0.5f, -0.5f}, {1.0f, 1.0f, 1.0f}},
+            {{ 0.5f, -0.5f, -0.5f}, {1.0f, 1.0f, 1.0f}},
+            {{ 0.5f,  0.5f, -0.5f}, {1.0f, 1.0f, 1.0f}},
+            {{-0.5f,  0.5f, -0.5f}, {1.0f, 1.0f, 1.0f}},
         };
         
-        VkDeviceSize vertexBufferSize = sizeof(coloredCubeVertices[0]) * coloredCubeVertices.size();
+        VkDeviceSize vertexBufferSize = sizeof(unitCubeVertices[0]) * unitCubeVertices.size();
         createBuffer(vertexBufferSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
                      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                     g_coloredCubeVertexBuffers[i], g_coloredCubeVertexBufferMemory[i]);
+                     g_unitCubeVertexBuffer, g_unitCubeVertexBufferMemory);
+        memcpy(g_unitCubeVertexBufferMemory.mapped, unitCubeVertices.data(), (size_t)vertexBufferSize);
         
-        void* data;
-        vkMapMemory(g_device, g_coloredCubeVertexBufferMemory[i], 0, vertexBufferSize, 0, &data);
-        memcpy(data, coloredCubeVertices.data(), (size_t)vertexBufferSize);
-        vkUnmapMemory(g_device, g_coloredCubeVertexBufferMemory[i]);
+        // Per-instance ring: one region per frame in flight, persistently mapped and rewritten by
+        // the frame slot that owns it (the GPU may still read the other regions)
+        createBuffer(sizeof(MeshInstance) * MAX_COLORED_CUBES * g_framesInFlight, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                     g_coloredCubeInstanceBuffer, g_coloredCubeInstanceBufferMemory);
+        g_coloredCubeBatch.reserve(MAX_COLORED_CUBES);
     }
+    g_coloredCubeColors = g_coloredCubeOriginalColors;
     
     std::cout << "[FPS] Created " << g_numColoredCubes << " colored reference cubes" << std::endl;
     
@@ -2481,20 +2632,20 @@ extern "C" int heidic_init_renderer_fps(GLFWwindow* window) {
     std::vector<char> vertShaderCode, fragShaderCode;
     try {
         // Use cube shaders first (these are known to work)
-        vertShaderCode = readFile("vert_cube.spv");
-        fragShaderCode = readFile("frag_cube.spv");
+        vertShaderCode = loadShaderCode("vert_cube.spv");
+        fragShaderCode = loadShaderCode("frag_cube.spv");
         std::cout << "[FPS] Using cube shaders (vert_cube.spv, frag_cube.spv) - same as working spinning cube" << std::endl;
     } catch (const std::exception&) {
         // Fall back to fps-specific shaders
         try {
-            vertShaderCode = readFile("vert_fps.spv");
-            fragShaderCode = readFile("frag_fps.spv");
+            vertShaderCode = loadShaderCode("vert_fps.spv");
+            fragShaderCode = loadShaderCode("frag_fps.spv");
             std::cout << "[FPS] Using FPS-specific shaders (vert_fps.spv, frag_fps.spv)" << std::endl;
         } catch (const std::exception&) {
             // Last resort: default 3d shaders (but these are broken - missing vertex inputs)
             try {
-                vertShaderCode = readFile("vert_3d.spv");
-                fragShaderCode = readFile("frag_3d.spv");
+                vertShaderCode = loadShaderCode("vert_3d.spv");
+                fragShaderCode = loadShaderCode("frag_3d.spv");
                 std::cerr << "[FPS] WARNING: Using default 3D shaders (vert_3d.spv, frag_3d.spv) - these may be broken!" << std::endl;
                 std::cerr << "[FPS] Validation layer reported these shaders don't consume vertex attributes!" << std::endl;
             } catch (const std::exception& e) {
@@ -2645,18 +2796,167 @@ extern "C" int heidic_init_renderer_fps(GLFWwindow* window) {
     pipelineInfo.subpass = 0;
     pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
     
-    if (vkCreateGraphicsPipelines(g_device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &g_fpsPipeline) != VK_SUCCESS) {
+    if (vkCreateGraphicsPipelines(g_device, PipelineCache::get_instance().get(), 1, &pipelineInfo, nullptr, &g_fpsPipeline) != VK_SUCCESS) {
         std::cerr << "[FPS] ERROR: Failed to create FPS graphics pipeline!" << std::endl;
         vkDestroyShaderModule(g_device, g_fpsFragShaderModule, nullptr);
         vkDestroyShaderModule(g_device, g_fpsVertShaderModule, nullptr);
         return 0;
     }
     
+    // Colored cube pipeline: shared unit cube positions (binding 0) + per-instance data (binding 1)
+    // The instanced vertex shader reads the model matrix from the instance buffer; without it the
+    // cube shader is used (model from push constants) and only the color comes from the instance
+    try {
+        std::vector<char> instancedVertCode;
+        try {
+            instancedVertCode = loadShaderCode("shaders/fps_instanced.vert.spv");
+        } catch (const std::exception&) {
+            instancedVertCode = loadShaderCode("fps_instanced.vert.spv");
+        }
+        
+        VkShaderModuleCreateInfo instancedCreateInfo = {};
+        instancedCreateInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        instancedCreateInfo.codeSize = instancedVertCode.size();
+        instancedCreateInfo.pCode = reinterpret_cast<const uint32_t*>(instancedVertCode.data());
+        if (vkCreateShaderModule(g_device, &instancedCreateInfo, nullptr, &g_fpsInstancedVertShaderModule) == VK_SUCCESS) {
+            g_fpsCubeInstancing = true;
+        }
+    } catch (const std::exception&) {
+        g_fpsCubeInstancing = false;
+    }
+    if (!g_fpsCubeInstancing) {
+        std::cout << "[FPS] fps_instanced.vert.spv not found - colored cubes use one draw each" << std::endl;
+    }
+    
+    VkVertexInputBindingDescription instancedBindings[2] = {bindingDescription, {}};
+    instancedBindings[1].binding = 1;
+    instancedBindings[1].stride = sizeof(MeshInstance);
+    instancedBindings[1].inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+    
+    VkVertexInputAttributeDescription instancedAttributes[6] = {};
+    instancedAttributes[0] = attributeDescriptions[0];
+    instancedAttributes[1].binding = 1;
+    instancedAttributes[1].location = 1;
+    instancedAttributes[1].format = VK_FORMAT_R32G32B32_SFLOAT;
+    instancedAttributes[1].offset = offsetof(MeshInstance, color);
+    for (uint32_t column = 0; column < 4; column++) {
+        instancedAttributes[2 + column].binding = 1;
+        instancedAttributes[2 + column].location = 2 + column;
+        instancedAttributes[2 + column].format = VK_FORMAT_R32G32B32A32_SFLOAT;
+        instancedAttributes[2 + column].offset = offsetof(MeshInstance, model) + column * 4 * sizeof(float);
+    }
+    
+    VkPipelineVertexInputStateCreateInfo instancedVertexInputInfo = vertexInputInfo;
+    instancedVertexInputInfo.vertexBindingDescriptionCount = 2;
+    instancedVertexInputInfo.pVertexBindingDescriptions = instancedBindings;
+    instancedVertexInputInfo.vertexAttributeDescriptionCount = g_fpsCubeInstancing ? 6 : 2;
+    instancedVertexInputInfo.pVertexAttributeDescriptions = instancedAttributes;
+    
+    VkPipelineShaderStageCreateInfo instancedShaderStages[] = {vertShaderStageInfo, fragShaderStageInfo};
+    if (g_fpsCubeInstancing) {
+        instancedShaderStages[0].module = g_fpsInstancedVertShaderModule;
+    }
+    pipelineInfo.pStages = instancedShaderStages;
+    pipelineInfo.pVertexInputState = &instancedVertexInputInfo;
+    
+    if (vkCreateGraphicsPipelines(g_device, PipelineCache::get_instance().get(), 1, &pipelineInfo, nullptr, &g_fpsInstancedPipeline) != VK_SUCCESS) {
+        std::cerr << "[FPS] ERROR: Failed to create colored cube pipeline!" << std::endl;
+        g_fpsInstancedPipeline = VK_NULL_HANDLE;
+    }
+    
+    // Debug line pipelines: world-space line list (DebugVertex) with the cube fragment shader,
+    // one depth-tested and one overlay; both read the same per-frame region of the debug ring
+    try {
+        std::vector<char> debugVertCode;
+        try {
+            debugVertCode = loadShaderCode("shaders/debug_line.vert.spv");
+        } catch (const std::exception&) {
+            debugVertCode = loadShaderCode("debug_line.vert.spv");
+        }
+        
+        VkShaderModuleCreateInfo debugCreateInfo = {};
+        debugCreateInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        debugCreateInfo.codeSize = debugVertCode.size();
+        debugCreateInfo.pCode = reinterpret_cast<const uint32_t*>(debugVertCode.data());
+        if (vkCreateShaderModule(g_device, &debugCreateInfo, nullptr, &g_debugLineVertShaderModule) != VK_SUCCESS) {
+            g_debugLineVertShaderModule = VK_NULL_HANDLE;
+        }
+    } catch (const std::exception&) {
+        g_debugLineVertShaderModule = VK_NULL_HANDLE;
+    }
+    
+    if (g_debugLineVertShaderModule != VK_NULL_HANDLE) {
+        GraphicsPipelineDesc debugDesc;
+        debugDesc.vertexShader = g_debugLineVertShaderModule;
+        debugDesc.fragmentShader = g_fpsFragShaderModule;
+        debugDesc.bindings.push_back({0, sizeof(DebugVertex), VK_VERTEX_INPUT_RATE_VERTEX});
+        debugDesc.attributes.push_back({0, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(DebugVertex, position)});
+        debugDesc.attributes.push_back({1, 0, VK_FORMAT_R8G8B8A8_UNORM, offsetof(DebugVertex, color)});
+        debugDesc.topology = VK_PRIMITIVE_TOPOLOGY_LINE_LIST;
+        debugDesc.extent = g_swapchainExtent;
+        debugDesc.depthCompareOp = VK_COMPARE_OP_LESS_OR_EQUAL;  // Edges drawn exactly on a face still show
+        debugDesc.layout = g_pipelineLayout;
+        debugDesc.renderPass = g_renderPass;
+        for (uint32_t category = 0; category < DEBUG_DRAW_CATEGORY_COUNT; category++) {
+            debugDesc.depthTest = category == static_cast<uint32_t>(DebugDrawCategory::Depth);
+            if (create_graphics_pipeline(g_device, PipelineCache::get_instance().get(), debugDesc, &g_debugLinePipelines[category]) != VK_SUCCESS) {
+                std::cerr << "[FPS] ERROR: Failed to create debug line pipeline!" << std::endl;
+                g_debugLinePipelines[category] = VK_NULL_HANDLE;
+            }
+        }
+        createBuffer(sizeof(DebugVertex) * MAX_DEBUG_DRAW_VERTICES * g_framesInFlight, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                     g_debugDrawBuffer, g_debugDrawBufferMemory);
+    } else {
+        std::cout << "[FPS] debug_line.vert.spv not found - debug lines are not drawn" << std::endl;
+    }
+    
     g_fpsInitialized = true;
     std::cout << "[FPS] FPS camera renderer initialized successfully!" << std::endl;
     return 1;
 }
 
+// Current transform and color of one colored cube
+// Vertices are a unit cube, so the scale is the actual size (per-axis if set, otherwise uniform)
+static InstanceTransform coloredCubeTransform(int i) {
+    InstanceTransform transform;
+    transform.position[0] = g_coloredCubePositions[i].x;
+    transform.position[1] = g_coloredCubePositions[i].y;
+    transform.position[2] = g_coloredCubePositions[i].z;
+    transform.yawDegrees = i < static_cast<int>(g_coloredCubeRotations.size()) ? g_coloredCubeRotations[i] : 0.0f;
+    transform.scale[0] = g_coloredCubeSizeX[i] > 0.0f ? g_coloredCubeSizeX[i] : g_coloredCubeSizes[i];
+    transform.scale[1] = g_coloredCubeSizeY[i] > 0.0f ? g_coloredCubeSizeY[i] : g_coloredCubeSizes[i];
+    transform.scale[2] = g_coloredCubeSizeZ[i] > 0.0f ? g_coloredCubeSizeZ[i] : g_coloredCubeSizes[i];
+    if (i < static_cast<int>(g_coloredCubeColors.size())) {
+        transform.color[0] = g_coloredCubeColors[i].r;
+        transform.color[1] = g_coloredCubeColors[i].g;
+        transform.color[2] = g_coloredCubeColors[i].b;
+    }
+    return transform;
+}
+
+// Gather the colored cubes inside the view frustum into g_coloredCubeBatch
+static void buildColoredCubeBatch(const CullParams& cullParams) {
+    g_coloredCubeBatch.clear();
+    g_coloredCubeBounds.clear();
+    int count = std::min(g_numColoredCubes, static_cast<int>(g_coloredCubePositions.size()));
+    for (int i = 0; i < count; i++) {
+        // World AABB of the yaw-rotated box: half extents projected onto the world X/Z axes
+        InstanceTransform transform = coloredCubeTransform(i);
+        float yawRad = transform.yawDegrees * (3.14159265358979f / 180.0f);
+        float c = std::fabs(std::cos(yawRad));
+        float s = std::fabs(std::sin(yawRad));
+        float hx = transform.scale[0] * 0.5f;
+        float hz = transform.scale[2] * 0.5f;
+        g_coloredCubeBounds.add(transform.position[0], transform.position[1], transform.position[2],
+                                c * hx + s * hz, transform.scale[1] * 0.5f, s * hx + c * hz);
+    }
+    cull_boxes(g_coloredCubeBounds, cullParams, g_visibleIndices);
+    for (uint32_t index : g_visibleIndices) {
+        g_coloredCubeBatch.add(coloredCubeTransform(static_cast<int>(index)));
+    }
+}
+
 // Render FPS camera frame
 extern "C" void heidic_render_fps(GLFWwindow* window, float camera_pos_x, float camera_pos_y, float camera_pos_z, float camera_yaw, float camera_pitch) {
     if (g_device == VK_NULL_HANDLE || g_swapchain == VK_NULL_HANDLE) {
@@ -2670,13 +2970,11 @@ extern "C" void heidic_render_fps(GLFWwindow* window, float camera_pos_x, float
         return;
     }
     
-    // Wait for previous frame
-    vkWaitForFences(g_device, 1, &g_inFlightFence, VK_TRUE, UINT64_MAX);
-    vkResetFences(g_device, 1, &g_inFlightFence);
-    
-    // Acquire next image
+    // Wait for this frame slot and acquire the next swapchain image
     uint32_t imageIndex;
-    vkAcquireNextImageKHR(g_device, g_swapchain, UINT64_MAX, g_imageAvailableSemaphore, VK_NULL_HANDLE, &imageIndex);
+    if (!beginFrame(imageIndex)) {
+        return;
+    }
     
     // Reset command buffer
     vkResetCommandBuffer(g_commandBuffers[imageIndex], 0);
@@ -2767,21 +3065,37 @@ extern "C" void heidic_render_fps(GLFWwindow* window, float camera_pos_x, float
     g_fpsCurrentProj = ubo.proj;
     g_fpsCurrentCamPos = glm::vec3(camera_pos_x, camera_pos_y, camera_pos_z);
     
+    // Frustum (and optional distance) culling for this frame's draw lists
+    CullParams cullParams;
+    cullParams.planes = extract_frustum_planes(&g_fpsCurrentView[0][0], &g_fpsCurrentProj[0][0]);
+    cullParams.eye[0] = camera_pos_x;
+    cullParams.eye[1] = camera_pos_y;
+    cullParams.eye[2] = camera_pos_z;
+    cullParams.maxDistance = g_cullMaxDistance;
+    
+    // The camera is the audio listener (view matrix rows are the camera axes)
+    {
+        float listenerPos[3] = {camera_pos_x, camera_pos_y, camera_pos_z};
+        float listenerForward[3] = {-ubo.view[0][2], -ubo.view[1][2], -ubo.view[2][2]};
+        float listenerUp[3] = {ubo.view[0][1], ubo.view[1][1], ubo.view[2][1]};
+        SpatialAudio::get_instance().setListener(listenerPos, listenerForward, listenerUp);
+    }
+    
     // No per-frame debug spam
     
     // Update uniform buffer for floor cube
-    void* data;
-    vkMapMemory(g_device, g_uniformBuffersMemory[imageIndex], 0, sizeof(ubo), 0, &data);
+    void* data = g_uniformBuffersMemory[imageIndex].mapped;
     memcpy(data, &ubo, sizeof(ubo));
-    vkUnmapMemory(g_device, g_uniformBuffersMemory[imageIndex]);
     
     // DIAGNOSTIC: Verify descriptor sets are valid
     if (g_descriptorSets.empty() || imageIndex >= g_descriptorSets.size() || g_descriptorSets[imageIndex] == VK_NULL_HANDLE) {
         std::cerr << "[FPS] ERROR: Descriptor set is NULL! imageIndex=" << imageIndex << ", sets.size()=" << g_descriptorSets.size() << std::endl;
+        abandonFrame(imageIndex);
         return;
     }
     if (g_uniformBuffers.empty() || imageIndex >= g_uniformBuffers.size() || g_uniformBuffers[imageIndex] == VK_NULL_HANDLE) {
         std::cerr << "[FPS] ERROR: Uniform buffer is NULL! imageIndex=" << imageIndex << ", buffers.size()=" << g_uniformBuffers.size() << std::endl;
+        abandonFrame(imageIndex);
         return;
     }
     
@@ -2802,45 +3116,48 @@ extern "C" void heidic_render_fps(GLFWwindow* window, float camera_pos_x, float
     // Draw floor cube using indexed drawing
     vkCmdDrawIndexed(g_commandBuffers[imageIndex], g_fpsCubeIndexCount, 1, 0, 0, 0);
     
-    // Draw multiple colored 1x1x1 cubes on top of the floor for spatial reference
-    // Use global mutable cube positions array (for pickup system)
-    
-    // Render colored cubes if they were created
-    for (int i = 0; i < g_numColoredCubes && i < static_cast<int>(g_coloredCubePositions.size()); i++) {
-        if (g_coloredCubeVertexBuffers[i] == VK_NULL_HANDLE) {
-            continue;
-        }
+    // Draw the colored reference cubes on top of the floor: one instanced draw of the shared unit cube
+    if (g_fpsInstancedPipeline != VK_NULL_HANDLE && g_coloredCubeInstanceBuffer != VK_NULL_HANDLE) {
+        buildColoredCubeBatch(cullParams);
+        VkDeviceSize instanceOffset = sizeof(MeshInstance) * MAX_COLORED_CUBES * g_currentFrame;
+        MeshInstance* instances = reinterpret_cast<MeshInstance*>(static_cast<char*>(g_coloredCubeInstanceBufferMemory.mapped) + instanceOffset);
+        uint32_t instanceCount = static_cast<uint32_t>(g_coloredCubeBatch.build(instances, MAX_COLORED_CUBES));
         
-        // Model matrix: cube at the specified position with rotation
-        // Note: Vertices are created at size 1.0, so we need to scale them to the actual size
-        // Use per-axis sizes if available, otherwise use uniform size
-        // Transform order: translate, rotate (around Y axis), scale
-        float scaleX = g_coloredCubeSizeX[i] > 0.0f ? g_coloredCubeSizeX[i] : g_coloredCubeSizes[i];
-        float scaleY = g_coloredCubeSizeY[i] > 0.0f ? g_coloredCubeSizeY[i] : g_coloredCubeSizes[i];
-        float scaleZ = g_coloredCubeSizeZ[i] > 0.0f ? g_coloredCubeSizeZ[i] : g_coloredCubeSizes[i];
-        glm::mat4 cubeModel = glm::mat4(1.0f);
-        cubeModel = glm::translate(cubeModel, glm::vec3(g_coloredCubePositions[i].x, g_coloredCubePositions[i].y, g_coloredCubePositions[i].z));
-        // Apply rotation around Y axis (yaw) if cube has rotation set
-        if (i < static_cast<int>(g_coloredCubeRotations.size()) && g_coloredCubeRotations[i] != 0.0f) {
-            float yaw_rad = g_coloredCubeRotations[i] * 3.14159f / 180.0f;  // Convert degrees to radians
-            cubeModel = glm::rotate(cubeModel, yaw_rad, glm::vec3(0.0f, 1.0f, 0.0f));
+        if (instanceCount > 0) {
+            // Same pipeline layout, so the descriptor set stays bound across the pipeline switch
+            vkCmdBindPipeline(g_commandBuffers[imageIndex], VK_PIPELINE_BIND_POINT_GRAPHICS, g_fpsInstancedPipeline);
+            
+            VkBuffer cubeBuffers[] = {g_unitCubeVertexBuffer, g_coloredCubeInstanceBuffer};
+            VkDeviceSize cubeOffsets[] = {0, instanceOffset};
+            vkCmdBindVertexBuffers(g_commandBuffers[imageIndex], 0, 2, cubeBuffers, cubeOffsets);
+            
+            // The floor's index buffer is still bound (same 36-index cube topology)
+            if (g_fpsCubeInstancing) {
+                vkCmdDrawIndexed(g_commandBuffers[imageIndex], 36, instanceCount, 0, 0, 0);
+            } else {
+                for (uint32_t i = 0; i < instanceCount; i++) {
+                    vkCmdPushConstants(g_commandBuffers[imageIndex], g_pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(instances[i].model), instances[i].model);
+                    vkCmdDrawIndexed(g_commandBuffers[imageIndex], 36, 1, 0, 0, i);
+                }
+            }
+        }
+    }
+    
+    // Debug lines submitted since the last frame: one draw per category (depth-tested, then overlay)
+    if (g_debugDrawBuffer != VK_NULL_HANDLE && !g_debugDraw.empty()) {
+        VkDeviceSize debugOffset = sizeof(DebugVertex) * MAX_DEBUG_DRAW_VERTICES * g_currentFrame;
+        DebugVertex* debugVertices = reinterpret_cast<DebugVertex*>(static_cast<char*>(g_debugDrawBufferMemory.mapped) + debugOffset);
+        DebugDrawRange ranges[DEBUG_DRAW_CATEGORY_COUNT];
+        g_debugDraw.build(debugVertices, MAX_DEBUG_DRAW_VERTICES, ranges);
+        vkCmdBindVertexBuffers(g_commandBuffers[imageIndex], 0, 1, &g_debugDrawBuffer, &debugOffset);
+        for (uint32_t category = 0; category < DEBUG_DRAW_CATEGORY_COUNT; category++) {
+            if (ranges[category].vertexCount > 0 && g_debugLinePipelines[category] != VK_NULL_HANDLE) {
+                vkCmdBindPipeline(g_commandBuffers[imageIndex], VK_PIPELINE_BIND_POINT_GRAPHICS, g_debugLinePipelines[category]);
+                vkCmdDraw(g_commandBuffers[imageIndex], ranges[category].vertexCount, 1, ranges[category].firstVertex, 0);
+            }
         }
-        cubeModel = glm::scale(cubeModel, glm::vec3(scaleX, scaleY, scaleZ));  // Scale to actual size (supports non-uniform)
-        
-        // Push model matrix as push constant (each draw gets its own matrix)
-        vkCmdPushConstants(g_commandBuffers[imageIndex], g_pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(glm::mat4), &cubeModel);
-        
-        // Bind the colored cube's vertex buffer
-        VkBuffer vertexBuffers[] = {g_coloredCubeVertexBuffers[i]};
-        VkDeviceSize offsets[] = {0};
-        vkCmdBindVertexBuffers(g_commandBuffers[imageIndex], 0, 1, vertexBuffers, offsets);
-        
-        // Rebind index buffer (same indices work for all cubes - 36 indices for a cube)
-        vkCmdBindIndexBuffer(g_commandBuffers[imageIndex], g_fpsCubeIndexBuffer, 0, VK_INDEX_TYPE_UINT16);
-        
-        // Draw the cube (36 indices for a cube: 6 faces * 2 triangles * 3 vertices)
-        vkCmdDrawIndexed(g_commandBuffers[imageIndex], 36, 1, 0, 0, 0);
     }
+    g_debugDraw.clear();
     
     // Render Neuroshell UI (includes crosshair)
     #ifdef USE_NEUROSHELL
@@ -2855,43 +3172,14 @@ extern "C" void heidic_render_fps(GLFWwindow* window, float camera_pos_x, float
     
     if (vkEndCommandBuffer(g_commandBuffers[imageIndex]) != VK_SUCCESS) {
         std::cerr << "[FPS] ERROR: Failed to record command buffer!" << std::endl;
+        abandonFrame(imageIndex);
         return;
     }
     
-    // Submit command buffer
-    VkSubmitInfo submitInfo = {};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    
-    VkSemaphore waitSemaphores[] = {g_imageAvailableSemaphore};
-    VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-    submitInfo.waitSemaphoreCount = 1;
-    submitInfo.pWaitSemaphores = waitSemaphores;
-    submitInfo.pWaitDstStageMask = waitStages;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &g_commandBuffers[imageIndex];
-    
-    VkSemaphore signalSemaphores[] = {g_renderFinishedSemaphore};
-    submitInfo.signalSemaphoreCount = 1;
-    submitInfo.pSignalSemaphores = signalSemaphores;
-    
-    if (vkQueueSubmit(g_graphicsQueue, 1, &submitInfo, g_inFlightFence) != VK_SUCCESS) {
+    // Submit on this frame slot's fence and present
+    if (!submitFrame(imageIndex)) {
         std::cerr << "[FPS] ERROR: Failed to submit draw command buffer!" << std::endl;
-        return;
     }
-    
-    // Present
-    VkPresentInfoKHR presentInfo = {};
-    presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-    presentInfo.waitSemaphoreCount = 1;
-    presentInfo.pWaitSemaphores = signalSemaphores;
-    
-    VkSwapchainKHR swapChains[] = {g_swapchain};
-    presentInfo.swapchainCount = 1;
-    presentInfo.pSwapchains = swapChains;
-    presentInfo.pImageIndices = &imageIndex;
-    presentInfo.pResults = nullptr;
-    
-    vkQueuePresentKHR(g_graphicsQueue, &presentInfo);
 }
 
 // Cleanup FPS renderer
@@ -2904,31 +3192,57 @@ extern "C" void heidic_cleanup_renderer_fps() {
             vkDestroyBuffer(g_device, g_fpsCubeIndexBuffer, nullptr);
             g_fpsCubeIndexBuffer = VK_NULL_HANDLE;
         }
-        if (g_fpsCubeIndexBufferMemory != VK_NULL_HANDLE) {
-            vkFreeMemory(g_device, g_fpsCubeIndexBufferMemory, nullptr);
-            g_fpsCubeIndexBufferMemory = VK_NULL_HANDLE;
-        }
+        GpuAllocator::get_instance().free(g_fpsCubeIndexBufferMemory);
         if (g_fpsCubeVertexBuffer != VK_NULL_HANDLE) {
             vkDestroyBuffer(g_device, g_fpsCubeVertexBuffer, nullptr);
             g_fpsCubeVertexBuffer = VK_NULL_HANDLE;
         }
-        if (g_fpsCubeVertexBufferMemory != VK_NULL_HANDLE) {
-            vkFreeMemory(g_device, g_fpsCubeVertexBufferMemory, nullptr);
-            g_fpsCubeVertexBufferMemory = VK_NULL_HANDLE;
-        }
+        GpuAllocator::get_instance().free(g_fpsCubeVertexBufferMemory);
         
         // Cleanup colored cube buffers
-        for (int i = 0; i < g_numColoredCubes && i < 10; i++) {
-            if (g_coloredCubeVertexBuffers[i] != VK_NULL_HANDLE) {
-                vkDestroyBuffer(g_device, g_coloredCubeVertexBuffers[i], nullptr);
-                g_coloredCubeVertexBuffers[i] = VK_NULL_HANDLE;
-            }
-            if (g_coloredCubeVertexBufferMemory[i] != VK_NULL_HANDLE) {
-                vkFreeMemory(g_device, g_coloredCubeVertexBufferMemory[i], nullptr);
-                g_coloredCubeVertexBufferMemory[i] = VK_NULL_HANDLE;
+        if (g_coloredCubeInstanceBuffer != VK_NULL_HANDLE) {
+            vkDestroyBuffer(g_device, g_coloredCubeInstanceBuffer, nullptr);
+            g_coloredCubeInstanceBuffer = VK_NULL_HANDLE;
+        }
+        GpuAllocator::get_instance().free(g_coloredCubeInstanceBufferMemory);
+        if (g_unitCubeVertexBuffer != VK_NULL_HANDLE) {
+            vkDestroyBuffer(g_device, g_unitCubeVertexBuffer, nullptr);
+            g_unitCubeVertexBuffer = VK_NULL_HANDLE;
+        }
+        GpuAllocator::get_instance().free(g_unitCubeVertexBufferMemory);
+        
+        // Cleanup debug lines
+        if (g_debugDrawBuffer != VK_NULL_HANDLE) {
+            vkDestroyBuffer(g_device, g_debugDrawBuffer, nullptr);
+            g_debugDrawBuffer = VK_NULL_HANDLE;
+        }
+        GpuAllocator::get_instance().free(g_debugDrawBufferMemory);
+        for (VkPipeline& pipeline : g_debugLinePipelines) {
+            if (pipeline != VK_NULL_HANDLE) {
+                vkDestroyPipeline(g_device, pipeline, nullptr);
+                pipeline = VK_NULL_HANDLE;
             }
         }
+        if (g_debugLineVertShaderModule != VK_NULL_HANDLE) {
+            vkDestroyShaderModule(g_device, g_debugLineVertShaderModule, nullptr);
+            g_debugLineVertShaderModule = VK_NULL_HANDLE;
+        }
+        g_debugDraw.clear();
         g_numColoredCubes = 0;
+        g_coloredCubeBatch.clear();
+        g_coloredCubeBvh.clear();
+        g_coloredCubeBvhDirty = true;
+        g_cubeBroadphase.clear();
+        g_cubeBroadphaseProxies.clear();
+        g_cubeOverlapPairs.clear();
+        g_cubeBroadphaseDirty = true;
+        if (g_cubeBodiesInitialized) {
+            for (int i = 0; i < MAX_COLORED_CUBES; i++) {
+                g_cubePhysics.destroyBody(g_cubeBodies[i]);
+                g_cubeBodies[i] = PhysicsWorld::INVALID_BODY;
+            }
+        }
+        g_coloredCubeColors.clear();
         g_coloredCubePositions.clear();
         g_coloredCubeRotations.clear();
         g_attachedCubes.clear();
@@ -2939,6 +3253,17 @@ extern "C" void heidic_cleanup_renderer_fps() {
             g_fpsPipeline = VK_NULL_HANDLE;
         }
         
+        if (g_fpsInstancedPipeline != VK_NULL_HANDLE) {
+            vkDestroyPipeline(g_device, g_fpsInstancedPipeline, nullptr);
+            g_fpsInstancedPipeline = VK_NULL_HANDLE;
+        }
+        
+        if (g_fpsInstancedVertShaderModule != VK_NULL_HANDLE) {
+            vkDestroyShaderModule(g_device, g_fpsInstancedVertShaderModule, nullptr);
+            g_fpsInstancedVertShaderModule = VK_NULL_HANDLE;
+        }
+        g_fpsCubeInstancing = false;
+        
         if (g_fpsFragShaderModule != VK_NULL_HANDLE) {
             vkDestroyShaderModule(g_device, g_fpsFragShaderModule, nullptr);
             g_fpsFragShaderModule = VK_NULL_HANDLE;
@@ -3030,27 +3355,15 @@ static void unproject(glm::vec2 ndc, glm::mat4 invProj, glm::mat4 invView, glm::
     }
 }
 
-// Ray-AABB intersection using Möller-Trumbore slab method
+// Ray-AABB intersection using the slab method (bvhRayBox)
+// rayDir must already be normalized (unproject and the downward probes are)
 // Returns true if ray hits AABB, and t (distance along ray) if hit
 static bool rayAABB(const glm::vec3& rayOrigin, const glm::vec3& rayDir, const AABB& box, float& tMin, float& tMax) {
-    // Ensure ray direction is normalized (should already be, but double-check for precision)
-    glm::vec3 dir = glm::normalize(rayDir);
-    
-    // Handle division by zero by using a very small epsilon
-    const float epsilon = 1e-6f;
-    glm::vec3 invDir;
-    invDir.x = (fabsf(dir.x) < epsilon) ? (dir.x >= 0.0f ? 1e6f : -1e6f) : (1.0f / dir.x);
-    invDir.y = (fabsf(dir.y) < epsilon) ? (dir.y >= 0.0f ? 1e6f : -1e6f) : (1.0f / dir.y);
-    invDir.z = (fabsf(dir.z) < epsilon) ? (dir.z >= 0.0f ? 1e6f : -1e6f) : (1.0f / dir.z);
-    
-    glm::vec3 t0 = (box.min - rayOrigin) * invDir;
-    glm::vec3 t1 = (box.max - rayOrigin) * invDir;
-    
-    glm::vec3 tMinVec = glm::min(t0, t1);
-    glm::vec3 tMaxVec = glm::max(t0, t1);
-    
-    tMin = glm::max(glm::max(tMinVec.x, tMinVec.y), tMinVec.z);
-    tMax = glm::min(glm::min(tMaxVec.x, tMaxVec.y), tMaxVec.z);
+    BvhRay ray = bvh_make_ray(rayOrigin.x, rayOrigin.y, rayOrigin.z, rayDir.x, rayDir.y, rayDir.z);
+    const float boxMin[3] = {box.min.x, box.min.y, box.min.z};
+    const float boxMax[3] = {box.max.x, box.max.y, box.max.z};
+    int axis;
+    bvhRayBox(ray, boxMin, boxMax, tMin, tMax, axis);
     
     // Ray hits if tMax >= tMin AND tMax >= 0 (intersection is in front of or at ray origin)
     // If tMin > tMax, the ray misses the AABB
@@ -3071,6 +3384,97 @@ static AABB createCubeAABB(float x, float y, float z, float sx, float sy, float
     return AABB(min, max);
 }
 
+// Colored cube BVH, brought up to date with the cubes' current positions and sizes
+static const Bvh& getColoredCubeBvh() {
+    if (g_coloredCubeBvhDirty) {
+        int count = std::min(g_numColoredCubes, static_cast<int>(g_coloredCubePositions.size()));
+        g_coloredCubeBvhBounds.resize(count);
+        for (int i = 0; i < count; i++) {
+            g_coloredCubeBvhBounds[i] = bvh_bounds_from_center(
+                g_coloredCubePositions[i].x, g_coloredCubePositions[i].y, g_coloredCubePositions[i].z,
+                g_coloredCubeSizeX[i] > 0.0f ? g_coloredCubeSizeX[i] : g_coloredCubeSizes[i],
+                g_coloredCubeSizeY[i] > 0.0f ? g_coloredCubeSizeY[i] : g_coloredCubeSizes[i],
+                g_coloredCubeSizeZ[i] > 0.0f ? g_coloredCubeSizeZ[i] : g_coloredCubeSizes[i]);
+        }
+        if (g_coloredCubeBvh.getObjectCount() != g_coloredCubeBvhBounds.size()) {
+            g_coloredCubeBvh.build(g_coloredCubeBvhBounds.data(), g_coloredCubeBvhBounds.size());
+        } else {
+            g_coloredCubeBvh.refit(g_coloredCubeBvhBounds.data(), g_coloredCubeBvhBounds.size());
+        }
+        g_coloredCubeBvhDirty = false;
+    }
+    return g_coloredCubeBvh;
+}
+
+// Ray query filters: cubes not left out with heidic_raycast_set_ignored_cube
+static bool isCubePickable(uint32_t index) {
+    return index >= static_cast<uint32_t>(MAX_COLORED_CUBES) || !g_cubeIgnoredByPicks[index];
+}
+
+static bool isCubeGround(uint32_t index) {
+    return index >= static_cast<uint32_t>(MAX_COLORED_CUBES) || !g_cubeIgnoredByGround[index];
+}
+
+// Nearest colored cube along a ray (skipping ignored cubes), remembered for the getters below
+static int raycastColoredCubes(const glm::vec3& origin, const glm::vec3& dir, float maxDistance) {
+    BvhRay ray = bvh_make_ray(origin.x, origin.y, origin.z, dir.x, dir.y, dir.z, maxDistance);
+    g_lastRaycastHit = getColoredCubeBvh().intersect(ray, isCubePickable);
+    g_lastRaycastPoint = g_lastRaycastHit.index >= 0 ? origin + dir * g_lastRaycastHit.distance : glm::vec3(0.0f);
+    return g_lastRaycastHit.index;
+}
+
+// Leave a cube out of ray queries, e.g. a vehicle the player stands in
+// ignore_picks: heidic_raycast_cubes, heidic_raycast_pick_center, heidic_raycast_cubes_batch
+// ignore_ground: heidic_raycast_downward_big_cube, heidic_raycast_downward_batch
+extern "C" void heidic_raycast_set_ignored_cube(int cube_index, int ignore_picks, int ignore_ground) {
+    if (cube_index < 0 || cube_index >= MAX_COLORED_CUBES) return;
+    g_cubeIgnoredByPicks[cube_index] = ignore_picks != 0;
+    g_cubeIgnoredByGround[cube_index] = ignore_ground != 0;
+}
+
+// Cast a ray against all colored cubes and return the nearest cube index (or -1)
+// Cubes ignored for picks are never hit. Distance, point and normal: heidic_get_raycast_*
+extern "C" int heidic_raycast_cubes(float origin_x, float origin_y, float origin_z, float dir_x, float dir_y, float dir_z, float max_distance) {
+    glm::vec3 dir(dir_x, dir_y, dir_z);
+    float length = glm::length(dir);
+    if (length <= 0.0f) {
+        g_lastRaycastHit = BvhHit();
+        return -1;
+    }
+    return raycastColoredCubes(glm::vec3(origin_x, origin_y, origin_z), dir / length, max_distance);
+}
+
+// Cast a ray from the crosshair (screen center) and return the nearest cube index (or -1)
+extern "C" int heidic_raycast_pick_center(GLFWwindow* window, float max_distance) {
+    g_lastRaycastHit = BvhHit();
+    if (!window) return -1;
+    
+    int fbWidth, fbHeight;
+    glfwGetFramebufferSize(window, &fbWidth, &fbHeight);
+    glm::vec2 ndc = screenToNDC(fbWidth / 2.0f, fbHeight / 2.0f, fbWidth, fbHeight);
+    
+    glm::mat4 invProj = glm::inverse(g_fpsCurrentProj);
+    glm::mat4 invView = glm::inverse(g_fpsCurrentView);
+    glm::vec3 rayOrigin, rayDir;
+    unproject(ndc, invProj, invView, rayOrigin, rayDir);
+    return raycastColoredCubes(rayOrigin, rayDir, max_distance);
+}
+
+// Distance to the last raycast hit (-1 if it missed)
+extern "C" float heidic_get_raycast_distance() {
+    return g_lastRaycastHit.index >= 0 ? g_lastRaycastHit.distance : -1.0f;
+}
+
+// World-space point of the last raycast hit
+extern "C" Vec3 heidic_get_raycast_point() {
+    return Vec3(g_lastRaycastPoint.x, g_lastRaycastPoint.y, g_lastRaycastPoint.z);
+}
+
+// Outward normal of the face the last raycast entered through (zero if it missed)
+extern "C" Vec3 heidic_get_raycast_normal() {
+    return Vec3(g_lastRaycastHit.normal[0], g_lastRaycastHit.normal[1], g_lastRaycastHit.normal[2]);
+}
+
 // Raycast from screen center (crosshair) against a cube
 // Returns 1 if hit, 0 if miss
 extern "C" int heidic_raycast_cube_hit_center(GLFWwindow* window, float cubeX, float cubeY, float cubeZ, float cubeSx, float cubeSy, float cubeSz) {
@@ -3157,11 +3561,22 @@ extern "C" Vec3 heidic_get_cube_position(int cube_index) {
 }
 
 // Set cube position (for HEIDIC to update picked-up cube)
+// Move a cube's physics body (if it has one) to where gameplay code put the cube
+static void syncCubeBody(int cube_index) {
+    if (g_cubeBodiesInitialized && g_cubePhysics.isValid(g_cubeBodies[cube_index])) {
+        const ColoredCubePos& pos = g_coloredCubePositions[cube_index];
+        g_cubePhysics.setPosition(g_cubeBodies[cube_index], pos.x, pos.y, pos.z);
+        g_cubePhysics.setVelocity(g_cubeBodies[cube_index], 0.0f, 0.0f, 0.0f);
+    }
+}
+
 extern "C" void heidic_set_cube_position(int cube_index, float x, float y, float z) {
     if (cube_index >= 0 && cube_index < static_cast<int>(g_coloredCubePositions.size())) {
         g_coloredCubePositions[cube_index].x = x;
         g_coloredCubePositions[cube_index].y = y;
         g_coloredCubePositions[cube_index].z = z;
+        g_coloredCubeBvhDirty = true;
+        syncCubeBody(cube_index);
     } else {
         std::cout << "[CUBE_POS] ERROR: Invalid cube_index " << cube_index 
                   << " (size=" << g_coloredCubePositions.size() << ")" << std::endl;
@@ -3179,28 +3594,11 @@ extern "C" void heidic_set_cube_rotation(int cube_index, float yaw_degrees) {
 }
 
 // Set cube color (for visual feedback when selected/picked up)
+// Picked up by the instance buffer on the next frame
 extern "C" void heidic_set_cube_color(int cube_index, float r, float g, float b) {
     if (cube_index >= 0 && cube_index < g_numColoredCubes && 
-        cube_index < static_cast<int>(g_coloredCubeOriginalColors.size()) &&
-        g_coloredCubeVertexBuffers[cube_index] != VK_NULL_HANDLE) {
-        
-        // Update vertex buffer with new color
-        std::vector<Vertex> coloredCubeVertices = {
-            {{-0.5f, -0.5f,  0.5f}, {r, g, b}},
-            {{ 0.5f, -0.5f,  0.5f}, {r, g, b}},
-            {{ 0.5f,  0.5f,  0.5f}, {r, g, b}},
-            {{-0.5f,  0.5f,  0.5f}, {r, g, b}},
-            {{-0.5f, -0.5f, -0.5f}, {r, g, b}},
-            {{ 0.5f, -0.5f, -0.5f}, {r, g, b}},
-            {{ 0.5f,  0.5f, -0.5f}, {r, g, b}},
-            {{-0.5f,  0.5f, -0.5f}, {r, g, b}},
-        };
-        
-        VkDeviceSize vertexBufferSize = sizeof(coloredCubeVertices[0]) * coloredCubeVertices.size();
-        void* data;
-        vkMapMemory(g_device, g_coloredCubeVertexBufferMemory[cube_index], 0, vertexBufferSize, 0, &data);
-        memcpy(data, coloredCubeVertices.data(), (size_t)vertexBufferSize);
-        vkUnmapMemory(g_device, g_coloredCubeVertexBufferMemory[cube_index]);
+        cube_index < static_cast<int>(g_coloredCubeColors.size())) {
+        g_coloredCubeColors[cube_index] = {r, g, b};
     }
 }
 
@@ -3399,6 +3797,8 @@ extern "C" void heidic_update_attached_cubes(float vehicle_x, float vehicle_y, f
             g_coloredCubePositions[i].x = new_x;
             g_coloredCubePositions[i].y = new_y;
             g_coloredCubePositions[i].z = new_z;
+            g_coloredCubeBvhDirty = true;
+            syncCubeBody(i);
             
             // Update cube rotation to match vehicle
             if (i < static_cast<int>(g_coloredCubeRotations.size())) {
@@ -3443,44 +3843,230 @@ extern "C" int heidic_raycast_downward_big_cube(float x, float y, float z) {
     // Ray direction: straight down (negative Y)
     glm::vec3 rayDir(0.0f, -1.0f, 0.0f);
     
-    int closestHitIndex = -1;
-    float closestT = 1000.0f;  // Large initial distance
-    
-    // Test all cubes (check all cubes, not just first 9)
-    // Skip vehicle (index 14), helm (index 15), and ground platform (index 16) as they're special
-    // But include building (index 17) and all other cubes
-    for (int i = 0; i < g_numColoredCubes; i++) {
-        // Skip vehicle, helm, and ground platform (they're handled separately or shouldn't be stepped on)
-        if (i == 14 || i == 15 || i == 16) {
-            continue;
+    // Nearest cube below within 1000 units (BVH query), skipping cubes ignored for ground casts
+    BvhRay ray = bvh_make_ray(rayOrigin.x, rayOrigin.y, rayOrigin.z, rayDir.x, rayDir.y, rayDir.z, 1000.0f);
+    BvhHit hit = getColoredCubeBvh().intersect(ray, isCubeGround);
+    return hit.index;
+}
+
+// Cast many rays against the colored cubes in one call (SOA arrays, unit directions)
+// hit_indices[i] = nearest cube (ignored cubes are skipped) or -1, hit_distances[i] = its distance or -1
+// Returns the number of rays that hit a cube
+extern "C" int heidic_raycast_cubes_batch(const float* origins_x, const float* origins_y, const float* origins_z,
+                                          const float* dirs_x, const float* dirs_y, const float* dirs_z,
+                                          int32_t count, float max_distance, int32_t* hit_indices, float* hit_distances) {
+    if (count <= 0 || !origins_x || !origins_y || !origins_z || !dirs_x || !dirs_y || !dirs_z || !hit_indices || !hit_distances) {
+        return 0;
+    }
+    BvhRayBatch rays;
+    rays.originX = origins_x;
+    rays.originY = origins_y;
+    rays.originZ = origins_z;
+    rays.dirX = dirs_x;
+    rays.dirY = dirs_y;
+    rays.dirZ = dirs_z;
+    rays.count = static_cast<size_t>(count);
+    rays.tMax = max_distance;
+    BvhHitBatch hits;
+    hits.index = hit_indices;
+    hits.distance = hit_distances;
+    size_t hitCount = bvh_intersect_batch(getColoredCubeBvh(), rays, hits, 0, isCubePickable);
+    for (int32_t i = 0; i < count; i++) {
+        if (hit_indices[i] < 0) {
+            hit_distances[i] = -1.0f;
         }
-        
-        // Check if cube has size >= 1.0 (big cube) or use per-axis sizes for rectangles
-        float cubeSize = g_coloredCubeSizes[i];
-        float sizeX = g_coloredCubeSizeX[i];
-        float sizeY = g_coloredCubeSizeY[i];
-        float sizeZ = g_coloredCubeSizeZ[i];
-        
-        // Use per-axis sizes if available (for rectangles), otherwise use uniform size
-        AABB cubeBox = createCubeAABB(
-            g_coloredCubePositions[i].x,
-            g_coloredCubePositions[i].y,
-            g_coloredCubePositions[i].z,
-            sizeX > 0.0f ? sizeX : cubeSize,
-            sizeY > 0.0f ? sizeY : cubeSize,
-            sizeZ > 0.0f ? sizeZ : cubeSize
-        );
-        
-        float tMin, tMax;
-        if (rayAABB(rayOrigin, rayDir, cubeBox, tMin, tMax)) {
-            if (tMin >= 0.0f && tMin < closestT) {
-                closestT = tMin;
-                closestHitIndex = i;
+    }
+    return static_cast<int>(hitCount);
+}
+
+// Cast straight down from many positions in one call (ground snapping dropped items)
+// hit_indices[i] = cube below (same cubes as heidic_raycast_downward_big_cube) or -1,
+// hit_distances[i] = distance to the nearest surface below (that cube or the floor) or -1
+// Returns the number of positions with ground below
+extern "C" int heidic_raycast_downward_batch(const float* xs, const float* ys, const float* zs, int32_t count,
+                                             float max_distance, int32_t* hit_indices, float* hit_distances) {
+    if (count <= 0 || !xs || !ys || !zs || !hit_indices || !hit_distances) {
+        return 0;
+    }
+    BvhRayBatch rays;
+    rays.originX = xs;
+    rays.originY = ys;
+    rays.originZ = zs;
+    rays.count = static_cast<size_t>(count);
+    rays.tMax = max_distance;     // direction defaults to straight down
+    BvhHitBatch hits;
+    hits.index = hit_indices;
+    hits.distance = hit_distances;
+    bvh_intersect_batch(getColoredCubeBvh(), rays, hits, 0, isCubeGround);
+    
+    int grounded = 0;
+    for (int32_t i = 0; i < count; i++) {
+        float floorDistance = heidic_raycast_downward_distance(xs[i], ys[i], zs[i]);
+        if (floorDistance >= 0.0f && floorDistance < max_distance &&
+            (hit_indices[i] < 0 || floorDistance < hit_distances[i])) {
+            hit_indices[i] = -1;
+            hit_distances[i] = floorDistance;
+        } else if (hit_indices[i] < 0) {
+            hit_distances[i] = -1.0f;
+        }
+        grounded += hit_distances[i] >= 0.0f ? 1 : 0;
+    }
+    return grounded;
+}
+
+// World-space collision box of a colored cube (HDM collision size or its size, widened for yaw)
+static BroadphaseBounds coloredCubeCollisionBounds(int i) {
+    const CubeCollision& collision = g_cubeCollision[i];
+    float sx = g_coloredCubeSizeX[i] > 0.0f ? g_coloredCubeSizeX[i] : g_coloredCubeSizes[i];
+    float sy = g_coloredCubeSizeY[i] > 0.0f ? g_coloredCubeSizeY[i] : g_coloredCubeSizes[i];
+    float sz = g_coloredCubeSizeZ[i] > 0.0f ? g_coloredCubeSizeZ[i] : g_coloredCubeSizes[i];
+    if (collision.bounds[0] > 0.0f && collision.bounds[1] > 0.0f && collision.bounds[2] > 0.0f) {
+        sx = collision.bounds[0];
+        sy = collision.bounds[1];
+        sz = collision.bounds[2];
+    }
+    float yaw = i < static_cast<int>(g_coloredCubeRotations.size()) ? g_coloredCubeRotations[i] : 0.0f;
+    if (yaw != 0.0f) {
+        float yawRad = yaw * (3.14159265358979f / 180.0f);
+        float c = std::fabs(std::cos(yawRad));
+        float s = std::fabs(std::sin(yawRad));
+        float rx = c * sx + s * sz;
+        float rz = s * sx + c * sz;
+        sx = rx;
+        sz = rz;
+    }
+    return broadphase_bounds_from_center(g_coloredCubePositions[i].x, g_coloredCubePositions[i].y,
+                                         g_coloredCubePositions[i].z, sx, sy, sz);
+}
+
+// Find the colored cubes whose collision boxes overlap (candidate pairs for stacking/contacts)
+// Cubes with collision type 0 are skipped and static cubes never pair with each other.
+// Returns the number of pairs; read them with heidic_get_cube_overlap_a/b
+extern "C" int heidic_update_cube_broadphase() {
+    int count = std::min(g_numColoredCubes, static_cast<int>(g_coloredCubePositions.size()));
+    if (g_cubeBroadphaseDirty || static_cast<int>(g_cubeBroadphaseProxies.size()) != count) {
+        g_cubeBroadphase.clear();
+        g_cubeBroadphaseProxies.assign(count, SweepAndPrune::INVALID_PROXY);
+        for (int i = 0; i < count; i++) {
+            if (g_cubeCollision[i].collisionType != 0) {
+                g_cubeBroadphaseProxies[i] = g_cubeBroadphase.addProxy(coloredCubeCollisionBounds(i),
+                                                                       g_cubeCollision[i].isStatic,
+                                                                       static_cast<uint32_t>(i));
+            }
+        }
+        g_cubeBroadphaseDirty = false;
+    } else {
+        for (int i = 0; i < count; i++) {
+            if (g_cubeBroadphaseProxies[i] != SweepAndPrune::INVALID_PROXY) {
+                g_cubeBroadphase.updateProxy(g_cubeBroadphaseProxies[i], coloredCubeCollisionBounds(i));
             }
         }
     }
-    
-    return closestHitIndex;
+
+    g_cubeBroadphase.findPairs(g_cubeOverlapPairs);
+    for (BroadphasePair& pair : g_cubeOverlapPairs) {
+        uint32_t a = g_cubeBroadphase.getUserData(pair.a);
+        uint32_t b = g_cubeBroadphase.getUserData(pair.b);
+        pair.a = std::min(a, b);
+        pair.b = std::max(a, b);
+    }
+    broadphase_sort_pairs(g_cubeOverlapPairs);
+    return static_cast<int>(g_cubeOverlapPairs.size());
+}
+
+// Cube indices of an overlapping pair from the last heidic_update_cube_broadphase (a < b), or -1
+extern "C" int heidic_get_cube_overlap_a(int pair_index) {
+    if (pair_index >= 0 && pair_index < static_cast<int>(g_cubeOverlapPairs.size())) {
+        return static_cast<int>(g_cubeOverlapPairs[pair_index].a);
+    }
+    return -1;
+}
+
+extern "C" int heidic_get_cube_overlap_b(int pair_index) {
+    if (pair_index >= 0 && pair_index < static_cast<int>(g_cubeOverlapPairs.size())) {
+        return static_cast<int>(g_cubeOverlapPairs[pair_index].b);
+    }
+    return -1;
+}
+
+// Turn rigid-body physics on (1) or off (0) for a cube. The body is the cube's collision box
+// (HDM collision settings if applied); static cubes only hold others up. Collision type none
+// gets no body. Turn physics off for a cube while the player carries it.
+extern "C" void heidic_physics_enable_cube(int cube_index, int enabled) {
+    if (cube_index < 0 || cube_index >= std::min(g_numColoredCubes, static_cast<int>(g_coloredCubePositions.size()))) {
+        return;
+    }
+    if (!g_cubeBodiesInitialized) {
+        for (int i = 0; i < MAX_COLORED_CUBES; i++) {
+            g_cubeBodies[i] = PhysicsWorld::INVALID_BODY;
+        }
+        // Starting floor (same box as heidic_raycast_downward_distance)
+        RigidBodyDesc floor;
+        floor.halfExtents[0] = 12.5f;
+        floor.halfExtents[1] = 0.25f;
+        floor.halfExtents[2] = 12.5f;
+        floor.position[1] = -0.5f;
+        floor.isStatic = true;
+        g_cubePhysicsFloor = g_cubePhysics.createBody(floor);
+        g_cubeBodiesInitialized = true;
+    }
+    g_cubePhysics.destroyBody(g_cubeBodies[cube_index]);
+    g_cubeBodies[cube_index] = PhysicsWorld::INVALID_BODY;
+
+    const CubeCollision& collision = g_cubeCollision[cube_index];
+    if (!enabled) {
+        return;
+    }
+    // Same conversion as HDM objects: a missing or non-positive "mass" field (read as 0) becomes 1 kg
+    // instead of an immovable body that gravity still pulls through the floor
+    BroadphaseBounds bounds = coloredCubeCollisionBounds(cube_index);
+    float size[3];
+    for (int axis = 0; axis < 3; axis++) {
+        size[axis] = bounds.max[axis] - bounds.min[axis];
+    }
+    RigidBodyDesc desc;
+    if (!rigid_body_desc_from_hdm(collision.collisionType, size, collision.isStatic, collision.mass, desc)) {
+        return;
+    }
+    for (int axis = 0; axis < 3; axis++) {
+        desc.position[axis] = (bounds.max[axis] + bounds.min[axis]) * 0.5f;
+    }
+    desc.userData = static_cast<uint32_t>(cube_index);
+    g_cubeBodies[cube_index] = g_cubePhysics.createBody(desc);
+}
+
+// Advance cube physics by a frame's elapsed time (fixed 1/60 s steps) and move the simulated
+// cubes. Returns the number of fixed steps taken
+extern "C" int heidic_physics_step(float delta_time) {
+    if (!g_cubeBodiesInitialized) {
+        return 0;
+    }
+    uint32_t steps = g_cubePhysics.update(delta_time);
+    if (steps == 0) {
+        return 0;
+    }
+    int count = std::min(g_numColoredCubes, static_cast<int>(g_coloredCubePositions.size()));
+    for (int i = 0; i < count; i++) {
+        uint32_t body = g_cubeBodies[i];
+        if (g_cubePhysics.isAwake(body)) {
+            float p[3];
+            g_cubePhysics.getPosition(body, p);
+            g_coloredCubePositions[i].x = p[0];
+            g_coloredCubePositions[i].y = p[1];
+            g_coloredCubePositions[i].z = p[2];
+            g_coloredCubeBvhDirty = true;
+        }
+    }
+    return static_cast<int>(steps);
+}
+
+// 1 if the cube has a physics body that has come to rest (asleep), 0 otherwise
+extern "C" int heidic_physics_is_cube_sleeping(int cube_index) {
+    if (!g_cubeBodiesInitialized || cube_index < 0 || cube_index >= MAX_COLORED_CUBES) {
+        return 0;
+    }
+    uint32_t body = g_cubeBodies[cube_index];
+    return g_cubePhysics.isValid(body) && !g_cubePhysics.isStatic(body) && !g_cubePhysics.isAwake(body) ? 1 : 0;
 }
 
 // Get cube size (1.0 for big, 0.5 for small, or average for rectangles)
@@ -3539,13 +4125,65 @@ extern "C" Vec3 heidic_get_center_ray_dir(GLFWwindow* window) {
     return result;
 }
 
-// Draw a debug line from point1 to point2 with color (simple implementation for FPS renderer)
-// Note: This is a placeholder - proper line rendering would need a line pipeline
-// For now, we'll just print debug info
+// Debug drawing: primitives are batched (stdlib/debug_draw.h) and drawn by the next heidic_render_fps
+// Draw a debug line from point1 to point2 with color
 extern "C" void heidic_draw_line(float x1, float y1, float z1, float x2, float y2, float z2, float r, float g, float b) {
-    // TODO: Implement proper line rendering with Vulkan
-    // For now, this is a placeholder - the line would need to be rendered in the FPS renderer
-    // We could add it to the renderer later if needed
+    g_debugDraw.line(x1, y1, z1, x2, y2, z2, debug_pack_color(r, g, b), g_debugDrawCategory);
+}
+
+// Draw the ray under the mouse cursor, from the camera out to `length`
+extern "C" void heidic_draw_ray(GLFWwindow* window, float length, float r, float g, float b) {
+    double xpos, ypos;
+    glfwGetCursorPos(window, &xpos, &ypos);
+    int fbWidth, fbHeight;
+    glfwGetFramebufferSize(window, &fbWidth, &fbHeight);
+    if (fbWidth <= 0 || fbHeight <= 0) {
+        return;
+    }
+    // Cursor coordinates are in window units; scale to framebuffer pixels (HiDPI)
+    int winWidth, winHeight;
+    glfwGetWindowSize(window, &winWidth, &winHeight);
+    float scaleX = winWidth > 0 ? static_cast<float>(fbWidth) / winWidth : 1.0f;
+    float scaleY = winHeight > 0 ? static_cast<float>(fbHeight) / winHeight : 1.0f;
+    glm::vec2 ndc = screenToNDC(static_cast<float>(xpos) * scaleX, static_cast<float>(ypos) * scaleY, fbWidth, fbHeight);
+    glm::vec3 rayOrigin, rayDir;
+    unproject(ndc, glm::inverse(g_fpsCurrentProj), glm::inverse(g_fpsCurrentView), rayOrigin, rayDir);
+    g_debugDraw.ray(&rayOrigin[0], &rayDir[0], length, debug_pack_color(r, g, b), g_debugDrawCategory);
+}
+
+// Draw a wireframe box (center, rotation in degrees about X/Y/Z, full size per axis)
+extern "C" void heidic_draw_cube_wireframe(float x, float y, float z, float rx, float ry, float rz, float sx, float sy, float sz, float r, float g, float b) {
+    float center[3] = {x, y, z};
+    float rotation[3] = {rx, ry, rz};
+    float size[3] = {sx, sy, sz};
+    g_debugDraw.box(center, rotation, size, debug_pack_color(r, g, b), g_debugDrawCategory);
+}
+
+// Draw a spot light's cone: apex at the light, along its direction for `range`, outer cone half-angle in radians
+extern "C" void heidic_draw_spot_light_cone(float x, float y, float z, float dir_x, float dir_y, float dir_z, float range, float outer_cone, float r, float g, float b) {
+    float apex[3] = {x, y, z};
+    float direction[3] = {dir_x, dir_y, dir_z};
+    g_debugDraw.cone(apex, direction, range, outer_cone, debug_pack_color(r, g, b), g_debugDrawCategory);
+}
+
+// Draw a wireframe sphere (three great circles)
+extern "C" void heidic_draw_sphere_wireframe(float x, float y, float z, float radius, float r, float g, float b) {
+    float center[3] = {x, y, z};
+    g_debugDraw.sphere(center, radius, debug_pack_color(r, g, b), g_debugDrawCategory);
+}
+
+// Depth-test debug primitives drawn after this call (1, default) or draw them on top of everything (0)
+extern "C" void heidic_set_debug_draw_depth_test(int enabled) {
+    g_debugDrawCategory = enabled ? DebugDrawCategory::Depth : DebugDrawCategory::Overlay;
+}
+
+// Debug lines waiting for the next frame, and primitives dropped this frame for lack of room
+extern "C" int heidic_get_debug_draw_line_count() {
+    return static_cast<int>(g_debugDraw.getLineCount());
+}
+
+extern "C" int heidic_get_debug_draw_dropped() {
+    return static_cast<int>(g_debugDraw.getDroppedPrimitives());
 }
 
 extern "C" void heidic_hide_cursor(GLFWwindow* window) {
@@ -3566,18 +4204,12 @@ extern "C" void heidic_cleanup_renderer_cube() {
             vkDestroyBuffer(g_device, g_cubeIndexBuffer, nullptr);
             g_cubeIndexBuffer = VK_NULL_HANDLE;
         }
-        if (g_cubeIndexBufferMemory != VK_NULL_HANDLE) {
-            vkFreeMemory(g_device, g_cubeIndexBufferMemory, nullptr);
-            g_cubeIndexBufferMemory = VK_NULL_HANDLE;
-        }
+        GpuAllocator::get_instance().free(g_cubeIndexBufferMemory);
         if (g_cubeVertexBuffer != VK_NULL_HANDLE) {
             vkDestroyBuffer(g_device, g_cubeVertexBuffer, nullptr);
             g_cubeVertexBuffer = VK_NULL_HANDLE;
         }
-        if (g_cubeVertexBufferMemory != VK_NULL_HANDLE) {
-            vkFreeMemory(g_device, g_cubeVertexBufferMemory, nullptr);
-            g_cubeVertexBufferMemory = VK_NULL_HANDLE;
-        }
+        GpuAllocator::get_instance().free(g_cubeVertexBufferMemory);
         if (g_cubePipeline != VK_NULL_HANDLE) {
             vkDestroyPipeline(g_device, g_cubePipeline, nullptr);
             g_cubePipeline = VK_NULL_HANDLE;
@@ -3658,7 +4290,7 @@ extern "C" int heidic_init_imgui(GLFWwindow* window) {
     init_info.Device = g_device;
     init_info.QueueFamily = g_graphicsQueueFamilyIndex;
     init_info.Queue = g_graphicsQueue;
-    init_info.PipelineCache = VK_NULL_HANDLE;
+    init_info.PipelineCache = PipelineCache::get_instance().get();
     init_info.DescriptorPool = g_imguiDescriptorPool;
     // In newer ImGui versions, RenderPass, Subpass, and MSAASamples are in PipelineInfoMain
     init_info.PipelineInfoMain.RenderPass = g_renderPass;
@@ -3785,10 +4417,8 @@ extern "C" int heidic_init_renderer_balls(GLFWwindow* window) {
                      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                      g_cubeVertexBuffer, g_cubeVertexBufferMemory);
         
-        void* data;
-        vkMapMemory(g_device, g_cubeVertexBufferMemory, 0, vertexBufferSize, 0, &data);
+        void* data = g_cubeVertexBufferMemory.mapped;
         memcpy(data, cubeVertices.data(), (size_t)vertexBufferSize);
-        vkUnmapMemory(g_device, g_cubeVertexBufferMemory);
         
         // Create cube index buffer
         VkDeviceSize indexBufferSize = sizeof(cubeIndices[0]) * cubeIndices.size();
@@ -3797,23 +4427,22 @@ extern "C" int heidic_init_renderer_balls(GLFWwindow* window) {
                      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                      g_cubeIndexBuffer, g_cubeIndexBufferMemory);
         
-        vkMapMemory(g_device, g_cubeIndexBufferMemory, 0, indexBufferSize, 0, &data);
+        data = g_cubeIndexBufferMemory.mapped;
         memcpy(data, cubeIndices.data(), (size_t)indexBufferSize);
-        vkUnmapMemory(g_device, g_cubeIndexBufferMemory);
     }
     
     // Load ball shaders (ball.vert.spv, ball.frag.spv)
     std::vector<char> vertShaderCode, fragShaderCode;
     try {
-        vertShaderCode = readFile("shaders/ball.vert.spv");
-        fragShaderCode = readFile("shaders/ball.frag.spv");
+        vertShaderCode = loadShaderCode("shaders/ball.vert.spv");
+        fragShaderCode = loadShaderCode("shaders/ball.frag.spv");
         std::cout << "[EDEN] Loaded ball shaders successfully" << std::endl;
     } catch (const std::exception& e) {
         std::cerr << "[EDEN] Failed to load ball shaders: " << e.what() << std::endl;
         std::cerr << "[EDEN] Falling back to default shaders" << std::endl;
         try {
-            vertShaderCode = readFile("vert_3d.spv");
-            fragShaderCode = readFile("frag_3d.spv");
+            vertShaderCode = loadShaderCode("vert_3d.spv");
+            fragShaderCode = loadShaderCode("frag_3d.spv");
         } catch (const std::exception& e2) {
             std::cerr << "[EDEN] Failed to load default shaders: " << e2.what() << std::endl;
             return 0;
@@ -3961,7 +4590,7 @@ extern "C" int heidic_init_renderer_balls(GLFWwindow* window) {
     pipelineInfo.subpass = 0;
     pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
     
-    if (vkCreateGraphicsPipelines(g_device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &g_ballsPipeline) != VK_SUCCESS) {
+    if (vkCreateGraphicsPipelines(g_device, PipelineCache::get_instance().get(), 1, &pipelineInfo, nullptr, &g_ballsPipeline) != VK_SUCCESS) {
         std::cerr << "[EDEN] Failed to create graphics pipeline for balls" << std::endl;
         vkDestroyPipelineLayout(g_device, g_pipelineLayout, nullptr);
         vkDestroyShaderModule(g_device, fragShaderModule, nullptr);
@@ -4006,13 +4635,11 @@ extern "C" void heidic_render_balls(GLFWwindow* window, int32_t ball_count, floa
         sizes = default_sizes;
     }
     
-    // Wait for previous frame
-    vkWaitForFences(g_device, 1, &g_inFlightFence, VK_TRUE, UINT64_MAX);
-    vkResetFences(g_device, 1, &g_inFlightFence);
-    
-    // Acquire next image
+    // Wait for this frame slot and acquire the next swapchain image
     uint32_t imageIndex;
-    vkAcquireNextImageKHR(g_device, g_swapchain, UINT64_MAX, g_imageAvailableSemaphore, VK_NULL_HANDLE, &imageIndex);
+    if (!beginFrame(imageIndex)) {
+        return;
+    }
     
     // Reset command buffer
     vkResetCommandBuffer(g_commandBuffers[imageIndex], 0);
@@ -4068,9 +4695,24 @@ extern "C" void heidic_render_balls(GLFWwindow* window, int32_t ball_count, floa
     ubo.proj = mat4_perspective(fov, aspect, nearPlane, farPlane);
     ubo.proj[1][1] *= -1.0f;  // Vulkan clip space
     
-    // Render each ball (using positions/sizes from ECS)
+    // Cull balls outside the view (the ball mesh is a +-1 cube, so its bounding radius is size * sqrt(3))
     int actual_count = (ball_count < MAX_BALLS) ? ball_count : MAX_BALLS;
+    CullParams cullParams;
+    cullParams.planes = extract_frustum_planes(&ubo.view[0][0], &ubo.proj[0][0]);
+    cullParams.eye[0] = eye.x;
+    cullParams.eye[1] = eye.y;
+    cullParams.eye[2] = eye.z;
+    cullParams.maxDistance = g_cullMaxDistance;
+    g_ballBounds.clear();
     for (int32_t i = 0; i < actual_count; i++) {
+        float sx = (sizes && sizes[i] > 0.0f) ? sizes[i] : 0.2f;
+        g_ballBounds.add(positions[i * 3], positions[i * 3 + 1], positions[i * 3 + 2], sx * 1.7320508f);
+    }
+    cull_spheres(g_ballBounds, cullParams, g_visibleIndices);
+    
+    // Render each visible ball (using positions/sizes from ECS)
+    for (uint32_t visibleIndex : g_visibleIndices) {
+        int32_t i = static_cast<int32_t>(visibleIndex);
         int idx = i * 3;
         
         // Model matrix - translate to ball position and scale based on provided size (default 0.2)
@@ -4081,10 +4723,8 @@ extern "C" void heidic_render_balls(GLFWwindow* window, int32_t ball_count, floa
         ubo.model = Mat4(model);
         
         // Update uniform buffer (view/proj only; model via push constants)
-        void* data;
-        vkMapMemory(g_device, g_uniformBuffersMemory[imageIndex], 0, sizeof(ubo), 0, &data);
+        void* data = g_uniformBuffersMemory[imageIndex].mapped;
         memcpy(data, &ubo, sizeof(ubo));
-        vkUnmapMemory(g_device, g_uniformBuffersMemory[imageIndex]);
         
         // Push per-draw model matrix so each cube uses its own transform
         vkCmdPushConstants(g_commandBuffers[imageIndex], g_pipelineLayout,
@@ -4110,36 +4750,8 @@ extern "C" void heidic_render_balls(GLFWwindow* window, int32_t ball_count, floa
     vkCmdEndRenderPass(g_commandBuffers[imageIndex]);
     vkEndCommandBuffer(g_commandBuffers[imageIndex]);
     
-    // Submit
-    VkSubmitInfo submitInfo = {};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    
-    VkSemaphore waitSemaphores[] = {g_imageAvailableSemaphore};
-    VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-    submitInfo.waitSemaphoreCount = 1;
-    submitInfo.pWaitSemaphores = waitSemaphores;
-    submitInfo.pWaitDstStageMask = waitStages;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &g_commandBuffers[imageIndex];
-    
-    VkSemaphore signalSemaphores[] = {g_renderFinishedSemaphore};
-    submitInfo.signalSemaphoreCount = 1;
-    submitInfo.pSignalSemaphores = signalSemaphores;
-    
-    vkQueueSubmit(g_graphicsQueue, 1, &submitInfo, g_inFlightFence);
-    
-    // Present
-    VkPresentInfoKHR presentInfo = {};
-    presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-    presentInfo.waitSemaphoreCount = 1;
-    presentInfo.pWaitSemaphores = signalSemaphores;
-    
-    VkSwapchainKHR swapChains[] = {g_swapchain};
-    presentInfo.swapchainCount = 1;
-    presentInfo.pSwapchains = swapChains;
-    presentInfo.pImageIndices = &imageIndex;
-    
-    vkQueuePresentKHR(g_graphicsQueue, &presentInfo);
+    // Submit on this frame slot's fence and present
+    submitFrame(imageIndex);
 }
 
 extern "C" void heidic_cleanup_renderer_balls() {
@@ -4159,16 +4771,16 @@ extern "C" void heidic_cleanup_renderer_balls() {
 static VkImage g_ddsQuadImage = VK_NULL_HANDLE;
 static VkImageView g_ddsQuadImageView = VK_NULL_HANDLE;
 static VkSampler g_ddsQuadSampler = VK_NULL_HANDLE;
-static VkDeviceMemory g_ddsQuadImageMemory = VK_NULL_HANDLE;
+static GpuAllocation g_ddsQuadImageMemory;
 static VkPipeline g_ddsQuadPipeline = VK_NULL_HANDLE;
 static VkPipelineLayout g_ddsQuadPipelineLayout = VK_NULL_HANDLE;
 static VkDescriptorSetLayout g_ddsQuadDescriptorSetLayout = VK_NULL_HANDLE;
 static VkDescriptorPool g_ddsQuadDescriptorPool = VK_NULL_HANDLE;
 static VkDescriptorSet g_ddsQuadDescriptorSet = VK_NULL_HANDLE;
 static VkBuffer g_ddsQuadVertexBuffer = VK_NULL_HANDLE;
-static VkDeviceMemory g_ddsQuadVertexBufferMemory = VK_NULL_HANDLE;
+static GpuAllocation g_ddsQuadVertexBufferMemory;
 static VkBuffer g_ddsQuadIndexBuffer = VK_NULL_HANDLE;
-static VkDeviceMemory g_ddsQuadIndexBufferMemory = VK_NULL_HANDLE;
+static GpuAllocation g_ddsQuadIndexBufferMemory;
 static VkShaderModule g_ddsQuadVertShaderModule = VK_NULL_HANDLE;
 static VkShaderModule g_ddsQuadFragShaderModule = VK_NULL_HANDLE;
 static bool g_ddsQuadInitialized = false;
@@ -4271,77 +4883,26 @@ extern "C" int heidic_init_renderer_dds_quad(GLFWwindow* window, const char* dds
     imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
     imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
-    if (vkCreateImage(g_device, &imageInfo, nullptr, &g_ddsQuadImage) != VK_SUCCESS) {
+    if (!GpuAllocator::get_instance().createImage(imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, g_ddsQuadImage, g_ddsQuadImageMemory)) {
         std::cerr << "[DDS] ERROR: Failed to create image!" << std::endl;
         return 0;
     }
 
-    // Allocate memory for image
-    VkMemoryRequirements memRequirements;
-    vkGetImageMemoryRequirements(g_device, g_ddsQuadImage, &memRequirements);
-
-    VkMemoryAllocateInfo allocInfo = {};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-    
-    if (allocInfo.memoryTypeIndex == UINT32_MAX || allocInfo.memoryTypeIndex == 0) {
-        std::cerr << "[DDS] ERROR: Failed to find suitable memory type!" << std::endl;
-        vkDestroyImage(g_device, g_ddsQuadImage, nullptr);
-        return 0;
-    }
-
-    if (vkAllocateMemory(g_device, &allocInfo, nullptr, &g_ddsQuadImageMemory) != VK_SUCCESS) {
-        std::cerr << "[DDS] ERROR: Failed to allocate image memory!" << std::endl;
-        vkDestroyImage(g_device, g_ddsQuadImage, nullptr);
-        return 0;
-    }
-
-    vkBindImageMemory(g_device, g_ddsQuadImage, g_ddsQuadImageMemory, 0);
-
-    // Create staging buffer to upload compressed data
+    // Create staging buffer to upload pixel data
     VkBuffer stagingBuffer;
-    VkDeviceMemory stagingBufferMemory;
-    
-    VkBufferCreateInfo bufferInfo = {};
-    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    bufferInfo.size = ddsData.compressedData.size();
-    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-
-    if (vkCreateBuffer(g_device, &bufferInfo, nullptr, &stagingBuffer) != VK_SUCCESS) {
-        vkFreeMemory(g_device, g_ddsQuadImageMemory, nullptr);
-        vkDestroyImage(g_device, g_ddsQuadImage, nullptr);
-        return 0;
-    }
-
-    vkGetBufferMemoryRequirements(g_device, stagingBuffer, &memRequirements);
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, 
-                                               VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-    
-    if (allocInfo.memoryTypeIndex == UINT32_MAX || allocInfo.memoryTypeIndex == 0) {
-        std::cerr << "[DDS] ERROR: Failed to find suitable memory type for staging buffer!" << std::endl;
-        vkDestroyBuffer(g_device, stagingBuffer, nullptr);
-        vkFreeMemory(g_device, g_ddsQuadImageMemory, nullptr);
+    GpuAllocation stagingBufferMemory;
+    if (!GpuAllocator::get_instance().createBuffer(ddsData.compressedData.size(), VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                                   VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                                   stagingBuffer, stagingBufferMemory)) {
+        std::cerr << "[DDS] ERROR: Failed to create staging buffer!" << std::endl;
         vkDestroyImage(g_device, g_ddsQuadImage, nullptr);
+        GpuAllocator::get_instance().free(g_ddsQuadImageMemory);
         return 0;
     }
 
-    if (vkAllocateMemory(g_device, &allocInfo, nullptr, &stagingBufferMemory) != VK_SUCCESS) {
-        vkDestroyBuffer(g_device, stagingBuffer, nullptr);
-        vkFreeMemory(g_device, g_ddsQuadImageMemory, nullptr);
-        vkDestroyImage(g_device, g_ddsQuadImage, nullptr);
-        return 0;
-    }
-
-    vkBindBufferMemory(g_device, stagingBuffer, stagingBufferMemory, 0);
-
     // Copy compressed data to staging buffer
-    void* data;
-    vkMapMemory(g_device, stagingBufferMemory, 0, ddsData.compressedData.size(), 0, &data);
+    void* data = stagingBufferMemory.mapped;
     memcpy(data, ddsData.compressedData.data(), ddsData.compressedData.size());
-    vkUnmapMemory(g_device, stagingBufferMemory);
 
     // Transition image layout for transfer and upload data
     VkCommandBuffer commandBuffer = beginSingleTimeCommands();
@@ -4391,7 +4952,7 @@ extern "C" int heidic_init_renderer_dds_quad(GLFWwindow* window, const char* dds
 
     // Cleanup staging buffer
     vkDestroyBuffer(g_device, stagingBuffer, nullptr);
-    vkFreeMemory(g_device, stagingBufferMemory, nullptr);
+    GpuAllocator::get_instance().free(stagingBufferMemory);
 
     // Create image view
     VkImageViewCreateInfo viewInfo = {};
@@ -4407,7 +4968,7 @@ extern "C" int heidic_init_renderer_dds_quad(GLFWwindow* window, const char* dds
 
     if (vkCreateImageView(g_device, &viewInfo, nullptr, &g_ddsQuadImageView) != VK_SUCCESS) {
         std::cerr << "[DDS] ERROR: Failed to create image view!" << std::endl;
-        vkFreeMemory(g_device, g_ddsQuadImageMemory, nullptr);
+        GpuAllocator::get_instance().free(g_ddsQuadImageMemory);
         vkDestroyImage(g_device, g_ddsQuadImage, nullptr);
         return 0;
     }
@@ -4434,7 +4995,7 @@ extern "C" int heidic_init_renderer_dds_quad(GLFWwindow* window, const char* dds
     if (vkCreateSampler(g_device, &samplerInfo, nullptr, &g_ddsQuadSampler) != VK_SUCCESS) {
         std::cerr << "[DDS] ERROR: Failed to create sampler!" << std::endl;
         vkDestroyImageView(g_device, g_ddsQuadImageView, nullptr);
-        vkFreeMemory(g_device, g_ddsQuadImageMemory, nullptr);
+        GpuAllocator::get_instance().free(g_ddsQuadImageMemory);
         vkDestroyImage(g_device, g_ddsQuadImage, nullptr);
         return 0;
     }
@@ -4456,7 +5017,7 @@ extern "C" int heidic_init_renderer_dds_quad(GLFWwindow* window, const char* dds
         std::cerr << "[DDS] ERROR: Failed to create descriptor set layout!" << std::endl;
         vkDestroySampler(g_device, g_ddsQuadSampler, nullptr);
         vkDestroyImageView(g_device, g_ddsQuadImageView, nullptr);
-        vkFreeMemory(g_device, g_ddsQuadImageMemory, nullptr);
+        GpuAllocator::get_instance().free(g_ddsQuadImageMemory);
         vkDestroyImage(g_device, g_ddsQuadImage, nullptr);
         return 0;
     }
@@ -4477,7 +5038,7 @@ extern "C" int heidic_init_renderer_dds_quad(GLFWwindow* window, const char* dds
         vkDestroyDescriptorSetLayout(g_device, g_ddsQuadDescriptorSetLayout, nullptr);
         vkDestroySampler(g_device, g_ddsQuadSampler, nullptr);
         vkDestroyImageView(g_device, g_ddsQuadImageView, nullptr);
-        vkFreeMemory(g_device, g_ddsQuadImageMemory, nullptr);
+        GpuAllocator::get_instance().free(g_ddsQuadImageMemory);
         vkDestroyImage(g_device, g_ddsQuadImage, nullptr);
         return 0;
     }
@@ -4495,7 +5056,7 @@ extern "C" int heidic_init_renderer_dds_quad(GLFWwindow* window, const char* dds
         vkDestroyDescriptorSetLayout(g_device, g_ddsQuadDescriptorSetLayout, nullptr);
         vkDestroySampler(g_device, g_ddsQuadSampler, nullptr);
         vkDestroyImageView(g_device, g_ddsQuadImageView, nullptr);
-        vkFreeMemory(g_device, g_ddsQuadImageMemory, nullptr);
+        GpuAllocator::get_instance().free(g_ddsQuadImageMemory);
         vkDestroyImage(g_device, g_ddsQuadImage, nullptr);
         return 0;
     }
@@ -4523,9 +5084,8 @@ extern "C" int heidic_init_renderer_dds_quad(GLFWwindow* window, const char* dds
                  VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                  g_ddsQuadVertexBuffer, g_ddsQuadVertexBufferMemory);
 
-    vkMapMemory(g_device, g_ddsQuadVertexBufferMemory, 0, vertexBufferSize, 0, &data);
+    data = g_ddsQuadVertexBufferMemory.mapped;
     memcpy(data, g_quadVertices, (size_t)vertexBufferSize);
-    vkUnmapMemory(g_device, g_ddsQuadVertexBufferMemory);
 
     // Create quad index buffer
     VkDeviceSize indexBufferSize = sizeof(g_quadIndices);
@@ -4533,9 +5093,8 @@ extern "C" int heidic_init_renderer_dds_quad(GLFWwindow* window, const char* dds
                  VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                  g_ddsQuadIndexBuffer, g_ddsQuadIndexBufferMemory);
 
-    vkMapMemory(g_device, g_ddsQuadIndexBufferMemory, 0, indexBufferSize, 0, &data);
+    data = g_ddsQuadIndexBufferMemory.mapped;
     memcpy(data, g_quadIndices, (size_t)indexBufferSize);
-    vkUnmapMemory(g_device, g_ddsQuadIndexBufferMemory);
 
     // Load quad shaders
     std::vector<char> vertShaderCode, fragShaderCode;
@@ -4555,7 +5114,7 @@ extern "C" int heidic_init_renderer_dds_quad(GLFWwindow* window, const char* dds
     bool foundVert = false, foundFrag = false;
     for (const auto& path : quadVertPaths) {
         try {
-            vertShaderCode = readFile(path);
+            vertShaderCode = loadShaderCode(path);
             foundVert = true;
             std::cout << "[DDS] Loaded quad vertex shader: " << path << std::endl;
             break;
@@ -4566,7 +5125,7 @@ extern "C" int heidic_init_renderer_dds_quad(GLFWwindow* window, const char* dds
 
     for (const auto& path : quadFragPaths) {
         try {
-            fragShaderCode = readFile(path);
+            fragShaderCode = loadShaderCode(path);
             foundFrag = true;
             std::cout << "[DDS] Loaded quad fragment shader: " << path << std::endl;
             break;
@@ -4583,7 +5142,7 @@ extern "C" int heidic_init_renderer_dds_quad(GLFWwindow* window, const char* dds
         vkDestroyDescriptorSetLayout(g_device, g_ddsQuadDescriptorSetLayout, nullptr);
         vkDestroySampler(g_device, g_ddsQuadSampler, nullptr);
         vkDestroyImageView(g_device, g_ddsQuadImageView, nullptr);
-        vkFreeMemory(g_device, g_ddsQuadImageMemory, nullptr);
+        GpuAllocator::get_instance().free(g_ddsQuadImageMemory);
         vkDestroyImage(g_device, g_ddsQuadImage, nullptr);
         return 0;
     }
@@ -4725,7 +5284,7 @@ extern "C" int heidic_init_renderer_dds_quad(GLFWwindow* window, const char* dds
     pipelineInfo.renderPass = g_renderPass;
     pipelineInfo.subpass = 0;
 
-    if (vkCreateGraphicsPipelines(g_device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &g_ddsQuadPipeline) != VK_SUCCESS) {
+    if (vkCreateGraphicsPipelines(g_device, PipelineCache::get_instance().get(), 1, &pipelineInfo, nullptr, &g_ddsQuadPipeline) != VK_SUCCESS) {
         std::cerr << "[DDS] ERROR: Failed to create graphics pipeline!" << std::endl;
         vkDestroyPipelineLayout(g_device, g_ddsQuadPipelineLayout, nullptr);
         vkDestroyShaderModule(g_device, g_ddsQuadFragShaderModule, nullptr);
@@ -4743,13 +5302,11 @@ extern "C" void heidic_render_dds_quad(GLFWwindow* window) {
         return;
     }
 
-    // Wait for previous frame
-    vkWaitForFences(g_device, 1, &g_inFlightFence, VK_TRUE, UINT64_MAX);
-    vkResetFences(g_device, 1, &g_inFlightFence);
-
-    // Acquire next image
+    // Wait for this frame slot and acquire the next swapchain image
     uint32_t imageIndex;
-    vkAcquireNextImageKHR(g_device, g_swapchain, UINT64_MAX, g_imageAvailableSemaphore, VK_NULL_HANDLE, &imageIndex);
+    if (!beginFrame(imageIndex)) {
+        return;
+    }
 
     // Reset command buffer
     vkResetCommandBuffer(g_commandBuffers[imageIndex], 0);
@@ -4803,36 +5360,8 @@ extern "C" void heidic_render_dds_quad(GLFWwindow* window) {
     vkCmdEndRenderPass(g_commandBuffers[imageIndex]);
     vkEndCommandBuffer(g_commandBuffers[imageIndex]);
 
-    // Submit
-    VkSubmitInfo submitInfo = {};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-
-    VkSemaphore waitSemaphores[] = {g_imageAvailableSemaphore};
-    VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-    submitInfo.waitSemaphoreCount = 1;
-    submitInfo.pWaitSemaphores = waitSemaphores;
-    submitInfo.pWaitDstStageMask = waitStages;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &g_commandBuffers[imageIndex];
-
-    VkSemaphore signalSemaphores[] = {g_renderFinishedSemaphore};
-    submitInfo.signalSemaphoreCount = 1;
-    submitInfo.pSignalSemaphores = signalSemaphores;
-
-    vkQueueSubmit(g_graphicsQueue, 1, &submitInfo, g_inFlightFence);
-
-    // Present
-    VkPresentInfoKHR presentInfo = {};
-    presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-    presentInfo.waitSemaphoreCount = 1;
-    presentInfo.pWaitSemaphores = signalSemaphores;
-
-    VkSwapchainKHR swapChains[] = {g_swapchain};
-    presentInfo.swapchainCount = 1;
-    presentInfo.pSwapchains = swapChains;
-    presentInfo.pImageIndices = &imageIndex;
-
-    vkQueuePresentKHR(g_graphicsQueue, &presentInfo);
+    // Submit on this frame slot's fence and present
+    submitFrame(imageIndex);
 }
 
 extern "C" void heidic_cleanup_renderer_dds_quad() {
@@ -4848,10 +5377,7 @@ extern "C" void heidic_cleanup_renderer_dds_quad() {
         vkDestroyImage(g_device, g_ddsQuadImage, nullptr);
         g_ddsQuadImage = VK_NULL_HANDLE;
     }
-    if (g_ddsQuadImageMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(g_device, g_ddsQuadImageMemory, nullptr);
-        g_ddsQuadImageMemory = VK_NULL_HANDLE;
-    }
+    GpuAllocator::get_instance().free(g_ddsQuadImageMemory);
     if (g_ddsQuadPipeline != VK_NULL_HANDLE) {
         vkDestroyPipeline(g_device, g_ddsQuadPipeline, nullptr);
         g_ddsQuadPipeline = VK_NULL_HANDLE;
@@ -4872,18 +5398,12 @@ extern "C" void heidic_cleanup_renderer_dds_quad() {
         vkDestroyBuffer(g_device, g_ddsQuadVertexBuffer, nullptr);
         g_ddsQuadVertexBuffer = VK_NULL_HANDLE;
     }
-    if (g_ddsQuadVertexBufferMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(g_device, g_ddsQuadVertexBufferMemory, nullptr);
-        g_ddsQuadVertexBufferMemory = VK_NULL_HANDLE;
-    }
+    GpuAllocator::get_instance().free(g_ddsQuadVertexBufferMemory);
     if (g_ddsQuadIndexBuffer != VK_NULL_HANDLE) {
         vkDestroyBuffer(g_device, g_ddsQuadIndexBuffer, nullptr);
         g_ddsQuadIndexBuffer = VK_NULL_HANDLE;
     }
-    if (g_ddsQuadIndexBufferMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(g_device, g_ddsQuadIndexBufferMemory, nullptr);
-        g_ddsQuadIndexBufferMemory = VK_NULL_HANDLE;
-    }
+    GpuAllocator::get_instance().free(g_ddsQuadIndexBufferMemory);
     if (g_ddsQuadVertShaderModule != VK_NULL_HANDLE) {
         vkDestroyShaderModule(g_device, g_ddsQuadVertShaderModule, nullptr);
         g_ddsQuadVertShaderModule = VK_NULL_HANDLE;
@@ -4900,16 +5420,16 @@ extern "C" void heidic_cleanup_renderer_dds_quad() {
 static VkImage g_pngQuadImage = VK_NULL_HANDLE;
 static VkImageView g_pngQuadImageView = VK_NULL_HANDLE;
 static VkSampler g_pngQuadSampler = VK_NULL_HANDLE;
-static VkDeviceMemory g_pngQuadImageMemory = VK_NULL_HANDLE;
+static GpuAllocation g_pngQuadImageMemory;
 static VkPipeline g_pngQuadPipeline = VK_NULL_HANDLE;
 static VkPipelineLayout g_pngQuadPipelineLayout = VK_NULL_HANDLE;
 static VkDescriptorSetLayout g_pngQuadDescriptorSetLayout = VK_NULL_HANDLE;
 static VkDescriptorPool g_pngQuadDescriptorPool = VK_NULL_HANDLE;
 static VkDescriptorSet g_pngQuadDescriptorSet = VK_NULL_HANDLE;
 static VkBuffer g_pngQuadVertexBuffer = VK_NULL_HANDLE;
-static VkDeviceMemory g_pngQuadVertexBufferMemory = VK_NULL_HANDLE;
+static GpuAllocation g_pngQuadVertexBufferMemory;
 static VkBuffer g_pngQuadIndexBuffer = VK_NULL_HANDLE;
-static VkDeviceMemory g_pngQuadIndexBufferMemory = VK_NULL_HANDLE;
+static GpuAllocation g_pngQuadIndexBufferMemory;
 static VkShaderModule g_pngQuadVertShaderModule = VK_NULL_HANDLE;
 static VkShaderModule g_pngQuadFragShaderModule = VK_NULL_HANDLE;
 static bool g_pngQuadInitialized = false;
@@ -4937,22 +5457,24 @@ extern "C" int heidic_init_renderer_png_quad(GLFWwindow* window, const char* png
     PNGData pngData;
     try {
         pngData = load_png(pngPath);
+        generate_png_mipmaps(pngData);
     } catch (const std::exception& e) {
         std::cerr << "[PNG] ERROR: " << e.what() << std::endl;
         return 0;
     }
     
+    uint32_t mipLevels = static_cast<uint32_t>(pngData.mipLevels.size());
     std::cout << "[PNG] Loaded: " << pngData.width << "x" << pngData.height 
-              << ", Format: " << pngData.format << std::endl;
+              << ", Format: " << pngData.format << ", Mip levels: " << mipLevels << std::endl;
     
-    // Create Vulkan image (PNG is uncompressed RGBA8, no mipmaps)
+    // Create Vulkan image (PNG is uncompressed RGBA8; mips generated on the CPU)
     VkImageCreateInfo imageInfo = {};
     imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
     imageInfo.imageType = VK_IMAGE_TYPE_2D;
     imageInfo.extent.width = pngData.width;
     imageInfo.extent.height = pngData.height;
     imageInfo.extent.depth = 1;
-    imageInfo.mipLevels = 1;  // PNG has no mipmaps
+    imageInfo.mipLevels = mipLevels;
     imageInfo.arrayLayers = 1;
     imageInfo.format = pngData.format;
     imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
@@ -4961,71 +5483,26 @@ extern "C" int heidic_init_renderer_png_quad(GLFWwindow* window, const char* png
     imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
     imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
     
-    if (vkCreateImage(g_device, &imageInfo, nullptr, &g_pngQuadImage) != VK_SUCCESS) {
+    if (!GpuAllocator::get_instance().createImage(imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, g_pngQuadImage, g_pngQuadImageMemory)) {
         std::cerr << "[PNG] ERROR: Failed to create image!" << std::endl;
         return 0;
     }
-    
-    // Allocate memory for image
-    VkMemoryRequirements memRequirements;
-    vkGetImageMemoryRequirements(g_device, g_pngQuadImage, &memRequirements);
-    
-    VkMemoryAllocateInfo allocInfo = {};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-    
-    if (allocInfo.memoryTypeIndex == UINT32_MAX || allocInfo.memoryTypeIndex == 0) {
-        std::cerr << "[PNG] ERROR: Failed to find suitable memory type!" << std::endl;
-        vkDestroyImage(g_device, g_pngQuadImage, nullptr);
-        return 0;
-    }
-    
-    if (vkAllocateMemory(g_device, &allocInfo, nullptr, &g_pngQuadImageMemory) != VK_SUCCESS) {
-        std::cerr << "[PNG] ERROR: Failed to allocate image memory!" << std::endl;
-        vkDestroyImage(g_device, g_pngQuadImage, nullptr);
-        return 0;
-    }
-    
-    vkBindImageMemory(g_device, g_pngQuadImage, g_pngQuadImageMemory, 0);
-    
-    // Create staging buffer to upload uncompressed RGBA8 data
+
+    // Create staging buffer to upload pixel data
     VkBuffer stagingBuffer;
-    VkDeviceMemory stagingBufferMemory;
-    
-    VkBufferCreateInfo bufferInfo = {};
-    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    bufferInfo.size = pngData.pixelData.size();
-    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-    
-    if (vkCreateBuffer(g_device, &bufferInfo, nullptr, &stagingBuffer) != VK_SUCCESS) {
-        vkFreeMemory(g_device, g_pngQuadImageMemory, nullptr);
-        vkDestroyImage(g_device, g_pngQuadImage, nullptr);
+    GpuAllocation stagingBufferMemory;
+    if (!GpuAllocator::get_instance().createBuffer(pngData.pixelData.size(), VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                                   VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                                   stagingBuffer, stagingBufferMemory)) {
         std::cerr << "[PNG] ERROR: Failed to create staging buffer!" << std::endl;
-        return 0;
-    }
-    
-    vkGetBufferMemoryRequirements(g_device, stagingBuffer, &memRequirements);
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, 
-                                               VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-    
-    if (vkAllocateMemory(g_device, &allocInfo, nullptr, &stagingBufferMemory) != VK_SUCCESS) {
-        vkDestroyBuffer(g_device, stagingBuffer, nullptr);
-        vkFreeMemory(g_device, g_pngQuadImageMemory, nullptr);
         vkDestroyImage(g_device, g_pngQuadImage, nullptr);
-        std::cerr << "[PNG] ERROR: Failed to allocate staging buffer memory!" << std::endl;
+        GpuAllocator::get_instance().free(g_pngQuadImageMemory);
         return 0;
     }
     
-    vkBindBufferMemory(g_device, stagingBuffer, stagingBufferMemory, 0);
-    
     // Copy pixel data to staging buffer
-    void* data;
-    vkMapMemory(g_device, stagingBufferMemory, 0, pngData.pixelData.size(), 0, &data);
+    void* data = stagingBufferMemory.mapped;
     memcpy(data, pngData.pixelData.data(), pngData.pixelData.size());
-    vkUnmapMemory(g_device, stagingBufferMemory);
     
     // Transition image layout for transfer and upload data
     VkCommandBuffer commandBuffer = beginSingleTimeCommands();
@@ -5039,7 +5516,7 @@ extern "C" int heidic_init_renderer_png_quad(GLFWwindow* window, const char* png
     barrier.image = g_pngQuadImage;
     barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
     barrier.subresourceRange.baseMipLevel = 0;
-    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.levelCount = mipLevels;
     barrier.subresourceRange.baseArrayLayer = 0;
     barrier.subresourceRange.layerCount = 1;
     barrier.srcAccessMask = 0;
@@ -5048,19 +5525,24 @@ extern "C" int heidic_init_renderer_png_quad(GLFWwindow* window, const char* png
     vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
                          0, 0, nullptr, 0, nullptr, 1, &barrier);
     
-    // Copy buffer to image (uncompressed RGBA8)
-    VkBufferImageCopy region = {};
-    region.bufferOffset = 0;
-    region.bufferRowLength = 0;
-    region.bufferImageHeight = 0;
-    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    region.imageSubresource.mipLevel = 0;
-    region.imageSubresource.baseArrayLayer = 0;
-    region.imageSubresource.layerCount = 1;
-    region.imageOffset = {0, 0, 0};
-    region.imageExtent = {pngData.width, pngData.height, 1};
+    // Copy buffer to image (uncompressed RGBA8, one region per mip level)
+    std::vector<VkBufferImageCopy> regions(mipLevels);
+    for (uint32_t level = 0; level < mipLevels; level++) {
+        VkBufferImageCopy& region = regions[level];
+        region = {};
+        region.bufferOffset = pngData.mipLevels[level].offset;
+        region.bufferRowLength = 0;
+        region.bufferImageHeight = 0;
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.mipLevel = level;
+        region.imageSubresource.baseArrayLayer = 0;
+        region.imageSubresource.layerCount = 1;
+        region.imageOffset = {0, 0, 0};
+        region.imageExtent = {pngData.mipLevels[level].width, pngData.mipLevels[level].height, 1};
+    }
     
-    vkCmdCopyBufferToImage(commandBuffer, stagingBuffer, g_pngQuadImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+    vkCmdCopyBufferToImage(commandBuffer, stagingBuffer, g_pngQuadImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           mipLevels, regions.data());
     
     // Transition image layout to shader-readable
     barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
@@ -5075,7 +5557,7 @@ extern "C" int heidic_init_renderer_png_quad(GLFWwindow* window, const char* png
     
     // Cleanup staging buffer
     vkDestroyBuffer(g_device, stagingBuffer, nullptr);
-    vkFreeMemory(g_device, stagingBufferMemory, nullptr);
+    GpuAllocator::get_instance().free(stagingBufferMemory);
     
     // Create image view
     VkImageViewCreateInfo viewInfo = {};
@@ -5085,13 +5567,13 @@ extern "C" int heidic_init_renderer_png_quad(GLFWwindow* window, const char* png
     viewInfo.format = pngData.format;
     viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
     viewInfo.subresourceRange.baseMipLevel = 0;
-    viewInfo.subresourceRange.levelCount = 1;
+    viewInfo.subresourceRange.levelCount = mipLevels;
     viewInfo.subresourceRange.baseArrayLayer = 0;
     viewInfo.subresourceRange.layerCount = 1;
     
     if (vkCreateImageView(g_device, &viewInfo, nullptr, &g_pngQuadImageView) != VK_SUCCESS) {
         std::cerr << "[PNG] ERROR: Failed to create image view!" << std::endl;
-        vkFreeMemory(g_device, g_pngQuadImageMemory, nullptr);
+        GpuAllocator::get_instance().free(g_pngQuadImageMemory);
         vkDestroyImage(g_device, g_pngQuadImage, nullptr);
         return 0;
     }
@@ -5113,12 +5595,12 @@ extern "C" int heidic_init_renderer_png_quad(GLFWwindow* window, const char* png
     samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
     samplerInfo.mipLodBias = 0.0f;
     samplerInfo.minLod = 0.0f;
-    samplerInfo.maxLod = 0.0f;  // No mipmaps for PNG
+    samplerInfo.maxLod = static_cast<float>(mipLevels);
     
     if (vkCreateSampler(g_device, &samplerInfo, nullptr, &g_pngQuadSampler) != VK_SUCCESS) {
         std::cerr << "[PNG] ERROR: Failed to create sampler!" << std::endl;
         vkDestroyImageView(g_device, g_pngQuadImageView, nullptr);
-        vkFreeMemory(g_device, g_pngQuadImageMemory, nullptr);
+        GpuAllocator::get_instance().free(g_pngQuadImageMemory);
         vkDestroyImage(g_device, g_pngQuadImage, nullptr);
         return 0;
     }
@@ -5140,7 +5622,7 @@ extern "C" int heidic_init_renderer_png_quad(GLFWwindow* window, const char* png
         std::cerr << "[PNG] ERROR: Failed to create descriptor set layout!" << std::endl;
         vkDestroySampler(g_device, g_pngQuadSampler, nullptr);
         vkDestroyImageView(g_device, g_pngQuadImageView, nullptr);
-        vkFreeMemory(g_device, g_pngQuadImageMemory, nullptr);
+        GpuAllocator::get_instance().free(g_pngQuadImageMemory);
         vkDestroyImage(g_device, g_pngQuadImage, nullptr);
         return 0;
     }
@@ -5161,7 +5643,7 @@ extern "C" int heidic_init_renderer_png_quad(GLFWwindow* window, const char* png
         vkDestroyDescriptorSetLayout(g_device, g_pngQuadDescriptorSetLayout, nullptr);
         vkDestroySampler(g_device, g_pngQuadSampler, nullptr);
         vkDestroyImageView(g_device, g_pngQuadImageView, nullptr);
-        vkFreeMemory(g_device, g_pngQuadImageMemory, nullptr);
+        GpuAllocator::get_instance().free(g_pngQuadImageMemory);
         vkDestroyImage(g_device, g_pngQuadImage, nullptr);
         return 0;
     }
@@ -5179,7 +5661,7 @@ extern "C" int heidic_init_renderer_png_quad(GLFWwindow* window, const char* png
         vkDestroyDescriptorSetLayout(g_device, g_pngQuadDescriptorSetLayout, nullptr);
         vkDestroySampler(g_device, g_pngQuadSampler, nullptr);
         vkDestroyImageView(g_device, g_pngQuadImageView, nullptr);
-        vkFreeMemory(g_device, g_pngQuadImageMemory, nullptr);
+        GpuAllocator::get_instance().free(g_pngQuadImageMemory);
         vkDestroyImage(g_device, g_pngQuadImage, nullptr);
         return 0;
     }
@@ -5207,9 +5689,8 @@ extern "C" int heidic_init_renderer_png_quad(GLFWwindow* window, const char* png
                  VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                  g_pngQuadVertexBuffer, g_pngQuadVertexBufferMemory);
     
-    vkMapMemory(g_device, g_pngQuadVertexBufferMemory, 0, vertexBufferSize, 0, &data);
+    data = g_pngQuadVertexBufferMemory.mapped;
     memcpy(data, g_quadVertices, (size_t)vertexBufferSize);
-    vkUnmapMemory(g_device, g_pngQuadVertexBufferMemory);
     
     // Create quad index buffer
     VkDeviceSize indexBufferSize = sizeof(g_quadIndices);
@@ -5217,9 +5698,8 @@ extern "C" int heidic_init_renderer_png_quad(GLFWwindow* window, const char* png
                  VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                  g_pngQuadIndexBuffer, g_pngQuadIndexBufferMemory);
     
-    vkMapMemory(g_device, g_pngQuadIndexBufferMemory, 0, indexBufferSize, 0, &data);
+    data = g_pngQuadIndexBufferMemory.mapped;
     memcpy(data, g_quadIndices, (size_t)indexBufferSize);
-    vkUnmapMemory(g_device, g_pngQuadIndexBufferMemory);
     
     // Load quad shaders (same paths as DDS)
     std::vector<char> vertShaderCode, fragShaderCode;
@@ -5239,7 +5719,7 @@ extern "C" int heidic_init_renderer_png_quad(GLFWwindow* window, const char* png
     bool foundVert = false, foundFrag = false;
     for (const auto& path : quadVertPaths) {
         try {
-            vertShaderCode = readFile(path);
+            vertShaderCode = loadShaderCode(path);
             foundVert = true;
             std::cout << "[PNG] Loaded quad vertex shader: " << path << std::endl;
             break;
@@ -5250,7 +5730,7 @@ extern "C" int heidic_init_renderer_png_quad(GLFWwindow* window, const char* png
     
     for (const auto& path : quadFragPaths) {
         try {
-            fragShaderCode = readFile(path);
+            fragShaderCode = loadShaderCode(path);
             foundFrag = true;
             std::cout << "[PNG] Loaded quad fragment shader: " << path << std::endl;
             break;
@@ -5262,14 +5742,14 @@ extern "C" int heidic_init_renderer_png_quad(GLFWwindow* window, const char* png
     if (!foundVert || !foundFrag) {
         std::cerr << "[PNG] ERROR: Failed to load quad shaders!" << std::endl;
         vkDestroyBuffer(g_device, g_pngQuadIndexBuffer, nullptr);
-        vkFreeMemory(g_device, g_pngQuadIndexBufferMemory, nullptr);
+        GpuAllocator::get_instance().free(g_pngQuadIndexBufferMemory);
         vkDestroyBuffer(g_device, g_pngQuadVertexBuffer, nullptr);
-        vkFreeMemory(g_device, g_pngQuadVertexBufferMemory, nullptr);
+        GpuAllocator::get_instance().free(g_pngQuadVertexBufferMemory);
         vkDestroyDescriptorPool(g_device, g_pngQuadDescriptorPool, nullptr);
         vkDestroyDescriptorSetLayout(g_device, g_pngQuadDescriptorSetLayout, nullptr);
         vkDestroySampler(g_device, g_pngQuadSampler, nullptr);
         vkDestroyImageView(g_device, g_pngQuadImageView, nullptr);
-        vkFreeMemory(g_device, g_pngQuadImageMemory, nullptr);
+        GpuAllocator::get_instance().free(g_pngQuadImageMemory);
         vkDestroyImage(g_device, g_pngQuadImage, nullptr);
         return 0;
     }
@@ -5411,7 +5891,7 @@ extern "C" int heidic_init_renderer_png_quad(GLFWwindow* window, const char* png
     pipelineInfo.renderPass = g_renderPass;
     pipelineInfo.subpass = 0;
     
-    if (vkCreateGraphicsPipelines(g_device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &g_pngQuadPipeline) != VK_SUCCESS) {
+    if (vkCreateGraphicsPipelines(g_device, PipelineCache::get_instance().get(), 1, &pipelineInfo, nullptr, &g_pngQuadPipeline) != VK_SUCCESS) {
         std::cerr << "[PNG] ERROR: Failed to create graphics pipeline!" << std::endl;
         vkDestroyPipelineLayout(g_device, g_pngQuadPipelineLayout, nullptr);
         vkDestroyShaderModule(g_device, g_pngQuadFragShaderModule, nullptr);
@@ -5429,13 +5909,11 @@ extern "C" void heidic_render_png_quad(GLFWwindow* window) {
         return;
     }
     
-    // Wait for previous frame
-    vkWaitForFences(g_device, 1, &g_inFlightFence, VK_TRUE, UINT64_MAX);
-    vkResetFences(g_device, 1, &g_inFlightFence);
-    
-    // Acquire next image
+    // Wait for this frame slot and acquire the next swapchain image
     uint32_t imageIndex;
-    vkAcquireNextImageKHR(g_device, g_swapchain, UINT64_MAX, g_imageAvailableSemaphore, VK_NULL_HANDLE, &imageIndex);
+    if (!beginFrame(imageIndex)) {
+        return;
+    }
     
     // Reset command buffer
     vkResetCommandBuffer(g_commandBuffers[imageIndex], 0);
@@ -5480,36 +5958,8 @@ extern "C" void heidic_render_png_quad(GLFWwindow* window) {
     vkCmdEndRenderPass(g_commandBuffers[imageIndex]);
     vkEndCommandBuffer(g_commandBuffers[imageIndex]);
     
-    // Submit
-    VkSubmitInfo submitInfo = {};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    
-    VkSemaphore waitSemaphores[] = {g_imageAvailableSemaphore};
-    VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-    submitInfo.waitSemaphoreCount = 1;
-    submitInfo.pWaitSemaphores = waitSemaphores;
-    submitInfo.pWaitDstStageMask = waitStages;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &g_commandBuffers[imageIndex];
-    
-    VkSemaphore signalSemaphores[] = {g_renderFinishedSemaphore};
-    submitInfo.signalSemaphoreCount = 1;
-    submitInfo.pSignalSemaphores = signalSemaphores;
-    
-    vkQueueSubmit(g_graphicsQueue, 1, &submitInfo, g_inFlightFence);
-    
-    // Present
-    VkPresentInfoKHR presentInfo = {};
-    presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-    presentInfo.waitSemaphoreCount = 1;
-    presentInfo.pWaitSemaphores = signalSemaphores;
-    
-    VkSwapchainKHR swapChains[] = {g_swapchain};
-    presentInfo.swapchainCount = 1;
-    presentInfo.pSwapchains = swapChains;
-    presentInfo.pImageIndices = &imageIndex;
-    
-    vkQueuePresentKHR(g_graphicsQueue, &presentInfo);
+    // Submit on this frame slot's fence and present
+    submitFrame(imageIndex);
 }
 
 extern "C" void heidic_cleanup_renderer_png_quad() {
@@ -5525,10 +5975,7 @@ extern "C" void heidic_cleanup_renderer_png_quad() {
         vkDestroyImage(g_device, g_pngQuadImage, nullptr);
         g_pngQuadImage = VK_NULL_HANDLE;
     }
-    if (g_pngQuadImageMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(g_device, g_pngQuadImageMemory, nullptr);
-        g_pngQuadImageMemory = VK_NULL_HANDLE;
-    }
+    GpuAllocator::get_instance().free(g_pngQuadImageMemory);
     if (g_pngQuadPipeline != VK_NULL_HANDLE) {
         vkDestroyPipeline(g_device, g_pngQuadPipeline, nullptr);
         g_pngQuadPipeline = VK_NULL_HANDLE;
@@ -5549,18 +5996,12 @@ extern "C" void heidic_cleanup_renderer_png_quad() {
         vkDestroyBuffer(g_device, g_pngQuadVertexBuffer, nullptr);
         g_pngQuadVertexBuffer = VK_NULL_HANDLE;
     }
-    if (g_pngQuadVertexBufferMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(g_device, g_pngQuadVertexBufferMemory, nullptr);
-        g_pngQuadVertexBufferMemory = VK_NULL_HANDLE;
-    }
+    GpuAllocator::get_instance().free(g_pngQuadVertexBufferMemory);
     if (g_pngQuadIndexBuffer != VK_NULL_HANDLE) {
         vkDestroyBuffer(g_device, g_pngQuadIndexBuffer, nullptr);
         g_pngQuadIndexBuffer = VK_NULL_HANDLE;
     }
-    if (g_pngQuadIndexBufferMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(g_device, g_pngQuadIndexBufferMemory, nullptr);
-        g_pngQuadIndexBufferMemory = VK_NULL_HANDLE;
-    }
+    GpuAllocator::get_instance().free(g_pngQuadIndexBufferMemory);
     if (g_pngQuadVertShaderModule != VK_NULL_HANDLE) {
         vkDestroyShaderModule(g_device, g_pngQuadVertShaderModule, nullptr);
         g_pngQuadVertShaderModule = VK_NULL_HANDLE;
@@ -5572,6 +6013,82 @@ extern "C" void heidic_cleanup_renderer_png_quad() {
     g_pngQuadInitialized = false;
 }
 
+// Per-frame-slot copies of a descriptor set. Setup and reload code keep writing the original set,
+// which is never bound and so never in use; each frame binds its slot's copy instead.
+struct SlotDescriptorSets {
+    VkDescriptorPool pool = VK_NULL_HANDLE;     // Pool the copies came from (re-created pools re-allocate)
+    VkDescriptorSet sets[MAX_FRAMES_IN_FLIGHT] = {};
+};
+
+// Keep a texture baked into a long-lived descriptor set usable: touch it for the ResidencyManager
+// and copy `templateSet` into the current frame slot's set with the texture's current view and
+// sampler at `binding` (they change as streamed levels land, detail is dropped or it is restored
+// after eviction). Call after beginFrame, whose fence wait means no submitted frame still reads the
+// slot's set, so nothing waits on the other frames in flight. The pool must have room for
+// MAX_FRAMES_IN_FLIGHT sets beyond the template. Returns the set to bind (the template on failure).
+static VkDescriptorSet refreshTextureDescriptor(TextureResource& texture, SlotDescriptorSets& slots, VkDescriptorPool pool,
+                                                VkDescriptorSetLayout layout, VkDescriptorSet templateSet,
+                                                uint32_t bindingCount, uint32_t binding) {
+    if (slots.pool != pool) {
+        std::fill(std::begin(slots.sets), std::end(slots.sets), VK_NULL_HANDLE);
+        slots.pool = pool;
+    }
+    VkDescriptorSet& slotSet = slots.sets[g_currentFrame];
+    if (slotSet == VK_NULL_HANDLE) {
+        VkDescriptorSetAllocateInfo allocInfo = {};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = pool;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &layout;
+        if (vkAllocateDescriptorSets(g_device, &allocInfo, &slotSet) != VK_SUCCESS) {
+            slotSet = VK_NULL_HANDLE;
+            return templateSet;
+        }
+    }
+    
+    std::vector<VkCopyDescriptorSet> copies;
+    for (uint32_t b = 0; b < bindingCount; b++) {
+        if (b == binding) {
+            continue;
+        }
+        VkCopyDescriptorSet copy = {};
+        copy.sType = VK_STRUCTURE_TYPE_COPY_DESCRIPTOR_SET;
+        copy.srcSet = templateSet;
+        copy.srcBinding = b;
+        copy.dstSet = slotSet;
+        copy.dstBinding = b;
+        copy.descriptorCount = 1;
+        copies.push_back(copy);
+    }
+    
+    VkDescriptorImageInfo imageInfo = {};
+    VkWriteDescriptorSet descriptorWrite = {};
+    bool resident = texture.ensureResident() && texture.isLoaded();
+    if (resident) {
+        imageInfo = texture.getDescriptorImageInfo();
+        descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptorWrite.dstSet = slotSet;
+        descriptorWrite.dstBinding = binding;
+        descriptorWrite.dstArrayElement = 0;
+        descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        descriptorWrite.descriptorCount = 1;
+        descriptorWrite.pImageInfo = &imageInfo;
+    } else {
+        // Not loaded: sample whatever the template holds (e.g. a fallback texture)
+        VkCopyDescriptorSet copy = {};
+        copy.sType = VK_STRUCTURE_TYPE_COPY_DESCRIPTOR_SET;
+        copy.srcSet = templateSet;
+        copy.srcBinding = binding;
+        copy.dstSet = slotSet;
+        copy.dstBinding = binding;
+        copy.descriptorCount = 1;
+        copies.push_back(copy);
+    }
+    vkUpdateDescriptorSets(g_device, resident ? 1 : 0, &descriptorWrite,
+                           static_cast<uint32_t>(copies.size()), copies.data());
+    return slotSet;
+}
+
 // ========== TEXTURERESOURCE QUAD RENDERER (TEST) ==========
 // Test renderer that uses TextureResource class to load textures automatically
 static std::unique_ptr<TextureResource> g_textureResourceQuad = nullptr;
@@ -5579,11 +6096,12 @@ static VkPipeline g_textureResourceQuadPipeline = VK_NULL_HANDLE;
 static VkPipelineLayout g_textureResourceQuadPipelineLayout = VK_NULL_HANDLE;
 static VkDescriptorSetLayout g_textureResourceQuadDescriptorSetLayout = VK_NULL_HANDLE;
 static VkDescriptorPool g_textureResourceQuadDescriptorPool = VK_NULL_HANDLE;
-static VkDescriptorSet g_textureResourceQuadDescriptorSet = VK_NULL_HANDLE;
+static VkDescriptorSet g_textureResourceQuadDescriptorSet = VK_NULL_HANDLE;   // Template; frames bind the slot copies
+static SlotDescriptorSets g_textureResourceQuadSlotSets;
 static VkBuffer g_textureResourceQuadVertexBuffer = VK_NULL_HANDLE;
-static VkDeviceMemory g_textureResourceQuadVertexBufferMemory = VK_NULL_HANDLE;
+static GpuAllocation g_textureResourceQuadVertexBufferMemory;
 static VkBuffer g_textureResourceQuadIndexBuffer = VK_NULL_HANDLE;
-static VkDeviceMemory g_textureResourceQuadIndexBufferMemory = VK_NULL_HANDLE;
+static GpuAllocation g_textureResourceQuadIndexBufferMemory;
 static VkShaderModule g_textureResourceQuadVertShaderModule = VK_NULL_HANDLE;
 static VkShaderModule g_textureResourceQuadFragShaderModule = VK_NULL_HANDLE;
 static bool g_textureResourceQuadInitialized = false;
@@ -5687,13 +6205,13 @@ extern "C" int heidic_init_renderer_texture_quad(GLFWwindow* window, const char*
     // Create descriptor pool
     VkDescriptorPoolSize poolSize = {};
     poolSize.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    poolSize.descriptorCount = 1;
+    poolSize.descriptorCount = 1 + MAX_FRAMES_IN_FLIGHT;
     
     VkDescriptorPoolCreateInfo poolInfo = {};
     poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
     poolInfo.poolSizeCount = 1;
     poolInfo.pPoolSizes = &poolSize;
-    poolInfo.maxSets = 1;
+    poolInfo.maxSets = 1 + MAX_FRAMES_IN_FLIGHT;   // The template set and one copy per frame slot
     
     if (vkCreateDescriptorPool(g_device, &poolInfo, nullptr, &g_textureResourceQuadDescriptorPool) != VK_SUCCESS) {
         std::cerr << "[TextureResource] ERROR: Failed to create descriptor pool!" << std::endl;
@@ -5736,19 +6254,16 @@ extern "C" int heidic_init_renderer_texture_quad(GLFWwindow* window, const char*
                  VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                  g_textureResourceQuadVertexBuffer, g_textureResourceQuadVertexBufferMemory);
     
-    void* data;
-    vkMapMemory(g_device, g_textureResourceQuadVertexBufferMemory, 0, vertexBufferSize, 0, &data);
+    void* data = g_textureResourceQuadVertexBufferMemory.mapped;
     memcpy(data, g_quadVertices, (size_t)vertexBufferSize);
-    vkUnmapMemory(g_device, g_textureResourceQuadVertexBufferMemory);
     
     VkDeviceSize indexBufferSize = sizeof(g_quadIndices);
     createBuffer(indexBufferSize, VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
                  VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                  g_textureResourceQuadIndexBuffer, g_textureResourceQuadIndexBufferMemory);
     
-    vkMapMemory(g_device, g_textureResourceQuadIndexBufferMemory, 0, indexBufferSize, 0, &data);
+    data = g_textureResourceQuadIndexBufferMemory.mapped;
     memcpy(data, g_quadIndices, (size_t)indexBufferSize);
-    vkUnmapMemory(g_device, g_textureResourceQuadIndexBufferMemory);
     
     // Load quad shaders
     std::vector<char> vertShaderCode, fragShaderCode;
@@ -5768,7 +6283,7 @@ extern "C" int heidic_init_renderer_texture_quad(GLFWwindow* window, const char*
     bool foundVert = false, foundFrag = false;
     for (const auto& path : quadVertPaths) {
         try {
-            vertShaderCode = readFile(path);
+            vertShaderCode = loadShaderCode(path);
             foundVert = true;
             std::cout << "[TextureResource] Loaded vertex shader: " << path << std::endl;
             break;
@@ -5777,7 +6292,7 @@ extern "C" int heidic_init_renderer_texture_quad(GLFWwindow* window, const char*
     
     for (const auto& path : quadFragPaths) {
         try {
-            fragShaderCode = readFile(path);
+            fragShaderCode = loadShaderCode(path);
             foundFrag = true;
             std::cout << "[TextureResource] Loaded fragment shader: " << path << std::endl;
             break;
@@ -5787,9 +6302,9 @@ extern "C" int heidic_init_renderer_texture_quad(GLFWwindow* window, const char*
     if (!foundVert || !foundFrag) {
         std::cerr << "[TextureResource] ERROR: Failed to load quad shaders!" << std::endl;
         vkDestroyBuffer(g_device, g_textureResourceQuadIndexBuffer, nullptr);
-        vkFreeMemory(g_device, g_textureResourceQuadIndexBufferMemory, nullptr);
+        GpuAllocator::get_instance().free(g_textureResourceQuadIndexBufferMemory);
         vkDestroyBuffer(g_device, g_textureResourceQuadVertexBuffer, nullptr);
-        vkFreeMemory(g_device, g_textureResourceQuadVertexBufferMemory, nullptr);
+        GpuAllocator::get_instance().free(g_textureResourceQuadVertexBufferMemory);
         vkDestroyDescriptorPool(g_device, g_textureResourceQuadDescriptorPool, nullptr);
         vkDestroyDescriptorSetLayout(g_device, g_textureResourceQuadDescriptorSetLayout, nullptr);
         g_textureResourceQuad.reset();
@@ -5935,7 +6450,7 @@ extern "C" int heidic_init_renderer_texture_quad(GLFWwindow* window, const char*
     pipelineInfo.renderPass = g_renderPass;
     pipelineInfo.subpass = 0;
     
-    if (vkCreateGraphicsPipelines(g_device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &g_textureResourceQuadPipeline) != VK_SUCCESS) {
+    if (vkCreateGraphicsPipelines(g_device, PipelineCache::get_instance().get(), 1, &pipelineInfo, nullptr, &g_textureResourceQuadPipeline) != VK_SUCCESS) {
         std::cerr << "[TextureResource] ERROR: Failed to create graphics pipeline!" << std::endl;
         vkDestroyPipelineLayout(g_device, g_textureResourceQuadPipelineLayout, nullptr);
         vkDestroyShaderModule(g_device, g_textureResourceQuadFragShaderModule, nullptr);
@@ -5954,11 +6469,22 @@ extern "C" void heidic_render_texture_quad(GLFWwindow* window) {
         return;
     }
     
-    vkWaitForFences(g_device, 1, &g_inFlightFence, VK_TRUE, UINT64_MAX);
-    vkResetFences(g_device, 1, &g_inFlightFence);
-    
+    // Wait for this frame slot and acquire the next swapchain image
     uint32_t imageIndex;
-    vkAcquireNextImageKHR(g_device, g_swapchain, UINT64_MAX, g_imageAvailableSemaphore, VK_NULL_HANDLE, &imageIndex);
+    if (!beginFrame(imageIndex)) {
+        return;
+    }
+    
+    // Advance residency clock and evict least-recently-used assets if over budget
+    ResidencyManager::get_instance().beginFrame();
+    
+    // Finish streamed texture levels that have landed and start the next ones within budget
+    TextureStreamer::get_instance().update();
+    
+    // Sample the texture's current view (it changes as finer levels stream in)
+    VkDescriptorSet descriptorSet = refreshTextureDescriptor(*g_textureResourceQuad, g_textureResourceQuadSlotSets,
+                                                             g_textureResourceQuadDescriptorPool, g_textureResourceQuadDescriptorSetLayout,
+                                                             g_textureResourceQuadDescriptorSet, 1, 0);
     
     vkResetCommandBuffer(g_commandBuffers[imageIndex], 0);
     
@@ -5984,7 +6510,7 @@ extern "C" void heidic_render_texture_quad(GLFWwindow* window) {
     vkCmdBindPipeline(g_commandBuffers[imageIndex], VK_PIPELINE_BIND_POINT_GRAPHICS, g_textureResourceQuadPipeline);
     
     vkCmdBindDescriptorSets(g_commandBuffers[imageIndex], VK_PIPELINE_BIND_POINT_GRAPHICS, 
-                            g_textureResourceQuadPipelineLayout, 0, 1, &g_textureResourceQuadDescriptorSet, 0, nullptr);
+                            g_textureResourceQuadPipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
     
     VkBuffer vertexBuffers[] = {g_textureResourceQuadVertexBuffer};
     VkDeviceSize offsets[] = {0};
@@ -5996,34 +6522,8 @@ extern "C" void heidic_render_texture_quad(GLFWwindow* window) {
     vkCmdEndRenderPass(g_commandBuffers[imageIndex]);
     vkEndCommandBuffer(g_commandBuffers[imageIndex]);
     
-    VkSubmitInfo submitInfo = {};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    
-    VkSemaphore waitSemaphores[] = {g_imageAvailableSemaphore};
-    VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-    submitInfo.waitSemaphoreCount = 1;
-    submitInfo.pWaitSemaphores = waitSemaphores;
-    submitInfo.pWaitDstStageMask = waitStages;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &g_commandBuffers[imageIndex];
-    
-    VkSemaphore signalSemaphores[] = {g_renderFinishedSemaphore};
-    submitInfo.signalSemaphoreCount = 1;
-    submitInfo.pSignalSemaphores = signalSemaphores;
-    
-    vkQueueSubmit(g_graphicsQueue, 1, &submitInfo, g_inFlightFence);
-    
-    VkPresentInfoKHR presentInfo = {};
-    presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-    presentInfo.waitSemaphoreCount = 1;
-    presentInfo.pWaitSemaphores = signalSemaphores;
-    
-    VkSwapchainKHR swapChains[] = {g_swapchain};
-    presentInfo.swapchainCount = 1;
-    presentInfo.pSwapchains = swapChains;
-    presentInfo.pImageIndices = &imageIndex;
-    
-    vkQueuePresentKHR(g_graphicsQueue, &presentInfo);
+    // Submit on this frame slot's fence and present
+    submitFrame(imageIndex);
 }
 
 extern "C" void heidic_cleanup_renderer_texture_quad() {
@@ -6038,6 +6538,7 @@ extern "C" void heidic_cleanup_renderer_texture_quad() {
     if (g_textureResourceQuadDescriptorPool != VK_NULL_HANDLE) {
         vkDestroyDescriptorPool(g_device, g_textureResourceQuadDescriptorPool, nullptr);
         g_textureResourceQuadDescriptorPool = VK_NULL_HANDLE;
+        g_textureResourceQuadSlotSets = SlotDescriptorSets();
     }
     if (g_textureResourceQuadDescriptorSetLayout != VK_NULL_HANDLE) {
         vkDestroyDescriptorSetLayout(g_device, g_textureResourceQuadDescriptorSetLayout, nullptr);
@@ -6047,18 +6548,12 @@ extern "C" void heidic_cleanup_renderer_texture_quad() {
         vkDestroyBuffer(g_device, g_textureResourceQuadVertexBuffer, nullptr);
         g_textureResourceQuadVertexBuffer = VK_NULL_HANDLE;
     }
-    if (g_textureResourceQuadVertexBufferMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(g_device, g_textureResourceQuadVertexBufferMemory, nullptr);
-        g_textureResourceQuadVertexBufferMemory = VK_NULL_HANDLE;
-    }
+    GpuAllocator::get_instance().free(g_textureResourceQuadVertexBufferMemory);
     if (g_textureResourceQuadIndexBuffer != VK_NULL_HANDLE) {
         vkDestroyBuffer(g_device, g_textureResourceQuadIndexBuffer, nullptr);
         g_textureResourceQuadIndexBuffer = VK_NULL_HANDLE;
     }
-    if (g_textureResourceQuadIndexBufferMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(g_device, g_textureResourceQuadIndexBufferMemory, nullptr);
-        g_textureResourceQuadIndexBufferMemory = VK_NULL_HANDLE;
-    }
+    GpuAllocator::get_instance().free(g_textureResourceQuadIndexBufferMemory);
     if (g_textureResourceQuadVertShaderModule != VK_NULL_HANDLE) {
         vkDestroyShaderModule(g_device, g_textureResourceQuadVertShaderModule, nullptr);
         g_textureResourceQuadVertShaderModule = VK_NULL_HANDLE;
@@ -6082,15 +6577,20 @@ static VkPipeline g_objMeshPipeline = VK_NULL_HANDLE;
 static VkPipelineLayout g_objMeshPipelineLayout = VK_NULL_HANDLE;
 static VkDescriptorSetLayout g_objMeshDescriptorSetLayout = VK_NULL_HANDLE;
 static VkDescriptorPool g_objMeshDescriptorPool = VK_NULL_HANDLE;
-static VkDescriptorSet g_objMeshDescriptorSet = VK_NULL_HANDLE;
+static VkDescriptorSet g_objMeshDescriptorSet = VK_NULL_HANDLE;   // Template; frames bind the slot copies
+static SlotDescriptorSets g_objMeshSlotSets;
 static VkBuffer g_objMeshUniformBuffer = VK_NULL_HANDLE;
-static VkDeviceMemory g_objMeshUniformBufferMemory = VK_NULL_HANDLE;
+static GpuAllocation g_objMeshUniformBufferMemory;
+// Bounding sphere of the OBJ mesh about its origin (valid for any rotation), recomputed when the mesh changes
+static const MeshResource* g_objMeshBoundsMesh = nullptr;
+static size_t g_objMeshBoundsVertexCount = 0;
+static float g_objMeshBoundingRadius = 0.0f;
 static VkShaderModule g_objMeshVertShaderModule = VK_NULL_HANDLE;
 static VkShaderModule g_objMeshFragShaderModule = VK_NULL_HANDLE;
 static VkImage g_objMeshDummyTexture = VK_NULL_HANDLE;
 static VkImageView g_objMeshDummyTextureView = VK_NULL_HANDLE;
 static VkSampler g_objMeshDummySampler = VK_NULL_HANDLE;
-static VkDeviceMemory g_objMeshDummyTextureMemory = VK_NULL_HANDLE;
+static GpuAllocation g_objMeshDummyTextureMemory;
 static bool g_objMeshInitialized = false;
 static float g_objMeshRotationAngle = 0.0f;
 static std::chrono::high_resolution_clock::time_point g_objMeshLastTime = std::chrono::high_resolution_clock::now();
@@ -6099,6 +6599,11 @@ static std::time_t g_objMeshTextureLastModified = 0;  // Track file modification
 static void* g_objMeshTextureResourcePtr = nullptr;  // Store HEIDIC Resource<TextureResource>* pointer (resource-based)
 static TextureResource* g_objMeshTextureFromResource = nullptr;  // Store pointer to texture from HEIDIC resource (for change detection)
 
+// The texture g_objMeshDescriptorSet samples: the HEIDIC resource's if one was given, else the path-loaded one
+static TextureResource* objMeshBoundTexture() {
+    return g_objMeshTextureFromResource ? g_objMeshTextureFromResource : g_objMeshTexture.get();
+}
+
 // Initialize OBJ mesh renderer
 extern "C" int heidic_init_renderer_obj_mesh(GLFWwindow* window, const char* objPath, const char* texturePath) {
     if (g_device == VK_NULL_HANDLE) {
@@ -6127,14 +6632,14 @@ extern "C" int heidic_init_renderer_obj_mesh(GLFWwindow* window, const char* obj
     // Load shaders - try shaders/ subdirectory first, then current directory
     std::vector<char> vertShaderCode, fragShaderCode;
     try {
-        vertShaderCode = readFile("shaders/mesh.vert.spv");
-        fragShaderCode = readFile("shaders/mesh.frag.spv");
+        vertShaderCode = loadShaderCode("shaders/mesh.vert.spv");
+        fragShaderCode = loadShaderCode("shaders/mesh.frag.spv");
         std::cout << "[EDEN] Loaded mesh shaders from shaders/ directory" << std::endl;
     } catch (const std::exception& e) {
         // Try current directory
         try {
-            vertShaderCode = readFile("mesh.vert.spv");
-            fragShaderCode = readFile("mesh.frag.spv");
+            vertShaderCode = loadShaderCode("mesh.vert.spv");
+            fragShaderCode = loadShaderCode("mesh.frag.spv");
             std::cout << "[EDEN] Loaded mesh shaders from current directory" << std::endl;
         } catch (const std::exception& e2) {
             std::cerr << "[EDEN] ERROR: Could not find mesh shader files!" << std::endl;
@@ -6279,15 +6784,13 @@ extern "C" int heidic_init_renderer_obj_mesh(GLFWwindow* window, const char* obj
         region.imageExtent = {1, 1, 1};
         
         VkBuffer stagingBuffer;
-        VkDeviceMemory stagingBufferMemory;
+        GpuAllocation stagingBufferMemory;
         createBuffer(4, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
                      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                      stagingBuffer, stagingBufferMemory);
         
-        void* data;
-        vkMapMemory(g_device, stagingBufferMemory, 0, 4, 0, &data);
+        void* data = stagingBufferMemory.mapped;
         memcpy(data, &dummyData, 4);
-        vkUnmapMemory(g_device, stagingBufferMemory);
         
         vkCmdCopyBufferToImage(commandBuffer, stagingBuffer, g_objMeshDummyTexture, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
         
@@ -6302,7 +6805,7 @@ extern "C" int heidic_init_renderer_obj_mesh(GLFWwindow* window, const char* obj
         endSingleTimeCommands(commandBuffer);
         
         vkDestroyBuffer(g_device, stagingBuffer, nullptr);
-        vkFreeMemory(g_device, stagingBufferMemory, nullptr);
+        GpuAllocator::get_instance().free(stagingBufferMemory);
         
         // Create image view for dummy texture
         VkImageViewCreateInfo viewInfo = {};
@@ -6319,9 +6822,9 @@ extern "C" int heidic_init_renderer_obj_mesh(GLFWwindow* window, const char* obj
         if (vkCreateImageView(g_device, &viewInfo, nullptr, &g_objMeshDummyTextureView) != VK_SUCCESS) {
             std::cerr << "[EDEN] ERROR: Failed to create dummy texture image view!" << std::endl;
             vkDestroyImage(g_device, g_objMeshDummyTexture, nullptr);
-            vkFreeMemory(g_device, g_objMeshDummyTextureMemory, nullptr);
+            GpuAllocator::get_instance().free(g_objMeshDummyTextureMemory);
             vkDestroyBuffer(g_device, g_objMeshUniformBuffer, nullptr);
-            vkFreeMemory(g_device, g_objMeshUniformBufferMemory, nullptr);
+            GpuAllocator::get_instance().free(g_objMeshUniformBufferMemory);
             vkDestroyPipelineLayout(g_device, g_objMeshPipelineLayout, nullptr);
             vkDestroyDescriptorSetLayout(g_device, g_objMeshDescriptorSetLayout, nullptr);
             vkDestroyShaderModule(g_device, g_objMeshVertShaderModule, nullptr);
@@ -6352,9 +6855,9 @@ extern "C" int heidic_init_renderer_obj_mesh(GLFWwindow* window, const char* obj
             std::cerr << "[EDEN] ERROR: Failed to create sampler!" << std::endl;
             vkDestroyImageView(g_device, g_objMeshDummyTextureView, nullptr);
             vkDestroyImage(g_device, g_objMeshDummyTexture, nullptr);
-            vkFreeMemory(g_device, g_objMeshDummyTextureMemory, nullptr);
+            GpuAllocator::get_instance().free(g_objMeshDummyTextureMemory);
             vkDestroyBuffer(g_device, g_objMeshUniformBuffer, nullptr);
-            vkFreeMemory(g_device, g_objMeshUniformBufferMemory, nullptr);
+            GpuAllocator::get_instance().free(g_objMeshUniformBufferMemory);
             vkDestroyPipelineLayout(g_device, g_objMeshPipelineLayout, nullptr);
             vkDestroyDescriptorSetLayout(g_device, g_objMeshDescriptorSetLayout, nullptr);
             vkDestroyShaderModule(g_device, g_objMeshVertShaderModule, nullptr);
@@ -6366,24 +6869,24 @@ extern "C" int heidic_init_renderer_obj_mesh(GLFWwindow* window, const char* obj
     // Create descriptor pool
     VkDescriptorPoolSize poolSizes[2] = {};
     poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-    poolSizes[0].descriptorCount = 1;
+    poolSizes[0].descriptorCount = 1 + MAX_FRAMES_IN_FLIGHT;
     poolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    poolSizes[1].descriptorCount = 1;
+    poolSizes[1].descriptorCount = 1 + MAX_FRAMES_IN_FLIGHT;
     
     VkDescriptorPoolCreateInfo poolInfo = {};
     poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
     poolInfo.poolSizeCount = 2;
     poolInfo.pPoolSizes = poolSizes;
-    poolInfo.maxSets = 1;
+    poolInfo.maxSets = 1 + MAX_FRAMES_IN_FLIGHT;   // The template set and one copy per frame slot
     
     if (vkCreateDescriptorPool(g_device, &poolInfo, nullptr, &g_objMeshDescriptorPool) != VK_SUCCESS) {
         std::cerr << "[EDEN] ERROR: Failed to create descriptor pool!" << std::endl;
         vkDestroySampler(g_device, g_objMeshDummySampler, nullptr);
         vkDestroyImageView(g_device, g_objMeshDummyTextureView, nullptr);
         vkDestroyImage(g_device, g_objMeshDummyTexture, nullptr);
-        vkFreeMemory(g_device, g_objMeshDummyTextureMemory, nullptr);
+        GpuAllocator::get_instance().free(g_objMeshDummyTextureMemory);
         vkDestroyBuffer(g_device, g_objMeshUniformBuffer, nullptr);
-        vkFreeMemory(g_device, g_objMeshUniformBufferMemory, nullptr);
+        GpuAllocator::get_instance().free(g_objMeshUniformBufferMemory);
         vkDestroyPipelineLayout(g_device, g_objMeshPipelineLayout, nullptr);
         vkDestroyDescriptorSetLayout(g_device, g_objMeshDescriptorSetLayout, nullptr);
         vkDestroyShaderModule(g_device, g_objMeshVertShaderModule, nullptr);
@@ -6404,9 +6907,9 @@ extern "C" int heidic_init_renderer_obj_mesh(GLFWwindow* window, const char* obj
         vkDestroySampler(g_device, g_objMeshDummySampler, nullptr);
         vkDestroyImageView(g_device, g_objMeshDummyTextureView, nullptr);
         vkDestroyImage(g_device, g_objMeshDummyTexture, nullptr);
-        vkFreeMemory(g_device, g_objMeshDummyTextureMemory, nullptr);
+        GpuAllocator::get_instance().free(g_objMeshDummyTextureMemory);
         vkDestroyBuffer(g_device, g_objMeshUniformBuffer, nullptr);
-        vkFreeMemory(g_device, g_objMeshUniformBufferMemory, nullptr);
+        GpuAllocator::get_instance().free(g_objMeshUniformBufferMemory);
         vkDestroyPipelineLayout(g_device, g_objMeshPipelineLayout, nullptr);
         vkDestroyDescriptorSetLayout(g_device, g_objMeshDescriptorSetLayout, nullptr);
         vkDestroyShaderModule(g_device, g_objMeshVertShaderModule, nullptr);
@@ -6566,15 +7069,15 @@ extern "C" int heidic_init_renderer_obj_mesh(GLFWwindow* window, const char* obj
     pipelineInfo.subpass = 0;
     pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
     
-    if (vkCreateGraphicsPipelines(g_device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &g_objMeshPipeline) != VK_SUCCESS) {
+    if (vkCreateGraphicsPipelines(g_device, PipelineCache::get_instance().get(), 1, &pipelineInfo, nullptr, &g_objMeshPipeline) != VK_SUCCESS) {
         std::cerr << "[EDEN] ERROR: Failed to create graphics pipeline!" << std::endl;
         vkDestroyDescriptorPool(g_device, g_objMeshDescriptorPool, nullptr);
         vkDestroySampler(g_device, g_objMeshDummySampler, nullptr);
         vkDestroyImageView(g_device, g_objMeshDummyTextureView, nullptr);
         vkDestroyImage(g_device, g_objMeshDummyTexture, nullptr);
-        vkFreeMemory(g_device, g_objMeshDummyTextureMemory, nullptr);
+        GpuAllocator::get_instance().free(g_objMeshDummyTextureMemory);
         vkDestroyBuffer(g_device, g_objMeshUniformBuffer, nullptr);
-        vkFreeMemory(g_device, g_objMeshUniformBufferMemory, nullptr);
+        GpuAllocator::get_instance().free(g_objMeshUniformBufferMemory);
         vkDestroyPipelineLayout(g_device, g_objMeshPipelineLayout, nullptr);
         vkDestroyDescriptorSetLayout(g_device, g_objMeshDescriptorSetLayout, nullptr);
         vkDestroyShaderModule(g_device, g_objMeshVertShaderModule, nullptr);
@@ -6625,8 +7128,8 @@ extern "C" int heidic_init_renderer_obj_mesh_with_resources(GLFWwindow* window,
     // Load shaders (same as path-based version)
     std::vector<char> vertShaderCode, fragShaderCode;
     try {
-        vertShaderCode = readFile("mesh.vert.spv");
-        fragShaderCode = readFile("mesh.frag.spv");
+        vertShaderCode = loadShaderCode("mesh.vert.spv");
+        fragShaderCode = loadShaderCode("mesh.frag.spv");
         std::cout << "[EDEN] Loaded mesh shaders successfully" << std::endl;
     } catch (const std::exception& e) {
         std::cerr << "[EDEN] ERROR: Could not find mesh shader files (mesh.vert.spv, mesh.frag.spv)!" << std::endl;
@@ -6710,20 +7213,20 @@ extern "C" int heidic_init_renderer_obj_mesh_with_resources(GLFWwindow* window,
     // Create descriptor pool
     VkDescriptorPoolSize poolSizes[2] = {};
     poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-    poolSizes[0].descriptorCount = 1;
+    poolSizes[0].descriptorCount = 1 + MAX_FRAMES_IN_FLIGHT;
     poolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    poolSizes[1].descriptorCount = 1;
+    poolSizes[1].descriptorCount = 1 + MAX_FRAMES_IN_FLIGHT;
     
     VkDescriptorPoolCreateInfo poolInfo = {};
     poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
     poolInfo.poolSizeCount = 2;
     poolInfo.pPoolSizes = poolSizes;
-    poolInfo.maxSets = 1;
+    poolInfo.maxSets = 1 + MAX_FRAMES_IN_FLIGHT;   // The template set and one copy per frame slot
     
     if (vkCreateDescriptorPool(g_device, &poolInfo, nullptr, &g_objMeshDescriptorPool) != VK_SUCCESS) {
         std::cerr << "[EDEN] ERROR: Failed to create descriptor pool!" << std::endl;
         vkDestroyBuffer(g_device, g_objMeshUniformBuffer, nullptr);
-        vkFreeMemory(g_device, g_objMeshUniformBufferMemory, nullptr);
+        GpuAllocator::get_instance().free(g_objMeshUniformBufferMemory);
         vkDestroyPipelineLayout(g_device, g_objMeshPipelineLayout, nullptr);
         vkDestroyDescriptorSetLayout(g_device, g_objMeshDescriptorSetLayout, nullptr);
         vkDestroyShaderModule(g_device, g_objMeshVertShaderModule, nullptr);
@@ -6742,7 +7245,7 @@ extern "C" int heidic_init_renderer_obj_mesh_with_resources(GLFWwindow* window,
         std::cerr << "[EDEN] ERROR: Failed to allocate descriptor set!" << std::endl;
         vkDestroyDescriptorPool(g_device, g_objMeshDescriptorPool, nullptr);
         vkDestroyBuffer(g_device, g_objMeshUniformBuffer, nullptr);
-        vkFreeMemory(g_device, g_objMeshUniformBufferMemory, nullptr);
+        GpuAllocator::get_instance().free(g_objMeshUniformBufferMemory);
         vkDestroyPipelineLayout(g_device, g_objMeshPipelineLayout, nullptr);
         vkDestroyDescriptorSetLayout(g_device, g_objMeshDescriptorSetLayout, nullptr);
         vkDestroyShaderModule(g_device, g_objMeshVertShaderModule, nullptr);
@@ -6797,15 +7300,13 @@ extern "C" int heidic_init_renderer_obj_mesh_with_resources(GLFWwindow* window,
         region.imageExtent = {1, 1, 1};
         
         VkBuffer stagingBuffer;
-        VkDeviceMemory stagingBufferMemory;
+        GpuAllocation stagingBufferMemory;
         createBuffer(4, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
                      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                      stagingBuffer, stagingBufferMemory);
         
-        void* data;
-        vkMapMemory(g_device, stagingBufferMemory, 0, 4, 0, &data);
+        void* data = stagingBufferMemory.mapped;
         memcpy(data, &dummyData, 4);
-        vkUnmapMemory(g_device, stagingBufferMemory);
         
         vkCmdCopyBufferToImage(commandBuffer, stagingBuffer, g_objMeshDummyTexture, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
         
@@ -6820,7 +7321,7 @@ extern "C" int heidic_init_renderer_obj_mesh_with_resources(GLFWwindow* window,
         endSingleTimeCommands(commandBuffer);
         
         vkDestroyBuffer(g_device, stagingBuffer, nullptr);
-        vkFreeMemory(g_device, stagingBufferMemory, nullptr);
+        GpuAllocator::get_instance().free(stagingBufferMemory);
         
         VkImageViewCreateInfo viewInfo = {};
         viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
@@ -6899,6 +7400,32 @@ extern "C" int heidic_init_renderer_obj_mesh_with_resources(GLFWwindow* window,
     return 1;
 }
 
+// Whether the OBJ mesh (rotating about its origin) intersects the view of ubo.view/ubo.proj
+static bool objMeshVisible(const UniformBufferObject& ubo, const Vec3& eye) {
+    const std::vector<MeshVertex>& vertices = g_objMeshResource->getVertices();
+    if (vertices.empty()) {
+        return true;
+    }
+    if (g_objMeshBoundsMesh != g_objMeshResource.get() || g_objMeshBoundsVertexCount != vertices.size()) {
+        float radiusSq = 0.0f;
+        for (const MeshVertex& vertex : vertices) {
+            radiusSq = std::max(radiusSq, vertex.pos[0] * vertex.pos[0] + vertex.pos[1] * vertex.pos[1] + vertex.pos[2] * vertex.pos[2]);
+        }
+        g_objMeshBoundsMesh = g_objMeshResource.get();
+        g_objMeshBoundsVertexCount = vertices.size();
+        g_objMeshBoundingRadius = std::sqrt(radiusSq);
+    }
+    CullParams cullParams;
+    cullParams.planes = extract_frustum_planes(&ubo.view[0][0], &ubo.proj[0][0]);
+    cullParams.eye[0] = eye.x;
+    cullParams.eye[1] = eye.y;
+    cullParams.eye[2] = eye.z;
+    cullParams.maxDistance = g_cullMaxDistance;
+    CullSpheres meshBounds;
+    meshBounds.add(0.0f, 0.0f, 0.0f, g_objMeshBoundingRadius);
+    return cull_spheres_reference(meshBounds, cullParams, g_visibleIndices) > 0;
+}
+
 // Render OBJ mesh
 extern "C" void heidic_render_obj_mesh(GLFWwindow* window) {
     if (g_device == VK_NULL_HANDLE || g_swapchain == VK_NULL_HANDLE || g_objMeshPipeline == VK_NULL_HANDLE || !g_objMeshResource) {
@@ -7046,13 +7573,24 @@ extern "C" void heidic_render_obj_mesh(GLFWwindow* window) {
         g_objMeshRotationAngle -= 2.0f * 3.14159f;
     }
     
-    // Wait for previous frame
-    vkWaitForFences(g_device, 1, &g_inFlightFence, VK_TRUE, UINT64_MAX);
-    vkResetFences(g_device, 1, &g_inFlightFence);
-    
-    // Acquire next image
+    // Wait for this frame slot and acquire the next swapchain image
     uint32_t imageIndex;
-    vkAcquireNextImageKHR(g_device, g_swapchain, UINT64_MAX, g_imageAvailableSemaphore, VK_NULL_HANDLE, &imageIndex);
+    if (!beginFrame(imageIndex)) {
+        return;
+    }
+    
+    // Advance residency clock and evict least-recently-used assets if over budget
+    ResidencyManager::get_instance().beginFrame();
+    
+    // Finish streamed texture levels that have landed and start the next ones within budget
+    TextureStreamer::get_instance().update();
+    
+    // Sample the texture's current view (it changes as finer levels stream in)
+    VkDescriptorSet descriptorSet = g_objMeshDescriptorSet;
+    if (TextureResource* texture = objMeshBoundTexture()) {
+        descriptorSet = refreshTextureDescriptor(*texture, g_objMeshSlotSets, g_objMeshDescriptorPool,
+                                                 g_objMeshDescriptorSetLayout, g_objMeshDescriptorSet, 2, 1);
+    }
     
     // Reset command buffer
     vkResetCommandBuffer(g_commandBuffers[imageIndex], 0);
@@ -7104,29 +7642,31 @@ extern "C" void heidic_render_obj_mesh(GLFWwindow* window) {
     // Vulkan clip space has inverted Y and half Z
     ubo.proj[1][1] *= -1.0f;
     
-    // Update uniform buffer
-    void* data;
-    vkMapMemory(g_device, g_objMeshUniformBufferMemory, 0, sizeof(ubo), 0, &data);
-    memcpy(data, &ubo, sizeof(ubo));
-    vkUnmapMemory(g_device, g_objMeshUniformBufferMemory);
+    // Skip the draw when the mesh is outside the view (the frame is still cleared and presented)
+    if (objMeshVisible(ubo, eye)) {
+        // Update uniform buffer
+        void* data = g_objMeshUniformBufferMemory.mapped;
+        memcpy(data, &ubo, sizeof(ubo));
     
-    // Bind descriptor set
-    vkCmdBindDescriptorSets(g_commandBuffers[imageIndex], VK_PIPELINE_BIND_POINT_GRAPHICS, g_objMeshPipelineLayout, 0, 1, &g_objMeshDescriptorSet, 0, nullptr);
+        // Bind descriptor set
+        vkCmdBindDescriptorSets(g_commandBuffers[imageIndex], VK_PIPELINE_BIND_POINT_GRAPHICS, g_objMeshPipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
     
-    // Bind vertex buffer (from MeshResource)
-    VkBuffer vertexBuffer = g_objMeshResource->getVertexBuffer();
-    VkBuffer indexBuffer = g_objMeshResource->getIndexBuffer();
-    uint32_t indexCount = g_objMeshResource->getIndexCount();
+        // Bind vertex buffer (from MeshResource; re-uploaded first if it was evicted)
+        g_objMeshResource->ensureResident();
+        VkBuffer vertexBuffer = g_objMeshResource->getVertexBuffer();
+        VkBuffer indexBuffer = g_objMeshResource->getIndexBuffer();
+        uint32_t indexCount = g_objMeshResource->getIndexCount();
     
-    VkBuffer vertexBuffers[] = {vertexBuffer};
-    VkDeviceSize offsets[] = {0};
-    vkCmdBindVertexBuffers(g_commandBuffers[imageIndex], 0, 1, vertexBuffers, offsets);
+        VkBuffer vertexBuffers[] = {vertexBuffer};
+        VkDeviceSize offsets[] = {0};
+        vkCmdBindVertexBuffers(g_commandBuffers[imageIndex], 0, 1, vertexBuffers, offsets);
     
-    // Bind index buffer
-    vkCmdBindIndexBuffer(g_commandBuffers[imageIndex], indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+        // Bind index buffer
+        vkCmdBindIndexBuffer(g_commandBuffers[imageIndex], indexBuffer, 0, VK_INDEX_TYPE_UINT32);
     
-    // Draw mesh using indexed drawing
-    vkCmdDrawIndexed(g_commandBuffers[imageIndex], indexCount, 1, 0, 0, 0);
+        // Draw mesh using indexed drawing
+        vkCmdDrawIndexed(g_commandBuffers[imageIndex], indexCount, 1, 0, 0, 0);
+    }
     
     // Render NEUROSHELL UI (if enabled)
     #ifdef USE_NEUROSHELL
@@ -7140,34 +7680,8 @@ extern "C" void heidic_render_obj_mesh(GLFWwindow* window) {
     vkCmdEndRenderPass(g_commandBuffers[imageIndex]);
     vkEndCommandBuffer(g_commandBuffers[imageIndex]);
     
-    VkSubmitInfo submitInfo = {};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    
-    VkSemaphore waitSemaphores[] = {g_imageAvailableSemaphore};
-    VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-    submitInfo.waitSemaphoreCount = 1;
-    submitInfo.pWaitSemaphores = waitSemaphores;
-    submitInfo.pWaitDstStageMask = waitStages;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &g_commandBuffers[imageIndex];
-    
-    VkSemaphore signalSemaphores[] = {g_renderFinishedSemaphore};
-    submitInfo.signalSemaphoreCount = 1;
-    submitInfo.pSignalSemaphores = signalSemaphores;
-    
-    vkQueueSubmit(g_graphicsQueue, 1, &submitInfo, g_inFlightFence);
-    
-    VkPresentInfoKHR presentInfo = {};
-    presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-    presentInfo.waitSemaphoreCount = 1;
-    presentInfo.pWaitSemaphores = signalSemaphores;
-    
-    VkSwapchainKHR swapChains[] = {g_swapchain};
-    presentInfo.swapchainCount = 1;
-    presentInfo.pSwapchains = swapChains;
-    presentInfo.pImageIndices = &imageIndex;
-    
-    vkQueuePresentKHR(g_graphicsQueue, &presentInfo);
+    // Submit on this frame slot's fence and present
+    submitFrame(imageIndex);
 }
 
 // Cleanup OBJ mesh renderer
@@ -7183,6 +7697,7 @@ extern "C" void heidic_cleanup_renderer_obj_mesh() {
     if (g_objMeshDescriptorPool != VK_NULL_HANDLE) {
         vkDestroyDescriptorPool(g_device, g_objMeshDescriptorPool, nullptr);
         g_objMeshDescriptorPool = VK_NULL_HANDLE;
+        g_objMeshSlotSets = SlotDescriptorSets();
     }
     if (g_objMeshDescriptorSetLayout != VK_NULL_HANDLE) {
         vkDestroyDescriptorSetLayout(g_device, g_objMeshDescriptorSetLayout, nullptr);
@@ -7192,10 +7707,7 @@ extern "C" void heidic_cleanup_renderer_obj_mesh() {
         vkDestroyBuffer(g_device, g_objMeshUniformBuffer, nullptr);
         g_objMeshUniformBuffer = VK_NULL_HANDLE;
     }
-    if (g_objMeshUniformBufferMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(g_device, g_objMeshUniformBufferMemory, nullptr);
-        g_objMeshUniformBufferMemory = VK_NULL_HANDLE;
-    }
+    GpuAllocator::get_instance().free(g_objMeshUniformBufferMemory);
     // Cleanup texture (TextureResource handles its own cleanup via RAII)
     if (g_objMeshTexture) {
         g_objMeshTexture.reset();
@@ -7213,10 +7725,7 @@ extern "C" void heidic_cleanup_renderer_obj_mesh() {
         vkDestroyImage(g_device, g_objMeshDummyTexture, nullptr);
         g_objMeshDummyTexture = VK_NULL_HANDLE;
     }
-    if (g_objMeshDummyTextureMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(g_device, g_objMeshDummyTextureMemory, nullptr);
-        g_objMeshDummyTextureMemory = VK_NULL_HANDLE;
-    }
+    GpuAllocator::get_instance().free(g_objMeshDummyTextureMemory);
     if (g_objMeshVertShaderModule != VK_NULL_HANDLE) {
         vkDestroyShaderModule(g_device, g_objMeshVertShaderModule, nullptr);
         g_objMeshVertShaderModule = VK_NULL_HANDLE;
@@ -7233,6 +7742,13 @@ extern "C" void heidic_cleanup_renderer_obj_mesh() {
 static void render_obj_mesh_to_command_buffer(VkCommandBuffer commandBuffer) {
     if (!g_objMeshInitialized || !g_objMeshResource) return;
     
+    // Sample the texture's current view before the set is bound below
+    VkDescriptorSet descriptorSet = g_objMeshDescriptorSet;
+    if (TextureResource* texture = objMeshBoundTexture()) {
+        descriptorSet = refreshTextureDescriptor(*texture, g_objMeshSlotSets, g_objMeshDescriptorPool,
+                                                 g_objMeshDescriptorSetLayout, g_objMeshDescriptorSet, 2, 1);
+    }
+    
     // Update rotation
     auto now = std::chrono::high_resolution_clock::now();
     float deltaTime = std::chrono::duration<float>(now - g_lastTime).count();
@@ -7265,11 +7781,14 @@ static void render_obj_mesh_to_command_buffer(VkCommandBuffer commandBuffer) {
     // Vulkan clip space has inverted Y and half Z
     ubo.proj[1][1] *= -1.0f;
     
+    // Skip the draw when the mesh is outside the view
+    if (!objMeshVisible(ubo, eye)) {
+        return;
+    }
+    
     // Update uniform buffer
-    void* data;
-    vkMapMemory(g_device, g_objMeshUniformBufferMemory, 0, sizeof(ubo), 0, &data);
+    void* data = g_objMeshUniformBufferMemory.mapped;
     memcpy(data, &ubo, sizeof(ubo));
-    vkUnmapMemory(g_device, g_objMeshUniformBufferMemory);
     
     // Set viewport and scissor
     VkViewport viewport = {};
@@ -7287,9 +7806,10 @@ static void render_obj_mesh_to_command_buffer(VkCommandBuffer commandBuffer) {
     vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
     
     // Bind descriptor set
-    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, g_objMeshPipelineLayout, 0, 1, &g_objMeshDescriptorSet, 0, nullptr);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, g_objMeshPipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
     
-    // Bind vertex buffer (from MeshResource)
+    // Bind vertex buffer (from MeshResource; re-uploaded first if it was evicted)
+    g_objMeshResource->ensureResident();
     VkBuffer vertexBuffer = g_objMeshResource->getVertexBuffer();
     VkBuffer indexBuffer = g_objMeshResource->getIndexBuffer();
     uint32_t indexCount = g_objMeshResource->getIndexCount();
@@ -7464,24 +7984,20 @@ static bool hdm_load_texture_data(const char* filepath, HDMTexture& tex) {
         return false;
     }
     
-    // Use stb_image to load the texture
-    int width, height, channels;
-    unsigned char* data = stbi_load(filepath, &width, &height, &channels, 4);  // Force RGBA
-    
-    if (!data) {
-        std::cerr << "[HDM] Failed to load texture: " << filepath << std::endl;
+    // Decode straight into the HDM texture (RGB sources are expanded to RGBA on the way)
+    ImageInfo info;
+    try {
+        tex.data = load_image_rgba8(filepath, info);
+    } catch (const std::exception& e) {
+        std::cerr << "[HDM] Failed to load texture: " << filepath << " (" << e.what() << ")" << std::endl;
         return false;
     }
     
-    tex.width = width;
-    tex.height = height;
+    tex.width = info.width;
+    tex.height = info.height;
     tex.format = 0;  // RGBA8
-    tex.data.resize(width * height * 4);
-    memcpy(tex.data.data(), data, width * height * 4);
     
-    stbi_image_free(data);
-    
-    std::cout << "[HDM] Loaded texture: " << width << "x" << height << " (" 
+    std::cout << "[HDM] Loaded texture: " << tex.width << "x" << tex.height << " (" 
               << tex.data.size() << " bytes)" << std::endl;
     return true;
 }
@@ -7878,15 +8394,15 @@ static bool hdm_create_mesh_from_packed(GLFWwindow* window, const HDMGeometry& g
         
         // Try shaders/mesh.vert.spv first (common location)
         try {
-            vertShaderCode = readFile("shaders/mesh.vert.spv");
-            fragShaderCode = readFile("shaders/mesh.frag.spv");
+            vertShaderCode = loadShaderCode("shaders/mesh.vert.spv");
+            fragShaderCode = loadShaderCode("shaders/mesh.frag.spv");
             std::cout << "[HDM] Loaded mesh shaders (shaders/mesh.vert.spv, shaders/mesh.frag.spv)" << std::endl;
             loadedMeshShaders = true;
         } catch (const std::exception& e) {
             // Try current directory
             try {
-                vertShaderCode = readFile("mesh.vert.spv");
-                fragShaderCode = readFile("mesh.frag.spv");
+                vertShaderCode = loadShaderCode("mesh.vert.spv");
+                fragShaderCode = loadShaderCode("mesh.frag.spv");
                 std::cout << "[HDM] Loaded mesh shaders (mesh.vert.spv, mesh.frag.spv)" << std::endl;
                 loadedMeshShaders = true;
             } catch (const std::exception& e2) {
@@ -7894,8 +8410,8 @@ static bool hdm_create_mesh_from_packed(GLFWwindow* window, const HDMGeometry& g
                 std::cout << "[HDM] WARNING: Mesh shaders not found, trying default 3D shaders..." << std::endl;
                 std::cout << "[HDM] NOTE: 3D shaders may not work correctly with OBJ mesh format!" << std::endl;
                 try {
-                    vertShaderCode = readFile("vert_3d.spv");
-                    fragShaderCode = readFile("frag_3d.spv");
+                    vertShaderCode = loadShaderCode("vert_3d.spv");
+                    fragShaderCode = loadShaderCode("frag_3d.spv");
                     std::cout << "[HDM] Loaded default 3D shaders (vert_3d.spv, frag_3d.spv)" << std::endl;
                     std::cerr << "[HDM] WARNING: Using incompatible shaders - model may not render correctly!" << std::endl;
                 } catch (const std::exception& e3) {
@@ -8014,12 +8530,10 @@ static bool hdm_create_mesh_from_packed(GLFWwindow* window, const HDMGeometry& g
         vkCmdPipelineBarrier(cmdBuf, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
         
         VkBuffer stagingBuf;
-        VkDeviceMemory stagingMem;
+        GpuAllocation stagingMem;
         createBuffer(4, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuf, stagingMem);
-        void* mapData;
-        vkMapMemory(g_device, stagingMem, 0, 4, 0, &mapData);
+        void* mapData = stagingMem.mapped;
         memcpy(mapData, &dummyData, 4);
-        vkUnmapMemory(g_device, stagingMem);
         
         VkBufferImageCopy region = {};
         region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
@@ -8033,7 +8547,7 @@ static bool hdm_create_mesh_from_packed(GLFWwindow* window, const HDMGeometry& g
         vkCmdPipelineBarrier(cmdBuf, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
         endSingleTimeCommands(cmdBuf);
         vkDestroyBuffer(g_device, stagingBuf, nullptr);
-        vkFreeMemory(g_device, stagingMem, nullptr);
+        GpuAllocator::get_instance().free(stagingMem);
         
         VkImageViewCreateInfo viewInfo = {};
         viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
@@ -8054,13 +8568,13 @@ static bool hdm_create_mesh_from_packed(GLFWwindow* window, const HDMGeometry& g
         
         // Create descriptor pool and set - from lines 6356-6440
         VkDescriptorPoolSize poolSizes[2] = {};
-        poolSizes[0] = {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1};
-        poolSizes[1] = {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1};
+        poolSizes[0] = {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1 + MAX_FRAMES_IN_FLIGHT};
+        poolSizes[1] = {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1 + MAX_FRAMES_IN_FLIGHT};
         VkDescriptorPoolCreateInfo poolInfo = {};
         poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
         poolInfo.poolSizeCount = 2;
         poolInfo.pPoolSizes = poolSizes;
-        poolInfo.maxSets = 1;
+        poolInfo.maxSets = 1 + MAX_FRAMES_IN_FLIGHT;   // The template set and one copy per frame slot
         vkCreateDescriptorPool(g_device, &poolInfo, nullptr, &g_objMeshDescriptorPool);
         
         VkDescriptorSetAllocateInfo allocInfo = {};
@@ -8127,12 +8641,13 @@ static bool hdm_create_mesh_from_packed(GLFWwindow* window, const HDMGeometry& g
         pipelineInfo.renderPass = g_renderPass;
         pipelineInfo.subpass = 0;
         
-        if (vkCreateGraphicsPipelines(g_device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &g_objMeshPipeline) != VK_SUCCESS) {
+        if (vkCreateGraphicsPipelines(g_device, PipelineCache::get_instance().get(), 1, &pipelineInfo, nullptr, &g_objMeshPipeline) != VK_SUCCESS) {
             std::cerr << "[HDM] ERROR: Failed to create graphics pipeline!" << std::endl;
             // Cleanup on failure
             if (g_objMeshDescriptorPool != VK_NULL_HANDLE) {
                 vkDestroyDescriptorPool(g_device, g_objMeshDescriptorPool, nullptr);
                 g_objMeshDescriptorPool = VK_NULL_HANDLE;
+                g_objMeshSlotSets = SlotDescriptorSets();
             }
             if (g_objMeshDummySampler != VK_NULL_HANDLE) {
                 vkDestroySampler(g_device, g_objMeshDummySampler, nullptr);
@@ -8146,18 +8661,12 @@ static bool hdm_create_mesh_from_packed(GLFWwindow* window, const HDMGeometry& g
                 vkDestroyImage(g_device, g_objMeshDummyTexture, nullptr);
                 g_objMeshDummyTexture = VK_NULL_HANDLE;
             }
-            if (g_objMeshDummyTextureMemory != VK_NULL_HANDLE) {
-                vkFreeMemory(g_device, g_objMeshDummyTextureMemory, nullptr);
-                g_objMeshDummyTextureMemory = VK_NULL_HANDLE;
-            }
+            GpuAllocator::get_instance().free(g_objMeshDummyTextureMemory);
             if (g_objMeshUniformBuffer != VK_NULL_HANDLE) {
                 vkDestroyBuffer(g_device, g_objMeshUniformBuffer, nullptr);
                 g_objMeshUniformBuffer = VK_NULL_HANDLE;
             }
-            if (g_objMeshUniformBufferMemory != VK_NULL_HANDLE) {
-                vkFreeMemory(g_device, g_objMeshUniformBufferMemory, nullptr);
-                g_objMeshUniformBufferMemory = VK_NULL_HANDLE;
-            }
+            GpuAllocator::get_instance().free(g_objMeshUniformBufferMemory);
             if (g_objMeshPipelineLayout != VK_NULL_HANDLE) {
                 vkDestroyPipelineLayout(g_device, g_objMeshPipelineLayout, nullptr);
                 g_objMeshPipelineLayout = VK_NULL_HANDLE;
@@ -8197,8 +8706,7 @@ static bool hdm_create_mesh_from_packed(GLFWwindow* window, const HDMGeometry& g
             }
             vkDestroyImage(g_device, g_objMeshDummyTexture, nullptr);
             g_objMeshDummyTexture = VK_NULL_HANDLE;
-            vkFreeMemory(g_device, g_objMeshDummyTextureMemory, nullptr);
-            g_objMeshDummyTextureMemory = VK_NULL_HANDLE;
+            GpuAllocator::get_instance().free(g_objMeshDummyTextureMemory);
         }
         
         // Create image
@@ -8227,16 +8735,14 @@ static bool hdm_create_mesh_from_packed(GLFWwindow* window, const HDMGeometry& g
         // Create staging buffer
         VkDeviceSize imageSize = tex.width * tex.height * 4;
         VkBuffer stagingBuffer;
-        VkDeviceMemory stagingBufferMemory;
+        GpuAllocation stagingBufferMemory;
         createBuffer(imageSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
                      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                      stagingBuffer, stagingBufferMemory);
         
         // Copy texture data to staging buffer
-        void* data;
-        vkMapMemory(g_device, stagingBufferMemory, 0, imageSize, 0, &data);
+        void* data = stagingBufferMemory.mapped;
         memcpy(data, tex.data.data(), imageSize);
-        vkUnmapMemory(g_device, stagingBufferMemory);
         
         // Copy buffer to image
         VkBufferImageCopy region = {};
@@ -8260,7 +8766,7 @@ static bool hdm_create_mesh_from_packed(GLFWwindow* window, const HDMGeometry& g
         
         // Clean up staging buffer
         vkDestroyBuffer(g_device, stagingBuffer, nullptr);
-        vkFreeMemory(g_device, stagingBufferMemory, nullptr);
+        GpuAllocator::get_instance().free(stagingBufferMemory);
         
         // Create image view
         VkImageViewCreateInfo viewInfo = {};
@@ -8733,16 +9239,10 @@ extern "C" void heidic_render_ese(GLFWwindow* window) {
     ImGui::Render();
 #endif
     
-    // Wait for previous frame to complete BEFORE acquiring next image
-    vkWaitForFences(g_device, 1, &g_inFlightFence, VK_TRUE, UINT64_MAX);
-    vkResetFences(g_device, 1, &g_inFlightFence);
-    
-    // Acquire swapchain image
+    // Wait for this frame slot and acquire the next swapchain image
     uint32_t imageIndex;
-    VkResult result = vkAcquireNextImageKHR(g_device, g_swapchain, UINT64_MAX, 
-                                            g_imageAvailableSemaphore, VK_NULL_HANDLE, &imageIndex);
-    if (result == VK_ERROR_OUT_OF_DATE_KHR) {
-        return; // Swapchain needs recreation
+    if (!beginFrame(imageIndex)) {
+        return;
     }
     
     // Reset and begin command buffer
@@ -8785,36 +9285,8 @@ extern "C" void heidic_render_ese(GLFWwindow* window) {
     vkCmdEndRenderPass(g_commandBuffers[imageIndex]);
     vkEndCommandBuffer(g_commandBuffers[imageIndex]);
     
-    // Submit command buffer
-    VkSubmitInfo submitInfo = {};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    
-    VkSemaphore waitSemaphores[] = {g_imageAvailableSemaphore};
-    VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-    submitInfo.waitSemaphoreCount = 1;
-    submitInfo.pWaitSemaphores = waitSemaphores;
-    submitInfo.pWaitDstStageMask = waitStages;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &g_commandBuffers[imageIndex];
-    
-    VkSemaphore signalSemaphores[] = {g_renderFinishedSemaphore};
-    submitInfo.signalSemaphoreCount = 1;
-    submitInfo.pSignalSemaphores = signalSemaphores;
-    
-    vkQueueSubmit(g_graphicsQueue, 1, &submitInfo, g_inFlightFence);
-    
-    // Present
-    VkPresentInfoKHR presentInfo = {};
-    presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-    presentInfo.waitSemaphoreCount = 1;
-    presentInfo.pWaitSemaphores = signalSemaphores;
-    
-    VkSwapchainKHR swapChains[] = {g_swapchain};
-    presentInfo.swapchainCount = 1;
-    presentInfo.pSwapchains = swapChains;
-    presentInfo.pImageIndices = &imageIndex;
-    
-    vkQueuePresentKHR(g_graphicsQueue, &presentInfo);
+    // Submit on this frame slot's fence and present
+    submitFrame(imageIndex);
     
 #ifdef USE_IMGUI
     // Handle file dialogs after render (so they don't block the frame)
@@ -9085,6 +9557,25 @@ extern "C" HDMPhysicsPropertiesC hdm_get_physics_properties() {
     return result;
 }
 
+// Give a colored cube the collision settings of the last loaded HDM file (type, box size, static, mass)
+extern "C" void heidic_apply_hdm_physics_to_cube(int cube_index) {
+    if (cube_index < 0 || cube_index >= MAX_COLORED_CUBES) {
+        return;
+    }
+    const HDMPhysicsProperties& physics = g_loadedHdmProperties.physics;
+    CubeCollision& collision = g_cubeCollision[cube_index];
+    collision.collisionType = physics.collision_type;
+    collision.bounds[0] = physics.collision_bounds[0];
+    collision.bounds[1] = physics.collision_bounds[1];
+    collision.bounds[2] = physics.collision_bounds[2];
+    collision.isStatic = physics.is_static;
+    collision.mass = physics.mass;
+    g_cubeBroadphaseDirty = true;
+    if (g_cubeBodiesInitialized && g_cubePhysics.isValid(g_cubeBodies[cube_index])) {
+        heidic_physics_enable_cube(cube_index, 1);   // Recreate the body with the new settings
+    }
+}
+
 extern "C" HDMModelPropertiesC hdm_get_model_properties() {
     HDMModelPropertiesC result;
     strncpy(result.obj_path, g_loadedHdmProperties.model.obj_path, sizeof(result.obj_path) - 1);
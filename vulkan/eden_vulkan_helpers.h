@@ -37,6 +37,40 @@ void heidic_cleanup_renderer();
 // Sleep for milliseconds (to prevent CPU spinning)
 void heidic_sleep_ms(uint32_t milliseconds);
 
+// GPU memory residency (TextureResource/MeshResource)
+// Set device memory budget in MB (0 = unlimited); least-recently-used assets drop mips or are evicted
+void heidic_set_gpu_memory_budget_mb(float megabytes);
+// Get device memory currently held by tracked textures and meshes (MB)
+float heidic_get_gpu_resident_memory_mb();
+// Print GpuAllocator statistics (live allocations, blocks, dedicated allocations)
+void heidic_print_gpu_memory_stats();
+// Submit pending texture/mesh uploads now (wait != 0 blocks until they complete)
+void heidic_flush_uploads(int wait);
+// Frames the CPU may record ahead of the GPU (1-3, default 2); call before heidic_init_renderer
+void heidic_set_frames_in_flight(int frames);
+// Also cull cubes, balls and meshes farther than this from the camera (0 = frustum culling only, the default)
+void heidic_set_cull_distance(float distance);
+// Transcode PNG textures to BC7/BC5 with a .dds cache (enabled by default; quality 0 = fast, 1 = quality)
+void heidic_set_png_texture_compression(int enabled, int quality);
+// Cache directory for transcoded PNGs (default "texture_cache", "" = no cache, transcode on every load)
+void heidic_set_png_texture_cache_dir(const char* dir);
+// Upload budget for streaming texture mips in MB per frame (default 16; 0 = load every level up front)
+void heidic_set_texture_streaming_budget_mb(float megabytes);
+// Pipeline cache file (default "pipeline_cache.bin", "" = not saved); call before heidic_init_renderer
+void heidic_set_pipeline_cache_path(const char* path);
+// Write the pipeline cache to disk now (cleanup also saves it)
+void heidic_save_pipeline_cache();
+// Shared VkPipelineCache, for pipelines created outside the renderer
+VkPipelineCache heidic_get_pipeline_cache();
+// SPIR-V cache directory for GLSL compiled in-process (default "shader_cache", "" = memory only)
+void heidic_set_shader_cache_dir(const char* dir);
+// Define passed to every shader compiled afterwards (value may be NULL or "")
+void heidic_add_shader_define(const char* name, const char* value);
+// Compile GLSL sources in parallel into the shader cache; returns how many succeeded
+int heidic_precompile_shaders(const char** paths, int count);
+// 1 if a file the shader #includes changed in the current FileWatcher batch
+int heidic_shader_includes_changed(const char* shader_path);
+
 // Cube rendering functions
 int heidic_init_renderer_cube(GLFWwindow* window);
 void heidic_render_frame_cube(GLFWwindow* window);
@@ -113,6 +147,17 @@ void heidic_hide_cursor(GLFWwindow* window);
 int heidic_raycast_cube_hit_center(GLFWwindow* window, float cubeX, float cubeY, float cubeZ, float cubeSx, float cubeSy, float cubeSz);
 // Get hit point from raycast (call after heidic_raycast_cube_hit_center returns 1) - returns world-space hit position
 Vec3 heidic_raycast_cube_hit_point_center(GLFWwindow* window, float cubeX, float cubeY, float cubeZ, float cubeSx, float cubeSy, float cubeSz);
+// Leave a cube out of ray queries: ignore_picks for raycast_cubes/pick_center/cubes_batch,
+// ignore_ground for raycast_downward_big_cube/downward_batch (flags reset by heidic_init_renderer_fps)
+void heidic_raycast_set_ignored_cube(int cube_index, int ignore_picks, int ignore_ground);
+// Nearest cube hit by a ray (BVH over all cubes not ignored for picks) - returns cube index or -1
+int heidic_raycast_cubes(float origin_x, float origin_y, float origin_z, float dir_x, float dir_y, float dir_z, float max_distance);
+// Nearest cube under the crosshair (screen center) - returns cube index or -1
+int heidic_raycast_pick_center(GLFWwindow* window, float max_distance);
+// Distance, world-space point and surface normal of the last heidic_raycast_cubes/pick_center hit (distance -1 on a miss)
+float heidic_get_raycast_distance();
+Vec3 heidic_get_raycast_point();
+Vec3 heidic_get_raycast_normal();
 // Get cube position (for HEIDIC to read) - returns Vec3
 Vec3 heidic_get_cube_position(int cube_index);
 // Set cube position (for HEIDIC to update picked-up cube)
@@ -163,6 +208,25 @@ float heidic_raycast_downward_distance(float x, float y, float z);
 // Cast ray downward from position and return index of big cube hit (or -1 if no hit or hit small cube)
 // Returns cube index if ray hits a big cube (size >= 1.0), -1 otherwise
 int heidic_raycast_downward_big_cube(float x, float y, float z);
+// Batched raycasts (SOA arrays, one call for many rays; traced in packets across worker threads)
+// Cubes: hit_indices = nearest cube or -1, hit_distances = distance or -1; returns number of hits
+int heidic_raycast_cubes_batch(const float* origins_x, const float* origins_y, const float* origins_z,
+                               const float* dirs_x, const float* dirs_y, const float* dirs_z,
+                               int32_t count, float max_distance, int32_t* hit_indices, float* hit_distances);
+// Straight down (ground snapping): hit_indices = cube below or -1 (floor/none), hit_distances = distance to
+// the nearest surface below or -1; returns number of positions with ground below
+int heidic_raycast_downward_batch(const float* xs, const float* ys, const float* zs, int32_t count,
+                                  float max_distance, int32_t* hit_indices, float* hit_distances);
+// Collision broadphase over the cubes (sweep-and-prune) - returns the number of overlapping cube pairs
+int heidic_update_cube_broadphase();
+// Cube indices of overlapping pair pair_index from the last update (a < b), or -1
+int heidic_get_cube_overlap_a(int pair_index);
+int heidic_get_cube_overlap_b(int pair_index);
+// Rigid-body physics for cubes: enable (1) / disable (0) per cube (disable while carried),
+// step by frame time (returns fixed steps taken), and query whether a cube has come to rest
+void heidic_physics_enable_cube(int cube_index, int enabled);
+int heidic_physics_step(float delta_time);
+int heidic_physics_is_cube_sleeping(int cube_index);
 // Get cube size (1.0 for big, 0.5 for small, or average for rectangles)
 float heidic_get_cube_size(int cube_index);
 // Get cube size per axis (for rectangles)
@@ -170,8 +234,20 @@ Vec3 heidic_get_cube_size_xyz(int cube_index);
 // Get ray origin and direction from screen center (for debug visualization)
 Vec3 heidic_get_center_ray_origin(GLFWwindow* window);
 Vec3 heidic_get_center_ray_dir(GLFWwindow* window);
-// Draw a debug line (placeholder - not yet implemented for FPS renderer)
+// Debug drawing (batched, drawn by the next heidic_render_fps with one draw per depth mode)
 void heidic_draw_line(float x1, float y1, float z1, float x2, float y2, float z2, float r, float g, float b);
+// Ray under the mouse cursor, from the camera out to `length`
+void heidic_draw_ray(GLFWwindow* window, float length, float r, float g, float b);
+// Wireframe box: center, rotation in degrees about X/Y/Z, full size per axis
+void heidic_draw_cube_wireframe(float x, float y, float z, float rx, float ry, float rz, float sx, float sy, float sz, float r, float g, float b);
+// Spot light cone: apex, direction, range, outer cone half-angle (radians)
+void heidic_draw_spot_light_cone(float x, float y, float z, float dir_x, float dir_y, float dir_z, float range, float outer_cone, float r, float g, float b);
+void heidic_draw_sphere_wireframe(float x, float y, float z, float radius, float r, float g, float b);
+// 1 (default): later debug primitives are hidden behind geometry; 0: drawn on top
+void heidic_set_debug_draw_depth_test(int enabled);
+// Debug lines queued for the next frame / primitives dropped because the frame's buffer was full
+int heidic_get_debug_draw_line_count();
+int heidic_get_debug_draw_dropped();
 
 // UI Window Manager functions (optional - for game interface windows)
 // These functions are only available if UI windows are enabled in project config
@@ -219,6 +295,8 @@ typedef struct {
 int hdm_load_file(const char* filepath);
 HDMItemPropertiesC hdm_get_item_properties();
 HDMPhysicsPropertiesC hdm_get_physics_properties();
+// Use the loaded HDM's physics properties (collision type, box size, static, mass) for a cube's collision
+void heidic_apply_hdm_physics_to_cube(int cube_index);
 HDMModelPropertiesC hdm_get_model_properties();
 
 // NFD (Native File Dialog) functions for ESE